@@ -0,0 +1,184 @@
+// 实时路径回调分派微基准：std::function（改造前）vs rt::FunctionRef（当前）vs 直接调用（下限）。
+//   1) dispatch：空回调，只测一次分派的 ns/call；
+//   2) capture -> ring：采集回调把一个周期的 PCM 写进 SpscRingBuffer（消费端同线程读空），ns/周期；
+//   3) receive -> JB：收包回调 decode_audio + JitterBuffer::push，随后出队一块，ns/包。
+// 回调对象经 do_not_optimize 逃逸，持有方（模拟后端 / 传输层）在独立的 noinline 函数里调用，
+// 与真实代码跨翻译单元调用回调的形态一致，编译器不能把分派折叠掉。
+//
+// 用法：aqua_bench_callback [iterations]
+//   默认 200000 次；PCM 为 10ms 48kHz F32 立体声（3840 字节）。
+
+#include "core/audio/ringbuffer/spsc_ringbuffer.h"
+#include "core/jitter_buffer/jitter_buffer.h"
+#include "core/net/packet/packet.h"
+#include "core/public/audio_format.h"
+#include "core/rt/function_ref.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace {
+
+using aqua::AudioEncoding;
+using aqua::AudioFormat;
+
+constexpr AudioFormat FORMAT { AudioEncoding::PcmF32LE, 2, 48000 };
+constexpr std::uint32_t FRAMES_PER_PACKET = 480;
+constexpr std::size_t PAYLOAD_BYTES = FRAMES_PER_PACKET * 8;
+
+template <typename T>
+void do_not_optimize(T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+m"(value) : : "memory");
+#else
+    static_cast<void>(std::addressof(value));
+#endif
+}
+
+template <typename Fn>
+double ns_per_iteration(std::size_t iterations, Fn&& body)
+{
+    for (std::size_t i = 0; i < iterations / 10 + 1; ++i) {
+        body(i);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        body(i);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+}
+
+// ---- 模拟持有方：一次 "设备周期" / "收到一个 datagram" 调用一次回调 ----
+
+using CaptureFunction = std::function<void(std::span<const std::byte>)>;
+using CaptureRef = aqua::rt::FunctionRef<void(std::span<const std::byte>)>;
+using ReceiveFunction = std::function<void(std::span<const std::byte>)>;
+using ReceiveRef = aqua::rt::FunctionRef<void(std::span<const std::byte>)>;
+
+template <typename Callback>
+[[gnu::noinline]] void deliver(const Callback& cb, std::span<const std::byte> data)
+{
+    cb(data);
+}
+
+// ---- 1) 空回调分派 ----
+
+void bench_dispatch(std::size_t iterations)
+{
+    std::size_t calls = 0;
+    const auto sink = [&calls](std::span<const std::byte>) { ++calls; };
+    const std::vector<std::byte> data(PAYLOAD_BYTES);
+
+    CaptureFunction function = sink;
+    CaptureRef ref = sink;
+    do_not_optimize(function);
+    do_not_optimize(ref);
+
+    const double fn_ns = ns_per_iteration(iterations, [&](std::size_t) { deliver(function, data); });
+    const double ref_ns = ns_per_iteration(iterations, [&](std::size_t) { deliver(ref, data); });
+    const double direct_ns = ns_per_iteration(iterations, [&](std::size_t) { deliver(sink, data); });
+    std::printf("%-16s %-14s %10.2f\n", "dispatch", "std::function", fn_ns);
+    std::printf("%-16s %-14s %10.2f\n", "dispatch", "FunctionRef", ref_ns);
+    std::printf("%-16s %-14s %10.2f\n", "dispatch", "direct", direct_ns);
+    do_not_optimize(calls);
+}
+
+// ---- 2) capture -> ring ----
+
+void bench_capture_ring(std::size_t iterations)
+{
+    aqua::audio::SpscRingBuffer ring(PAYLOAD_BYTES * 4);
+    std::uint64_t dropped = 0;
+    // 与 ServerRuntime::Impl::handle_capture 同形：写 RB，写不下计丢弃
+    const auto on_capture = [&](std::span<const std::byte> pcm) {
+        const auto written = ring.write(pcm);
+        dropped += pcm.size() - written;
+    };
+    const std::vector<std::byte> pcm(PAYLOAD_BYTES, std::byte { 0x3c });
+    std::vector<std::byte> drain(PAYLOAD_BYTES);
+
+    CaptureFunction function = on_capture;
+    CaptureRef ref = on_capture;
+    do_not_optimize(function);
+    do_not_optimize(ref);
+
+    const auto run = [&](const auto& cb) {
+        return ns_per_iteration(iterations, [&](std::size_t) {
+            deliver(cb, pcm);
+            (void)ring.read(drain); // packetizer 端
+        });
+    };
+    const double fn_ns = run(function);
+    const double ref_ns = run(ref);
+    const double direct_ns = run(on_capture);
+    std::printf("%-16s %-14s %10.2f\n", "capture->ring", "std::function", fn_ns);
+    std::printf("%-16s %-14s %10.2f\n", "capture->ring", "FunctionRef", ref_ns);
+    std::printf("%-16s %-14s %10.2f\n", "capture->ring", "direct", direct_ns);
+    if (dropped != 0) {
+        std::fprintf(stderr, "unexpected ring drops: %llu bytes\n", static_cast<unsigned long long>(dropped));
+    }
+}
+
+// ---- 3) receive -> JB ----
+
+void bench_receive_jb(std::size_t iterations)
+{
+    aqua::jitter::JitterBuffer jb(FORMAT, FRAMES_PER_PACKET, 2, 16);
+    // 与 Timer 模式 on_datagram 的音频分支同形：解码报文头，按 sequence 入 JB
+    const auto on_datagram = [&jb](std::span<const std::byte> data) {
+        if (const auto decoded = aqua::net::decode_audio(data)) {
+            jb.push(decoded->header.sequence, decoded->payload);
+        }
+    };
+
+    const std::vector<std::byte> payload(PAYLOAD_BYTES, std::byte { 0x3c });
+    std::vector<std::byte> datagram(sizeof(aqua::net::AudioPacketHeader) + PAYLOAD_BYTES);
+    std::vector<std::byte> out(PAYLOAD_BYTES);
+    std::uint32_t sequence = 0;
+
+    ReceiveFunction function = on_datagram;
+    ReceiveRef ref = on_datagram;
+    do_not_optimize(function);
+    do_not_optimize(ref);
+
+    const auto run = [&](const auto& cb) {
+        return ns_per_iteration(iterations, [&](std::size_t) {
+            // 报文编码不计入对比的差异（三种分派相同），但计入绝对值
+            const auto n = aqua::net::encode_audio(1, sequence, sequence * FRAMES_PER_PACKET, payload, datagram);
+            ++sequence;
+            deliver(cb, std::span<const std::byte>(datagram).first(n));
+            (void)jb.pop_next(out); // 出队端
+        });
+    };
+    const double fn_ns = run(function);
+    const double ref_ns = run(ref);
+    const double direct_ns = run(on_datagram);
+    std::printf("%-16s %-14s %10.2f\n", "receive->jb", "std::function", fn_ns);
+    std::printf("%-16s %-14s %10.2f\n", "receive->jb", "FunctionRef", ref_ns);
+    std::printf("%-16s %-14s %10.2f\n", "receive->jb", "direct", direct_ns);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    if (iterations == 0) {
+        std::fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("iterations=%zu payload=%zu bytes\n", iterations, PAYLOAD_BYTES);
+    std::printf("%-16s %-14s %10s\n", "path", "callback", "ns/call");
+    bench_dispatch(iterations);
+    bench_capture_ring(iterations);
+    bench_receive_jb(iterations);
+    return 0;
+}
@@ -0,0 +1,160 @@
+// 格式转换微基准：
+//   1) decode / encode 内核：各编码 × 各可用 SIMD 档位，ns/sample 与相对标量加速比；
+//   2) PolyphaseResampler 立体声：各采样率对 × 各档位，ns/输出帧与实时单核占用；
+//   3) FormatConverter 典型客户端路径（默认档位）：ns/frame。
+//
+// 用法：aqua_bench_convert [frames_per_buffer] [iterations]
+//   默认 480 帧（10ms 48kHz）× 20000 次；内核按立体声（960 样本）计。
+
+#include "core/audio/dsp/cpu_features.h"
+#include "core/audio/dsp/format_converter.h"
+#include "core/audio/dsp/polyphase_resampler.h"
+#include "core/audio/dsp/sample_convert.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+using aqua::AudioEncoding;
+using aqua::AudioFormat;
+using aqua::audio::dsp::SimdLevel;
+namespace dsp = aqua::audio::dsp;
+
+struct EncodingCase {
+    AudioEncoding encoding;
+    const char* name;
+};
+
+constexpr EncodingCase ENCODINGS[] = {
+    { AudioEncoding::PcmS16LE, "s16" },
+    { AudioEncoding::PcmS24LE, "s24" },
+    { AudioEncoding::PcmS32LE, "s32" },
+    { AudioEncoding::PcmU8, "u8" },
+};
+
+constexpr SimdLevel LEVELS[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Neon };
+
+struct ConverterCase {
+    AudioFormat in;
+    AudioFormat out;
+    const char* name;
+};
+
+constexpr std::uint32_t RATE = 48000;
+
+const ConverterCase CONVERTERS[] = {
+    { { AudioEncoding::PcmF32LE, 2, RATE }, { AudioEncoding::PcmS16LE, 2, RATE }, "f32x2 -> s16x2 (dither)" },
+    { { AudioEncoding::PcmS16LE, 2, RATE }, { AudioEncoding::PcmF32LE, 2, RATE }, "s16x2 -> f32x2" },
+    { { AudioEncoding::PcmF32LE, 2, RATE }, { AudioEncoding::PcmS32LE, 2, RATE }, "f32x2 -> s32x2" },
+    { { AudioEncoding::PcmF32LE, 2, RATE }, { AudioEncoding::PcmS24LE, 2, RATE }, "f32x2 -> s24x2" },
+    { { AudioEncoding::PcmF32LE, 6, RATE }, { AudioEncoding::PcmF32LE, 2, RATE }, "f32x6 -> f32x2 (downmix)" },
+    { { AudioEncoding::PcmS16LE, 2, RATE }, { AudioEncoding::PcmS16LE, 1, RATE }, "s16x2 -> s16x1 (downmix)" },
+    { { AudioEncoding::PcmS16LE, 2, 44100 }, { AudioEncoding::PcmS16LE, 2, RATE }, "s16x2 44.1k -> 48k (src)" },
+};
+
+struct RateCase {
+    std::uint32_t in_rate;
+    std::uint32_t out_rate;
+};
+
+constexpr RateCase RATES[] = { { 44100, 48000 }, { 48000, 44100 }, { 48000, 96000 }, { 96000, 48000 } };
+
+std::vector<float> random_samples(std::size_t n)
+{
+    std::vector<float> v(n);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-0.9f, 0.9f);
+    for (auto& x : v) {
+        x = dist(rng);
+    }
+    return v;
+}
+
+template <typename Fn>
+double time_ns(std::size_t iterations, Fn&& fn)
+{
+    for (std::size_t i = 0; i < iterations / 10 + 1; ++i) {
+        fn();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+// 返回 { decode ns/sample, encode ns/sample }
+std::pair<double, double> kernel_ns(AudioEncoding enc, SimdLevel level, std::size_t samples, std::size_t iterations)
+{
+    const auto floats = random_samples(samples);
+    std::vector<std::byte> pcm(samples * AudioFormat { enc, 1, 1 }.bytes_per_sample());
+    std::vector<float> decoded(samples);
+    dsp::encode_samples(floats, enc, pcm, level);
+
+    const double enc_ns = time_ns(iterations, [&] { dsp::encode_samples(floats, enc, pcm, level); });
+    const double dec_ns = time_ns(iterations, [&] { dsp::decode_samples(pcm, enc, decoded, level); });
+    const auto n = static_cast<double>(samples * iterations);
+    return { dec_ns / n, enc_ns / n };
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t frames = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 480;
+    const std::size_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+    if (frames == 0 || iterations == 0) {
+        std::fprintf(stderr, "usage: %s [frames_per_buffer] [iterations]\n", argv[0]);
+        return 1;
+    }
+    const std::size_t samples = frames * 2;
+
+    std::printf("detected=%s frames=%zu iterations=%zu\n",
+        dsp::simd_level_name(dsp::detect_simd_level()), frames, iterations);
+    std::printf("%-6s %-8s %12s %9s %12s %9s\n", "enc", "level", "decode ns/s", "speedup", "encode ns/s", "speedup");
+    for (const auto& c : ENCODINGS) {
+        const auto scalar = kernel_ns(c.encoding, SimdLevel::Scalar, samples, iterations);
+        for (const auto level : LEVELS) {
+            if (!dsp::simd_level_supported(level)) {
+                continue;
+            }
+            const auto r = level == SimdLevel::Scalar ? scalar : kernel_ns(c.encoding, level, samples, iterations);
+            std::printf("%-6s %-8s %12.3f %8.2fx %12.3f %8.2fx\n", c.name, dsp::simd_level_name(level),
+                r.first, scalar.first / r.first, r.second, scalar.second / r.second);
+        }
+    }
+
+    std::printf("\n%-16s %-8s %5s %14s %9s\n", "src", "level", "taps", "ns/out frame", "cpu %");
+    for (const auto& r : RATES) {
+        const auto in = random_samples(frames * 2);
+        for (const auto level : LEVELS) {
+            if (!dsp::simd_level_supported(level)) {
+                continue;
+            }
+            dsp::PolyphaseResampler rs(2, r.in_rate, r.out_rate, frames, level);
+            std::vector<float> out(rs.max_output_frames() * 2);
+            const double ns = time_ns(iterations, [&] { rs.process(in, out); });
+            // 稳态每次输出 frames × L / M 帧；单核占用 = 每秒 out_rate 帧的耗时 / 1s
+            const double out_frames = static_cast<double>(frames * iterations) * r.out_rate / r.in_rate;
+            const double per_frame = ns / out_frames;
+            std::printf("%6u -> %-6u %-8s %5zu %14.3f %8.3f%%\n", r.in_rate, r.out_rate, dsp::simd_level_name(level),
+                rs.taps(), per_frame, per_frame * r.out_rate / 1e7);
+        }
+    }
+
+    std::printf("\n%-28s %12s\n", "converter", "ns/frame");
+    for (const auto& c : CONVERTERS) {
+        dsp::FormatConverter conv(c.in, c.out, frames);
+        std::vector<std::byte> in(frames * c.in.frame_bytes());
+        dsp::encode_samples(random_samples(frames * c.in.channels), c.in.encoding, in);
+        std::vector<std::byte> out(frames * c.out.frame_bytes());
+        const double ns = time_ns(iterations, [&] { conv.process(in, out, { }); });
+        std::printf("%-28s %12.3f\n", c.name, ns / static_cast<double>(frames * iterations));
+    }
+    return 0;
+}
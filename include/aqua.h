@@ -113,6 +113,12 @@ typedef enum aqua_client_state {
     AQUA_CLIENT_FAILED = 5, /* 致命错误 */
 } aqua_client_state_t;
 
+/* 丢包隐藏算法。数值与 core 内部 aqua::config::PlcMode 一一对应（编译期静态断言校验）。 */
+typedef enum aqua_plc_mode {
+    AQUA_PLC_REPEAT = 0, /* 上一包逐包减半重复（默认） */
+    AQUA_PLC_WAVEFORM = 1, /* 基音匹配延续 + 交叉淡化，丢包更平滑 */
+} aqua_plc_mode_t;
+
 typedef struct aqua_client_config {
     const char* server_ip; /* UTF-8；NULL = "127.0.0.1" */
     uint16_t server_rpc_port; /* 0 = 50051 */
@@ -128,6 +134,12 @@ typedef struct aqua_client_config {
     uint32_t jitter_detect_window_packets; /* 抖动检测窗口（包数）：窗口满时评估
                                               drift rebase 与自适应 target；
                                               越小越灵敏，越大越稳定 */
+    /* v5 追加字段（尾部扩展；0 = AQUA_PLC_REPEAT） */
+    int32_t plc_mode; /* aqua_plc_mode_t */
+    /* v6 追加字段（尾部扩展；清零即 core 默认：时间伸缩开、漂移补偿关） */
+    int32_t disable_time_stretch; /* 0/1：1 = 自适应 target 整拍跳变，不做时间伸缩 */
+    int32_t drift_compensation; /* 0/1：1 = 开启时钟漂移补偿（JB 出队速率 + 重采样，
+                                   出队路径多一级重采样，不再零拷贝直通） */
 } aqua_client_config_t;
 
 /* 用默认值填充 config。调用方随后可覆盖所需字段再 start()。 */
@@ -188,8 +200,15 @@ AQUA_API const char* aqua_client_last_error(const aqua_client_t* client);
  *   rb_rearms：pre-roll latch 重臂累计次数（饥饿 3 连空仓或低水位看门狗触发），
  *             每次伴随一次短静音，是运行点自愈频率的直接指标。
  *   short/long_slope_samples_per_s：缓冲占用斜率（样本/秒，短/长窗口）。
- *   end_to_end_ms：端到端缓冲延迟（JB + RB，无需时间同步）。
- *   drift_ppm：server 发送速率 vs 客户端播放速率的时钟漂移（ppm，正 = server 偏快）。 */
+ *   end_to_end_ms：端到端缓冲延迟（JB + RB + 设备缓冲，无需时间同步）。
+ *   device_delay_ms：播放设备缓冲延迟（ALSA snd_pcm_delay；其余后端为 0）。
+ *   drift_ppm：server 发送速率 vs 客户端播放速率的时钟漂移（ppm，正 = server 偏快）。
+ *   sched_wakeup_*_us：最近一个诊断周期内 JB 出队调度唤醒迟到的 p50 / p99 / max（us；
+ *                      pull 播放模式无调度唤醒，为 0）。
+ *   thread_policy_failures / memory_locked：运行时线程调度策略与内存锁定的结果
+ *                      （失败只告警，不影响播放；未配置时为 0）。
+ *   startup_*_ms：本会话启动时间线，各阶段距会话开始的时长（ms；0 = 未到达 / 回放模式跳过）。
+ *                 startup_first_audible_ms 即 time-to-first-audio（首个非静音块交给设备）。 */
 typedef struct aqua_diagnostics {
     /* Network */
     double rtt_ms;
@@ -229,6 +248,28 @@ typedef struct aqua_diagnostics {
     /* v2 追加字段（尾部扩展，ABI 兼容：老调用方 memset(0) 初始化后按值读取） */
     double jb_target_ms; /* 当前自适应 target（actual，ms） */
     uint64_t rb_rearms; /* pre-roll latch 重臂累计次数 */
+
+    /* v3 追加字段 */
+    double device_delay_ms; /* 播放设备缓冲延迟（ms） */
+
+    /* v4 追加字段 */
+    double sched_wakeup_p50_us; /* 调度唤醒迟到 p50（us，本诊断周期） */
+    double sched_wakeup_p99_us; /* 调度唤醒迟到 p99 */
+    double sched_wakeup_max_us; /* 调度唤醒迟到最大值 */
+
+    /* v5 追加字段 */
+    uint32_t thread_policy_failures; /* 线程调度策略 / 亲和性 / 内存锁定失败累计次数（非致命） */
+    int32_t memory_locked; /* 0/1：进程内存已 mlockall 锁定 */
+
+    /* v6 追加字段：启动时间线（ms，距会话开始） */
+    double startup_channel_ready_ms; /* gRPC 通道就绪 */
+    double startup_connected_ms; /* Connect RPC 返回 */
+    double startup_udp_bound_ms; /* 本地 UDP 绑定 */
+    double startup_device_opened_ms; /* 播放后端创建 */
+    double startup_playback_started_ms; /* 播放设备启动 */
+    double startup_hello_acked_ms; /* 首个 HELLO_ACK */
+    double startup_first_audio_ms; /* 首个音频包 */
+    double startup_first_audible_ms; /* 首个非静音块交给设备（time-to-first-audio） */
 } aqua_diagnostics_t;
 
 /* 获取客户端最近一次诊断快照并写入 out（按值拷贝，线程安全）。
@@ -6,6 +6,128 @@
 
 namespace aqua {
 
+namespace {
+
+    std::optional<audio::PlaybackSink> parse_playback_sink(const std::string& value)
+    {
+        if (value == "device") {
+            return audio::PlaybackSink::Device;
+        }
+        if (value == "null") {
+            return audio::PlaybackSink::Null;
+        }
+        if (value == "file") {
+            return audio::PlaybackSink::File;
+        }
+        if (value == "stdout") {
+            return audio::PlaybackSink::Stdout;
+        }
+        return std::nullopt;
+    }
+
+    // 播放去向参数。只做范围校验；文件能否创建由 core 在 start() 时判定。
+    bool parse_playback_options(const cxxopts::ParseResult& parsed, audio::PlaybackSinkConfig& playback,
+        std::string& error)
+    {
+        const auto sink_name = parsed["playback-sink"].as<std::string>();
+        const auto sink = parse_playback_sink(sink_name);
+        if (!sink) {
+            error = "Invalid --playback-sink '" + sink_name + "' (expected: device/null/file/stdout)";
+            return false;
+        }
+        playback.sink = *sink;
+        playback.path = parsed["playback-file"].as<std::string>();
+        if (playback.sink == audio::PlaybackSink::File && playback.path.empty()) {
+            error = "--playback-sink file requires --playback-file";
+            return false;
+        }
+
+        // 周期 [1, 1000] ms，漂移 [-1000, 1000] ppm
+        const auto period = parsed["playback-period"].as<long long>();
+        if (period < 1 || period > 1000) {
+            error = "--playback-period must be in range 1..1000 (ms)";
+            return false;
+        }
+        playback.period = std::chrono::milliseconds(period);
+
+        playback.drift_ppm = parsed["playback-drift-ppm"].as<double>();
+        if (!(playback.drift_ppm >= -audio::MAX_PLAYBACK_DRIFT_PPM
+                && playback.drift_ppm <= audio::MAX_PLAYBACK_DRIFT_PPM)) {
+            error = "--playback-drift-ppm must be in range -1000..1000";
+            return false;
+        }
+
+        // 模拟设备格式：空 / 0 = 跟随服务端格式；声道 [0, 8]，采样率 0 或 [8000, 384000]
+        const auto encoding_name = parsed["playback-encoding"].as<std::string>();
+        if (!encoding_name.empty()) {
+            const auto encoding = parse_encoding_name(encoding_name);
+            if (!encoding) {
+                error = "Invalid --playback-encoding '" + encoding_name + "' (expected: s16/s24/s32/f32/u8)";
+                return false;
+            }
+            playback.encoding = *encoding;
+        }
+        const auto channels = parsed["playback-channels"].as<long long>();
+        if (channels < 0 || channels > 8) {
+            error = "--playback-channels must be in range 0..8";
+            return false;
+        }
+        playback.channels = static_cast<std::uint32_t>(channels);
+        const auto rate = parsed["playback-rate"].as<long long>();
+        if (rate != 0 && (rate < 8000 || rate > 384000)) {
+            error = "--playback-rate must be 0 or in range 8000..384000 (Hz)";
+            return false;
+        }
+        playback.sample_rate = static_cast<std::uint32_t>(rate);
+        return true;
+    }
+
+    // 混音增益：[0, MIX_MAX_GAIN] 的线性倍数，拒绝尾随字符。
+    std::optional<float> parse_gain(const std::string& value)
+    {
+        try {
+            std::size_t pos = 0;
+            const float gain = std::stof(value, &pos);
+            if (pos != value.size() || !(gain >= 0.0f && gain <= config::MIX_MAX_GAIN)) {
+                return std::nullopt;
+            }
+            return gain;
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+
+    // --mix-server IP[:PORT][@GAIN]。IPv6 地址含多个冒号时不拆端口（用默认端口）。
+    bool parse_mix_server(const std::string& value, MixServerSpec& spec, std::string& error)
+    {
+        std::string host = value;
+        if (const auto at = host.rfind('@'); at != std::string::npos) {
+            const auto gain = parse_gain(host.substr(at + 1));
+            if (!gain) {
+                error = "--mix-server gain in '" + value + "' must be in range 0..4";
+                return false;
+            }
+            spec.gain = *gain;
+            host.resize(at);
+        }
+        if (const auto colon = host.find(':'); colon != std::string::npos && host.find(':', colon + 1) == std::string::npos) {
+            const auto port = parse_port(host.substr(colon + 1), "--mix-server port", error);
+            if (!port) {
+                return false;
+            }
+            spec.rpc_port = *port;
+            host.resize(colon);
+        }
+        if (host.empty()) {
+            error = "--mix-server '" + value + "' is missing the server IP";
+            return false;
+        }
+        spec.ip = host;
+        return true;
+    }
+
+} // namespace
+
 ClientCliResult parse_client_command_line(int argc, const char* const* argv)
 {
     cxxopts::Options options("aqua_client", "Aqua audio sharing client");
@@ -16,7 +138,7 @@ ClientCliResult parse_client_command_line(int argc, const char* const* argv)
 
     // 注意：数值选项使用 long long 而非 uint32_t/std::size_t，
     // 避免负数经 std::stoul 解析为 ULONG_MAX 后截断溢出。
-    options.add_options()("s,server-ip", "Server IP address", cxxopts::value<std::string>()->default_value("127.0.0.1"))("p,server-rpc-port", "Server gRPC port", cxxopts::value<std::string>()->default_value("50051"))("jitter-buffer", "JitterBuffer total capacity in ms; floor/ceiling auto-derived from it (0 = default 30)", cxxopts::value<long long>()->default_value("0"))("jitter-detect-window", "Jitter detect window in packets; smaller = more reactive, larger = more stable (0 = default 500)", cxxopts::value<long long>()->default_value("0"))("playback-buffer", "Playback RingBuffer size in bytes (0 = default 16384)", cxxopts::value<long long>()->default_value("0"))("auto-reconnect", "Auto-reconnect to server with exponential backoff (default: off)")("l,log-level", "Log level: trace/debug/info/warn/error (default: debug in debug build, info in release)", cxxopts::value<std::string>())("h,help", "Print usage")("v,version", "Print version");
+    options.add_options()("s,server-ip", "Server IP address", cxxopts::value<std::string>()->default_value("127.0.0.1"))("p,server-rpc-port", "Server gRPC port", cxxopts::value<std::string>()->default_value("50051"))("jitter-buffer", "JitterBuffer total capacity in ms; floor/ceiling auto-derived from it (0 = default 30)", cxxopts::value<long long>()->default_value("0"))("jitter-detect-window", "Jitter detect window in packets; smaller = more reactive, larger = more stable (0 = default 500)", cxxopts::value<long long>()->default_value("0"))("jitter-estimator", "Adaptive target estimator: late (late-count AIMD) / histogram (arrival-delay quantile) (default: late)", cxxopts::value<std::string>()->default_value("late"))("playback-buffer", "Playback RingBuffer size in bytes (0 = default 16384)", cxxopts::value<long long>()->default_value("0"))("plc", "Packet loss concealment: repeat/waveform (default: repeat)", cxxopts::value<std::string>()->default_value("repeat"))("no-time-stretch", "Adjust adaptive latency by jumping a whole packet instead of time-stretching playout (default: time-stretch)")("drift-compensation", "Enable clock drift compensation (JB playout rate + adaptive resampling); adds a resampling stage to the playout path (default: off, rely on rebase / re-arm)")("no-dither", "Disable TPDF dither when format conversion reduces sample resolution")("playout", "Playout scheduling: timer (io-thread timer feeds a playback RingBuffer) / pull (device callback pulls the jitter buffer directly) / thread (dedicated high-resolution scheduler thread feeds the RingBuffer) (default: timer)", cxxopts::value<std::string>()->default_value("timer"))("playout-realtime", "Run the --playout thread scheduler at real-time priority (shortcut for --thread-policy scheduler=fifo:70; needs CAP_SYS_NICE / rtprio limit)")("thread-policy", "Per-thread scheduling, repeatable: ROLE=POLICY[:PRIORITY][@CPUS], ROLE = session/io/playback/scheduler, POLICY = default/fifo/rr (priority 1..99), CPUS e.g. 0,2-3", cxxopts::value<std::vector<std::string>>())("lock-memory", "Lock process memory (mlockall) and prefault thread stacks; failures are logged, not fatal")("auto-reconnect", "Auto-reconnect to server with exponential backoff (default: off)")("capture-file", "Record every received UDP datagram with its arrival time to this file", cxxopts::value<std::string>()->default_value(""))("replay-file", "Replay a capture file through the receive path with original timing instead of connecting to a server", cxxopts::value<std::string>()->default_value(""))("mix-server", "Also subscribe to this server and mix its stream into playback, repeatable (up to 8): IP[:PORT][@GAIN], same sample rate as the primary server", cxxopts::value<std::vector<std::string>>())("gain", "Linear mix gain of the primary server stream, 0..4 (default: 1)", cxxopts::value<std::string>()->default_value("1"))("playback-sink", "Playback sink: device/null/file/stdout (default: device)", cxxopts::value<std::string>()->default_value("device"))("playback-file", "File sink: output WAV path", cxxopts::value<std::string>()->default_value(""))("playback-period", "Headless sink callback period in ms", cxxopts::value<long long>()->default_value("10"))("playback-drift-ppm", "Headless sink clock offset in ppm (+ = plays fast)", cxxopts::value<double>()->default_value("0"))("playback-encoding", "Headless sink device encoding: s16/s24/s32/f32/u8 (empty = server format)", cxxopts::value<std::string>()->default_value(""))("playback-channels", "Headless sink device channel count (0 = server format)", cxxopts::value<long long>()->default_value("0"))("playback-rate", "Headless sink device sample rate in Hz (0 = server format)", cxxopts::value<long long>()->default_value("0"))("l,log-level", "Log level: trace/debug/info/warn/error (default: debug in debug build, info in release)", cxxopts::value<std::string>())("h,help", "Print usage")("v,version", "Print version");
 
     ClientCliResult result;
     try {
@@ -82,7 +204,91 @@ ClientCliResult parse_client_command_line(int argc, const char* const* argv)
         }
         result.playback_buffer_size = static_cast<std::size_t>(playback_buffer);
 
+        const auto estimator = parse_jitter_estimator_name(parsed["jitter-estimator"].as<std::string>());
+        if (!estimator) {
+            result.error_message = "Invalid --jitter-estimator '" + parsed["jitter-estimator"].as<std::string>()
+                + "' (expected: late/histogram)";
+            return result;
+        }
+        result.jitter_estimator = *estimator;
+
+        const auto plc = parse_plc_mode_name(parsed["plc"].as<std::string>());
+        if (!plc) {
+            result.error_message = "Invalid --plc '" + parsed["plc"].as<std::string>() + "' (expected: repeat/waveform)";
+            return result;
+        }
+        result.plc_mode = *plc;
+
+        const auto playout = parsed["playout"].as<std::string>();
+        if (playout == "timer") {
+            result.playout_mode = config::PlayoutMode::Timer;
+        } else if (playout == "pull") {
+            result.playout_mode = config::PlayoutMode::Pull;
+        } else if (playout == "thread") {
+            result.playout_mode = config::PlayoutMode::Thread;
+        } else {
+            result.error_message = "Invalid --playout '" + playout + "' (expected: timer/pull/thread)";
+            return result;
+        }
+        result.playout_realtime = parsed.count("playout-realtime") > 0;
+        if (result.playout_realtime && result.playout_mode != config::PlayoutMode::Thread) {
+            result.error_message = "--playout-realtime requires --playout thread";
+            return result;
+        }
+        if (parsed.count("thread-policy") > 0
+            && !parse_thread_policies(parsed["thread-policy"].as<std::vector<std::string>>(),
+                { config::ThreadRole::Session, config::ThreadRole::Io, config::ThreadRole::Playback,
+                    config::ThreadRole::Scheduler },
+                result.thread_policies, result.error_message)) {
+            return result;
+        }
+        const auto& scheduler_policy = result.thread_policies[static_cast<std::size_t>(config::ThreadRole::Scheduler)];
+        if ((scheduler_policy.policy != config::SchedPolicy::Default || scheduler_policy.cpu_mask != 0)
+            && result.playout_mode != config::PlayoutMode::Thread) {
+            result.error_message = "--thread-policy scheduler=... requires --playout thread";
+            return result;
+        }
+        result.lock_memory = parsed.count("lock-memory") > 0;
+
+        result.time_stretch = parsed.count("no-time-stretch") == 0;
+        result.drift_compensation = parsed.count("drift-compensation") > 0;
+        result.dither = parsed.count("no-dither") == 0;
         result.auto_reconnect = parsed.count("auto-reconnect") > 0;
+        result.capture_file = parsed["capture-file"].as<std::string>();
+        result.replay_file = parsed["replay-file"].as<std::string>();
+        if (!result.replay_file.empty() && result.auto_reconnect) {
+            result.error_message = "--replay-file cannot be combined with --auto-reconnect";
+            return result;
+        }
+
+        const auto gain = parse_gain(parsed["gain"].as<std::string>());
+        if (!gain) {
+            result.error_message = "--gain must be in range 0..4";
+            return result;
+        }
+        result.gain = *gain;
+        if (parsed.count("mix-server") > 0) {
+            const auto specs = parsed["mix-server"].as<std::vector<std::string>>();
+            if (specs.size() > config::MIX_MAX_SOURCES) {
+                result.error_message = "--mix-server can be given at most 8 times";
+                return result;
+            }
+            for (const auto& value : specs) {
+                MixServerSpec spec;
+                if (!parse_mix_server(value, spec, result.error_message)) {
+                    return result;
+                }
+                result.mix_servers.push_back(std::move(spec));
+            }
+            if (!result.replay_file.empty()) {
+                result.error_message = "--replay-file cannot be combined with --mix-server";
+                return result;
+            }
+        }
+
+        if (!parse_playback_options(parsed, result.playback, result.error_message)) {
+            return result;
+        }
 
         if (parsed.count("log-level") > 0) {
             auto lvl = log_level_from_string(parsed["log-level"].as<std::string>());
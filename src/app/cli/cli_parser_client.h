@@ -1,8 +1,11 @@
 #ifndef AQUA_CLI_PARSER_CLIENT_H
 #define AQUA_CLI_PARSER_CLIENT_H
 
+#include "core/audio/backend/audio_backend_factory.h"
 #include "core/logger/logger.h"
+#include "core/public/config.h"
 
+#include <array>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -10,6 +13,13 @@
 
 namespace aqua {
 
+// --mix-server IP[:PORT][@GAIN]：附加订阅的服务器
+struct MixServerSpec {
+    std::string ip;
+    uint16_t rpc_port = 50051;
+    float gain = 1.0f;
+};
+
 struct ClientCliResult {
     bool success = false;
     bool show_help = false;
@@ -24,10 +34,36 @@ struct ClientCliResult {
     // 抖动检测窗口（包数）：窗口满时评估 drift rebase 与自适应 target
     // （0 = 用 config.h 默认值 500 包）
     uint32_t jitter_detect_window_packets = 0;
+    // 自适应 target 估计器（--jitter-estimator late/histogram），默认 late
+    config::JitterEstimator jitter_estimator = config::JitterEstimator::LateCount;
+    // 丢包隐藏算法（--plc repeat/waveform），默认 repeat
+    config::PlcMode plc_mode = config::PlcMode::Repeat;
+    // 自适应 target 经时间伸缩平滑调整（--no-time-stretch 关闭，改为 deadline 整拍跳变）
+    bool time_stretch = true;
+    // 时钟漂移补偿（--drift-compensation 开启；默认关，保留零拷贝出队直通）
+    bool drift_compensation = false;
+    // 格式转换降低分辨率时加 TPDF 抖动（--no-dither 关闭）
+    bool dither = true;
+    // 播放调度（--playout timer/pull/thread），默认 timer
+    config::PlayoutMode playout_mode = config::PlayoutMode::Timer;
+    // thread 调度线程请求实时优先级（--playout-realtime）
+    bool playout_realtime = false;
+    // 线程调度策略（--thread-policy，角色 session/io/playback/scheduler）与内存锁定（--lock-memory）
+    std::array<config::ThreadPolicy, config::THREAD_ROLE_COUNT> thread_policies { };
+    bool lock_memory = false;
     // 播放 RingBuffer 大小（字节，0 = 用 config.h 默认值）
     std::size_t playback_buffer_size = 0;
     // 断线自动重连（指数退避），默认关闭
     bool auto_reconnect = false;
+    // 数据面抓包文件（--capture-file），空 = 不抓包
+    std::string capture_file;
+    // 回放抓包文件代替连接服务器（--replay-file），空 = 正常连接
+    std::string replay_file;
+    // 多服务器混音：附加订阅的服务器（--mix-server，可重复）与主服务器流增益（--gain）
+    std::vector<MixServerSpec> mix_servers;
+    float gain = 1.0f;
+    // 播放去向（--playback-sink 等）。默认平台设备；其余去向不依赖声卡。
+    audio::PlaybackSinkConfig playback;
     // 日志等级。默认用编译期 default_log_level()；--log-level 覆盖。
     LogLevel log_level = default_log_level();
 };
@@ -1,9 +1,18 @@
 #ifndef AQUA_CLI_PARSER_COMMON_H
 #define AQUA_CLI_PARSER_COMMON_H
 
+#include "core/public/audio_format.h"
+#include "core/public/config.h"
+#include "core/rt/thread_policy.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <cstdint>
+#include <initializer_list>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace aqua {
 
@@ -32,6 +41,169 @@ inline std::optional<uint16_t> parse_port(const std::string& value, const std::s
     }
 }
 
+// 解析编码名（s16 / s24 / s32 / f32 / u8，不区分大小写），未知名称返回 std::nullopt。
+inline std::optional<AudioEncoding> parse_encoding_name(std::string value)
+{
+    for (auto& ch : value) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    if (value == "s16") {
+        return AudioEncoding::PcmS16LE;
+    }
+    if (value == "s24") {
+        return AudioEncoding::PcmS24LE;
+    }
+    if (value == "s32") {
+        return AudioEncoding::PcmS32LE;
+    }
+    if (value == "f32") {
+        return AudioEncoding::PcmF32LE;
+    }
+    if (value == "u8") {
+        return AudioEncoding::PcmU8;
+    }
+    return std::nullopt;
+}
+
+// 解析自适应 target 估计器名（late / histogram），未知名称返回 std::nullopt。
+// cli_parser_client.cpp 与 cli_parser_jbsim.cpp 共用。
+inline std::optional<config::JitterEstimator> parse_jitter_estimator_name(const std::string& value)
+{
+    if (value == "late") {
+        return config::JitterEstimator::LateCount;
+    }
+    if (value == "histogram") {
+        return config::JitterEstimator::Histogram;
+    }
+    return std::nullopt;
+}
+
+// 解析丢包隐藏算法名（repeat / waveform），未知名称返回 std::nullopt。
+inline std::optional<config::PlcMode> parse_plc_mode_name(const std::string& value)
+{
+    if (value == "repeat") {
+        return config::PlcMode::Repeat;
+    }
+    if (value == "waveform") {
+        return config::PlcMode::Waveform;
+    }
+    return std::nullopt;
+}
+
+// 解析 CPU 列表（"0,2-3"，CPU 编号 0..63）为亲和性位掩码。格式非法或为空返回 std::nullopt。
+inline std::optional<std::uint64_t> parse_cpu_list(const std::string& value)
+{
+    std::uint64_t mask = 0;
+    std::size_t begin = 0;
+    while (begin <= value.size()) {
+        const auto end = std::min(value.find(',', begin), value.size());
+        const auto item = value.substr(begin, end - begin);
+        const auto dash = item.find('-');
+        const auto parse_cpu = [](const std::string& text) -> std::optional<int> {
+            if (text.empty() || text.size() > 2) {
+                return std::nullopt;
+            }
+            int cpu = 0;
+            for (const char ch : text) {
+                if (!std::isdigit(static_cast<unsigned char>(ch))) {
+                    return std::nullopt;
+                }
+                cpu = cpu * 10 + (ch - '0');
+            }
+            return cpu < 64 ? std::optional<int>(cpu) : std::nullopt;
+        };
+        const auto first = parse_cpu(item.substr(0, dash));
+        const auto last = dash == std::string::npos ? first : parse_cpu(item.substr(dash + 1));
+        if (!first || !last || *first > *last) {
+            return std::nullopt;
+        }
+        for (int cpu = *first; cpu <= *last; ++cpu) {
+            mask |= std::uint64_t { 1 } << cpu;
+        }
+        begin = end + 1;
+    }
+    return mask;
+}
+
+// 解析 --thread-policy 取值 ROLE=POLICY[:PRIORITY][@CPUS]（可重复，后者覆盖同一角色），写入 policies。
+//   POLICY：default / fifo / rr；fifo 与 rr 必须给出 PRIORITY（1..99），default 不接受 PRIORITY。
+//   CPUS：CPU 列表（见 parse_cpu_list），省略 = 不设亲和性。
+// roles 为该前端存在的线程角色（服务端 / 客户端各不相同）。失败时填充 error 并返回 false。
+// cli_parser_client.cpp 与 cli_parser_server.cpp 共用。
+inline bool parse_thread_policies(const std::vector<std::string>& specs,
+    std::initializer_list<config::ThreadRole> roles,
+    std::array<config::ThreadPolicy, config::THREAD_ROLE_COUNT>& policies,
+    std::string& error)
+{
+    std::string role_names;
+    for (const auto role : roles) {
+        role_names += (role_names.empty() ? "" : "/") + std::string(rt::thread_role_name(role));
+    }
+
+    for (const auto& spec : specs) {
+        const auto invalid = [&](const std::string& why) {
+            error = "Invalid --thread-policy '" + spec + "': " + why;
+            return false;
+        };
+        const auto eq = spec.find('=');
+        if (eq == std::string::npos) {
+            return invalid("expected ROLE=POLICY[:PRIORITY][@CPUS]");
+        }
+        const auto role_name = spec.substr(0, eq);
+        const config::ThreadRole* role = nullptr;
+        for (const auto& r : roles) {
+            if (role_name == rt::thread_role_name(r)) {
+                role = &r;
+            }
+        }
+        if (!role) {
+            return invalid("unknown role '" + role_name + "' (expected: " + role_names + ")");
+        }
+
+        auto rest = spec.substr(eq + 1);
+        config::ThreadPolicy policy;
+        if (const auto at = rest.find('@'); at != std::string::npos) {
+            const auto mask = parse_cpu_list(rest.substr(at + 1));
+            if (!mask) {
+                return invalid("CPU list must look like 0,2-3 (CPUs 0..63)");
+            }
+            policy.cpu_mask = *mask;
+            rest.resize(at);
+        }
+        const auto colon = rest.find(':');
+        const auto policy_name = rest.substr(0, colon);
+        if (policy_name == "fifo") {
+            policy.policy = config::SchedPolicy::Fifo;
+        } else if (policy_name == "rr") {
+            policy.policy = config::SchedPolicy::RoundRobin;
+        } else if (policy_name != "default") {
+            return invalid("unknown policy '" + policy_name + "' (expected: default/fifo/rr)");
+        }
+        if (policy.policy == config::SchedPolicy::Default) {
+            if (colon != std::string::npos) {
+                return invalid("policy 'default' takes no priority");
+            }
+        } else {
+            const auto prio = colon == std::string::npos ? std::string { } : rest.substr(colon + 1);
+            try {
+                std::size_t pos = 0;
+                policy.priority = std::stoi(prio, &pos);
+                if (pos != prio.size()) {
+                    return invalid("priority must be an integer");
+                }
+            } catch (const std::exception&) {
+                return invalid("fifo/rr require a priority, e.g. fifo:80");
+            }
+            if (policy.priority < config::THREAD_POLICY_MIN_PRIORITY
+                || policy.priority > config::THREAD_POLICY_MAX_PRIORITY) {
+                return invalid("priority must be in range 1..99");
+            }
+        }
+        policies[static_cast<std::size_t>(*role)] = policy;
+    }
+    return true;
+}
+
 } // namespace aqua
 
 #endif // AQUA_CLI_PARSER_COMMON_H
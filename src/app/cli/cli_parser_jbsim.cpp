@@ -0,0 +1,196 @@
+#include "app/cli/cli_parser_jbsim.h"
+#include "app/cli/cli_parser_common.h"
+
+#include <cxxopts.hpp>
+#include <sstream>
+
+namespace aqua {
+
+namespace {
+
+    // 读取 long long 选项并校验 [min, max]，失败时填充 error。
+    bool parse_ranged(const cxxopts::ParseResult& parsed, const std::string& name, long long min, long long max,
+        uint32_t& out, std::string& error)
+    {
+        const long long value = parsed[name].as<long long>();
+        if (value < min || value > max) {
+            error = "--" + name + " must be in range " + std::to_string(min) + ".." + std::to_string(max);
+            return false;
+        }
+        out = static_cast<uint32_t>(value);
+        return true;
+    }
+
+    // 可选 double 覆盖项：给出时校验 [min, max] 并写入 out。
+    bool override_double(const cxxopts::ParseResult& parsed, const std::string& name, double min, double max,
+        double& out, std::string& error)
+    {
+        if (parsed.count(name) == 0) {
+            return true;
+        }
+        const double value = parsed[name].as<double>();
+        if (!(value >= min && value <= max)) {
+            error = "--" + name + " must be in range " + std::to_string(min) + ".." + std::to_string(max);
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    // 逗号分隔的 jitter-buffer 列表（ms），每项 1..10000。
+    bool parse_jitter_buffer_list(const std::string& value, std::vector<uint32_t>& out, std::string& error)
+    {
+        out.clear();
+        std::stringstream ss(value);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            try {
+                std::size_t pos = 0;
+                const long long ms = std::stoll(item, &pos);
+                if (pos != item.size() || ms < 1 || ms > 10000) {
+                    throw std::out_of_range(item);
+                }
+                out.push_back(static_cast<uint32_t>(ms));
+            } catch (const std::exception&) {
+                error = "--jitter-buffer must be a comma-separated list of values in range 1..10000";
+                return false;
+            }
+        }
+        if (out.empty()) {
+            error = "--jitter-buffer must not be empty";
+            return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+JbsimCliResult parse_jbsim_command_line(int argc, const char* const* argv)
+{
+    cxxopts::Options options("aqua_jbsim", "Offline JitterBuffer simulator (virtual clock, synthetic or recorded arrival traces)");
+
+    // 不接受任何位置参数：所有参数必须是 --option 形式。
+    options.positional_help("");
+    options.parse_positional({ });
+
+    // 数值选项使用 long long，理由同 cli_parser_client.cpp（负数不被 stoul 回绕）。
+    options.add_options()("profile", "Network profile: lan/wifi/wifi-psm/cellular/lossy (default: wifi)", cxxopts::value<std::string>()->default_value("wifi"))("trace", "Recorded arrival trace file (\"<arrival_us> <sequence>\" per line); overrides --profile", cxxopts::value<std::string>()->default_value(""))("duration", "Synthetic trace duration in seconds", cxxopts::value<long long>()->default_value("600"))("seed", "Random seed for the synthetic trace", cxxopts::value<long long>()->default_value("1"))("base-delay", "Override: one-way base delay in ms", cxxopts::value<double>())("pareto-scale", "Override: Pareto jitter scale in ms (0 = no jitter)", cxxopts::value<double>())("pareto-shape", "Override: Pareto jitter shape (smaller = heavier tail)", cxxopts::value<double>())("ge-p", "Override: Gilbert-Elliott good->bad transition probability", cxxopts::value<double>())("ge-r", "Override: Gilbert-Elliott bad->good transition probability", cxxopts::value<double>())("ge-loss-good", "Override: loss probability in the good state", cxxopts::value<double>())("ge-loss-bad", "Override: loss probability in the bad state", cxxopts::value<double>())("psm-interval", "Override: Wi-Fi power-save wake interval in ms (0 = off)", cxxopts::value<double>())("drift-ppm", "Override: sender clock offset in ppm (+ = sender fast)", cxxopts::value<double>())("sample-rate", "Sample rate in Hz", cxxopts::value<long long>()->default_value("48000"))("frames-per-packet", "Frames per packet", cxxopts::value<long long>()->default_value(std::to_string(config::AUDIO_FRAMES_PER_PACKET)))("jitter-buffer", "JitterBuffer capacity in ms, comma-separated to compare several (default: 30)", cxxopts::value<std::string>()->default_value(std::to_string(config::DEFAULT_JITTER_BUFFER_MS)))("jitter-detect-window", "Jitter detect window in packets (0 = default 500)", cxxopts::value<long long>()->default_value("0"))("jitter-estimator", "Adaptive target estimator: late/histogram (default: late)", cxxopts::value<std::string>()->default_value("late"))("plc", "Packet loss concealment: repeat/waveform (default: repeat)", cxxopts::value<std::string>()->default_value("repeat"))("no-time-stretch", "Adjust adaptive latency by jumping a whole packet instead of time-stretching playout")("l,log-level", "Log level: trace/debug/info/warn/error (default: warn)", cxxopts::value<std::string>())("h,help", "Print usage")("v,version", "Print version");
+
+    JbsimCliResult result;
+    try {
+        auto parsed = options.parse(argc, argv);
+
+        if (parsed.count("help") > 0) {
+            std::ostringstream oss;
+            oss << options.help();
+            result.show_help = true;
+            result.help_message = oss.str();
+            result.success = true;
+            return result;
+        }
+
+        if (parsed.count("version") > 0) {
+            result.show_version = true;
+            result.success = true;
+            return result;
+        }
+
+        if (!parsed.unmatched().empty()) {
+            result.error_message = "Unknown argument(s): "
+                + parsed.unmatched()[0]
+                + "\nUse --help to see usage.";
+            return result;
+        }
+
+        result.profile = parsed["profile"].as<std::string>();
+        const auto preset = jbsim::network_profile_preset(result.profile);
+        if (!preset) {
+            result.error_message = "Invalid --profile '" + result.profile
+                + "' (expected: lan/wifi/wifi-psm/cellular/lossy)";
+            return result;
+        }
+        result.network = *preset;
+        result.trace_file = parsed["trace"].as<std::string>();
+
+        const long long seed = parsed["seed"].as<long long>();
+        if (seed < 0) {
+            result.error_message = "--seed must be >= 0";
+            return result;
+        }
+        result.network.seed = static_cast<std::uint64_t>(seed);
+
+        auto& net = result.network;
+        if (!override_double(parsed, "base-delay", 0.0, 10000.0, net.base_delay_ms, result.error_message)
+            || !override_double(parsed, "pareto-scale", 0.0, 10000.0, net.pareto_scale_ms, result.error_message)
+            || !override_double(parsed, "pareto-shape", 0.1, 100.0, net.pareto_shape, result.error_message)
+            || !override_double(parsed, "ge-p", 0.0, 1.0, net.ge_good_to_bad, result.error_message)
+            || !override_double(parsed, "ge-r", 0.0, 1.0, net.ge_bad_to_good, result.error_message)
+            || !override_double(parsed, "ge-loss-good", 0.0, 1.0, net.ge_loss_good, result.error_message)
+            || !override_double(parsed, "ge-loss-bad", 0.0, 1.0, net.ge_loss_bad, result.error_message)
+            || !override_double(parsed, "psm-interval", 0.0, 10000.0, net.psm_interval_ms, result.error_message)
+            || !override_double(parsed, "drift-ppm", -10000.0, 10000.0, net.drift_ppm, result.error_message)) {
+            return result;
+        }
+
+        // duration 上限一周：合成 trace 常驻内存（3ms 包约 2 亿个到达事件）
+        if (!parse_ranged(parsed, "duration", 1, 604800, result.duration_s, result.error_message)
+            || !parse_ranged(parsed, "sample-rate", 8000, 384000, result.sample_rate, result.error_message)
+            || !parse_ranged(parsed, "frames-per-packet", 1, 8192, result.frames_per_packet, result.error_message)
+            || !parse_ranged(parsed, "jitter-detect-window", 0, 100000, result.jitter_detect_window_packets,
+                result.error_message)) {
+            return result;
+        }
+
+        if (!parse_jitter_buffer_list(parsed["jitter-buffer"].as<std::string>(), result.jitter_buffer_ms,
+                result.error_message)) {
+            return result;
+        }
+
+        const auto estimator = parse_jitter_estimator_name(parsed["jitter-estimator"].as<std::string>());
+        if (!estimator) {
+            result.error_message = "Invalid --jitter-estimator '" + parsed["jitter-estimator"].as<std::string>()
+                + "' (expected: late/histogram)";
+            return result;
+        }
+        result.jitter_estimator = *estimator;
+
+        const auto plc = parse_plc_mode_name(parsed["plc"].as<std::string>());
+        if (!plc) {
+            result.error_message = "Invalid --plc '" + parsed["plc"].as<std::string>() + "' (expected: repeat/waveform)";
+            return result;
+        }
+        result.plc_mode = *plc;
+        result.time_stretch = parsed.count("no-time-stretch") == 0;
+
+        if (parsed.count("log-level") > 0) {
+            auto lvl = log_level_from_string(parsed["log-level"].as<std::string>());
+            if (!lvl) {
+                result.error_message = "Invalid --log-level '" + parsed["log-level"].as<std::string>()
+                    + "' (expected: trace/debug/info/warn/error)";
+                return result;
+            }
+            result.log_level = *lvl;
+        }
+
+        result.success = true;
+        return result;
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        result.error_message = std::string("Argument parse error: ") + e.what()
+            + "\nUse --help to see usage.";
+        return result;
+    }
+}
+
+JbsimCliResult parse_jbsim_command_line(const std::vector<std::string>& args)
+{
+    std::vector<const char*> argv;
+    argv.reserve(args.size() + 1);
+    argv.push_back("aqua_jbsim");
+    for (const auto& arg : args) {
+        argv.push_back(arg.c_str());
+    }
+    return parse_jbsim_command_line(static_cast<int>(argv.size()), argv.data());
+}
+
+} // namespace aqua
@@ -0,0 +1,46 @@
+#ifndef AQUA_CLI_PARSER_JBSIM_H
+#define AQUA_CLI_PARSER_JBSIM_H
+
+#include "core/jbsim/arrival_trace.h"
+#include "core/logger/logger.h"
+#include "core/public/config.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace aqua {
+
+struct JbsimCliResult {
+    bool success = false;
+    bool show_help = false;
+    bool show_version = false;
+    std::string help_message;
+    std::string error_message;
+
+    // 到达 trace：trace_file 非空时读录制 trace，否则按 network（预置剖面 + 单项覆盖）合成
+    std::string profile = "wifi";
+    jbsim::NetworkProfile network;
+    std::string trace_file;
+    // 合成 trace 的时长（秒）
+    uint32_t duration_s = 600;
+
+    uint32_t sample_rate = 48000;
+    uint32_t frames_per_packet = config::AUDIO_FRAMES_PER_PACKET;
+    // 待比较的 jitter-buffer 取值（ms），每个值跑一遍、输出一行
+    std::vector<uint32_t> jitter_buffer_ms { config::DEFAULT_JITTER_BUFFER_MS };
+    uint32_t jitter_detect_window_packets = 0; // 0 = config 默认
+    config::JitterEstimator jitter_estimator = config::JitterEstimator::LateCount;
+    config::PlcMode plc_mode = config::PlcMode::Repeat;
+    bool time_stretch = true;
+
+    // 日志等级。默认 warn：JB 的 rebase / target 调整日志会淹没结果行；--log-level 覆盖。
+    LogLevel log_level = LogLevel::Warn;
+};
+
+JbsimCliResult parse_jbsim_command_line(int argc, const char* const* argv);
+JbsimCliResult parse_jbsim_command_line(const std::vector<std::string>& args);
+
+} // namespace aqua
+
+#endif // AQUA_CLI_PARSER_JBSIM_H
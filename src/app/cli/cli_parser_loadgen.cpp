@@ -0,0 +1,119 @@
+#include "app/cli/cli_parser_loadgen.h"
+#include "app/cli/cli_parser_common.h"
+
+#include <cxxopts.hpp>
+#include <sstream>
+
+namespace aqua {
+
+namespace {
+
+    // 读取 long long 选项并校验 [min, max]，失败时填充 error。
+    bool parse_ranged(const cxxopts::ParseResult& parsed, const std::string& name, long long min, long long max,
+        uint32_t& out, std::string& error)
+    {
+        const long long value = parsed[name].as<long long>();
+        if (value < min || value > max) {
+            error = "--" + name + " must be in range " + std::to_string(min) + ".." + std::to_string(max);
+            return false;
+        }
+        out = static_cast<uint32_t>(value);
+        return true;
+    }
+
+} // namespace
+
+LoadgenCliResult parse_loadgen_command_line(int argc, const char* const* argv)
+{
+    cxxopts::Options options("aqua_loadgen", "Aqua server load generator (simulated client sessions)");
+
+    // 不接受任何位置参数：所有参数必须是 --option 形式。
+    options.positional_help("");
+    options.parse_positional({ });
+
+    // 数值选项使用 long long，理由同 cli_parser_client.cpp（负数不被 stoul 回绕）。
+    options.add_options()("s,server-ip", "Server IP address", cxxopts::value<std::string>()->default_value("127.0.0.1"))("p,server-rpc-port", "Server gRPC port", cxxopts::value<std::string>()->default_value("50051"))("n,sessions", "Target number of simulated sessions", cxxopts::value<long long>()->default_value("100"))("ramp-step", "Sessions added per ramp step", cxxopts::value<long long>()->default_value("10"))("step-seconds", "Measurement window per ramp step in seconds", cxxopts::value<long long>()->default_value("5"))("io-threads", "UDP receive threads (0 = hardware concurrency)", cxxopts::value<long long>()->default_value("0"))("connect-concurrency", "Concurrent Connect RPCs while ramping", cxxopts::value<long long>()->default_value("16"))("client-name", "Client name prefix reported to the server", cxxopts::value<std::string>()->default_value("aqua_loadgen"))("l,log-level", "Log level: trace/debug/info/warn/error (default: warn)", cxxopts::value<std::string>())("h,help", "Print usage")("v,version", "Print version");
+
+    LoadgenCliResult result;
+    try {
+        auto parsed = options.parse(argc, argv);
+
+        if (parsed.count("help") > 0) {
+            std::ostringstream oss;
+            oss << options.help();
+            result.show_help = true;
+            result.help_message = oss.str();
+            result.success = true;
+            return result;
+        }
+
+        if (parsed.count("version") > 0) {
+            result.show_version = true;
+            result.success = true;
+            return result;
+        }
+
+        if (!parsed.unmatched().empty()) {
+            result.error_message = "Unknown argument(s): "
+                + parsed.unmatched()[0]
+                + "\nUse --help to see usage.";
+            return result;
+        }
+
+        result.server_ip = parsed["server-ip"].as<std::string>();
+
+        auto rpc_port = parse_port(parsed["server-rpc-port"].as<std::string>(), "--server-rpc-port",
+            result.error_message);
+        if (!rpc_port.has_value()) {
+            return result;
+        }
+        result.server_rpc_port = rpc_port.value();
+
+        // sessions 上限受每会话一个 UDP socket（fd）约束；io-threads / 并发度给出防呆上限。
+        if (!parse_ranged(parsed, "sessions", 1, 100000, result.sessions, result.error_message)
+            || !parse_ranged(parsed, "ramp-step", 1, 100000, result.ramp_step, result.error_message)
+            || !parse_ranged(parsed, "step-seconds", 1, 3600, result.step_seconds, result.error_message)
+            || !parse_ranged(parsed, "io-threads", 0, 256, result.io_threads, result.error_message)
+            || !parse_ranged(parsed, "connect-concurrency", 1, 1024, result.connect_concurrency,
+                result.error_message)) {
+            return result;
+        }
+
+        result.client_name = parsed["client-name"].as<std::string>();
+        if (result.client_name.empty()) {
+            result.error_message = "--client-name must not be empty";
+            return result;
+        }
+
+        if (parsed.count("log-level") > 0) {
+            auto lvl = log_level_from_string(parsed["log-level"].as<std::string>());
+            if (!lvl) {
+                result.error_message = "Invalid --log-level '" + parsed["log-level"].as<std::string>()
+                    + "' (expected: trace/debug/info/warn/error)";
+                return result;
+            }
+            result.log_level = *lvl;
+        }
+
+        result.success = true;
+        return result;
+
+    } catch (const cxxopts::exceptions::exception& e) {
+        result.error_message = std::string("Argument parse error: ") + e.what()
+            + "\nUse --help to see usage.";
+        return result;
+    }
+}
+
+LoadgenCliResult parse_loadgen_command_line(const std::vector<std::string>& args)
+{
+    std::vector<const char*> argv;
+    argv.reserve(args.size() + 1);
+    argv.push_back("aqua_loadgen");
+    for (const auto& arg : args) {
+        argv.push_back(arg.c_str());
+    }
+    return parse_loadgen_command_line(static_cast<int>(argv.size()), argv.data());
+}
+
+} // namespace aqua
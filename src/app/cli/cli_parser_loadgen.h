@@ -0,0 +1,39 @@
+#ifndef AQUA_CLI_PARSER_LOADGEN_H
+#define AQUA_CLI_PARSER_LOADGEN_H
+
+#include "core/logger/logger.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace aqua {
+
+struct LoadgenCliResult {
+    bool success = false;
+    bool show_help = false;
+    bool show_version = false;
+    std::string help_message;
+    std::string error_message;
+    std::string server_ip = "127.0.0.1";
+    uint16_t server_rpc_port = 50051;
+    // 目标会话数与爬坡步长（每步新增会话数）
+    uint32_t sessions = 100;
+    uint32_t ramp_step = 10;
+    // 每步测量时长（秒）
+    uint32_t step_seconds = 5;
+    // UDP 分片线程数（0 = 硬件并发数）
+    uint32_t io_threads = 0;
+    // 并发 Connect RPC 数
+    uint32_t connect_concurrency = 16;
+    std::string client_name = "aqua_loadgen";
+    // 日志等级。默认 warn：数千会话的逐会话 Connect 日志会淹没步报告；--log-level 覆盖。
+    LogLevel log_level = LogLevel::Warn;
+};
+
+LoadgenCliResult parse_loadgen_command_line(int argc, const char* const* argv);
+LoadgenCliResult parse_loadgen_command_line(const std::vector<std::string>& args);
+
+} // namespace aqua
+
+#endif // AQUA_CLI_PARSER_LOADGEN_H
@@ -6,6 +6,94 @@
 
 namespace aqua {
 
+namespace {
+
+    std::optional<audio::CaptureSource> parse_capture_source(const std::string& value)
+    {
+        if (value == "device") {
+            return audio::CaptureSource::Device;
+        }
+        if (value == "file") {
+            return audio::CaptureSource::File;
+        }
+        if (value == "pipe") {
+            return audio::CaptureSource::Pipe;
+        }
+        if (value == "sine") {
+            return audio::CaptureSource::Sine;
+        }
+        if (value == "noise") {
+            return audio::CaptureSource::Noise;
+        }
+        if (value == "impulse") {
+            return audio::CaptureSource::Impulse;
+        }
+        return std::nullopt;
+    }
+
+    // 采集来源参数。只做范围校验；来源能否打开（文件存在等）由 core 在 start() 时判定。
+    bool parse_capture_options(const cxxopts::ParseResult& parsed, audio::CaptureSourceConfig& capture,
+        std::string& error)
+    {
+        const auto source_name = parsed["capture-source"].as<std::string>();
+        const auto source = parse_capture_source(source_name);
+        if (!source) {
+            error = "Invalid --capture-source '" + source_name
+                + "' (expected: device/file/pipe/sine/noise/impulse)";
+            return false;
+        }
+        capture.source = *source;
+        capture.path = parsed["capture-path"].as<std::string>();
+        if (capture.source == audio::CaptureSource::File && capture.path.empty()) {
+            error = "--capture-source file requires --capture-path";
+            return false;
+        }
+
+        const auto encoding_name = parsed["capture-encoding"].as<std::string>();
+        const auto encoding = parse_encoding_name(encoding_name);
+        if (!encoding) {
+            error = "Invalid --capture-encoding '" + encoding_name + "' (expected: s16/s24/s32/f32/u8)";
+            return false;
+        }
+        capture.format.encoding = *encoding;
+
+        // 采样率 [8000, 384000]，声道 [1, 8]，周期 [1, 1000] ms
+        const auto rate = parsed["capture-rate"].as<long long>();
+        if (rate < 8000 || rate > 384000) {
+            error = "--capture-rate must be in range 8000..384000 (Hz)";
+            return false;
+        }
+        capture.format.sample_rate = static_cast<std::uint32_t>(rate);
+
+        const auto channels = parsed["capture-channels"].as<long long>();
+        if (channels < 1 || channels > 8) {
+            error = "--capture-channels must be in range 1..8";
+            return false;
+        }
+        capture.format.channels = static_cast<std::uint32_t>(channels);
+
+        const auto period = parsed["capture-period"].as<long long>();
+        if (period < 1 || period > 1000) {
+            error = "--capture-period must be in range 1..1000 (ms)";
+            return false;
+        }
+        capture.period = std::chrono::milliseconds(period);
+
+        capture.frequency_hz = parsed["signal-frequency"].as<double>();
+        if (!(capture.frequency_hz > 0.0) || capture.frequency_hz > capture.format.sample_rate / 2.0) {
+            error = "--signal-frequency must be in range (0, sample_rate/2]";
+            return false;
+        }
+        capture.amplitude = parsed["signal-amplitude"].as<double>();
+        if (!(capture.amplitude >= 0.0 && capture.amplitude <= 1.0)) {
+            error = "--signal-amplitude must be in range 0..1";
+            return false;
+        }
+        return true;
+    }
+
+} // namespace
+
 ServerCliResult parse_server_command_line(int argc, const char* const* argv)
 {
     cxxopts::Options options("aqua_server", "Aqua audio sharing server");
@@ -15,7 +103,7 @@ ServerCliResult parse_server_command_line(int argc, const char* const* argv)
     options.positional_help("");
     options.parse_positional({ });
 
-    options.add_options()("b,bind-ip", "Bind IP address", cxxopts::value<std::string>()->default_value("0.0.0.0"))("r,rpc-port", "gRPC port", cxxopts::value<std::string>()->default_value("50051"))("u,udp-port", "UDP media port", cxxopts::value<std::string>()->default_value("50000"))("capture-buffer", "Capture RingBuffer size in bytes (0 = default 8192)", cxxopts::value<long long>()->default_value("0"))("l,log-level", "Log level: trace/debug/info/warn/error (default: debug in debug build, info in release)", cxxopts::value<std::string>())("h,help", "Print usage")("v,version", "Print version");
+    options.add_options()("b,bind-ip", "Bind IP address", cxxopts::value<std::string>()->default_value("0.0.0.0"))("r,rpc-port", "gRPC port", cxxopts::value<std::string>()->default_value("50051"))("u,udp-port", "UDP media port", cxxopts::value<std::string>()->default_value("50000"))("capture-buffer", "Capture RingBuffer size in bytes (0 = default 8192)", cxxopts::value<long long>()->default_value("0"))("capture-source", "Capture source: device/file/pipe/sine/noise/impulse (default: device)", cxxopts::value<std::string>()->default_value("device"))("capture-path", "File source: WAV/raw path; pipe source: FIFO path ('-' or empty = stdin)", cxxopts::value<std::string>()->default_value(""))("capture-encoding", "Headless source encoding: s16/s24/s32/f32/u8 (WAV files use their header)", cxxopts::value<std::string>()->default_value("f32"))("capture-rate", "Headless source sample rate in Hz", cxxopts::value<long long>()->default_value("48000"))("capture-channels", "Headless source channel count", cxxopts::value<long long>()->default_value("2"))("capture-period", "Headless source callback period in ms", cxxopts::value<long long>()->default_value("10"))("signal-frequency", "Sine frequency / impulse rate in Hz", cxxopts::value<double>()->default_value("440"))("signal-amplitude", "Signal peak amplitude (0..1)", cxxopts::value<double>()->default_value("0.5"))("thread-policy", "Per-thread scheduling, repeatable: ROLE=POLICY[:PRIORITY][@CPUS], ROLE = grpc/io/sender/capture, POLICY = default/fifo/rr (priority 1..99), CPUS e.g. 0,2-3", cxxopts::value<std::vector<std::string>>())("lock-memory", "Lock process memory (mlockall) and prefault thread stacks; failures are logged, not fatal")("l,log-level", "Log level: trace/debug/info/warn/error (default: debug in debug build, info in release)", cxxopts::value<std::string>())("h,help", "Print usage")("v,version", "Print version");
 
     ServerCliResult result;
     try {
@@ -67,6 +155,19 @@ ServerCliResult parse_server_command_line(int argc, const char* const* argv)
         }
         result.capture_buffer_size = static_cast<std::size_t>(capture_buf);
 
+        if (!parse_capture_options(parsed, result.capture, result.error_message)) {
+            return result;
+        }
+
+        if (parsed.count("thread-policy") > 0
+            && !parse_thread_policies(parsed["thread-policy"].as<std::vector<std::string>>(),
+                { config::ThreadRole::Grpc, config::ThreadRole::Io, config::ThreadRole::Sender,
+                    config::ThreadRole::Capture },
+                result.thread_policies, result.error_message)) {
+            return result;
+        }
+        result.lock_memory = parsed.count("lock-memory") > 0;
+
         if (parsed.count("log-level") > 0) {
             auto lvl = log_level_from_string(parsed["log-level"].as<std::string>());
             if (!lvl) {
@@ -1,8 +1,11 @@
 #ifndef AQUA_CLI_PARSER_SERVER_H
 #define AQUA_CLI_PARSER_SERVER_H
 
+#include "core/audio/backend/audio_backend_factory.h"
 #include "core/logger/logger.h"
+#include "core/public/config.h"
 
+#include <array>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -21,6 +24,11 @@ struct ServerCliResult {
     uint16_t udp_port = 50000;
     // 采集 RingBuffer 大小（字节，0 = 用 config.h 默认值）
     std::size_t capture_buffer_size = 0;
+    // 采集来源（--capture-source 等）。默认平台设备；其余来源不依赖声卡。
+    audio::CaptureSourceConfig capture;
+    // 线程调度策略（--thread-policy，角色 grpc/io/sender/capture）与内存锁定（--lock-memory）。
+    std::array<config::ThreadPolicy, config::THREAD_ROLE_COUNT> thread_policies { };
+    bool lock_memory = false;
     // 日志等级。默认用编译期 default_log_level()；--log-level 覆盖。
     LogLevel log_level = default_log_level();
 };
@@ -34,6 +34,10 @@ int main(int argc, char** argv)
         return 0;
     }
 
+    // stdout 承载 PCM 时日志改走 stderr，避免污染音频流。
+    if (parsed.playback.sink == aqua::audio::PlaybackSink::Stdout) {
+        aqua::redirect_log_to_stderr();
+    }
     aqua::set_log_level(parsed.log_level);
 
     // ---- CLI 参数 → 运行时配置（"0 = 用默认值"语义在此解析）----
@@ -41,12 +45,28 @@ int main(int argc, char** argv)
     cfg.server_ip = parsed.server_ip;
     cfg.server_rpc_port = parsed.server_rpc_port;
     cfg.auto_reconnect = parsed.auto_reconnect;
+    cfg.playback = parsed.playback;
+    cfg.capture_path = parsed.capture_file;
+    cfg.replay_path = parsed.replay_file;
+    for (const auto& mix : parsed.mix_servers) {
+        cfg.mix_sources.push_back({ mix.ip, mix.rpc_port, mix.gain });
+    }
+    cfg.mix_gain = parsed.gain;
     if (parsed.jitter_buffer_ms > 0) {
         cfg.runtime.jitter_buffer_ms = parsed.jitter_buffer_ms;
     }
     if (parsed.jitter_detect_window_packets > 0) {
         cfg.runtime.jitter_detect_window_packets = parsed.jitter_detect_window_packets;
     }
+    cfg.runtime.jitter_estimator = parsed.jitter_estimator;
+    cfg.runtime.plc_mode = parsed.plc_mode;
+    cfg.runtime.time_stretch = parsed.time_stretch;
+    cfg.runtime.drift_compensation = parsed.drift_compensation;
+    cfg.runtime.dither = parsed.dither;
+    cfg.runtime.playout_mode = parsed.playout_mode;
+    cfg.runtime.playout_realtime = parsed.playout_realtime;
+    cfg.runtime.thread_policies = parsed.thread_policies;
+    cfg.runtime.lock_memory = parsed.lock_memory;
     if (parsed.playback_buffer_size > 0) {
         cfg.runtime.playback_ringbuffer_size = parsed.playback_buffer_size;
     }
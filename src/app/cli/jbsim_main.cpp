@@ -0,0 +1,113 @@
+#include "app/cli/cli_parser_jbsim.h"
+#include "app/cli/cli_version.h"
+#include "core/jbsim/arrival_trace.h"
+#include "core/jbsim/jb_simulator.h"
+#include "core/logger/logger.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// 结果是本工具的主输出：直接写 stdout（不受 --log-level 影响），每个运行点一行 key=value。
+void print_report(std::uint32_t jitter_buffer_ms, const aqua::jbsim::SimReport& r)
+{
+    const auto dist = [](const char* name, const aqua::jbsim::Distribution& d) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(2)
+            << " " << name << "_mean=" << d.mean
+            << " " << name << "_p50=" << d.p50
+            << " " << name << "_p95=" << d.p95
+            << " " << name << "_p99=" << d.p99
+            << " " << name << "_max=" << d.max;
+        return oss.str();
+    };
+    std::cout << std::fixed << std::setprecision(2)
+              << "jitter_buffer=" << jitter_buffer_ms << "ms"
+              << " arrived=" << r.packets_arrived
+              << " played=" << r.blocks_played
+              << " concealed=" << r.blocks_concealed
+              << " concealed_pct=" << r.concealed_pct << "%"
+              << " late=" << r.late_packets
+              << " duplicates=" << r.duplicates
+              << " rebases=" << r.rebases
+              << dist("latency_ms", r.latency_ms)
+              << dist("conceal_run", r.conceal_run_blocks)
+              << dist("target_ms", r.target_ms)
+              << " simulated=" << r.simulated_s << "s"
+              << " wall=" << std::setprecision(3) << r.wall_s << "s"
+              << " speedup=" << std::setprecision(0) << (r.wall_s > 0.0 ? r.simulated_s / r.wall_s : 0.0) << "x"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto parsed = aqua::parse_jbsim_command_line(argc, argv);
+
+    if (!parsed.success) {
+        std::cerr << "Error: " << parsed.error_message << "\n";
+        return 1;
+    }
+    if (parsed.show_help) {
+        std::cout << parsed.help_message;
+        return 0;
+    }
+    if (parsed.show_version) {
+        std::cout << "aqua_jbsim " << AQUA_JBSIM_CLI_VERSION << "\n";
+        return 0;
+    }
+
+    // 结果行占用 stdout，日志改走 stderr。
+    aqua::redirect_log_to_stderr();
+    aqua::set_log_level(parsed.log_level);
+
+    aqua::jbsim::SimConfig cfg;
+    cfg.format = { aqua::AudioEncoding::PcmF32LE, 2, parsed.sample_rate };
+    cfg.frames_per_packet = parsed.frames_per_packet;
+    if (parsed.jitter_detect_window_packets > 0) {
+        cfg.detect_window_packets = parsed.jitter_detect_window_packets;
+    }
+    cfg.estimator = parsed.jitter_estimator;
+    cfg.plc_mode = parsed.plc_mode;
+    cfg.time_stretch = parsed.time_stretch;
+    const auto packet_duration = std::chrono::nanoseconds(
+        static_cast<std::int64_t>(parsed.frames_per_packet) * 1'000'000'000 / parsed.sample_rate);
+
+    std::vector<aqua::jbsim::Arrival> trace;
+    if (!parsed.trace_file.empty()) {
+        std::ifstream in(parsed.trace_file);
+        if (!in) {
+            std::cerr << "Error: cannot open trace file '" << parsed.trace_file << "'\n";
+            return 1;
+        }
+        std::ostringstream text;
+        text << in.rdbuf();
+        auto loaded = aqua::jbsim::parse_trace(text.str(), packet_duration);
+        if (!loaded) {
+            std::cerr << "Error: malformed trace file '" << parsed.trace_file
+                      << "' (expected \"<arrival_us> <sequence>\" per line)\n";
+            return 1;
+        }
+        trace = std::move(*loaded);
+    } else {
+        const auto packets = static_cast<std::uint32_t>(
+            std::chrono::nanoseconds(std::chrono::seconds(parsed.duration_s)) / packet_duration);
+        trace = aqua::jbsim::generate_trace(parsed.network, packets, packet_duration);
+    }
+
+    try {
+        for (const auto ms : parsed.jitter_buffer_ms) {
+            cfg.jitter_buffer_ms = ms;
+            print_report(ms, aqua::jbsim::simulate(cfg, trace));
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
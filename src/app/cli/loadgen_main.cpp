@@ -0,0 +1,86 @@
+#include "app/cli/cli_parser_loadgen.h"
+#include "app/cli/cli_version.h"
+#include "core/loadgen/load_generator.h"
+#include "core/logger/logger.h"
+
+#include <atomic>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+// 信号处理只做原子置位（signal-safe），由 LoadGenerator::run(stop_when) 轮询感知。
+std::atomic<bool> g_stop { false };
+
+void signal_handler(int)
+{
+    g_stop = true;
+}
+
+// 步报告是本工具的主输出：直接写 stdout（不受 --log-level 影响），一步一行便于 grep / 绘图。
+void print_step(const aqua::loadgen::StepReport& r)
+{
+    std::cout << std::fixed << std::setprecision(2)
+              << "step=" << r.step
+              << " sessions=" << r.sessions_active
+              << " failed=" << r.sessions_failed
+              << " fanout_pps=" << r.fanout_packets_per_s
+              << " fanout_mbps=" << r.fanout_mbps
+              << " delivery=" << r.delivery_ratio
+              << " loss_mean=" << r.loss_mean_pct << "%"
+              << " loss_max=" << r.loss_max_pct << "%"
+              << " jitter_mean=" << r.jitter_mean_ms << "ms"
+              << " jitter_max=" << r.jitter_max_ms << "ms"
+              << " skew_p50=" << r.skew_p50_ms << "ms"
+              << " skew_p99=" << r.skew_p99_ms << "ms"
+              << " skew_max=" << r.skew_max_ms << "ms"
+              << " connect_p50=" << r.connect_p50_ms << "ms"
+              << " connect_p90=" << r.connect_p90_ms << "ms"
+              << " connect_p99=" << r.connect_p99_ms << "ms"
+              << " connect_max=" << r.connect_max_ms << "ms"
+              << std::endl;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto parsed = aqua::parse_loadgen_command_line(argc, argv);
+
+    if (!parsed.success) {
+        std::cerr << "Error: " << parsed.error_message << "\n";
+        return 1;
+    }
+    if (parsed.show_help) {
+        std::cout << parsed.help_message;
+        return 0;
+    }
+    if (parsed.show_version) {
+        std::cout << "aqua_loadgen " << AQUA_LOADGEN_CLI_VERSION << "\n";
+        return 0;
+    }
+
+    // 步报告占用 stdout，日志改走 stderr。
+    aqua::redirect_log_to_stderr();
+    aqua::set_log_level(parsed.log_level);
+
+    aqua::loadgen::LoadGenConfig cfg;
+    cfg.server_ip = parsed.server_ip;
+    cfg.server_rpc_port = parsed.server_rpc_port;
+    cfg.sessions = parsed.sessions;
+    cfg.ramp_step = parsed.ramp_step;
+    cfg.step_duration = std::chrono::seconds(parsed.step_seconds);
+    cfg.io_threads = parsed.io_threads;
+    cfg.connect_concurrency = parsed.connect_concurrency;
+    cfg.client_name = parsed.client_name;
+
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    aqua::loadgen::LoadGenerator generator;
+    const bool ok = generator.run(cfg, print_step, [] { return g_stop.load(); });
+    if (!ok) {
+        std::cerr << "Error: " << generator.last_error() << "\n";
+        return 1;
+    }
+    return 0;
+}
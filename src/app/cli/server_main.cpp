@@ -44,6 +44,9 @@ int main(int argc, char** argv)
     if (parsed.capture_buffer_size > 0) {
         cfg.runtime.capture_ringbuffer_size = parsed.capture_buffer_size;
     }
+    cfg.capture = parsed.capture;
+    cfg.runtime.thread_policies = parsed.thread_policies;
+    cfg.runtime.lock_memory = parsed.lock_memory;
 
     // ---- 启动并运行（编排逻辑全部在 core 的 ServerRuntime 内）----
     aqua::server::ServerRuntime runtime;
@@ -10,7 +10,7 @@ namespace aqua::audio {
 namespace {
 
     // core AudioEncoding → AAudio 格式。不支持的返回 AAUDIO_FORMAT_UNSPECIFIED。
-    // 注意：AAudio 不支持 packed S24LE；S24/S32/U8 需客户端格式转换（AGENT.md §14）。
+    // 注意：AAudio 不支持 packed S24LE；S24/S32/U8 经 negotiate_format 转为 F32。
     aaudio_format_t to_aaudio_format(AudioEncoding encoding) noexcept
     {
         switch (encoding) {
@@ -30,6 +30,16 @@ AaudioPlayback::~AaudioPlayback()
     stop();
 }
 
+AudioFormat AaudioPlayback::negotiate_format(const AudioFormat& requested)
+{
+    AudioFormat result = requested;
+    if (requested.valid() && to_aaudio_format(requested.encoding) == AAUDIO_FORMAT_UNSPECIFIED) {
+        // float 不损失 S24 精度；S32 低 8 位本就超出 DAC 有效位
+        result.encoding = AudioEncoding::PcmF32LE;
+    }
+    return result;
+}
+
 bool AaudioPlayback::start(AudioFormat format, FillCallback cb)
 {
     if (stream_ != nullptr) {
@@ -26,7 +26,8 @@ namespace aqua::audio {
 //   - stop(): requestStop → close → delete builder。
 //
 // 格式支持：F32LE → AAUDIO_FORMAT_PCM_FLOAT，S16LE → AAUDIO_FORMAT_PCM_I16。
-// 其余编码（S24/S32/U8）返回 unsupported（客户端格式转换见 AGENT.md §14，后续实现）。
+// 其余编码（S24/S32/U8）start() 返回 unsupported；negotiate_format 把它们映射为 F32，
+// 由客户端格式转换级转换。
 class AaudioPlayback final : public PlaybackBackend {
 public:
     AaudioPlayback() = default;
@@ -36,6 +37,8 @@ public:
     void stop() override;
     bool is_running() const override;
 
+    AudioFormat negotiate_format(const AudioFormat& requested) override;
+
 private:
     static aaudio_data_callback_result_t on_data_callback(AAudioStream* stream,
         void* user_data,
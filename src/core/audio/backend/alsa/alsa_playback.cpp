@@ -0,0 +1,377 @@
+#include "core/audio/backend/alsa/alsa_playback.h"
+
+#include "core/logger/logger.h"
+
+#include <alsa/asoundlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace aqua::audio {
+
+namespace {
+    // 设备 buffer 预算下限：低于 2 个 4ms period 时多数 hw 拒绝或频繁 xrun。
+    constexpr std::chrono::microseconds MIN_LATENCY_HINT { 8000 };
+    // 每个设备 buffer 的 period 数（唤醒次数）。
+    constexpr unsigned int PERIODS_PER_BUFFER = 4;
+    // snd_pcm_wait 超时：保证 stop() 请求最多延迟这么久被感知。
+    constexpr int WAIT_TIMEOUT_MS = 100;
+
+    snd_pcm_format_t to_alsa_format(AudioEncoding encoding) noexcept
+    {
+        switch (encoding) {
+        case AudioEncoding::PcmF32LE:
+            return SND_PCM_FORMAT_FLOAT_LE;
+        case AudioEncoding::PcmS16LE:
+            return SND_PCM_FORMAT_S16_LE;
+        case AudioEncoding::PcmS24LE:
+            return SND_PCM_FORMAT_S24_3LE; // packed 3 字节，与 AudioFormat 一致
+        case AudioEncoding::PcmS32LE:
+            return SND_PCM_FORMAT_S32_LE;
+        case AudioEncoding::PcmU8:
+            return SND_PCM_FORMAT_U8;
+        case AudioEncoding::Invalid:
+            break;
+        }
+        return SND_PCM_FORMAT_UNKNOWN;
+    }
+
+    // 请求编码不可用时的回退顺序：精度从高到低。
+    constexpr AudioEncoding FALLBACK_ENCODINGS[] = {
+        AudioEncoding::PcmF32LE,
+        AudioEncoding::PcmS32LE,
+        AudioEncoding::PcmS24LE,
+        AudioEncoding::PcmS16LE,
+        AudioEncoding::PcmU8,
+    };
+} // namespace
+
+AlsaPlayback::AlsaPlayback(std::string device)
+    : device_(std::move(device))
+{
+}
+
+AlsaPlayback::~AlsaPlayback()
+{
+    stop();
+}
+
+void AlsaPlayback::set_latency_hint(std::chrono::microseconds budget)
+{
+    latency_hint_ = std::max(budget, MIN_LATENCY_HINT);
+}
+
+void AlsaPlayback::set_underrun_callback(UnderrunCallback cb)
+{
+    underrun_callback_ = std::move(cb);
+}
+
+std::uint32_t AlsaPlayback::device_delay_frames() const
+{
+    return delay_frames_.load(std::memory_order_relaxed);
+}
+
+AudioFormat AlsaPlayback::negotiate_format(const AudioFormat& requested)
+{
+    if (pcm_ != nullptr || !requested.valid()) {
+        return requested;
+    }
+
+    snd_pcm_t* probe = nullptr;
+    int err = snd_pcm_open(&probe, device_.c_str(), SND_PCM_STREAM_PLAYBACK, SND_PCM_NONBLOCK);
+    if (err < 0) {
+        return requested; // 打不开由 start() 报告
+    }
+
+    AudioFormat result = requested;
+    snd_pcm_hw_params_t* hw = nullptr;
+    snd_pcm_hw_params_alloca(&hw);
+    if (snd_pcm_hw_params_any(probe, hw) < 0
+        || snd_pcm_hw_params_set_access(probe, hw, SND_PCM_ACCESS_MMAP_INTERLEAVED) < 0) {
+        snd_pcm_close(probe);
+        return requested;
+    }
+
+    if (snd_pcm_hw_params_test_format(probe, hw, to_alsa_format(requested.encoding)) != 0) {
+        for (const auto enc : FALLBACK_ENCODINGS) {
+            if (snd_pcm_hw_params_test_format(probe, hw, to_alsa_format(enc)) == 0) {
+                result.encoding = enc;
+                break;
+            }
+        }
+    }
+    snd_pcm_hw_params_set_format(probe, hw, to_alsa_format(result.encoding));
+
+    if (snd_pcm_hw_params_test_channels(probe, hw, requested.channels) != 0) {
+        unsigned int min_ch = 0;
+        unsigned int max_ch = 0;
+        if (snd_pcm_hw_params_get_channels_min(hw, &min_ch) == 0
+            && snd_pcm_hw_params_get_channels_max(hw, &max_ch) == 0 && min_ch > 0) {
+            result.channels = std::clamp(requested.channels, min_ch, std::max(min_ch, max_ch));
+        }
+    }
+    snd_pcm_hw_params_set_channels(probe, hw, result.channels);
+
+    // 采样率：设备（如 hw: 直通、无 plug 层）不支持时取最近的可用值，差异由客户端重采样。
+    if (snd_pcm_hw_params_test_rate(probe, hw, requested.sample_rate, 0) != 0) {
+        unsigned int rate = requested.sample_rate;
+        if (snd_pcm_hw_params_set_rate_near(probe, hw, &rate, nullptr) == 0 && rate > 0) {
+            result.sample_rate = rate;
+        }
+    }
+    snd_pcm_close(probe);
+
+    if (result != requested) {
+        log_info_fmt("ALSA playback: device '{}' prefers {}ch {}Hz encoding={} over {}ch {}Hz encoding={}",
+            device_, result.channels, result.sample_rate, static_cast<int>(result.encoding),
+            requested.channels, requested.sample_rate, static_cast<int>(requested.encoding));
+    }
+    return result;
+}
+
+bool AlsaPlayback::start(AudioFormat format, FillCallback cb)
+{
+    if (pcm_ != nullptr || thread_.joinable()) {
+        return false; // 已启动
+    }
+    if (!format.valid()) {
+        return false;
+    }
+
+    int err = snd_pcm_open(&pcm_, device_.c_str(), SND_PCM_STREAM_PLAYBACK, 0);
+    if (err < 0) {
+        pcm_ = nullptr;
+        log_error_fmt("ALSA playback: cannot open device '{}': {}", device_, snd_strerror(err));
+        return false;
+    }
+    if (!configure(format)) {
+        stop();
+        return false;
+    }
+
+    format_ = format;
+    frame_bytes_ = format.frame_bytes();
+    callback_ = std::move(cb);
+    delay_frames_ = 0;
+    running_ = true;
+    thread_ = std::thread([this] { playback_loop(); });
+
+    log_info_fmt("ALSA playback started on '{}': {}ch {}Hz encoding={}, mmap, period {} frames, buffer {} frames ({:.1f}ms)",
+        device_, format.channels, format.sample_rate, static_cast<int>(format.encoding),
+        period_frames_, buffer_frames_,
+        static_cast<double>(buffer_frames_) * 1000.0 / format.sample_rate);
+    return true;
+}
+
+bool AlsaPlayback::configure(const AudioFormat& format)
+{
+    const snd_pcm_format_t alsa_fmt = to_alsa_format(format.encoding);
+    if (alsa_fmt == SND_PCM_FORMAT_UNKNOWN) {
+        log_error_fmt("ALSA playback: unsupported encoding {}", static_cast<int>(format.encoding));
+        return false;
+    }
+
+    snd_pcm_hw_params_t* hw = nullptr;
+    snd_pcm_hw_params_alloca(&hw);
+    int err = snd_pcm_hw_params_any(pcm_, hw);
+    if (err < 0) {
+        log_error_fmt("ALSA playback: no hw configuration available: {}", snd_strerror(err));
+        return false;
+    }
+    err = snd_pcm_hw_params_set_access(pcm_, hw, SND_PCM_ACCESS_MMAP_INTERLEAVED);
+    if (err < 0) {
+        log_error_fmt("ALSA playback: device '{}' does not support mmap interleaved access "
+                      "(try 'plughw:' or 'default'): {}",
+            device_, snd_strerror(err));
+        return false;
+    }
+    if ((err = snd_pcm_hw_params_set_format(pcm_, hw, alsa_fmt)) < 0
+        || (err = snd_pcm_hw_params_set_channels(pcm_, hw, format.channels)) < 0
+        || (err = snd_pcm_hw_params_set_rate(pcm_, hw, format.sample_rate, 0)) < 0) {
+        // 精确匹配：调用方应先经 negotiate_format 取得设备可用的格式，这里不降级。
+        log_error_fmt("ALSA playback: device rejects {}ch {}Hz encoding={}: {}",
+            format.channels, format.sample_rate, static_cast<int>(format.encoding), snd_strerror(err));
+        return false;
+    }
+
+    // 先定 period 再定 buffer（与 aplay 一致）：near 协商下 period 是更硬的约束。
+    unsigned int period_us = static_cast<unsigned int>(latency_hint_.count()) / PERIODS_PER_BUFFER;
+    unsigned int buffer_us = static_cast<unsigned int>(latency_hint_.count());
+    if ((err = snd_pcm_hw_params_set_period_time_near(pcm_, hw, &period_us, nullptr)) < 0
+        || (err = snd_pcm_hw_params_set_buffer_time_near(pcm_, hw, &buffer_us, nullptr)) < 0) {
+        log_error_fmt("ALSA playback: cannot set period/buffer time: {}", snd_strerror(err));
+        return false;
+    }
+    err = snd_pcm_hw_params(pcm_, hw);
+    if (err < 0) {
+        log_error_fmt("ALSA playback: snd_pcm_hw_params failed: {}", snd_strerror(err));
+        return false;
+    }
+
+    snd_pcm_uframes_t period_size = 0;
+    snd_pcm_uframes_t buffer_size = 0;
+    snd_pcm_hw_params_get_period_size(hw, &period_size, nullptr);
+    snd_pcm_hw_params_get_buffer_size(hw, &buffer_size);
+    period_frames_ = period_size;
+    buffer_frames_ = buffer_size;
+
+    // 软件参数：avail_min = 1 period（每 period 唤醒一次）；start_threshold = boundary，
+    // 由播放线程在首轮填满 buffer 后显式 snd_pcm_start（xrun 恢复后同理）。
+    snd_pcm_sw_params_t* sw = nullptr;
+    snd_pcm_sw_params_alloca(&sw);
+    snd_pcm_uframes_t boundary = 0;
+    if ((err = snd_pcm_sw_params_current(pcm_, sw)) < 0
+        || (err = snd_pcm_sw_params_get_boundary(sw, &boundary)) < 0
+        || (err = snd_pcm_sw_params_set_avail_min(pcm_, sw, period_size)) < 0
+        || (err = snd_pcm_sw_params_set_start_threshold(pcm_, sw, boundary)) < 0
+        || (err = snd_pcm_sw_params(pcm_, sw)) < 0) {
+        log_error_fmt("ALSA playback: cannot set sw params: {}", snd_strerror(err));
+        return false;
+    }
+
+    err = snd_pcm_prepare(pcm_);
+    if (err < 0) {
+        log_error_fmt("ALSA playback: snd_pcm_prepare failed: {}", snd_strerror(err));
+        return false;
+    }
+    return true;
+}
+
+bool AlsaPlayback::recover(int err) noexcept
+{
+    if (err == -EPIPE || err == -ESTRPIPE) {
+        // 硬件 buffer 被放空（或系统挂起）：计入欠载，重新 prepare 后由主循环重新 start。
+        if (err == -EPIPE && underrun_callback_) {
+            underrun_callback_();
+        }
+        if (snd_pcm_recover(pcm_, err, 1) == 0) {
+            return true;
+        }
+    }
+    // 不可恢复（设备被拔出 -ENODEV 等）：线程退出，ClientRuntime 主循环轮询感知。
+    log_error_fmt("ALSA playback: unrecoverable device error: {}", snd_strerror(err));
+    running_.store(false, std::memory_order_release);
+    return false;
+}
+
+void AlsaPlayback::playback_loop()
+{
+    // 统计（每 5 秒输出一次 debug 日志），与 WASAPI 播放后端一致。
+    constexpr auto STATS_INTERVAL = std::chrono::seconds(5);
+    auto last_stats_time = std::chrono::steady_clock::now();
+    std::uint64_t stats_commits = 0;
+    std::uint64_t stats_bytes_filled = 0;
+    std::uint64_t stats_bytes_silent = 0;
+
+    // U8 的零电平是 0x80，其余编码为 0。
+    const int silence = format_.encoding == AudioEncoding::PcmU8 ? 0x80 : 0;
+
+    while (running_.load(std::memory_order_acquire)) {
+        snd_pcm_sframes_t avail = 0;
+        snd_pcm_sframes_t delay = 0;
+        int err = snd_pcm_avail_delay(pcm_, &avail, &delay);
+        if (err < 0) {
+            if (!recover(err)) {
+                break;
+            }
+            continue;
+        }
+        delay_frames_.store(static_cast<std::uint32_t>(std::max<snd_pcm_sframes_t>(delay, 0)),
+            std::memory_order_relaxed);
+
+        if (static_cast<std::uint64_t>(avail) < period_frames_) {
+            err = snd_pcm_wait(pcm_, WAIT_TIMEOUT_MS);
+            if (err < 0 && !recover(err)) {
+                break;
+            }
+            continue;
+        }
+
+        // 写满全部可写空间：mmap 区域可能在 buffer 尾部回绕，分段 begin/commit。
+        auto remaining = static_cast<snd_pcm_uframes_t>(avail);
+        bool failed = false;
+        while (remaining > 0) {
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            snd_pcm_uframes_t frames = remaining;
+            err = snd_pcm_mmap_begin(pcm_, &areas, &offset, &frames);
+            if (err < 0 || frames == 0) {
+                failed = err < 0 && !recover(err);
+                break;
+            }
+
+            // interleaved：所有声道共享 areas[0]，first / step 单位为 bit。
+            auto* dst = static_cast<std::byte*>(areas[0].addr) + (areas[0].first + offset * areas[0].step) / 8;
+            const std::size_t bytes_needed = static_cast<std::size_t>(frames) * frame_bytes_;
+            std::size_t filled = callback_(std::span<std::byte> { dst, bytes_needed });
+            // 防御：FillCallback 契约保证 filled <= bytes_needed，再钳制一次防 memset 下溢。
+            if (filled > bytes_needed) {
+                filled = bytes_needed;
+            }
+            if (filled < bytes_needed) {
+                std::memset(dst + filled, silence, bytes_needed - filled);
+            }
+            stats_bytes_filled += filled;
+            stats_bytes_silent += bytes_needed - filled;
+
+            const snd_pcm_sframes_t committed = snd_pcm_mmap_commit(pcm_, offset, frames);
+            if (committed < 0 || static_cast<snd_pcm_uframes_t>(committed) != frames) {
+                failed = !recover(committed < 0 ? static_cast<int>(committed) : -EPIPE);
+                break;
+            }
+            ++stats_commits;
+            remaining -= frames;
+        }
+        if (failed) {
+            break;
+        }
+
+        // 首轮填满（或 xrun 恢复后重新 prepare）时显式启动。
+        if (snd_pcm_state(pcm_) == SND_PCM_STATE_PREPARED) {
+            err = snd_pcm_start(pcm_);
+            if (err < 0 && !recover(err)) {
+                break;
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_stats_time >= STATS_INTERVAL) {
+            const double elapsed_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                now - last_stats_time)
+                                         .count();
+            log_debug_fmt("ALSA playback stats: {} commits, filled {:.1f} KB, silent {:.1f} KB in {:.2f}s, delay {} frames",
+                stats_commits,
+                static_cast<double>(stats_bytes_filled) / 1024.0,
+                static_cast<double>(stats_bytes_silent) / 1024.0,
+                elapsed_s, delay_frames_.load(std::memory_order_relaxed));
+            stats_commits = 0;
+            stats_bytes_filled = 0;
+            stats_bytes_silent = 0;
+            last_stats_time = now;
+        }
+    }
+    running_.store(false, std::memory_order_release);
+}
+
+void AlsaPlayback::stop()
+{
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (pcm_ != nullptr) {
+        snd_pcm_drop(pcm_);
+        snd_pcm_close(pcm_);
+        pcm_ = nullptr;
+    }
+    callback_ = { };
+    delay_frames_ = 0;
+}
+
+bool AlsaPlayback::is_running() const
+{
+    return running_.load(std::memory_order_acquire);
+}
+
+} // namespace aqua::audio
@@ -0,0 +1,77 @@
+#ifndef AQUA_ALSA_PLAYBACK_H
+#define AQUA_ALSA_PLAYBACK_H
+
+#include "core/audio/backend/audio_backend_factory.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// alsa-lib 前置声明（snd_pcm_t 是 struct _snd_pcm 的 typedef），头文件不引入 asoundlib.h。
+struct _snd_pcm;
+
+namespace aqua::audio {
+
+// Linux ALSA 播放后端（无声音服务器的主机：直连 hw / plughw / dmix）。
+// mmap 模式（SND_PCM_ACCESS_MMAP_INTERLEAVED）：snd_pcm_mmap_begin 取得硬件 buffer 的
+// 可写区域，FillCallback 直接写入（SpscRingBuffer → 设备 buffer，无中转拷贝），
+// snd_pcm_mmap_commit 提交。
+//
+// 设备 buffer / period 由 set_latency_hint 的预算决定：buffer ≈ 预算，period ≈ 预算 / 4
+// （每个 buffer 4 次唤醒，与 WASAPI 共享模式的 buffer / 周期比例相当）。
+// 未给提示时使用 DEFAULT_LATENCY_HINT。
+//
+// 格式协商（negotiate_format）：临时打开设备，用 snd_pcm_hw_params_test_* 探测编码、声道数与采样率；
+// 请求格式不可用时按 F32 → S32 → S24 → S16 → U8 取第一个可用编码，声道数钳到设备范围，
+// 采样率取设备支持的最近值。
+//
+// 线程模型：
+//   - start()/stop() 在调用方线程；设备打开与参数协商在 start() 内同步完成。
+//   - 播放线程：snd_pcm_wait 等待可写空间 → mmap 填充 → commit；每轮更新 snd_pcm_delay。
+//     xrun（-EPIPE）/ 挂起（-ESTRPIPE）经 snd_pcm_recover 恢复并触发 UnderrunCallback，
+//     其余错误视为设备丢失，线程退出（is_running() 返回 false）。
+class AlsaPlayback final : public PlaybackBackend {
+public:
+    static constexpr std::chrono::microseconds DEFAULT_LATENCY_HINT { 20000 };
+
+    // device: ALSA PCM 名称（"default" / "hw:0,0" / "plughw:1" / "null" 等）。
+    explicit AlsaPlayback(std::string device = "default");
+    ~AlsaPlayback() override;
+
+    bool start(AudioFormat format, FillCallback cb) override;
+    void stop() override;
+    bool is_running() const override;
+
+    AudioFormat negotiate_format(const AudioFormat& requested) override;
+    void set_latency_hint(std::chrono::microseconds budget) override;
+    void set_underrun_callback(UnderrunCallback cb) override;
+    std::uint32_t device_delay_frames() const override;
+
+private:
+    bool configure(const AudioFormat& format);
+    void playback_loop();
+    // 播放线程：处理 avail/wait/commit 返回的负错误码。可恢复返回 true。
+    bool recover(int err) noexcept;
+
+    std::string device_;
+    std::chrono::microseconds latency_hint_ { DEFAULT_LATENCY_HINT };
+    _snd_pcm* pcm_ = nullptr;
+    std::thread thread_;
+    FillCallback callback_;
+    UnderrunCallback underrun_callback_;
+    AudioFormat format_ { };
+    std::uint32_t frame_bytes_ = 0;
+    std::uint64_t period_frames_ = 0;
+    std::uint64_t buffer_frames_ = 0;
+
+    // running_: 线程存活标志。start() 置 true；线程因致命错误退出或 stop() 时置 false。
+    std::atomic<bool> running_ { false };
+    // 最近一次 snd_pcm_delay（帧）。播放线程写，主线程诊断读（relaxed）。
+    std::atomic<std::uint32_t> delay_frames_ { 0 };
+};
+
+} // namespace aqua::audio
+
+#endif // AQUA_ALSA_PLAYBACK_H
@@ -1,10 +1,23 @@
 #include "core/audio/backend/audio_backend_factory.h"
 
+#include "core/audio/backend/headless/headless_capture.h"
+#include "core/audio/backend/headless/headless_playback.h"
+#include "core/logger/logger.h"
+
 #if defined(_WIN32)
 #include "core/audio/backend/wasapi/wasapi_capture.h"
 #include "core/audio/backend/wasapi/wasapi_playback.h"
 #elif defined(__ANDROID__)
 #include "core/audio/backend/aaudio/aaudio_playback.h"
+#else
+#if defined(AQUA_HAVE_PIPEWIRE)
+#include "core/audio/backend/pipewire/pipewire_capture.h"
+#include "core/audio/backend/pipewire/pipewire_common.h"
+#include "core/audio/backend/pipewire/pipewire_playback.h"
+#endif
+#if defined(AQUA_HAVE_ALSA)
+#include "core/audio/backend/alsa/alsa_playback.h"
+#endif
 #endif
 
 namespace aqua::audio {
@@ -13,21 +26,100 @@ std::unique_ptr<CaptureBackend> create_capture_backend()
 {
 #if defined(_WIN32)
     return std::make_unique<WasapiCapture>();
+#elif defined(AQUA_HAVE_PIPEWIRE)
+    return std::make_unique<PipewireCapture>();
 #else
     // Android mic 采集（AAudio input）尚未实现，后续里程碑补充。
     return nullptr;
 #endif
 }
 
+std::unique_ptr<CaptureBackend> create_capture_backend(const CaptureSourceConfig& cfg)
+{
+    if (cfg.source == CaptureSource::Device) {
+        return create_capture_backend();
+    }
+
+    // File 来源的格式可由 WAV 头覆盖，但 raw 文件仍需回退格式，统一要求有效。
+    if (!cfg.format.valid() || cfg.period.count() <= 0) {
+        log_error("Headless capture: invalid format or period");
+        return nullptr;
+    }
+
+    switch (cfg.source) {
+    case CaptureSource::File:
+        if (cfg.path.empty()) {
+            log_error("File capture: no path configured");
+            return nullptr;
+        }
+        return std::make_unique<FileCapture>(cfg.path, cfg.format, cfg.period);
+    case CaptureSource::Pipe:
+        return std::make_unique<PipeCapture>(cfg.path, cfg.format, cfg.period);
+    case CaptureSource::Sine:
+    case CaptureSource::Noise:
+    case CaptureSource::Impulse:
+        // 与 CLI 相同的 (0, sample_rate/2] 约束：超过 Nyquist 的正弦会混叠，脉冲串会被钳到每样本一个。
+        if (!(cfg.frequency_hz > 0.0) || cfg.frequency_hz > cfg.format.sample_rate / 2.0) {
+            log_error("Signal capture: frequency must be in range (0, sample_rate/2]");
+            return nullptr;
+        }
+        if (!(cfg.amplitude >= 0.0 && cfg.amplitude <= 1.0)) {
+            log_error("Signal capture: amplitude must be in range 0..1");
+            return nullptr;
+        }
+        return std::make_unique<SignalCapture>(cfg.source, cfg.format, cfg.period,
+            cfg.frequency_hz, cfg.amplitude);
+    case CaptureSource::Device:
+        break;
+    }
+    return nullptr;
+}
+
 std::unique_ptr<PlaybackBackend> create_playback_backend()
 {
 #if defined(_WIN32)
     return std::make_unique<WasapiPlayback>();
 #elif defined(__ANDROID__)
     return std::make_unique<AaudioPlayback>();
+#else
+    // Linux：有 PipeWire 守护进程时走 PipeWire（与桌面其他应用共享 graph）；
+    // 无声音服务器的主机回退 ALSA 直连设备。
+#if defined(AQUA_HAVE_PIPEWIRE)
+#if defined(AQUA_HAVE_ALSA)
+    if (!pipewire::daemon_socket_present()) {
+        log_info("PipeWire daemon not found, using ALSA playback");
+        return std::make_unique<AlsaPlayback>();
+    }
+#endif
+    return std::make_unique<PipewirePlayback>();
+#elif defined(AQUA_HAVE_ALSA)
+    return std::make_unique<AlsaPlayback>();
 #else
     return nullptr;
 #endif
+#endif
+}
+
+std::unique_ptr<PlaybackBackend> create_playback_backend(const PlaybackSinkConfig& cfg)
+{
+    if (cfg.sink == PlaybackSink::Device) {
+        return create_playback_backend();
+    }
+
+    if (cfg.period.count() <= 0) {
+        log_error("Headless playback: invalid period");
+        return nullptr;
+    }
+    if (!(cfg.drift_ppm >= -MAX_PLAYBACK_DRIFT_PPM && cfg.drift_ppm <= MAX_PLAYBACK_DRIFT_PPM)) {
+        log_error_fmt("Headless playback: drift must be within +/-{}ppm", MAX_PLAYBACK_DRIFT_PPM);
+        return nullptr;
+    }
+    if (cfg.sink == PlaybackSink::File && cfg.path.empty()) {
+        log_error("File playback: no path configured");
+        return nullptr;
+    }
+    return std::make_unique<HeadlessPlayback>(cfg.sink, cfg.path, cfg.period, cfg.drift_ppm,
+        cfg.encoding, cfg.channels, cfg.sample_rate);
 }
 
 } // namespace aqua::audio
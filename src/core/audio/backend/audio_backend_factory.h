@@ -2,20 +2,24 @@
 #define AQUA_AUDIO_BACKEND_H
 
 #include "core/public/audio_format.h"
+#include "core/rt/function_ref.h"
 
+#include <chrono>
 #include <cstddef>
-#include <functional>
+#include <cstdint>
 #include <memory>
 #include <span>
+#include <string>
 
 namespace aqua::audio {
 
 // 音频采集后端抽象接口。
 // 回调在音频实时线程触发，遵守 §10/§15.2 约束（无锁、无分配、无阻塞）。
 // 回调内只做 RingBuffer 写入，不直接调用 UDP / SessionManager。
+// 回调是非拥有引用（rt::FunctionRef）：被引用对象须存活至 stop() 返回。
 class CaptureBackend {
 public:
-    using CaptureCallback = std::function<void(std::span<const std::byte> pcm)>;
+    using CaptureCallback = rt::FunctionRef<void(std::span<const std::byte> pcm)>;
 
     virtual ~CaptureBackend() = default;
 
@@ -32,9 +36,12 @@ public:
 // FillCallback 由播放线程调用，填充 out 缓冲，返回实际填充字节数；不足部分播放静音。
 // 契约：返回值必须 <= out.size()（超出会导致调用方静音填充的下溢）。当前调用方
 // （SpscRingBuffer::read）保证满足此契约。
+// 回调是非拥有引用（rt::FunctionRef）：被引用对象须存活至 stop() 返回。
 class PlaybackBackend {
 public:
-    using FillCallback = std::function<std::size_t(std::span<std::byte> out)>;
+    using FillCallback = rt::FunctionRef<std::size_t(std::span<std::byte> out)>;
+    // 设备侧欠载（xrun）通知，在播放线程触发，须满足与 FillCallback 相同的实时约束。
+    using UnderrunCallback = rt::FunctionRef<void()>;
 
     virtual ~PlaybackBackend() = default;
 
@@ -45,11 +52,89 @@ public:
     // 播放线程是否仍在运行。初始化失败或运行时错误后返回 false。
     // 调用方应在主循环中轮询以感知运行时错误（如设备被占用/移除）。
     virtual bool is_running() const = 0;
+
+    // ---- 可选能力（start() 之前设置；默认实现忽略）----
+
+    // 格式协商：返回设备能直接播放、与 requested 最接近的格式（含采样率）。
+    // 调用方按返回值 start()，不一致部分（含采样率转换）由客户端格式转换级（dsp::FormatConverter）补齐。
+    // 探测失败（设备打不开等）时返回 requested，错误留给 start() 报告。默认实现原样返回。
+    virtual AudioFormat negotiate_format(const AudioFormat& requested) { return requested; }
+
+    // 设备缓冲预算：后端据此选择设备 buffer / period 大小（ALSA）。
+    // 共享模式后端（WASAPI / PipeWire / AAudio）由系统决定周期，忽略此提示。
+    virtual void set_latency_hint(std::chrono::microseconds /*budget*/) { }
+    // 设备欠载回调：FillCallback 返回不足之外，硬件 buffer 被放空（xrun）时触发。
+    virtual void set_underrun_callback(UnderrunCallback /*cb*/) { }
+
+    // 设备缓冲中已写入、尚未播出的帧数（ALSA snd_pcm_delay）。任意线程可读；
+    // 不支持的后端返回 0。
+    virtual std::uint32_t device_delay_frames() const { return 0; }
 };
 
+// 采集来源。Device = 平台设备后端（WASAPI loopback）；其余为无设备来源，
+// 供无声卡的 Linux 主机与性能测试使用，按 period 实时节拍回调。
+enum class CaptureSource : std::uint8_t {
+    Device = 0,
+    File, // WAV / raw PCM 文件，到尾部后循环
+    Pipe, // stdin 或 FIFO 的 raw PCM 流（不足一周期时补静音）
+    Sine, // 正弦波
+    Noise, // 白噪声
+    Impulse, // 脉冲串（每 1/frequency_hz 秒一个单样本脉冲）
+};
+
+// 采集来源配置（ServerConfig 携带）。Device 来源忽略其余字段。
+struct CaptureSourceConfig {
+    CaptureSource source = CaptureSource::Device;
+    // 输出格式。File 来源若为 WAV 则以文件头为准；raw 文件 / Pipe 按此格式解释字节流。
+    AudioFormat format { AudioEncoding::PcmF32LE, 2, 48000 };
+    // 回调周期，对应设备后端一次交付的时长（WASAPI 共享模式约 10ms）。
+    std::chrono::microseconds period { 10000 };
+    // File：文件路径；Pipe：FIFO 路径，空或 "-" 表示 stdin。
+    std::string path;
+    // Sine：频率；Impulse：脉冲重复频率。
+    double frequency_hz = 440.0;
+    // 峰值幅度（满量程 = 1.0）。
+    double amplitude = 0.5;
+};
+
+// 播放去向。Device = 平台设备后端；其余为无设备去向（headless 客户端 / 端到端测试），
+// 按 period 实时节拍消费 FillCallback 的数据。
+enum class PlaybackSink : std::uint8_t {
+    Device = 0,
+    Null, // 只消费不输出
+    File, // 写入 WAV 文件（听到了什么：含欠载补的静音）
+    Stdout, // raw PCM 写到标准输出（可接 aplay / ffmpeg）
+};
+
+// 播放去向配置（ClientConfig 携带）。Device 去向忽略其余字段。
+struct PlaybackSinkConfig {
+    PlaybackSink sink = PlaybackSink::Device;
+    // File：输出 WAV 路径。
+    std::string path;
+    // 回调周期，对应设备后端一次拉取的时长。
+    std::chrono::microseconds period { 10000 };
+    // 消费时钟相对标称采样率的偏差（ppm）。正 = 播放偏快（RB 渐空），负 = 偏慢（RB 渐满）。
+    // 用于在无声卡环境复现声卡晶振偏差，验证漂移处理。
+    double drift_ppm = 0.0;
+    // 模拟设备格式（编码 / 声道数 / 采样率）。Invalid / 0 = 跟随服务端格式；设置后 negotiate_format
+    // 返回覆盖后的格式，客户端经格式转换级输出（用于在无声卡环境验证转换路径）。
+    AudioEncoding encoding = AudioEncoding::Invalid;
+    std::uint32_t channels = 0;
+    std::uint32_t sample_rate = 0;
+};
+
+// 可编程漂移上限：±1000ppm 已远超实际声卡晶振偏差（通常 < 100ppm）。
+inline constexpr double MAX_PLAYBACK_DRIFT_PPM = 1000.0;
+
 // 工厂：平台相关，根据编译期宏选择实现。
 std::unique_ptr<CaptureBackend> create_capture_backend();
+// 按来源创建：Device 等价于无参版本；其余来源与平台无关，任何平台均可用。
+// 配置非法（格式无效 / period 为 0 / 频率非正等）时返回 nullptr。
+std::unique_ptr<CaptureBackend> create_capture_backend(const CaptureSourceConfig& cfg);
 std::unique_ptr<PlaybackBackend> create_playback_backend();
+// 按去向创建：Device 等价于无参版本；其余去向与平台无关，任何平台均可用。
+// 配置非法（period 为 0 / File 无路径 / |drift_ppm| 超过 MAX_PLAYBACK_DRIFT_PPM）时返回 nullptr。
+std::unique_ptr<PlaybackBackend> create_playback_backend(const PlaybackSinkConfig& cfg);
 
 } // namespace aqua::audio
 
@@ -0,0 +1,405 @@
+#include "core/audio/backend/headless/headless_capture.h"
+
+#include "core/audio/backend/headless/wav_file.h"
+#include "core/logger/logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numbers>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace aqua::audio {
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    // 落后超过此值时重锚时间线（不突发补发积压周期）。
+    constexpr auto MAX_CATCH_UP = std::chrono::milliseconds(200);
+
+    // 周期统计日志间隔，与 WASAPI 后端一致。
+    constexpr auto STATS_INTERVAL = std::chrono::seconds(5);
+
+    // raw 文件来源的读入上限：整文件驻留内存，防止误指向超大文件。
+    constexpr std::uintmax_t MAX_FILE_BYTES = 512ull * 1024 * 1024;
+
+    // 静音字节：U8 以 0x80 为零点，其余编码为 0。
+    std::byte silence_byte(AudioEncoding encoding) noexcept
+    {
+        return encoding == AudioEncoding::PcmU8 ? std::byte { 0x80 } : std::byte { 0 };
+    }
+
+    // 把 [-1, 1] 浮点样本按编码写入 dst（小端）。超界值饱和。
+    void store_sample(float v, AudioEncoding encoding, std::byte* dst) noexcept
+    {
+        v = std::clamp(v, -1.0f, 1.0f);
+        switch (encoding) {
+        case AudioEncoding::PcmF32LE:
+            std::memcpy(dst, &v, sizeof(v));
+            break;
+        case AudioEncoding::PcmS16LE: {
+            const auto s = static_cast<std::int16_t>(std::lrint(v * 32767.0f));
+            std::memcpy(dst, &s, sizeof(s));
+            break;
+        }
+        case AudioEncoding::PcmS32LE: {
+            const auto s = static_cast<std::int32_t>(std::llrint(static_cast<double>(v) * 2147483647.0));
+            std::memcpy(dst, &s, sizeof(s));
+            break;
+        }
+        case AudioEncoding::PcmS24LE: {
+            const auto s = static_cast<std::int32_t>(std::lrint(v * 8388607.0f));
+            dst[0] = static_cast<std::byte>(s & 0xFF);
+            dst[1] = static_cast<std::byte>((s >> 8) & 0xFF);
+            dst[2] = static_cast<std::byte>((s >> 16) & 0xFF);
+            break;
+        }
+        case AudioEncoding::PcmU8:
+            dst[0] = static_cast<std::byte>(static_cast<std::uint8_t>(std::lrint(v * 127.0f) + 128));
+            break;
+        case AudioEncoding::Invalid:
+            break;
+        }
+    }
+} // namespace
+
+// ---- PacedCapture ----
+
+PacedCapture::PacedCapture(std::chrono::microseconds period)
+    : period_(period)
+{
+}
+
+PacedCapture::~PacedCapture()
+{
+    stop();
+}
+
+bool PacedCapture::start(CaptureCallback cb, AudioFormat& out_format)
+{
+    if (running_) {
+        return false;
+    }
+    AudioFormat format { };
+    if (!open(format) || !format.valid()) {
+        close();
+        return false;
+    }
+
+    const auto period_frames = static_cast<std::size_t>(
+        std::max<long long>(1, period_.count() * static_cast<long long>(format.sample_rate) / 1'000'000));
+    format_ = format;
+    buffer_.assign(period_frames * format.frame_bytes(), std::byte { 0 });
+    callback_ = std::move(cb);
+
+    log_info_fmt("Headless capture: {}ch {}Hz encoding={}, period={} frames ({:.2f}ms)",
+        format.channels, format.sample_rate, static_cast<int>(format.encoding),
+        period_frames, static_cast<double>(period_frames) * 1000.0 / format.sample_rate);
+
+    // 无设备初始化：open() 已同步完成全部可能失败的步骤，线程启动即就绪。
+    running_ = true;
+    thread_ = std::thread(&PacedCapture::capture_loop, this);
+    out_format = format_;
+    return true;
+}
+
+void PacedCapture::stop()
+{
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+        close();
+    }
+    callback_ = { };
+}
+
+bool PacedCapture::is_running() const
+{
+    return running_.load(std::memory_order_acquire);
+}
+
+void PacedCapture::capture_loop()
+{
+    const std::size_t period_frames = buffer_.size() / format_.frame_bytes();
+    const std::uint32_t rate = format_.sample_rate;
+
+    auto origin = clock::now();
+    std::uint64_t frames_since_origin = 0;
+
+    auto last_stats_time = origin;
+    std::uint64_t stats_callbacks = 0;
+    std::uint64_t stats_rebases = 0;
+    clock::duration stats_max_late { };
+
+    while (running_.load(std::memory_order_relaxed)) {
+        produce(buffer_);
+        callback_(std::span<const std::byte> { buffer_.data(), buffer_.size() });
+        ++stats_callbacks;
+        frames_since_origin += period_frames;
+
+        // deadline = origin + 累计帧数 / 采样率（纳秒整数运算，无逐周期舍入累积）
+        const auto deadline = origin + std::chrono::nanoseconds(frames_since_origin * 1'000'000'000ull / rate);
+        const auto now = clock::now();
+        if (now - deadline > MAX_CATCH_UP) {
+            origin = now;
+            frames_since_origin = 0;
+            ++stats_rebases;
+        } else {
+            stats_max_late = std::max(stats_max_late, now - deadline);
+            std::this_thread::sleep_until(deadline);
+        }
+
+        if (now - last_stats_time >= STATS_INTERVAL) {
+            log_debug_fmt("Headless capture stats: {} callbacks in {:.2f}s, max late={:.2f}ms, rebases={}",
+                stats_callbacks,
+                std::chrono::duration<double>(now - last_stats_time).count(),
+                std::chrono::duration<double, std::milli>(stats_max_late).count(),
+                stats_rebases);
+            last_stats_time = now;
+            stats_callbacks = 0;
+            stats_rebases = 0;
+            stats_max_late = { };
+        }
+    }
+}
+
+// ---- FileCapture ----
+
+FileCapture::FileCapture(std::string path, AudioFormat raw_format, std::chrono::microseconds period)
+    : PacedCapture(period)
+    , path_(std::move(path))
+    , raw_format_(raw_format)
+{
+}
+
+FileCapture::~FileCapture()
+{
+    stop();
+}
+
+bool FileCapture::open(AudioFormat& format)
+{
+    std::ifstream in(path_, std::ios::binary | std::ios::ate);
+    if (!in) {
+        log_error_fmt("File capture: cannot open '{}'", path_);
+        return false;
+    }
+    const auto size = static_cast<std::uintmax_t>(in.tellg());
+    if (size > MAX_FILE_BYTES) {
+        log_error_fmt("File capture: '{}' is too large ({} bytes, max {})", path_, size, MAX_FILE_BYTES);
+        return false;
+    }
+    std::vector<std::byte> file(static_cast<std::size_t>(size));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(file.data()), static_cast<std::streamsize>(file.size()));
+    if (!in) {
+        log_error_fmt("File capture: failed to read '{}'", path_);
+        return false;
+    }
+
+    if (auto wav = parse_wav(file)) {
+        format = wav->format;
+        const auto first = file.begin() + static_cast<std::ptrdiff_t>(wav->data_offset);
+        data_.assign(first, first + static_cast<std::ptrdiff_t>(wav->data_bytes));
+        log_info_fmt("File capture: WAV '{}' ({} bytes PCM)", path_, data_.size());
+    } else {
+        if (!raw_format_.valid()) {
+            log_error_fmt("File capture: '{}' is not a WAV file and no raw format is configured", path_);
+            return false;
+        }
+        format = raw_format_;
+        file.resize(file.size() - file.size() % format.frame_bytes());
+        data_ = std::move(file);
+        log_info_fmt("File capture: raw PCM '{}' ({} bytes)", path_, data_.size());
+    }
+
+    if (data_.empty()) {
+        log_error_fmt("File capture: '{}' contains no audio frames", path_);
+        return false;
+    }
+    cursor_ = 0;
+    return true;
+}
+
+void FileCapture::produce(std::span<std::byte> out) noexcept
+{
+    // data_ 按整帧对齐，cursor_ 也总在帧边界上，循环拼接不会错位声道。
+    std::size_t written = 0;
+    while (written < out.size()) {
+        const std::size_t n = std::min(out.size() - written, data_.size() - cursor_);
+        std::memcpy(out.data() + written, data_.data() + cursor_, n);
+        written += n;
+        cursor_ += n;
+        if (cursor_ == data_.size()) {
+            cursor_ = 0;
+        }
+    }
+}
+
+void FileCapture::close() noexcept
+{
+    data_.clear();
+    data_.shrink_to_fit();
+}
+
+// ---- PipeCapture ----
+
+PipeCapture::PipeCapture(std::string path, AudioFormat format, std::chrono::microseconds period)
+    : PacedCapture(period)
+    , path_(std::move(path))
+    , format_(format)
+{
+}
+
+PipeCapture::~PipeCapture()
+{
+    stop();
+}
+
+bool PipeCapture::open(AudioFormat& format)
+{
+#if defined(_WIN32)
+    log_error("Pipe capture is only supported on POSIX platforms");
+    (void)format;
+    return false;
+#else
+    if (path_.empty() || path_ == "-") {
+        fd_ = STDIN_FILENO;
+        owns_fd_ = false;
+    } else {
+        // O_NONBLOCK：FIFO 无写端时 open 也立即返回，读端等写端随时接入。
+        fd_ = ::open(path_.c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd_ < 0) {
+            log_error_fmt("Pipe capture: cannot open '{}'", path_);
+            return false;
+        }
+        owns_fd_ = true;
+    }
+    format = format_;
+    carry_.assign(format_.frame_bytes(), std::byte { 0 });
+    carry_bytes_ = 0;
+    underflow_bytes_ = 0;
+    log_info_fmt("Pipe capture: reading raw PCM from {}", owns_fd_ ? path_ : std::string("stdin"));
+    return true;
+#endif
+}
+
+void PipeCapture::produce(std::span<std::byte> out) noexcept
+{
+#if defined(_WIN32)
+    std::fill(out.begin(), out.end(), silence_byte(format_.encoding));
+#else
+    std::memcpy(out.data(), carry_.data(), carry_bytes_);
+    std::size_t got = carry_bytes_;
+
+    // poll(0) 判定可读后 read 不会阻塞；stdin 不改 O_NONBLOCK（避免影响共享终端）。
+    while (got < out.size()) {
+        pollfd pfd { fd_, POLLIN, 0 };
+        if (::poll(&pfd, 1, 0) <= 0 || (pfd.revents & POLLIN) == 0) {
+            break;
+        }
+        const auto n = ::read(fd_, out.data() + got, out.size() - got);
+        if (n <= 0) {
+            break; // EOF（写端关闭）或 EAGAIN：本周期不足部分补静音
+        }
+        got += static_cast<std::size_t>(n);
+    }
+
+    const std::size_t frame_bytes = format_.frame_bytes();
+    const std::size_t whole = got - got % frame_bytes;
+    carry_bytes_ = got - whole;
+    std::memcpy(carry_.data(), out.data() + whole, carry_bytes_);
+    if (whole < out.size()) {
+        std::fill(out.begin() + static_cast<std::ptrdiff_t>(whole), out.end(), silence_byte(format_.encoding));
+        underflow_bytes_.fetch_add(out.size() - whole, std::memory_order_relaxed);
+    }
+#endif
+}
+
+void PipeCapture::close() noexcept
+{
+#if !defined(_WIN32)
+    if (owns_fd_ && fd_ >= 0) {
+        ::close(fd_);
+    }
+#endif
+    fd_ = -1;
+    owns_fd_ = false;
+    const auto underflow = underflow_bytes_.exchange(0);
+    if (underflow > 0) {
+        log_debug_fmt("Pipe capture: padded {} bytes of silence while the upstream was short", underflow);
+    }
+}
+
+// ---- SignalCapture ----
+
+SignalCapture::SignalCapture(CaptureSource waveform, AudioFormat format, std::chrono::microseconds period,
+    double frequency_hz, double amplitude)
+    : PacedCapture(period)
+    , waveform_(waveform)
+    , format_(format)
+    , frequency_hz_(frequency_hz)
+    , amplitude_(static_cast<float>(amplitude))
+{
+}
+
+SignalCapture::~SignalCapture()
+{
+    stop();
+}
+
+bool SignalCapture::open(AudioFormat& format)
+{
+    phase_ = 0.0;
+    noise_state_ = 0x9E3779B9u;
+    impulse_interval_ = std::max<std::uint64_t>(1,
+        static_cast<std::uint64_t>(std::llround(format_.sample_rate / frequency_hz_)));
+    impulse_countdown_ = 0;
+    format = format_;
+    return true;
+}
+
+void SignalCapture::produce(std::span<std::byte> out) noexcept
+{
+    const std::uint32_t channels = format_.channels;
+    const std::uint32_t sample_bytes = format_.bytes_per_sample();
+    const std::size_t frames = out.size() / format_.frame_bytes();
+    const double phase_step = 2.0 * std::numbers::pi * frequency_hz_ / format_.sample_rate;
+
+    std::byte* p = out.data();
+    for (std::size_t f = 0; f < frames; ++f) {
+        float frame_value = 0.0f;
+        if (waveform_ == CaptureSource::Sine) {
+            frame_value = amplitude_ * static_cast<float>(std::sin(phase_));
+            phase_ += phase_step;
+            if (phase_ >= 2.0 * std::numbers::pi) {
+                phase_ -= 2.0 * std::numbers::pi;
+            }
+        } else if (waveform_ == CaptureSource::Impulse) {
+            frame_value = impulse_countdown_ == 0 ? amplitude_ : 0.0f;
+            impulse_countdown_ = impulse_countdown_ == 0 ? impulse_interval_ - 1 : impulse_countdown_ - 1;
+        }
+
+        for (std::uint32_t c = 0; c < channels; ++c) {
+            float v = frame_value;
+            if (waveform_ == CaptureSource::Noise) {
+                // xorshift32 → [-1, 1) 均匀白噪声
+                noise_state_ ^= noise_state_ << 13;
+                noise_state_ ^= noise_state_ >> 17;
+                noise_state_ ^= noise_state_ << 5;
+                v = amplitude_ * (static_cast<float>(noise_state_) * (2.0f / 4294967296.0f) - 1.0f);
+            }
+            store_sample(v, format_.encoding, p);
+            p += sample_bytes;
+        }
+    }
+}
+
+} // namespace aqua::audio
@@ -0,0 +1,114 @@
+#ifndef AQUA_HEADLESS_CAPTURE_H
+#define AQUA_HEADLESS_CAPTURE_H
+
+#include "core/audio/backend/audio_backend_factory.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace aqua::audio {
+
+// 无设备采集后端公共基类（Linux 无声卡主机 / 性能测试）。
+// 独立线程按绝对 deadline 节拍：每周期 produce() 生成 period 帧并回调一次；
+// deadline 由累计帧数换算（start + frames / sample_rate），长期速率无累积误差。
+// 线程被饿死（落后 > MAX_CATCH_UP）时重锚时间线而不是突发补发，行为与设备后端
+// 在系统卡顿后丢弃旧数据一致。
+class PacedCapture : public CaptureBackend {
+public:
+    explicit PacedCapture(std::chrono::microseconds period);
+    ~PacedCapture() override;
+
+    bool start(CaptureCallback cb, AudioFormat& out_format) override;
+    void stop() override;
+    bool is_running() const override;
+
+protected:
+    // start() 调用方线程执行：打开来源并确定输出格式。失败返回 false（已记日志）。
+    virtual bool open(AudioFormat& format) = 0;
+    // 采集线程调用：用 PCM 填满 out（恰好一个周期的帧数）。不得分配 / 阻塞。
+    virtual void produce(std::span<std::byte> out) noexcept = 0;
+    // stop() join 采集线程后调用：释放来源资源。派生类析构前必须先 stop()。
+    virtual void close() noexcept { }
+
+private:
+    void capture_loop();
+
+    std::chrono::microseconds period_;
+    std::thread thread_;
+    std::atomic<bool> running_ { false };
+    CaptureCallback callback_;
+    AudioFormat format_ { };
+    std::vector<std::byte> buffer_; // 一个周期的 PCM（start 时按格式预分配）
+};
+
+// WAV / raw PCM 文件来源：整文件读入内存，到尾部后从 data 起点循环。
+// WAV 以文件头格式为准；非 WAV 文件按 raw_format 解释（尾部不足一帧的字节丢弃）。
+class FileCapture final : public PacedCapture {
+public:
+    FileCapture(std::string path, AudioFormat raw_format, std::chrono::microseconds period);
+    ~FileCapture() override;
+
+protected:
+    bool open(AudioFormat& format) override;
+    void produce(std::span<std::byte> out) noexcept override;
+    void close() noexcept override;
+
+private:
+    std::string path_;
+    AudioFormat raw_format_;
+    std::vector<std::byte> data_; // 仅 PCM 数据（已剥离 WAV 头）
+    std::size_t cursor_ = 0;
+};
+
+// stdin / FIFO 来源：每周期非阻塞读取至多一个周期的字节，不足部分补静音
+// （按整帧补齐，残余半帧留到下周期，保证声道对齐）。上游写得比实时快时由
+// 管道满反压限速。仅 POSIX 平台可用，Windows 上 open() 失败。
+class PipeCapture final : public PacedCapture {
+public:
+    PipeCapture(std::string path, AudioFormat format, std::chrono::microseconds period);
+    ~PipeCapture() override;
+
+protected:
+    bool open(AudioFormat& format) override;
+    void produce(std::span<std::byte> out) noexcept override;
+    void close() noexcept override;
+
+private:
+    std::string path_;
+    AudioFormat format_;
+    int fd_ = -1;
+    bool owns_fd_ = false; // stdin 不由本类关闭
+    std::vector<std::byte> carry_; // 上周期残余的半帧
+    std::size_t carry_bytes_ = 0;
+    std::atomic<std::uint64_t> underflow_bytes_ { 0 }; // 补静音字节数（stop 时记日志）
+};
+
+// 信号发生器来源：Sine / Noise / Impulse，所有声道输出同一信号（噪声逐声道独立）。
+class SignalCapture final : public PacedCapture {
+public:
+    SignalCapture(CaptureSource waveform, AudioFormat format, std::chrono::microseconds period,
+        double frequency_hz, double amplitude);
+    ~SignalCapture() override;
+
+protected:
+    bool open(AudioFormat& format) override;
+    void produce(std::span<std::byte> out) noexcept override;
+
+private:
+    CaptureSource waveform_;
+    AudioFormat format_;
+    double frequency_hz_;
+    float amplitude_;
+    double phase_ = 0.0; // Sine：当前相位（弧度）
+    std::uint32_t noise_state_ = 0x9E3779B9u; // Noise：xorshift32 状态
+    std::uint64_t impulse_interval_ = 0; // Impulse：脉冲间隔（帧）
+    std::uint64_t impulse_countdown_ = 0;
+};
+
+} // namespace aqua::audio
+
+#endif // AQUA_HEADLESS_CAPTURE_H
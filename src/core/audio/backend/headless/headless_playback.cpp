@@ -0,0 +1,232 @@
+#include "core/audio/backend/headless/headless_playback.h"
+
+#include "core/audio/backend/headless/wav_file.h"
+#include "core/logger/logger.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace aqua::audio {
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    // 落后超过此值时重锚时间线，与 PacedCapture 一致。
+    constexpr auto MAX_CATCH_UP = std::chrono::milliseconds(200);
+
+    // 周期统计日志间隔，与 WASAPI 后端一致。
+    constexpr auto STATS_INTERVAL = std::chrono::seconds(5);
+} // namespace
+
+HeadlessPlayback::HeadlessPlayback(PlaybackSink sink, std::string path, std::chrono::microseconds period,
+    double drift_ppm, AudioEncoding encoding, std::uint32_t channels, std::uint32_t sample_rate)
+    : sink_(sink)
+    , path_(std::move(path))
+    , period_(period)
+    , drift_ppm_(drift_ppm)
+    , encoding_override_(encoding)
+    , channels_override_(channels)
+    , sample_rate_override_(sample_rate)
+{
+}
+
+AudioFormat HeadlessPlayback::negotiate_format(const AudioFormat& requested)
+{
+    AudioFormat result = requested;
+    if (encoding_override_ != AudioEncoding::Invalid) {
+        result.encoding = encoding_override_;
+    }
+    if (channels_override_ > 0) {
+        result.channels = channels_override_;
+    }
+    if (sample_rate_override_ > 0) {
+        result.sample_rate = sample_rate_override_;
+    }
+    return result;
+}
+
+HeadlessPlayback::~HeadlessPlayback()
+{
+    stop();
+}
+
+std::chrono::nanoseconds HeadlessPlayback::consumption_time(std::uint64_t frames,
+    std::uint32_t sample_rate, double drift_ppm) noexcept
+{
+    if (sample_rate == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+    // 偏快的时钟每秒消费 rate·(1 + ppm·1e-6) 帧：同样帧数耗时按比例缩短。
+    const double seconds = static_cast<double>(frames) / sample_rate / (1.0 + drift_ppm * 1e-6);
+    return std::chrono::nanoseconds(static_cast<std::int64_t>(seconds * 1e9));
+}
+
+bool HeadlessPlayback::start(AudioFormat format, FillCallback cb)
+{
+    if (running_ || thread_.joinable()) {
+        return false;
+    }
+    if (!format.valid()) {
+        return false;
+    }
+
+    format_ = format;
+    if (!open_sink()) {
+        return false;
+    }
+
+    const auto period_frames = static_cast<std::size_t>(
+        std::max<long long>(1, period_.count() * static_cast<long long>(format.sample_rate) / 1'000'000));
+    buffer_.assign(period_frames * format.frame_bytes(), std::byte { 0 });
+    callback_ = std::move(cb);
+
+    log_info_fmt("Headless playback: {}ch {}Hz encoding={}, period={} frames ({:.2f}ms), drift={:+.1f}ppm, sink={}",
+        format.channels, format.sample_rate, static_cast<int>(format.encoding),
+        period_frames, static_cast<double>(period_frames) * 1000.0 / format.sample_rate, drift_ppm_,
+        sink_ == PlaybackSink::File ? path_ : sink_ == PlaybackSink::Stdout ? std::string("stdout") : std::string("null"));
+
+    running_ = true;
+    thread_ = std::thread(&HeadlessPlayback::playback_loop, this);
+    return true;
+}
+
+void HeadlessPlayback::stop()
+{
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+        close_sink();
+    }
+    callback_ = { };
+}
+
+bool HeadlessPlayback::is_running() const
+{
+    return running_.load(std::memory_order_acquire);
+}
+
+bool HeadlessPlayback::open_sink()
+{
+    data_bytes_ = 0;
+    if (sink_ == PlaybackSink::Stdout) {
+#if defined(_WIN32)
+        // 文本模式会把 0x0A 改写成 CRLF，破坏 PCM。
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        out_ = stdout;
+        return true;
+    }
+    if (sink_ != PlaybackSink::File) {
+        return true;
+    }
+
+    out_ = std::fopen(path_.c_str(), "wb");
+    if (out_ == nullptr) {
+        log_error_fmt("Headless playback: cannot open '{}' for writing", path_);
+        return false;
+    }
+    std::array<std::byte, WAV_HEADER_BYTES> header { };
+    if (!write_wav_header(format_, 0, header)
+        || std::fwrite(header.data(), 1, header.size(), out_) != header.size()) {
+        log_error_fmt("Headless playback: failed to write WAV header to '{}'", path_);
+        std::fclose(out_);
+        out_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void HeadlessPlayback::close_sink() noexcept
+{
+    if (out_ == nullptr) {
+        return;
+    }
+    if (sink_ == PlaybackSink::Stdout) {
+        std::fflush(out_);
+        out_ = nullptr;
+        return;
+    }
+
+    // 回填 WAV 头的 RIFF / data 长度。
+    std::array<std::byte, WAV_HEADER_BYTES> header { };
+    if (write_wav_header(format_, data_bytes_, header) && std::fseek(out_, 0, SEEK_SET) == 0) {
+        std::fwrite(header.data(), 1, header.size(), out_);
+    }
+    std::fclose(out_);
+    out_ = nullptr;
+    log_info_fmt("Headless playback: wrote {} bytes PCM to '{}'", data_bytes_, path_);
+}
+
+void HeadlessPlayback::playback_loop()
+{
+    const std::size_t frame_bytes = format_.frame_bytes();
+    const std::size_t period_frames = buffer_.size() / frame_bytes;
+    const std::uint32_t rate = format_.sample_rate;
+    const std::byte silence = format_.encoding == AudioEncoding::PcmU8 ? std::byte { 0x80 } : std::byte { 0 };
+
+    auto origin = clock::now();
+    std::uint64_t frames_since_origin = 0;
+
+    auto last_stats_time = origin;
+    std::uint64_t stats_callbacks = 0;
+    std::uint64_t stats_bytes_filled = 0;
+    std::uint64_t stats_bytes_silent = 0;
+    std::uint64_t stats_rebases = 0;
+    clock::duration stats_max_late { };
+
+    while (running_.load(std::memory_order_relaxed)) {
+        std::size_t filled = callback_(std::span<std::byte> { buffer_.data(), buffer_.size() });
+        // 防御：FillCallback 契约保证 filled <= size，再钳制一次防填充下溢。
+        filled = std::min(filled, buffer_.size());
+        std::fill(buffer_.begin() + static_cast<std::ptrdiff_t>(filled), buffer_.end(), silence);
+        ++stats_callbacks;
+        stats_bytes_filled += filled;
+        stats_bytes_silent += buffer_.size() - filled;
+
+        if (out_ != nullptr) {
+            if (std::fwrite(buffer_.data(), 1, buffer_.size(), out_) != buffer_.size()) {
+                log_error_fmt("Headless playback: write to {} failed, stopping",
+                    sink_ == PlaybackSink::Stdout ? std::string("stdout") : path_);
+                break;
+            }
+            data_bytes_ += buffer_.size();
+        }
+
+        frames_since_origin += period_frames;
+        const auto deadline = origin + consumption_time(frames_since_origin, rate, drift_ppm_);
+        const auto now = clock::now();
+        if (now - deadline > MAX_CATCH_UP) {
+            origin = now;
+            frames_since_origin = 0;
+            ++stats_rebases;
+        } else {
+            stats_max_late = std::max(stats_max_late, now - deadline);
+            std::this_thread::sleep_until(deadline);
+        }
+
+        if (now - last_stats_time >= STATS_INTERVAL) {
+            const std::uint64_t total = stats_bytes_filled + stats_bytes_silent;
+            log_debug_fmt("Headless playback stats: {} callbacks in {:.2f}s, fill ratio {:.1f}%, max late={:.2f}ms, rebases={}",
+                stats_callbacks,
+                std::chrono::duration<double>(now - last_stats_time).count(),
+                total > 0 ? static_cast<double>(stats_bytes_filled) * 100.0 / static_cast<double>(total) : 0.0,
+                std::chrono::duration<double, std::milli>(stats_max_late).count(),
+                stats_rebases);
+            last_stats_time = now;
+            stats_callbacks = 0;
+            stats_bytes_filled = 0;
+            stats_bytes_silent = 0;
+            stats_rebases = 0;
+            stats_max_late = { };
+        }
+    }
+    running_.store(false, std::memory_order_release);
+}
+
+} // namespace aqua::audio
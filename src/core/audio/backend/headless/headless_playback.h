@@ -0,0 +1,72 @@
+#ifndef AQUA_HEADLESS_PLAYBACK_H
+#define AQUA_HEADLESS_PLAYBACK_H
+
+#include "core/audio/backend/audio_backend_factory.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace aqua::audio {
+
+// 无设备播放后端（headless 客户端 / 端到端测试）：独立线程按实时节拍每周期拉取一次
+// FillCallback（恰好 period 帧，不足补静音），可选把"实际播出"的 PCM 写到 WAV 文件或 stdout。
+//
+// 消费时钟：deadline = origin + consumption_time(累计帧数)，按 (1 + drift_ppm·1e-6)
+// 缩放标称采样率，模拟晶振偏快 / 偏慢的声卡；长期速率无累积误差。线程被饿死
+// （落后 > 200ms）时重锚时间线，与 PacedCapture 一致。
+//
+// 线程模型：
+//   - start()/stop() 在调用方线程；输出文件在 start() 内同步打开，失败即返回 false。
+//   - 播放线程：FillCallback → 补静音 → 写出（fwrite，带缓冲）。写失败（磁盘满 / 管道断开）
+//     视为设备丢失，线程退出，is_running() 返回 false。
+//   - 模拟设备格式（encoding / channels / sample_rate 覆盖）：negotiate_format 返回覆盖后的格式，
+//     写出的 WAV / raw PCM 即转换后的设备格式。
+//   - WAV 以流式头（data 长度 0）开始写，stop() 时回填实际长度；进程异常退出时
+//     parse_wav 仍可按文件实际长度读取。
+class HeadlessPlayback final : public PlaybackBackend {
+public:
+    HeadlessPlayback(PlaybackSink sink, std::string path, std::chrono::microseconds period, double drift_ppm,
+        AudioEncoding encoding = AudioEncoding::Invalid, std::uint32_t channels = 0, std::uint32_t sample_rate = 0);
+    ~HeadlessPlayback() override;
+
+    bool start(AudioFormat format, FillCallback cb) override;
+    void stop() override;
+    bool is_running() const override;
+
+    AudioFormat negotiate_format(const AudioFormat& requested) override;
+
+    // 以 drift_ppm 偏差的时钟消费 frames 帧所需的时长。
+    [[nodiscard]] static std::chrono::nanoseconds consumption_time(std::uint64_t frames,
+        std::uint32_t sample_rate, double drift_ppm) noexcept;
+
+private:
+    bool open_sink();
+    void close_sink() noexcept;
+    void playback_loop();
+
+    PlaybackSink sink_;
+    std::string path_;
+    std::chrono::microseconds period_;
+    double drift_ppm_;
+    AudioEncoding encoding_override_; // Invalid = 不覆盖
+    std::uint32_t channels_override_; // 0 = 不覆盖
+    std::uint32_t sample_rate_override_; // 0 = 不覆盖
+
+    std::thread thread_;
+    std::atomic<bool> running_ { false };
+    FillCallback callback_;
+    AudioFormat format_ { };
+    std::vector<std::byte> buffer_; // 一个周期的 PCM（start 时按格式预分配）
+
+    std::FILE* out_ = nullptr; // File / Stdout 去向
+    std::uint64_t data_bytes_ = 0; // 已写出的 PCM 字节数（WAV 头回填用，仅播放线程写）
+};
+
+} // namespace aqua::audio
+
+#endif // AQUA_HEADLESS_PLAYBACK_H
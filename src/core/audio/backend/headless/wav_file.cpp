@@ -0,0 +1,153 @@
+#include "core/audio/backend/headless/wav_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace aqua::audio {
+
+namespace {
+    // RIFF 字段为小端。与 packet codec 相同，假定小端主机（见 packet.cpp static_assert）。
+
+    constexpr std::uint16_t WAVE_FORMAT_PCM = 0x0001;
+    constexpr std::uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+    constexpr std::uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+    std::uint32_t read_u32_le(const std::byte* p) noexcept
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    std::uint16_t read_u16_le(const std::byte* p) noexcept
+    {
+        std::uint16_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    void write_u32_le(std::byte* p, std::uint32_t v) noexcept
+    {
+        std::memcpy(p, &v, sizeof(v));
+    }
+
+    void write_u16_le(std::byte* p, std::uint16_t v) noexcept
+    {
+        std::memcpy(p, &v, sizeof(v));
+    }
+
+    bool tag_equals(const std::byte* p, const char (&tag)[5]) noexcept
+    {
+        return std::memcmp(p, tag, 4) == 0;
+    }
+
+    AudioEncoding encoding_from_wav(std::uint16_t tag, std::uint16_t bits) noexcept
+    {
+        if (tag == WAVE_FORMAT_IEEE_FLOAT) {
+            return bits == 32 ? AudioEncoding::PcmF32LE : AudioEncoding::Invalid;
+        }
+        if (tag != WAVE_FORMAT_PCM) {
+            return AudioEncoding::Invalid;
+        }
+        switch (bits) {
+        case 8:
+            return AudioEncoding::PcmU8;
+        case 16:
+            return AudioEncoding::PcmS16LE;
+        case 24:
+            return AudioEncoding::PcmS24LE;
+        case 32:
+            return AudioEncoding::PcmS32LE;
+        default:
+            return AudioEncoding::Invalid;
+        }
+    }
+} // namespace
+
+std::optional<WavInfo> parse_wav(std::span<const std::byte> file) noexcept
+{
+    if (file.size() < 12 || !tag_equals(file.data(), "RIFF") || !tag_equals(file.data() + 8, "WAVE")) {
+        return std::nullopt;
+    }
+
+    WavInfo info;
+    bool have_fmt = false;
+    std::size_t pos = 12;
+    // chunk 遍历：id(4) + size(4) + body（奇数长度按 RIFF 规范补 1 字节）
+    while (pos + 8 <= file.size()) {
+        const std::byte* chunk = file.data() + pos;
+        const std::size_t body_size = read_u32_le(chunk + 4);
+        const std::size_t body_pos = pos + 8;
+
+        if (tag_equals(chunk, "fmt ")) {
+            if (body_size < 16 || body_pos + 16 > file.size()) {
+                return std::nullopt;
+            }
+            const std::byte* fmt = file.data() + body_pos;
+            std::uint16_t tag = read_u16_le(fmt);
+            const std::uint16_t channels = read_u16_le(fmt + 2);
+            const std::uint32_t sample_rate = read_u32_le(fmt + 4);
+            const std::uint16_t bits = read_u16_le(fmt + 14);
+            if (tag == WAVE_FORMAT_EXTENSIBLE) {
+                // WAVEFORMATEXTENSIBLE：SubFormat GUID 前 2 字节即真实 format tag
+                if (body_size < 40 || body_pos + 26 > file.size()) {
+                    return std::nullopt;
+                }
+                tag = read_u16_le(fmt + 24);
+            }
+            info.format.encoding = encoding_from_wav(tag, bits);
+            info.format.channels = channels;
+            info.format.sample_rate = sample_rate;
+            if (!info.format.valid()) {
+                return std::nullopt;
+            }
+            have_fmt = true;
+        } else if (tag_equals(chunk, "data")) {
+            if (!have_fmt) {
+                return std::nullopt;
+            }
+            info.data_offset = body_pos;
+            // 流式写出的文件常把 data size 留为 0 / 0xFFFFFFFF：按实际长度截断。
+            const std::size_t available = file.size() - std::min(body_pos, file.size());
+            std::size_t bytes = (body_size == 0 || body_size > available) ? available : body_size;
+            bytes -= bytes % info.format.frame_bytes();
+            info.data_bytes = bytes;
+            return info;
+        }
+
+        pos = body_pos + body_size + (body_size & 1);
+    }
+    return std::nullopt;
+}
+
+bool write_wav_header(const AudioFormat& format, std::uint64_t data_bytes,
+    std::span<std::byte, WAV_HEADER_BYTES> out) noexcept
+{
+    if (!format.valid()) {
+        return false;
+    }
+    // RIFF size = 36 + data，需在 u32 内
+    constexpr std::uint64_t max_data = std::numeric_limits<std::uint32_t>::max() - 36;
+    const auto data_size = static_cast<std::uint32_t>(std::min(data_bytes, max_data));
+    const std::uint16_t tag = format.encoding == AudioEncoding::PcmF32LE ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
+    const auto bits = static_cast<std::uint16_t>(format.bytes_per_sample() * 8);
+
+    std::byte* p = out.data();
+    std::memcpy(p, "RIFF", 4);
+    write_u32_le(p + 4, 36 + data_size);
+    std::memcpy(p + 8, "WAVE", 4);
+    std::memcpy(p + 12, "fmt ", 4);
+    write_u32_le(p + 16, 16);
+    write_u16_le(p + 20, tag);
+    write_u16_le(p + 22, static_cast<std::uint16_t>(format.channels));
+    write_u32_le(p + 24, format.sample_rate);
+    write_u32_le(p + 28, format.sample_rate * format.frame_bytes());
+    write_u16_le(p + 32, static_cast<std::uint16_t>(format.frame_bytes()));
+    write_u16_le(p + 34, bits);
+    std::memcpy(p + 36, "data", 4);
+    write_u32_le(p + 40, data_size);
+    return true;
+}
+
+} // namespace aqua::audio
@@ -0,0 +1,37 @@
+#ifndef AQUA_WAV_FILE_H
+#define AQUA_WAV_FILE_H
+
+#include "core/public/audio_format.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace aqua::audio {
+
+// RIFF/WAVE 最小读写支持（无设备后端的文件来源 / 文件输出共用）。
+// 只识别 PCM(1) / IEEE float(3) / WAVE_FORMAT_EXTENSIBLE(0xFFFE) 三种 format tag，
+// 位深映射到 AudioEncoding：8→U8、16→S16、24→S24、32→S32（PCM）或 F32（float）。
+
+struct WavInfo {
+    AudioFormat format;
+    std::size_t data_offset = 0; // data chunk 起始偏移（字节）
+    std::size_t data_bytes = 0; // data chunk 长度（已按文件实际长度截断、按帧对齐）
+};
+
+// 解析整个 WAV 文件内容。非 WAV / 不支持的格式返回 std::nullopt。
+[[nodiscard]] std::optional<WavInfo> parse_wav(std::span<const std::byte> file) noexcept;
+
+// 标准 44 字节 canonical WAV 头（fmt chunk 16 字节 + data chunk 头）。
+inline constexpr std::size_t WAV_HEADER_BYTES = 44;
+
+// 按 format 与 data 长度生成 44 字节头。data_bytes 超过 RIFF 32 位上限时饱和截断。
+// format 无效时返回 false。
+bool write_wav_header(const AudioFormat& format, std::uint64_t data_bytes,
+    std::span<std::byte, WAV_HEADER_BYTES> out) noexcept;
+
+} // namespace aqua::audio
+
+#endif // AQUA_WAV_FILE_H
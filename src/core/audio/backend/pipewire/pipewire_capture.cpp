@@ -0,0 +1,206 @@
+#include "core/audio/backend/pipewire/pipewire_capture.h"
+
+#include "core/audio/backend/pipewire/pipewire_common.h"
+#include "core/logger/logger.h"
+
+#include <chrono>
+#include <thread>
+
+namespace aqua::audio {
+
+// 初始化前请求的 quantum 采样率：monitor 跟随 sink 协商，此时尚不知道真实采样率，
+// 按主流 graph 默认 48kHz 估算（只影响 quantum 请求，不影响格式）。
+namespace {
+    constexpr std::uint32_t CAPTURE_QUANTUM_RATE_HINT = 48000;
+} // namespace
+
+struct PipewireCaptureEvents {
+    static void on_state_changed(void* data, pw_stream_state /*old*/, pw_stream_state state, const char* error)
+    {
+        auto* self = static_cast<PipewireCapture*>(data);
+        if (state == PW_STREAM_STATE_ERROR) {
+            log_error_fmt("PipeWire capture: stream error: {}", error ? error : "unknown");
+            self->running_.store(false, std::memory_order_release);
+        } else if (state == PW_STREAM_STATE_UNCONNECTED) {
+            // 守护进程退出 / 节点被移除：标记停止，ServerRuntime 主循环轮询感知。
+            self->running_.store(false, std::memory_order_release);
+        } else {
+            log_debug_fmt("PipeWire capture: stream state {}", pw_stream_state_as_string(state));
+        }
+    }
+
+    static void on_param_changed(void* data, std::uint32_t id, const spa_pod* param)
+    {
+        auto* self = static_cast<PipewireCapture*>(data);
+        if (param == nullptr || id != SPA_PARAM_Format) {
+            return;
+        }
+        spa_audio_info_raw info { };
+        if (spa_format_audio_raw_parse(param, &info) < 0) {
+            return;
+        }
+        AudioFormat format;
+        format.encoding = pipewire::from_spa_format(info.format);
+        format.channels = info.channels;
+        format.sample_rate = info.rate;
+        if (!format.valid()) {
+            log_error_fmt("PipeWire capture: unsupported negotiated format {}", static_cast<int>(info.format));
+            self->running_.store(false, std::memory_order_release);
+            return;
+        }
+        // 重新协商（sink 切换采样率）时格式变化无法通知下游（gRPC 已公布格式），
+        // 与 WASAPI 设备格式变更一样按运行时错误处理。
+        if (self->started_.load(std::memory_order_acquire) && !(format == self->format_)) {
+            log_error("PipeWire capture: format renegotiated mid-stream, stopping");
+            self->running_.store(false, std::memory_order_release);
+            return;
+        }
+        self->format_ = format;
+        self->started_.store(true, std::memory_order_release);
+    }
+
+    // 实时数据线程：只做 dequeue → CaptureCallback（SPSC 写）→ queue。
+    // 严格禁止锁 / 分配 / 日志。
+    static void on_process(void* data)
+    {
+        auto* self = static_cast<PipewireCapture*>(data);
+        pw_buffer* b = pw_stream_dequeue_buffer(self->stream_);
+        if (b == nullptr) {
+            return;
+        }
+        const spa_data& d = b->buffer->datas[0];
+        if (d.data != nullptr && d.chunk != nullptr && d.chunk->size > 0
+            && self->started_.load(std::memory_order_acquire)) {
+            const std::uint32_t offset = std::min(d.chunk->offset, d.maxsize);
+            const std::uint32_t size = std::min(d.chunk->size, d.maxsize - offset);
+            self->callback_(std::span<const std::byte> {
+                static_cast<const std::byte*>(d.data) + offset, size });
+        }
+        pw_stream_queue_buffer(self->stream_, b);
+    }
+};
+
+namespace {
+    // 逐字段赋值而非指定初始化器：pw_stream_events 随版本追加成员，避免缺省成员告警。
+    pw_stream_events make_stream_events() noexcept
+    {
+        pw_stream_events events { };
+        events.version = PW_VERSION_STREAM_EVENTS;
+        events.state_changed = &PipewireCaptureEvents::on_state_changed;
+        events.param_changed = &PipewireCaptureEvents::on_param_changed;
+        events.process = &PipewireCaptureEvents::on_process;
+        return events;
+    }
+
+    // 事件表须在流的整个生命周期内有效。
+    const pw_stream_events CAPTURE_STREAM_EVENTS = make_stream_events();
+} // namespace
+
+PipewireCapture::~PipewireCapture()
+{
+    stop();
+}
+
+bool PipewireCapture::start(CaptureCallback cb, AudioFormat& out_format)
+{
+    if (loop_ != nullptr) {
+        return false; // 已启动
+    }
+    pipewire::ensure_initialized();
+
+    callback_ = std::move(cb);
+    running_ = true;
+    started_ = false;
+
+    loop_ = pw_thread_loop_new("aqua-capture", nullptr);
+    if (loop_ == nullptr) {
+        log_error("PipeWire capture: pw_thread_loop_new failed");
+        stop();
+        return false;
+    }
+
+    const std::string latency = pipewire::node_latency(CAPTURE_QUANTUM_RATE_HINT);
+    pw_properties* props = pw_properties_new(
+        PW_KEY_MEDIA_TYPE, "Audio",
+        PW_KEY_MEDIA_CATEGORY, "Capture",
+        PW_KEY_MEDIA_ROLE, "Music",
+        PW_KEY_STREAM_CAPTURE_SINK, "true", // 采集默认 sink 的 monitor（loopback）
+        PW_KEY_NODE_LATENCY, latency.c_str(),
+        PW_KEY_NODE_NAME, "aqua_capture",
+        nullptr);
+
+    pw_thread_loop_lock(loop_);
+    if (pw_thread_loop_start(loop_) < 0) {
+        pw_thread_loop_unlock(loop_);
+        pw_properties_free(props);
+        log_error("PipeWire capture: failed to start thread loop");
+        stop();
+        return false;
+    }
+
+    // pw_stream_new_simple 接管 props 所有权（失败时也会释放）。
+    stream_ = pw_stream_new_simple(pw_thread_loop_get_loop(loop_), "aqua-capture", props,
+        &CAPTURE_STREAM_EVENTS, this);
+    if (stream_ == nullptr) {
+        pw_thread_loop_unlock(loop_);
+        log_error("PipeWire capture: pw_stream_new_simple failed (is the PipeWire daemon running?)");
+        stop();
+        return false;
+    }
+
+    std::uint8_t pod_buffer[1024];
+    spa_pod_builder builder = SPA_POD_BUILDER_INIT(pod_buffer, sizeof(pod_buffer));
+    const spa_pod* params[1] = {
+        pipewire::build_format_pod(builder, SPA_AUDIO_FORMAT_F32_LE, 0, 0),
+    };
+    const int res = pw_stream_connect(stream_, PW_DIRECTION_INPUT, PW_ID_ANY,
+        static_cast<pw_stream_flags>(PW_STREAM_FLAG_AUTOCONNECT
+            | PW_STREAM_FLAG_MAP_BUFFERS
+            | PW_STREAM_FLAG_RT_PROCESS),
+        params, 1);
+    pw_thread_loop_unlock(loop_);
+    if (res < 0) {
+        log_error_fmt("PipeWire capture: pw_stream_connect failed: {}", res);
+        stop();
+        return false;
+    }
+
+    // 等待格式协商结果（最多 1 秒），与 WASAPI 后端同步初始化语义一致。
+    for (int i = 0; i < 100 && running_.load(std::memory_order_acquire) && !started_.load(std::memory_order_acquire); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (!started_.load(std::memory_order_acquire) || !running_.load(std::memory_order_acquire)) {
+        log_error("PipeWire capture: format negotiation did not complete (no default sink?)");
+        stop();
+        return false;
+    }
+
+    out_format = format_;
+    log_info_fmt("PipeWire capture started: {}ch {}Hz, node latency {}",
+        format_.channels, format_.sample_rate, latency);
+    return true;
+}
+
+void PipewireCapture::stop()
+{
+    running_ = false;
+    if (loop_ != nullptr) {
+        // 先停线程循环再销毁流：之后不会再有任何回调触发。
+        pw_thread_loop_stop(loop_);
+        if (stream_ != nullptr) {
+            pw_stream_destroy(stream_);
+            stream_ = nullptr;
+        }
+        pw_thread_loop_destroy(loop_);
+        loop_ = nullptr;
+    }
+    callback_ = { };
+    started_ = false;
+}
+
+bool PipewireCapture::is_running() const
+{
+    return running_.load(std::memory_order_acquire);
+}
+
+} // namespace aqua::audio
@@ -0,0 +1,47 @@
+#ifndef AQUA_PIPEWIRE_CAPTURE_H
+#define AQUA_PIPEWIRE_CAPTURE_H
+
+#include "core/audio/backend/audio_backend_factory.h"
+
+#include <atomic>
+
+struct pw_thread_loop;
+struct pw_stream;
+
+namespace aqua::audio {
+
+// Linux PipeWire 采集后端：采集默认输出设备的 monitor（PW_KEY_STREAM_CAPTURE_SINK），
+// 语义与 WASAPI loopback 一致。格式请求 F32LE，声道数与采样率跟随 sink 协商结果。
+//
+// 线程模型：
+//   - start()/stop() 在调用方线程；流的创建/销毁在 pw_thread_loop 锁内完成。
+//   - process 回调在 PipeWire 实时数据线程（PW_STREAM_FLAG_RT_PROCESS），
+//     直接把 buffer 内存交给 CaptureCallback（写 SpscRingBuffer），无中转拷贝。
+//   - state/param 回调在 pw_thread_loop 线程，仅做原子置位。
+class PipewireCapture final : public CaptureBackend {
+public:
+    PipewireCapture() = default;
+    ~PipewireCapture() override;
+
+    bool start(CaptureCallback cb, AudioFormat& out_format) override;
+    void stop() override;
+    bool is_running() const override;
+
+private:
+    // pw_stream_events 回调集合（定义在 .cpp，避免头文件引入 PipeWire 类型）。
+    friend struct PipewireCaptureEvents;
+
+    pw_thread_loop* loop_ = nullptr;
+    pw_stream* stream_ = nullptr;
+    CaptureCallback callback_;
+    AudioFormat format_ { }; // param_changed 写入，started_ 发布
+
+    // running_: 流存活（未进入 ERROR / UNCONNECTED）。stop() 也会置 false。
+    // started_: 格式协商完成（初始化成功），start() 据此同步返回，与 WASAPI 后端一致。
+    std::atomic<bool> running_ { false };
+    std::atomic<bool> started_ { false };
+};
+
+} // namespace aqua::audio
+
+#endif // AQUA_PIPEWIRE_CAPTURE_H
@@ -0,0 +1,123 @@
+#ifndef AQUA_PIPEWIRE_COMMON_H
+#define AQUA_PIPEWIRE_COMMON_H
+
+// Linux PipeWire 后端公共工具：库初始化、AudioEncoding 与 SPA 格式互转、格式 pod 构建。
+// 仅在 AQUA_HAVE_PIPEWIRE 下使用，由 pipewire_capture.cpp / pipewire_playback.cpp 内部包含。
+
+#include "core/public/audio_format.h"
+
+#include <pipewire/pipewire.h>
+#include <spa/param/audio/format-utils.h>
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+
+namespace aqua::audio::pipewire {
+
+// pw_init 进程内只调用一次；不调用 pw_deinit（进程退出时由系统回收，
+// 避免多个后端实例引用计数交错导致提前反初始化）。
+inline void ensure_initialized() noexcept
+{
+    static std::once_flag once;
+    std::call_once(once, [] { pw_init(nullptr, nullptr); });
+}
+
+inline spa_audio_format to_spa_format(AudioEncoding encoding) noexcept
+{
+    switch (encoding) {
+    case AudioEncoding::PcmF32LE:
+        return SPA_AUDIO_FORMAT_F32_LE;
+    case AudioEncoding::PcmS16LE:
+        return SPA_AUDIO_FORMAT_S16_LE;
+    case AudioEncoding::PcmS24LE:
+        return SPA_AUDIO_FORMAT_S24_LE;
+    case AudioEncoding::PcmS32LE:
+        return SPA_AUDIO_FORMAT_S32_LE;
+    case AudioEncoding::PcmU8:
+        return SPA_AUDIO_FORMAT_U8;
+    case AudioEncoding::Invalid:
+        break;
+    }
+    return SPA_AUDIO_FORMAT_UNKNOWN;
+}
+
+inline AudioEncoding from_spa_format(std::uint32_t format) noexcept
+{
+    switch (format) {
+    case SPA_AUDIO_FORMAT_F32_LE:
+        return AudioEncoding::PcmF32LE;
+    case SPA_AUDIO_FORMAT_S16_LE:
+        return AudioEncoding::PcmS16LE;
+    case SPA_AUDIO_FORMAT_S24_LE:
+        return AudioEncoding::PcmS24LE;
+    case SPA_AUDIO_FORMAT_S32_LE:
+        return AudioEncoding::PcmS32LE;
+    case SPA_AUDIO_FORMAT_U8:
+        return AudioEncoding::PcmU8;
+    default:
+        return AudioEncoding::Invalid;
+    }
+}
+
+// 构建 EnumFormat pod。channels / rate 为 0 表示交给 graph 协商（采集跟随 sink）。
+// 1/2 声道给出标准位置，其余声道数标记为 unpositioned。
+inline const spa_pod* build_format_pod(spa_pod_builder& builder, spa_audio_format format,
+    std::uint32_t channels, std::uint32_t rate) noexcept
+{
+    spa_audio_info_raw info { };
+    info.format = format;
+    info.channels = channels;
+    info.rate = rate;
+    if (channels == 1) {
+        info.position[0] = SPA_AUDIO_CHANNEL_MONO;
+    } else if (channels == 2) {
+        info.position[0] = SPA_AUDIO_CHANNEL_FL;
+        info.position[1] = SPA_AUDIO_CHANNEL_FR;
+    } else if (channels > 0) {
+        info.flags = SPA_AUDIO_FLAG_UNPOSITIONED;
+    }
+    return spa_format_audio_raw_build(&builder, SPA_PARAM_EnumFormat, &info);
+}
+
+// 请求的 graph quantum（PW_KEY_NODE_LATENCY，"帧数/采样率"）。约 5ms 取 2 的幂：
+// 48kHz → 256 帧（5.3ms），与 WASAPI 共享模式 10ms 周期相比减半，
+// 仍高于多数桌面 graph 的最小 quantum（64~128），不会迫使整个 graph 降周期。
+inline std::string node_latency(std::uint32_t rate) noexcept
+{
+    const std::uint32_t target = std::max<std::uint32_t>(64, rate / 200);
+    return std::to_string(std::bit_ceil(target)) + "/" + std::to_string(rate);
+}
+
+// 守护进程 socket 是否存在（factory 在 PipeWire 与 ALSA 间选择播放后端用）。
+// 按 libpipewire 的查找顺序：PIPEWIRE_REMOTE（默认 "pipewire-0"），相对名依次在
+// PIPEWIRE_RUNTIME_DIR / XDG_RUNTIME_DIR 下查找。只做 stat，不建立连接。
+inline bool daemon_socket_present() noexcept
+{
+    const char* remote = std::getenv("PIPEWIRE_REMOTE");
+    const std::string name = (remote != nullptr && *remote != '\0') ? remote : "pipewire-0";
+    struct stat st { };
+    if (name.front() == '/') {
+        return ::stat(name.c_str(), &st) == 0 && S_ISSOCK(st.st_mode);
+    }
+    for (const char* env : { "PIPEWIRE_RUNTIME_DIR", "XDG_RUNTIME_DIR" }) {
+        const char* dir = std::getenv(env);
+        if (dir == nullptr || *dir == '\0') {
+            continue;
+        }
+        const std::string path = std::string(dir) + "/" + name;
+        if (::stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace aqua::audio::pipewire
+
+#endif // AQUA_PIPEWIRE_COMMON_H
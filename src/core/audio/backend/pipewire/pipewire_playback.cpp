@@ -0,0 +1,201 @@
+#include "core/audio/backend/pipewire/pipewire_playback.h"
+
+#include "core/audio/backend/pipewire/pipewire_common.h"
+#include "core/logger/logger.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace aqua::audio {
+
+struct PipewirePlaybackEvents {
+    static void on_state_changed(void* data, pw_stream_state /*old*/, pw_stream_state state, const char* error)
+    {
+        auto* self = static_cast<PipewirePlayback*>(data);
+        switch (state) {
+        case PW_STREAM_STATE_ERROR:
+            log_error_fmt("PipeWire playback: stream error: {}", error ? error : "unknown");
+            self->running_.store(false, std::memory_order_release);
+            break;
+        case PW_STREAM_STATE_UNCONNECTED:
+            // 守护进程退出 / sink 被移除：标记停止，ClientRuntime 主循环轮询感知。
+            self->running_.store(false, std::memory_order_release);
+            break;
+        case PW_STREAM_STATE_PAUSED:
+        case PW_STREAM_STATE_STREAMING:
+            self->started_.store(true, std::memory_order_release);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 实时数据线程：dequeue → FillCallback 直写设备 buffer → 补静音 → queue。
+    // 严格禁止锁 / 分配 / 日志。
+    static void on_process(void* data)
+    {
+        auto* self = static_cast<PipewirePlayback*>(data);
+        pw_buffer* b = pw_stream_dequeue_buffer(self->stream_);
+        if (b == nullptr) {
+            return;
+        }
+        spa_data& d = b->buffer->datas[0];
+        if (d.data == nullptr) {
+            pw_stream_queue_buffer(self->stream_, b);
+            return;
+        }
+
+        // requested：graph 本周期需要的帧数（0 = 未知，填满 buffer）。
+        std::uint64_t frames = d.maxsize / self->frame_bytes_;
+        if (b->requested > 0) {
+            frames = std::min<std::uint64_t>(frames, b->requested);
+        }
+        const std::size_t bytes_needed = static_cast<std::size_t>(frames) * self->frame_bytes_;
+        auto* out = static_cast<std::byte*>(d.data);
+
+        std::size_t filled = self->callback_(std::span<std::byte> { out, bytes_needed });
+        // 防御：FillCallback 契约保证 filled <= bytes_needed，再钳制一次防 memset 下溢。
+        if (filled > bytes_needed) {
+            filled = bytes_needed;
+        }
+        if (filled < bytes_needed) {
+            std::memset(out + filled, 0, bytes_needed - filled);
+        }
+
+        d.chunk->offset = 0;
+        d.chunk->stride = static_cast<std::int32_t>(self->frame_bytes_);
+        d.chunk->size = static_cast<std::uint32_t>(bytes_needed);
+        pw_stream_queue_buffer(self->stream_, b);
+    }
+};
+
+namespace {
+    // 逐字段赋值而非指定初始化器：pw_stream_events 随版本追加成员，避免缺省成员告警。
+    pw_stream_events make_stream_events() noexcept
+    {
+        pw_stream_events events { };
+        events.version = PW_VERSION_STREAM_EVENTS;
+        events.state_changed = &PipewirePlaybackEvents::on_state_changed;
+        events.process = &PipewirePlaybackEvents::on_process;
+        return events;
+    }
+
+    // 事件表须在流的整个生命周期内有效。
+    const pw_stream_events PLAYBACK_STREAM_EVENTS = make_stream_events();
+} // namespace
+
+PipewirePlayback::~PipewirePlayback()
+{
+    stop();
+}
+
+bool PipewirePlayback::start(AudioFormat format, FillCallback cb)
+{
+    if (loop_ != nullptr) {
+        return false; // 已启动
+    }
+    if (!format.valid()) {
+        return false;
+    }
+    const spa_audio_format spa_fmt = pipewire::to_spa_format(format.encoding);
+    if (spa_fmt == SPA_AUDIO_FORMAT_UNKNOWN) {
+        log_error_fmt("PipeWire playback: unsupported encoding {}", static_cast<int>(format.encoding));
+        return false;
+    }
+    pipewire::ensure_initialized();
+
+    frame_bytes_ = format.frame_bytes();
+    callback_ = std::move(cb);
+    running_ = true;
+    started_ = false;
+
+    loop_ = pw_thread_loop_new("aqua-playback", nullptr);
+    if (loop_ == nullptr) {
+        log_error("PipeWire playback: pw_thread_loop_new failed");
+        stop();
+        return false;
+    }
+
+    const std::string latency = pipewire::node_latency(format.sample_rate);
+    pw_properties* props = pw_properties_new(
+        PW_KEY_MEDIA_TYPE, "Audio",
+        PW_KEY_MEDIA_CATEGORY, "Playback",
+        PW_KEY_MEDIA_ROLE, "Music",
+        PW_KEY_NODE_LATENCY, latency.c_str(),
+        PW_KEY_NODE_NAME, "aqua_playback",
+        nullptr);
+
+    pw_thread_loop_lock(loop_);
+    if (pw_thread_loop_start(loop_) < 0) {
+        pw_thread_loop_unlock(loop_);
+        pw_properties_free(props);
+        log_error("PipeWire playback: failed to start thread loop");
+        stop();
+        return false;
+    }
+
+    stream_ = pw_stream_new_simple(pw_thread_loop_get_loop(loop_), "aqua-playback", props,
+        &PLAYBACK_STREAM_EVENTS, this);
+    if (stream_ == nullptr) {
+        pw_thread_loop_unlock(loop_);
+        log_error("PipeWire playback: pw_stream_new_simple failed (is the PipeWire daemon running?)");
+        stop();
+        return false;
+    }
+
+    std::uint8_t pod_buffer[1024];
+    spa_pod_builder builder = SPA_POD_BUILDER_INIT(pod_buffer, sizeof(pod_buffer));
+    const spa_pod* params[1] = {
+        pipewire::build_format_pod(builder, spa_fmt, format.channels, format.sample_rate),
+    };
+    const int res = pw_stream_connect(stream_, PW_DIRECTION_OUTPUT, PW_ID_ANY,
+        static_cast<pw_stream_flags>(PW_STREAM_FLAG_AUTOCONNECT
+            | PW_STREAM_FLAG_MAP_BUFFERS
+            | PW_STREAM_FLAG_RT_PROCESS),
+        params, 1);
+    pw_thread_loop_unlock(loop_);
+    if (res < 0) {
+        log_error_fmt("PipeWire playback: pw_stream_connect failed: {}", res);
+        stop();
+        return false;
+    }
+
+    // 等待流连上 sink（最多 1 秒），与 WASAPI / AAudio 后端同步初始化语义一致。
+    for (int i = 0; i < 100 && running_.load(std::memory_order_acquire) && !started_.load(std::memory_order_acquire); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (!started_.load(std::memory_order_acquire) || !running_.load(std::memory_order_acquire)) {
+        log_error("PipeWire playback: stream did not connect to a sink");
+        stop();
+        return false;
+    }
+
+    log_info_fmt("PipeWire playback started: {}ch {}Hz encoding={}, node latency {}",
+        format.channels, format.sample_rate, static_cast<int>(format.encoding), latency);
+    return true;
+}
+
+void PipewirePlayback::stop()
+{
+    running_ = false;
+    if (loop_ != nullptr) {
+        // 先停线程循环再销毁流：之后不会再有任何回调触发。
+        pw_thread_loop_stop(loop_);
+        if (stream_ != nullptr) {
+            pw_stream_destroy(stream_);
+            stream_ = nullptr;
+        }
+        pw_thread_loop_destroy(loop_);
+        loop_ = nullptr;
+    }
+    callback_ = { };
+    started_ = false;
+}
+
+bool PipewirePlayback::is_running() const
+{
+    return running_.load(std::memory_order_acquire);
+}
+
+} // namespace aqua::audio
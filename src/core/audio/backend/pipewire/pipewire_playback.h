@@ -0,0 +1,47 @@
+#ifndef AQUA_PIPEWIRE_PLAYBACK_H
+#define AQUA_PIPEWIRE_PLAYBACK_H
+
+#include "core/audio/backend/audio_backend_factory.h"
+
+#include <atomic>
+#include <cstdint>
+
+struct pw_thread_loop;
+struct pw_stream;
+
+namespace aqua::audio {
+
+// Linux PipeWire 播放后端：输出到默认 sink，按请求格式直通（PipeWire 负责 graph 侧转换）。
+//
+// 线程模型：
+//   - start()/stop() 在调用方线程（client_runtime 会话线程）。
+//   - process 回调在 PipeWire 实时数据线程（PW_STREAM_FLAG_RT_PROCESS），
+//     FillCallback 直接写入 pw_buffer 内存（SpscRingBuffer → 设备 buffer，无中转拷贝），
+//     不足部分补静音。
+//   - state 回调在 pw_thread_loop 线程，仅做原子置位。
+class PipewirePlayback final : public PlaybackBackend {
+public:
+    PipewirePlayback() = default;
+    ~PipewirePlayback() override;
+
+    bool start(AudioFormat format, FillCallback cb) override;
+    void stop() override;
+    bool is_running() const override;
+
+private:
+    friend struct PipewirePlaybackEvents;
+
+    pw_thread_loop* loop_ = nullptr;
+    pw_stream* stream_ = nullptr;
+    FillCallback callback_;
+    std::uint32_t frame_bytes_ = 0;
+
+    // running_: 流存活（未进入 ERROR / UNCONNECTED）。stop() 也会置 false。
+    // started_: 流已连接并完成格式协商（进入 PAUSED / STREAMING）。
+    std::atomic<bool> running_ { false };
+    std::atomic<bool> started_ { false };
+};
+
+} // namespace aqua::audio
+
+#endif // AQUA_PIPEWIRE_PLAYBACK_H
@@ -5,6 +5,7 @@
 
 #include <chrono>
 #include <cstring>
+#include <optional>
 #include <thread>
 
 namespace aqua::audio {
@@ -12,6 +13,27 @@ namespace aqua::audio {
 namespace {
     using wasapi::audio_format_to_wave_format;
     using wasapi::ComPtr;
+    using wasapi::wave_format_to_audio_format;
+
+    // 默认输出设备的 IAudioClient（调用方已初始化 COM）。失败返回空指针。
+    ComPtr<IAudioClient> activate_default_render_client()
+    {
+        ComPtr<IMMDeviceEnumerator> enumerator;
+        if (FAILED(CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL,
+                IID_PPV_ARGS(enumerator.put())))) {
+            return { };
+        }
+        ComPtr<IMMDevice> device;
+        if (FAILED(enumerator->GetDefaultAudioEndpoint(eRender, eConsole, device.put()))) {
+            return { };
+        }
+        ComPtr<IAudioClient> audio_client;
+        if (FAILED(device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr,
+                reinterpret_cast<void**>(audio_client.put())))) {
+            return { };
+        }
+        return audio_client;
+    }
 } // namespace
 
 WasapiPlayback::~WasapiPlayback()
@@ -19,6 +41,57 @@ WasapiPlayback::~WasapiPlayback()
     stop();
 }
 
+AudioFormat WasapiPlayback::negotiate_format(const AudioFormat& requested)
+{
+    WAVEFORMATEXTENSIBLE wfx { };
+    if (running_ || !audio_format_to_wave_format(requested, wfx)) {
+        return requested;
+    }
+
+    const HRESULT init_hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    const bool com_initialized = SUCCEEDED(init_hr);
+    if (FAILED(init_hr) && init_hr != RPC_E_CHANGED_MODE) {
+        return requested;
+    }
+
+    AudioFormat result = requested;
+    {
+        auto audio_client = activate_default_render_client();
+        if (audio_client) {
+            WAVEFORMATEX* closest = nullptr;
+            const HRESULT hr = audio_client->IsFormatSupported(AUDCLNT_SHAREMODE_SHARED,
+                reinterpret_cast<WAVEFORMATEX*>(&wfx), &closest);
+            std::optional<AudioFormat> device_fmt;
+            if (hr == S_FALSE && closest) {
+                device_fmt = wave_format_to_audio_format(closest);
+            } else if (hr != S_OK) {
+                WAVEFORMATEX* mix_format = nullptr;
+                if (SUCCEEDED(audio_client->GetMixFormat(&mix_format))) {
+                    device_fmt = wave_format_to_audio_format(mix_format);
+                    CoTaskMemFree(mix_format);
+                }
+            }
+            if (closest)
+                CoTaskMemFree(closest);
+            if (device_fmt) {
+                result.encoding = device_fmt->encoding;
+                result.channels = device_fmt->channels;
+                result.sample_rate = device_fmt->sample_rate;
+            }
+        }
+    } // audio_client 在 CoUninitialize 之前释放
+
+    if (com_initialized)
+        CoUninitialize();
+
+    if (result != requested) {
+        log_info_fmt("WASAPI playback: device prefers {}ch {}Hz encoding={} over {}ch {}Hz encoding={}",
+            result.channels, result.sample_rate, static_cast<int>(result.encoding),
+            requested.channels, requested.sample_rate, static_cast<int>(requested.encoding));
+    }
+    return result;
+}
+
 bool WasapiPlayback::start(AudioFormat format, FillCallback cb)
 {
     if (running_)
@@ -10,6 +10,8 @@ namespace aqua::audio {
 
 // Windows WASAPI 播放后端。
 // 以共享模式渲染到默认输出设备。
+// negotiate_format 在调用方线程临时激活设备，用 IsFormatSupported 取 closest match
+// （无 closest 时用 mix format）的编码、声道数与采样率。
 class WasapiPlayback : public PlaybackBackend {
 public:
     WasapiPlayback() = default;
@@ -19,6 +21,8 @@ public:
     void stop() override;
     bool is_running() const override;
 
+    AudioFormat negotiate_format(const AudioFormat& requested) override;
+
 private:
     void playback_loop();
 
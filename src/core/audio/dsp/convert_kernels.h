@@ -0,0 +1,72 @@
+#ifndef AQUA_CONVERT_KERNELS_H
+#define AQUA_CONVERT_KERNELS_H
+
+// sample_convert.cpp 与各指令集编解码内核之间的内部接口，不对外暴露。
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aqua::audio::dsp::detail {
+
+// 交织 PCM ↔ 归一化 float，处理 samples 个样本。pcm 无对齐要求。
+using DecodeKernelFn = void (*)(const std::byte* pcm, float* out, std::size_t samples) noexcept;
+using EncodeKernelFn = void (*)(const float* in, std::byte* pcm, std::size_t samples) noexcept;
+
+// F32 为 memcpy、S24 解码（逐样本拼 3 字节）无向量化收益，只有标量路径。
+// S24 编码在 AVX2 / NEON 上用字节重排打包，SSE2 只向量化取整钳位。
+struct ConvertKernels {
+    DecodeKernelFn decode_s16;
+    DecodeKernelFn decode_s32;
+    DecodeKernelFn decode_u8;
+    EncodeKernelFn encode_s16;
+    EncodeKernelFn encode_s24;
+    EncodeKernelFn encode_s32;
+    EncodeKernelFn encode_u8;
+};
+
+// 标量内核（SIMD 内核的尾部也调用它们）
+void decode_s16_scalar(const std::byte* pcm, float* out, std::size_t samples) noexcept;
+void decode_s32_scalar(const std::byte* pcm, float* out, std::size_t samples) noexcept;
+void decode_u8_scalar(const std::byte* pcm, float* out, std::size_t samples) noexcept;
+void encode_s16_scalar(const float* in, std::byte* pcm, std::size_t samples) noexcept;
+void encode_s24_scalar(const float* in, std::byte* pcm, std::size_t samples) noexcept;
+void encode_s32_scalar(const float* in, std::byte* pcm, std::size_t samples) noexcept;
+void encode_u8_scalar(const float* in, std::byte* pcm, std::size_t samples) noexcept;
+
+// 缩放因子均为 2 的幂：int→float 后乘 1/scale 与标量除法按位一致。
+inline constexpr float S16_SCALE = 32768.0f;
+inline constexpr float S24_SCALE = 8388608.0f;
+inline constexpr float S32_SCALE = 2147483648.0f;
+inline constexpr float U8_SCALE = 128.0f;
+
+// S24 打包：int32 低 3 字节（小端）。
+inline void store_s24(std::byte* p, std::int32_t v) noexcept
+{
+    p[0] = static_cast<std::byte>(v & 0xFF);
+    p[1] = static_cast<std::byte>((v >> 8) & 0xFF);
+    p[2] = static_cast<std::byte>((v >> 16) & 0xFF);
+}
+
+// SIMD 编码的等价形式：NaN 置零 → 乘 scale → 在 float 域钳到 [lo, hi] → 就近偶数取整。
+// 与标量"先取整后在 int64 域饱和"结果相同（边界值本身是整数）。S32 上界 2^31 在
+// cvtps 中溢出为 0x80000000，由内核修正为 INT32_MAX。
+inline constexpr float S16_ENCODE_MIN = -32768.0f;
+inline constexpr float S16_ENCODE_MAX = 32767.0f;
+inline constexpr float S24_ENCODE_MIN = -8388608.0f;
+inline constexpr float S24_ENCODE_MAX = 8388607.0f;
+inline constexpr float U8_ENCODE_MIN = -128.0f;
+inline constexpr float U8_ENCODE_MAX = 127.0f;
+inline constexpr float S32_ENCODE_MIN = -2147483648.0f;
+inline constexpr float S32_ENCODE_MAX = 2147483648.0f;
+
+#if defined(__x86_64__) || defined(_M_X64)
+extern const ConvertKernels SSE2_CONVERT_KERNELS;
+extern const ConvertKernels AVX2_CONVERT_KERNELS;
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+extern const ConvertKernels NEON_CONVERT_KERNELS;
+#endif
+
+} // namespace aqua::audio::dsp::detail
+
+#endif // AQUA_CONVERT_KERNELS_H
@@ -0,0 +1,129 @@
+// NEON 编解码内核（PCM ↔ float，AArch64 基线）。
+
+#include "core/audio/dsp/convert_kernels.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#include <cstdint>
+
+namespace aqua::audio::dsp::detail {
+
+namespace {
+
+    // NaN 置零（vceqq(v, v) 对 NaN lane 给出全零掩码），再缩放并钳位。
+    inline float32x4_t prepare_neon(float32x4_t v, float scale, float lo, float hi) noexcept
+    {
+        const float32x4_t finite = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(v), vceqq_f32(v, v)));
+        const float32x4_t scaled = vmulq_f32(finite, vdupq_n_f32(scale));
+        return vminq_f32(vmaxq_f32(scaled, vdupq_n_f32(lo)), vdupq_n_f32(hi));
+    }
+
+    // 字节指针按字节装载再重解释，不对 payload 对齐做任何假设
+    void decode_s16_neon(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        const float32x4_t k = vdupq_n_f32(1.0f / S16_SCALE);
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            const int16x8_t x = vreinterpretq_s16_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(pcm + i * 2)));
+            vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), k));
+            vst1q_f32(out + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), k));
+        }
+        decode_s16_scalar(pcm + i * 2, out + i, samples - i);
+    }
+
+    void decode_s32_neon(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        const float32x4_t k = vdupq_n_f32(1.0f / S32_SCALE);
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            const int32x4_t x = vreinterpretq_s32_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(pcm + i * 4)));
+            vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(x), k));
+        }
+        decode_s32_scalar(pcm + i * 4, out + i, samples - i);
+    }
+
+    void decode_u8_neon(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        const float32x4_t k = vdupq_n_f32(1.0f / U8_SCALE);
+        const float32x4_t bias = vdupq_n_f32(128.0f);
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            const uint16x8_t x = vmovl_u8(vld1_u8(reinterpret_cast<const std::uint8_t*>(pcm + i)));
+            const float32x4_t lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(x)));
+            const float32x4_t hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(x)));
+            vst1q_f32(out + i, vmulq_f32(vsubq_f32(lo, bias), k));
+            vst1q_f32(out + i + 4, vmulq_f32(vsubq_f32(hi, bias), k));
+        }
+        decode_u8_scalar(pcm + i, out + i, samples - i);
+    }
+
+    void encode_s16_neon(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            const float32x4_t lo = prepare_neon(vld1q_f32(in + i), S16_SCALE, S16_ENCODE_MIN, S16_ENCODE_MAX);
+            const float32x4_t hi = prepare_neon(vld1q_f32(in + i + 4), S16_SCALE, S16_ENCODE_MIN, S16_ENCODE_MAX);
+            // vcvtnq 就近偶数取整，与标量 nearbyint（默认舍入模式）一致
+            const int16x8_t r = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(lo)), vqmovn_s32(vcvtnq_s32_f32(hi)));
+            vst1q_u8(reinterpret_cast<std::uint8_t*>(pcm + i * 2), vreinterpretq_u8_s16(r));
+        }
+        encode_s16_scalar(in + i, pcm + i * 2, samples - i);
+    }
+
+    void encode_s32_neon(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            const float32x4_t f = prepare_neon(vld1q_f32(in + i), S32_SCALE, S32_ENCODE_MIN, S32_ENCODE_MAX);
+            // AArch64 浮点转整数饱和：2^31 直接得到 INT32_MAX，无需修正
+            vst1q_u8(reinterpret_cast<std::uint8_t*>(pcm + i * 4), vreinterpretq_u8_s32(vcvtnq_s32_f32(f)));
+        }
+        encode_s32_scalar(in + i, pcm + i * 4, samples - i);
+    }
+
+    void encode_s24_neon(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        // 4 个 int32 的低 3 字节查表压到前 12 字节；16 字节写多出的 4 字节落在后续样本上，
+        // 因此至少留 2 个样本给下一轮或尾部
+        static constexpr std::uint8_t PACK[16] = { 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 0xFF, 0xFF, 0xFF, 0xFF };
+        const uint8x16_t pack = vld1q_u8(PACK);
+        std::size_t i = 0;
+        for (; i + 6 <= samples; i += 4) {
+            const float32x4_t f = prepare_neon(vld1q_f32(in + i), S24_SCALE, S24_ENCODE_MIN, S24_ENCODE_MAX);
+            const uint8x16_t b = vqtbl1q_u8(vreinterpretq_u8_s32(vcvtnq_s32_f32(f)), pack);
+            vst1q_u8(reinterpret_cast<std::uint8_t*>(pcm + i * 3), b);
+        }
+        encode_s24_scalar(in + i, pcm + i * 3, samples - i);
+    }
+
+    void encode_u8_neon(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            const float32x4_t lo = prepare_neon(vld1q_f32(in + i), U8_SCALE, U8_ENCODE_MIN, U8_ENCODE_MAX);
+            const float32x4_t hi = prepare_neon(vld1q_f32(in + i + 4), U8_SCALE, U8_ENCODE_MIN, U8_ENCODE_MAX);
+            const int16x8_t s16 = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(lo)), vqmovn_s32(vcvtnq_s32_f32(hi)));
+            // 已钳到 int8 范围；翻转符号位即为偏置 128
+            const uint8x8_t u8 = veor_u8(vreinterpret_u8_s8(vqmovn_s16(s16)), vdup_n_u8(0x80));
+            vst1_u8(reinterpret_cast<std::uint8_t*>(pcm + i), u8);
+        }
+        encode_u8_scalar(in + i, pcm + i, samples - i);
+    }
+
+} // namespace
+
+const ConvertKernels NEON_CONVERT_KERNELS {
+    decode_s16_neon,
+    decode_s32_neon,
+    decode_u8_neon,
+    encode_s16_neon,
+    encode_s24_neon,
+    encode_s32_neon,
+    encode_u8_neon,
+};
+
+} // namespace aqua::audio::dsp::detail
+
+#endif // AArch64
@@ -0,0 +1,269 @@
+// SSE2 / AVX2 编解码内核（PCM ↔ float）。AVX2 用函数级 target 属性编译，
+// 运行时由 detect_simd_level() 保证只在支持的 CPU 上调用。
+
+#include "core/audio/dsp/convert_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <immintrin.h>
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define AQUA_TARGET_AVX2
+#else
+#define AQUA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace aqua::audio::dsp::detail {
+
+namespace {
+
+    // ---- SSE2：4 lane ----
+
+    // NaN 置零（cmpord 对 NaN lane 给出全零掩码），再缩放并钳位。
+    inline __m128 prepare_sse2(__m128 v, float scale, float lo, float hi) noexcept
+    {
+        const __m128 finite = _mm_and_ps(v, _mm_cmpord_ps(v, v));
+        const __m128 scaled = _mm_mul_ps(finite, _mm_set1_ps(scale));
+        return _mm_min_ps(_mm_max_ps(scaled, _mm_set1_ps(lo)), _mm_set1_ps(hi));
+    }
+
+    void decode_s16_sse2(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        const __m128 k = _mm_set1_ps(1.0f / S16_SCALE);
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pcm + i * 2));
+            // 符号扩展 int16 → int32：复制到高半字再算术右移
+            const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+            const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), k));
+            _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), k));
+        }
+        decode_s16_scalar(pcm + i * 2, out + i, samples - i);
+    }
+
+    void decode_s32_sse2(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        const __m128 k = _mm_set1_ps(1.0f / S32_SCALE);
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pcm + i * 4));
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(x), k));
+        }
+        decode_s32_scalar(pcm + i * 4, out + i, samples - i);
+    }
+
+    void decode_u8_sse2(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        const __m128 k = _mm_set1_ps(1.0f / U8_SCALE);
+        const __m128 bias = _mm_set1_ps(128.0f);
+        const __m128i zero = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 16 <= samples; i += 16) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pcm + i));
+            const __m128i w[2] = { _mm_unpacklo_epi8(x, zero), _mm_unpackhi_epi8(x, zero) };
+            for (int h = 0; h < 2; ++h) {
+                // 小整数减偏置在 float 域精确，与标量先减后转一致
+                const __m128 lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(w[h], zero));
+                const __m128 hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(w[h], zero));
+                _mm_storeu_ps(out + i + h * 8, _mm_mul_ps(_mm_sub_ps(lo, bias), k));
+                _mm_storeu_ps(out + i + h * 8 + 4, _mm_mul_ps(_mm_sub_ps(hi, bias), k));
+            }
+        }
+        decode_u8_scalar(pcm + i, out + i, samples - i);
+    }
+
+    void encode_s16_sse2(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            const __m128 lo = prepare_sse2(_mm_loadu_ps(in + i), S16_SCALE, S16_ENCODE_MIN, S16_ENCODE_MAX);
+            const __m128 hi = prepare_sse2(_mm_loadu_ps(in + i + 4), S16_SCALE, S16_ENCODE_MIN, S16_ENCODE_MAX);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pcm + i * 2),
+                _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi)));
+        }
+        encode_s16_scalar(in + i, pcm + i * 2, samples - i);
+    }
+
+    void encode_s32_sse2(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        const __m128 top = _mm_set1_ps(S32_ENCODE_MAX);
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            const __m128 f = prepare_sse2(_mm_loadu_ps(in + i), S32_SCALE, S32_ENCODE_MIN, S32_ENCODE_MAX);
+            // 2^31 溢出为 0x80000000，与全 1 掩码异或得 0x7FFFFFFF
+            const __m128i overflow = _mm_castps_si128(_mm_cmpge_ps(f, top));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pcm + i * 4), _mm_xor_si128(_mm_cvtps_epi32(f), overflow));
+        }
+        encode_s32_scalar(in + i, pcm + i * 4, samples - i);
+    }
+
+    void encode_s24_sse2(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        // SSE2 没有字节重排指令：向量取整钳位后逐样本打包
+        alignas(16) std::int32_t q[4];
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            const __m128 f = prepare_sse2(_mm_loadu_ps(in + i), S24_SCALE, S24_ENCODE_MIN, S24_ENCODE_MAX);
+            _mm_store_si128(reinterpret_cast<__m128i*>(q), _mm_cvtps_epi32(f));
+            for (int j = 0; j < 4; ++j) {
+                store_s24(pcm + (i + j) * 3, q[j]);
+            }
+        }
+        encode_s24_scalar(in + i, pcm + i * 3, samples - i);
+    }
+
+    void encode_u8_sse2(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+        std::size_t i = 0;
+        for (; i + 16 <= samples; i += 16) {
+            __m128i q[4];
+            for (int j = 0; j < 4; ++j) {
+                q[j] = _mm_cvtps_epi32(prepare_sse2(_mm_loadu_ps(in + i + j * 4), U8_SCALE, U8_ENCODE_MIN, U8_ENCODE_MAX));
+            }
+            // 已钳到 int8 范围，两级饱和打包不再改变数值；翻转符号位即为偏置 128
+            const __m128i s8 = _mm_packs_epi16(_mm_packs_epi32(q[0], q[1]), _mm_packs_epi32(q[2], q[3]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pcm + i), _mm_xor_si128(s8, bias));
+        }
+        encode_u8_scalar(in + i, pcm + i, samples - i);
+    }
+
+    // ---- AVX2：8 lane ----
+
+    AQUA_TARGET_AVX2 inline __m256 prepare_avx2(__m256 v, float scale, float lo, float hi) noexcept
+    {
+        const __m256 finite = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+        const __m256 scaled = _mm256_mul_ps(finite, _mm256_set1_ps(scale));
+        return _mm256_min_ps(_mm256_max_ps(scaled, _mm256_set1_ps(lo)), _mm256_set1_ps(hi));
+    }
+
+    AQUA_TARGET_AVX2 void decode_s16_avx2(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        const __m256 k = _mm256_set1_ps(1.0f / S16_SCALE);
+        std::size_t i = 0;
+        for (; i + 16 <= samples; i += 16) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pcm + i * 2));
+            const __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(x));
+            const __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), k));
+            _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), k));
+        }
+        decode_s16_scalar(pcm + i * 2, out + i, samples - i);
+    }
+
+    AQUA_TARGET_AVX2 void decode_s32_avx2(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        const __m256 k = _mm256_set1_ps(1.0f / S32_SCALE);
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pcm + i * 4));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(x), k));
+        }
+        decode_s32_scalar(pcm + i * 4, out + i, samples - i);
+    }
+
+    AQUA_TARGET_AVX2 void decode_u8_avx2(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        const __m256 k = _mm256_set1_ps(1.0f / U8_SCALE);
+        const __m256 bias = _mm256_set1_ps(128.0f);
+        std::size_t i = 0;
+        for (; i + 16 <= samples; i += 16) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pcm + i));
+            const __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(x));
+            const __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(x, 8)));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_sub_ps(lo, bias), k));
+            _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(_mm256_sub_ps(hi, bias), k));
+        }
+        decode_u8_scalar(pcm + i, out + i, samples - i);
+    }
+
+    AQUA_TARGET_AVX2 void encode_s16_avx2(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 16 <= samples; i += 16) {
+            const __m256 lo = prepare_avx2(_mm256_loadu_ps(in + i), S16_SCALE, S16_ENCODE_MIN, S16_ENCODE_MAX);
+            const __m256 hi = prepare_avx2(_mm256_loadu_ps(in + i + 8), S16_SCALE, S16_ENCODE_MIN, S16_ENCODE_MAX);
+            // packs 按 128 位 lane 交错（lo0 hi0 lo1 hi1），permute 还原为顺序排列
+            const __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(lo), _mm256_cvtps_epi32(hi));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pcm + i * 2), _mm256_permute4x64_epi64(packed, 0xD8));
+        }
+        encode_s16_scalar(in + i, pcm + i * 2, samples - i);
+    }
+
+    AQUA_TARGET_AVX2 void encode_s32_avx2(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        const __m256 top = _mm256_set1_ps(S32_ENCODE_MAX);
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            const __m256 f = prepare_avx2(_mm256_loadu_ps(in + i), S32_SCALE, S32_ENCODE_MIN, S32_ENCODE_MAX);
+            const __m256i overflow = _mm256_castps_si256(_mm256_cmp_ps(f, top, _CMP_GE_OQ));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pcm + i * 4),
+                _mm256_xor_si256(_mm256_cvtps_epi32(f), overflow));
+        }
+        encode_s32_scalar(in + i, pcm + i * 4, samples - i);
+    }
+
+    AQUA_TARGET_AVX2 void encode_s24_avx2(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        // 每个 128 位 lane 内把 4 个 int32 的低 3 字节压到前 12 字节
+        const __m256i pack = _mm256_setr_epi8(
+            0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+            0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        std::size_t i = 0;
+        // 两次 16 字节写各多写 4 字节：第一次的由第二次覆盖，第二次的落在后续样本上，
+        // 因此至少留 2 个样本（6 字节）给下一轮或尾部
+        for (; i + 10 <= samples; i += 8) {
+            const __m256 f = prepare_avx2(_mm256_loadu_ps(in + i), S24_SCALE, S24_ENCODE_MIN, S24_ENCODE_MAX);
+            const __m256i b = _mm256_shuffle_epi8(_mm256_cvtps_epi32(f), pack);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pcm + i * 3), _mm256_castsi256_si128(b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pcm + i * 3 + 12), _mm256_extracti128_si256(b, 1));
+        }
+        encode_s24_scalar(in + i, pcm + i * 3, samples - i);
+    }
+
+    AQUA_TARGET_AVX2 void encode_u8_avx2(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80));
+        // 两级 lane 内打包后各 4 样本一组按 lane 交错（q0lo q1lo q2lo q3lo q0hi ...），permutevar 还原
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        std::size_t i = 0;
+        for (; i + 32 <= samples; i += 32) {
+            __m256i q[4];
+            for (int j = 0; j < 4; ++j) {
+                q[j] = _mm256_cvtps_epi32(
+                    prepare_avx2(_mm256_loadu_ps(in + i + j * 8), U8_SCALE, U8_ENCODE_MIN, U8_ENCODE_MAX));
+            }
+            const __m256i s8 = _mm256_packs_epi16(_mm256_packs_epi32(q[0], q[1]), _mm256_packs_epi32(q[2], q[3]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pcm + i),
+                _mm256_xor_si256(_mm256_permutevar8x32_epi32(s8, order), bias));
+        }
+        encode_u8_scalar(in + i, pcm + i, samples - i);
+    }
+
+} // namespace
+
+const ConvertKernels SSE2_CONVERT_KERNELS {
+    decode_s16_sse2,
+    decode_s32_sse2,
+    decode_u8_sse2,
+    encode_s16_sse2,
+    encode_s24_sse2,
+    encode_s32_sse2,
+    encode_u8_sse2,
+};
+const ConvertKernels AVX2_CONVERT_KERNELS {
+    decode_s16_avx2,
+    decode_s32_avx2,
+    decode_u8_avx2,
+    encode_s16_avx2,
+    encode_s24_avx2,
+    encode_s32_avx2,
+    encode_u8_avx2,
+};
+
+} // namespace aqua::audio::dsp::detail
+
+#endif // x86-64
@@ -0,0 +1,83 @@
+#include "core/audio/dsp/cpu_features.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace aqua::audio::dsp {
+
+namespace {
+
+#if defined(__x86_64__) || defined(_M_X64)
+    bool cpu_has_avx2() noexcept
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        // CPUID.7.0:EBX[5] = AVX2；还需 OS 已启用 YMM 状态保存（OSXSAVE + XCR0[2:1]）。
+        int regs[4] { };
+        __cpuid(regs, 1);
+        const bool osxsave = (regs[2] & (1 << 27)) != 0;
+        const bool avx = (regs[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(regs, 7, 0);
+        return (regs[1] & (1 << 5)) != 0;
+#else
+        // __builtin_cpu_supports 已包含 OS 支持检查
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+#endif
+
+    SimdLevel detect_uncached() noexcept
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        return cpu_has_avx2() ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        return SimdLevel::Neon;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+} // namespace
+
+SimdLevel detect_simd_level() noexcept
+{
+    static const SimdLevel level = detect_uncached();
+    return level;
+}
+
+bool simd_level_supported(SimdLevel level) noexcept
+{
+    const SimdLevel best = detect_simd_level();
+    switch (level) {
+    case SimdLevel::Scalar:
+        return true;
+    case SimdLevel::Sse2:
+        return best == SimdLevel::Sse2 || best == SimdLevel::Avx2;
+    case SimdLevel::Avx2:
+        return best == SimdLevel::Avx2;
+    case SimdLevel::Neon:
+        return best == SimdLevel::Neon;
+    }
+    return false;
+}
+
+const char* simd_level_name(SimdLevel level) noexcept
+{
+    switch (level) {
+    case SimdLevel::Scalar:
+        return "scalar";
+    case SimdLevel::Sse2:
+        return "sse2";
+    case SimdLevel::Avx2:
+        return "avx2";
+    case SimdLevel::Neon:
+        return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace aqua::audio::dsp
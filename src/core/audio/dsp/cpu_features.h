@@ -0,0 +1,26 @@
+#ifndef AQUA_CPU_FEATURES_H
+#define AQUA_CPU_FEATURES_H
+
+#include <cstdint>
+
+namespace aqua::audio::dsp {
+
+// DSP 内核的指令集档位。x86-64 基线即含 SSE2；AArch64 基线即含 NEON。
+enum class SimdLevel : std::uint8_t {
+    Scalar,
+    Sse2,
+    Avx2,
+    Neon,
+};
+
+// 运行时检测当前 CPU 可用的最高档位（首次调用检测，之后返回缓存值）。
+[[nodiscard]] SimdLevel detect_simd_level() noexcept;
+
+// 指定档位在当前 CPU 与当前编译目标上是否可用（Scalar 恒可用）。
+[[nodiscard]] bool simd_level_supported(SimdLevel level) noexcept;
+
+[[nodiscard]] const char* simd_level_name(SimdLevel level) noexcept;
+
+} // namespace aqua::audio::dsp
+
+#endif // AQUA_CPU_FEATURES_H
@@ -0,0 +1,311 @@
+#include "core/audio/dsp/format_converter.h"
+#include "core/audio/dsp/sample_convert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace aqua::audio::dsp {
+
+namespace {
+    enum class Position : std::uint8_t {
+        Unknown,
+        FL,
+        FR,
+        FC,
+        LFE,
+        BL,
+        BR,
+        BC,
+        SL,
+        SR,
+    };
+
+    // 各声道数的默认布局（WAVEFORMATEXTENSIBLE 默认掩码顺序）。
+    Position position_of(std::uint32_t channels, std::uint32_t index) noexcept
+    {
+        using enum Position;
+        static constexpr Position L3[] = { FL, FR, FC };
+        static constexpr Position L4[] = { FL, FR, BL, BR };
+        static constexpr Position L5[] = { FL, FR, FC, BL, BR };
+        static constexpr Position L6[] = { FL, FR, FC, LFE, BL, BR };
+        static constexpr Position L7[] = { FL, FR, FC, LFE, BC, SL, SR };
+        static constexpr Position L8[] = { FL, FR, FC, LFE, BL, BR, SL, SR };
+        switch (channels) {
+        case 1:
+            return FC;
+        case 3:
+            return L3[index];
+        case 4:
+            return L4[index];
+        case 5:
+            return L5[index];
+        case 6:
+            return L6[index];
+        case 7:
+            return L7[index];
+        case 8:
+            return L8[index];
+        default:
+            // 立体声及未知布局：前两路视为 FL / FR
+            return index == 0 ? FL : index == 1 ? FR : Unknown;
+        }
+    }
+
+    constexpr float MINUS_3DB = 0.70710678f;
+
+    // 单个输入声道对立体声 L / R 的贡献。
+    std::pair<float, float> stereo_weights(Position p) noexcept
+    {
+        switch (p) {
+        case Position::FL:
+            return { 1.0f, 0.0f };
+        case Position::FR:
+            return { 0.0f, 1.0f };
+        case Position::FC:
+            return { MINUS_3DB, MINUS_3DB };
+        case Position::BL:
+        case Position::SL:
+            return { MINUS_3DB, 0.0f };
+        case Position::BR:
+        case Position::SR:
+            return { 0.0f, MINUS_3DB };
+        case Position::BC:
+            return { 0.5f, 0.5f };
+        case Position::LFE:
+        case Position::Unknown:
+            break;
+        }
+        return { 0.0f, 0.0f };
+    }
+
+    // 有效分辨率（位）：F32 按 24 位尾数计。
+    std::uint32_t resolution_bits(AudioEncoding encoding) noexcept
+    {
+        switch (encoding) {
+        case AudioEncoding::PcmU8:
+            return 8;
+        case AudioEncoding::PcmS16LE:
+            return 16;
+        case AudioEncoding::PcmS24LE:
+        case AudioEncoding::PcmF32LE:
+            return 24;
+        case AudioEncoding::PcmS32LE:
+            return 32;
+        case AudioEncoding::Invalid:
+            break;
+        }
+        return 0;
+    }
+
+    bool is_identity(const std::vector<float>& m, std::uint32_t in_channels, std::uint32_t out_channels) noexcept
+    {
+        if (in_channels != out_channels) {
+            return false;
+        }
+        for (std::uint32_t o = 0; o < out_channels; ++o) {
+            for (std::uint32_t i = 0; i < in_channels; ++i) {
+                if (m[o * in_channels + i] != (o == i ? 1.0f : 0.0f)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+} // namespace
+
+std::vector<float> default_channel_matrix(std::uint32_t in_channels, std::uint32_t out_channels)
+{
+    std::vector<float> m(static_cast<std::size_t>(in_channels) * out_channels, 0.0f);
+    if (in_channels == out_channels) {
+        for (std::uint32_t c = 0; c < in_channels; ++c) {
+            m[c * in_channels + c] = 1.0f;
+        }
+        return m;
+    }
+
+    if (out_channels <= 2 && in_channels > 1) {
+        // 先折叠为立体声，每行按绝对值和归一化（全部声道同相满幅时不削波）
+        std::vector<float> stereo(2 * static_cast<std::size_t>(in_channels), 0.0f);
+        for (std::uint32_t i = 0; i < in_channels; ++i) {
+            const auto [l, r] = stereo_weights(position_of(in_channels, i));
+            stereo[i] = l;
+            stereo[in_channels + i] = r;
+        }
+        for (std::uint32_t row = 0; row < 2; ++row) {
+            float sum = 0.0f;
+            for (std::uint32_t i = 0; i < in_channels; ++i) {
+                sum += std::abs(stereo[row * in_channels + i]);
+            }
+            if (sum > 1.0f) {
+                for (std::uint32_t i = 0; i < in_channels; ++i) {
+                    stereo[row * in_channels + i] /= sum;
+                }
+            }
+        }
+        if (out_channels == 2) {
+            return stereo;
+        }
+        for (std::uint32_t i = 0; i < in_channels; ++i) {
+            m[i] = 0.5f * (stereo[i] + stereo[in_channels + i]);
+        }
+        return m;
+    }
+
+    if (in_channels == 1) {
+        // 单声道 → FL / FR（输出单声道时已由上方单位阵处理）
+        m[0] = 1.0f;
+        m[1] = 1.0f;
+        return m;
+    }
+
+    // 立体声 → 多声道、多声道之间：共同前缀一一对应
+    for (std::uint32_t c = 0; c < std::min(in_channels, out_channels); ++c) {
+        m[c * in_channels + c] = 1.0f;
+    }
+    return m;
+}
+
+FormatConverter::FormatConverter(const AudioFormat& in, const AudioFormat& out, std::size_t max_frames,
+    FormatConverterOptions options)
+    : in_(in)
+    , out_(out)
+    , max_frames_(max_frames)
+    , max_output_frames_(max_frames)
+{
+    if (!in.valid() || !out.valid()) {
+        throw std::invalid_argument("FormatConverter requires valid AudioFormats");
+    }
+    if (max_frames == 0) {
+        throw std::invalid_argument("FormatConverter max_frames must be > 0");
+    }
+
+    auto matrix = options.matrix.empty() ? default_channel_matrix(in.channels, out.channels) : std::move(options.matrix);
+    if (matrix.size() != static_cast<std::size_t>(in.channels) * out.channels) {
+        throw std::invalid_argument("FormatConverter matrix must be out_channels x in_channels");
+    }
+    const bool identity = is_identity(matrix, in.channels, out.channels);
+    if (!identity) {
+        matrix_ = std::move(matrix);
+    }
+
+    if (in.sample_rate != out.sample_rate) {
+        // 在较少的一侧声道数上转换采样率
+        mix_before_resample_ = out.channels <= in.channels;
+        const auto channels = identity || mix_before_resample_ ? out.channels : in.channels;
+        resampler_ = std::make_unique<PolyphaseResampler>(channels, in.sample_rate, out.sample_rate, max_frames);
+        max_output_frames_ = resampler_->max_output_frames();
+        rs_f_.resize(max_output_frames_ * channels);
+    }
+    if (!identity) {
+        out_f_.resize(std::max(max_frames, max_output_frames_) * out.channels);
+    }
+
+    const auto out_bits = resolution_bits(out.encoding);
+    if (options.dither && out_bits <= 16
+        && (out_bits < resolution_bits(in.encoding) || !identity || resampler_)) {
+        dither_lsb_ = out.encoding == AudioEncoding::PcmU8 ? 1.0f / 128.0f : 1.0f / 32768.0f;
+    }
+
+    in_f_.resize(max_frames * in.channels);
+    pcm_.resize(max_output_frames_ * out.frame_bytes());
+}
+
+void FormatConverter::reset() noexcept
+{
+    if (resampler_) {
+        resampler_->reset();
+    }
+}
+
+void FormatConverter::mix(std::span<const float> src_samples, std::size_t frames, float* dst) noexcept
+{
+    const std::size_t ic = in_.channels;
+    const std::size_t oc = out_.channels;
+    const float* src = src_samples.data();
+    for (std::size_t f = 0; f < frames; ++f) {
+        for (std::size_t o = 0; o < oc; ++o) {
+            const float* row = matrix_.data() + o * ic;
+            float acc = 0.0f;
+            for (std::size_t i = 0; i < ic; ++i) {
+                acc += row[i] * src[i];
+            }
+            dst[o] = acc;
+        }
+        src += ic;
+        dst += oc;
+    }
+}
+
+void FormatConverter::dither(std::span<float> samples) noexcept
+{
+    // 一次 xorshift32 拆成两个 16 位均匀分布，差值为 (-1, 1) LSB 三角分布，均值 0
+    constexpr float UNIT = 1.0f / 65536.0f;
+    const float scale = dither_lsb_ * UNIT;
+    std::uint32_t x = rng_;
+    for (auto& s : samples) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        const auto a = static_cast<std::int32_t>(x & 0xFFFFu);
+        const auto b = static_cast<std::int32_t>(x >> 16);
+        s += static_cast<float>(a - b) * scale;
+    }
+    rng_ = x;
+}
+
+std::size_t FormatConverter::process(std::span<const std::byte> in,
+    std::span<std::byte> first, std::span<std::byte> second) noexcept
+{
+    const std::size_t out_frame_bytes = out_.frame_bytes();
+    const std::size_t room = (first.size() + second.size()) / out_frame_bytes;
+    std::size_t frames = std::min(in.size() / in_.frame_bytes(), max_frames_);
+    if (!resampler_) {
+        frames = std::min(frames, room);
+    }
+    if (frames == 0) {
+        return 0;
+    }
+
+    decode_samples(in.first(frames * in_.frame_bytes()), in_.encoding,
+        std::span<float> { in_f_ }.first(frames * in_.channels));
+
+    std::span<float> samples = std::span<float> { in_f_ }.first(frames * in_.channels);
+    std::size_t channels = in_.channels;
+    if (!matrix_.empty() && mix_before_resample_) {
+        mix(samples, frames, out_f_.data());
+        channels = out_.channels;
+        samples = std::span<float> { out_f_ }.first(frames * channels);
+    }
+    if (resampler_) {
+        frames = resampler_->process(samples, rs_f_);
+        samples = std::span<float> { rs_f_ }.first(frames * channels);
+    }
+    if (!matrix_.empty() && !mix_before_resample_) {
+        mix(samples, frames, out_f_.data());
+        samples = std::span<float> { out_f_ }.first(frames * out_.channels);
+    }
+    frames = std::min(frames, room);
+    if (frames == 0) {
+        return 0;
+    }
+    samples = samples.first(frames * out_.channels);
+    if (dither_lsb_ > 0.0f) {
+        dither(samples);
+    }
+
+    // 输出整段落在 first 内时直接编码过去，否则经暂存按字节拆分
+    const std::size_t bytes = frames * out_frame_bytes;
+    if (bytes <= first.size()) {
+        encode_samples(samples, out_.encoding, first.first(bytes));
+        return frames;
+    }
+    encode_samples(samples, out_.encoding, std::span<std::byte> { pcm_ }.first(bytes));
+    std::memcpy(first.data(), pcm_.data(), first.size());
+    std::memcpy(second.data(), pcm_.data() + first.size(), bytes - first.size());
+    return frames;
+}
+
+} // namespace aqua::audio::dsp
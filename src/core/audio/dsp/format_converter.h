@@ -0,0 +1,93 @@
+#ifndef AQUA_FORMAT_CONVERTER_H
+#define AQUA_FORMAT_CONVERTER_H
+
+#include "core/audio/dsp/polyphase_resampler.h"
+#include "core/public/audio_format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace aqua::audio::dsp {
+
+// 默认声道矩阵（out_channels 行 × in_channels 列，行主序）。声道顺序按
+// WAVEFORMATEXTENSIBLE / ALSA 默认映射：FL FR FC LFE BL BR SL SR（3/4/5/7 声道见实现）。
+//   相同声道数 → 单位阵
+//   多声道 → 立体声：ITU-R BS.775 折叠（中置 / 环绕 −3dB，LFE 丢弃），每行按系数绝对值和归一化，不削波
+//   任意 → 单声道：立体声折叠后 L/R 各 0.5
+//   单声道 / 立体声 → 多声道：送 FL/FR，其余声道静音
+//   其他多声道之间：共同前缀声道一一对应
+[[nodiscard]] std::vector<float> default_channel_matrix(std::uint32_t in_channels, std::uint32_t out_channels);
+
+struct FormatConverterOptions {
+    // TPDF 抖动（±1 LSB 三角分布）：仅在输出为 S16 / U8 且会丢失分辨率
+    // （输入精度更高，或声道矩阵非单位阵 / 采样率转换产生小数）时生效。
+    bool dither = true;
+    // 自定义声道矩阵（out × in，行主序）；为空时用 default_channel_matrix。
+    std::vector<float> matrix;
+};
+
+// 客户端格式转换级：JitterBuffer 出队（服务端格式）→ 播放设备协商出的格式。
+//
+// 任意 AudioEncoding 之间互转 + 声道矩阵混音 + 采样率转换，经 float 中间域：
+//   decode（SIMD）→ 声道矩阵 ⇄ PolyphaseResampler（SIMD）→ TPDF 抖动 → encode（SIMD）
+// 采样率不同时插入 PolyphaseResampler，在较少的一侧声道数上运行（降声道先混音，
+// 升声道后混音）。时钟漂移的 ±ppm 修正仍由上游 VariableResampler 负责。
+//
+// 构造时按 max_frames 预分配全部内存；热路径无分配、无锁。
+// Threading contract: 单线程使用（客户端 io_context 线程）。
+class FormatConverter {
+public:
+    // 格式非法、采样率比不受支持（PolyphaseResampler::supports）或矩阵尺寸不符时抛 std::invalid_argument。
+    FormatConverter(const AudioFormat& in, const AudioFormat& out, std::size_t max_frames,
+        FormatConverterOptions options = { });
+
+    FormatConverter(const FormatConverter&) = delete;
+    FormatConverter& operator=(const FormatConverter&) = delete;
+
+    [[nodiscard]] const AudioFormat& input_format() const noexcept { return in_; }
+    [[nodiscard]] const AudioFormat& output_format() const noexcept { return out_; }
+    [[nodiscard]] std::size_t max_frames() const noexcept { return max_frames_; }
+    [[nodiscard]] bool dithering() const noexcept { return dither_lsb_ > 0.0f; }
+    [[nodiscard]] bool resampling() const noexcept { return resampler_ != nullptr; }
+
+    // 单次 process 最多输出的帧数：同采样率时等于 max_frames。
+    [[nodiscard]] std::size_t max_output_frames() const noexcept { return max_output_frames_; }
+
+    // 采样率转换引入的固定延迟（输出帧），同采样率时为 0。
+    [[nodiscard]] double delay_frames() const noexcept { return resampler_ ? resampler_->delay_frames() : 0.0; }
+
+    // 转换 in 中的整帧（≤ max_frames，超出部分忽略），输出依次填充 first / second
+    // 两段（RingBuffer 回绕点不一定在帧边界）。返回输出帧数；输出区不足时截断
+    // （同采样率时按输出区限制消费的输入帧数；采样率转换时输入全部消费，多出的输出丢弃）。
+    std::size_t process(std::span<const std::byte> in,
+        std::span<std::byte> first, std::span<std::byte> second) noexcept;
+
+    // 清空采样率转换历史（时间线重置后调用）。
+    void reset() noexcept;
+
+private:
+    void mix(std::span<const float> src, std::size_t frames, float* dst) noexcept;
+    void dither(std::span<float> samples) noexcept;
+
+    AudioFormat in_;
+    AudioFormat out_;
+    std::size_t max_frames_;
+    std::size_t max_output_frames_;
+    std::vector<float> matrix_; // 空 = 单位阵（跳过混音）
+    bool mix_before_resample_ = true; // 输出声道 ≤ 输入声道时先混音
+    std::unique_ptr<PolyphaseResampler> resampler_; // 空 = 同采样率
+    float dither_lsb_ = 0.0f; // 0 = 不抖动
+    std::uint32_t rng_ = 0x9E3779B9u; // xorshift32 状态
+
+    std::vector<float> in_f_; // 解码后（输入声道）
+    std::vector<float> out_f_; // 混音后（输出声道）
+    std::vector<float> rs_f_; // 采样率转换后
+    std::vector<std::byte> pcm_; // 编码后（输出跨两段时的暂存）
+};
+
+} // namespace aqua::audio::dsp
+
+#endif // AQUA_FORMAT_CONVERTER_H
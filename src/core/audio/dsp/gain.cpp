@@ -0,0 +1,194 @@
+#include "core/audio/dsp/gain.h"
+#include "core/audio/dsp/gain_kernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace aqua::audio::dsp {
+
+// ---- 标量参考实现（SIMD 内核逐样本与之按位一致，也用于其尾部处理）----
+
+namespace detail {
+    void f32_scalar(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            float v;
+            std::memcpy(&v, data + i * 4, sizeof(v));
+            v *= ramp_gain(start, step, first + static_cast<std::uint32_t>(i));
+            std::memcpy(data + i * 4, &v, sizeof(v));
+        }
+    }
+
+    void s16_scalar(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            std::int16_t v;
+            std::memcpy(&v, data + i * 2, sizeof(v));
+            const float g = ramp_gain(start, step, first + static_cast<std::uint32_t>(i));
+            v = static_cast<std::int16_t>(std::clamp(static_cast<float>(v) * g, detail::S16_MIN, detail::S16_MAX));
+            std::memcpy(data + i * 2, &v, sizeof(v));
+        }
+    }
+
+    void s32_scalar(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            std::int32_t v;
+            std::memcpy(&v, data + i * 4, sizeof(v));
+            const float g = ramp_gain(start, step, first + static_cast<std::uint32_t>(i));
+            v = static_cast<std::int32_t>(std::clamp(static_cast<float>(v) * g, detail::S32_MIN, detail::S32_MAX));
+            std::memcpy(data + i * 4, &v, sizeof(v));
+        }
+    }
+
+    void mix_scalar(float* acc, const float* src, std::size_t samples, float gain) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            acc[i] += src[i] * gain;
+        }
+    }
+
+} // namespace detail
+
+namespace {
+    using detail::GainKernels;
+
+    constexpr GainKernels SCALAR_KERNELS { detail::f32_scalar, detail::s16_scalar, detail::s32_scalar,
+        detail::mix_scalar };
+
+    const GainKernels& kernels_for(SimdLevel level) noexcept
+    {
+        if (!simd_level_supported(level)) {
+            return SCALAR_KERNELS;
+        }
+        switch (level) {
+#if defined(__x86_64__) || defined(_M_X64)
+        case SimdLevel::Sse2:
+            return detail::SSE2_KERNELS;
+        case SimdLevel::Avx2:
+            return detail::AVX2_KERNELS;
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+        case SimdLevel::Neon:
+            return detail::NEON_KERNELS;
+#endif
+        default:
+            return SCALAR_KERNELS;
+        }
+    }
+
+    const GainKernels& active_kernels() noexcept
+    {
+        static const GainKernels& kernels = kernels_for(detect_simd_level());
+        return kernels;
+    }
+
+    // ---- 打包格式：分块解包为 float → 向量 f32 内核 → 钳位打包 ----
+    // S24LE / U8 没有对应的整数 SIMD 宽度，统一借道 float 块（栈上，无分配）。
+
+    constexpr std::size_t BLOCK_SAMPLES = 256;
+
+    void s24_blocks(const GainKernels& k, std::byte* data, std::size_t samples, float start, float step) noexcept
+    {
+        std::array<float, BLOCK_SAMPLES> block;
+        for (std::size_t base = 0; base < samples; base += BLOCK_SAMPLES) {
+            const std::size_t n = std::min(BLOCK_SAMPLES, samples - base);
+            std::byte* p = data + base * 3;
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto b0 = static_cast<std::uint32_t>(p[i * 3]);
+                const auto b1 = static_cast<std::uint32_t>(p[i * 3 + 1]);
+                const auto b2 = static_cast<std::uint32_t>(p[i * 3 + 2]);
+                // 左移到 int32 高位再算术右移完成符号扩展
+                const auto v = static_cast<std::int32_t>((b0 << 8) | (b1 << 16) | (b2 << 24)) >> 8;
+                block[i] = static_cast<float>(v);
+            }
+            k.f32(reinterpret_cast<std::byte*>(block.data()), n, start, step, static_cast<std::uint32_t>(base));
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto v = static_cast<std::int32_t>(std::clamp(block[i], -8388608.0f, 8388607.0f));
+                p[i * 3] = static_cast<std::byte>(v & 0xFF);
+                p[i * 3 + 1] = static_cast<std::byte>((v >> 8) & 0xFF);
+                p[i * 3 + 2] = static_cast<std::byte>((v >> 16) & 0xFF);
+            }
+        }
+    }
+
+    void u8_blocks(const GainKernels& k, std::byte* data, std::size_t samples, float start, float step) noexcept
+    {
+        std::array<float, BLOCK_SAMPLES> block;
+        for (std::size_t base = 0; base < samples; base += BLOCK_SAMPLES) {
+            const std::size_t n = std::min(BLOCK_SAMPLES, samples - base);
+            std::byte* p = data + base;
+            for (std::size_t i = 0; i < n; ++i) {
+                block[i] = static_cast<float>(static_cast<int>(p[i]) - 128);
+            }
+            k.f32(reinterpret_cast<std::byte*>(block.data()), n, start, step, static_cast<std::uint32_t>(base));
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto v = static_cast<int>(std::clamp(block[i], -128.0f, 127.0f));
+                p[i] = static_cast<std::byte>(v + 128);
+            }
+        }
+    }
+
+    void run(const GainKernels& k, std::span<std::byte> pcm, AudioEncoding encoding, float start, float end) noexcept
+    {
+        const std::size_t sample_bytes = AudioFormat { encoding, 1, 1 }.bytes_per_sample();
+        if (sample_bytes == 0) {
+            return;
+        }
+        const std::size_t samples = pcm.size() / sample_bytes;
+        if (samples == 0) {
+            return;
+        }
+        const float step = start == end ? 0.0f : (end - start) / static_cast<float>(samples);
+
+        switch (encoding) {
+        case AudioEncoding::PcmF32LE:
+            k.f32(pcm.data(), samples, start, step, 0);
+            break;
+        case AudioEncoding::PcmS16LE:
+            k.s16(pcm.data(), samples, start, step, 0);
+            break;
+        case AudioEncoding::PcmS32LE:
+            k.s32(pcm.data(), samples, start, step, 0);
+            break;
+        case AudioEncoding::PcmS24LE:
+            s24_blocks(k, pcm.data(), samples, start, step);
+            break;
+        case AudioEncoding::PcmU8:
+            u8_blocks(k, pcm.data(), samples, start, step);
+            break;
+        case AudioEncoding::Invalid:
+            break;
+        }
+    }
+} // namespace
+
+void apply_gain(std::span<std::byte> pcm, AudioEncoding encoding, float gain) noexcept
+{
+    run(active_kernels(), pcm, encoding, gain, gain);
+}
+
+void apply_gain_ramp(std::span<std::byte> pcm, AudioEncoding encoding, float start, float end) noexcept
+{
+    run(active_kernels(), pcm, encoding, start, end);
+}
+
+void apply_gain_ramp(std::span<std::byte> pcm, AudioEncoding encoding, float start, float end,
+    SimdLevel level) noexcept
+{
+    run(kernels_for(level), pcm, encoding, start, end);
+}
+
+void mix_accumulate(std::span<float> acc, std::span<const float> src, float gain) noexcept
+{
+    active_kernels().mix(acc.data(), src.data(), std::min(acc.size(), src.size()), gain);
+}
+
+void mix_accumulate(std::span<float> acc, std::span<const float> src, float gain, SimdLevel level) noexcept
+{
+    kernels_for(level).mix(acc.data(), src.data(), std::min(acc.size(), src.size()), gain);
+}
+
+} // namespace aqua::audio::dsp
@@ -0,0 +1,39 @@
+#ifndef AQUA_GAIN_H
+#define AQUA_GAIN_H
+
+#include "core/audio/dsp/cpu_features.h"
+#include "core/public/audio_format.h"
+
+#include <cstddef>
+#include <span>
+
+namespace aqua::audio::dsp {
+
+// 交织 PCM 原地增益 / 线性渐变（所有 AudioEncoding，含打包 24 位与无符号 8 位）。
+//
+// 语义（各档位逐样本一致，SIMD 与标量结果按位相同）：
+//   第 i 个样本（交织序，跨声道连续计数）的增益 g_i = start + step · i，
+//   step = (end - start) / 样本数；结果向零截断并饱和到编码范围
+//   （U8 以 128 为零点）。F32 不钳位。
+// pcm 无对齐要求，长度按整样本处理（尾部不足一个样本的字节不动）。
+// 热路径安全：无分配、无锁；内核在首次调用时按 detect_simd_level() 选定。
+
+void apply_gain(std::span<std::byte> pcm, AudioEncoding encoding, float gain) noexcept;
+
+// 线性渐变：首样本增益 start，逐样本线性趋近 end（end 本身落在下一块首样本上，
+// 因此相邻块首尾衔接无跳变）。
+void apply_gain_ramp(std::span<std::byte> pcm, AudioEncoding encoding, float start, float end) noexcept;
+
+// 指定档位（测试 / 基准用）。档位不可用时回退标量。
+void apply_gain_ramp(std::span<std::byte> pcm, AudioEncoding encoding, float start, float end,
+    SimdLevel level) noexcept;
+
+// 多路混音累加（float 域）：acc[i] += src[i] · gain，处理 min(acc, src) 个样本。
+// 先乘后加、不用 FMA，各档位与标量按位一致；不钳位（由调用方编码回整数时饱和）。
+void mix_accumulate(std::span<float> acc, std::span<const float> src, float gain) noexcept;
+
+void mix_accumulate(std::span<float> acc, std::span<const float> src, float gain, SimdLevel level) noexcept;
+
+} // namespace aqua::audio::dsp
+
+#endif // AQUA_GAIN_H
@@ -0,0 +1,54 @@
+#ifndef AQUA_GAIN_KERNELS_H
+#define AQUA_GAIN_KERNELS_H
+
+// gain.cpp 与各指令集内核之间的内部接口，不对外暴露。
+
+#include <cstddef>
+#include <cstdint>
+
+namespace aqua::audio::dsp::detail {
+
+// 对 data 起的 samples 个样本施加增益 g_i = start + step · float(first + i)。
+// data 无对齐要求。
+using GainKernelFn = void (*)(std::byte* data, std::size_t samples, float start, float step,
+    std::uint32_t first) noexcept;
+
+// 混音累加 acc[i] += src[i] · gain。acc / src 无对齐要求，不重叠。
+using MixKernelFn = void (*)(float* acc, const float* src, std::size_t samples, float gain) noexcept;
+
+struct GainKernels {
+    GainKernelFn f32;
+    GainKernelFn s16;
+    GainKernelFn s32;
+    MixKernelFn mix;
+};
+
+// g_i 的标量定义。SIMD 内核按相同运算顺序（int→float、乘、加）逐 lane 计算，不用 FMA。
+inline float ramp_gain(float start, float step, std::uint32_t index) noexcept
+{
+    return start + step * static_cast<float>(index);
+}
+
+// 标量内核（SIMD 内核的尾部也调用它们）
+void f32_scalar(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept;
+void s16_scalar(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept;
+void s32_scalar(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept;
+void mix_scalar(float* acc, const float* src, std::size_t samples, float gain) noexcept;
+
+// 饱和边界（float 表示）。2147483520 是小于 2^31 的最大 float。
+inline constexpr float S16_MIN = -32768.0f;
+inline constexpr float S16_MAX = 32767.0f;
+inline constexpr float S32_MIN = -2147483648.0f;
+inline constexpr float S32_MAX = 2147483520.0f;
+
+#if defined(__x86_64__) || defined(_M_X64)
+extern const GainKernels SSE2_KERNELS;
+extern const GainKernels AVX2_KERNELS;
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+extern const GainKernels NEON_KERNELS;
+#endif
+
+} // namespace aqua::audio::dsp::detail
+
+#endif // AQUA_GAIN_KERNELS_H
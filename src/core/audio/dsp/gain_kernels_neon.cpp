@@ -0,0 +1,86 @@
+// NEON 增益内核（AArch64 基线，Android arm64 / Apple Silicon）。
+
+#include "core/audio/dsp/gain_kernels.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+namespace aqua::audio::dsp::detail {
+
+namespace {
+
+    inline float32x4_t gains_neon(float start, float step, std::uint32_t index) noexcept
+    {
+        static const std::int32_t IOTA[4] = { 0, 1, 2, 3 };
+        const int32x4_t idx = vaddq_s32(vdupq_n_s32(static_cast<std::int32_t>(index)), vld1q_s32(IOTA));
+        // 不用 vmlaq/vfmaq：保持与标量相同的"先乘后加"两次舍入
+        return vaddq_f32(vdupq_n_f32(start), vmulq_f32(vdupq_n_f32(step), vcvtq_f32_s32(idx)));
+    }
+
+    inline float32x4_t clamp_neon(float32x4_t v, float lo, float hi) noexcept
+    {
+        return vminq_f32(vmaxq_f32(v, vdupq_n_f32(lo)), vdupq_n_f32(hi));
+    }
+
+    // 字节指针按字节装载再重解释，不对 payload 对齐做任何假设
+    void f32_neon(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            auto* p = reinterpret_cast<std::uint8_t*>(data + i * 4);
+            const float32x4_t x = vreinterpretq_f32_u8(vld1q_u8(p));
+            const auto g = gains_neon(start, step, first + static_cast<std::uint32_t>(i));
+            vst1q_u8(p, vreinterpretq_u8_f32(vmulq_f32(x, g)));
+        }
+        f32_scalar(data + i * 4, samples - i, start, step, first + static_cast<std::uint32_t>(i));
+    }
+
+    void s16_neon(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            auto* p = reinterpret_cast<std::uint8_t*>(data + i * 2);
+            const int16x8_t x = vreinterpretq_s16_u8(vld1q_u8(p));
+            const auto idx = first + static_cast<std::uint32_t>(i);
+            const float32x4_t flo = clamp_neon(
+                vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), gains_neon(start, step, idx)), S16_MIN, S16_MAX);
+            const float32x4_t fhi = clamp_neon(
+                vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), gains_neon(start, step, idx + 4)), S16_MIN, S16_MAX);
+            // vcvtq_s32_f32 向零截断，与标量 static_cast 一致
+            const int16x8_t r = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(flo)), vqmovn_s32(vcvtq_s32_f32(fhi)));
+            vst1q_u8(p, vreinterpretq_u8_s16(r));
+        }
+        s16_scalar(data + i * 2, samples - i, start, step, first + static_cast<std::uint32_t>(i));
+    }
+
+    void s32_neon(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            auto* p = reinterpret_cast<std::uint8_t*>(data + i * 4);
+            const int32x4_t x = vreinterpretq_s32_u8(vld1q_u8(p));
+            const auto g = gains_neon(start, step, first + static_cast<std::uint32_t>(i));
+            const float32x4_t f = clamp_neon(vmulq_f32(vcvtq_f32_s32(x), g), S32_MIN, S32_MAX);
+            vst1q_u8(p, vreinterpretq_u8_s32(vcvtq_s32_f32(f)));
+        }
+        s32_scalar(data + i * 4, samples - i, start, step, first + static_cast<std::uint32_t>(i));
+    }
+
+    void mix_neon(float* acc, const float* src, std::size_t samples, float gain) noexcept
+    {
+        const float32x4_t g = vdupq_n_f32(gain);
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            vst1q_f32(acc + i, vaddq_f32(vld1q_f32(acc + i), vmulq_f32(vld1q_f32(src + i), g)));
+        }
+        mix_scalar(acc + i, src + i, samples - i, gain);
+    }
+
+} // namespace
+
+const GainKernels NEON_KERNELS { f32_neon, s16_neon, s32_neon, mix_neon };
+
+} // namespace aqua::audio::dsp::detail
+
+#endif // AArch64
@@ -0,0 +1,160 @@
+// SSE2 / AVX2 增益内核。SSE2 为 x86-64 基线；AVX2 内核用函数级 target 属性编译，
+// 无需对整个 TU 开 -mavx2（运行时由 detect_simd_level() 保证只在支持的 CPU 上调用）。
+
+#include "core/audio/dsp/gain_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define AQUA_TARGET_AVX2
+#else
+#define AQUA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace aqua::audio::dsp::detail {
+
+namespace {
+
+    // ---- SSE2：4 lane ----
+
+    inline __m128 gains_sse2(float start, float step, std::uint32_t index) noexcept
+    {
+        const __m128i idx = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(index)), _mm_setr_epi32(0, 1, 2, 3));
+        return _mm_add_ps(_mm_set1_ps(start), _mm_mul_ps(_mm_set1_ps(step), _mm_cvtepi32_ps(idx)));
+    }
+
+    inline __m128 clamp_sse2(__m128 v, float lo, float hi) noexcept
+    {
+        return _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(lo)), _mm_set1_ps(hi));
+    }
+
+    void f32_sse2(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            auto* p = reinterpret_cast<float*>(data + i * 4);
+            const auto g = gains_sse2(start, step, first + static_cast<std::uint32_t>(i));
+            _mm_storeu_ps(p, _mm_mul_ps(_mm_loadu_ps(p), g));
+        }
+        f32_scalar(data + i * 4, samples - i, start, step, first + static_cast<std::uint32_t>(i));
+    }
+
+    void s16_sse2(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            auto* p = reinterpret_cast<__m128i*>(data + i * 2);
+            const __m128i x = _mm_loadu_si128(p);
+            // 符号扩展 int16 → int32：复制到高半字再算术右移
+            const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+            const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+            const auto idx = first + static_cast<std::uint32_t>(i);
+            const __m128 flo = clamp_sse2(_mm_mul_ps(_mm_cvtepi32_ps(lo), gains_sse2(start, step, idx)), S16_MIN, S16_MAX);
+            const __m128 fhi = clamp_sse2(_mm_mul_ps(_mm_cvtepi32_ps(hi), gains_sse2(start, step, idx + 4)), S16_MIN, S16_MAX);
+            _mm_storeu_si128(p, _mm_packs_epi32(_mm_cvttps_epi32(flo), _mm_cvttps_epi32(fhi)));
+        }
+        s16_scalar(data + i * 2, samples - i, start, step, first + static_cast<std::uint32_t>(i));
+    }
+
+    void s32_sse2(std::byte* data, std::size_t samples, float start, float step, std::uint32_t first) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            auto* p = reinterpret_cast<__m128i*>(data + i * 4);
+            const auto g = gains_sse2(start, step, first + static_cast<std::uint32_t>(i));
+            const __m128 f = clamp_sse2(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(p)), g), S32_MIN, S32_MAX);
+            _mm_storeu_si128(p, _mm_cvttps_epi32(f));
+        }
+        s32_scalar(data + i * 4, samples - i, start, step, first + static_cast<std::uint32_t>(i));
+    }
+
+    void mix_sse2(float* acc, const float* src, std::size_t samples, float gain) noexcept
+    {
+        const __m128 g = _mm_set1_ps(gain);
+        std::size_t i = 0;
+        for (; i + 4 <= samples; i += 4) {
+            _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+        }
+        mix_scalar(acc + i, src + i, samples - i, gain);
+    }
+
+    // ---- AVX2：8 lane ----
+
+    AQUA_TARGET_AVX2 inline __m256 gains_avx2(float start, float step, std::uint32_t index) noexcept
+    {
+        const __m256i idx = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(index)),
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        return _mm256_add_ps(_mm256_set1_ps(start), _mm256_mul_ps(_mm256_set1_ps(step), _mm256_cvtepi32_ps(idx)));
+    }
+
+    AQUA_TARGET_AVX2 inline __m256 clamp_avx2(__m256 v, float lo, float hi) noexcept
+    {
+        return _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(lo)), _mm256_set1_ps(hi));
+    }
+
+    AQUA_TARGET_AVX2 void f32_avx2(std::byte* data, std::size_t samples, float start, float step,
+        std::uint32_t first) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            auto* p = reinterpret_cast<float*>(data + i * 4);
+            const auto g = gains_avx2(start, step, first + static_cast<std::uint32_t>(i));
+            _mm256_storeu_ps(p, _mm256_mul_ps(_mm256_loadu_ps(p), g));
+        }
+        f32_scalar(data + i * 4, samples - i, start, step, first + static_cast<std::uint32_t>(i));
+    }
+
+    AQUA_TARGET_AVX2 void s16_avx2(std::byte* data, std::size_t samples, float start, float step,
+        std::uint32_t first) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 16 <= samples; i += 16) {
+            auto* p = reinterpret_cast<__m256i*>(data + i * 2);
+            const __m256i x = _mm256_loadu_si256(p);
+            const __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(x));
+            const __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1));
+            const auto idx = first + static_cast<std::uint32_t>(i);
+            const __m256 flo = clamp_avx2(_mm256_mul_ps(_mm256_cvtepi32_ps(lo), gains_avx2(start, step, idx)), S16_MIN, S16_MAX);
+            const __m256 fhi = clamp_avx2(_mm256_mul_ps(_mm256_cvtepi32_ps(hi), gains_avx2(start, step, idx + 8)), S16_MIN, S16_MAX);
+            // packs 按 128 位 lane 交错（lo0 hi0 lo1 hi1），permute 还原为顺序排列
+            const __m256i packed = _mm256_packs_epi32(_mm256_cvttps_epi32(flo), _mm256_cvttps_epi32(fhi));
+            _mm256_storeu_si256(p, _mm256_permute4x64_epi64(packed, 0xD8));
+        }
+        s16_scalar(data + i * 2, samples - i, start, step, first + static_cast<std::uint32_t>(i));
+    }
+
+    AQUA_TARGET_AVX2 void s32_avx2(std::byte* data, std::size_t samples, float start, float step,
+        std::uint32_t first) noexcept
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            auto* p = reinterpret_cast<__m256i*>(data + i * 4);
+            const auto g = gains_avx2(start, step, first + static_cast<std::uint32_t>(i));
+            const __m256 f = clamp_avx2(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(p)), g), S32_MIN, S32_MAX);
+            _mm256_storeu_si256(p, _mm256_cvttps_epi32(f));
+        }
+        s32_scalar(data + i * 4, samples - i, start, step, first + static_cast<std::uint32_t>(i));
+    }
+
+    // 不用 _mm256_fmadd_ps：FMA 单次舍入会与标量结果差 1 ulp
+    AQUA_TARGET_AVX2 void mix_avx2(float* acc, const float* src, std::size_t samples, float gain) noexcept
+    {
+        const __m256 g = _mm256_set1_ps(gain);
+        std::size_t i = 0;
+        for (; i + 8 <= samples; i += 8) {
+            _mm256_storeu_ps(acc + i,
+                _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+        }
+        mix_scalar(acc + i, src + i, samples - i, gain);
+    }
+
+} // namespace
+
+const GainKernels SSE2_KERNELS { f32_sse2, s16_sse2, s32_sse2, mix_sse2 };
+const GainKernels AVX2_KERNELS { f32_avx2, s16_avx2, s32_avx2, mix_avx2 };
+
+} // namespace aqua::audio::dsp::detail
+
+#endif // x86-64
@@ -0,0 +1,37 @@
+#ifndef AQUA_POLYPHASE_KERNELS_H
+#define AQUA_POLYPHASE_KERNELS_H
+
+// polyphase_resampler.cpp 与各指令集 FIR 内核之间的内部接口，不对外暴露。
+
+#include <cstddef>
+
+namespace aqua::audio::dsp::detail {
+
+// 一个输出帧的全部声道：out[ch] = Σ_j coeff[j] · x[ch · stride + j]，ch ∈ [0, channels)。
+// n 为 DOT_LANES 的整数倍。无对齐要求。
+using FirKernelFn = void (*)(const float* coeff, const float* x, std::size_t stride, std::size_t channels,
+    std::size_t n, float* out) noexcept;
+
+// 累加顺序的标量定义：16 路部分和 acc[j % 16]，再按 (k, k+8) → (k, k+4) → (k, k+2) → (0, 1) 归约。
+// SIMD 内核按相同顺序逐 lane 计算（AVX2 两个 8 lane、SSE2 / NEON 四个 4 lane 累加器），不用 FMA。
+// 多路独立累加链与声道两两并行用于隐藏加法延迟（每相位仅 32~64 抽头）。
+inline constexpr std::size_t DOT_LANES = 16;
+
+struct PolyphaseKernels {
+    FirKernelFn fir;
+};
+
+void fir_scalar(const float* coeff, const float* x, std::size_t stride, std::size_t channels, std::size_t n,
+    float* out) noexcept;
+
+#if defined(__x86_64__) || defined(_M_X64)
+extern const PolyphaseKernels SSE2_POLYPHASE_KERNELS;
+extern const PolyphaseKernels AVX2_POLYPHASE_KERNELS;
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+extern const PolyphaseKernels NEON_POLYPHASE_KERNELS;
+#endif
+
+} // namespace aqua::audio::dsp::detail
+
+#endif // AQUA_POLYPHASE_KERNELS_H
@@ -0,0 +1,69 @@
+// NEON FIR 内核（AArch64 基线）。
+
+#include "core/audio/dsp/polyphase_kernels.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+namespace aqua::audio::dsp::detail {
+
+namespace {
+
+    // 4 个 4 lane 累加器 a0..a3 对应标量 acc[0..3] / [4..7] / [8..11] / [12..15]。
+    // 乘加分开写，避免编译为融合乘加（与标量定义的舍入一致）。
+    struct Acc16Neon {
+        float32x4_t a0 = vdupq_n_f32(0.0f);
+        float32x4_t a1 = vdupq_n_f32(0.0f);
+        float32x4_t a2 = vdupq_n_f32(0.0f);
+        float32x4_t a3 = vdupq_n_f32(0.0f);
+
+        void step(const float* c, const float* x) noexcept
+        {
+            a0 = vaddq_f32(a0, vmulq_f32(vld1q_f32(c), vld1q_f32(x)));
+            a1 = vaddq_f32(a1, vmulq_f32(vld1q_f32(c + 4), vld1q_f32(x + 4)));
+            a2 = vaddq_f32(a2, vmulq_f32(vld1q_f32(c + 8), vld1q_f32(x + 8)));
+            a3 = vaddq_f32(a3, vmulq_f32(vld1q_f32(c + 12), vld1q_f32(x + 12)));
+        }
+
+        [[nodiscard]] float sum() const noexcept
+        {
+            const float32x4_t s = vaddq_f32(vaddq_f32(a0, a2), vaddq_f32(a1, a3));
+            const float32x2_t pair = vadd_f32(vget_low_f32(s), vget_high_f32(s));
+            return vget_lane_f32(pair, 0) + vget_lane_f32(pair, 1);
+        }
+    };
+
+    void fir_neon(const float* coeff, const float* x, std::size_t stride, std::size_t channels, std::size_t n,
+        float* out) noexcept
+    {
+        std::size_t ch = 0;
+        for (; ch + 2 <= channels; ch += 2) {
+            const float* x0 = x + ch * stride;
+            const float* x1 = x0 + stride;
+            Acc16Neon p;
+            Acc16Neon q;
+            for (std::size_t j = 0; j < n; j += DOT_LANES) {
+                p.step(coeff + j, x0 + j);
+                q.step(coeff + j, x1 + j);
+            }
+            out[ch] = p.sum();
+            out[ch + 1] = q.sum();
+        }
+        if (ch < channels) {
+            const float* x0 = x + ch * stride;
+            Acc16Neon p;
+            for (std::size_t j = 0; j < n; j += DOT_LANES) {
+                p.step(coeff + j, x0 + j);
+            }
+            out[ch] = p.sum();
+        }
+    }
+
+} // namespace
+
+const PolyphaseKernels NEON_POLYPHASE_KERNELS { fir_neon };
+
+} // namespace aqua::audio::dsp::detail
+
+#endif // AArch64
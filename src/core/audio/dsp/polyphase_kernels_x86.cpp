@@ -0,0 +1,124 @@
+// SSE2 / AVX2 FIR 内核。AVX2 用函数级 target 属性编译，
+// 运行时由 detect_simd_level() 保证只在支持的 CPU 上调用。
+
+#include "core/audio/dsp/polyphase_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define AQUA_TARGET_AVX2
+#else
+#define AQUA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace aqua::audio::dsp::detail {
+
+namespace {
+
+    // ---- SSE2：4 个 4 lane 累加器 a0..a3 对应标量 acc[0..3] / [4..7] / [8..11] / [12..15] ----
+
+    // (s0 s1 s2 s3) → (s0 + s2) + (s1 + s3)
+    inline float reduce4_sse2(__m128 s) noexcept
+    {
+        const __m128 pair = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+    }
+
+    struct Acc16Sse2 {
+        __m128 a0 = _mm_setzero_ps();
+        __m128 a1 = _mm_setzero_ps();
+        __m128 a2 = _mm_setzero_ps();
+        __m128 a3 = _mm_setzero_ps();
+
+        void step(const float* c, const float* x) noexcept
+        {
+            a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(c), _mm_loadu_ps(x)));
+            a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(c + 4), _mm_loadu_ps(x + 4)));
+            a2 = _mm_add_ps(a2, _mm_mul_ps(_mm_loadu_ps(c + 8), _mm_loadu_ps(x + 8)));
+            a3 = _mm_add_ps(a3, _mm_mul_ps(_mm_loadu_ps(c + 12), _mm_loadu_ps(x + 12)));
+        }
+
+        [[nodiscard]] float sum() const noexcept
+        {
+            return reduce4_sse2(_mm_add_ps(_mm_add_ps(a0, a2), _mm_add_ps(a1, a3)));
+        }
+    };
+
+    void fir_sse2(const float* coeff, const float* x, std::size_t stride, std::size_t channels, std::size_t n,
+        float* out) noexcept
+    {
+        std::size_t ch = 0;
+        for (; ch + 2 <= channels; ch += 2) {
+            const float* x0 = x + ch * stride;
+            const float* x1 = x0 + stride;
+            Acc16Sse2 p;
+            Acc16Sse2 q;
+            for (std::size_t j = 0; j < n; j += DOT_LANES) {
+                p.step(coeff + j, x0 + j);
+                q.step(coeff + j, x1 + j);
+            }
+            out[ch] = p.sum();
+            out[ch + 1] = q.sum();
+        }
+        if (ch < channels) {
+            const float* x0 = x + ch * stride;
+            Acc16Sse2 p;
+            for (std::size_t j = 0; j < n; j += DOT_LANES) {
+                p.step(coeff + j, x0 + j);
+            }
+            out[ch] = p.sum();
+        }
+    }
+
+    // ---- AVX2：2 个 8 lane 累加器 lo / hi 对应标量 acc[0..7] / acc[8..15] ----
+
+    AQUA_TARGET_AVX2 inline float reduce16_avx2(__m256 lo, __m256 hi) noexcept
+    {
+        const __m256 s = _mm256_add_ps(lo, hi);
+        return reduce4_sse2(_mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1)));
+    }
+
+    AQUA_TARGET_AVX2 void fir_avx2(const float* coeff, const float* x, std::size_t stride, std::size_t channels,
+        std::size_t n, float* out) noexcept
+    {
+        std::size_t ch = 0;
+        for (; ch + 2 <= channels; ch += 2) {
+            const float* x0 = x + ch * stride;
+            const float* x1 = x0 + stride;
+            __m256 p_lo = _mm256_setzero_ps();
+            __m256 p_hi = _mm256_setzero_ps();
+            __m256 q_lo = _mm256_setzero_ps();
+            __m256 q_hi = _mm256_setzero_ps();
+            for (std::size_t j = 0; j < n; j += DOT_LANES) {
+                const __m256 c_lo = _mm256_loadu_ps(coeff + j);
+                const __m256 c_hi = _mm256_loadu_ps(coeff + j + 8);
+                p_lo = _mm256_add_ps(p_lo, _mm256_mul_ps(c_lo, _mm256_loadu_ps(x0 + j)));
+                p_hi = _mm256_add_ps(p_hi, _mm256_mul_ps(c_hi, _mm256_loadu_ps(x0 + j + 8)));
+                q_lo = _mm256_add_ps(q_lo, _mm256_mul_ps(c_lo, _mm256_loadu_ps(x1 + j)));
+                q_hi = _mm256_add_ps(q_hi, _mm256_mul_ps(c_hi, _mm256_loadu_ps(x1 + j + 8)));
+            }
+            out[ch] = reduce16_avx2(p_lo, p_hi);
+            out[ch + 1] = reduce16_avx2(q_lo, q_hi);
+        }
+        if (ch < channels) {
+            const float* x0 = x + ch * stride;
+            __m256 p_lo = _mm256_setzero_ps();
+            __m256 p_hi = _mm256_setzero_ps();
+            for (std::size_t j = 0; j < n; j += DOT_LANES) {
+                p_lo = _mm256_add_ps(p_lo, _mm256_mul_ps(_mm256_loadu_ps(coeff + j), _mm256_loadu_ps(x0 + j)));
+                p_hi = _mm256_add_ps(p_hi, _mm256_mul_ps(_mm256_loadu_ps(coeff + j + 8), _mm256_loadu_ps(x0 + j + 8)));
+            }
+            out[ch] = reduce16_avx2(p_lo, p_hi);
+        }
+    }
+
+} // namespace
+
+const PolyphaseKernels SSE2_POLYPHASE_KERNELS { fir_sse2 };
+const PolyphaseKernels AVX2_POLYPHASE_KERNELS { fir_avx2 };
+
+} // namespace aqua::audio::dsp::detail
+
+#endif // x86-64
@@ -0,0 +1,223 @@
+#include "core/audio/dsp/polyphase_resampler.h"
+#include "core/audio/dsp/polyphase_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <numbers>
+#include <stdexcept>
+
+namespace aqua::audio::dsp {
+
+namespace {
+    // 截止频率（相对较低一侧的 Nyquist）与 Kaiser β：β = 8 阻带约 -80dB，
+    // 32 抽头下 44.1kHz → 48kHz 通带 ~18kHz 内平坦。
+    constexpr double CUTOFF = 0.9;
+    constexpr double KAISER_BETA = 8.0;
+
+    // 第一类零阶修正 Bessel 函数（级数展开）。
+    double bessel_i0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 32; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < sum * 1e-12) {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    using detail::PolyphaseKernels;
+
+    constexpr PolyphaseKernels SCALAR_KERNELS { detail::fir_scalar };
+
+    const PolyphaseKernels& kernels_for(SimdLevel level) noexcept
+    {
+        if (!simd_level_supported(level)) {
+            return SCALAR_KERNELS;
+        }
+        switch (level) {
+#if defined(__x86_64__) || defined(_M_X64)
+        case SimdLevel::Sse2:
+            return detail::SSE2_POLYPHASE_KERNELS;
+        case SimdLevel::Avx2:
+            return detail::AVX2_POLYPHASE_KERNELS;
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+        case SimdLevel::Neon:
+            return detail::NEON_POLYPHASE_KERNELS;
+#endif
+        default:
+            return SCALAR_KERNELS;
+        }
+    }
+} // namespace
+
+namespace detail {
+    void fir_scalar(const float* coeff, const float* x, std::size_t stride, std::size_t channels, std::size_t n,
+        float* out) noexcept
+    {
+        for (std::size_t ch = 0; ch < channels; ++ch) {
+            const float* xc = x + ch * stride;
+            float acc[DOT_LANES] = { };
+            for (std::size_t j = 0; j < n; j += DOT_LANES) {
+                for (std::size_t k = 0; k < DOT_LANES; ++k) {
+                    const float prod = coeff[j + k] * xc[j + k];
+                    acc[k] = acc[k] + prod;
+                }
+            }
+            for (std::size_t width = DOT_LANES / 2; width >= 4; width /= 2) {
+                for (std::size_t k = 0; k < width; ++k) {
+                    acc[k] = acc[k] + acc[k + width];
+                }
+            }
+            out[ch] = (acc[0] + acc[2]) + (acc[1] + acc[3]);
+        }
+    }
+} // namespace detail
+
+bool PolyphaseResampler::supports(std::uint32_t in_rate, std::uint32_t out_rate) noexcept
+{
+    if (in_rate == 0 || out_rate == 0) {
+        return false;
+    }
+    return out_rate / std::gcd(in_rate, out_rate) <= MAX_PHASES;
+}
+
+PolyphaseResampler::PolyphaseResampler(std::uint32_t channels, std::uint32_t in_rate, std::uint32_t out_rate,
+    std::size_t max_input_frames, SimdLevel level)
+    : channels_(channels)
+    , max_input_frames_(max_input_frames)
+    , fir_(kernels_for(level).fir)
+{
+    if (!supports(in_rate, out_rate)) {
+        throw std::invalid_argument("PolyphaseResampler: unsupported sample rate ratio");
+    }
+    if (channels == 0 || max_input_frames == 0) {
+        throw std::invalid_argument("PolyphaseResampler requires channels > 0 and max_input_frames > 0");
+    }
+    const auto g = std::gcd(in_rate, out_rate);
+    up_ = out_rate / g;
+    down_ = in_rate / g;
+
+    // 降采样时截止频率随输出 Nyquist 收窄，抽头数按比例加长以保持过渡带陡度。
+    const double bandwidth = std::min(1.0, static_cast<double>(up_) / down_);
+    const auto wanted = static_cast<std::size_t>(std::ceil(static_cast<double>(BASE_TAPS) / bandwidth));
+    taps_ = std::min(MAX_TAPS, (wanted + detail::DOT_LANES - 1) / detail::DOT_LANES * detail::DOT_LANES);
+    const std::size_t half = taps_ / 2;
+
+    // 系数表：相位 p 对应输入时刻小数部分 frac = p / L，抽头 j 与输出点的距离
+    // x = j - (half - 1) - frac ∈ (-half, half]。
+    table_.resize(static_cast<std::size_t>(up_) * taps_);
+    const double cutoff = CUTOFF * bandwidth;
+    const double i0_beta = bessel_i0(KAISER_BETA);
+    std::vector<double> h(taps_);
+    for (std::uint32_t p = 0; p < up_; ++p) {
+        const double frac = static_cast<double>(p) / up_;
+        double sum = 0.0;
+        for (std::size_t j = 0; j < taps_; ++j) {
+            const double x = static_cast<double>(j) - static_cast<double>(half - 1) - frac;
+            const double arg = std::numbers::pi * cutoff * x;
+            const double sinc = std::abs(x) < 1e-12 ? 1.0 : std::sin(arg) / arg;
+            const double r = x / static_cast<double>(half);
+            const double window = std::abs(r) >= 1.0 ? 0.0 : bessel_i0(KAISER_BETA * std::sqrt(1.0 - r * r)) / i0_beta;
+            h[j] = sinc * window;
+            sum += h[j];
+        }
+        for (std::size_t j = 0; j < taps_; ++j) {
+            table_[p * taps_ + j] = static_cast<float>(h[j] / sum);
+        }
+    }
+
+    // 输出上界：输入帧数 × L / M，另加相位余数与历史边界带来的 2 帧余量。
+    max_output_frames_ = (max_input_frames * up_ + down_ - 1) / down_ + 2;
+    // 历史：process 结束时保留 < taps 帧，再追加一块输入。
+    plane_stride_ = taps_ + max_input_frames;
+    history_.resize(plane_stride_ * channels_);
+    reset();
+}
+
+double PolyphaseResampler::delay_frames() const noexcept
+{
+    return static_cast<double>(taps_ / 2) * up_ / down_;
+}
+
+void PolyphaseResampler::reset() noexcept
+{
+    // 首个输出点落在首个输入帧（历史位置 half - 1）上，左侧 half - 1 帧静音邻域。
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    have_ = taps_ / 2 - 1;
+    base_ = have_;
+    phase_ = 0;
+}
+
+std::size_t PolyphaseResampler::process(std::span<const float> in, std::span<float> out) noexcept
+{
+    const std::size_t in_frames = std::min(in.size() / channels_, max_input_frames_);
+    for (std::size_t ch = 0; ch < channels_; ++ch) {
+        float* plane = history_.data() + ch * plane_stride_ + have_;
+        for (std::size_t f = 0; f < in_frames; ++f) {
+            plane[f] = in[f * channels_ + ch];
+        }
+    }
+    have_ += in_frames;
+
+    const std::size_t half = taps_ / 2;
+    const std::size_t room = std::min(max_output_frames_, out.size() / channels_);
+    std::size_t produced = 0;
+
+    // 输出点 (base, phase) 需要帧 [base - half + 1, base + half] 全部就绪。
+    const auto emit = [&](std::uint32_t phase) noexcept {
+        if (produced < room) {
+            fir_(table_.data() + static_cast<std::size_t>(phase) * taps_, history_.data() + base_ + 1 - half,
+                plane_stride_, channels_, taps_, out.data() + produced * channels_);
+            ++produced;
+        }
+    };
+
+    if (up_ == 1) {
+        // 整数倍降采样：只有相位 0
+        for (; base_ + half < have_; base_ += down_) {
+            emit(0);
+        }
+    } else if (down_ == 1) {
+        // 整数倍升采样：同一窗口依次出全部 L 个相位
+        for (; base_ + half < have_; ++base_) {
+            for (std::uint32_t p = 0; p < up_; ++p) {
+                emit(p);
+            }
+        }
+    } else {
+        const std::size_t step = down_ / up_;
+        const std::uint32_t step_frac = down_ % up_;
+        while (base_ + half < have_) {
+            emit(phase_);
+            base_ += step;
+            phase_ += step_frac;
+            if (phase_ >= up_) {
+                phase_ -= up_;
+                ++base_;
+            }
+        }
+    }
+
+    // 丢弃下一个输出点不再需要的历史，读位置随之平移。降采样时 base_ 可能越过 have_，
+    // 此时全部丢弃，base_ 保持相对于后续输入的偏移。
+    const std::size_t keep_from = base_ + 1 - half;
+    const std::size_t drop = std::min(keep_from, have_);
+    if (drop > 0) {
+        for (std::size_t ch = 0; ch < channels_; ++ch) {
+            float* plane = history_.data() + ch * plane_stride_;
+            std::memmove(plane, plane + drop, (have_ - drop) * sizeof(float));
+        }
+        have_ -= drop;
+        base_ -= drop;
+    }
+    return produced;
+}
+
+} // namespace aqua::audio::dsp
@@ -0,0 +1,82 @@
+#ifndef AQUA_POLYPHASE_RESAMPLER_H
+#define AQUA_POLYPHASE_RESAMPLER_H
+
+#include "core/audio/dsp/cpu_features.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace aqua::audio::dsp {
+
+// 固定有理倍率流式采样率转换（设备采样率 ≠ 服务端采样率，如 44.1kHz ↔ 48kHz）。
+//
+// - out_rate / in_rate 约分为 L / M：输出点 n 对应输入时刻 n·M / L，相位 (n·M) mod L
+//   精确落在 L 个预计算相位之一，无相位插值。
+// - 原型滤波器：Kaiser 窗 sinc，截止频率 CUTOFF × min(1, L / M)（降采样时同时抗混叠），
+//   每相位 taps() 个系数、归一化为单位直流增益，按相位连续存放（一个输出点读一段连续内存）。
+//   抽头数按 BASE_TAPS / min(1, L / M) 取 16 的倍数，降采样比越大越长。
+// - 历史按声道平面存放，每个输出点一次 SIMD FIR 内核调用覆盖全部声道（按 SimdLevel 分派）。
+// - 整数倍率快路径：M = 1（整数倍升采样）同一窗口连续出 L 个相位；L = 1（整数倍降采样）
+//   只有一个相位，每个输出点前进 M 帧。
+// - 延迟固定：输出点需要其右侧 taps() / 2 帧输入，delay_frames() 报告这段前瞻折算的
+//   输出帧数；输出点与输入时间线本身对齐（无额外相移）。
+//
+// 构造时按 max_input_frames 预分配全部内存；热路径无分配、无锁。
+// Threading contract: 单线程使用（客户端 io_context 线程）。
+class PolyphaseResampler {
+public:
+    static constexpr std::size_t BASE_TAPS = 32;
+    static constexpr std::size_t MAX_TAPS = 128;
+    // 约分后的相位数上限（系数表 L × taps）。常见采样率两两之间 L ≤ 640。
+    static constexpr std::uint32_t MAX_PHASES = 1024;
+
+    // 构造时选定内核；level 不受支持时退回标量。
+    // in_rate / out_rate 不受支持（见 supports）、channels 或 max_input_frames 为 0 时抛 std::invalid_argument。
+    PolyphaseResampler(std::uint32_t channels, std::uint32_t in_rate, std::uint32_t out_rate,
+        std::size_t max_input_frames, SimdLevel level = detect_simd_level());
+
+    PolyphaseResampler(const PolyphaseResampler&) = delete;
+    PolyphaseResampler& operator=(const PolyphaseResampler&) = delete;
+
+    // 两个采样率之间能否转换（均非 0 且约分后 L ≤ MAX_PHASES）。
+    [[nodiscard]] static bool supports(std::uint32_t in_rate, std::uint32_t out_rate) noexcept;
+
+    [[nodiscard]] std::uint32_t interpolation() const noexcept { return up_; }
+    [[nodiscard]] std::uint32_t decimation() const noexcept { return down_; }
+    [[nodiscard]] std::size_t taps() const noexcept { return taps_; }
+
+    // 单次 process 最多输出的帧数（调用方据此预留输出区）。
+    [[nodiscard]] std::size_t max_output_frames() const noexcept { return max_output_frames_; }
+
+    // 固定延迟（输出帧）：taps() / 2 帧输入前瞻折算到输出采样率。
+    [[nodiscard]] double delay_frames() const noexcept;
+
+    // 输入交织 float（≤ max_input_frames 帧，超出部分忽略），输出交织 float 到 out。
+    // 返回输出帧数；out 不足时截断（丢弃的帧不再补出）。
+    std::size_t process(std::span<const float> in, std::span<float> out) noexcept;
+
+    // 清空历史（时间线重置后调用）：下一块从静音邻域开始。
+    void reset() noexcept;
+
+private:
+    std::size_t channels_;
+    std::uint32_t up_; // L
+    std::uint32_t down_; // M
+    std::size_t taps_;
+    std::size_t max_input_frames_;
+    std::size_t max_output_frames_;
+    std::size_t plane_stride_;
+    void (*fir_)(const float*, const float*, std::size_t, std::size_t, std::size_t, float*) noexcept;
+
+    std::vector<float> table_; // L × taps，相位 p 的第 j 个系数作用于帧 base - taps/2 + 1 + j
+    std::vector<float> history_; // 声道平面，每平面 plane_stride_ 帧，有效帧 [0, have_)
+    std::size_t have_ = 0;
+    std::size_t base_ = 0; // 下一个输出点的整数输入位置
+    std::uint32_t phase_ = 0; // 下一个输出点的相位 ∈ [0, L)
+};
+
+} // namespace aqua::audio::dsp
+
+#endif // AQUA_POLYPHASE_RESAMPLER_H
@@ -0,0 +1,144 @@
+#include "core/audio/dsp/resampler.h"
+#include "core/audio/dsp/sample_convert.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+namespace aqua::audio::dsp {
+
+namespace {
+    // 截止频率（相对 Nyquist）与 Kaiser β：16 抽头下通带 ~0.8 Nyquist 内平坦（20kHz @48kHz）。
+    constexpr double CUTOFF = 0.9;
+    constexpr double KAISER_BETA = 8.0;
+
+    // 第一类零阶修正 Bessel 函数（级数展开）。
+    double bessel_i0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 32; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < sum * 1e-12) {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    constexpr std::size_t HALF = VariableResampler::TAPS / 2;
+} // namespace
+
+VariableResampler::VariableResampler(const AudioFormat& format, std::size_t max_input_frames)
+    : format_(format)
+    , channels_(format.channels)
+    , frame_bytes_(format.frame_bytes())
+    , max_input_frames_(max_input_frames)
+{
+    // 系数表：相位 p 对应读位置小数部分 frac = p / PHASES，抽头 j 与输出点的距离
+    // x = j - (HALF - 1) - frac ∈ (-HALF, HALF]。多一行 p = PHASES 供相位间插值。
+    table_.resize((PHASES + 1) * TAPS);
+    const double i0_beta = bessel_i0(KAISER_BETA);
+    for (std::size_t p = 0; p <= PHASES; ++p) {
+        const double frac = static_cast<double>(p) / PHASES;
+        double sum = 0.0;
+        std::array<double, TAPS> h { };
+        for (std::size_t j = 0; j < TAPS; ++j) {
+            const double x = static_cast<double>(j) - static_cast<double>(HALF - 1) - frac;
+            const double arg = std::numbers::pi * CUTOFF * x;
+            const double sinc = std::abs(x) < 1e-12 ? 1.0 : std::sin(arg) / arg;
+            const double r = x / static_cast<double>(HALF);
+            const double window = std::abs(r) >= 1.0 ? 0.0 : bessel_i0(KAISER_BETA * std::sqrt(1.0 - r * r)) / i0_beta;
+            h[j] = sinc * window;
+            sum += h[j];
+        }
+        for (std::size_t j = 0; j < TAPS; ++j) {
+            table_[p * TAPS + j] = static_cast<float>(h[j] / sum);
+        }
+    }
+
+    // 输出上界：输入帧数 × 最大比率，另加读位置小数部分与历史边界带来的 2 帧余量。
+    max_output_frames_ = static_cast<std::size_t>(
+                             std::ceil(static_cast<double>(max_input_frames) * (1.0 + MAX_RATIO_DEVIATION)))
+        + 2;
+    // 历史：process 结束时保留 < TAPS 帧，再追加一块输入。
+    history_.resize((TAPS + max_input_frames) * channels_);
+    out_.resize(max_output_frames_ * channels_);
+    pcm_.resize(max_output_frames_ * frame_bytes_);
+    reset();
+}
+
+void VariableResampler::reset() noexcept
+{
+    // 首个输出点 pos = HALF - 1 落在首个输入帧上，左侧 HALF - 1 帧静音邻域。
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    have_ = HALF - 1;
+    pos_ = static_cast<double>(HALF - 1);
+}
+
+std::size_t VariableResampler::process(std::span<const std::byte> in, double ratio,
+    std::span<std::byte> first, std::span<std::byte> second) noexcept
+{
+    const std::size_t in_frames = std::min(in.size() / frame_bytes_, max_input_frames_);
+    decode_samples(in.first(in_frames * frame_bytes_), format_.encoding,
+        std::span<float> { history_ }.subspan(have_ * channels_, in_frames * channels_));
+    have_ += in_frames;
+
+    const double clamped = std::clamp(ratio, 1.0 - MAX_RATIO_DEVIATION, 1.0 + MAX_RATIO_DEVIATION);
+    const double step = 1.0 / clamped;
+    const std::size_t room = std::min(max_output_frames_, (first.size() + second.size()) / frame_bytes_);
+
+    // 输出点 pos 需要帧 [floor(pos) - HALF + 1, floor(pos) + HALF] 全部就绪。
+    std::size_t produced = 0;
+    std::array<float, TAPS> coeff { };
+    while (static_cast<std::size_t>(pos_) + HALF < have_) {
+        const auto base = static_cast<std::size_t>(pos_);
+        const double phase = (pos_ - static_cast<double>(base)) * PHASES;
+        const auto p = std::min(static_cast<std::size_t>(phase), PHASES - 1);
+        const auto w = static_cast<float>(phase - static_cast<double>(p));
+        const float* c0 = table_.data() + p * TAPS;
+        const float* c1 = c0 + TAPS;
+        for (std::size_t j = 0; j < TAPS; ++j) {
+            coeff[j] = c0[j] + w * (c1[j] - c0[j]);
+        }
+
+        if (produced < room) {
+            const float* src = history_.data() + (base + 1 - HALF) * channels_;
+            float* dst = out_.data() + produced * channels_;
+            for (std::size_t ch = 0; ch < channels_; ++ch) {
+                float acc = 0.0f;
+                for (std::size_t j = 0; j < TAPS; ++j) {
+                    acc += coeff[j] * src[j * channels_ + ch];
+                }
+                dst[ch] = acc;
+            }
+            ++produced;
+        }
+        pos_ += step;
+    }
+
+    // 丢弃下一个输出点不再需要的历史，读位置随之平移（pos_ 始终保持在 [HALF - 1, HALF + 1) 附近）。
+    const auto keep_from = static_cast<std::size_t>(pos_) + 1 - HALF;
+    if (keep_from > 0) {
+        const std::size_t drop = std::min(keep_from, have_);
+        std::memmove(history_.data(), history_.data() + drop * channels_, (have_ - drop) * channels_ * sizeof(float));
+        have_ -= drop;
+        pos_ -= static_cast<double>(drop);
+    }
+
+    // 编码后按字节拆到两段（RingBuffer 回绕点不一定在帧边界）。
+    const std::size_t bytes = produced * frame_bytes_;
+    encode_samples(std::span<const float> { out_ }.first(produced * channels_), format_.encoding,
+        std::span<std::byte> { pcm_ }.first(bytes));
+    const std::size_t head = std::min(bytes, first.size());
+    std::memcpy(first.data(), pcm_.data(), head);
+    if (head < bytes) {
+        std::memcpy(second.data(), pcm_.data() + head, bytes - head);
+    }
+    return produced;
+}
+
+} // namespace aqua::audio::dsp
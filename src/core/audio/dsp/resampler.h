@@ -0,0 +1,62 @@
+#ifndef AQUA_RESAMPLER_H
+#define AQUA_RESAMPLER_H
+
+#include "core/public/audio_format.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace aqua::audio::dsp {
+
+// 分数倍率流式重采样（时钟漂移补偿：JitterBuffer 出队与播放设备之间的 ±ppm 级速率修正）。
+//
+// - 带限插值：Kaiser 窗 sinc，TAPS 抽头 × PHASES 相位系数表，相位间线性插值，
+//   每相位系数归一化为单位直流增益。截止频率按 ratio ≈ 1 设计（不做降采样抗混叠，
+//   ratio 钳到 1 ± MAX_RATIO_DEVIATION）。
+// - ratio = 输出帧数 / 输入帧数，每次 process 可变；读位置以 double 连续推进，
+//   比率变化不产生相位跳变。
+// - 群延迟 TAPS / 2 帧：输入末尾的这几帧留待下一块提供右侧邻域后再输出。
+//
+// 构造时按 max_input_frames 预分配全部内存；热路径无分配、无锁。
+// Threading contract: 单线程使用（客户端 io_context 线程）。
+class VariableResampler {
+public:
+    static constexpr std::size_t TAPS = 16;
+    static constexpr std::size_t PHASES = 128;
+    static constexpr double MAX_RATIO_DEVIATION = 0.01;
+
+    VariableResampler(const AudioFormat& format, std::size_t max_input_frames);
+
+    VariableResampler(const VariableResampler&) = delete;
+    VariableResampler& operator=(const VariableResampler&) = delete;
+
+    // 单次 process 最多输出的帧数（调用方据此预留输出区）。
+    [[nodiscard]] std::size_t max_output_frames() const noexcept { return max_output_frames_; }
+
+    // 输入一块交织 PCM（≤ max_input_frames 帧，超出部分忽略），按 ratio 输出到 first / second
+    // 两段（依次填充）。返回输出帧数；输出区不足时截断（丢弃的帧不再补出）。
+    std::size_t process(std::span<const std::byte> in, double ratio,
+        std::span<std::byte> first, std::span<std::byte> second) noexcept;
+
+    // 清空历史（时间线重置 / 重臂后调用）：下一块从静音邻域开始。
+    void reset() noexcept;
+
+private:
+    AudioFormat format_;
+    std::size_t channels_;
+    std::size_t frame_bytes_;
+    std::size_t max_input_frames_;
+    std::size_t max_output_frames_;
+
+    std::vector<float> table_; // (PHASES + 1) × TAPS，相位 p 的第 j 个系数作用于帧 floor(pos) - TAPS/2 + 1 + j
+    std::vector<float> history_; // 交织 float，帧 [0, have_)
+    std::vector<float> out_; // 本次输出（交织 float）
+    std::vector<std::byte> pcm_; // 本次输出（编码后）
+    std::size_t have_ = 0;
+    double pos_ = 0.0; // 下一个输出点在 history_ 中的帧位置
+};
+
+} // namespace aqua::audio::dsp
+
+#endif // AQUA_RESAMPLER_H
@@ -0,0 +1,223 @@
+#include "core/audio/dsp/sample_convert.h"
+#include "core/audio/dsp/convert_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace aqua::audio::dsp {
+
+namespace {
+    using detail::S16_SCALE;
+    using detail::S24_SCALE;
+    using detail::S32_SCALE;
+    using detail::U8_SCALE;
+
+    // 缩放后就近取整，在 int64 域饱和（S32 正满幅 2^31 超出 int32）。NaN 输出零点。
+    std::int64_t quantize(float v, float scale, std::int64_t lo, std::int64_t hi) noexcept
+    {
+        const float scaled = v * scale;
+        if (std::isnan(scaled)) {
+            return 0;
+        }
+        const auto q = static_cast<std::int64_t>(std::nearbyint(std::clamp(scaled, -2.0f * scale, 2.0f * scale)));
+        return std::clamp(q, lo, hi);
+    }
+} // namespace
+
+// ---- 标量参考实现（SIMD 内核逐样本与之按位一致，也用于其尾部处理）----
+
+namespace detail {
+    void decode_s16_scalar(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            std::int16_t v;
+            std::memcpy(&v, pcm + i * 2, sizeof(v));
+            out[i] = static_cast<float>(v) / S16_SCALE;
+        }
+    }
+
+    void decode_s32_scalar(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            std::int32_t v;
+            std::memcpy(&v, pcm + i * 4, sizeof(v));
+            out[i] = static_cast<float>(v) / S32_SCALE;
+        }
+    }
+
+    void decode_u8_scalar(const std::byte* pcm, float* out, std::size_t samples) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            out[i] = static_cast<float>(static_cast<int>(pcm[i]) - 128) / U8_SCALE;
+        }
+    }
+
+    void encode_s16_scalar(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            const auto v = static_cast<std::int16_t>(quantize(in[i], S16_SCALE, -32768, 32767));
+            std::memcpy(pcm + i * 2, &v, sizeof(v));
+        }
+    }
+
+    void encode_s24_scalar(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            store_s24(pcm + i * 3, static_cast<std::int32_t>(quantize(in[i], S24_SCALE, -8388608, 8388607)));
+        }
+    }
+
+    void encode_s32_scalar(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            const auto v = static_cast<std::int32_t>(quantize(in[i], S32_SCALE, INT32_MIN, INT32_MAX));
+            std::memcpy(pcm + i * 4, &v, sizeof(v));
+        }
+    }
+
+    void encode_u8_scalar(const float* in, std::byte* pcm, std::size_t samples) noexcept
+    {
+        for (std::size_t i = 0; i < samples; ++i) {
+            pcm[i] = static_cast<std::byte>(quantize(in[i], U8_SCALE, -128, 127) + 128);
+        }
+    }
+} // namespace detail
+
+namespace {
+    using detail::ConvertKernels;
+
+    constexpr ConvertKernels SCALAR_KERNELS {
+        detail::decode_s16_scalar,
+        detail::decode_s32_scalar,
+        detail::decode_u8_scalar,
+        detail::encode_s16_scalar,
+        detail::encode_s24_scalar,
+        detail::encode_s32_scalar,
+        detail::encode_u8_scalar,
+    };
+
+    const ConvertKernels& kernels_for(SimdLevel level) noexcept
+    {
+        if (!simd_level_supported(level)) {
+            return SCALAR_KERNELS;
+        }
+        switch (level) {
+#if defined(__x86_64__) || defined(_M_X64)
+        case SimdLevel::Sse2:
+            return detail::SSE2_CONVERT_KERNELS;
+        case SimdLevel::Avx2:
+            return detail::AVX2_CONVERT_KERNELS;
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+        case SimdLevel::Neon:
+            return detail::NEON_CONVERT_KERNELS;
+#endif
+        default:
+            return SCALAR_KERNELS;
+        }
+    }
+
+    const ConvertKernels& active_kernels() noexcept
+    {
+        static const ConvertKernels& kernels = kernels_for(detect_simd_level());
+        return kernels;
+    }
+
+    std::size_t decode(const ConvertKernels& k, std::span<const std::byte> pcm, AudioEncoding encoding,
+        std::span<float> out) noexcept
+    {
+        const std::size_t sample_bytes = AudioFormat { encoding, 1, 1 }.bytes_per_sample();
+        if (sample_bytes == 0) {
+            return 0;
+        }
+        const std::size_t n = std::min(pcm.size() / sample_bytes, out.size());
+        const std::byte* p = pcm.data();
+
+        switch (encoding) {
+        case AudioEncoding::PcmF32LE:
+            std::memcpy(out.data(), p, n * sizeof(float));
+            break;
+        case AudioEncoding::PcmS16LE:
+            k.decode_s16(p, out.data(), n);
+            break;
+        case AudioEncoding::PcmS24LE:
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto b0 = static_cast<std::uint32_t>(p[i * 3]);
+                const auto b1 = static_cast<std::uint32_t>(p[i * 3 + 1]);
+                const auto b2 = static_cast<std::uint32_t>(p[i * 3 + 2]);
+                const auto v = static_cast<std::int32_t>((b0 << 8) | (b1 << 16) | (b2 << 24)) >> 8;
+                out[i] = static_cast<float>(v) / S24_SCALE;
+            }
+            break;
+        case AudioEncoding::PcmS32LE:
+            k.decode_s32(p, out.data(), n);
+            break;
+        case AudioEncoding::PcmU8:
+            k.decode_u8(p, out.data(), n);
+            break;
+        case AudioEncoding::Invalid:
+            return 0;
+        }
+        return n;
+    }
+
+    std::size_t encode(const ConvertKernels& k, std::span<const float> in, AudioEncoding encoding,
+        std::span<std::byte> pcm) noexcept
+    {
+        const std::size_t sample_bytes = AudioFormat { encoding, 1, 1 }.bytes_per_sample();
+        if (sample_bytes == 0) {
+            return 0;
+        }
+        const std::size_t n = std::min(pcm.size() / sample_bytes, in.size());
+        std::byte* p = pcm.data();
+
+        switch (encoding) {
+        case AudioEncoding::PcmF32LE:
+            std::memcpy(p, in.data(), n * sizeof(float));
+            break;
+        case AudioEncoding::PcmS16LE:
+            k.encode_s16(in.data(), p, n);
+            break;
+        case AudioEncoding::PcmS24LE:
+            k.encode_s24(in.data(), p, n);
+            break;
+        case AudioEncoding::PcmS32LE:
+            k.encode_s32(in.data(), p, n);
+            break;
+        case AudioEncoding::PcmU8:
+            k.encode_u8(in.data(), p, n);
+            break;
+        case AudioEncoding::Invalid:
+            return 0;
+        }
+        return n;
+    }
+} // namespace
+
+std::size_t decode_samples(std::span<const std::byte> pcm, AudioEncoding encoding,
+    std::span<float> out) noexcept
+{
+    return decode(active_kernels(), pcm, encoding, out);
+}
+
+std::size_t encode_samples(std::span<const float> in, AudioEncoding encoding,
+    std::span<std::byte> pcm) noexcept
+{
+    return encode(active_kernels(), in, encoding, pcm);
+}
+
+std::size_t decode_samples(std::span<const std::byte> pcm, AudioEncoding encoding,
+    std::span<float> out, SimdLevel level) noexcept
+{
+    return decode(kernels_for(level), pcm, encoding, out);
+}
+
+std::size_t encode_samples(std::span<const float> in, AudioEncoding encoding,
+    std::span<std::byte> pcm, SimdLevel level) noexcept
+{
+    return encode(kernels_for(level), in, encoding, pcm);
+}
+
+} // namespace aqua::audio::dsp
@@ -0,0 +1,37 @@
+#ifndef AQUA_SAMPLE_CONVERT_H
+#define AQUA_SAMPLE_CONVERT_H
+
+#include "core/audio/dsp/cpu_features.h"
+#include "core/public/audio_format.h"
+
+#include <cstddef>
+#include <span>
+
+namespace aqua::audio::dsp {
+
+// 交织 PCM ↔ 归一化 float（满幅 [-1, 1)）。供需要在浮点域处理的 DSP 模块
+// （丢包隐藏等）使用；无分配、无对齐要求，可在实时线程调用。
+//
+// 整数编码按 2^(bits-1) 缩放：S16/S24/U8 往返无损；S32 受 float 24 位尾数限制，
+// 低位有 ≤ 2^7 的量化误差。
+// encode 四舍五入并饱和到编码范围（U8 以 128 为零点）；F32 原样透传。
+// 处理样本数 = min(pcm 整样本数, float 区间长度)，返回该值。
+// S16 / S32 走向量内核（首次调用时按 detect_simd_level() 选定），各档位与标量按位一致；
+// S24 / U8 为标量，F32 为 memcpy。
+
+std::size_t decode_samples(std::span<const std::byte> pcm, AudioEncoding encoding,
+    std::span<float> out) noexcept;
+
+std::size_t encode_samples(std::span<const float> in, AudioEncoding encoding,
+    std::span<std::byte> pcm) noexcept;
+
+// 指定档位（测试 / 基准用）。档位不可用时回退标量。
+std::size_t decode_samples(std::span<const std::byte> pcm, AudioEncoding encoding,
+    std::span<float> out, SimdLevel level) noexcept;
+
+std::size_t encode_samples(std::span<const float> in, AudioEncoding encoding,
+    std::span<std::byte> pcm, SimdLevel level) noexcept;
+
+} // namespace aqua::audio::dsp
+
+#endif // AQUA_SAMPLE_CONVERT_H
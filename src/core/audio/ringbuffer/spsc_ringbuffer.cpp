@@ -36,6 +36,27 @@ std::size_t SpscRingBuffer::write(std::span<const std::byte> data) noexcept
     return to_write;
 }
 
+SpscRingBuffer::WriteRegion SpscRingBuffer::prepare_write(std::size_t max_bytes) noexcept
+{
+    const std::size_t w = write_pos_.load(std::memory_order_relaxed);
+    const std::size_t r = read_pos_.load(std::memory_order_acquire);
+    const std::size_t to_write = std::min(max_bytes, buffer_.size() - (w - r));
+
+    const std::size_t idx = w % buffer_.size();
+    const std::size_t first = std::min(to_write, buffer_.size() - idx);
+    return WriteRegion {
+        std::span<std::byte> { buffer_.data() + idx, first },
+        std::span<std::byte> { buffer_.data(), to_write - first },
+    };
+}
+
+void SpscRingBuffer::commit_write(std::size_t bytes) noexcept
+{
+    // release：生产者对预留区域的填充先于写指针发布对消费者可见。
+    const std::size_t w = write_pos_.load(std::memory_order_relaxed);
+    write_pos_.store(w + bytes, std::memory_order_release);
+}
+
 std::size_t SpscRingBuffer::read(std::span<std::byte> out) noexcept
 {
     const std::size_t r = read_pos_.load(std::memory_order_relaxed);
@@ -30,6 +30,19 @@ public:
     // 返回实际写入字节数（可能小于请求值，若缓冲接近写满）。
     std::size_t write(std::span<const std::byte> data) noexcept;
 
+    // 零拷贝写：预留至多 max_bytes 的可写区域（跨尾部时为两段），生产者直接填充后
+    // commit_write() 发布。预留不移动写指针，未 commit 的内容对消费者不可见；
+    // 两次 prepare 之间未 commit 视为放弃上一次预留。仅生产者调用。
+    struct WriteRegion {
+        std::span<std::byte> first;
+        std::span<std::byte> second;
+        std::size_t size() const noexcept { return first.size() + second.size(); }
+    };
+    WriteRegion prepare_write(std::size_t max_bytes) noexcept;
+
+    // 发布 prepare_write 预留区域的前 bytes 字节（bytes <= 预留大小）。
+    void commit_write(std::size_t bytes) noexcept;
+
     // 返回实际读出字节数。
     std::size_t read(std::span<std::byte> out) noexcept;
 
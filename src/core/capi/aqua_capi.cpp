@@ -13,6 +13,7 @@
 #include "core/diagnostics/diagnostics_manager.h"
 #include "core/logger/logger.h"
 #include "core/public/audio_format.h"
+#include "core/public/config.h"
 #include "core/public/version.h"
 #include "core/server/server_runtime.h"
 
@@ -36,6 +37,10 @@ static_assert(static_cast<int>(aqua::AudioEncoding::PcmS24LE) == AQUA_ENCODING_P
     "AQUA_ENCODING_PCM_S24LE 与 AudioEncoding::PcmS24LE 不同步");
 static_assert(static_cast<int>(aqua::AudioEncoding::PcmU8) == AQUA_ENCODING_PCM_U8,
     "AQUA_ENCODING_PCM_U8 与 AudioEncoding::PcmU8 不同步");
+static_assert(static_cast<int>(aqua::config::PlcMode::Repeat) == AQUA_PLC_REPEAT,
+    "AQUA_PLC_REPEAT 与 PlcMode::Repeat 不同步");
+static_assert(static_cast<int>(aqua::config::PlcMode::Waveform) == AQUA_PLC_WAVEFORM,
+    "AQUA_PLC_WAVEFORM 与 PlcMode::Waveform 不同步");
 
 // ---- C ↔ C++ 类型转换 ----
 
@@ -171,6 +176,26 @@ void to_c_diagnostics(const aqua::diag::DiagnosticsManager::Snapshot& s,
     // v2 追加字段（老调用方 memset(0) 初始化时保持 0 语义安全）
     out->jb_target_ms = s.jb_target_ms;
     out->rb_rearms = s.rb_rearms;
+    // v3
+    out->device_delay_ms = s.device_delay_ms;
+    // v4
+    out->sched_wakeup_p50_us = s.sched_wakeup_p50_us;
+    out->sched_wakeup_p99_us = s.sched_wakeup_p99_us;
+    out->sched_wakeup_max_us = s.sched_wakeup_max_us;
+    // v5
+    out->thread_policy_failures = s.thread_policy_failures;
+    out->memory_locked = s.memory_locked ? 1 : 0;
+    // v6
+    using aqua::diag::StartupStage;
+    const auto startup = [&s](StartupStage stage) { return s.startup_ms[static_cast<std::size_t>(stage)]; };
+    out->startup_channel_ready_ms = startup(StartupStage::ChannelReady);
+    out->startup_connected_ms = startup(StartupStage::Connected);
+    out->startup_udp_bound_ms = startup(StartupStage::UdpBound);
+    out->startup_device_opened_ms = startup(StartupStage::DeviceOpened);
+    out->startup_playback_started_ms = startup(StartupStage::PlaybackStarted);
+    out->startup_hello_acked_ms = startup(StartupStage::HelloAcked);
+    out->startup_first_audio_ms = startup(StartupStage::FirstAudio);
+    out->startup_first_audible_ms = startup(StartupStage::FirstAudible);
 }
 
 } // namespace
@@ -303,6 +328,17 @@ int aqua_client_start(aqua_client_t* client,
         if (config->jitter_detect_window_packets > 0) {
             cfg.runtime.jitter_detect_window_packets = config->jitter_detect_window_packets;
         }
+        // v5 字段：0 = Repeat；未知取值按默认处理。
+        if (config->plc_mode == AQUA_PLC_WAVEFORM) {
+            cfg.runtime.plc_mode = aqua::config::PlcMode::Waveform;
+        }
+        // v6 字段：0 = core 默认（时间伸缩开、漂移补偿关），非 0 才覆盖。
+        if (config->disable_time_stretch != 0) {
+            cfg.runtime.time_stretch = false;
+        }
+        if (config->drift_compensation != 0) {
+            cfg.runtime.drift_compensation = true;
+        }
         if (config->playback_ringbuffer_size > 0) {
             cfg.runtime.playback_ringbuffer_size = config->playback_ringbuffer_size;
         }
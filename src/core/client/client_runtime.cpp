@@ -1,13 +1,25 @@
 #include "core/client/client_runtime.h"
 
 #include "core/audio/backend/audio_backend_factory.h"
+#include "core/audio/dsp/cpu_features.h"
+#include "core/audio/dsp/format_converter.h"
+#include "core/audio/dsp/polyphase_resampler.h"
+#include "core/audio/dsp/resampler.h"
 #include "core/audio/ringbuffer/spsc_ringbuffer.h"
+#include "core/client/drift_compensator.h"
+#include "core/client/playout_scheduler.h"
+#include "core/client/pull_playout.h"
+#include "core/client/stream_mixer.h"
 #include "core/diagnostics/diagnostics_manager.h"
+#include "core/diagnostics/startup_trace.h"
 #include "core/grpc/grpc_client.h"
+#include "core/jitter_buffer/ingress_queue.h"
 #include "core/jitter_buffer/jitter_buffer.h"
 #include "core/logger/logger.h"
+#include "core/net/capture/packet_capture.h"
 #include "core/net/packet/packet.h"
 #include "core/net/transport/udp_transport.h"
+#include "core/rt/thread_policy.h"
 
 #include <asio.hpp>
 
@@ -15,13 +27,18 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <span>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace aqua::client {
@@ -32,16 +49,26 @@ namespace {
     enum class SessionOutcome {
         CleanExit, // 收到关闭请求（shutdown_requested_ 被置位）
         Retryable, // 可重连：gRPC 失败 / HELLO 超时 / 音频超时
+        FormatChanged, // 原位重连后服务端格式变化：管线须按新格式重建，立即重连（不退避）
         Fatal, // 不可恢复：格式非法 / UDP 绑定失败 / 无播放后端 / 播放失败
     };
 
     // 主循环 / 退避等待轮询间隔。
     constexpr auto POLL_INTERVAL = std::chrono::milliseconds(50);
+    // 原位重连进行中的主循环轮询间隔：Connect 完成后尽快发出 HELLO。
+    constexpr auto RELINK_POLL_INTERVAL = std::chrono::milliseconds(5);
 
     // RB 占用高频采样间隔（slope 窗口输入，与诊断刷新解耦——5s 窗口只有 1-2 个
     // 样本点时线性回归无意义）。
     constexpr auto RB_SAMPLE_INTERVAL = std::chrono::milliseconds(500);
 
+    // 握手 HELLO 第 attempt 次（从 1 起）发出后到下次重发的间隔：INITIAL 起倍增，封顶 RETRY_INTERVAL。
+    std::chrono::milliseconds hello_retry_delay(int attempt)
+    {
+        const int shift = std::clamp(attempt - 1, 0, 8);
+        return std::min(config::HELLO_HANDSHAKE_INITIAL_RETRY * (1 << shift), config::HELLO_HANDSHAKE_RETRY_INTERVAL);
+    }
+
 } // namespace
 
 struct ClientRuntime::Impl {
@@ -66,12 +93,30 @@ struct ClientRuntime::Impl {
 
     std::thread session_thread;
 
+    // 线程策略应用结果（各运行时线程入口写入，主循环同步到诊断快照）。跨会话累计。
+    rt::ThreadPolicyReport thread_policy_report_;
+
+    // 已开始的会话数（会话线程独占）：重连后的抓包文件按序号加后缀，不覆盖前一会话。
+    std::uint32_t session_count_ = 0;
+
     void set_last_error(std::string message)
     {
         std::lock_guard<std::mutex> lock(error_mutex_);
         last_error_ = std::move(message);
     }
 
+    // 角色的线程策略。Scheduler 角色未显式配置时由 playout_realtime 折算为 SCHED_FIFO。
+    config::ThreadPolicy thread_policy(config::ThreadRole role) const
+    {
+        auto policy = cfg.runtime.thread_policies[static_cast<std::size_t>(role)];
+        if (role == config::ThreadRole::Scheduler && cfg.runtime.playout_realtime
+            && policy.policy == config::SchedPolicy::Default) {
+            policy.policy = config::SchedPolicy::Fifo;
+            policy.priority = config::PLAYOUT_SCHEDULER_RT_PRIORITY;
+        }
+        return policy;
+    }
+
     void set_state(ClientState next)
     {
         state_.store(next, std::memory_order_relaxed);
@@ -80,8 +125,8 @@ struct ClientRuntime::Impl {
         }
     }
 
-    // 执行一次完整的客户端会话：gRPC Connect → UDP 握手 → 播放 → 主循环 → 清理。
-    // 返回结果表示"为何退出"，由 session_loop 决定是否指数退避重连。
+    // 执行一次完整的客户端会话：gRPC Connect ∥ 播放后端创建 + UDP 绑定 → 首个 HELLO ∥ 设备启动 →
+    // 等待 HELLO_ACK → 主循环 → 清理。返回结果表示"为何退出"，由 session_loop 决定是否指数退避重连。
     SessionOutcome run_one_session()
     {
         // 新会话开始：清空上一会话的诊断快照（diag_manager 每会话重建，计数器归零，
@@ -92,20 +137,178 @@ struct ClientRuntime::Impl {
             audio_format_.reset();
         }
 
-        // ---- gRPC Connect ----
+        const std::uint32_t session_index = session_count_++;
+        asio::io_context ioc;
+
+        // 启动时间线（time-to-first-audio 分解）：各阶段在完成它的线程上打点，主循环同步到诊断快照。
+        diag::StartupTrace startup;
+
+        // 回放模式：不连接服务器，会话格式与 session_id 取自抓包文件头，
+        // 接收路径的输入由 CaptureReplaySource 按原始时序提供。
+        const bool replaying = !cfg.replay_path.empty();
+        net::CaptureReplaySource replay_source(ioc);
+
+        // ---- gRPC Connect（后台）----
+        // 控制面握手与播放后端创建、UDP 绑定互不依赖：三者并行，启动耗时取最大值而非总和。
+        // 设备格式协商需要服务端格式，放在 Connect 返回之后。
+        struct ControlConnect {
+            grpc::GrpcClient client;
+            grpc::ConnectResult result;
+            bool channel_ready = false;
+            bool connected = false;
+        };
+        // 重连 / 附加订阅源的后台 Connect 结果（失败为 nullopt）。
+        struct LinkConnect {
+            grpc::GrpcClient client;
+            grpc::ConnectResult result;
+        };
+        std::future<ControlConnect> pending_control;
         grpc::GrpcClient grpc_client;
-        if (!grpc_client.connect_to_server(cfg.server_ip, cfg.server_rpc_port)) {
-            set_last_error("failed to connect to gRPC server at " + cfg.server_ip + ":"
-                + std::to_string(cfg.server_rpc_port));
-            log_error("failed to connect to gRPC server");
-            return SessionOutcome::Retryable;
+        grpc::ConnectResult connect_result;
+        if (replaying) {
+            if (!replay_source.open(cfg.replay_path)) {
+                set_last_error("failed to open replay file '" + cfg.replay_path + "'");
+                return SessionOutcome::Fatal;
+            }
+            connect_result.session_id = replay_source.info().session_id;
+            connect_result.audio_format = replay_source.info().format;
+            log_info_fmt("Replaying captured datagrams from '{}' (no server connection)", cfg.replay_path);
+        } else {
+            pending_control = std::async(std::launch::async,
+                [server_ip = cfg.server_ip, rpc_port = cfg.server_rpc_port, client_name = cfg.client_name, &startup] {
+                    ControlConnect c;
+                    c.channel_ready = c.client.connect_to_server(server_ip, rpc_port);
+                    if (c.channel_ready) {
+                        startup.mark(diag::StartupStage::ChannelReady);
+                        c.connected = c.client.connect(client_name, c.result);
+                        if (c.connected) {
+                            startup.mark(diag::StartupStage::Connected);
+                        }
+                    }
+                    return c;
+                });
         }
 
-        grpc::ConnectResult connect_result;
-        if (!grpc_client.connect(cfg.client_name, connect_result)) {
-            set_last_error("gRPC Connect failed (server may not be running)");
-            log_error("gRPC Connect failed");
-            return SessionOutcome::Retryable;
+        // 附加订阅源（cfg.mix_sources）：每个源一条链路，会话线程独占。后台 Connect 与主服务器并行发起，
+        // 但不阻塞起播——完成后由主循环接入混音（service_mix）；断流 / 令牌失效后随保活节拍重新 Connect。
+        // io 线程只经 mix_routes（见下）看到已接入的链路。
+        struct MixLink {
+            std::size_t source = 0; // cfg.mix_sources 下标
+            std::future<std::optional<LinkConnect>> pending; // 后台 Connect（进行中为 valid）
+            std::optional<LinkConnect> connected; // 当前服务端会话（session_id 以 mix_session_ids 为准）
+            std::optional<std::size_t> stream; // StreamMixer 流索引：首次接入时分配，重连沿用
+            AudioFormat format; // 该路流格式（重连格式不变才沿用流）
+            asio::ip::udp::endpoint endpoint;
+            std::chrono::steady_clock::time_point next_connect_at { };
+            bool unreachable_logged = false;
+            bool disabled = false; // 地址非法 / 采样率不同 / 端点重复 / 格式变化：不再重试
+        };
+        std::vector<MixLink> mix_links;
+        // 附加源当前 session_id：会话线程接入时写，io 线程 UDP 重新入会（扩展 HELLO_ACK）时写。
+        std::array<std::atomic<std::uint32_t>, config::MIX_MAX_SOURCES> mix_session_ids { };
+        // 后台 Connect 附加源；stale_session 非零时先在新通道上 best-effort Disconnect 旧会话。
+        const auto begin_mix_connect = [&](MixLink& m, std::uint32_t stale_session) {
+            m.pending = std::async(std::launch::async,
+                [source = cfg.mix_sources[m.source], client_name = cfg.client_name,
+                    stale_session]() -> std::optional<LinkConnect> {
+                    LinkConnect c;
+                    if (!c.client.connect_to_server(source.server_ip, source.server_rpc_port,
+                            config::MIX_SOURCE_CONNECT_TIMEOUT)) {
+                        return std::nullopt;
+                    }
+                    if (stale_session != 0) {
+                        (void)c.client.disconnect(stale_session);
+                    }
+                    if (!c.client.connect(client_name, c.result)) {
+                        return std::nullopt;
+                    }
+                    return c;
+                });
+        };
+        if (!replaying) {
+            if (cfg.mix_sources.size() > config::MIX_MAX_SOURCES) {
+                log_warn_fmt("{} mix sources configured, only the first {} are used",
+                    cfg.mix_sources.size(), config::MIX_MAX_SOURCES);
+            }
+            const std::size_t mix_count = std::min(cfg.mix_sources.size(), config::MIX_MAX_SOURCES);
+            mix_links.reserve(mix_count);
+            for (std::size_t i = 0; i < mix_count; ++i) {
+                auto& m = mix_links.emplace_back();
+                m.source = i;
+                begin_mix_connect(m, 0);
+            }
+        }
+
+        // 收尾附加源：进行中的后台 Connect 与已接入的会话一并 Disconnect（任何退出路径都调用）。
+        const auto release_mix = [&] {
+            for (auto& m : mix_links) {
+                if (m.pending.valid()) {
+                    if (auto c = m.pending.get()) {
+                        (void)c->client.disconnect(c->result.session_id);
+                    }
+                }
+                if (m.connected) {
+                    (void)m.connected->client.disconnect(mix_session_ids[m.source].load(std::memory_order_relaxed));
+                }
+            }
+        };
+
+        // 本地阶段失败时收尾后台 Connect：已建立的服务端会话立即移除，不等超时。
+        const auto abandon_control = [&] {
+            if (pending_control.valid()) {
+                auto control = pending_control.get();
+                if (control.connected) {
+                    (void)control.client.disconnect(control.result.session_id);
+                }
+            }
+            release_mix();
+        };
+
+        // ---- Playback 后端（与 Connect 并行创建）----
+        // 后端在 RB / JB 之前创建：设备格式决定 RB 字节速率与格式转换级。
+        // 此时只创建后端，协商在拿到服务端格式后进行，start() 与首个 HELLO 的往返重叠。
+        auto playback = audio::create_playback_backend(cfg.playback);
+        if (!playback) {
+            set_last_error("no audio playback backend available");
+            log_error("no audio playback backend available");
+            abandon_control();
+            return SessionOutcome::Fatal;
+        }
+        startup.mark(diag::StartupStage::DeviceOpened);
+
+        // ---- UDP Transport（与 Connect 并行绑定；回放时不绑定，收发均为空操作）----
+        net::UdpTransport transport(ioc);
+        if (!replaying) {
+            if (!transport.bind("0.0.0.0", 0)) {
+                set_last_error("failed to bind local UDP port");
+                log_error("failed to bind local UDP port");
+                abandon_control();
+                return SessionOutcome::Fatal;
+            }
+            startup.mark(diag::StartupStage::UdpBound);
+
+            const auto local_ep = transport.socket_local_endpoint();
+            log_info_fmt("Client UDP bound to {}:{}",
+                local_ep.address().to_string(), local_ep.port());
+        }
+
+        if (pending_control.valid()) {
+            auto control = pending_control.get();
+            if (!control.channel_ready) {
+                set_last_error("failed to connect to gRPC server at " + cfg.server_ip + ":"
+                    + std::to_string(cfg.server_rpc_port));
+                log_error("failed to connect to gRPC server");
+                release_mix();
+                return SessionOutcome::Retryable;
+            }
+            if (!control.connected) {
+                set_last_error("gRPC Connect failed (server may not be running)");
+                log_error("gRPC Connect failed");
+                release_mix();
+                return SessionOutcome::Retryable;
+            }
+            grpc_client = std::move(control.client);
+            connect_result = std::move(control.result);
         }
 
         const auto session_id = connect_result.session_id;
@@ -115,6 +318,7 @@ struct ClientRuntime::Impl {
             set_last_error("server returned invalid audio format");
             log_error("server returned invalid audio format");
             grpc_client.disconnect(session_id);
+            release_mix();
             return SessionOutcome::Fatal;
         }
 
@@ -134,19 +338,19 @@ struct ClientRuntime::Impl {
             cfg.server_ip, cfg.server_rpc_port,
             rt_cfg.jitter_buffer_ms);
 
-        // ---- UDP Transport ----
-        asio::io_context ioc;
-        net::UdpTransport transport(ioc);
-        if (!transport.bind("0.0.0.0", 0)) {
-            set_last_error("failed to bind local UDP port");
-            log_error("failed to bind local UDP port");
-            grpc_client.disconnect(session_id);
-            return SessionOutcome::Fatal;
+        // ---- 设备格式协商（临时探测设备）----
+        AudioFormat device_format = playback->negotiate_format(server_audio_format);
+        if (!device_format.valid()
+            || !audio::dsp::PolyphaseResampler::supports(server_audio_format.sample_rate, device_format.sample_rate)) {
+            // 转换级无法覆盖（采样率比约分后相位数过多）：按服务端格式尝试，由 start() 判定
+            log_warn_fmt("Playback device proposed {}ch {}Hz encoding={}, unsupported; using server format",
+                device_format.channels, device_format.sample_rate, static_cast<int>(device_format.encoding));
+            device_format = server_audio_format;
         }
-
-        const auto local_ep = transport.socket_local_endpoint();
-        log_info_fmt("Client UDP bound to {}:{}",
-            local_ep.address().to_string(), local_ep.port());
+        const bool convert_format = device_format != server_audio_format;
+        log_info_fmt("Playback device format: {}ch {}Hz encoding={}{}",
+            device_format.channels, device_format.sample_rate, static_cast<int>(device_format.encoding),
+            convert_format ? " (converting from server format)" : "");
 
         // asio::ip::make_address 在 IP 格式非法时抛异常，需 try-catch 保护。
         asio::ip::address server_address;
@@ -157,19 +361,55 @@ struct ClientRuntime::Impl {
                 + "': " + e.what());
             log_error_fmt("invalid server IP address '{}': {}", cfg.server_ip, e.what());
             grpc_client.disconnect(session_id);
+            release_mix();
             return SessionOutcome::Fatal;
         }
         const asio::ip::udp::endpoint server_udp_endpoint(server_address, connect_result.udp_port);
 
-        // Init RingBuffer: JitterBuffer → RingBuffer → 播放线程。
-        audio::SpscRingBuffer ringbuffer(rt_cfg.playback_ringbuffer_size);
+        // 当前链路（服务端 session_id + UDP 端点 + 恢复令牌）：原位重连时由会话线程替换，
+        // io 线程（HELLO_ACK 匹配 / 保活）读取，用 link_mutex 保护（低频访问）。
+        struct LinkTarget {
+            std::uint32_t session_id;
+            asio::ip::udp::endpoint endpoint;
+            std::uint64_t resume_token; // 0 = 无令牌（旧服务端 / 回放），HELLO 不带扩展字段
+        };
+        std::mutex link_mutex;
+        LinkTarget link { session_id, server_udp_endpoint, connect_result.resume_token };
+        // 快速恢复时服务端经 UDP 新建的 session（扩展 HELLO_ACK，io 线程写入），由会话线程在 Resuming 状态下取走切换。
+        std::optional<LinkTarget> pending_rejoin;
+        const auto current_link = [&] {
+            std::lock_guard<std::mutex> lock(link_mutex);
+            return link;
+        };
+        const auto take_pending_rejoin = [&] {
+            std::lock_guard<std::mutex> lock(link_mutex);
+            return std::exchange(pending_rejoin, std::nullopt);
+        };
+
+        // 拉模式：设备回调直接从 JB 出队（client::PullPlayout），不经过下面的 RingBuffer。
+        // 调度线程模式：专用线程（PlayoutScheduler）出队到 RingBuffer，取代 io 线程的 steady_timer。
+        // 两者都由 JB 的出队线程独占 JB，io 线程经 IngressQueue 交包。
+        const bool pull_mode = rt_cfg.playout_mode == config::PlayoutMode::Pull;
+        const bool thread_mode = rt_cfg.playout_mode == config::PlayoutMode::Thread;
+
+        // Init RingBuffer（Timer 模式）: JitterBuffer → [格式转换] → RingBuffer → 播放线程。
+        // RB 存设备格式；配置容量按服务端格式字节计，按字节速率比例换算以保持时长不变。
+        const std::uint64_t server_bytes_per_s = static_cast<std::uint64_t>(server_audio_format.sample_rate)
+            * server_audio_format.frame_bytes();
+        const std::uint64_t device_bytes_per_s = static_cast<std::uint64_t>(device_format.sample_rate)
+            * device_format.frame_bytes();
+        const auto rb_requested_bytes = static_cast<std::size_t>(
+            rt_cfg.playback_ringbuffer_size * device_bytes_per_s / server_bytes_per_s);
+        audio::SpscRingBuffer ringbuffer(rb_requested_bytes);
         // 字节速率（B/ms），把容量换算成时长，便于直观比较缓冲余量。
-        const double bytes_per_ms = static_cast<double>(server_audio_format.sample_rate)
-            * server_audio_format.frame_bytes() / 1000.0;
-        log_info_fmt("Playback RingBuffer: requested={} bytes ({:.1f}ms), actual={} bytes ({:.1f}ms)",
-            rt_cfg.playback_ringbuffer_size,
-            rt_cfg.playback_ringbuffer_size / bytes_per_ms,
-            ringbuffer.capacity(), ringbuffer.capacity() / bytes_per_ms);
+        const double bytes_per_ms = static_cast<double>(device_format.sample_rate)
+            * device_format.frame_bytes() / 1000.0;
+        if (!pull_mode) {
+            log_info_fmt("Playback RingBuffer: requested={} bytes ({:.1f}ms), actual={} bytes ({:.1f}ms)",
+                rb_requested_bytes,
+                rb_requested_bytes / bytes_per_ms,
+                ringbuffer.capacity(), ringbuffer.capacity() / bytes_per_ms);
+        }
 
         // 每包 PCM 参数。FRAMES_PER_PACKET 是固定帧数（与采样率无关）。
         const std::uint32_t frames_per_packet = config::AUDIO_FRAMES_PER_PACKET;
@@ -191,17 +431,13 @@ struct ClientRuntime::Impl {
         const std::uint32_t jb_ms = rt_cfg.jitter_buffer_ms > 0
             ? rt_cfg.jitter_buffer_ms
             : config::DEFAULT_JITTER_BUFFER_MS;
-        const std::uint64_t requested_frames = static_cast<std::uint64_t>(jb_ms) * server_audio_format.sample_rate / 1000;
-        const std::uint64_t requested_packets = (requested_frames + frames_per_packet - 1) / frames_per_packet;
-        std::size_t jitter_capacity = config::JITTER_MIN_CAPACITY_PACKETS;
-        while (jitter_capacity < requested_packets) {
-            jitter_capacity <<= 1;
-        }
         // 分配策略（比例固定，见 config.h）：
         //   ceiling = cap/2（自适应上限；上半区留乱序余量）
         //   floor   = cap/4（起播点 + 自适应下限，AIMD 区间 [cap/4, cap/2]）
-        const std::size_t jb_ceiling_packets = jitter_capacity / 2;
-        const std::size_t jb_floor_packets = jitter_capacity / 4;
+        const auto sizing = jitter::derive_jitter_sizing(jb_ms, server_audio_format.sample_rate, frames_per_packet);
+        const std::size_t jitter_capacity = sizing.capacity_packets;
+        const std::size_t jb_ceiling_packets = sizing.ceiling_packets;
+        const std::size_t jb_floor_packets = sizing.floor_packets;
 
         log_info_fmt("JitterBuffer: buffer={}ms -> capacity={} packets ({:.2f}ms), "
                      "floor={} packets ({:.2f}ms), ceiling={} packets ({:.2f}ms), {}B",
@@ -217,9 +453,16 @@ struct ClientRuntime::Impl {
         const std::uint32_t detect_window_packets = rt_cfg.jitter_detect_window_packets > 0
             ? rt_cfg.jitter_detect_window_packets
             : config::JITTER_DETECT_WINDOW_PACKETS;
-        log_info_fmt("JitterBuffer detect window: {} packets", detect_window_packets);
+        log_info_fmt("JitterBuffer detect window: {} packets, estimator={}, plc={}, time-stretch={}, drift-compensation={}",
+            detect_window_packets,
+            rt_cfg.jitter_estimator == config::JitterEstimator::Histogram ? "histogram" : "late",
+            rt_cfg.plc_mode == config::PlcMode::Waveform ? "waveform" : "repeat",
+            rt_cfg.time_stretch ? "on" : "off",
+            rt_cfg.drift_compensation ? "on" : "off");
         jitter::AdaptiveTargetConfig adapt_cfg { };
         adapt_cfg.max_packets = jb_ceiling_packets;
+        adapt_cfg.time_stretch = rt_cfg.time_stretch;
+        adapt_cfg.estimator = rt_cfg.jitter_estimator;
         jitter::JitterBuffer jitter_buffer(
             server_audio_format,
             frames_per_packet,
@@ -227,10 +470,27 @@ struct ClientRuntime::Impl {
             jitter_capacity,
             detect_window_packets,
             config::JITTER_DRIFT_REBASE_LATE_COUNT,
-            adapt_cfg);
+            adapt_cfg,
+            sizeof(net::AudioPacketHeader), // 零拷贝接收：报文头落在 JB 缓冲的 headroom
+            rt_cfg.plc_mode,
+            std::max(packet_payload_size, config::AUDIO_MAX_PAYLOAD_BYTES)); // 变长包上限
+
+        // ---- 多服务器混音（cfg.mix_sources）----
+        // 混音级在起播前建好，流槽位按附加源数预分配；附加源不在此等待，Connect 完成后由主循环
+        // 接入（同采样率的源各建一路 JB，与主流同一套尺寸推导），在主流出队时按增益求和。
+        std::unique_ptr<StreamMixer> mixer;
+        if (!mix_links.empty() || cfg.mix_gain != 1.0f) {
+            mixer = std::make_unique<StreamMixer>(server_audio_format, frames_per_packet, cfg.mix_gain, mix_links.size());
+            log_info_fmt("Stream mixer: {} extra source(s), primary gain={:.2f}, kernel={}",
+                mix_links.size(), cfg.mix_gain, audio::dsp::simd_level_name(audio::dsp::detect_simd_level()));
+        }
 
-        // UDP 握手状态。
+        // UDP 握手状态。会话线程在 handshake_cv 上等待首个 HELLO_ACK（io 线程置位后唤醒）。
         std::atomic<bool> hello_acked { false };
+        std::mutex handshake_mutex;
+        std::condition_variable handshake_cv;
+        // 扩展 HELLO 的恢复被服务端拒绝（HELLO_ACK session_id = 0），原位重连据此立即改走 gRPC。
+        std::atomic<bool> resume_rejected { false };
 
         // WASAPI playback 初始化标志：在 playback 启动前丢弃音频包。
         std::atomic<bool> playback_ready { false };
@@ -246,22 +506,170 @@ struct ClientRuntime::Impl {
         std::uint32_t consecutive_missed_acks = 0;
         bool keepalive_loss_warned = false;
 
-        // M5: DiagnosticsManager
+        // ---- 时钟漂移补偿（RuntimeConfig::drift_compensation）----
+        // 主循环跑 DriftCompensator，输出经 atomic 交给 io 线程：出队节拍 → JitterBuffer，
+        // 重采样比率 → pop 与 RB 之间的 VariableResampler。未启用时走原直通路径。
+        std::atomic<double> jb_rate_cmd { 1.0 };
+        std::atomic<double> resample_ratio_cmd { 1.0 };
+        std::unique_ptr<audio::dsp::VariableResampler> resampler;
+        std::vector<std::byte> pop_scratch; // pop_next 输出（重采样 / 转换输入），io 线程独占
+        if (rt_cfg.drift_compensation) {
+            resampler = std::make_unique<audio::dsp::VariableResampler>(server_audio_format, frames_per_packet);
+            pop_scratch.resize(packet_payload_size);
+        }
+        const std::size_t max_resampled_frames = resampler ? resampler->max_output_frames() : frames_per_packet;
+
+        // ---- 格式转换（设备格式 ≠ 服务端格式）----
+        // 位于漂移重采样之后、RB 之前：JB / 漂移重采样始终在服务端格式上工作，转换只做一次。
+        // 采样率不同时转换级内含 PolyphaseResampler（固定倍率），漂移的 ±ppm 修正仍在其上游。
+        std::unique_ptr<audio::dsp::FormatConverter> converter;
+        std::vector<std::byte> resample_scratch; // 漂移重采样输出（转换输入），io 线程独占
+        if (convert_format) {
+            audio::dsp::FormatConverterOptions convert_options;
+            convert_options.dither = rt_cfg.dither;
+            converter = std::make_unique<audio::dsp::FormatConverter>(
+                server_audio_format, device_format, max_resampled_frames, std::move(convert_options));
+            pop_scratch.resize(packet_payload_size);
+            if (resampler) {
+                resample_scratch.resize(max_resampled_frames * server_audio_format.frame_bytes());
+            }
+            log_info_fmt("Format converter: {}ch {}Hz encoding={} -> {}ch {}Hz encoding={}, dither={}, delay={:.2f}ms",
+                server_audio_format.channels, server_audio_format.sample_rate, static_cast<int>(server_audio_format.encoding),
+                device_format.channels, device_format.sample_rate, static_cast<int>(device_format.encoding),
+                converter->dithering() ? "on" : "off", converter->delay_frames() * 1000.0 / device_format.sample_rate);
+        }
+        if (mixer) {
+            pop_scratch.resize(packet_payload_size); // 混音在 pop_scratch 上原地进行
+        }
+        const std::size_t max_pop_frames = converter ? converter->max_output_frames() : max_resampled_frames;
+        // 采样率转换的固定前瞻计入端到端延迟（与设备缓冲同一口径，设备帧）
+        const auto converter_delay_frames = converter
+            ? static_cast<std::uint32_t>(std::lround(converter->delay_frames()))
+            : 0u;
+        const std::size_t rb_write_bytes = max_pop_frames * device_format.frame_bytes();
+
+        // ---- 拉模式 / 调度线程模式：IngressQueue（io 线程 → 出队线程）+ PullPlayout ----
+        // io 线程把包连同到达时刻排队（可直接收进队列槽），JB 的 push / pop 全部在出队线程。
+        std::unique_ptr<jitter::IngressQueue> ingress;
+        std::unique_ptr<PullPlayout> pull_playout;
+        if (pull_mode || thread_mode) {
+            ingress = std::make_unique<jitter::IngressQueue>(config::PULL_INGRESS_QUEUE_PACKETS,
+                sizeof(net::AudioPacketHeader), std::max(packet_payload_size, config::AUDIO_MAX_PAYLOAD_BYTES));
+        }
+        if (pull_mode) {
+            pull_playout = std::make_unique<PullPlayout>(jitter_buffer, *ingress, server_audio_format, device_format,
+                frames_per_packet, resampler.get(), converter.get(), config::PULL_PLAYOUT_LEAD_PACKETS, mixer.get());
+            log_info_fmt("Pull playout: ingress={} packets, lead={} packets, staging={} bytes",
+                ingress->capacity(), config::PULL_PLAYOUT_LEAD_PACKETS, pull_playout->staging_capacity());
+        }
+
+        // M5: DiagnosticsManager（RB 占用按设备格式换算时长；每包折算为设备采样率下的帧数）。
+        // 拉模式下 "RB" 为 PullPlayout 跨回调暂存的帧（< 1 块）。
+        // 采样回调为非拥有引用：具名 lambda 先于 diag_manager 构造、后于它析构。
+        const auto rb_fill_bytes = [&]() { return pull_playout ? pull_playout->staged_bytes() : ringbuffer.available_read(); };
+        const auto played_sample_count = [&played_samples]() { return played_samples.load(std::memory_order_relaxed); };
         diag::DiagnosticsManager diag_manager(
-            server_audio_format.sample_rate,
-            server_audio_format.frame_bytes(),
-            packet_payload_size,
-            [&ringbuffer]() { return ringbuffer.available_read(); },
-            ringbuffer.capacity(),
-            [&played_samples]() { return played_samples.load(std::memory_order_relaxed); });
-
-        // ---- JitterBuffer → RingBuffer 调度器 ----
+            device_format.sample_rate,
+            device_format.frame_bytes(),
+            static_cast<std::size_t>(static_cast<std::uint64_t>(frames_per_packet) * device_format.sample_rate
+                / server_audio_format.sample_rate) * device_format.frame_bytes(),
+            rb_fill_bytes,
+            pull_playout ? pull_playout->staging_capacity() : ringbuffer.capacity(),
+            played_sample_count);
+
+        // ---- JitterBuffer → RingBuffer 出队 ----
+        // 直通：pop_next 直接写入 RingBuffer 预留区（prepare_write/commit_write），无中转缓冲。
+        // 混音 / 漂移补偿 / 格式转换：pop_next 写入 pop_scratch，混入附加流后经重采样
+        // （→ resample_scratch）与格式转换写入预留区（按最大输出预留，按实际提交）。
+        // 出队 deadline 不晚于 horizon 的全部块（Timer：horizon = now；调度线程：now + 批量窗口）。
+        // 主流无时间线（未起播 / 断流重置）时由附加流中最早的 deadline 领拍，以静音为底混音，
+        // 主流静音停发或服务器闪断时附加流不随之中断。
+        // Timer 模式在 io 线程、调度线程模式在 PlayoutScheduler 线程调用。
+        const auto playout_deadline = [&]() {
+            auto dl = jitter_buffer.next_playout_deadline();
+            if (!dl && mixer) {
+                dl = mixer->next_deadline();
+            }
+            return dl;
+        };
+        const auto pop_due = [&](std::chrono::steady_clock::time_point now,
+                                 std::chrono::steady_clock::time_point horizon) {
+            if (resampler) {
+                jitter_buffer.set_playout_rate(jb_rate_cmd.load(std::memory_order_relaxed));
+            }
+            if (mixer) {
+                mixer->drain();
+            }
+
+            while (!shutdown_requested_.load(std::memory_order_relaxed)) {
+                auto dl = jitter_buffer.next_playout_deadline();
+                const bool primary = dl.has_value();
+                if (!primary && mixer) {
+                    dl = mixer->next_deadline();
+                }
+                if (!dl || *dl > horizon) {
+                    break;
+                }
+
+                // RingBuffer 没有空间时停止 pop，保留包在 JitterBuffer 中。
+                // （WASAPI 未启动时 RB 满属正常；长时间断流的 timeline reset
+                //  已下沉到 JitterBuffer::pop_next 内部，仅在真正 pop 时触发。）
+                const auto region = ringbuffer.prepare_write(rb_write_bytes);
+                if (region.size() < rb_write_bytes) {
+                    break;
+                }
+
+                const auto lateness = std::chrono::duration_cast<std::chrono::microseconds>(now - *dl);
+
+                if (lateness > packet_duration_us) {
+                    diag_manager.record_deadline_miss();
+                }
+
+                if (!resampler && !converter && !mixer) {
+                    (void)jitter_buffer.pop_next(region.first, region.second);
+                    ringbuffer.commit_write(packet_payload_size);
+                    continue;
+                }
+
+                if (primary) {
+                    (void)jitter_buffer.pop_next(pop_scratch);
+                }
+                if (mixer) {
+                    (void)(primary ? mixer->mix(pop_scratch, *dl) : mixer->mix_over_silence(pop_scratch, *dl));
+                    if (!resampler && !converter) {
+                        const std::size_t head = std::min(packet_payload_size, region.first.size());
+                        std::memcpy(region.first.data(), pop_scratch.data(), head);
+                        if (head < packet_payload_size) {
+                            std::memcpy(region.second.data(), pop_scratch.data() + head, packet_payload_size - head);
+                        }
+                        ringbuffer.commit_write(packet_payload_size);
+                        continue;
+                    }
+                }
+                const double ratio = resample_ratio_cmd.load(std::memory_order_relaxed);
+                std::size_t frames = 0;
+                if (!converter) {
+                    frames = resampler->process(pop_scratch, ratio, region.first, region.second);
+                } else if (!resampler) {
+                    frames = converter->process(pop_scratch, region.first, region.second);
+                } else {
+                    const auto resampled = resampler->process(pop_scratch, ratio, resample_scratch, { });
+                    frames = converter->process(
+                        std::span<const std::byte> { resample_scratch }.first(resampled * server_audio_format.frame_bytes()),
+                        region.first, region.second);
+                }
+                ringbuffer.commit_write(frames * device_format.frame_bytes());
+            }
+        };
+
+        // Timer 模式：io_context 上的 steady_timer 逐 deadline 唤醒。
         asio::steady_timer jb_timer(ioc);
-        std::vector<std::byte> jb_pop_buf(packet_payload_size);
+        std::optional<std::chrono::steady_clock::time_point> jb_timer_deadline; // 按 deadline 请求的唤醒（轮询为空）
 
         std::function<void()> schedule_jb_pop;
         schedule_jb_pop = [&]() {
-            auto deadline = jitter_buffer.next_playout_deadline();
+            auto deadline = playout_deadline();
+            jb_timer_deadline.reset();
             if (!deadline) {
                 jb_timer.expires_after(std::chrono::milliseconds(10));
             } else {
@@ -271,6 +679,7 @@ struct ClientRuntime::Impl {
                     jb_timer.expires_after(std::chrono::milliseconds(1));
                 } else {
                     jb_timer.expires_at(*deadline);
+                    jb_timer_deadline = deadline;
                 }
             }
 
@@ -281,56 +690,192 @@ struct ClientRuntime::Impl {
 
                 // 一次性 pop 所有已过 deadline 的包（Windows 定时器粒度 ~15ms 会滞后多个 deadline）。
                 const auto now = std::chrono::steady_clock::now();
+                if (jb_timer_deadline) {
+                    diag_manager.record_wakeup_lateness(now - *jb_timer_deadline);
+                }
+                pop_due(now, now);
+                schedule_jb_pop();
+            });
+        };
 
-                while (!shutdown_requested_.load(std::memory_order_relaxed)) {
-                    const auto dl = jitter_buffer.next_playout_deadline();
-                    if (!dl || *dl > now) {
-                        break;
-                    }
+        // 调度线程模式：每次唤醒先把入口队列的包按原到达时刻入 JB，再批量出队，
+        // 返回下一块 deadline 作为绝对唤醒时刻。RB 满暂停出队时 1ms 后重试（同 Timer 模式）。
+        std::atomic<bool> jb_reset_requested { false }; // 原位重连：调度线程在取入口队列前 reset JB
+        const auto scheduler_tick = [&](std::chrono::steady_clock::time_point now)
+            -> std::optional<std::chrono::steady_clock::time_point> {
+            if (jb_reset_requested.load(std::memory_order_relaxed)
+                && jb_reset_requested.exchange(false, std::memory_order_acquire)) {
+                jitter_buffer.reset();
+            }
+            ingress->drain([&](const jitter::IngressQueue::Entry& e) {
+                jitter_buffer.push_at(e.sample_position, e.payload,
+                    std::chrono::steady_clock::time_point(
+                        std::chrono::duration_cast<std::chrono::steady_clock::duration>(e.arrival)));
+            });
+            const auto horizon = now + config::PLAYOUT_SCHEDULER_BATCH_WINDOW;
+            pop_due(now, horizon);
+            const auto next = playout_deadline();
+            if (!next) {
+                return std::nullopt;
+            }
+            return *next > horizon ? *next : now + std::chrono::milliseconds(1);
+        };
+        const auto scheduler_lateness = [&diag_manager](std::chrono::nanoseconds lateness) {
+            diag_manager.record_wakeup_lateness(lateness);
+        };
+        std::unique_ptr<PlayoutScheduler> scheduler;
+        if (thread_mode) {
+            scheduler = std::make_unique<PlayoutScheduler>(scheduler_tick, scheduler_lateness);
+        }
 
-                    // RingBuffer 没有空间时停止 pop，保留包在 JitterBuffer 中。
-                    // （WASAPI 未启动时 RB 满属正常；长时间断流的 timeline reset
-                    //  已下沉到 JitterBuffer::pop_next 内部，仅在真正 pop 时触发。）
-                    if (ringbuffer.available_write() < packet_payload_size) {
-                        break;
-                    }
+        // Timer 模式的出队定时器链只启动一次（首个 HELLO_ACK / 回放开始；原位重连的握手不再启动）。
+        // io 线程独占。
+        bool jb_pop_started = false;
+        const auto start_jb_pop_once = [&] {
+            if (!std::exchange(jb_pop_started, true)) {
+                schedule_jb_pop();
+            }
+        };
 
-                    const auto lateness = std::chrono::duration_cast<std::chrono::microseconds>(now - *dl);
+        // 原位重连：新链路的首个 HELLO 之前调用（新流的包不会早于它到达），由 JB 所属线程
+        // 丢弃旧时间线（reset 保留已学习的 target），诊断的到达 / 速率回归按新流重新起算。
+        const auto restart_stream = [&] {
+            if (pull_playout) {
+                pull_playout->request_reset();
+            } else if (thread_mode) {
+                jb_reset_requested.store(true, std::memory_order_release);
+            }
+            asio::post(ioc, [&] {
+                if (!ingress) {
+                    jitter_buffer.reset(); // Timer 模式：JB 属于 io 线程
+                }
+                diag_manager.restart_stream();
+            });
+        };
 
-                    if (lateness > packet_duration_us) {
-                        diag_manager.record_deadline_miss();
-                    }
+        // ---- 数据面抓包（--capture-file）----
+        // io 线程只把 datagram 拷进无锁缓冲，落盘在 CaptureWriter 自己的线程。
+        // 析构（stop）晚于下方 ioc_thread 的 join，不与接收回调并发。
+        std::unique_ptr<net::CaptureWriter> capture;
+        if (!cfg.capture_path.empty()) {
+            const auto path = session_index == 0
+                ? cfg.capture_path
+                : cfg.capture_path + "." + std::to_string(session_index);
+            capture = std::make_unique<net::CaptureWriter>(path, config::CAPTURE_RINGBUFFER_BYTES);
+            if (!capture->start({ server_audio_format, session_id })) {
+                set_last_error("failed to open capture file '" + path + "'");
+                grpc_client.disconnect(session_id);
+                release_mix();
+                return SessionOutcome::Fatal;
+            }
+        }
 
-                    (void)jitter_buffer.pop_next(
-                        std::span<std::byte> { jb_pop_buf.data(), jb_pop_buf.size() });
-                    ringbuffer.write(std::span<const std::byte> { jb_pop_buf.data(), packet_payload_size });
+        // 已接入附加源的 io 线程视图（收包分流 / 保活 / ACK 匹配）：只在 io 线程读写，
+        // 会话线程接入 / 重连时经 asio::post 增改（publish_mix_route），收包路径无锁。
+        struct MixRoute {
+            std::size_t source; // cfg.mix_sources 下标
+            std::size_t stream; // StreamMixer 流索引
+            asio::ip::udp::endpoint endpoint;
+            std::uint64_t resume_token;
+            bool acked = false; // 首个 HELLO_ACK 已记日志
+        };
+        std::vector<MixRoute> mix_routes;
+        mix_routes.reserve(mix_links.size());
+        // 附加源最近一次收到音频（io 线程写）/ 扩展 HELLO 被服务端拒绝（令牌失效，io 线程置位）：
+        // 会话线程据此判断断流并重新 Connect。
+        std::array<std::atomic<std::int64_t>, config::MIX_MAX_SOURCES> mix_last_audio_ns { };
+        std::array<std::atomic<bool>, config::MIX_MAX_SOURCES> mix_rejected { };
+        const auto find_mix_route = [&](const asio::ip::udp::endpoint& sender) -> MixRoute* {
+            for (auto& m : mix_routes) {
+                if (m.endpoint == sender) {
+                    return &m;
                 }
-
-                schedule_jb_pop();
-            });
+            }
+            return nullptr;
         };
 
         // ---- UDP 接收回调 ----
-        transport.start_receive([&](const asio::ip::udp::endpoint& /*sender*/,
-                                    std::span<const std::byte> data) {
+        // 零拷贝：直接收进 JB 的备用缓冲，音频包 push 时只交换缓冲索引。
+        // 回放源与 UdpTransport 共用同一回调与缓冲提供方，JB 之后的路径完全一致。
+        // 附加源的包按发送端端点分流到混音级（拷入其入口队列），不计入主流诊断与断流检测。
+        const auto on_datagram = [&](const asio::ip::udp::endpoint& sender, std::span<const std::byte> data) {
+            const auto arrival = std::chrono::steady_clock::now();
+            if (capture) {
+                capture->record(data, arrival);
+            }
+
             const auto type = net::peek_type(data);
             if (!type) {
                 log_debug_fmt("UDP recv unknown packet type ({} bytes)", data.size());
                 return;
             }
 
+            if (MixRoute* m = mix_routes.empty() ? nullptr : find_mix_route(sender)) {
+                const auto& source = cfg.mix_sources[m->source];
+                if (*type == net::PacketType::HelloAck) {
+                    const auto ack = net::decode_hello(data);
+                    auto& session = mix_session_ids[m->source];
+                    if (!ack) {
+                        return;
+                    }
+                    if (ack->session_id == net::kResumeRejectedSessionId) {
+                        mix_rejected[m->source].store(true, std::memory_order_relaxed);
+                    } else if (const auto rejoin_token = net::decode_hello_ack_rejoin_token(data)) {
+                        // 服务端凭令牌经 UDP 新建了 session：同一服务端实例，换用新 id / 令牌，流不变。
+                        session.store(ack->session_id, std::memory_order_relaxed);
+                        m->resume_token = *rejoin_token;
+                        log_info_fmt("Mix source {}:{} rejoined over UDP (session=0x{:08X})",
+                            source.server_ip, source.server_rpc_port, ack->session_id);
+                    } else if (ack->session_id == session.load(std::memory_order_relaxed) && !m->acked) {
+                        m->acked = true;
+                        log_info_fmt("Mix source {}:{} HELLO_ACK received", source.server_ip, source.server_rpc_port);
+                        // 主流尚未握手（服务器未起 / 首次握手失败后原位重连）时附加流也须有出队节拍
+                        if (!pull_mode && !thread_mode) {
+                            asio::post(ioc, start_jb_pop_once);
+                        }
+                    }
+                } else if (*type == net::PacketType::Audio && playback_ready.load(std::memory_order_relaxed)) {
+                    if (const auto decoded = net::decode_audio(data)) {
+                        (void)mixer->push(m->stream, arrival.time_since_epoch(), decoded->header.sample_position,
+                            decoded->payload);
+                        mix_last_audio_ns[m->source].store(arrival.time_since_epoch().count(), std::memory_order_relaxed);
+                    }
+                }
+                return;
+            }
+
             if (*type == net::PacketType::HelloAck) {
                 const auto ack = net::decode_hello(data);
-                if (ack && ack->session_id == session_id) {
+                if (ack && ack->session_id == net::kResumeRejectedSessionId) {
+                    // 拒绝不带 session 可校验：只认当前服务端端点发来的，任意来源的伪造包不能打断快速恢复。
+                    if (sender == current_link().endpoint) {
+                        resume_rejected.store(true, std::memory_order_relaxed);
+                    }
+                } else if (const auto rejoin_token = net::decode_hello_ack_rejoin_token(data); ack && rejoin_token) {
+                    // 服务端凭令牌经 UDP 新建了 session：同样只认当前服务端端点。
+                    std::lock_guard<std::mutex> lock(link_mutex);
+                    if (sender == link.endpoint) {
+                        pending_rejoin = LinkTarget { ack->session_id, link.endpoint, *rejoin_token };
+                    }
+                } else if (ack && ack->session_id == current_link().session_id) {
                     // 收到 ACK：重置保活丢 ACK 计数（io_context 线程独占，无并发）。
                     consecutive_missed_acks = 0;
                     keepalive_loss_warned = false;
 
                     const bool was_acked = hello_acked.exchange(true, std::memory_order_relaxed);
                     if (!was_acked) {
+                        startup.mark(diag::StartupStage::HelloAcked);
+                        // 空临界区：等待方检查谓词与进入等待之间置位不会丢唤醒。
+                        {
+                            std::lock_guard<std::mutex> lock(handshake_mutex);
+                        }
+                        handshake_cv.notify_all();
                         log_info("UDP HELLO_ACK received, channel established");
-                        // 首个 HELLO_ACK 到达时立即启动 JitterBuffer 调度器。
-                        asio::post(ioc, [&] { schedule_jb_pop(); });
+                        // 首个 HELLO_ACK 到达时立即启动 JitterBuffer 调度器
+                        // （拉模式由设备回调出队，调度线程模式已在收包前启动）。
+                        if (!pull_mode && !thread_mode) {
+                            asio::post(ioc, start_jb_pop_once);
+                        }
                     }
                     diag_manager.record_hello_ack_received();
                     diag_manager.record_hello_ack();
@@ -342,68 +887,94 @@ struct ClientRuntime::Impl {
                     if (!playback_ready.load(std::memory_order_relaxed)) {
                         return;
                     }
+                    startup.mark(diag::StartupStage::FirstAudio);
 
-                    jitter_buffer.push(decoded->header.sequence, decoded->payload);
+                    // 按样本位置入 JB：包长可逐包变化（sequence 只用于诊断的丢包/乱序统计）。
+                    // 拉模式 / 调度线程模式经入口队列交给出队线程入 JB（队满丢弃计入 ingress->dropped()）。
+                    if (ingress) {
+                        (void)ingress->push(arrival.time_since_epoch(), decoded->header.sample_position,
+                            decoded->payload);
+                    } else {
+                        jitter_buffer.push_at(decoded->header.sample_position, decoded->payload);
+                    }
 
                     diag_manager.record_packet_arrival(decoded->header.sequence,
                         decoded->header.sample_position);
                     diag_manager.record_audio_bytes(decoded->payload.size());
 
-                    last_audio_recv_ns.store(
-                        std::chrono::steady_clock::now().time_since_epoch().count(),
-                        std::memory_order_relaxed);
+                    last_audio_recv_ns.store(arrival.time_since_epoch().count(), std::memory_order_relaxed);
                 } else {
                     log_debug_fmt("Failed to decode Audio packet ({} bytes)", data.size());
                 }
             }
-        });
+        };
+        // 调度线程先于收包启动：时间线建立前按空闲间隔轮询入口队列。
+        if (scheduler) {
+            scheduler->start(thread_policy(config::ThreadRole::Scheduler), &thread_policy_report_);
+            log_info_fmt("Playout scheduler thread started (batch window {}us)",
+                config::PLAYOUT_SCHEDULER_BATCH_WINDOW.count());
+        }
+
+        // 零拷贝接收：Timer 模式收进 JB 备用缓冲，拉模式 / 调度线程模式收进入口队列的空槽。
+        const auto receive_buffer = [&] {
+            return ingress ? ingress->receive_buffer() : jitter_buffer.receive_buffer();
+        };
+        if (replaying) {
+            replay_source.set_receive_buffer_provider(receive_buffer);
+            // 无握手：直接视为通道已建立，启动 JB 调度器；回放在播放就绪后开始。
+            hello_acked.store(true, std::memory_order_relaxed);
+            if (!pull_mode && !thread_mode) {
+                asio::post(ioc, start_jb_pop_once);
+            }
+        } else {
+            transport.set_receive_buffer_provider(receive_buffer);
+            transport.start_receive(on_datagram);
+        }
 
         std::thread ioc_thread([&] {
+            rt::apply_current_thread_policy(config::ThreadRole::Io, thread_policy(config::ThreadRole::Io),
+                &thread_policy_report_);
             ioc.run();
         });
 
-        // ---- 发送 HELLO 直到收到 HELLO_ACK 或超时 ----
-        std::array<std::byte, sizeof(net::HelloPacket)> hello_buf { };
-        const auto hello_written = net::encode_hello(session_id, hello_buf);
+        // 向链路发送一次 HELLO（握手 / 保活 / 原位重连共用；HELLO 按链路当前 session_id 编码）。
+        // 有恢复令牌时一律发扩展 HELLO：服务端 session 短暂超时后，下一次保活即可把它恢复。
+        // 附加源的 HELLO 不计入主链路的 HELLO 诊断（record_diag = false）。
+        const auto send_hello = [&](const LinkTarget& target, bool record_diag = true) {
+            std::array<std::byte, sizeof(net::HelloResumePacket)> hello_buf { };
+            const auto hello_written = target.resume_token != 0
+                ? net::encode_hello_resume(target.session_id, target.resume_token, hello_buf)
+                : net::encode_hello(target.session_id, hello_buf);
+            if (record_diag) {
+                diag_manager.record_hello_sent();
+            }
+            transport.send(target.endpoint, std::span<const std::byte> { hello_buf.data(), hello_written });
+        };
 
+        // ---- UDP 握手：首个 HELLO 立即发出，设备启动与其往返重叠 ----
+        // 之后在 handshake_cv 上等待 ACK（事件驱动，到达即唤醒）；未到时按 HELLO_HANDSHAKE_INITIAL_RETRY
+        // 起倍增的间隔重发，总时限 HELLO_HANDSHAKE_TIMEOUT。回放无握手（hello_acked 已置位）。
         int hello_attempts = 0;
-        while (!shutdown_requested_.load(std::memory_order_relaxed)
-            && !hello_acked.load(std::memory_order_relaxed)) {
-            if (++hello_attempts > config::HELLO_HANDSHAKE_MAX_ATTEMPTS) {
-                break;
+        auto next_hello_retry = std::chrono::steady_clock::now();
+        const auto handshake_deadline = next_hello_retry + config::HELLO_HANDSHAKE_TIMEOUT;
+        // 附加源接入时立即发首个 HELLO（publish_mix_route），之后随保活发送（io 线程）；附加源不影响会话成败。
+        const auto send_mix_hellos = [&] {
+            for (const auto& m : mix_routes) {
+                send_hello({ mix_session_ids[m.source].load(std::memory_order_relaxed), m.endpoint, m.resume_token },
+                    false);
             }
-            log_debug_fmt("Sending HELLO attempt {}/{} to {}",
-                hello_attempts, config::HELLO_HANDSHAKE_MAX_ATTEMPTS,
-                cfg.server_ip);
-            diag_manager.record_hello_sent();
-            transport.send(server_udp_endpoint,
-                std::span<const std::byte> { hello_buf.data(), hello_written });
-            std::this_thread::sleep_for(config::HELLO_HANDSHAKE_RETRY_INTERVAL);
+        };
+        const auto send_handshake_hello = [&](std::chrono::steady_clock::time_point now) {
+            ++hello_attempts;
+            log_debug_fmt("Sending HELLO attempt {} to {}", hello_attempts, cfg.server_ip);
+            send_hello(link);
+            next_hello_retry = now + hello_retry_delay(hello_attempts);
+        };
+        if (!replaying) {
+            send_handshake_hello(next_hello_retry);
         }
 
-        if (!hello_acked.load(std::memory_order_relaxed)) {
-            set_last_error("UDP HELLO_ACK timeout (server reachable but UDP handshake failed)");
-            log_error_fmt("UDP HELLO_ACK timeout ({} attempts, {}ms)",
-                hello_attempts,
-                hello_attempts * config::HELLO_HANDSHAKE_RETRY_INTERVAL.count());
-            transport.stop();
-            ioc.stop();
-            ioc_thread.join();
-            grpc_client.disconnect(session_id);
-            return SessionOutcome::Retryable;
-        }
-
-        // ---- WASAPI Playback ----
-        auto playback = audio::create_playback_backend();
-        if (!playback) {
-            set_last_error("no audio playback backend available");
-            log_error("no audio playback backend available");
-            transport.stop();
-            ioc.stop();
-            ioc_thread.join();
-            grpc_client.disconnect(session_id);
-            return SessionOutcome::Fatal;
-        }
+        // ---- Playback（后端已在会话开始时创建并协商格式）----
 
         // 启动水位（pre-roll latch）：RB 是 1:1 直通管道，稳态占用 = 起跑点。
         // 若 fill 回调从空缓冲就开始消费，RB 永远在空附近运行，拉大容量无济于事。
@@ -432,52 +1003,144 @@ struct ClientRuntime::Impl {
         constexpr std::uint32_t low_water_rearm_samples = 6;
         const std::size_t low_watermark_bytes = preroll_watermark - preroll_watermark / 4;
 
-        if (!playback->start(server_audio_format, [&](std::span<std::byte> out) -> std::size_t {
-                // 水位检查：闩锁打开后零开销；重臂后再次生效。
-                if (!preroll_done.load(std::memory_order_relaxed)) {
-                    if (ringbuffer.available_read() < preroll_watermark) {
-                        return 0; // 静音等待，不计 underrun，不计消费
-                    }
-                    log_info_fmt("Playback pre-roll complete: {} bytes buffered (watermark {})",
-                        ringbuffer.available_read(), preroll_watermark);
-                    preroll_done.store(true, std::memory_order_relaxed);
-                    starved_callbacks.store(0, std::memory_order_relaxed);
-                }
-                const auto got = ringbuffer.read(out);
-                if (got < out.size()) {
-                    diag_manager.record_underrun();
-                    // 仅"完全空仓"计饥饿（部分填充说明供给未中断，不累加也不清零）。
-                    if (got == 0
-                        && starved_callbacks.fetch_add(1, std::memory_order_relaxed) + 1
-                            >= starved_rearm_callbacks) {
-                        preroll_done.store(false, std::memory_order_relaxed);
-                        diag_manager.record_rb_rearm();
-                        log_info_fmt("Playback buffer starved {} consecutive callbacks, "
-                                     "re-arming pre-roll latch",
-                            starved_rearm_callbacks);
-                    }
-                } else {
-                    starved_callbacks.store(0, std::memory_order_relaxed);
+        // 设备缓冲预算 = RB 半水位时长（稳态运行点）：设备侧再缓冲同量级即可吸收调度抖动，
+        // 更大只会线性抬高端到端延迟。仅 ALSA 采用；共享模式后端忽略。
+        // 设备 xrun 与 fill 不足同走 record_underrun（同一欠载指标）。
+        // 拉模式无 RB 运行点，改用固定预算 PULL_PLAYOUT_DEVICE_BUFFER。
+        playback->set_latency_hint(pull_mode
+                ? std::chrono::duration_cast<std::chrono::microseconds>(config::PULL_PLAYOUT_DEVICE_BUFFER)
+                : std::chrono::microseconds(static_cast<std::int64_t>(preroll_watermark / bytes_per_ms * 1000.0)));
+        playback->set_underrun_callback(audio::PlaybackBackend::UnderrunCallback::bind<
+            &diag::DiagnosticsManager::record_underrun>(diag_manager));
+
+        // 播放线程由后端创建：首次 fill 回调时对当前线程应用一次 Playback 策略。
+        std::atomic<bool> playback_policy_pending { true };
+        const auto apply_playback_policy_once = [&] {
+            if (playback_policy_pending.load(std::memory_order_relaxed)
+                && playback_policy_pending.exchange(false, std::memory_order_relaxed)) {
+                rt::apply_current_thread_policy(config::ThreadRole::Playback,
+                    thread_policy(config::ThreadRole::Playback), &thread_policy_report_);
+            }
+        };
+
+        // 拉模式：起播前 / 首块 deadline 前 fill 输出静音（不计欠载），无预蓄水闩锁与重臂。
+        const auto pull_fill = [&](std::span<std::byte> out) -> std::size_t {
+            apply_playback_policy_once();
+            const auto r = pull_playout->fill(out);
+            if (r.bytes > 0) {
+                startup.mark(diag::StartupStage::FirstAudible);
+            }
+            for (std::uint32_t i = 0; i < r.deadline_misses; ++i) {
+                diag_manager.record_deadline_miss();
+            }
+            if (r.underrun) {
+                diag_manager.record_underrun();
+            }
+            played_samples.fetch_add(out.size() / device_format.frame_bytes(), std::memory_order_relaxed);
+            return r.bytes;
+        };
+
+        const auto timer_fill = [&](std::span<std::byte> out) -> std::size_t {
+            apply_playback_policy_once();
+            // 水位检查：闩锁打开后零开销；重臂后再次生效。
+            if (!preroll_done.load(std::memory_order_relaxed)) {
+                if (ringbuffer.available_read() < preroll_watermark) {
+                    return 0; // 静音等待，不计 underrun，不计消费
                 }
-                // 整个 out 缓冲都会被播放（含静音填充），累加已播放样本数。
-                played_samples.fetch_add(out.size() / server_audio_format.frame_bytes(),
-                    std::memory_order_relaxed);
-                return got;
-            })) {
+                log_info_fmt("Playback pre-roll complete: {} bytes buffered (watermark {})",
+                    ringbuffer.available_read(), preroll_watermark);
+                preroll_done.store(true, std::memory_order_relaxed);
+                starved_callbacks.store(0, std::memory_order_relaxed);
+                startup.mark(diag::StartupStage::FirstAudible);
+            }
+            const auto got = ringbuffer.read(out);
+            if (got < out.size()) {
+                diag_manager.record_underrun();
+                // 仅"完全空仓"计饥饿（部分填充说明供给未中断，不累加也不清零）。
+                if (got == 0
+                    && starved_callbacks.fetch_add(1, std::memory_order_relaxed) + 1
+                        >= starved_rearm_callbacks) {
+                    preroll_done.store(false, std::memory_order_relaxed);
+                    diag_manager.record_rb_rearm();
+                    log_info_fmt("Playback buffer starved {} consecutive callbacks, "
+                                 "re-arming pre-roll latch",
+                        starved_rearm_callbacks);
+                }
+            } else {
+                starved_callbacks.store(0, std::memory_order_relaxed);
+            }
+            // 整个 out 缓冲都会被播放（含静音填充），累加已播放样本数。
+            played_samples.fetch_add(out.size() / device_format.frame_bytes(),
+                std::memory_order_relaxed);
+            return got;
+        };
+
+        if (!playback->start(device_format,
+                pull_mode ? audio::PlaybackBackend::FillCallback(pull_fill)
+                          : audio::PlaybackBackend::FillCallback(timer_fill))) {
             set_last_error("failed to start audio playback (see log above for details)");
             log_error("failed to start audio playback (see log above for details)");
             transport.stop();
             ioc.stop();
             ioc_thread.join();
             grpc_client.disconnect(session_id);
+            release_mix();
             return SessionOutcome::Fatal;
         }
+        startup.mark(diag::StartupStage::PlaybackStarted);
 
-        log_info("Playback started with server audio format");
+        log_info_fmt("Playback started: {}ch {}Hz encoding={}",
+            device_format.channels, device_format.sample_rate, static_cast<int>(device_format.encoding));
         playback_ready.store(true, std::memory_order_relaxed);
-        set_state(ClientState::Playing);
+
+        // ---- 等待 HELLO_ACK（设备启动期间 ACK 可能已到）----
+        {
+            std::unique_lock<std::mutex> lock(handshake_mutex);
+            while (!shutdown_requested_.load(std::memory_order_relaxed)
+                && !hello_acked.load(std::memory_order_relaxed)) {
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= handshake_deadline) {
+                    break;
+                }
+                if (now >= next_hello_retry) {
+                    lock.unlock();
+                    send_handshake_hello(now);
+                    lock.lock();
+                    continue;
+                }
+                // shutdown() 不通知条件变量：等待不超过 POLL_INTERVAL 以便及时退出。
+                handshake_cv.wait_until(lock, std::min({ next_hello_retry, handshake_deadline, now + POLL_INTERVAL }));
+            }
+        }
+
+        // 原位重连开启时首次握手超时不结束会话：播放后端、RB / JB 已就绪，转入下方重连状态机
+        // （新建服务端会话 + 重发 HELLO），不经 session_loop 退避重建整条管线。
+        const bool reconnect_in_place = cfg.auto_reconnect && !replaying;
+        const bool initial_handshake_failed = !hello_acked.load(std::memory_order_relaxed);
+        if (initial_handshake_failed && reconnect_in_place) {
+            log_warn_fmt("UDP HELLO_ACK timeout ({} attempts, {}ms), reconnecting in place",
+                hello_attempts, config::HELLO_HANDSHAKE_TIMEOUT.count());
+        } else if (initial_handshake_failed) {
+            set_last_error("UDP HELLO_ACK timeout (server reachable but UDP handshake failed)");
+            log_error_fmt("UDP HELLO_ACK timeout ({} attempts, {}ms)",
+                hello_attempts, config::HELLO_HANDSHAKE_TIMEOUT.count());
+            playback->stop();
+            transport.stop();
+            ioc.stop();
+            ioc_thread.join();
+            grpc_client.disconnect(session_id);
+            release_mix();
+            return SessionOutcome::Retryable;
+        }
+
+        if (replaying) {
+            replay_source.start(on_datagram);
+        }
+        if (!initial_handshake_failed) {
+            set_state(ClientState::Playing);
+        }
         // 重置音频超时计时器：HELLO 握手 + playback 初始化可能消耗大部分
-        // CLIENT_AUDIO_RECV_TIMEOUT，从 playback 就绪时刻重新计时。
+        // CLIENT_AUDIO_RECV_TIMEOUT，从握手完成时刻重新计时。
         last_audio_recv_ns.store(
             std::chrono::steady_clock::now().time_since_epoch().count(),
             std::memory_order_relaxed);
@@ -491,8 +1154,9 @@ struct ClientRuntime::Impl {
                 if (ec || shutdown_requested_.load(std::memory_order_relaxed)) {
                     return;
                 }
+                const auto target = current_link();
                 log_trace_fmt("HELLO keepalive sent to {}:{} (session=0x{:08X})",
-                    cfg.server_ip, connect_result.udp_port, session_id);
+                    cfg.server_ip, target.endpoint.port(), target.session_id);
                 // 连续未收到 ACK 计数：早于音频超时暴露服务器已断。
                 ++consecutive_missed_acks;
                 if (!keepalive_loss_warned
@@ -502,23 +1166,199 @@ struct ClientRuntime::Impl {
                         consecutive_missed_acks,
                         consecutive_missed_acks * config::HELLO_KEEPALIVE_INTERVAL.count());
                 }
-                diag_manager.record_hello_sent();
-                transport.send(server_udp_endpoint,
-                    std::span<const std::byte> { hello_buf.data(), hello_written });
+                send_hello(target);
+                send_mix_hellos();
                 schedule_keepalive();
             });
         };
-        schedule_keepalive();
+        if (!replaying) {
+            schedule_keepalive();
+        }
+
+        // ---- 附加源接入 / 重连（会话线程，主循环每拍调用）----
+        // 后台 Connect 完成即接入：首次分配混音流，重连沿用同一路流（JB 按新时间线自行重置）；
+        // 链路经 publish_mix_route 交给 io 线程（同时发出首个 HELLO）。连不上的源、断流超过
+        // MIX_SOURCE_RECONNECT_GAP 或令牌被拒（服务端已重启）的源按保活节拍重新 Connect。
+        const auto publish_mix_route = [&](MixRoute route, std::uint32_t session) {
+            asio::post(ioc, [&, route, session] {
+                // 在 io 线程上再写一次 session：覆盖同一时刻旧链路的 UDP 重新入会。
+                mix_session_ids[route.source].store(session, std::memory_order_relaxed);
+                const auto it = std::ranges::find(mix_routes, route.source, &MixRoute::source);
+                if (it != mix_routes.end()) {
+                    *it = route;
+                } else {
+                    mix_routes.push_back(route);
+                }
+                send_hello({ session, route.endpoint, route.resume_token }, false);
+            });
+        };
+        const auto drop_mix_route = [&](std::size_t source) {
+            asio::post(ioc, [&, source] { std::erase_if(mix_routes, [&](const MixRoute& r) { return r.source == source; }); });
+        };
+        const auto attach_mix = [&](MixLink& m, LinkConnect c, std::chrono::steady_clock::time_point now) {
+            const auto& source = cfg.mix_sources[m.source];
+            const auto& fmt = c.result.audio_format;
+            asio::ip::udp::endpoint endpoint;
+            try {
+                endpoint = { asio::ip::make_address(source.server_ip), c.result.udp_port };
+            } catch (const std::exception& e) {
+                log_warn_fmt("Mix source '{}' has invalid IP address: {}", source.server_ip, e.what());
+            }
+            const char* skip_reason = nullptr;
+            if (!fmt.valid() || endpoint.port() == 0) {
+                skip_reason = "invalid format or address";
+            } else if (fmt.sample_rate != server_audio_format.sample_rate) {
+                skip_reason = "sample rate differs from primary server";
+            } else if (m.stream && fmt != m.format) {
+                skip_reason = "audio format changed after reconnect";
+            } else if (endpoint == current_link().endpoint
+                || std::ranges::any_of(mix_links, [&](const MixLink& other) {
+                       return &other != &m && other.connected && other.endpoint == endpoint;
+                   })) {
+                skip_reason = "same UDP endpoint as another stream";
+            }
+            if (skip_reason) {
+                log_warn_fmt("Mix source {}:{} disabled: {}", source.server_ip, source.server_rpc_port, skip_reason);
+                (void)c.client.disconnect(c.result.session_id);
+                if (m.connected) {
+                    drop_mix_route(m.source);
+                    m.connected.reset();
+                }
+                m.disabled = true;
+                return;
+            }
+
+            const bool reconnect = m.stream.has_value();
+            if (!reconnect) {
+                m.stream = mixer->add_stream({ fmt, source.gain, jb_floor_packets, jitter_capacity,
+                    detect_window_packets, adapt_cfg, rt_cfg.plc_mode });
+                m.format = fmt;
+            }
+            m.endpoint = endpoint;
+            m.unreachable_logged = false;
+            mix_session_ids[m.source].store(c.result.session_id, std::memory_order_relaxed);
+            mix_last_audio_ns[m.source].store(now.time_since_epoch().count(), std::memory_order_relaxed);
+            mix_rejected[m.source].store(false, std::memory_order_relaxed);
+            publish_mix_route({ m.source, *m.stream, endpoint, c.result.resume_token }, c.result.session_id);
+            log_info_fmt("{} server {}:{} (session=0x{:08X}, {}ch encoding={}, gain={:.2f})",
+                reconnect ? "Reconnected mix" : "Mixing", source.server_ip, source.server_rpc_port,
+                c.result.session_id, fmt.channels, static_cast<int>(fmt.encoding), source.gain);
+            m.connected = std::move(c);
+        };
+        const auto service_mix = [&](std::chrono::steady_clock::time_point now) {
+            for (auto& m : mix_links) {
+                if (m.disabled) {
+                    continue;
+                }
+                const auto& source = cfg.mix_sources[m.source];
+                if (m.pending.valid()) {
+                    if (m.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                        continue;
+                    }
+                    if (auto connected = m.pending.get()) {
+                        attach_mix(m, std::move(*connected), now);
+                    } else {
+                        if (!m.unreachable_logged) {
+                            m.unreachable_logged = true;
+                            log_warn_fmt("Mix source {}:{} unreachable, retrying every {}s",
+                                source.server_ip, source.server_rpc_port, config::HELLO_KEEPALIVE_INTERVAL.count());
+                        }
+                        m.next_connect_at = now + config::HELLO_KEEPALIVE_INTERVAL;
+                    }
+                    continue;
+                }
+                if (now < m.next_connect_at) {
+                    continue;
+                }
+                std::uint32_t stale_session = 0;
+                if (m.connected) {
+                    const auto last_audio = std::chrono::steady_clock::time_point(
+                        std::chrono::steady_clock::duration(mix_last_audio_ns[m.source].load(std::memory_order_relaxed)));
+                    const bool rejected = mix_rejected[m.source].exchange(false, std::memory_order_relaxed);
+                    if (!rejected && now - last_audio <= config::MIX_SOURCE_RECONNECT_GAP) {
+                        continue;
+                    }
+                    stale_session = mix_session_ids[m.source].load(std::memory_order_relaxed);
+                    log_warn_fmt("Mix source {}:{} {}, reconnecting", source.server_ip, source.server_rpc_port,
+                        rejected ? "rejected the resume token" : "stopped sending audio");
+                }
+                begin_mix_connect(m, stale_session);
+            }
+        };
 
         // ---- 等待退出（主循环健康监控）----
         log_info("Client running. Press Ctrl+C to stop.");
 
         auto last_stats_time = std::chrono::steady_clock::now();
         auto last_rb_sample_time = last_stats_time;
+        auto last_drift_update_time = last_stats_time;
+        // RB 回路设定点 = pre-roll 水位：与闩锁 / 低水位看门狗同一运行点。
+        // 拉模式以 PullPlayout::backlog_ms 为占用输入，设定点 0（每块恰在 deadline 开始播放）。
+        DriftCompensator drift_compensator(pull_mode ? 0.0 : static_cast<double>(preroll_watermark) / bytes_per_ms);
+        std::optional<double> sender_ppm; // RB_SAMPLE_INTERVAL 刷新（回归 ~600 点，不必每拍算）
+        std::optional<std::chrono::steady_clock::time_point> replay_finished_at;
+        bool startup_logged = false;
+
+        // ---- 原位重连（auto_reconnect，非回放）----
+        // 断流 CLIENT_RECONNECT_GAP 后在本会话内重建服务端会话：后台 gRPC Connect（先 best-effort
+        // Disconnect 旧会话），格式不变则换链路、重发 HELLO。播放后端、RB / JB（含已学习的 target）、
+        // 诊断计数器全部保留；间隙内 JB 照常出队（PLC 渐隐到静音），拉模式输出静音。
+        // 服务端恢复后的可闻间隙 ≈ 一次 Connect + HELLO 往返 + JB target，而非整会话重建的数秒。
+        // 格式变化时以 FormatChanged 结束会话，由 session_loop 立即按新格式重建。
+        // 持有恢复令牌时先走 UDP 快速恢复（扩展 HELLO，同一 session、同一条流，JB / 诊断无需重启）：
+        // 服务端仍认得该 session 时一个 RTT 即恢复；被拒绝或无应答才改走 gRPC Connect。
+        enum class LinkState {
+            Up, // 链路正常（或断流未达阈值）
+            Resuming, // 扩展 HELLO 快速恢复中（不经 gRPC）
+            Connecting, // 后台 gRPC Connect 进行中 / 等待重试
+            Handshaking, // 新会话已建立，等待 HELLO_ACK
+        };
+        LinkState link_state = LinkState::Up;
+        std::future<std::optional<LinkConnect>> pending_connect;
+        std::vector<std::uint32_t> stale_sessions; // 待 Disconnect 的旧会话（下一次连上服务端时清理）
+        std::chrono::milliseconds retry_delay = config::CLIENT_RECONNECT_RETRY_INITIAL;
+        std::chrono::steady_clock::time_point next_connect_at { };
+        std::chrono::steady_clock::time_point gap_started { };
+        std::chrono::steady_clock::time_point next_hello_at { };
+        std::chrono::steady_clock::time_point relink_handshake_deadline { };
+        int relink_hello_attempts = 0;
+        int resume_attempts = 0;
+
+        const auto begin_connect = [&] {
+            pending_connect = std::async(std::launch::async,
+                [server_ip = cfg.server_ip, rpc_port = cfg.server_rpc_port, client_name = cfg.client_name,
+                    stale = stale_sessions]() -> std::optional<LinkConnect> {
+                    LinkConnect c;
+                    if (!c.client.connect_to_server(server_ip, rpc_port, config::CLIENT_RECONNECT_CONNECT_TIMEOUT)) {
+                        return std::nullopt;
+                    }
+                    for (const auto id : stale) {
+                        (void)c.client.disconnect(id);
+                    }
+                    if (!c.client.connect(client_name, c.result)) {
+                        return std::nullopt;
+                    }
+                    return c;
+                });
+        };
+        const auto schedule_retry = [&](std::chrono::steady_clock::time_point now) {
+            next_connect_at = now + retry_delay;
+            retry_delay = std::min(retry_delay * 2, config::CLIENT_RECONNECT_RETRY_MAX);
+            link_state = LinkState::Connecting;
+        };
+
+        if (initial_handshake_failed) {
+            // 首次握手未通：服务端会话作废，立即发起新的 Connect。
+            set_state(ClientState::Reconnecting);
+            gap_started = std::chrono::steady_clock::now();
+            stale_sessions.push_back(current_link().session_id);
+            next_connect_at = gap_started;
+            link_state = LinkState::Connecting;
+        }
 
         SessionOutcome outcome = SessionOutcome::CleanExit;
         while (!shutdown_requested_.load(std::memory_order_relaxed)) {
-            std::this_thread::sleep_for(POLL_INTERVAL);
+            std::this_thread::sleep_for(link_state == LinkState::Up ? POLL_INTERVAL : RELINK_POLL_INTERVAL);
 
             if (!playback->is_running()) {
                 log_error("Playback backend stopped unexpectedly, shutting down");
@@ -527,7 +1367,132 @@ struct ClientRuntime::Impl {
                 break;
             }
 
-            {
+            if (!mix_links.empty()) {
+                service_mix(std::chrono::steady_clock::now());
+            }
+
+            if (reconnect_in_place) {
+                const auto now = std::chrono::steady_clock::now();
+                const auto last_time = std::chrono::steady_clock::time_point(
+                    std::chrono::steady_clock::duration(last_audio_recv_ns.load(std::memory_order_relaxed)));
+
+                if (link_state == LinkState::Up && now - last_time > config::CLIENT_RECONNECT_GAP) {
+                    log_warn_fmt("No audio from server for {}ms, reconnecting in place "
+                                 "(playback device, buffers and learned jitter target kept)",
+                        std::chrono::duration_cast<std::chrono::milliseconds>(now - last_time).count());
+                    set_state(ClientState::Reconnecting);
+                    gap_started = last_time;
+                    retry_delay = config::CLIENT_RECONNECT_RETRY_INITIAL;
+                    if (current_link().resume_token != 0) {
+                        hello_acked.store(false, std::memory_order_relaxed);
+                        resume_rejected.store(false, std::memory_order_relaxed);
+                        (void)take_pending_rejoin();
+                        resume_attempts = 0;
+                        next_hello_at = now;
+                        link_state = LinkState::Resuming;
+                    } else {
+                        stale_sessions.push_back(current_link().session_id);
+                        next_connect_at = now;
+                        link_state = LinkState::Connecting;
+                    }
+                }
+
+                if (link_state == LinkState::Resuming) {
+                    if (hello_acked.load(std::memory_order_relaxed)) {
+                        log_info_fmt("Resumed session 0x{:08X} over UDP, {}ms since last audio",
+                            current_link().session_id,
+                            std::chrono::duration_cast<std::chrono::milliseconds>(now - gap_started).count());
+                        link_state = LinkState::Up;
+                        last_audio_recv_ns.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+                        set_state(ClientState::Playing);
+                    } else if (auto rejoin = take_pending_rejoin()) {
+                        // 同一服务端实例（令牌有效）：广播时间线连续，只换 session_id + 令牌，JB / 诊断无需重启。
+                        const auto stale_id = current_link().session_id;
+                        {
+                            std::lock_guard<std::mutex> lock(link_mutex);
+                            link = *rejoin;
+                        }
+                        hello_acked.store(true, std::memory_order_relaxed);
+                        log_info_fmt("Rejoined over UDP: new session 0x{:08X} (was 0x{:08X}), {}ms since last audio",
+                            rejoin->session_id, stale_id,
+                            std::chrono::duration_cast<std::chrono::milliseconds>(now - gap_started).count());
+                        link_state = LinkState::Up;
+                        last_audio_recv_ns.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+                        set_state(ClientState::Playing);
+                    } else if (resume_rejected.load(std::memory_order_relaxed)
+                        || (now >= next_hello_at && resume_attempts >= config::CLIENT_RESUME_ATTEMPTS)) {
+                        log_info_fmt("UDP session resume {}, falling back to gRPC Connect",
+                            resume_rejected.load(std::memory_order_relaxed) ? "rejected by server" : "unanswered");
+                        stale_sessions.push_back(current_link().session_id);
+                        next_connect_at = now;
+                        link_state = LinkState::Connecting;
+                    } else if (now >= next_hello_at) {
+                        ++resume_attempts;
+                        send_hello(current_link());
+                        next_hello_at = now + config::CLIENT_RESUME_RETRY_INTERVAL;
+                    }
+                }
+
+                if (link_state == LinkState::Connecting) {
+                    if (!pending_connect.valid() && now >= next_connect_at) {
+                        begin_connect();
+                    }
+                    if (pending_connect.valid()
+                        && pending_connect.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                        auto connected = pending_connect.get();
+                        if (!connected) {
+                            schedule_retry(now);
+                        } else {
+                            stale_sessions.clear();
+                            const auto& result = connected->result;
+                            if (result.audio_format != server_audio_format) {
+                                log_info_fmt("Server audio format changed to {}ch {}Hz encoding={}, rebuilding pipeline",
+                                    result.audio_format.channels, result.audio_format.sample_rate,
+                                    static_cast<int>(result.audio_format.encoding));
+                                (void)connected->client.disconnect(result.session_id);
+                                outcome = SessionOutcome::FormatChanged;
+                                break;
+                            }
+                            grpc_client = std::move(connected->client);
+                            {
+                                std::lock_guard<std::mutex> lock(link_mutex);
+                                link = { result.session_id, asio::ip::udp::endpoint(server_address, result.udp_port),
+                                    result.resume_token };
+                            }
+                            if (cb.on_format) {
+                                cb.on_format(server_audio_format);
+                            }
+                            hello_acked.store(false, std::memory_order_relaxed);
+                            restart_stream();
+                            relink_hello_attempts = 0;
+                            next_hello_at = now;
+                            relink_handshake_deadline = now + config::HELLO_HANDSHAKE_TIMEOUT;
+                            link_state = LinkState::Handshaking;
+                        }
+                    }
+                }
+
+                if (link_state == LinkState::Handshaking) {
+                    if (hello_acked.load(std::memory_order_relaxed)) {
+                        log_info_fmt("Reconnected in place: session=0x{:08X}, {}ms since last audio",
+                            current_link().session_id,
+                            std::chrono::duration_cast<std::chrono::milliseconds>(now - gap_started).count());
+                        link_state = LinkState::Up;
+                        last_audio_recv_ns.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+                        set_state(ClientState::Playing);
+                    } else if (now >= next_hello_at) {
+                        if (now >= relink_handshake_deadline) {
+                            log_warn_fmt("UDP HELLO_ACK timeout after reconnect ({} attempts), retrying",
+                                relink_hello_attempts);
+                            stale_sessions.push_back(current_link().session_id);
+                            schedule_retry(now);
+                        } else {
+                            send_hello(current_link());
+                            next_hello_at = now + hello_retry_delay(++relink_hello_attempts);
+                        }
+                    }
+                }
+            } else {
                 const auto now = std::chrono::steady_clock::now();
                 const auto last_ns = last_audio_recv_ns.load(std::memory_order_relaxed);
                 const auto last_time = std::chrono::steady_clock::time_point(
@@ -543,10 +1508,37 @@ struct ClientRuntime::Impl {
 
             const auto now = std::chrono::steady_clock::now();
 
+            // 首个非静音块交给设备：输出一次启动时间线（回放模式控制面阶段为 0）。
+            if (!startup_logged && startup.reached(diag::StartupStage::FirstAudible)) {
+                startup_logged = true;
+                const auto t = startup.times();
+                const auto at = [&t](diag::StartupStage stage) { return t[static_cast<std::size_t>(stage)]; };
+                log_info_fmt("Startup: first audible output at {:.1f}ms (channel={:.1f} connect={:.1f} udp={:.1f} "
+                             "device={:.1f} playback={:.1f} hello_ack={:.1f} first_audio={:.1f}ms)",
+                    at(diag::StartupStage::FirstAudible), at(diag::StartupStage::ChannelReady),
+                    at(diag::StartupStage::Connected), at(diag::StartupStage::UdpBound),
+                    at(diag::StartupStage::DeviceOpened), at(diag::StartupStage::PlaybackStarted),
+                    at(diag::StartupStage::HelloAcked), at(diag::StartupStage::FirstAudio));
+            }
+
+            // 回放读完：留出 JB / RB 排空时间后正常结束会话。
+            if (replaying && replay_source.finished()) {
+                if (!replay_finished_at) {
+                    replay_finished_at = now;
+                } else if (now - *replay_finished_at >= config::REPLAY_DRAIN_TIME) {
+                    log_info("Replay complete, stopping");
+                    break;
+                }
+            }
+
             // 高频采样 RB 占用到 slope 窗口（与日志输出解耦）。
             if (now - last_rb_sample_time >= RB_SAMPLE_INTERVAL) {
                 diag_manager.record_rb_occupancy();
+                diag_manager.record_device_delay(playback->device_delay_frames() + converter_delay_frames);
                 last_rb_sample_time = now;
+                if (resampler) {
+                    sender_ppm = diag_manager.sender_rate_ppm();
+                }
 
                 // 低水位看门狗（见声明处注释）：仅在闩锁打开（正常运行）时评估，
                 // 蓄水期（首启动 / 刚重臂）跳过。
@@ -570,10 +1562,46 @@ struct ClientRuntime::Impl {
                 }
             }
 
+            if (resampler) {
+                DriftCompensator::Measurement m;
+                m.jb_arrival_delay_ms = jitter_buffer.mean_arrival_delay_ms();
+                m.jb_timeline_epoch = jitter_buffer.timeline_epoch();
+                if (pull_playout) {
+                    m.rb_fill_ms = pull_playout->backlog_ms();
+                    m.playback_running = pull_playout->started();
+                } else {
+                    m.rb_fill_ms = static_cast<double>(ringbuffer.available_read()) / bytes_per_ms;
+                    m.playback_running = preroll_done.load(std::memory_order_relaxed);
+                }
+                m.sender_ppm = sender_ppm;
+                const auto& out = drift_compensator.update(m, now - last_drift_update_time);
+                last_drift_update_time = now;
+                if (pull_playout) {
+                    pull_playout->set_drift_command(out.jb_rate, out.resample_ratio);
+                } else {
+                    jb_rate_cmd.store(out.jb_rate, std::memory_order_relaxed);
+                    resample_ratio_cmd.store(out.resample_ratio, std::memory_order_relaxed);
+                }
+                diag_manager.record_drift_compensation(drift_compensator.jb_ppm(), drift_compensator.resample_ppm());
+            }
+
             // 周期性诊断刷新：collect_and_log 输出日志并更新快照缓存
             // （diagnostics() 即时返回快照，刷新频率由该常量决定，见 config.h）。
             if (now - last_stats_time >= config::DIAGNOSTICS_REFRESH_INTERVAL) {
+                const auto rt_status = thread_policy_report_.status();
+                diag_manager.record_thread_policy(rt_status.applied, rt_status.failures, rt_status.memory_locked);
+                diag_manager.record_startup(startup.times());
                 diag_manager.collect_and_log(jitter_buffer);
+                for (const auto& m : mix_links) {
+                    if (!m.stream) {
+                        continue;
+                    }
+                    const auto st = mixer->stats(*m.stream);
+                    log_debug_fmt("Mix {}:{}: recv={} lost={} late={} dropped={} mixed={} skipped={} fill={}/{}",
+                        cfg.mix_sources[m.source].server_ip, cfg.mix_sources[m.source].server_rpc_port,
+                        st.packets_received, st.packets_lost, st.late_packets, st.ingress_dropped,
+                        st.mixed_blocks, st.skipped_blocks, st.fill_packets, st.target_packets);
+                }
                 // 同步最新快照到缓存，供外部 diagnostics() 读取（跨线程用 mutex）。
                 {
                     std::lock_guard<std::mutex> lock(diag_mutex_);
@@ -584,10 +1612,20 @@ struct ClientRuntime::Impl {
         }
 
         log_info("Shutting down...");
+        if (scheduler) {
+            scheduler->stop();
+        }
         playback->stop();
 
         // 先通知 server 移除 session 并停止发包，再关闭本地 UDP（避免 ICMP 风暴）。
-        grpc_client.disconnect(session_id);
+        // 原位重连进行中则先等后台 Connect 结束，刚建立的会话一并移除。
+        if (pending_connect.valid()) {
+            if (auto connected = pending_connect.get()) {
+                (void)connected->client.disconnect(connected->result.session_id);
+            }
+        }
+        grpc_client.disconnect(current_link().session_id);
+        release_mix();
 
         transport.stop();
         ioc.stop();
@@ -595,6 +1633,9 @@ struct ClientRuntime::Impl {
         if (ioc_thread.joinable()) {
             ioc_thread.join();
         }
+        if (ingress && ingress->dropped() > 0) {
+            log_warn_fmt("Playout ingress queue dropped {} packets (queue full)", ingress->dropped());
+        }
 
         return outcome;
     }
@@ -627,13 +1668,19 @@ struct ClientRuntime::Impl {
                 break;
             }
 
-            // 非致命退出（CleanExit 或 Retryable）：
-            if (!cfg.auto_reconnect) {
-                // 非重连模式：自然退出（关闭请求或服务端已断，均非致命）。
+            // 非致命退出（CleanExit / Retryable / FormatChanged）：
+            if (!cfg.auto_reconnect || !cfg.replay_path.empty()) {
+                // 非重连模式 / 回放：自然退出（关闭请求、服务端已断或回放结束，均非致命）。
                 set_state(ClientState::Stopped);
                 break;
             }
 
+            // 原位重连发现格式变化：服务端在线，立即按新格式重建，不计退避。
+            if (outcome == SessionOutcome::FormatChanged) {
+                session_start = std::chrono::steady_clock::now();
+                continue;
+            }
+
             set_state(ClientState::Reconnecting);
 
             // 上次会话稳定运行过（>= RECONNECT_BACKOFF_RESET_AFTER）则重置退避。
@@ -701,6 +1748,12 @@ bool ClientRuntime::start(const ClientConfig& cfg, ClientCallbacks cb)
 
     p.running_.store(true, std::memory_order_relaxed);
     p.session_thread = std::thread([&p] {
+        // 先锁定内存：之后每个会话分配的 RB / JB / 入口队列在映射时即驻留。
+        if (p.cfg.runtime.lock_memory) {
+            rt::lock_process_memory(&p.thread_policy_report_);
+        }
+        rt::apply_current_thread_policy(config::ThreadRole::Session,
+            p.thread_policy(config::ThreadRole::Session), &p.thread_policy_report_);
         p.session_loop();
     });
     return true;
@@ -1,6 +1,7 @@
 #ifndef AQUA_CLIENT_RUNTIME_H
 #define AQUA_CLIENT_RUNTIME_H
 
+#include "core/audio/backend/audio_backend_factory.h"
 #include "core/diagnostics/diagnostics_manager.h"
 #include "core/public/audio_format.h"
 #include "core/public/config.h"
@@ -11,19 +12,42 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace aqua::client {
 
+// 附加订阅的服务器（多服务器混音）：各自 gRPC Connect + UDP 握手，音频按 gain 与主服务器流求和。
+struct MixSource {
+    std::string server_ip;
+    std::uint16_t server_rpc_port = 50051;
+    float gain = 1.0f; // 线性增益，[0, MIX_MAX_GAIN]
+};
+
 // 客户端运行时配置。前端（CLI / UI）填充后传入 ClientRuntime::start()。
 // CLI 参数中"0 = 用默认值"的语义由前端在填 runtime 前解析，core 不感知。
 struct ClientConfig {
     std::string server_ip = "127.0.0.1";
     std::uint16_t server_rpc_port = 50051;
     config::RuntimeConfig runtime; // jitter 延迟 / 漂移阈值 / 播放缓冲大小
-    // 断线自动重连（指数退避 1/2/4/8/16/30s），默认关闭。
+    // 断线自动重连，默认关闭：运行中断流即原位重连（保留播放设备 / 缓冲 / JB target），
+    // 建会话失败按指数退避（1/2/4/8/16/30s）重试。
     bool auto_reconnect = false;
     // gRPC Connect 时上报的名称，仅用于服务器日志识别设备，默认 "aqua_client"。
     std::string client_name = "aqua_client";
+    // 播放去向（--playback-sink 等）。默认平台设备；其余去向不依赖声卡。
+    audio::PlaybackSinkConfig playback;
+    // 数据面抓包（--capture-file）：把收到的每个 UDP datagram 连同到达时刻写入该文件
+    // （格式见 net/capture/packet_capture.h）；重连后的会话追加 ".1"、".2" 后缀。空 = 不抓包。
+    std::string capture_path;
+    // 回放（--replay-file）：不连接服务器，按抓包时序把文件中的 datagram 送入接收路径，
+    // 读完后会话正常结束（不重连）。非空时忽略 server_ip / server_rpc_port。
+    std::string replay_path;
+    // 多服务器订阅（--mix-server，至多 MIX_MAX_SOURCES 路）：与主服务器同采样率的流混入同一播放流，
+    // 采样率不同或连接失败的源跳过（告警，不影响主流）。附加源不参与原位重连，会话重建时一并重连。
+    // 回放模式忽略。
+    std::vector<MixSource> mix_sources;
+    // 主服务器流的混音增益（--gain，线性）。1 且无附加源时不经混音级。
+    float mix_gain = 1.0f;
 };
 
 // 客户端运行状态。
@@ -31,7 +55,7 @@ enum class ClientState {
     Idle = 0, // 未启动
     Connecting, // gRPC 连接 + UDP 握手 + 播放初始化中
     Playing, // 音频正常播放中
-    Reconnecting, // 断线后指数退避等待重连（仅 auto_reconnect 时出现）
+    Reconnecting, // 断线重连中：原位重连或指数退避等待（仅 auto_reconnect 时出现）
     Stopped, // 优雅关闭（shutdown() 或非重连模式下自然退出）
     Failed, // 致命错误（不可恢复）
 };
@@ -56,7 +80,10 @@ struct ClientCallbacks {
 //   - 会话线程：start() 启动的后台线程，执行整个会话（含重连退避）
 //   - UDP I/O 线程：asio::io_context.run()（收发 + JB 调度 + HELLO 保活）
 //   - 播放线程：平台音频后端回调
+//   - 调度线程：PlayoutMode::Thread 时的 PlayoutScheduler
 //   - 调用方线程：start() / run() / shutdown()
+// 运行时线程在入口（播放线程在首次回调）按 RuntimeConfig::thread_policies 应用调度策略与亲和性，
+// 结果计入诊断快照 thread_policy_*。
 class ClientRuntime {
 public:
     ClientRuntime();
@@ -0,0 +1,76 @@
+#include "core/client/drift_compensator.h"
+#include "core/public/config.h"
+
+#include <algorithm>
+
+namespace aqua::client {
+
+namespace {
+    double clamp_ppm(double ppm)
+    {
+        return std::clamp(ppm, -config::DRIFT_COMP_MAX_PPM, config::DRIFT_COMP_MAX_PPM);
+    }
+} // namespace
+
+DriftCompensator::DriftCompensator(double rb_setpoint_ms)
+    : rb_setpoint_ms_(rb_setpoint_ms)
+{
+}
+
+const DriftCompensator::Output& DriftCompensator::update(const Measurement& m, std::chrono::duration<double> dt)
+{
+    const double dt_s = std::max(0.0, dt.count());
+    update_jb_loop(m, dt_s);
+    update_rb_loop(m, dt_s);
+    out_.jb_rate = 1.0 + jb_ppm_ * 1e-6;
+    out_.resample_ratio = 1.0 + resample_ppm_ * 1e-6;
+    return out_;
+}
+
+void DriftCompensator::update_jb_loop(const Measurement& m, double dt_s)
+{
+    if (!epoch_ || *epoch_ != m.jb_timeline_epoch) {
+        // 时间线（重）建：到达延迟基准已归零，重新预热后取设定点
+        epoch_ = m.jb_timeline_epoch;
+        since_epoch_s_ = 0.0;
+        jb_setpoint_ms_.reset();
+    }
+    since_epoch_s_ += dt_s;
+
+    const double feedforward = m.sender_ppm.value_or(0.0);
+    if (!jb_setpoint_ms_) {
+        if (since_epoch_s_ < std::chrono::duration<double>(config::DRIFT_COMP_WARMUP).count()) {
+            jb_ppm_ = clamp_ppm(feedforward - jb_integral_ppm_);
+            return;
+        }
+        jb_setpoint_ms_ = m.jb_arrival_delay_ms;
+    }
+
+    const double error = m.jb_arrival_delay_ms - *jb_setpoint_ms_;
+    jb_integral_ppm_ = clamp_ppm(jb_integral_ppm_ + config::DRIFT_COMP_KI_PPM_PER_MS_S * error * dt_s);
+    jb_ppm_ = clamp_ppm(feedforward - config::DRIFT_COMP_KP_PPM_PER_MS * error - jb_integral_ppm_);
+}
+
+void DriftCompensator::update_rb_loop(const Measurement& m, double dt_s)
+{
+    const double feedforward = -jb_ppm_;
+    if (!m.playback_running) {
+        rb_smoothed_ms_.reset();
+        resample_ppm_ = clamp_ppm(feedforward - rb_integral_ppm_);
+        return;
+    }
+
+    if (!rb_smoothed_ms_) {
+        rb_smoothed_ms_ = m.rb_fill_ms;
+    } else {
+        const double tau_s = std::chrono::duration<double>(config::DRIFT_COMP_RB_SMOOTHING).count();
+        const double alpha = std::min(1.0, dt_s / tau_s);
+        *rb_smoothed_ms_ += alpha * (m.rb_fill_ms - *rb_smoothed_ms_);
+    }
+
+    const double error = *rb_smoothed_ms_ - rb_setpoint_ms_;
+    rb_integral_ppm_ = clamp_ppm(rb_integral_ppm_ + config::DRIFT_COMP_KI_PPM_PER_MS_S * error * dt_s);
+    resample_ppm_ = clamp_ppm(feedforward - config::DRIFT_COMP_KP_PPM_PER_MS * error - rb_integral_ppm_);
+}
+
+} // namespace aqua::client
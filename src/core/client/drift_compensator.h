@@ -0,0 +1,73 @@
+#ifndef AQUA_DRIFT_COMPENSATOR_H
+#define AQUA_DRIFT_COMPENSATOR_H
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace aqua::client {
+
+// 时钟漂移补偿控制器（见 config.h DRIFT_COMP_*）。
+//
+// 两个独立回路，输出均为相对名义速率的 ppm，钳到 ±DRIFT_COMP_MAX_PPM：
+//   JB 回路：jb_ppm = sender_ppm − PI(到达延迟 − 设定点)
+//     发送端偏快 → 包相对出队节拍越来越早 → 到达延迟下降 → 出队加速。
+//     设定点在时间线（重）建 DRIFT_COMP_WARMUP 后取当时的到达延迟；积分项跨 rebase 保留
+//     （速率差不因时间线重建而改变）。
+//   RB 回路：resample_ppm = −jb_ppm − PI(RB 平滑占用 − 设定点)
+//     重采样比率 = 设备消费速率 / 出队速率；前馈抵消 JB 回路的调整，积分项学到设备时钟偏差，
+//     RB 偏满 → 少产出。播放闩锁未打开（pre-roll 蓄水）时冻结，平滑状态清零，积分项保留。
+// sender_ppm（DiagnosticsManager::sender_rate_ppm）缺省时按 0 处理，仅靠积分项收敛。
+// 设备侧不做速率前馈：播放进度按回调块计数，10s 窗口回归误差达数百 ppm，不如 RB 占用直接。
+//
+// Threading contract: 单线程（客户端主循环每 POLL_INTERVAL 调用 update）；
+// 输出经调用方的 atomic 交给 io 线程。
+class DriftCompensator {
+public:
+    struct Measurement {
+        double jb_arrival_delay_ms = 0.0; // JitterBuffer::mean_arrival_delay_ms
+        std::uint32_t jb_timeline_epoch = 0; // JitterBuffer::timeline_epoch
+        double rb_fill_ms = 0.0;
+        bool playback_running = false; // 播放闩锁已打开
+        std::optional<double> sender_ppm; // 发送端速率相对本地 steady_clock
+    };
+
+    struct Output {
+        double jb_rate = 1.0; // JitterBuffer::set_playout_rate
+        double resample_ratio = 1.0; // VariableResampler::process（输出 / 输入）
+    };
+
+    // rb_setpoint_ms：RB 回路设定点（通常为 pre-roll 水位）。
+    explicit DriftCompensator(double rb_setpoint_ms);
+
+    const Output& update(const Measurement& m, std::chrono::duration<double> dt);
+
+    [[nodiscard]] const Output& output() const noexcept { return out_; }
+    [[nodiscard]] double jb_ppm() const noexcept { return jb_ppm_; }
+    [[nodiscard]] double resample_ppm() const noexcept { return resample_ppm_; }
+    [[nodiscard]] std::optional<double> jb_setpoint_ms() const noexcept { return jb_setpoint_ms_; }
+
+private:
+    void update_jb_loop(const Measurement& m, double dt_s);
+    void update_rb_loop(const Measurement& m, double dt_s);
+
+    double rb_setpoint_ms_;
+
+    // JB 回路
+    std::optional<std::uint32_t> epoch_;
+    double since_epoch_s_ = 0.0;
+    std::optional<double> jb_setpoint_ms_;
+    double jb_integral_ppm_ = 0.0;
+    double jb_ppm_ = 0.0;
+
+    // RB 回路
+    std::optional<double> rb_smoothed_ms_;
+    double rb_integral_ppm_ = 0.0;
+    double resample_ppm_ = 0.0;
+
+    Output out_ { };
+};
+
+} // namespace aqua::client
+
+#endif // AQUA_DRIFT_COMPENSATOR_H
@@ -0,0 +1,70 @@
+#include "core/client/playout_scheduler.h"
+
+#include "core/public/config.h"
+#include "core/rt/high_res_timer.h"
+
+#include <utility>
+
+namespace aqua::client {
+
+PlayoutScheduler::PlayoutScheduler(TickFn tick, LatenessFn on_lateness)
+    : tick_(std::move(tick))
+    , on_lateness_(std::move(on_lateness))
+{
+}
+
+PlayoutScheduler::~PlayoutScheduler()
+{
+    stop();
+}
+
+void PlayoutScheduler::start(const config::ThreadPolicy& policy, rt::ThreadPolicyReport* report)
+{
+    if (thread_.joinable()) {
+        return;
+    }
+    stop_requested_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this, policy, report] {
+        rt::apply_current_thread_policy(config::ThreadRole::Scheduler, policy, report);
+        run();
+    });
+}
+
+void PlayoutScheduler::stop()
+{
+    stop_requested_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void PlayoutScheduler::run()
+{
+    rt::HighResTimer timer;
+    // 上次按请求时刻睡眠的目标（空闲轮询 / 分段睡眠不计迟到）
+    clock::time_point requested { };
+    bool on_request = false;
+
+    while (!stop_requested_.load(std::memory_order_relaxed)) {
+        const auto now = clock::now();
+        if (on_request && on_lateness_) {
+            on_lateness_(now - requested);
+        }
+
+        const auto next = tick_(now);
+        const auto after_tick = clock::now();
+        if (!next) {
+            on_request = false;
+            timer.sleep_until(after_tick + config::PLAYOUT_SCHEDULER_IDLE_INTERVAL);
+        } else if (*next > after_tick + config::PLAYOUT_SCHEDULER_MAX_SLEEP) {
+            on_request = false;
+            timer.sleep_until(after_tick + config::PLAYOUT_SCHEDULER_MAX_SLEEP);
+        } else {
+            on_request = true;
+            requested = *next;
+            timer.sleep_until(requested);
+        }
+    }
+}
+
+} // namespace aqua::client
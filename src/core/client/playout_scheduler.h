@@ -0,0 +1,60 @@
+#ifndef AQUA_PLAYOUT_SCHEDULER_H
+#define AQUA_PLAYOUT_SCHEDULER_H
+
+#include "core/public/config.h"
+#include "core/rt/function_ref.h"
+#include "core/rt/thread_policy.h"
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+namespace aqua::client {
+
+// 专用播放调度线程（RuntimeConfig::playout_mode = Thread）：取代 io_context 上的 steady_timer，
+// 按绝对 deadline 睡眠后调用 tick，出队节拍不再与 UDP 收包 / 保活共用一个线程。
+//
+// - 高精度绝对睡眠（rt::HighResTimer：Linux clock_nanosleep(TIMER_ABSTIME)，Windows 高分辨率
+//   waitable timer）。绝对时刻不会因 tick 耗时累积误差。
+// - tick(now) 返回下一次唤醒的绝对时刻（通常为下一块 deadline）；nullopt 表示空闲，
+//   PLAYOUT_SCHEDULER_IDLE_INTERVAL 后再调用。单次睡眠不超过 PLAYOUT_SCHEDULER_MAX_SLEEP，
+//   stop() 响应有界。返回不晚于 now 的时刻会立即再次调用，调用方须自行限制重试节奏。
+// - 每次按请求时刻唤醒后回调 on_lateness(实际唤醒 - 请求时刻)（空闲轮询不计）。
+// - 可选线程策略（ThreadRole::Scheduler：SCHED_FIFO / RR、CPU 亲和性，见 rt::apply_current_thread_policy），
+//   在调度线程入口应用：失败只告警并计入 report，以原设置继续。
+//
+// tick / on_lateness 是非拥有引用（rt::FunctionRef）：被引用对象须存活至 stop() 返回（析构即 stop）。
+//
+// Threading contract: start / stop 在同一控制线程调用；tick 与 on_lateness 只在调度线程执行。
+class PlayoutScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+    using TickFn = rt::FunctionRef<std::optional<clock::time_point>(clock::time_point now)>;
+    using LatenessFn = rt::FunctionRef<void(std::chrono::nanoseconds lateness)>;
+
+    PlayoutScheduler(TickFn tick, LatenessFn on_lateness = { });
+    ~PlayoutScheduler();
+
+    PlayoutScheduler(const PlayoutScheduler&) = delete;
+    PlayoutScheduler& operator=(const PlayoutScheduler&) = delete;
+
+    // 启动调度线程，线程入口先应用 policy（结果计入 report，可为空）。重复调用为空操作。
+    void start(const config::ThreadPolicy& policy = { }, rt::ThreadPolicyReport* report = nullptr);
+    // 请求停止并 join（幂等）。
+    void stop();
+
+    [[nodiscard]] bool is_running() const noexcept { return thread_.joinable(); }
+
+private:
+    void run();
+
+    TickFn tick_;
+    LatenessFn on_lateness_;
+    std::thread thread_;
+    std::atomic<bool> stop_requested_ { false };
+};
+
+} // namespace aqua::client
+
+#endif // AQUA_PLAYOUT_SCHEDULER_H
@@ -0,0 +1,185 @@
+#include "core/client/pull_playout.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace aqua::client {
+
+template <typename Clock>
+BasicPullPlayout<Clock>::BasicPullPlayout(jitter::BasicJitterBuffer<Clock>& jb,
+    jitter::IngressQueue& ingress,
+    const AudioFormat& server_format,
+    const AudioFormat& device_format,
+    std::uint32_t frames_per_packet,
+    audio::dsp::VariableResampler* resampler,
+    audio::dsp::FormatConverter* converter,
+    std::uint32_t lead_packets,
+    BasicStreamMixer<Clock>* mixer)
+    : jb_(jb)
+    , ingress_(ingress)
+    , device_frame_bytes_(device_format.frame_bytes())
+    , device_rate_(device_format.sample_rate)
+    , lead_(std::chrono::nanoseconds(static_cast<std::int64_t>(lead_packets) * frames_per_packet * 1'000'000'000
+          / server_format.sample_rate))
+    , packet_duration_(std::chrono::nanoseconds(static_cast<std::int64_t>(frames_per_packet) * 1'000'000'000
+          / server_format.sample_rate))
+    , server_frame_bytes_(server_format.frame_bytes())
+    , payload_bytes_(static_cast<std::size_t>(frames_per_packet) * server_format.frame_bytes())
+    , resampler_(resampler)
+    , converter_(converter)
+    , mixer_(mixer)
+{
+    const std::size_t resampled_frames = resampler_ ? resampler_->max_output_frames() : frames_per_packet;
+    const std::size_t block_frames = converter_ ? converter_->max_output_frames() : resampled_frames;
+    if (resampler_ || converter_) {
+        pop_scratch_.resize(payload_bytes_);
+    }
+    if (resampler_ && converter_) {
+        resample_scratch_.resize(resampled_frames * server_frame_bytes_);
+    }
+    staging_.resize(std::max(block_frames * device_frame_bytes_, payload_bytes_));
+}
+
+template <typename Clock>
+void BasicPullPlayout<Clock>::set_drift_command(double jb_rate, double resample_ratio) noexcept
+{
+    jb_rate_cmd_.store(jb_rate, std::memory_order_relaxed);
+    resample_ratio_cmd_.store(resample_ratio, std::memory_order_relaxed);
+}
+
+template <typename Clock>
+double BasicPullPlayout<Clock>::backlog_ms() const noexcept
+{
+    return static_cast<double>(backlog_ns_.load(std::memory_order_relaxed)) / 1e6;
+}
+
+template <typename Clock>
+std::chrono::nanoseconds BasicPullPlayout<Clock>::frames_duration(std::size_t frames) const noexcept
+{
+    return std::chrono::nanoseconds(static_cast<std::int64_t>(frames) * 1'000'000'000 / device_rate_);
+}
+
+template <typename Clock>
+std::size_t BasicPullPlayout<Clock>::produce(std::span<std::byte> dst, typename Clock::time_point deadline,
+    bool primary) noexcept
+{
+    if (!resampler_ && !converter_) {
+        // 直通：pop_next 直接写入目标（out 或暂存区），无中转；混音在目标上原地进行
+        if (!primary) {
+            (void)mixer_->mix_over_silence(dst.first(payload_bytes_), deadline);
+            return payload_bytes_;
+        }
+        (void)jb_.pop_next(dst.first(payload_bytes_));
+        if (mixer_) {
+            (void)mixer_->mix(dst.first(payload_bytes_), deadline);
+        }
+        return payload_bytes_;
+    }
+
+    if (!primary) {
+        (void)mixer_->mix_over_silence(pop_scratch_, deadline);
+    } else {
+        (void)jb_.pop_next(pop_scratch_);
+        if (mixer_) {
+            (void)mixer_->mix(pop_scratch_, deadline);
+        }
+    }
+    const double ratio = resample_ratio_cmd_.load(std::memory_order_relaxed);
+    std::size_t frames = 0;
+    if (!converter_) {
+        frames = resampler_->process(pop_scratch_, ratio, dst, { });
+    } else if (!resampler_) {
+        frames = converter_->process(pop_scratch_, dst, { });
+    } else {
+        const auto resampled = resampler_->process(pop_scratch_, ratio, resample_scratch_, { });
+        frames = converter_->process(
+            std::span<const std::byte> { resample_scratch_ }.first(resampled * server_frame_bytes_), dst, { });
+    }
+    return frames * device_frame_bytes_;
+}
+
+template <typename Clock>
+typename BasicPullPlayout<Clock>::FillResult BasicPullPlayout<Clock>::fill(std::span<std::byte> out) noexcept
+{
+    if (reset_requested_.load(std::memory_order_relaxed) && reset_requested_.exchange(false, std::memory_order_acquire)) {
+        jb_.reset();
+        staged_offset_ = 0;
+        staged_end_ = 0;
+    }
+    // 入队包按原到达时刻入 JB；now 在 drain 之后取，保证不早于任何到达时刻。
+    ingress_.drain([this](const jitter::IngressQueue::Entry& e) {
+        jb_.push_at(e.sample_position, e.payload,
+            typename Clock::time_point(std::chrono::duration_cast<typename Clock::duration>(e.arrival)));
+    });
+    if (mixer_) {
+        mixer_->drain();
+    }
+    const auto now = Clock::now();
+    if (resampler_) {
+        jb_.set_playout_rate(jb_rate_cmd_.load(std::memory_order_relaxed));
+    }
+
+    FillResult result;
+    std::size_t written = std::min(staged_end_ - staged_offset_, out.size());
+    std::memcpy(out.data(), staging_.data() + staged_offset_, written);
+    staged_offset_ += written;
+
+    bool started = started_.load(std::memory_order_relaxed);
+    bool mixer_led = false; // 本次回调有附加流领拍出队的块
+    while (written < out.size()) {
+        auto deadline = jb_.next_playout_deadline();
+        const bool primary = deadline.has_value();
+        if (!primary) {
+            started = false; // 尚无时间线 / 断流重置：静音等待下一个包
+            // 附加流照常出队：由最早的附加流领拍，以静音为底混音
+            if (mixer_) {
+                deadline = mixer_->next_deadline();
+            }
+            if (!deadline) {
+                break;
+            }
+        }
+        // 该块开始播放的设备时刻：本次回调起点 + 已写入帧的时长
+        const auto play_at = now + frames_duration(written / device_frame_bytes_);
+        if (*deadline > play_at + lead_) {
+            break;
+        }
+        if (play_at - *deadline > packet_duration_) {
+            ++result.deadline_misses;
+        }
+        started = primary;
+        mixer_led = mixer_led || !primary;
+
+        const std::size_t room = out.size() - written;
+        if (room >= staging_.size()) {
+            written += produce(out.subspan(written), *deadline, primary);
+        } else {
+            staged_end_ = produce(staging_, *deadline, primary);
+            staged_offset_ = std::min(staged_end_, room);
+            std::memcpy(out.data() + written, staging_.data(), staged_offset_);
+            written += staged_offset_;
+        }
+    }
+    if (staged_offset_ == staged_end_) {
+        staged_offset_ = 0;
+        staged_end_ = 0;
+    }
+
+    result.bytes = written;
+    result.underrun = (started || mixer_led) && written < out.size();
+    started_.store(started, std::memory_order_relaxed);
+    staged_bytes_.store(staged_end_ - staged_offset_, std::memory_order_relaxed);
+    if (const auto deadline = jb_.next_playout_deadline(); deadline && started) {
+        // 下一块在本次 out 与剩余暂存帧播完后开始播放
+        const auto next_play = now + frames_duration(out.size() / device_frame_bytes_
+                                   + (staged_end_ - staged_offset_) / device_frame_bytes_);
+        backlog_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(next_play - *deadline).count(),
+            std::memory_order_relaxed);
+    }
+    return result;
+}
+
+template class BasicPullPlayout<std::chrono::steady_clock>;
+template class BasicPullPlayout<jitter::SimClock>;
+
+} // namespace aqua::client
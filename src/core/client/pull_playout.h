@@ -0,0 +1,125 @@
+#ifndef AQUA_PULL_PLAYOUT_H
+#define AQUA_PULL_PLAYOUT_H
+
+#include "core/audio/dsp/format_converter.h"
+#include "core/audio/dsp/resampler.h"
+#include "core/client/stream_mixer.h"
+#include "core/jitter_buffer/ingress_queue.h"
+#include "core/jitter_buffer/jitter_buffer.h"
+#include "core/public/audio_format.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace aqua::client {
+
+// 拉模式播放（RuntimeConfig::playout_mode = Pull）：播放后端的 FillCallback 直接从 JitterBuffer 取包，
+// 取代 "steady_timer 出队 → SpscRingBuffer → 预蓄水闩锁 → 设备回调" 的推模式链路。
+//
+// 每次 fill(out)：
+//   1. 把 IngressQueue 中排队的包按原到达时刻 push_at 入 JB（JB 只在播放线程访问）；
+//   2. 先输出上次剩余的暂存帧，再按设备播放位置逐块出队：块将在 now + 已写帧时长 处开始播放，
+//      其 deadline 不晚于该时刻 + lead 时才 pop（lead 吸收回调时刻抖动）；
+//   3. 出队块经可选的多流混音 / 漂移重采样 / 格式转换写入 out，跨越 out 末尾的部分留在暂存区。
+// 起播前（JB 无时间线）与首块 deadline 之前输出静音，不计欠载——起播缓冲即 JB 的 target，
+// 无需 RB 预蓄水与低水位看门狗；出队时刻即设备取数时刻，也没有定时器唤醒抖动。
+//
+// 漂移补偿：backlog_ms() = 下一块开始播放的设备时刻 - 其 deadline（正 = 出队落后于 deadline）。
+// 设备时钟与出队节拍的速率差使其线性漂移，作为 DriftCompensator RB 回路的占用输入（设定点 0）。
+//
+// 时钟为模板参数（与 BasicJitterBuffer 一致）：运行时 PullPlayout = BasicPullPlayout<steady_clock>，
+// 测试用 BasicPullPlayout<SimClock> 逐回调推进虚拟时间。
+//
+// Threading contract: fill 只在播放回调线程调用（该线程独占 JB 的 push / pop）；
+// request_reset / set_drift_command / backlog_ms / staged_bytes / started 任意线程可调用。
+// 构造时预分配全部缓冲，fill 无分配、无锁。
+template <typename Clock>
+class BasicPullPlayout {
+public:
+    using clock = Clock;
+
+    struct FillResult {
+        std::size_t bytes = 0; // 写入 out 的字节数（其余由后端补静音）
+        std::uint32_t deadline_misses = 0; // 出队时已落后 deadline 超过一包的块数
+        bool underrun = false; // 已起播但 out 未写满
+    };
+
+    // jb / ingress 须比本对象存活更久。resampler（漂移重采样）/ converter（格式转换）可为空，
+    // 非空时依次作用于每个出队块，与推模式同一条处理链。
+    // lead_packets：deadline 相对设备播放位置的提前量（包数）。
+    // mixer（多服务器订阅）可为空，非空时每个出队块先按其 deadline 混入附加流，再进入处理链；
+    // 主流无时间线时由附加流领拍，以静音为底出队（见 BasicStreamMixer::mix_over_silence）。
+    BasicPullPlayout(jitter::BasicJitterBuffer<Clock>& jb,
+        jitter::IngressQueue& ingress,
+        const AudioFormat& server_format,
+        const AudioFormat& device_format,
+        std::uint32_t frames_per_packet,
+        audio::dsp::VariableResampler* resampler,
+        audio::dsp::FormatConverter* converter,
+        std::uint32_t lead_packets,
+        BasicStreamMixer<Clock>* mixer = nullptr);
+
+    BasicPullPlayout(const BasicPullPlayout&) = delete;
+    BasicPullPlayout& operator=(const BasicPullPlayout&) = delete;
+
+    // 播放回调：写满 out（设备格式）或写到下一块 deadline 未到为止。
+    FillResult fill(std::span<std::byte> out) noexcept;
+
+    // 请求丢弃当前时间线（客户端原位重连、发送流换了会话）：下一次 fill 在取入口队列之前
+    // reset JB（保留已学习的 target）并清空暂存帧，之后按新流的首包重新起播。
+    void request_reset() noexcept { reset_requested_.store(true, std::memory_order_release); }
+
+    // 漂移补偿输出（DriftCompensator）：下一次 fill 生效。
+    void set_drift_command(double jb_rate, double resample_ratio) noexcept;
+
+    [[nodiscard]] double backlog_ms() const noexcept;
+    [[nodiscard]] std::size_t staged_bytes() const noexcept { return staged_bytes_.load(std::memory_order_relaxed); }
+    // 暂存区容量（一块处理后的最大输出）。
+    [[nodiscard]] std::size_t staging_capacity() const noexcept { return staging_.size(); }
+    // 主流当前时间线已开始出队（JB 断流重置后回到 false，直至新时间线的首块出队；附加流领拍不计）。
+    [[nodiscard]] bool started() const noexcept { return started_.load(std::memory_order_relaxed); }
+
+private:
+    // 出队一块（播放时刻 deadline），处理后写入 dst（>= staging_.size() 字节），返回写入字节数。
+    // primary = false：主流缺席，块由 mixer 以静音为底混出。
+    std::size_t produce(std::span<std::byte> dst, typename Clock::time_point deadline, bool primary) noexcept;
+    [[nodiscard]] std::chrono::nanoseconds frames_duration(std::size_t frames) const noexcept;
+
+    jitter::BasicJitterBuffer<Clock>& jb_;
+    jitter::IngressQueue& ingress_;
+    std::size_t device_frame_bytes_;
+    std::uint32_t device_rate_;
+    std::chrono::nanoseconds lead_;
+    std::chrono::nanoseconds packet_duration_;
+    std::size_t server_frame_bytes_;
+    std::size_t payload_bytes_; // 每块 pop_next 输出（服务端格式）
+    audio::dsp::VariableResampler* resampler_;
+    audio::dsp::FormatConverter* converter_;
+    BasicStreamMixer<Clock>* mixer_;
+
+    std::vector<std::byte> pop_scratch_; // pop_next 输出（重采样 / 转换输入）
+    std::vector<std::byte> resample_scratch_; // 漂移重采样输出（转换输入）
+    std::vector<std::byte> staging_; // 跨回调的剩余帧（设备格式），有效区 [staged_offset_, staged_end_)
+    std::size_t staged_offset_ = 0;
+    std::size_t staged_end_ = 0;
+
+    std::atomic<double> jb_rate_cmd_ { 1.0 };
+    std::atomic<double> resample_ratio_cmd_ { 1.0 };
+    std::atomic<std::int64_t> backlog_ns_ { 0 };
+    std::atomic<std::size_t> staged_bytes_ { 0 };
+    std::atomic<bool> started_ { false };
+    std::atomic<bool> reset_requested_ { false };
+};
+
+extern template class BasicPullPlayout<std::chrono::steady_clock>;
+extern template class BasicPullPlayout<jitter::SimClock>;
+
+using PullPlayout = BasicPullPlayout<std::chrono::steady_clock>;
+
+} // namespace aqua::client
+
+#endif // AQUA_PULL_PLAYOUT_H
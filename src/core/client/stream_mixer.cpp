@@ -0,0 +1,194 @@
+#include "core/client/stream_mixer.h"
+
+#include "core/audio/dsp/gain.h"
+#include "core/audio/dsp/sample_convert.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace aqua::client {
+
+template <typename Clock>
+BasicStreamMixer<Clock>::BasicStreamMixer(const AudioFormat& mix_format, std::uint32_t frames_per_packet,
+    float primary_gain, std::size_t max_streams)
+    : mix_format_(mix_format)
+    , frames_per_packet_(frames_per_packet)
+    , primary_gain_(primary_gain)
+    , half_packet_(std::chrono::nanoseconds(static_cast<std::int64_t>(frames_per_packet) * 500'000'000
+          / mix_format.sample_rate))
+    , streams_(max_streams)
+    , acc_(static_cast<std::size_t>(frames_per_packet) * mix_format.channels)
+    , converted_(acc_.size())
+{
+    if (!mix_format.valid() || frames_per_packet == 0) {
+        throw std::invalid_argument("StreamMixer requires a valid mix format and frames_per_packet > 0");
+    }
+}
+
+template <typename Clock>
+std::size_t BasicStreamMixer<Clock>::add_stream(const StreamConfig& stream_cfg)
+{
+    if (!stream_cfg.format.valid()) {
+        throw std::invalid_argument("StreamMixer stream requires a valid AudioFormat");
+    }
+    if (stream_cfg.format.sample_rate != mix_format_.sample_rate) {
+        throw std::invalid_argument("StreamMixer stream sample rate must match the primary stream");
+    }
+    const std::size_t index = stream_count_.load(std::memory_order_relaxed);
+    if (index == streams_.size()) {
+        throw std::length_error("StreamMixer stream slots exhausted");
+    }
+
+    auto s = std::make_unique<Stream>();
+    s->gain = stream_cfg.gain;
+    s->payload_bytes = static_cast<std::size_t>(frames_per_packet_) * stream_cfg.format.frame_bytes();
+    const std::size_t max_payload = std::max(s->payload_bytes, config::AUDIO_MAX_PAYLOAD_BYTES);
+    s->jb = std::make_unique<jitter::BasicJitterBuffer<Clock>>(stream_cfg.format, frames_per_packet_,
+        stream_cfg.floor_packets, stream_cfg.capacity_packets, stream_cfg.detect_window_packets,
+        config::JITTER_DRIFT_REBASE_LATE_COUNT, stream_cfg.adaptive, 0, stream_cfg.plc_mode, max_payload);
+    s->ingress = std::make_unique<jitter::IngressQueue>(config::PULL_INGRESS_QUEUE_PACKETS, 0, max_payload);
+
+    const AudioFormat float_format { AudioEncoding::PcmF32LE, mix_format_.channels, mix_format_.sample_rate };
+    if (stream_cfg.format != float_format) {
+        // 只换声道 / 编码，不抖动：输出是 float 中间域，最终量化在混音后的 encode
+        audio::dsp::FormatConverterOptions options;
+        options.dither = false;
+        s->converter = std::make_unique<audio::dsp::FormatConverter>(stream_cfg.format, float_format,
+            frames_per_packet_, std::move(options));
+    }
+    s->pop.resize((s->payload_bytes + sizeof(float) - 1) / sizeof(float));
+
+    streams_[index] = std::move(s);
+    stream_count_.store(index + 1, std::memory_order_release);
+    return index;
+}
+
+template <typename Clock>
+bool BasicStreamMixer<Clock>::push(std::size_t stream, std::chrono::nanoseconds arrival,
+    std::uint32_t sample_position, std::span<const std::byte> payload) noexcept
+{
+    return streams_[stream]->ingress->push(arrival, sample_position, payload);
+}
+
+template <typename Clock>
+void BasicStreamMixer<Clock>::drain() noexcept
+{
+    for (std::size_t i = 0, n = stream_count(); i < n; ++i) {
+        auto& s = streams_[i];
+        s->ingress->drain([&s](const jitter::IngressQueue::Entry& e) {
+            s->jb->push_at(e.sample_position, e.payload,
+                time_point(std::chrono::duration_cast<typename Clock::duration>(e.arrival)));
+        });
+    }
+}
+
+template <typename Clock>
+void BasicStreamMixer<Clock>::load_primary(std::span<const std::byte> block) noexcept
+{
+    std::fill(acc_.begin(), acc_.end(), 0.0f);
+    (void)audio::dsp::decode_samples(block, mix_format_.encoding, acc_);
+    if (primary_gain_ != 1.0f) {
+        audio::dsp::apply_gain(std::as_writable_bytes(std::span(acc_)), AudioEncoding::PcmF32LE, primary_gain_);
+    }
+}
+
+template <typename Clock>
+std::size_t BasicStreamMixer<Clock>::accumulate(std::span<const std::byte> primary, time_point deadline) noexcept
+{
+    std::size_t mixed = 0;
+    for (std::size_t i = 0, n = stream_count(); i < n; ++i) {
+        auto& s = streams_[i];
+        auto dl = s->jb->next_playout_deadline();
+        // 落后领拍块超过半包：丢弃到对齐为止（至多一个 capacity，更久的断流由 JB 自己重置时间线）
+        for (std::size_t budget = s->jb->capacity_packets(); dl && *dl + half_packet_ < deadline && budget > 0;
+             --budget) {
+            (void)s->jb->pop_next(pop_bytes(*s));
+            s->skipped_blocks.fetch_add(1, std::memory_order_relaxed);
+            dl = s->jb->next_playout_deadline();
+        }
+        if (!dl || *dl > deadline + half_packet_) {
+            continue;
+        }
+
+        (void)s->jb->pop_next(pop_bytes(*s));
+        if (mixed == 0) {
+            if (primary.empty()) {
+                std::fill(acc_.begin(), acc_.end(), 0.0f);
+            } else {
+                load_primary(primary);
+            }
+        }
+        std::span<const float> src { s->pop };
+        if (s->converter) {
+            const std::size_t frames = s->converter->process(pop_bytes(*s),
+                std::as_writable_bytes(std::span(converted_)), { });
+            src = std::span<const float> { converted_ }.first(frames * mix_format_.channels);
+        }
+        audio::dsp::mix_accumulate(acc_, src, s->gain);
+        s->mixed_blocks.fetch_add(1, std::memory_order_relaxed);
+        ++mixed;
+    }
+    return mixed;
+}
+
+template <typename Clock>
+std::size_t BasicStreamMixer<Clock>::mix(std::span<std::byte> block, time_point deadline) noexcept
+{
+    drain();
+
+    const std::size_t mixed = accumulate(block, deadline);
+    if (mixed > 0) {
+        (void)audio::dsp::encode_samples(acc_, mix_format_.encoding, block);
+    } else if (primary_gain_ != 1.0f) {
+        audio::dsp::apply_gain(block, mix_format_.encoding, primary_gain_);
+    }
+    return mixed;
+}
+
+template <typename Clock>
+std::optional<typename BasicStreamMixer<Clock>::time_point> BasicStreamMixer<Clock>::next_deadline() const noexcept
+{
+    std::optional<time_point> earliest;
+    for (std::size_t i = 0, n = stream_count(); i < n; ++i) {
+        const auto dl = streams_[i]->jb->next_playout_deadline();
+        if (dl && (!earliest || *dl < *earliest)) {
+            earliest = dl;
+        }
+    }
+    return earliest;
+}
+
+template <typename Clock>
+std::size_t BasicStreamMixer<Clock>::mix_over_silence(std::span<std::byte> block, time_point deadline) noexcept
+{
+    drain();
+
+    const std::size_t mixed = accumulate({ }, deadline);
+    if (mixed == 0) {
+        std::fill(acc_.begin(), acc_.end(), 0.0f);
+    }
+    // 经 encode 写静音：U8 等偏置编码的零点不是全零字节
+    (void)audio::dsp::encode_samples(acc_, mix_format_.encoding, block);
+    return mixed;
+}
+
+template <typename Clock>
+typename BasicStreamMixer<Clock>::StreamStats BasicStreamMixer<Clock>::stats(std::size_t stream) const noexcept
+{
+    const auto& s = *streams_[stream];
+    StreamStats st;
+    st.packets_received = s.jb->packets_received();
+    st.packets_lost = s.jb->packets_lost();
+    st.late_packets = s.jb->late_packets();
+    st.ingress_dropped = s.ingress->dropped();
+    st.mixed_blocks = s.mixed_blocks.load(std::memory_order_relaxed);
+    st.skipped_blocks = s.skipped_blocks.load(std::memory_order_relaxed);
+    st.fill_packets = s.jb->buffer_fill_packets();
+    st.target_packets = s.jb->target_latency_packets();
+    return st;
+}
+
+template class BasicStreamMixer<std::chrono::steady_clock>;
+template class BasicStreamMixer<jitter::SimClock>;
+
+} // namespace aqua::client
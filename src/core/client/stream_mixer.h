@@ -0,0 +1,150 @@
+#ifndef AQUA_STREAM_MIXER_H
+#define AQUA_STREAM_MIXER_H
+
+#include "core/audio/dsp/format_converter.h"
+#include "core/jitter_buffer/ingress_queue.h"
+#include "core/jitter_buffer/jitter_buffer.h"
+#include "core/public/audio_format.h"
+#include "core/public/config.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace aqua::client {
+
+// 多服务器订阅的客户端混音级（ClientConfig::mix_sources）：主流之外的每路附加流各有一个
+// IngressQueue + JitterBuffer，在主流 JB 的出队线程上随主流块出队，按各自增益与主流求和。
+// 服务端不感知混音，仍是纯转发。
+//
+// - 主流驱动播放节拍：附加流的块在其 deadline 落在主流块 deadline ± 半包内时混入；
+//   落后超过半包的块丢弃以追上主流（起播对齐 / 服务器间时钟漂移累积到半包时各发生一次），
+//   尚未到期或无时间线（未起播 / 断流重置）时该路本块不参与。附加流自己的自适应 target、
+//   PLC、断流重置照常工作，只是出队时刻对齐到主流块。
+// - 主流无时间线（未起播、静音段服务器停发导致断流重置、服务器闪断）时节拍不停：出队线程按
+//   next_deadline()（附加流中最早的 deadline）出队，mix_over_silence 以静音为底混入到期的附加流，
+//   对齐规则同上，只是由最早的附加流领拍。主流恢复后重新由主流领拍。
+// - 附加流须与主流同采样率（块对齐，不做跨流重采样）；声道数 / 编码不同时经 FormatConverter
+//   转成主流声道布局的 F32，布局相同的 F32 流直接出队到 float 缓冲。
+// - 求和在 float 域：主流解码后乘主流增益，各附加流经 mix_accumulate（SIMD，acc += src · gain）
+//   累加，再编码回主流编码（整数编码饱和，F32 不钳位）。本块无附加流参与时主流增益
+//   直接作用于主流块（apply_gain），增益为 1 时不触碰主流块。
+//
+// 时钟为模板参数（与 BasicJitterBuffer 一致）：运行时 StreamMixer = BasicStreamMixer<steady_clock>，
+// 测试用 BasicStreamMixer<SimClock>。
+//
+// Threading contract: add_stream 单线程调用（会话线程），可与出队线程并发——流槽位在构造时
+// 一次分配（max_streams），新流构造完成后以 release 发布流数，出队线程按 acquire 读到的流数遍历，
+// 附加源可在起播后随 Connect 完成陆续接入；push 在 io 线程（每路单生产者，流索引须在 add_stream
+// 返回后经同步交给 io 线程）；drain / mix / next_deadline / mix_over_silence 在主流 JB 的出队线程；
+// stats 任意线程（已发布的流）。add_stream 预分配该路全部缓冲，push / drain / mix 无分配、无锁。
+template <typename Clock>
+class BasicStreamMixer {
+public:
+    using clock = Clock;
+    using time_point = typename Clock::time_point;
+
+    // 一路附加流：JB 参数与主流同源推导（jitter-buffer 毫秒 → floor / capacity）。
+    struct StreamConfig {
+        AudioFormat format;
+        float gain = 1.0f;
+        std::size_t floor_packets = 0;
+        std::size_t capacity_packets = 0;
+        std::uint32_t detect_window_packets = config::JITTER_DETECT_WINDOW_PACKETS;
+        std::optional<jitter::AdaptiveTargetConfig> adaptive;
+        config::PlcMode plc_mode = config::PlcMode::Repeat;
+    };
+
+    struct StreamStats {
+        std::uint64_t packets_received = 0;
+        std::uint64_t packets_lost = 0;
+        std::uint64_t late_packets = 0;
+        std::uint64_t ingress_dropped = 0; // 入口队列满丢弃
+        std::uint64_t mixed_blocks = 0; // 参与混音的块数
+        std::uint64_t skipped_blocks = 0; // 落后主流而丢弃的块数
+        std::size_t fill_packets = 0;
+        std::size_t target_packets = 0;
+    };
+
+    // mix_format：主流（服务端）格式，混音结果按它编码；primary_gain：主流增益；max_streams：附加流槽位数。
+    BasicStreamMixer(const AudioFormat& mix_format, std::uint32_t frames_per_packet, float primary_gain,
+        std::size_t max_streams = config::MIX_MAX_SOURCES);
+
+    BasicStreamMixer(const BasicStreamMixer&) = delete;
+    BasicStreamMixer& operator=(const BasicStreamMixer&) = delete;
+
+    // 添加一路附加流，返回其索引。格式非法或采样率与主流不同时抛 std::invalid_argument，
+    // 槽位已满抛 std::length_error。
+    std::size_t add_stream(const StreamConfig& stream_cfg);
+
+    [[nodiscard]] std::size_t stream_count() const noexcept { return stream_count_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::size_t max_streams() const noexcept { return streams_.size(); }
+
+    // io 线程：排队 stream 路的一个音频包（payload 拷入该路入口队列）。队满丢弃返回 false。
+    bool push(std::size_t stream, std::chrono::nanoseconds arrival, std::uint32_t sample_position,
+        std::span<const std::byte> payload) noexcept;
+
+    // 出队线程：各路入口队列的包按原到达时刻入 JB。主流尚未起播时也应随出队线程的
+    // 每次唤醒调用，避免入口队列积满丢包。
+    void drain() noexcept;
+
+    // 出队线程：block 为主流刚出队的一块（mix_format，frames_per_packet 帧），deadline 为其播放时刻。
+    // 到期的附加流各出队一块混入 block（原地）。返回参与混音的附加流数。
+    std::size_t mix(std::span<std::byte> block, time_point deadline) noexcept;
+
+    // 出队线程：附加流中最早的下一块 deadline（主流无时间线时领拍）。均无时间线时为空。
+    [[nodiscard]] std::optional<time_point> next_deadline() const noexcept;
+
+    // 出队线程：主流缺席时的一块（mix_format，frames_per_packet 帧）：以静音为底，deadline
+    // 到期的附加流各出队一块混入后写入 block。主流增益不参与。返回参与混音的附加流数（0 时 block 为静音）。
+    std::size_t mix_over_silence(std::span<std::byte> block, time_point deadline) noexcept;
+
+    [[nodiscard]] StreamStats stats(std::size_t stream) const noexcept;
+
+private:
+    struct Stream {
+        std::unique_ptr<jitter::BasicJitterBuffer<Clock>> jb;
+        std::unique_ptr<jitter::IngressQueue> ingress;
+        std::unique_ptr<audio::dsp::FormatConverter> converter; // 空 = 已是主流声道布局的 F32
+        float gain = 1.0f;
+        std::size_t payload_bytes = 0; // 每块 pop_next 输出（附加流格式）
+        std::vector<float> pop; // pop_next 输出；按字节视图使用，无转换时即混音输入
+        std::atomic<std::uint64_t> mixed_blocks { 0 };
+        std::atomic<std::uint64_t> skipped_blocks { 0 };
+    };
+
+    [[nodiscard]] static std::span<std::byte> pop_bytes(Stream& s) noexcept
+    {
+        return std::as_writable_bytes(std::span(s.pop)).first(s.payload_bytes);
+    }
+
+    // 主流块解码到 acc_ 并乘主流增益（本块首个附加流参与时调用一次）。
+    void load_primary(std::span<const std::byte> block) noexcept;
+
+    // deadline 到期的附加流各出队一块累加到 acc_。首个参与的流之前先装载底：primary 为空时
+    // 清零（静音），否则 load_primary。返回参与的流数（0 时 acc_ 未触碰）。
+    std::size_t accumulate(std::span<const std::byte> primary, time_point deadline) noexcept;
+
+    AudioFormat mix_format_;
+    std::uint32_t frames_per_packet_;
+    float primary_gain_;
+    std::chrono::nanoseconds half_packet_;
+    std::vector<std::unique_ptr<Stream>> streams_; // max_streams 个槽位，构造后不再扩容
+    std::atomic<std::size_t> stream_count_ { 0 }; // 已发布的流数（add_stream release / 出队线程 acquire）
+    std::vector<float> acc_; // 混音累加（主流声道布局，一块）
+    std::vector<float> converted_; // FormatConverter 输出（F32，一块）
+};
+
+extern template class BasicStreamMixer<std::chrono::steady_clock>;
+extern template class BasicStreamMixer<jitter::SimClock>;
+
+using StreamMixer = BasicStreamMixer<std::chrono::steady_clock>;
+
+} // namespace aqua::client
+
+#endif // AQUA_STREAM_MIXER_H
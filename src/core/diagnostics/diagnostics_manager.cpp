@@ -39,6 +39,8 @@ void DiagnosticsManager::record_packet_arrival(std::uint32_t sequence,
             prune_samples(arrival_history_, now, RATE_WINDOW);
             while (arrival_history_.size() > MAX_RATE_HISTORY)
                 arrival_history_.pop_front();
+            sender_rate_history_.clear(); // 首包重新定义累积基准
+            sender_rate_history_.push_back({ now, 0.0 });
         }
         return;
     }
@@ -75,6 +77,10 @@ void DiagnosticsManager::record_packet_arrival(std::uint32_t sequence,
         prune_samples(arrival_history_, now, RATE_WINDOW);
         while (arrival_history_.size() > MAX_RATE_HISTORY)
             arrival_history_.pop_front();
+        if (now - sender_rate_history_.back().time >= RATE_ESTIMATE_SPACING) {
+            sender_rate_history_.push_back({ now, static_cast<double>(arrival_pos_accum_) });
+            prune_samples(sender_rate_history_, now, RATE_ESTIMATE_WINDOW);
+        }
     }
 
     last_seq_ = sequence;
@@ -82,6 +88,14 @@ void DiagnosticsManager::record_packet_arrival(std::uint32_t sequence,
     last_arrival_ = now;
 }
 
+void DiagnosticsManager::restart_stream()
+{
+    first_packet_ = true;
+    std::lock_guard<std::mutex> lock(arrival_mutex_);
+    arrival_history_.clear();
+    sender_rate_history_.clear();
+}
+
 void DiagnosticsManager::record_hello_sent()
 {
     last_hello_sent_ns_.store(
@@ -114,8 +128,27 @@ void DiagnosticsManager::record_underrun() { underruns_.fetch_add(1, std::memory
 
 void DiagnosticsManager::record_deadline_miss() { deadline_misses_.fetch_add(1, std::memory_order_relaxed); }
 
+void DiagnosticsManager::record_wakeup_lateness(std::chrono::nanoseconds lateness) noexcept { wakeup_lateness_.record(lateness); }
+
 void DiagnosticsManager::record_rb_rearm() { rb_rearms_.fetch_add(1, std::memory_order_relaxed); }
 
+void DiagnosticsManager::record_device_delay(std::uint32_t frames) { device_delay_frames_.store(frames, std::memory_order_relaxed); }
+
+void DiagnosticsManager::record_drift_compensation(double jb_rate_ppm, double resample_ppm)
+{
+    jb_rate_ppm_.store(jb_rate_ppm, std::memory_order_relaxed);
+    resample_ppm_.store(resample_ppm, std::memory_order_relaxed);
+}
+
+void DiagnosticsManager::record_thread_policy(std::uint32_t applied, std::uint32_t failures, bool memory_locked)
+{
+    thread_policy_applied_.store(applied, std::memory_order_relaxed);
+    thread_policy_failures_.store(failures, std::memory_order_relaxed);
+    memory_locked_.store(memory_locked, std::memory_order_relaxed);
+}
+
+void DiagnosticsManager::record_startup(const StartupTimes& times) { startup_ms_ = times; }
+
 void DiagnosticsManager::record_audio_bytes(std::size_t bytes) { recv_audio_bytes_.fetch_add(bytes, std::memory_order_relaxed); }
 
 void DiagnosticsManager::record_hello_ack() { recv_hello_acks_.fetch_add(1, std::memory_order_relaxed); }
@@ -140,6 +173,21 @@ void DiagnosticsManager::record_rb_occupancy()
     }
 }
 
+std::optional<double> DiagnosticsManager::sender_rate_ppm() const
+{
+    if (sample_rate_ == 0)
+        return std::nullopt;
+    double rate = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(arrival_mutex_);
+        if (sender_rate_history_.size() < 2
+            || sender_rate_history_.back().time - sender_rate_history_.front().time < RATE_ESTIMATE_MIN_SPAN)
+            return std::nullopt;
+        rate = regression_slope(sender_rate_history_);
+    }
+    return (rate / sample_rate_ - 1.0) * 1e6;
+}
+
 void DiagnosticsManager::collect_and_log(const jitter::JitterBuffer& jb)
 {
     // JitterBuffer 指标
@@ -149,6 +197,8 @@ void DiagnosticsManager::collect_and_log(const jitter::JitterBuffer& jb)
     // RingBuffer 指标（当前快照，不复用 slope 窗口）
     std::size_t rb_bytes = rb_fill_fn_ ? rb_fill_fn_() : 0;
     double rb_ms = bytes_to_ms(rb_bytes);
+    double device_ms = bytes_to_ms(
+        static_cast<std::size_t>(device_delay_frames_.load(std::memory_order_relaxed)) * frame_bytes_);
 
     // 记录历史（用于 min/max/avg）
     jb_occupancy_history_ms_.push_back(jb_ms);
@@ -184,6 +234,7 @@ void DiagnosticsManager::collect_and_log(const jitter::JitterBuffer& jb)
 
     auto [jb_avg, jb_min, jb_max] = stats(jb_occupancy_history_ms_);
     auto [rb_avg, rb_min, rb_max] = stats(rb_occupancy_history_ms_);
+    const auto wakeup = wakeup_lateness_.take_interval();
 
     // 构建快照。锁内填局部 snap，并同步一份到 last_snapshot_（供 snapshot() 跨线程读），
     // 锁外直接用 snap 输出日志，避免 snapshot() 的二次加锁拷贝。
@@ -213,14 +264,23 @@ void DiagnosticsManager::collect_and_log(const jitter::JitterBuffer& jb)
         s.underruns = underruns_.load(std::memory_order_relaxed);
         s.deadline_misses = deadline_misses_.load(std::memory_order_relaxed);
         s.rb_rearms = rb_rearms_.load(std::memory_order_relaxed);
+        s.sched_wakeups = wakeup.wakeups;
+        s.sched_wakeup_p50_us = wakeup.p50_us;
+        s.sched_wakeup_p99_us = wakeup.p99_us;
+        s.sched_wakeup_max_us = wakeup.max_us;
+        s.thread_policy_applied = thread_policy_applied_.load(std::memory_order_relaxed);
+        s.thread_policy_failures = thread_policy_failures_.load(std::memory_order_relaxed);
+        s.memory_locked = memory_locked_.load(std::memory_order_relaxed);
+        s.startup_ms = startup_ms_;
+        s.device_delay_ms = device_ms;
         s.recv_audio_bytes = recv_audio_bytes_.load(std::memory_order_relaxed);
         s.recv_hello_acks = recv_hello_acks_.load(std::memory_order_relaxed);
         s.short_slope_samples_per_s = short_slope;
         s.long_slope_samples_per_s = long_slope;
 
         // 端到端延迟 + 时钟漂移
-        // 端到端延迟：当前缓冲量（JB + RB），无需时间同步，语义即"此刻的缓冲延迟"。
-        s.end_to_end_ms = jb_ms + rb_ms;
+        // 端到端延迟：当前缓冲量（JB + RB + 设备缓冲），无需时间同步，语义即"此刻的缓冲延迟"。
+        s.end_to_end_ms = jb_ms + rb_ms + device_ms;
 
         // 时钟漂移：server 发送速率 vs 客户端播放速率的偏差（ppm）。
         // 两者都用最近 RATE_WINDOW 内的线性回归斜率（帧/秒），
@@ -232,6 +292,8 @@ void DiagnosticsManager::collect_and_log(const jitter::JitterBuffer& jb)
         } else {
             s.drift_ppm = 0.0;
         }
+        s.jb_rate_ppm = jb_rate_ppm_.load(std::memory_order_relaxed);
+        s.resample_ppm = resample_ppm_.load(std::memory_order_relaxed);
         last_snapshot_ = snap;
     }
 
@@ -244,17 +306,21 @@ void DiagnosticsManager::collect_and_log(const jitter::JitterBuffer& jb)
         "Client diag: RTT={:.1f}ms jitter={:.2f}ms loss={}/{:.3f}% dup={} late={} malformed={} dmiss={} "
         "JB[{:.0f}/{:.0f}/{:.0f}/{:.0f}/{:.0f}ms target={:.0f}ms] "
         "RB[{:.0f}/{:.0f}/{:.0f}/{:.0f}/{:.0f}ms] "
-        "underrun={} rearm={} slope_s={:.1f} slope_l={:.1f} e2e={:.1f}ms drift={:.1f}ppm "
-        "rx_bytes={} acks={}",
+        "wake[p50/p99/max={:.0f}/{:.0f}/{:.0f}us] "
+        "dev={:.1f}ms underrun={} rearm={} slope_s={:.1f} slope_l={:.1f} e2e={:.1f}ms drift={:.1f}ppm "
+        "comp[jb={:+.0f} rs={:+.0f}ppm] rt[ok={} fail={} mlock={}] rx_bytes={} acks={} ttfa={:.1f}ms",
         snap.rtt_ms, snap.interarrival_jitter_ms,
         total_lost, loss_rate, snap.duplicates, snap.late_packets, snap.jb_malformed_packets,
         snap.deadline_misses,
         snap.jb_current_ms, snap.jb_avg_ms, snap.jb_min_ms, snap.jb_max_ms, snap.jb_capacity_ms,
         snap.jb_target_ms,
         snap.rb_current_ms, snap.rb_avg_ms, snap.rb_min_ms, snap.rb_max_ms, snap.rb_capacity_ms,
-        snap.underruns, snap.rb_rearms, snap.short_slope_samples_per_s, snap.long_slope_samples_per_s,
-        snap.end_to_end_ms, snap.drift_ppm,
-        snap.recv_audio_bytes, snap.recv_hello_acks);
+        snap.sched_wakeup_p50_us, snap.sched_wakeup_p99_us, snap.sched_wakeup_max_us,
+        snap.device_delay_ms, snap.underruns, snap.rb_rearms, snap.short_slope_samples_per_s, snap.long_slope_samples_per_s,
+        snap.end_to_end_ms, snap.drift_ppm, snap.jb_rate_ppm, snap.resample_ppm,
+        snap.thread_policy_applied, snap.thread_policy_failures, snap.memory_locked ? "on" : "off",
+        snap.recv_audio_bytes, snap.recv_hello_acks,
+        snap.startup_ms[static_cast<std::size_t>(StartupStage::FirstAudible)]);
 }
 
 double DiagnosticsManager::bytes_to_ms(std::size_t bytes) const noexcept
@@ -2,14 +2,17 @@
 #define AQUA_DIAGNOSTICS_MANAGER_H
 
 #include "core/audio/ringbuffer/spsc_ringbuffer.h"
+#include "core/diagnostics/lateness_histogram.h"
+#include "core/diagnostics/startup_trace.h"
 #include "core/jitter_buffer/jitter_buffer.h"
+#include "core/rt/function_ref.h"
 
 #include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <deque>
-#include <functional>
 #include <mutex>
+#include <optional>
 
 namespace aqua::diag {
 
@@ -27,9 +30,10 @@ namespace aqua::diag {
 class DiagnosticsManager {
 public:
     // 采样回调：返回当前 RingBuffer available_read 字节数
-    using RingBufferFillFn = std::function<std::size_t()>;
+    using RingBufferFillFn = rt::FunctionRef<std::size_t()>;
     // 播放进度回调：返回 client 已播放的累计样本数（跨 JB 播放累积）
-    using PlayedSamplesFn = std::function<std::uint64_t()>;
+    using PlayedSamplesFn = rt::FunctionRef<std::uint64_t()>;
+    // 两个回调都是非拥有引用：被引用对象须比 DiagnosticsManager 活得久。
 
     // rb_capacity_bytes: RingBuffer 总容量（字节），用于诊断日志显示水位/容量比
     DiagnosticsManager(std::uint32_t sample_rate,
@@ -45,6 +49,11 @@ public:
     // 供 server 发送速率回归使用。
     void record_packet_arrival(std::uint32_t sequence, std::uint32_t sample_position);
 
+    // 新的发送流开始（客户端原位重连换了服务端会话，sample_position 基准不再连续）：
+    // 下一个包按首包处理，清空到达 / 发送速率回归窗口；累计计数器与 jitter EWMA 保留。
+    // 与 record_packet_arrival 同线程（io_context）调用。
+    void restart_stream();
+
     // RTT 测量：发送 HELLO 时记录起点（需在发出 HELLO 前调用）
     void record_hello_sent();
 
@@ -57,10 +66,28 @@ public:
     // 记录一次调度错过 deadline（JB timer 延迟超过 1 个 packet_duration 时）
     void record_deadline_miss();
 
+    // 记录一次 JB 出队调度唤醒的迟到（实际唤醒 - 请求的 deadline），在调度线程 / io 线程调用。
+    // 快照给出每个诊断区间的 p50 / p99 / max。
+    void record_wakeup_lateness(std::chrono::nanoseconds lateness) noexcept;
+
     // 记录一次播放缓冲重臂（pre-roll latch re-arm：饥饿 3 连空仓或低水位看门狗）。
     // 每次重臂伴随一次短静音，是运行点自愈次数的直接指标。
     void record_rb_rearm();
 
+    // 记录播放设备缓冲延迟（后端 device_delay_frames，已写入设备尚未播出的帧数）。
+    // 不支持的后端恒为 0，end_to_end_ms 退化为 JB + RB。
+    void record_device_delay(std::uint32_t frames);
+
+    // 记录漂移补偿回路当前输出（DriftCompensator，ppm；未启用时不调用，快照恒为 0）。
+    void record_drift_compensation(double jb_rate_ppm, double resample_ppm);
+
+    // 记录运行时线程策略的累计应用结果（rt::ThreadPolicyReport::Status，客户端主循环周期同步）。
+    // 失败不影响播放，只在快照与诊断日志中暴露。
+    void record_thread_policy(std::uint32_t applied, std::uint32_t failures, bool memory_locked);
+
+    // 记录本会话的启动时间线（StartupTrace::times，客户端主循环周期同步；阶段全部到达后不再变化）。
+    void record_startup(const StartupTimes& times);
+
     // 记录收到的音频字节数（payload only）
     void record_audio_bytes(std::size_t bytes);
 
@@ -79,6 +106,11 @@ public:
     // 全部指标，生成快照并输出日志。需要外部周期调用，周期：通常 3s。
     void collect_and_log(const jitter::JitterBuffer& jb);
 
+    // 发送端速率相对名义采样率的偏差（ppm，本地 steady_clock 为基准），漂移补偿前馈用。
+    // 与 drift_ppm 的 server 速率同源，但用稀疏长窗口（RATE_ESTIMATE_*）回归：
+    // 逐包 ~1ms 到达抖动在 30s 窗口下只剩个位数 ppm 误差。跨度不足时返回 std::nullopt。
+    [[nodiscard]] std::optional<double> sender_rate_ppm() const;
+
     // ---- 诊断快照 ----
 
     struct Snapshot {
@@ -112,14 +144,34 @@ public:
         std::uint64_t deadline_misses = 0;
         std::uint64_t rb_rearms = 0; // pre-roll latch 重臂次数（饥饿 + 看门狗）
 
+        // JB 出队调度唤醒迟到（本诊断区间；Pull 模式无调度唤醒，恒为 0）
+        std::uint64_t sched_wakeups = 0;
+        double sched_wakeup_p50_us = 0.0;
+        double sched_wakeup_p99_us = 0.0;
+        double sched_wakeup_max_us = 0.0;
+
+        // 线程策略（RuntimeConfig::thread_policies / lock_memory；全部默认时均为 0 / false）
+        std::uint32_t thread_policy_applied = 0; // 生效的调度 / 亲和性设置次数
+        std::uint32_t thread_policy_failures = 0; // 失败次数（含内存锁定），非致命
+        bool memory_locked = false;
+
+        // 启动时间线：各 StartupStage 距会话开始的 ms（0 = 未到达），FirstAudible 即 time-to-first-audio
+        StartupTimes startup_ms { };
+
+        // 播放设备缓冲（ALSA snd_pcm_delay；共享模式后端不上报，为 0）
+        double device_delay_ms = 0.0;
+
         // Buffer occupancy slope (experimental, not clock drift)
         double short_slope_samples_per_s = 0.0;
         double long_slope_samples_per_s = 0.0;
 
-        // 端到端延迟（当前缓冲量 = JB + RB，无需时间同步）
+        // 端到端延迟（当前缓冲量 = JB + RB + 设备缓冲，无需时间同步）
         double end_to_end_ms = 0.0;
         // 时钟漂移（server 发送速率 vs 客户端播放速率的偏差，ppm）
         double drift_ppm = 0.0;
+        // 漂移补偿回路输出（ppm）：JB 出队节拍、pop → RB 重采样比率
+        double jb_rate_ppm = 0.0;
+        double resample_ppm = 0.0;
     };
 
     Snapshot snapshot() const
@@ -167,6 +219,7 @@ private:
     std::deque<TimeSample> arrival_history_; // ~10s，value = 累积 sample_position（帧）
     mutable std::mutex arrival_mutex_;
     std::int64_t arrival_pos_accum_ = 0; // 累积 sample_position（int32 差值累加，避免 uint32 回绕）
+    std::deque<TimeSample> sender_rate_history_; // 稀疏到达历史（RATE_ESTIMATE_SPACING 间隔），同受 arrival_mutex_ 保护
     // 客户端播放速率回归：(时间, 累计播放帧数)，仅主线程访问
     std::deque<TimeSample> played_history_; // ~10s，value = 播放帧数
 
@@ -180,6 +233,14 @@ private:
     std::atomic<std::uint64_t> rb_rearms_ { 0 };
     std::atomic<std::uint64_t> recv_audio_bytes_ { 0 };
     std::atomic<std::uint64_t> recv_hello_acks_ { 0 };
+    std::atomic<std::uint32_t> device_delay_frames_ { 0 };
+    std::atomic<double> jb_rate_ppm_ { 0.0 };
+    std::atomic<double> resample_ppm_ { 0.0 };
+    std::atomic<std::uint32_t> thread_policy_applied_ { 0 };
+    std::atomic<std::uint32_t> thread_policy_failures_ { 0 };
+    std::atomic<bool> memory_locked_ { false };
+    StartupTimes startup_ms_ { }; // record_startup 与 collect_and_log 同在客户端主循环，无需同步
+    LatenessHistogram wakeup_lateness_; // record 在调度线程，take_interval 在主线程 collect_and_log
 
     // 上次快照（collect_and_log 写、snapshot 读，跨线程需保护）
     Snapshot last_snapshot_;
@@ -190,6 +251,9 @@ private:
     static constexpr auto RATE_WINDOW = std::chrono::seconds(10); // 速率回归窗口
     static constexpr std::size_t MAX_HISTORY = 100; // occupancy 历史上限
     static constexpr std::size_t MAX_RATE_HISTORY = 200; // 速率回归历史上限（避免锁内 O(n) 过久）
+    static constexpr auto RATE_ESTIMATE_WINDOW = std::chrono::seconds(30); // sender_rate_ppm 回归窗口
+    static constexpr auto RATE_ESTIMATE_SPACING = std::chrono::milliseconds(50); // 稀疏采样间隔（窗口内 ≤ 600 点）
+    static constexpr auto RATE_ESTIMATE_MIN_SPAN = std::chrono::seconds(5); // 跨度不足时不给估计
 
     double bytes_to_ms(std::size_t bytes) const noexcept;
 
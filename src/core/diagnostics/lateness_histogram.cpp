@@ -0,0 +1,54 @@
+#include "core/diagnostics/lateness_histogram.h"
+
+#include <algorithm>
+
+namespace aqua::diag {
+
+void LatenessHistogram::record(std::chrono::nanoseconds lateness) noexcept
+{
+    const std::int64_t ns = std::max<std::int64_t>(lateness.count(), 0);
+    const auto bucket = std::min<std::size_t>(
+        static_cast<std::size_t>(ns / std::chrono::nanoseconds(BUCKET_WIDTH).count()), BUCKETS);
+    counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    std::int64_t prev = interval_max_ns_.load(std::memory_order_relaxed);
+    while (ns > prev && !interval_max_ns_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) { }
+}
+
+LatenessHistogram::Percentiles LatenessHistogram::take_interval() noexcept
+{
+    std::array<std::uint64_t, BUCKETS + 1> delta { };
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i <= BUCKETS; ++i) {
+        const std::uint64_t now = counts_[i].load(std::memory_order_relaxed);
+        delta[i] = now - taken_[i];
+        taken_[i] = now;
+        total += delta[i];
+    }
+    const double max_us = static_cast<double>(interval_max_ns_.exchange(0, std::memory_order_relaxed)) / 1e3;
+
+    Percentiles p;
+    p.wakeups = total;
+    if (total == 0) {
+        return p;
+    }
+    const auto rank = [&](double q) {
+        const auto target = static_cast<std::uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i <= BUCKETS; ++i) {
+            seen += delta[i];
+            if (seen >= target) {
+                const auto upper = static_cast<double>((i + 1) * BUCKET_WIDTH.count());
+                return std::min(upper, max_us);
+            }
+        }
+        return max_us;
+    };
+    p.p50_us = rank(0.50);
+    p.p99_us = rank(0.99);
+    p.p999_us = rank(0.999);
+    p.max_us = max_us;
+    return p;
+}
+
+} // namespace aqua::diag
@@ -0,0 +1,46 @@
+#ifndef AQUA_LATENESS_HISTOGRAM_H
+#define AQUA_LATENESS_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace aqua::diag {
+
+// 调度唤醒迟到分布：实际唤醒时刻 - 请求的唤醒时刻。
+//
+// 固定 25us 宽的线性桶覆盖 0~25ms，超出计入溢出桶（分位取区间最大值）；提前唤醒按 0 计。
+// record 只做一次 relaxed fetch_add（可在实时线程调用）；take_interval 与上次调用的计数作差，
+// 得到本区间的 p50 / p99 / p99.9 / max，不需要清零热路径正在写的计数器。
+//
+// Threading contract: record 任意线程（通常同一时刻只有一个调度线程）；
+// take_interval 单一消费者线程（客户端主循环的诊断刷新）。
+class LatenessHistogram {
+public:
+    static constexpr std::chrono::microseconds BUCKET_WIDTH { 25 };
+    static constexpr std::size_t BUCKETS = 1000; // 0~25ms，另加一个溢出桶
+
+    struct Percentiles {
+        std::uint64_t wakeups = 0; // 区间内唤醒次数
+        double p50_us = 0.0;
+        double p99_us = 0.0;
+        double p999_us = 0.0;
+        double max_us = 0.0;
+    };
+
+    void record(std::chrono::nanoseconds lateness) noexcept;
+
+    // 自上次调用以来的分位（桶上界，不超过区间最大值）。区间内无样本时全部为 0。
+    [[nodiscard]] Percentiles take_interval() noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKETS + 1> counts_ { };
+    std::atomic<std::int64_t> interval_max_ns_ { 0 };
+    std::array<std::uint64_t, BUCKETS + 1> taken_ { }; // 上次 take_interval 时的计数，仅消费者访问
+};
+
+} // namespace aqua::diag
+
+#endif // AQUA_LATENESS_HISTOGRAM_H
@@ -0,0 +1,41 @@
+#include "core/diagnostics/startup_trace.h"
+
+namespace aqua::diag {
+
+void StartupTrace::begin() noexcept
+{
+    start_ = std::chrono::steady_clock::now();
+    for (auto& offset : offset_ns_) {
+        offset.store(-1, std::memory_order_relaxed);
+    }
+}
+
+void StartupTrace::mark(StartupStage stage) noexcept
+{
+    auto& slot = offset_ns_[static_cast<std::size_t>(stage)];
+    if (slot.load(std::memory_order_relaxed) >= 0) {
+        return;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    const std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    std::int64_t expected = -1;
+    (void)slot.compare_exchange_strong(expected, ns, std::memory_order_relaxed);
+}
+
+bool StartupTrace::reached(StartupStage stage) const noexcept
+{
+    return offset_ns_[static_cast<std::size_t>(stage)].load(std::memory_order_relaxed) >= 0;
+}
+
+StartupTimes StartupTrace::times() const noexcept
+{
+    StartupTimes out { };
+    for (std::size_t i = 0; i < kStartupStageCount; ++i) {
+        const std::int64_t ns = offset_ns_[i].load(std::memory_order_relaxed);
+        // 到达时刻恰为 0ns 不可能（mark 晚于 begin），0 专用于"未到达"
+        out[i] = ns >= 0 ? static_cast<double>(ns) / 1e6 : 0.0;
+    }
+    return out;
+}
+
+} // namespace aqua::diag
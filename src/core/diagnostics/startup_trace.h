@@ -0,0 +1,54 @@
+#ifndef AQUA_STARTUP_TRACE_H
+#define AQUA_STARTUP_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace aqua::diag {
+
+// 客户端启动阶段（time-to-first-audio 分解）。控制面与设备 / UDP 并行推进，阶段完成顺序不固定。
+enum class StartupStage : std::uint8_t {
+    ChannelReady, // gRPC 通道就绪（WaitForConnected）
+    Connected, // Connect RPC 返回（拿到 session_id / 服务端格式）
+    UdpBound, // 本地 UDP 端口绑定
+    DeviceOpened, // 播放后端创建（设备格式协商需服务端格式，计入 PlaybackStarted）
+    PlaybackStarted, // 播放设备启动（fill 回调开始输出静音）
+    HelloAcked, // 首个 HELLO_ACK（数据面握手完成）
+    FirstAudio, // 首个音频包进入 JB
+    FirstAudible, // 首个非静音块交给设备（Timer / 调度线程：pre-roll 完成；Pull：首块出队）
+    Count,
+};
+
+inline constexpr std::size_t kStartupStageCount = static_cast<std::size_t>(StartupStage::Count);
+
+// 每个阶段距会话开始的时长（ms）；0 = 尚未到达（回放模式跳过控制面阶段）。
+using StartupTimes = std::array<double, kStartupStageCount>;
+
+// 单次会话的启动时间线：begin() 记起点，各阶段在完成它的线程上 mark()。
+//
+// 同一阶段只记首次（原位重连不改写）。mark 已到达后只剩一次 relaxed load，可在播放回调
+// / io 线程的热路径调用。Threading contract: begin() 在任何 mark() 之前（会话线程）；
+// mark / times 任意线程。
+class StartupTrace {
+public:
+    StartupTrace() noexcept { begin(); }
+
+    void begin() noexcept;
+
+    void mark(StartupStage stage) noexcept;
+
+    [[nodiscard]] bool reached(StartupStage stage) const noexcept;
+
+    [[nodiscard]] StartupTimes times() const noexcept;
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    std::array<std::atomic<std::int64_t>, kStartupStageCount> offset_ns_ { }; // -1 = 未到达
+};
+
+} // namespace aqua::diag
+
+#endif // AQUA_STARTUP_TRACE_H
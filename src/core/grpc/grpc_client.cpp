@@ -7,13 +7,14 @@
 
 namespace aqua::grpc {
 
-bool GrpcClient::connect_to_server(const std::string& server_ip, std::uint16_t rpc_port)
+bool GrpcClient::connect_to_server(const std::string& server_ip, std::uint16_t rpc_port,
+    std::chrono::milliseconds wait_timeout)
 {
     std::string target = server_ip + ":" + std::to_string(rpc_port);
     auto channel = ::grpc::CreateChannel(target, ::grpc::InsecureChannelCredentials());
 
-    // 等待连接就绪，超时 5 秒
-    auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(5);
+    // 等待连接就绪（默认 5 秒；原位重连用短超时 + 新通道重试，不受通道内部重连退避拖累）
+    auto deadline = std::chrono::system_clock::now() + wait_timeout;
     if (!channel->WaitForConnected(deadline)) {
         auto state = channel->GetState(false);
         log_error_fmt("gRPC: failed to connect to {} (state={})", target,
@@ -54,6 +55,7 @@ bool GrpcClient::connect(const std::string& client_name, ConnectResult& out)
     out.udp_address = resp.udp().address();
     out.udp_port = static_cast<std::uint16_t>(resp.udp().port());
     out.audio_format = from_proto(resp.audio_format());
+    out.resume_token = resp.resume_token();
 
     log_info_fmt("gRPC Connect OK: session=0x{:08X} udp={}:{} format={}ch/{}Hz/enc={}",
         out.session_id, out.udp_address, out.udp_port,
@@ -7,6 +7,7 @@
 
 #include <grpcpp/grpcpp.h>
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -19,6 +20,7 @@ struct ConnectResult {
     std::string udp_address;
     std::uint16_t udp_port = 0;
     AudioFormat audio_format;
+    std::uint64_t resume_token = 0; // 0 = 服务端未下发（旧版本），不尝试 UDP 快速恢复
 };
 
 // gRPC 客户端：同步调用 Connect / Disconnect。
@@ -27,8 +29,9 @@ class GrpcClient {
 public:
     GrpcClient() = default;
 
-    // 连接到 server gRPC 端口。返回 false 表示无法连接。
-    bool connect_to_server(const std::string& server_ip, std::uint16_t rpc_port);
+    // 连接到 server gRPC 端口，最多等待 wait_timeout 通道就绪。返回 false 表示无法连接。
+    bool connect_to_server(const std::string& server_ip, std::uint16_t rpc_port,
+        std::chrono::milliseconds wait_timeout = std::chrono::seconds(5));
 
     // 调用 Connect RPC。返回 false 表示失败。
     bool connect(const std::string& client_name, ConnectResult& out);
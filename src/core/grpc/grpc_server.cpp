@@ -5,9 +5,10 @@
 
 namespace aqua::grpc {
 
-AudioServiceImpl::AudioServiceImpl(SessionManager& sessions, AudioFormat server_format,
-    std::string udp_address, std::uint16_t udp_port)
+AudioServiceImpl::AudioServiceImpl(SessionManager& sessions, const SessionResumer& resumer,
+    AudioFormat server_format, std::string udp_address, std::uint16_t udp_port)
     : sessions_(sessions)
+    , resumer_(resumer)
     , server_format_(server_format)
     , udp_address_(std::move(udp_address))
     , udp_port_(udp_port)
@@ -21,7 +22,8 @@ AudioServiceImpl::AudioServiceImpl(SessionManager& sessions, AudioFormat server_
     log_debug_fmt("gRPC Connect: client_name='{}' peer='{}'",
         req->client_name(), ctx ? ctx->peer() : std::string { "?" });
 
-    auto id = sessions_.create_session();
+    // 避开仍可凭令牌恢复的旧 id：否则旧客户端的扩展 HELLO 会挂到新 session 上。
+    auto id = sessions_.create_session([this](auto candidate) { return resumer_.is_reserved(candidate); });
     if (!id) {
         log_error("Connect: failed to create session");
         return ::grpc::Status(::grpc::StatusCode::INTERNAL, "session creation failed");
@@ -31,6 +33,7 @@ AudioServiceImpl::AudioServiceImpl(SessionManager& sessions, AudioFormat server_
     resp->mutable_udp()->set_address(udp_address_);
     resp->mutable_udp()->set_port(udp_port_);
     *resp->mutable_audio_format() = to_proto(server_format_);
+    resp->set_resume_token(resumer_.mint(*id));
 
     log_info_fmt("Connect: session 0x{:08X} created (client_name='{}')",
         *id, req->client_name());
@@ -54,12 +57,12 @@ AudioServiceImpl::AudioServiceImpl(SessionManager& sessions, AudioFormat server_
 
 // ---- GrpcServer ----
 
-GrpcServer::GrpcServer(SessionManager& sessions, AudioFormat server_format,
+GrpcServer::GrpcServer(SessionManager& sessions, const SessionResumer& resumer, AudioFormat server_format,
     std::string bind_ip, std::uint16_t rpc_port,
     std::string udp_address, std::uint16_t udp_port)
 {
     service_ = std::make_unique<AudioServiceImpl>(
-        sessions, server_format, std::move(udp_address), udp_port);
+        sessions, resumer, server_format, std::move(udp_address), udp_port);
 
     std::string address = bind_ip + ":" + std::to_string(rpc_port);
     ::grpc::ServerBuilder builder;
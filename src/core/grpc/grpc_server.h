@@ -3,6 +3,7 @@
 
 #include "core/public/audio_format.h"
 #include "core/session/session_manager.h"
+#include "core/session/session_resumer.h"
 
 #include <aqua_service.grpc.pb.h>
 
@@ -16,10 +17,10 @@ namespace aqua::grpc {
 
 // gRPC 服务实现：处理 Connect / Disconnect。
 // 保活由 UDP HELLO 负责（server 收到 HELLO 后 establish_udp → touch_session），gRPC 不参与保活。
-// 持有 SessionManager 引用（不拥有），Server 固定 AudioFormat。
+// 持有 SessionManager / SessionResumer 引用（不拥有，Connect 建 session 并签发恢复令牌），Server 固定 AudioFormat。
 class AudioServiceImpl final : public pb::AudioService::Service {
 public:
-    AudioServiceImpl(SessionManager& sessions, AudioFormat server_format,
+    AudioServiceImpl(SessionManager& sessions, const SessionResumer& resumer, AudioFormat server_format,
         std::string udp_address, std::uint16_t udp_port);
 
     ::grpc::Status Connect(::grpc::ServerContext* ctx,
@@ -32,6 +33,7 @@ public:
 
 private:
     SessionManager& sessions_;
+    const SessionResumer& resumer_;
     AudioFormat server_format_;
     std::string udp_address_;
     std::uint16_t udp_port_;
@@ -40,7 +42,7 @@ private:
 // gRPC Server 包装：管理 builder / shutdown 生命周期。
 class GrpcServer {
 public:
-    GrpcServer(SessionManager& sessions, AudioFormat server_format,
+    GrpcServer(SessionManager& sessions, const SessionResumer& resumer, AudioFormat server_format,
         std::string bind_ip, std::uint16_t rpc_port,
         std::string udp_address, std::uint16_t udp_port);
 
@@ -0,0 +1,180 @@
+#include "core/jbsim/arrival_trace.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <random>
+
+namespace aqua::jbsim {
+
+namespace {
+
+    // [0, 1) 均匀分布。不用 std::uniform_real_distribution：其算法由实现定义，
+    // 同一 seed 在不同标准库下的 trace 会不同；这里保证跨平台可复现。
+    double uniform(std::mt19937_64& rng) noexcept
+    {
+        return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+    }
+
+    std::int64_t ms_to_ns(double ms) noexcept
+    {
+        return static_cast<std::int64_t>(std::llround(ms * 1e6));
+    }
+
+    std::string_view trim(std::string_view s) noexcept
+    {
+        const auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+        while (!s.empty() && is_space(s.front())) {
+            s.remove_prefix(1);
+        }
+        while (!s.empty() && is_space(s.back())) {
+            s.remove_suffix(1);
+        }
+        return s;
+    }
+
+    void sort_by_arrival(std::vector<Arrival>& trace)
+    {
+        std::stable_sort(trace.begin(), trace.end(), [](const Arrival& a, const Arrival& b) {
+            return a.arrival_ns < b.arrival_ns;
+        });
+    }
+
+} // namespace
+
+std::optional<NetworkProfile> network_profile_preset(std::string_view name)
+{
+    NetworkProfile p;
+    if (name == "lan") {
+        p.base_delay_ms = 0.5;
+        p.pareto_scale_ms = 0.1;
+        p.pareto_shape = 3.0;
+    } else if (name == "wifi" || name == "wifi-psm") {
+        p.base_delay_ms = 2.0;
+        p.pareto_scale_ms = 1.0;
+        p.pareto_shape = 2.0;
+        p.ge_good_to_bad = 0.001;
+        p.ge_bad_to_good = 0.3;
+        p.ge_loss_bad = 0.5;
+        if (name == "wifi-psm") {
+            p.psm_interval_ms = 102.4; // 标准 beacon 间隔 100 TU
+        }
+    } else if (name == "cellular") {
+        p.base_delay_ms = 30.0;
+        p.pareto_scale_ms = 5.0;
+        p.pareto_shape = 1.8;
+        p.ge_good_to_bad = 0.005;
+        p.ge_bad_to_good = 0.2;
+        p.ge_loss_bad = 0.3;
+    } else if (name == "lossy") {
+        p.base_delay_ms = 5.0;
+        p.pareto_scale_ms = 2.0;
+        p.pareto_shape = 2.2;
+        p.ge_good_to_bad = 0.02;
+        p.ge_bad_to_good = 0.25;
+        p.ge_loss_good = 0.005;
+        p.ge_loss_bad = 0.7;
+    } else {
+        return std::nullopt;
+    }
+    return p;
+}
+
+std::vector<Arrival> generate_trace(const NetworkProfile& profile, std::uint32_t packets,
+    std::chrono::nanoseconds packet_duration)
+{
+    std::mt19937_64 rng(profile.seed);
+    const double interval_ns = static_cast<double>(packet_duration.count()) * (1.0 - profile.drift_ppm * 1e-6);
+    const std::int64_t base_ns = ms_to_ns(profile.base_delay_ms);
+    const std::int64_t psm_ns = ms_to_ns(profile.psm_interval_ms);
+
+    std::vector<Arrival> trace;
+    trace.reserve(packets);
+    bool bad = false;
+    for (std::uint32_t seq = 0; seq < packets; ++seq) {
+        // 每包一次状态转移，再按所在状态丢包（随机数消耗与是否丢包无关，改一项参数不扰动其余）
+        const double u_state = uniform(rng);
+        const double u_loss = uniform(rng);
+        const double u_jitter = uniform(rng);
+        bad = bad ? u_state >= profile.ge_bad_to_good : u_state < profile.ge_good_to_bad;
+        if (u_loss < (bad ? profile.ge_loss_bad : profile.ge_loss_good)) {
+            continue;
+        }
+
+        Arrival a;
+        a.sequence = seq;
+        a.send_ns = static_cast<std::int64_t>(std::llround(static_cast<double>(seq) * interval_ns));
+        a.arrival_ns = a.send_ns + base_ns;
+        if (profile.pareto_scale_ms > 0.0) {
+            // 1 - u ∈ (0, 1]，避免 pow(0, 负数)
+            const double extra_ms = profile.pareto_scale_ms * (std::pow(1.0 - u_jitter, -1.0 / profile.pareto_shape) - 1.0);
+            a.arrival_ns += ms_to_ns(extra_ms);
+        }
+        if (psm_ns > 0) {
+            a.arrival_ns = (a.arrival_ns + psm_ns - 1) / psm_ns * psm_ns;
+        }
+        trace.push_back(a);
+    }
+    sort_by_arrival(trace);
+    return trace;
+}
+
+std::optional<std::vector<Arrival>> parse_trace(std::string_view text,
+    std::chrono::nanoseconds packet_duration)
+{
+    std::vector<Arrival> trace;
+    std::int64_t first_seq = 0;
+    std::int64_t last_seq = 0;
+    while (!text.empty()) {
+        const auto eol = text.find('\n');
+        auto line = trim(text.substr(0, eol));
+        text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        std::int64_t arrival_us = 0;
+        std::uint32_t seq = 0;
+        const char* end = line.data() + line.size();
+        auto [p, ec] = std::from_chars(line.data(), end, arrival_us);
+        if (ec != std::errc { } || p == end || (*p != ' ' && *p != '\t')) {
+            return std::nullopt;
+        }
+        while (p != end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+        auto [q, ec2] = std::from_chars(p, end, seq);
+        if (ec2 != std::errc { } || q != end) {
+            return std::nullopt;
+        }
+
+        // sequence 展开：相对上一行按有符号 32 位差值累加
+        if (trace.empty()) {
+            first_seq = seq;
+            last_seq = seq;
+        } else {
+            last_seq += static_cast<std::int32_t>(seq - static_cast<std::uint32_t>(last_seq));
+        }
+        Arrival a;
+        a.sequence = seq;
+        a.arrival_ns = arrival_us * 1000;
+        a.send_ns = (last_seq - first_seq) * packet_duration.count();
+        trace.push_back(a);
+    }
+    if (trace.empty()) {
+        return std::nullopt;
+    }
+
+    // 发送时刻平移：最小传输时延归零
+    std::int64_t min_transit = trace.front().arrival_ns - trace.front().send_ns;
+    for (const auto& a : trace) {
+        min_transit = std::min(min_transit, a.arrival_ns - a.send_ns);
+    }
+    for (auto& a : trace) {
+        a.send_ns += min_transit;
+    }
+    sort_by_arrival(trace);
+    return trace;
+}
+
+} // namespace aqua::jbsim
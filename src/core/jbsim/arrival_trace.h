@@ -0,0 +1,62 @@
+#ifndef AQUA_ARRIVAL_TRACE_H
+#define AQUA_ARRIVAL_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace aqua::jbsim {
+
+// 一个到达事件（时间相对 trace 起点，纳秒）。
+struct Arrival {
+    std::int64_t arrival_ns = 0;
+    std::int64_t send_ns = 0; // 发送时刻（仿真器据此计算播放延迟）
+    std::uint32_t sequence = 0;
+};
+
+// 合成网络模型。各效应可叠加：发送 → 漂移 → 基础时延 + Pareto 抖动 → Wi-Fi 省电突发 → Gilbert-Elliott 丢包。
+struct NetworkProfile {
+    // 固定单程时延（ms）
+    double base_delay_ms = 1.0;
+
+    // Pareto 抖动：额外时延 = scale × (U^(-1/shape) - 1)，重尾、非负。scale = 0 关闭。
+    double pareto_scale_ms = 0.0;
+    double pareto_shape = 2.5; // > 0；越小尾部越重
+
+    // Gilbert-Elliott 丢包：Good/Bad 两状态马尔可夫链，每包按状态转移概率切换，
+    // 再按所在状态的丢包率丢弃。默认全程 Good 且不丢包。
+    double ge_good_to_bad = 0.0;
+    double ge_bad_to_good = 1.0;
+    double ge_loss_good = 0.0;
+    double ge_loss_bad = 1.0;
+
+    // Wi-Fi 省电突发：终端每 psm_interval_ms 醒来一次（beacon），期间到达 AP 的包
+    // 攒到下一个唤醒时刻一并送达。0 = 关闭。
+    double psm_interval_ms = 0.0;
+
+    // 时钟漂移：发送端包间隔 = packet_duration × (1 - drift_ppm × 1e-6)
+    // （正值 = 发送端时钟快，包到得比接收端播放快）。
+    double drift_ppm = 0.0;
+
+    std::uint64_t seed = 1;
+};
+
+// 预置网络剖面：lan / wifi / wifi-psm / cellular / lossy。未知名称返回 std::nullopt。
+[[nodiscard]] std::optional<NetworkProfile> network_profile_preset(std::string_view name);
+
+// 按剖面生成 packets 个包的到达序列（已丢弃丢失的包，按到达时刻排序）。确定性：同 seed 同结果。
+[[nodiscard]] std::vector<Arrival> generate_trace(const NetworkProfile& profile, std::uint32_t packets,
+    std::chrono::nanoseconds packet_duration);
+
+// 解析录制的到达 trace：每行 "<arrival_us> <sequence>"，空行与 '#' 开头的行忽略。
+// 发送时刻按 sequence × packet_duration 推算并平移，使最快到达的包传输时延为 0
+// （录制端与发送端时钟无共同基准，延迟只能相对最小传输时延）。
+// sequence 相对首行按有符号差值展开（允许回绕）。格式错误返回 std::nullopt。
+[[nodiscard]] std::optional<std::vector<Arrival>> parse_trace(std::string_view text,
+    std::chrono::nanoseconds packet_duration);
+
+} // namespace aqua::jbsim
+
+#endif // AQUA_ARRIVAL_TRACE_H
@@ -0,0 +1,146 @@
+#include "core/jbsim/jb_simulator.h"
+#include "core/jitter_buffer/jitter_buffer.h"
+#include "core/jitter_buffer/sim_clock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace aqua::jbsim {
+
+namespace {
+
+    using jitter::SimClock;
+
+    Distribution summarize(std::vector<double>& samples)
+    {
+        Distribution d;
+        if (samples.empty()) {
+            return d;
+        }
+        std::sort(samples.begin(), samples.end());
+        // nearest-rank 分位
+        const auto rank = [&](double q) {
+            const auto idx = static_cast<std::size_t>(std::ceil(q * static_cast<double>(samples.size())));
+            return samples[std::clamp<std::size_t>(idx, 1, samples.size()) - 1];
+        };
+        d.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+        d.p50 = rank(0.50);
+        d.p95 = rank(0.95);
+        d.p99 = rank(0.99);
+        d.max = samples.back();
+        return d;
+    }
+
+} // namespace
+
+SimReport simulate(const SimConfig& cfg, std::span<const Arrival> trace)
+{
+    const auto wall_start = std::chrono::steady_clock::now();
+
+    const auto sizing = jitter::derive_jitter_sizing(cfg.jitter_buffer_ms, cfg.format.sample_rate, cfg.frames_per_packet);
+    jitter::AdaptiveTargetConfig adapt_cfg { };
+    adapt_cfg.max_packets = sizing.ceiling_packets;
+    adapt_cfg.time_stretch = cfg.time_stretch;
+    adapt_cfg.estimator = cfg.estimator;
+    jitter::BasicJitterBuffer<SimClock> jb(cfg.format, cfg.frames_per_packet,
+        sizing.floor_packets, sizing.capacity_packets,
+        cfg.detect_window_packets, cfg.drift_rebase_late_count,
+        adapt_cfg, 0, cfg.plc_mode);
+
+    SimReport report;
+    if (trace.empty()) {
+        return report;
+    }
+
+    const std::size_t payload_size = static_cast<std::size_t>(cfg.frames_per_packet) * cfg.format.frame_bytes();
+    const std::vector<std::byte> payload(payload_size);
+    std::vector<std::byte> out(payload_size);
+    const double packet_ms = static_cast<double>(cfg.frames_per_packet) * 1000.0 / cfg.format.sample_rate;
+
+    // 按 sequence（相对最小值）索引发送时刻，供播放延迟计算
+    const std::uint32_t first_seq = std::min_element(trace.begin(), trace.end(), [&](const Arrival& a, const Arrival& b) {
+        return static_cast<std::int32_t>(a.sequence - trace.front().sequence)
+            < static_cast<std::int32_t>(b.sequence - trace.front().sequence);
+    })->sequence;
+    std::vector<std::int64_t> send_ns;
+    for (const auto& a : trace) {
+        const std::size_t index = a.sequence - first_seq;
+        if (index >= send_ns.size()) {
+            send_ns.resize(index + 1, std::numeric_limits<std::int64_t>::min());
+        }
+        send_ns[index] = a.send_ns;
+    }
+
+    // 虚拟时间：trace 时刻 t 对应 epoch + (t - t0)；epoch 取当前虚拟时刻保证跨次调用单调
+    const auto epoch = SimClock::now();
+    const std::int64_t t0 = trace.front().arrival_ns;
+    const auto to_trace_ns = [&](SimClock::time_point t) {
+        return (t - epoch).count() + t0;
+    };
+
+    std::vector<double> latency;
+    std::vector<double> runs;
+    std::vector<double> targets;
+    latency.reserve(trace.size());
+    targets.reserve(trace.size());
+    std::uint64_t run = 0;
+
+    std::size_t next = 0;
+    for (;;) {
+        const auto deadline = jb.next_playout_deadline();
+        const bool arrivals_left = next < trace.size();
+        if (!arrivals_left && (!deadline || jb.buffer_fill_packets() == 0)) {
+            break;
+        }
+
+        const auto arrival_time = arrivals_left
+            ? epoch + std::chrono::nanoseconds(trace[next].arrival_ns - t0)
+            : SimClock::time_point::max();
+        if (deadline && *deadline <= arrival_time) {
+            SimClock::set(std::max(SimClock::now(), *deadline));
+            const std::uint32_t seq = jb.next_sequence();
+            targets.push_back(static_cast<double>(jb.target_latency_packets()) * packet_ms);
+            ++report.blocks_played;
+            if (jb.pop_next(out)) {
+                const std::size_t index = seq - first_seq;
+                if (index < send_ns.size() && send_ns[index] != std::numeric_limits<std::int64_t>::min()) {
+                    latency.push_back(static_cast<double>(to_trace_ns(SimClock::now()) - send_ns[index]) / 1e6);
+                }
+                if (run > 0) {
+                    runs.push_back(static_cast<double>(run));
+                    run = 0;
+                }
+            } else {
+                ++report.blocks_concealed;
+                ++run;
+            }
+        } else {
+            SimClock::set(std::max(SimClock::now(), arrival_time));
+            jb.push(trace[next].sequence, payload);
+            ++report.packets_arrived;
+            ++next;
+        }
+    }
+    if (run > 0) {
+        runs.push_back(static_cast<double>(run));
+    }
+
+    report.late_packets = jb.late_packets();
+    report.duplicates = jb.duplicates();
+    report.rebases = jb.rebases();
+    report.concealed_pct = report.blocks_played > 0
+        ? static_cast<double>(report.blocks_concealed) * 100.0 / static_cast<double>(report.blocks_played)
+        : 0.0;
+    report.latency_ms = summarize(latency);
+    report.conceal_run_blocks = summarize(runs);
+    report.target_ms = summarize(targets);
+    report.simulated_s = std::chrono::duration<double>(SimClock::now() - epoch).count();
+    report.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    return report;
+}
+
+} // namespace aqua::jbsim
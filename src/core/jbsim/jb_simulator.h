@@ -0,0 +1,64 @@
+#ifndef AQUA_JB_SIMULATOR_H
+#define AQUA_JB_SIMULATOR_H
+
+#include "core/jbsim/arrival_trace.h"
+#include "core/public/audio_format.h"
+#include "core/public/config.h"
+
+#include <cstdint>
+#include <span>
+
+namespace aqua::jbsim {
+
+// 仿真的 JB 运行点。尺寸与自适应参数按客户端运行时同一规则推导
+// （derive_jitter_sizing + ceiling 作为自适应上限），仿真结果可直接对应线上配置。
+struct SimConfig {
+    AudioFormat format { AudioEncoding::PcmF32LE, 2, 48000 };
+    std::uint32_t frames_per_packet = config::AUDIO_FRAMES_PER_PACKET;
+    std::uint32_t jitter_buffer_ms = config::DEFAULT_JITTER_BUFFER_MS;
+    std::uint32_t detect_window_packets = config::JITTER_DETECT_WINDOW_PACKETS;
+    std::uint32_t drift_rebase_late_count = config::JITTER_DRIFT_REBASE_LATE_COUNT;
+    config::JitterEstimator estimator = config::JitterEstimator::LateCount;
+    config::PlcMode plc_mode = config::PlcMode::Repeat;
+    bool time_stretch = true;
+};
+
+// 分布摘要（空样本时全 0）
+struct Distribution {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+struct SimReport {
+    std::uint64_t packets_arrived = 0; // trace 中到达（push）的包
+    std::uint64_t blocks_played = 0; // pop 次数
+    std::uint64_t blocks_concealed = 0; // pop 输出含隐藏/静音的次数
+    std::uint64_t late_packets = 0;
+    std::uint64_t duplicates = 0;
+    std::uint64_t rebases = 0;
+    double concealed_pct = 0.0;
+
+    // 真实播放块的 发送 → 播放 延迟（ms）。时间伸缩进行中一次 pop 可能取多个块，
+    // 此时按 pop 前的 next_sequence 记一个样本（近似）。
+    Distribution latency_ms;
+    // 连续隐藏段长度（块数）
+    Distribution conceal_run_blocks;
+    // 每次 pop 时的 target（ms）；pop 等间隔，即时间加权分布
+    Distribution target_ms;
+
+    double simulated_s = 0.0;
+    double wall_s = 0.0;
+};
+
+// 以虚拟时钟（SimClock）驱动 BasicJitterBuffer：到达事件按 trace 时刻 push，pop 恰在
+// next_playout_deadline 执行，两类事件按时间顺序交错，无真实等待。trace 耗尽且 JB
+// 清空后结束。同一线程内多次调用的虚拟时间单调延续。
+// 构造参数非法（如 format 无效）时抛出 std::invalid_argument（同 JitterBuffer）。
+[[nodiscard]] SimReport simulate(const SimConfig& cfg, std::span<const Arrival> trace);
+
+} // namespace aqua::jbsim
+
+#endif // AQUA_JB_SIMULATOR_H
@@ -0,0 +1,245 @@
+#include "core/jitter_buffer/concealment.h"
+#include "core/audio/dsp/sample_convert.h"
+#include "core/public/config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace aqua::jitter {
+
+namespace {
+    // 粗搜的目标分析采样率：48kHz 下每 4 帧取 1，基音分辨率 ~0.08ms，精搜再补回。
+    constexpr std::uint32_t COARSE_ANALYSIS_RATE = 12000;
+} // namespace
+
+ConcealmentEngine::ConcealmentEngine(const AudioFormat& format, std::uint32_t frames_per_packet)
+    : format_(format)
+    , channels_(format.channels)
+    , packet_frames_(frames_per_packet)
+    , payload_size_(static_cast<std::size_t>(frames_per_packet) * format.frame_bytes())
+{
+    const std::uint32_t rate = format.sample_rate;
+    min_lag_ = std::max<std::uint32_t>(1, rate / config::PLC_PITCH_MAX_HZ);
+    max_lag_ = std::max(min_lag_, rate / config::PLC_PITCH_MIN_HZ);
+    match_frames_ = std::max<std::uint32_t>(1, rate * config::PLC_MATCH_WINDOW_MS / 1000);
+    decimation_ = std::max<std::uint32_t>(1, rate / COARSE_ANALYSIS_RATE);
+    hold_frames_ = rate * config::PLC_HOLD_MS / 1000;
+    fade_frames_ = std::max(hold_frames_ + 1, rate * config::PLC_FADE_MS / 1000);
+
+    // 历史需覆盖最长周期 + 模板，按整包向上取整。
+    const std::size_t needed = static_cast<std::size_t>(max_lag_) + match_frames_;
+    raw_packets_ = std::max<std::size_t>(1, (needed + packet_frames_ - 1) / packet_frames_);
+    const std::size_t history_frames = raw_packets_ * packet_frames_;
+
+    raw_.resize(raw_packets_ * payload_size_);
+    history_.resize(history_frames * channels_);
+    mono_.resize(history_frames);
+    loop_.resize(history_frames * channels_);
+    work_.resize(packet_frames_ * channels_);
+    blend_.resize(std::min<std::size_t>(min_lag_, packet_frames_) * channels_);
+}
+
+void ConcealmentEngine::on_real(std::span<std::byte> pcm) noexcept
+{
+    if (pcm.size() < payload_size_) {
+        return;
+    }
+
+    if (in_gap_) {
+        in_gap_ = false;
+        // 恢复交叉淡化：隐藏信号再续写 n 帧，与真实包开头按线性权重混合。
+        // 隐藏已衰减到零时等价于从静音淡入。
+        if (period_ != 0) {
+            const std::size_t n = blend_.size() / channels_;
+            const std::size_t bytes = n * format_.frame_bytes();
+            render(blend_, n);
+            audio::dsp::decode_samples(pcm.first(bytes), format_.encoding, work_);
+            for (std::size_t f = 0; f < n; ++f) {
+                const float w = static_cast<float>(f + 1) / static_cast<float>(n + 1);
+                for (std::size_t c = 0; c < channels_; ++c) {
+                    const std::size_t i = f * channels_ + c;
+                    work_[i] = blend_[i] * (1.0f - w) + work_[i] * w;
+                }
+            }
+            audio::dsp::encode_samples(std::span<const float>(work_).first(n * channels_), format_.encoding,
+                pcm.first(bytes));
+        }
+    }
+
+    remember(pcm.first(payload_size_));
+}
+
+void ConcealmentEngine::conceal(std::span<std::byte> out) noexcept
+{
+    if (out.size() < payload_size_) {
+        return;
+    }
+    if (!in_gap_) {
+        begin_gap();
+    }
+
+    if (period_ == 0 || gap_frames_ >= fade_frames_) {
+        std::fill(work_.begin(), work_.end(), 0.0f);
+    } else {
+        render(work_, packet_frames_);
+    }
+    audio::dsp::encode_samples(work_, format_.encoding, out.first(payload_size_));
+
+    // 隐藏输出同样记入历史：下一次缺口从"实际播放过的"波形继续，接缝连续。
+    remember(out.first(payload_size_));
+}
+
+void ConcealmentEngine::reset() noexcept
+{
+    raw_head_ = 0;
+    raw_count_ = 0;
+    in_gap_ = false;
+    gap_frames_ = 0;
+    loop_pos_ = 0;
+}
+
+void ConcealmentEngine::begin_gap() noexcept
+{
+    in_gap_ = true;
+    gap_frames_ = 0;
+    loop_pos_ = 0;
+    if (raw_count_ == 0) {
+        period_ = 0;
+        return;
+    }
+
+    // 原始历史按时间顺序（最旧 → 最新）解码
+    const std::size_t frames = raw_count_ * packet_frames_;
+    const std::size_t packet_samples = packet_frames_ * channels_;
+    std::size_t packet = (raw_head_ + raw_packets_ - raw_count_) % raw_packets_;
+    for (std::size_t k = 0; k < raw_count_; ++k) {
+        audio::dsp::decode_samples(std::span<const std::byte>(raw_).subspan(packet * payload_size_, payload_size_),
+            format_.encoding, std::span<float>(history_).subspan(k * packet_samples, packet_samples));
+        packet = (packet + 1) % raw_packets_;
+    }
+
+    const float inv_channels = 1.0f / static_cast<float>(channels_);
+    for (std::size_t f = 0; f < frames; ++f) {
+        float sum = 0.0f;
+        for (std::size_t c = 0; c < channels_; ++c) {
+            sum += history_[f * channels_ + c];
+        }
+        mono_[f] = sum * inv_channels;
+    }
+
+    // 历史不足一个搜索窗（起播后头几个包）时整段循环，不做接缝淡化。
+    std::size_t period = find_period(frames);
+    std::size_t overlap = 0;
+    if (period == 0) {
+        period = frames;
+    } else {
+        overlap = std::min(period / 4, frames - period);
+    }
+
+    // 循环段 = 历史最后 period 帧；尾部 overlap 帧渐变到段首之前的样本
+    // （history[end - 2·period + k]），环回到段首时即与原波形自然衔接。
+    const std::size_t base = frames - period;
+    std::copy_n(history_.begin() + static_cast<std::ptrdiff_t>(base * channels_), period * channels_, loop_.begin());
+    for (std::size_t j = 0; j < overlap; ++j) {
+        const std::size_t k = period - overlap + j;
+        const float w = static_cast<float>(j + 1) / static_cast<float>(overlap + 1);
+        for (std::size_t c = 0; c < channels_; ++c) {
+            const float prior = history_[(base - period + k) * channels_ + c];
+            loop_[k * channels_ + c] = loop_[k * channels_ + c] * (1.0f - w) + prior * w;
+        }
+    }
+    period_ = static_cast<std::uint32_t>(period);
+}
+
+std::uint32_t ConcealmentEngine::find_period(std::size_t frames) const noexcept
+{
+    const std::size_t window = match_frames_;
+    if (frames < static_cast<std::size_t>(min_lag_) + window) {
+        return 0;
+    }
+    const auto max_lag = static_cast<std::uint32_t>(std::min<std::size_t>(max_lag_, frames - window));
+    const float* tmpl = mono_.data() + frames - window;
+
+    // 归一化互相关；任一侧能量近零（静音）时记 0。
+    const auto score = [&](std::uint32_t lag, std::uint32_t stride) noexcept {
+        const float* cand = tmpl - lag;
+        float xy = 0.0f;
+        float xx = 0.0f;
+        float yy = 0.0f;
+        for (std::size_t i = 0; i < window; i += stride) {
+            xy += tmpl[i] * cand[i];
+            xx += tmpl[i] * tmpl[i];
+            yy += cand[i] * cand[i];
+        }
+        constexpr float ENERGY_EPSILON = 1e-9f;
+        if (xx < ENERGY_EPSILON || yy < ENERGY_EPSILON) {
+            return 0.0f;
+        }
+        return xy / std::sqrt(xx * yy);
+    };
+
+    // 粗搜：lag 与模板同按 decimation_ 步进
+    std::uint32_t coarse = max_lag;
+    float best = -1.0f;
+    for (std::uint32_t lag = min_lag_; lag <= max_lag; lag += decimation_) {
+        const float s = score(lag, decimation_);
+        if (s > best) {
+            best = s;
+            coarse = lag;
+        }
+    }
+
+    // 精搜：全速率 ±decimation_
+    const std::uint32_t lo = coarse > min_lag_ + decimation_ ? coarse - decimation_ : min_lag_;
+    const std::uint32_t hi = std::min(max_lag, coarse + decimation_);
+    std::uint32_t fine = coarse;
+    best = -1.0f;
+    for (std::uint32_t lag = lo; lag <= hi; ++lag) {
+        const float s = score(lag, 1);
+        if (s > best) {
+            best = s;
+            fine = lag;
+        }
+    }
+
+    // 非周期信号：短周期循环会蜂鸣，取最长周期
+    return best < config::PLC_MIN_CORRELATION ? max_lag : fine;
+}
+
+float ConcealmentEngine::gap_gain(std::uint32_t gap_frame) const noexcept
+{
+    if (gap_frame < hold_frames_) {
+        return 1.0f;
+    }
+    if (gap_frame >= fade_frames_) {
+        return 0.0f;
+    }
+    return 1.0f - static_cast<float>(gap_frame - hold_frames_) / static_cast<float>(fade_frames_ - hold_frames_);
+}
+
+void ConcealmentEngine::render(std::span<float> out, std::size_t frames) noexcept
+{
+    for (std::size_t f = 0; f < frames; ++f) {
+        const float g = gap_gain(gap_frames_);
+        const float* src = loop_.data() + static_cast<std::size_t>(loop_pos_) * channels_;
+        for (std::size_t c = 0; c < channels_; ++c) {
+            out[f * channels_ + c] = src[c] * g;
+        }
+        if (++loop_pos_ == period_) {
+            loop_pos_ = 0;
+        }
+        if (gap_frames_ < fade_frames_) {
+            ++gap_frames_;
+        }
+    }
+}
+
+void ConcealmentEngine::remember(std::span<const std::byte> pcm) noexcept
+{
+    std::memcpy(raw_.data() + raw_head_ * payload_size_, pcm.data(), payload_size_);
+    raw_head_ = (raw_head_ + 1) % raw_packets_;
+    raw_count_ = std::min(raw_count_ + 1, raw_packets_);
+}
+
+} // namespace aqua::jitter
@@ -0,0 +1,93 @@
+#ifndef AQUA_CONCEALMENT_H
+#define AQUA_CONCEALMENT_H
+
+#include "core/public/audio_format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace aqua::jitter {
+
+// 波形相似度丢包隐藏（PlcMode::Waveform，WSOLA / G.711 Appendix I 思路）。
+//
+// - 历史：最近若干包的实际输出（真实包与隐藏输出都记入），原始字节环形保存；
+//   真实路径只做一次 memcpy，解码与分析只在缺口首包发生。
+// - 缺口首包：历史混成单声道，在 [1/PLC_PITCH_MAX_HZ, 1/PLC_PITCH_MIN_HZ] 内按归一化
+//   互相关找与末尾模板最相似的周期 L（先按 ~12kHz 抽取粗搜，再全速率 ±1 个抽取步精搜）。
+//   相关度不足（噪声/清音）时取最长周期。
+// - 延续：循环播放历史最后一个周期；循环段尾部 L/4 与"段首之前的真实样本"交叉淡化，
+//   使环接缝与自然波形连续。跨包保持循环相位，连续丢包不会在包边界重启。
+// - 衰减：缺口内前 PLC_HOLD_MS 满幅，之后线性衰减，PLC_FADE_MS 时归零。
+// - 恢复：真实包到达时，其开头最短基音周期长度（1/PLC_PITCH_MAX_HZ）与隐藏信号的延续
+//   交叉淡化，消除硬切。
+//
+// 构造时预分配全部内存；on_real / conceal 无分配、无锁。
+// Threading contract: 与所属 JitterBuffer 的 push/pop_next 同线程调用。
+class ConcealmentEngine {
+public:
+    ConcealmentEngine(const AudioFormat& format, std::uint32_t frames_per_packet);
+
+    ConcealmentEngine(const ConcealmentEngine&) = delete;
+    ConcealmentEngine& operator=(const ConcealmentEngine&) = delete;
+
+    // 真实包即将输出时调用（pcm 为一包 PCM，原地修改）：上一包为隐藏输出时先做恢复
+    // 交叉淡化，然后把 pcm 记入历史。
+    void on_real(std::span<std::byte> pcm) noexcept;
+
+    // 输出一包隐藏 PCM 到 out（一包大小）。无历史时输出静音（编码零点）。
+    void conceal(std::span<std::byte> out) noexcept;
+
+    // 清空历史与缺口状态（时间线重建时调用）。
+    void reset() noexcept;
+
+    // 最近一次缺口选定的循环周期（帧）；0 = 尚未隐藏或无历史。
+    [[nodiscard]] std::uint32_t period_frames() const noexcept { return period_; }
+
+private:
+    // 缺口首包：把原始历史解码到 history_，选周期并建立循环段 loop_。
+    void begin_gap() noexcept;
+    // 在 mono_[0, frames) 上搜索周期；历史不足以搜索时返回 0。
+    [[nodiscard]] std::uint32_t find_period(std::size_t frames) const noexcept;
+    // 缺口内第 gap_frame 帧的衰减增益。
+    [[nodiscard]] float gap_gain(std::uint32_t gap_frame) const noexcept;
+    // 从循环段续写 frames 帧（含衰减）到 out，推进循环相位与缺口计时。
+    void render(std::span<float> out, std::size_t frames) noexcept;
+    // 把一包 PCM 追加到原始历史环。
+    void remember(std::span<const std::byte> pcm) noexcept;
+
+    AudioFormat format_;
+    std::size_t channels_;
+    std::size_t packet_frames_;
+    std::size_t payload_size_;
+
+    std::uint32_t min_lag_; // 最短周期（帧），也是恢复交叉淡化长度
+    std::uint32_t max_lag_; // 最长周期（帧）
+    std::uint32_t match_frames_; // 互相关模板长度（帧）
+    std::uint32_t decimation_; // 粗搜抽取步长
+    std::uint32_t hold_frames_;
+    std::uint32_t fade_frames_;
+
+    // 原始历史环：raw_packets_ 包，raw_head_ 为下一写入位置。
+    std::vector<std::byte> raw_;
+    std::size_t raw_packets_;
+    std::size_t raw_head_ = 0;
+    std::size_t raw_count_ = 0;
+
+    // 分析/合成缓冲（float 交织，构造时按最大需求预分配）
+    std::vector<float> history_;
+    std::vector<float> mono_;
+    std::vector<float> loop_;
+    std::vector<float> work_;
+    std::vector<float> blend_;
+
+    std::uint32_t period_ = 0; // 当前循环周期（帧），0 = 无历史，输出静音
+    std::uint32_t loop_pos_ = 0; // 循环相位（帧）
+    std::uint32_t gap_frames_ = 0; // 缺口已隐藏帧数
+    bool in_gap_ = false;
+};
+
+} // namespace aqua::jitter
+
+#endif // AQUA_CONCEALMENT_H
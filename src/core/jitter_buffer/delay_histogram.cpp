@@ -0,0 +1,46 @@
+#include "core/jitter_buffer/delay_histogram.h"
+
+#include <algorithm>
+
+namespace aqua::jitter {
+
+DelayHistogram::DelayHistogram(std::size_t buckets, float forget_factor)
+    : buckets_(std::max<std::size_t>(1, buckets), 0.0f)
+    , forget_factor_(forget_factor)
+{
+    reset();
+}
+
+void DelayHistogram::add(std::size_t bucket) noexcept
+{
+    for (auto& b : buckets_) {
+        b *= forget_factor_;
+    }
+    buckets_[std::min(bucket, buckets_.size() - 1)] += 1.0f - forget_factor_;
+}
+
+std::size_t DelayHistogram::quantile(float q) const noexcept
+{
+    // 按实际总质量归一：浮点累积误差下总和会轻微偏离 1。
+    float total = 0.0f;
+    for (const float b : buckets_) {
+        total += b;
+    }
+    const float threshold = q * total;
+    float sum = 0.0f;
+    for (std::size_t k = 0; k < buckets_.size(); ++k) {
+        sum += buckets_[k];
+        if (sum >= threshold) {
+            return k;
+        }
+    }
+    return buckets_.size() - 1;
+}
+
+void DelayHistogram::reset() noexcept
+{
+    std::fill(buckets_.begin(), buckets_.end(), 0.0f);
+    buckets_[0] = 1.0f;
+}
+
+} // namespace aqua::jitter
@@ -0,0 +1,41 @@
+#ifndef AQUA_DELAY_HISTOGRAM_H
+#define AQUA_DELAY_HISTOGRAM_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace aqua::jitter {
+
+// 到达延迟直方图（JitterEstimator::Histogram，NetEq DelayManager 思路）。
+//
+// 桶 k 记录"需要 k 包缓冲才能按时播放"的包所占比例（最后一桶兼收更大延迟）。
+// 每次 add 先把全部桶乘以遗忘因子 f，再给命中桶加 (1 - f)：总质量恒为 1，
+// 旧样本按 f^n 指数淡出，分布随网络变化在 ~1/(1-f) 包内迁移到位。
+// 初始（及 reset 后）全部质量在桶 0，即"无抖动"先验。
+//
+// 构造时预分配；add / quantile 无分配，O(桶数)。
+// Threading contract: 与所属 JitterBuffer 的 push 同线程调用。
+class DelayHistogram {
+public:
+    DelayHistogram(std::size_t buckets, float forget_factor);
+
+    // 记录一个包的延迟桶（超出范围的落入最后一桶）。
+    void add(std::size_t bucket) noexcept;
+
+    // 最小的 k，使桶 [0, k] 的累计比例 >= q。
+    [[nodiscard]] std::size_t quantile(float q) const noexcept;
+
+    // 回到初始先验（全部质量在桶 0）。
+    void reset() noexcept;
+
+    [[nodiscard]] std::span<const float> buckets() const noexcept { return buckets_; }
+
+private:
+    std::vector<float> buckets_;
+    float forget_factor_;
+};
+
+} // namespace aqua::jitter
+
+#endif // AQUA_DELAY_HISTOGRAM_H
@@ -0,0 +1,68 @@
+#include "core/jitter_buffer/ingress_queue.h"
+
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace aqua::jitter {
+
+IngressQueue::IngressQueue(std::size_t capacity_packets, std::size_t headroom_bytes, std::size_t max_payload_bytes)
+    : stride_(headroom_bytes + max_payload_bytes)
+    , max_payload_(max_payload_bytes)
+    , slot_mask_(std::bit_ceil(capacity_packets) - 1)
+{
+    if (capacity_packets == 0 || max_payload_bytes == 0) {
+        throw std::invalid_argument("IngressQueue requires capacity_packets > 0 and max_payload_bytes > 0");
+    }
+    slots_.resize(slot_mask_ + 1);
+    storage_.resize((slots_.size() + 1) * stride_);
+}
+
+std::span<std::byte> IngressQueue::receive_buffer() noexcept
+{
+    const std::size_t w = write_pos_.load(std::memory_order_relaxed);
+    const std::size_t r = read_pos_.load(std::memory_order_acquire);
+    // 队满：下一个槽仍属于消费者，收进溢出缓冲（push 时若仍满则丢弃）
+    const std::size_t index = (w - r < slots_.size()) ? (w & slot_mask_) : slots_.size();
+    return { slot_data(index), stride_ };
+}
+
+bool IngressQueue::push(std::chrono::nanoseconds arrival, std::uint32_t sample_position,
+    std::span<const std::byte> payload) noexcept
+{
+    const std::size_t w = write_pos_.load(std::memory_order_relaxed);
+    const std::size_t r = read_pos_.load(std::memory_order_acquire);
+    if (payload.empty() || payload.size() > max_payload_ || w - r >= slots_.size()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const std::size_t index = w & slot_mask_;
+    std::byte* base = slot_data(index);
+    Slot& slot = slots_[index];
+    // 指针比较用 std::less：payload 可能来自与槽缓冲无关的对象
+    const std::less<const std::byte*> before;
+    if (!before(payload.data(), base) && !before(base + stride_, payload.data() + payload.size())) {
+        slot.offset = static_cast<std::size_t>(payload.data() - base); // 已在槽内（零拷贝接收）
+    } else {
+        std::memcpy(base, payload.data(), payload.size());
+        slot.offset = 0;
+    }
+    slot.arrival = arrival;
+    slot.sample_position = sample_position;
+    slot.size = payload.size();
+
+    // release：槽内容先于写指针对消费者可见
+    write_pos_.store(w + 1, std::memory_order_release);
+    return true;
+}
+
+std::size_t IngressQueue::size() const noexcept
+{
+    const std::size_t r = read_pos_.load(std::memory_order_acquire);
+    const std::size_t w = write_pos_.load(std::memory_order_acquire);
+    return w - r;
+}
+
+} // namespace aqua::jitter
@@ -0,0 +1,88 @@
+#ifndef AQUA_INGRESS_QUEUE_H
+#define AQUA_INGRESS_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace aqua::jitter {
+
+// 拉模式播放的 JitterBuffer 入口队列：io 线程把收到的音频包连同到达时刻排队，
+// 播放回调线程取出后经 push_at(pos, payload, arrival) 入 JB（JB 只在播放线程访问）。
+//
+// - 固定 capacity 个槽（取整为 2 的幂），每槽 headroom + max_payload 字节，构造时预分配。
+// - 零拷贝接收：receive_buffer() 指向下一个空槽，UdpTransport 可直接收进去（报文头落在
+//   headroom）；push 的 payload 恰在该槽内时只记录偏移，其他来源照常拷贝。
+// - 队满时 push 丢弃该包并计入 dropped()，不阻塞、不覆盖未取出的包；
+//   此时 receive_buffer() 返回独立的溢出缓冲。
+// - 到达时刻以纳秒（时钟纪元起）保存，与具体 Clock 类型无关。
+//
+// Threading contract: 单生产者单消费者。receive_buffer / push 在生产者线程（io_context），
+// drain 在消费者线程（播放回调）；size / dropped 任意线程可读。
+class IngressQueue {
+public:
+    struct Entry {
+        std::chrono::nanoseconds arrival; // 到达时刻（时钟纪元起）
+        std::uint32_t sample_position;
+        std::span<const std::byte> payload; // drain 回调返回前有效
+    };
+
+    IngressQueue(std::size_t capacity_packets, std::size_t headroom_bytes, std::size_t max_payload_bytes);
+
+    IngressQueue(const IngressQueue&) = delete;
+    IngressQueue& operator=(const IngressQueue&) = delete;
+
+    // 生产者：本次接收的目标缓冲（headroom + max_payload 字节）。每次投递接收前重新获取。
+    [[nodiscard]] std::span<std::byte> receive_buffer() noexcept;
+
+    // 生产者：排队一个包。payload 为空或超过 max_payload 时丢弃。返回 false 表示已丢弃。
+    bool push(std::chrono::nanoseconds arrival, std::uint32_t sample_position,
+        std::span<const std::byte> payload) noexcept;
+
+    // 消费者：按到达顺序对每个已排队的包调用 fn(const Entry&)，返回处理的包数。
+    template <typename Fn>
+    std::size_t drain(Fn&& fn)
+    {
+        const std::size_t r = read_pos_.load(std::memory_order_relaxed);
+        const std::size_t w = write_pos_.load(std::memory_order_acquire);
+        for (std::size_t i = r; i != w; ++i) {
+            const Slot& slot = slots_[i & slot_mask_];
+            fn(Entry { slot.arrival, slot.sample_position,
+                { slot_data(i & slot_mask_) + slot.offset, slot.size } });
+            // 逐包释放：长 drain 期间生产者可继续复用已取出的槽
+            read_pos_.store(i + 1, std::memory_order_release);
+        }
+        return w - r;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return slots_.size(); }
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::chrono::nanoseconds arrival { };
+        std::uint32_t sample_position = 0;
+        std::size_t offset = 0; // payload 在槽缓冲内的偏移
+        std::size_t size = 0;
+    };
+
+    [[nodiscard]] std::byte* slot_data(std::size_t index) noexcept { return storage_.data() + index * stride_; }
+
+    std::size_t stride_;
+    std::size_t max_payload_;
+    std::size_t slot_mask_;
+    std::vector<Slot> slots_;
+    std::vector<std::byte> storage_; // slots_.size() 个槽缓冲 + 1 个溢出缓冲
+
+    alignas(64) std::atomic<std::size_t> write_pos_ { 0 };
+    alignas(64) std::atomic<std::size_t> read_pos_ { 0 };
+    std::atomic<std::uint64_t> dropped_ { 0 };
+};
+
+} // namespace aqua::jitter
+
+#endif // AQUA_INGRESS_QUEUE_H
@@ -1,28 +1,49 @@
 #include "core/jitter_buffer/jitter_buffer.h"
+#include "core/audio/dsp/gain.h"
 #include "core/logger/logger.h"
 
 #include <algorithm>
 #include <bit>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <stdexcept>
 
 namespace aqua::jitter {
 
-JitterBuffer::JitterBuffer(const AudioFormat& format,
+JitterBufferSizing derive_jitter_sizing(std::uint32_t jitter_buffer_ms,
+    std::uint32_t sample_rate, std::uint32_t frames_per_packet) noexcept
+{
+    // 向上取整 + 2 的幂对齐 = 缓冲预算"至少"语义
+    const std::uint64_t requested_frames = static_cast<std::uint64_t>(jitter_buffer_ms) * sample_rate / 1000;
+    const std::uint64_t requested_packets = (requested_frames + frames_per_packet - 1) / frames_per_packet;
+    std::size_t capacity = config::JITTER_MIN_CAPACITY_PACKETS;
+    while (capacity < requested_packets) {
+        capacity <<= 1;
+    }
+    return { capacity, capacity / 4, capacity / 2 };
+}
+
+template <typename Clock>
+BasicJitterBuffer<Clock>::BasicJitterBuffer(const AudioFormat& format,
     std::uint32_t frames_per_packet,
     std::size_t floor_packets,
     std::size_t capacity_packets,
     std::uint32_t detect_window_packets,
     std::uint32_t drift_rebase_late_count,
-    std::optional<AdaptiveTargetConfig> adaptive)
+    std::optional<AdaptiveTargetConfig> adaptive,
+    std::size_t receive_headroom_bytes,
+    config::PlcMode plc_mode,
+    std::size_t max_payload_bytes)
     : format_(format)
+    , frames_per_packet_(frames_per_packet)
     , target_latency_packets_(floor_packets)
     , floor_packets_(floor_packets)
     , adaptive_(adaptive.has_value())
     , adapt_cfg_(adaptive.value_or(AdaptiveTargetConfig { }))
     , capacity_(capacity_packets)
     , slot_mask_(capacity_packets - 1)
+    , headroom_(receive_headroom_bytes)
     , detect_window_packets_(detect_window_packets)
     , drift_rebase_late_count_(drift_rebase_late_count)
 {
@@ -52,6 +73,14 @@ JitterBuffer::JitterBuffer(const AudioFormat& format,
         }
     }
 
+    // 直方图参数：分位 (0, 1]、遗忘因子 (0, 1)，否则分位无意义或直方图不更新/不遗忘。
+    if (adaptive && adapt_cfg_.estimator == config::JitterEstimator::Histogram
+        && !(adapt_cfg_.histogram_quantile > 0.0f && adapt_cfg_.histogram_quantile <= 1.0f
+            && adapt_cfg_.histogram_forget_factor > 0.0f && adapt_cfg_.histogram_forget_factor < 1.0f)) {
+        throw std::invalid_argument(
+            "JitterBuffer histogram quantile must be in (0, 1] and forget factor in (0, 1)");
+    }
+
     // 检测窗口必须 > 0，否则每个包都评估一次。
     if (detect_window_packets == 0) {
         throw std::invalid_argument("JitterBuffer detect_window_packets must be > 0");
@@ -73,7 +102,14 @@ JitterBuffer::JitterBuffer(const AudioFormat& format,
     }
 
     // 计算每包 PCM 字节数
-    payload_size_ = static_cast<std::size_t>(frames_per_packet) * format_.frame_bytes();
+    frame_bytes_ = format_.frame_bytes();
+    payload_size_ = static_cast<std::size_t>(frames_per_packet) * frame_bytes_;
+
+    // 变长包上限：至少一块（push 的定长包必须能零拷贝收进备用缓冲）
+    max_payload_bytes_ = max_payload_bytes == 0 ? payload_size_ : max_payload_bytes;
+    if (max_payload_bytes_ < payload_size_) {
+        throw std::invalid_argument("JitterBuffer max_payload_bytes must be >= one packet");
+    }
 
     // 计算每包时长（纳秒）。
     // 用纳秒而非微秒：微秒整数除法在 44.1kHz 家族（含因子 7，如 44100/88200）下被截断
@@ -82,30 +118,47 @@ JitterBuffer::JitterBuffer(const AudioFormat& format,
     // 排空 JB 缓冲触发 rebase。纳秒精度下漂移降至 ~0.037ppm，可忽略。
     packet_duration_ = std::chrono::nanoseconds(
         static_cast<std::int64_t>(frames_per_packet) * 1'000'000'000 / format_.sample_rate);
+    playout_step_q32_ = static_cast<std::uint64_t>(packet_duration_.count()) << 32;
 
-    // 预分配所有内存
+    // 预分配所有内存：slot i 初始持有缓冲 i，其后依次为接收备用与 PLC 历史。
+    buffer_stride_ = headroom_ + max_payload_bytes_;
     slots_.resize(capacity_);
-    storage_.resize(capacity_ * payload_size_, std::byte { 0 });
-    last_pcm_.resize(payload_size_, std::byte { 0 });
+    coverage_words_ = (frames_per_packet + 63) / 64;
+    coverage_.resize(capacity_ * coverage_words_, 0);
+    for (std::size_t i = 0; i < capacity_; ++i) {
+        slots_[i].buffer = static_cast<std::uint32_t>(i);
+    }
+    spare_buffer_ = static_cast<std::uint32_t>(capacity_);
+    history_buffer_ = static_cast<std::uint32_t>(capacity_ + 1);
+    storage_.resize((capacity_ + 2) * buffer_stride_, std::byte { 0 });
+    conceal_scratch_.resize(payload_size_, std::byte { 0 });
+    if (plc_mode == config::PlcMode::Waveform) {
+        concealment_.emplace(format_, frames_per_packet);
+    }
+    if (adaptive_ && adapt_cfg_.time_stretch) {
+        stretcher_.emplace(format_, frames_per_packet);
+    }
+    adapt_ceiling_ = adapt_cfg_.max_packets.value_or(capacity_ / 2);
+    if (adaptive_ && adapt_cfg_.estimator == config::JitterEstimator::Histogram) {
+        histogram_.emplace(adapt_ceiling_ + 1, adapt_cfg_.histogram_forget_factor);
+    }
+
+    publish_state();
 }
 
-void JitterBuffer::init_timeline(std::uint32_t sequence,
-    std::span<const std::byte> payload)
+template <typename Clock>
+void BasicJitterBuffer<Clock>::init_timeline(const Fragment& frag)
 {
-    // 调用方（push）应已校验 payload 大小，此处 assert 防御未来新增调用路径遗漏。
-    assert(payload.size() >= payload_size_);
+    // 调用方（push / push_at）应已校验 payload 大小，此处 assert 防御未来新增调用路径遗漏。
+    assert(frag.frames > 0 && frag.pcm.size() == frag.frames * frame_bytes_);
 
+    const std::uint32_t sequence = frag.block;
     const bool rebase = initialized_;
 
-    // 软 rebase 时 sequence 可能向回跳（consecutive-late 场景），slot 中可能
-    // 仍留有更高 seq 的 future 包：保留 highest_pushed_seq_ 的最大值，
-    // 避免 buffer_fill_packets() 的统计范围瞬时低估。
-    if (!rebase || seq_diff(sequence, highest_pushed_seq_) > 0) {
-        highest_pushed_seq_ = sequence;
-    }
-
     initialized_ = true;
-    first_packet_time_ = clock::now();
+    first_packet_time_ = event_time_;
+    arrival_delay_avg_ns_ = 0.0; // 首包定义名义到达时刻，延迟基准随时间线重建
+    ++timeline_epoch_;
 
     // deadline 策略分场景：
     // - 首包：now + target×duration（标准起播缓冲）。
@@ -146,13 +199,160 @@ void JitterBuffer::init_timeline(std::uint32_t sequence,
         rebases_.fetch_add(1, std::memory_order_relaxed);
     }
 
-    auto idx = sequence & slot_mask_;
+    store(frag);
+
+    // 窗口起点跳变：软 rebase 时 slot 中可能留有新窗口内的 future 包（或回跳后
+    // 重新落入窗口的旧包），增量计数无从推导，全量校准一次。
+    recount_fill();
+}
+
+template <typename Clock>
+void BasicJitterBuffer<Clock>::store_slot(std::size_t idx, std::uint32_t sequence,
+    std::span<const std::byte> payload) noexcept
+{
+    if (payload.data() == pool_payload(spare_buffer_).data()) {
+        // 零拷贝：包已收在备用缓冲中，slot 接管它，slot 的旧缓冲成为新的备用。
+        std::swap(slots_[idx].buffer, spare_buffer_);
+    } else {
+        std::memcpy(slot_payload(idx).data(), payload.data(), payload_size_);
+    }
     slots_[idx].sequence = sequence;
     slots_[idx].valid = true;
-    std::memcpy(slot_payload(idx).data(), payload.data(), payload_size_);
+    slots_[idx].filled = frames_per_packet_;
+}
+
+template <typename Clock>
+void BasicJitterBuffer<Clock>::store(const Fragment& frag) noexcept
+{
+    // 窗口内映射到同一 idx 的块只有一个，slot 中若有残留（valid 但块号不同）必在窗口外、
+    // 未计入占用数，因此块被本包首次占用时恒 +1。
+    const auto in_window = [this](std::uint32_t block) {
+        const auto diff = seq_diff(block, next_pop_seq_);
+        return diff >= 0 && static_cast<std::size_t>(diff) < capacity_;
+    };
+
+    // 整块对齐（定长包的常态）：一次入槽，来自备用缓冲时零拷贝
+    if (frag.offset == 0 && frag.frames == frames_per_packet_) {
+        if (in_window(frag.block)) {
+            const auto idx = frag.block & slot_mask_;
+            if (!slots_[idx].valid || slots_[idx].sequence != frag.block) {
+                ++fill_packets_;
+            }
+            store_slot(idx, frag.block, frag.pcm);
+        }
+        return;
+    }
+
+    auto pcm = frag.pcm;
+    std::uint32_t block = frag.block;
+    std::uint32_t offset = frag.offset;
+    while (!pcm.empty()) {
+        const std::size_t frames = std::min<std::size_t>(frames_per_packet_ - offset, pcm.size() / frame_bytes_);
+        if (in_window(block)) {
+            store_frames(block, offset, pcm.first(frames * frame_bytes_));
+        }
+        pcm = pcm.subspan(frames * frame_bytes_);
+        ++block;
+        offset = 0;
+    }
+}
+
+template <typename Clock>
+void BasicJitterBuffer<Clock>::store_frames(std::uint32_t block, std::uint32_t offset, std::span<const std::byte> pcm) noexcept
+{
+    const auto idx = block & slot_mask_;
+    auto& slot = slots_[idx];
+    std::uint64_t* bits = coverage(idx);
+    if (!slot.valid || slot.sequence != block) {
+        // slot 转给新块：清空到达位图
+        std::fill_n(bits, coverage_words_, std::uint64_t { 0 });
+        slot.sequence = block;
+        slot.valid = true;
+        slot.filled = 0;
+        ++fill_packets_;
+    }
+    std::memcpy(slot_payload(idx).data() + offset * frame_bytes_, pcm.data(), pcm.size());
+    if (slot.filled == frames_per_packet_) {
+        return; // 已整块齐备（重传/重叠包覆盖同一内容）
+    }
+
+    // 置位 [offset, end)，按字统计新到达的帧
+    const std::size_t end = offset + pcm.size() / frame_bytes_;
+    for (std::size_t f = offset; f < end;) {
+        const std::size_t bit = f % 64;
+        const std::size_t count = std::min<std::size_t>(64 - bit, end - f);
+        const std::uint64_t mask = (count == 64 ? ~std::uint64_t { 0 } : (std::uint64_t { 1 } << count) - 1) << bit;
+        slot.filled += static_cast<std::uint32_t>(std::popcount(mask & ~bits[f / 64]));
+        bits[f / 64] |= mask;
+        f += count;
+    }
+}
+
+template <typename Clock>
+bool BasicJitterBuffer<Clock>::covered(const Fragment& frag) const noexcept
+{
+    auto remaining = static_cast<std::size_t>(frag.frames);
+    std::uint32_t block = frag.block;
+    std::size_t offset = frag.offset;
+    while (remaining > 0) {
+        const auto idx = block & slot_mask_;
+        const auto& slot = slots_[idx];
+        if (!slot.valid || slot.sequence != block) {
+            return false;
+        }
+        const std::size_t end = std::min<std::size_t>(frames_per_packet_, offset + remaining);
+        if (slot.filled != frames_per_packet_) {
+            const std::uint64_t* bits = coverage(idx);
+            for (std::size_t f = offset; f < end;) {
+                const std::size_t bit = f % 64;
+                const std::size_t count = std::min<std::size_t>(64 - bit, end - f);
+                const std::uint64_t mask = (count == 64 ? ~std::uint64_t { 0 } : (std::uint64_t { 1 } << count) - 1) << bit;
+                if ((bits[f / 64] & mask) != mask) {
+                    return false;
+                }
+                f += count;
+            }
+        }
+        remaining -= end - offset;
+        ++block;
+        offset = 0;
+    }
+    return true;
 }
 
-void JitterBuffer::push(std::uint32_t sequence,
+template <typename Clock>
+std::span<std::byte> BasicJitterBuffer<Clock>::receive_buffer() noexcept
+{
+    return { storage_.data() + spare_buffer_ * buffer_stride_, buffer_stride_ };
+}
+
+template <typename Clock>
+void BasicJitterBuffer<Clock>::recount_fill() noexcept
+{
+    fill_packets_ = 0;
+    for (std::size_t i = 0; i < capacity_; ++i) {
+        const auto seq = next_pop_seq_ + static_cast<std::uint32_t>(i);
+        const auto& slot = slots_[seq & slot_mask_];
+        if (slot.valid && slot.sequence == seq) {
+            ++fill_packets_;
+        }
+    }
+}
+
+template <typename Clock>
+void BasicJitterBuffer<Clock>::publish_state() noexcept
+{
+    PublishedState state;
+    state.next_pop_seq = next_pop_seq_;
+    state.fill_packets = static_cast<std::uint32_t>(fill_packets_);
+    state.target_packets = static_cast<std::uint32_t>(target_latency_packets_);
+    state.timeline_epoch = timeline_epoch_;
+    state.arrival_delay_ms = static_cast<float>(arrival_delay_avg_ns_ / 1e6);
+    published_.store(state);
+}
+
+template <typename Clock>
+void BasicJitterBuffer<Clock>::push(std::uint32_t sequence,
     std::span<const std::byte> payload)
 {
     if (payload.size() != payload_size_) {
@@ -161,30 +361,69 @@ void JitterBuffer::push(std::uint32_t sequence,
         malformed_packets_.fetch_add(1, std::memory_order_relaxed);
         return;
     }
+    event_time_ = clock::now();
+    push_impl({ sequence, 0, frames_per_packet_, payload });
+    publish_state();
+}
 
-    packets_received_.fetch_add(1, std::memory_order_relaxed);
+template <typename Clock>
+void BasicJitterBuffer<Clock>::push_at(std::uint32_t sample_position,
+    std::span<const std::byte> payload)
+{
+    push_at(sample_position, payload, clock::now());
+}
 
-    std::lock_guard<std::mutex> lock(slots_mutex_);
+template <typename Clock>
+void BasicJitterBuffer<Clock>::push_at(std::uint32_t sample_position,
+    std::span<const std::byte> payload, time_point arrival)
+{
+    if (payload.empty() || payload.size() % frame_bytes_ != 0 || payload.size() > max_payload_bytes_) {
+        aqua::log_debug_fmt("JitterBuffer push_at: invalid payload size {} (frame={}B, max={}B)",
+            payload.size(), frame_bytes_, max_payload_bytes_);
+        malformed_packets_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // uint32 位置展开：首包（或 reset 后）以块长 × 2^32 为偏置播种，此后按有符号差值累加，
+    // 位置回绕时块号仍连续递增。
+    if (!initialized_) {
+        position_ = (static_cast<std::uint64_t>(frames_per_packet_) << 32) | sample_position;
+    } else {
+        position_ += static_cast<std::int64_t>(static_cast<std::int32_t>(
+            sample_position - static_cast<std::uint32_t>(position_)));
+    }
+    const auto frames = static_cast<std::uint32_t>(payload.size() / frame_bytes_);
+    event_time_ = arrival;
+    push_impl({ static_cast<std::uint32_t>(position_ / frames_per_packet_),
+        static_cast<std::uint32_t>(position_ % frames_per_packet_), frames, payload });
+    publish_state();
+}
+
+template <typename Clock>
+void BasicJitterBuffer<Clock>::push_impl(const Fragment& frag)
+{
+    packets_received_.fetch_add(1, std::memory_order_relaxed);
 
     // 第一个包：初始化播放时间线，不参与检测窗口
     if (!initialized_) {
-        init_timeline(sequence, payload);
+        init_timeline(frag);
         return;
     }
 
-    // 与 next_pop_seq_ 的有符号差值
+    // 首块与 next_pop_seq_ 的有符号差值（跨块包的末块决定是否整体迟到）
+    const std::uint32_t sequence = frag.block;
     auto diff = seq_diff(sequence, next_pop_seq_);
 
-    if (diff < 0) {
-        // 已经过了这个 sequence 的播放时刻（或重复包）
-        auto idx = sequence & slot_mask_;
-        if (slots_[idx].valid && slots_[idx].sequence == sequence) {
+    if (seq_diff(last_block(frag), next_pop_seq_) < 0) {
+        // 已经过了这些块的播放时刻（或重复包）
+        if (covered(frag)) {
             duplicates_.fetch_add(1, std::memory_order_relaxed);
             // 重复包不计入检测窗口，避免稀释 late 比例导致 rebase 变钝
         } else {
             late_packets_.fetch_add(1, std::memory_order_relaxed);
             ++window_late_count_;
             ++window_total_count_;
+            track_arrival(diff);
             // 连续 late 检测：音频源暂停后恢复时，pop 空转已让 next_pop_seq_ 超前，
             // 新包全部 diff<0，无法触发 diff>=capacity 的 reset，导致永久死锁。
             // 连续 late 达到 capacity 时强制 reset 重建时间线。
@@ -195,17 +434,17 @@ void JitterBuffer::push(std::uint32_t sequence,
                 // 软 rebase：不调用 reset()，保留 slot 中已有的 future 包。
                 // init_timeline 重置 next_pop_seq_ 和 deadline，stale slot 会被
                 // pop_next 的 sequence 校验自然过滤。
-                init_timeline(sequence, payload);
+                init_timeline(frag);
                 return;
             }
             // 迟到包：即便触发 drift rebase（init_timeline 已存储本包），本分支也到此返回，
             // 返回值无需处理，显式忽略以表达该意图。
-            (void)evaluate_detect_window_locked(sequence, payload);
+            (void)evaluate_detect_window(frag);
         }
         return;
     }
 
-    if (static_cast<std::size_t>(diff) >= capacity_) {
+    if (diff > 0 && static_cast<std::size_t>(diff) >= capacity_) {
         // 跳跃太远（diff >= capacity），可能是严重乱序或调度延迟积累。
         // 软 rebase：不调用 reset()，保留 slot 中已缓冲的 future 包。
         // init_timeline 将 next_pop_seq_ 跳到当前包，重建 deadline。
@@ -213,36 +452,30 @@ void JitterBuffer::push(std::uint32_t sequence,
         // future 包（seq >= 新 next_pop_seq_）不受影响，继续正常播放。
         aqua::log_warn_fmt("JitterBuffer: sequence jump too far (seq={}, next_pop={}, diff={}), rebasing timeline",
             sequence, next_pop_seq_, diff);
-        init_timeline(sequence, payload);
+        init_timeline(frag);
         return;
     }
 
-    // diff >= 0 and diff < capacity：expected / future 包，复位连续 late 计数
+    // 末块仍在窗口内：expected / future 包（跨过 next_pop_seq_ 的包只存未播部分），
+    // 复位连续 late 计数
     consecutive_late_ = 0;
 
-    auto idx = sequence & slot_mask_;
-    if (slots_[idx].valid && slots_[idx].sequence == sequence) {
+    if (covered(frag)) {
         // 重复包
         duplicates_.fetch_add(1, std::memory_order_relaxed);
         return;
     }
     ++window_total_count_;
-    if (evaluate_detect_window_locked(sequence, payload)) {
+    track_arrival(diff);
+    if (evaluate_detect_window(frag)) {
         return; // drift rebase 已接管本包（init_timeline 已存储）
     }
 
-    slots_[idx].sequence = sequence;
-    slots_[idx].valid = true;
-    std::memcpy(slot_payload(idx).data(), payload.data(), payload_size_);
-
-    // 更新最高已 push 的 sequence
-    if (seq_diff(sequence, highest_pushed_seq_) > 0) {
-        highest_pushed_seq_ = sequence;
-    }
+    store(frag);
 }
 
-bool JitterBuffer::evaluate_detect_window_locked(std::uint32_t sequence,
-    std::span<const std::byte> payload)
+template <typename Clock>
+bool BasicJitterBuffer<Clock>::evaluate_detect_window(const Fragment& frag)
 {
     if (window_total_count_ < detect_window_packets_) {
         return false;
@@ -260,12 +493,12 @@ bool JitterBuffer::evaluate_detect_window_locked(std::uint32_t sequence,
             "JitterBuffer: clock drift detected ({} late/{} packets = {:.1f}%), rebasing timeline to seq={}",
             window_late, window_total,
             static_cast<double>(window_late) * 100.0 / window_total,
-            sequence);
-        init_timeline(sequence, payload); // 内部重置窗口计数与干净资格
+            frag.block);
+        init_timeline(frag); // 内部重置窗口计数与干净资格
         return true;
     }
 
-    // 2) AIMD（未启用自适应时到此为止）
+    // 2) 自适应 target（未启用时到此为止）
     if (!adaptive_) {
         return false;
     }
@@ -276,30 +509,34 @@ bool JitterBuffer::evaluate_detect_window_locked(std::uint32_t sequence,
             .count();
     };
 
+    if (histogram_) {
+        // 直方图估计器：抬升已在 observe_arrival 逐包完成，窗口结束时一次回落到分位值。
+        const std::size_t desired = histogram_target();
+        if (desired < target_latency_packets_) {
+            shift_target(static_cast<std::int64_t>(desired) - static_cast<std::int64_t>(target_latency_packets_));
+            log_info_fmt("JitterBuffer: histogram target lowered to {} packets ({:.1f}ms), "
+                         "q{:.1f} of arrival delay, floor {} packets",
+                target_latency_packets_, target_ms(), adapt_cfg_.histogram_quantile * 100.0f, floor_packets_);
+        }
+        return false;
+    }
+
     if (window_late >= adapt_cfg_.raise_late_count) {
         // 快升：late 压力 → target +1 包，deadline 后移 1 拍（下游 RB 蓄水 1 拍的量）。
         // 上限：显式 max_packets 优先，否则 capacity/2（乱序余量契约的默认上界）。
-        const std::size_t adapt_ceiling = adapt_cfg_.max_packets.value_or(capacity_ / 2);
         adapt_clean_streak_ = 0;
-        if (target_latency_packets_ < adapt_ceiling) {
-            ++target_latency_packets_;
-            next_deadline_ += packet_duration_;
+        if (target_latency_packets_ < adapt_ceiling_) {
+            shift_target(1);
             log_info_fmt("JitterBuffer: adaptive target raised to {} packets ({:.1f}ms, "
                          "ceiling {} packets), {} late in last {} packets",
-                target_latency_packets_, target_ms(), adapt_ceiling,
+                target_latency_packets_, target_ms(), adapt_ceiling_,
                 window_late, detect_window_packets_);
         }
     } else if (window_late == 0) {
         // 慢降：连续干净窗口 → target -1 包，deadline 前移 1 拍（排水）。
-        // 钳到 now：deadline 已落后（追赶/RB 满排水中）时前移会放大滞后，
-        // 极端情况触发 pop_next 的断流 reset；钳位后立即恢复 cadence，同样净减 1 拍。
         if (++adapt_clean_streak_ >= adapt_cfg_.lower_clean_windows
             && target_latency_packets_ > floor_packets_) {
-            --target_latency_packets_;
-            const auto now = clock::now();
-            next_deadline_ = (next_deadline_ - packet_duration_ < now)
-                ? now
-                : next_deadline_ - packet_duration_;
+            shift_target(-1);
             adapt_clean_streak_ = 0;
             log_info_fmt("JitterBuffer: adaptive target lowered to {} packets ({:.1f}ms), "
                          "floor {} packets, {} consecutive clean windows",
@@ -313,8 +550,90 @@ bool JitterBuffer::evaluate_detect_window_locked(std::uint32_t sequence,
     return false;
 }
 
-std::optional<JitterBuffer::time_point>
-JitterBuffer::next_playout_deadline() const noexcept
+template <typename Clock>
+void BasicJitterBuffer<Clock>::shift_target(std::int64_t delta)
+{
+    target_latency_packets_ = static_cast<std::size_t>(static_cast<std::int64_t>(target_latency_packets_) + delta);
+    if (stretcher_) {
+        // 时间伸缩：deadline 不动，插入（抬升）/删除（回落）delta 包的帧数，逐步蓄水/排水。
+        stretcher_->adjust(-delta * static_cast<std::int64_t>(stretcher_->packet_frames()));
+        return;
+    }
+    const auto shift = packet_duration_ * delta;
+    if (delta >= 0) {
+        next_deadline_ += shift;
+        return;
+    }
+    // 回落钳到 now：deadline 已落后（追赶/RB 满排水中）时前移会放大滞后，
+    // 极端情况触发 pop_next 的断流 reset；钳位后立即恢复 cadence。
+    const auto now = event_time_;
+    next_deadline_ = (next_deadline_ + shift < now) ? now : next_deadline_ + shift;
+}
+
+template <typename Clock>
+typename BasicJitterBuffer<Clock>::time_point BasicJitterBuffer<Clock>::playout_time(std::int32_t diff) const noexcept
+{
+    auto t = next_deadline_ + packet_duration_ * static_cast<std::int64_t>(diff);
+    if (stretcher_) {
+        // FIFO 中排在 next_pop_seq_ 之前的帧先播；待删帧（正）使其提前，待插帧（负）使其推后。
+        const auto frames = static_cast<std::int64_t>(stretcher_->buffered_frames()) - stretcher_->pending_frames();
+        t += std::chrono::nanoseconds(frames * 1'000'000'000 / format_.sample_rate);
+    }
+    return t;
+}
+
+template <typename Clock>
+std::chrono::nanoseconds BasicJitterBuffer<Clock>::arrival_delay(std::int32_t diff) const noexcept
+{
+    // 名义到达时刻 = 播放时刻 - target 缓冲量（首包定义时间线时恰等于其到达时刻）。
+    const auto nominal = playout_time(diff) - packet_duration_ * static_cast<std::int64_t>(target_latency_packets_);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(event_time_ - nominal);
+}
+
+template <typename Clock>
+void BasicJitterBuffer<Clock>::track_arrival(std::int32_t diff)
+{
+    const auto delay = arrival_delay(diff);
+    arrival_delay_avg_ns_ += static_cast<double>(config::JITTER_ARRIVAL_DELAY_EWMA_ALPHA)
+        * (static_cast<double>(delay.count()) - arrival_delay_avg_ns_);
+    if (histogram_) {
+        observe_arrival(delay);
+    }
+}
+
+template <typename Clock>
+void BasicJitterBuffer<Clock>::observe_arrival(std::chrono::nanoseconds delay)
+{
+    // 延迟 d > 0 的包需要 ceil(d / packet_duration) 包缓冲才能按时播放。
+    std::size_t bucket = 0;
+    if (delay.count() > 0) {
+        bucket = static_cast<std::size_t>((delay + packet_duration_ - std::chrono::nanoseconds(1)) / packet_duration_);
+    }
+    histogram_->add(bucket);
+
+    const std::size_t desired = histogram_target();
+    if (desired > target_latency_packets_) {
+        shift_target(static_cast<std::int64_t>(desired) - static_cast<std::int64_t>(target_latency_packets_));
+        adapt_clean_streak_ = 0;
+        log_info_fmt("JitterBuffer: histogram target raised to {} packets ({:.1f}ms), "
+                     "q{:.1f} of arrival delay, ceiling {} packets",
+            target_latency_packets_,
+            std::chrono::duration<double, std::milli>(
+                packet_duration_ * static_cast<std::int64_t>(target_latency_packets_))
+                .count(),
+            adapt_cfg_.histogram_quantile * 100.0f, adapt_ceiling_);
+    }
+}
+
+template <typename Clock>
+std::size_t BasicJitterBuffer<Clock>::histogram_target() const noexcept
+{
+    return std::clamp(histogram_->quantile(adapt_cfg_.histogram_quantile), floor_packets_, adapt_ceiling_);
+}
+
+template <typename Clock>
+std::optional<typename BasicJitterBuffer<Clock>::time_point>
+BasicJitterBuffer<Clock>::next_playout_deadline() const noexcept
 {
     if (!initialized_) {
         return std::nullopt;
@@ -322,13 +641,64 @@ JitterBuffer::next_playout_deadline() const noexcept
     return next_deadline_;
 }
 
-bool JitterBuffer::pop_next(std::span<std::byte> output)
+template <typename Clock>
+bool BasicJitterBuffer<Clock>::pop_next(std::span<std::byte> output)
 {
-    if (output.size() < payload_size_) {
-        return false;
+    return pop_next(output, { });
+}
+
+template <typename Clock>
+bool BasicJitterBuffer<Clock>::pop_next(std::span<std::byte> first, std::span<std::byte> second)
+{
+    const bool got_real_data = pop_next_impl(first, second);
+    publish_state();
+    return got_real_data;
+}
+
+namespace {
+    // 将 src 依次写入 first / second 两段（调用方保证总长足够）。
+    void copy_split(std::span<const std::byte> src, std::span<std::byte> first, std::span<std::byte> second) noexcept
+    {
+        const std::size_t head = std::min(src.size(), first.size());
+        std::memcpy(first.data(), src.data(), head);
+        if (head < src.size()) {
+            std::memcpy(second.data(), src.data() + head, src.size() - head);
+        }
+    }
+
+    // 将 src 写入两段输出的字节偏移 offset 处。
+    void copy_split_at(std::size_t offset, std::span<const std::byte> src,
+        std::span<std::byte> first, std::span<std::byte> second) noexcept
+    {
+        if (offset < first.size()) {
+            const std::size_t head = std::min(src.size(), first.size() - offset);
+            std::memcpy(first.data() + offset, src.data(), head);
+            src = src.subspan(head);
+            offset = 0;
+        } else {
+            offset -= first.size();
+        }
+        if (!src.empty()) {
+            std::memcpy(second.data() + offset, src.data(), src.size());
+        }
     }
 
-    std::lock_guard<std::mutex> lock(slots_mutex_);
+    void zero_split(std::size_t bytes, std::span<std::byte> first, std::span<std::byte> second) noexcept
+    {
+        const std::size_t head = std::min(bytes, first.size());
+        std::memset(first.data(), 0, head);
+        if (head < bytes) {
+            std::memset(second.data(), 0, bytes - head);
+        }
+    }
+} // namespace
+
+template <typename Clock>
+bool BasicJitterBuffer<Clock>::pop_next_impl(std::span<std::byte> first, std::span<std::byte> second)
+{
+    if (first.size() + second.size() < payload_size_) {
+        return false;
+    }
 
     // 防御：首个包到达前没有时间线，next_pop_seq_ / next_deadline_ 均为初值，
     // 此时 pop 会静音填充并推进一个无意义的时间线。外部调度器本应在
@@ -343,112 +713,171 @@ bool JitterBuffer::pop_next(std::span<std::byte> output)
     // （Windows 粒度 ~15.6ms）的合法落后会被纯 target 阈值误判为断流（reset 风暴）。
     // 注意：乘法需转 int64——size_t 与 chrono rep(int64) 混合会把 common rep 变成
     // 无符号类型，负的 lateness（deadline 在未来）被回绕成巨大正数导致误触发。
-    const auto now = clock::now();
+    event_time_ = clock::now();
+    const auto now = event_time_;
     const auto max_lateness = std::max<std::chrono::nanoseconds>(
         packet_duration_ * static_cast<std::int64_t>(target_latency_packets_),
         config::JITTER_MIN_RESET_LATENESS_MS);
     if (now - next_deadline_ > max_lateness) {
         aqua::log_warn_fmt("JitterBuffer: playout deadline behind by {}ms (likely stream gap), resetting timeline",
             std::chrono::duration_cast<std::chrono::milliseconds>(now - next_deadline_).count());
-        reset_playout_state_locked();
-        std::memset(output.data(), 0, payload_size_);
+        reset_playout_state();
+        zero_split(payload_size_, first, second);
         return false;
     }
 
+    const bool got_real_data = (stretcher_ && stretcher_->active())
+        ? pop_stretched(first, second)
+        : take_next_packet(first, second);
+
+    // 计算下一个 deadline：基于上一个 deadline + packet_duration / playout_rate_（Q32 定点累加）
+    playout_residual_q32_ += playout_step_q32_;
+    next_deadline_ = next_deadline_ + std::chrono::nanoseconds(static_cast<std::int64_t>(playout_residual_q32_ >> 32));
+    playout_residual_q32_ &= 0xFFFF'FFFFu;
+
+    return got_real_data;
+}
+
+template <typename Clock>
+bool BasicJitterBuffer<Clock>::take_next_packet(std::span<std::byte> first, std::span<std::byte> second)
+{
     // 尝试输出 next_pop_seq_ 的数据
     auto idx = next_pop_seq_ & slot_mask_;
     bool got_real_data = false;
 
-    if (slots_[idx].valid && slots_[idx].sequence == next_pop_seq_) {
-        // 包存在：输出真实 PCM，并刷新 PLC 历史
-        std::memcpy(output.data(), slot_payload(idx).data(), payload_size_);
-        std::memcpy(last_pcm_.data(), output.data(), payload_size_);
+    if (slots_[idx].valid && slots_[idx].sequence == next_pop_seq_
+        && slots_[idx].filled == frames_per_packet_) {
+        // 包存在：输出真实 PCM；该缓冲与 PLC 历史交换索引即完成历史刷新（无拷贝），
+        // slot 换到的旧历史缓冲随 valid=false 一并作废。
+        // Waveform 隐藏在输出前原地完成恢复淡化（slot 缓冲归 JB 所有）。
+        if (concealment_) {
+            concealment_->on_real(slot_payload(idx));
+        }
+        copy_split(slot_payload(idx), first, second);
+        std::swap(slots_[idx].buffer, history_buffer_);
         hide_gain_ = 1.0f;
         slots_[idx].valid = false;
+        --fill_packets_;
         got_real_data = true;
+    } else if (slots_[idx].valid && slots_[idx].sequence == next_pop_seq_) {
+        // 块内只到达了部分帧：先隐藏整块，再按到达位图覆盖真实帧（缺失段两端为硬拼接，
+        // 只出现在拆包丢片时）。不计丢包，也不刷新 PLC 历史（历史须为完整一块）。
+        conceal_block(first, second);
+        const std::uint64_t* bits = coverage(idx);
+        const auto pcm = slot_payload(idx);
+        std::size_t f = 0;
+        while (f < frames_per_packet_) {
+            if ((bits[f / 64] >> (f % 64) & 1) == 0) {
+                ++f;
+                continue;
+            }
+            const std::size_t run_start = f;
+            while (f < frames_per_packet_ && (bits[f / 64] >> (f % 64) & 1) != 0) {
+                ++f;
+            }
+            copy_split_at(run_start * frame_bytes_,
+                pcm.subspan(run_start * frame_bytes_, (f - run_start) * frame_bytes_), first, second);
+        }
+        slots_[idx].valid = false;
+        --fill_packets_;
     } else {
-        // 包不存在（丢包或还没到）：丢包隐藏（PLC）——重复上一包 PCM 并逐包衰减，
-        // 比纯静音的"咔哒"声更平滑。连续丢包每包增益减半，若干包后收敛为静音。
+        // 包不存在（丢包或还没到）
         packets_lost_.fetch_add(1, std::memory_order_relaxed);
-        if (hide_gain_ > 0.0f) {
-            hide_gain_ *= 0.5f;
-            std::memcpy(output.data(), last_pcm_.data(), payload_size_);
-            apply_gain({ output.data(), payload_size_ }, hide_gain_);
-        } else {
-            std::memset(output.data(), 0, payload_size_);
-        }
+        conceal_block(first, second);
     }
 
-    // 推进到下一个 sequence
+    // 推进到下一个 sequence：窗口右滑一格，新进入窗口的 seq 与刚出窗的共用 slot idx，
+    // 仅当该 slot 恰好存着新 seq（回跳 rebase 后的遗留 future 包）时计入占用数。
     ++next_pop_seq_;
-
-    // 计算下一个 deadline：基于上一个 deadline + packet_duration
-    next_deadline_ = next_deadline_ + packet_duration_;
+    const auto entering = next_pop_seq_ + static_cast<std::uint32_t>(capacity_ - 1);
+    if (slots_[idx].valid && slots_[idx].sequence == entering) {
+        ++fill_packets_;
+    }
 
     return got_real_data;
 }
 
-void JitterBuffer::apply_gain(std::span<std::byte> pcm, float gain) const noexcept
+template <typename Clock>
+void BasicJitterBuffer<Clock>::conceal_block(std::span<std::byte> first, std::span<std::byte> second)
 {
-    // 逐样本 memcpy 读写，不依赖缓冲区对齐。样本数 = pcm / bytes_per_sample。
-    const std::size_t sample_bytes = format_.bytes_per_sample();
-    if (sample_bytes == 0) {
-        std::memset(pcm.data(), 0, pcm.size());
-        return;
+    // 丢包隐藏（PLC）。Waveform 交给 ConcealmentEngine；Repeat 重复上一包 PCM 并逐包衰减，
+    // 比纯静音的"咔哒"声更平滑，连续丢包每包增益减半，若干包后收敛为静音。
+    if (concealment_) {
+        if (first.size() >= payload_size_) {
+            concealment_->conceal(first.first(payload_size_));
+        } else {
+            concealment_->conceal(conceal_scratch_);
+            copy_split(conceal_scratch_, first, second);
+        }
+    } else if (hide_gain_ > 0.0f) {
+        hide_gain_ *= 0.5f;
+        // 增益按样本施加：输出不跨段时原地处理，跨段（样本可能被拆开）时经中转。
+        if (first.size() >= payload_size_) {
+            std::memcpy(first.data(), pool_payload(history_buffer_).data(), payload_size_);
+            audio::dsp::apply_gain(first.first(payload_size_), format_.encoding, hide_gain_);
+        } else {
+            std::memcpy(conceal_scratch_.data(), pool_payload(history_buffer_).data(), payload_size_);
+            audio::dsp::apply_gain(conceal_scratch_, format_.encoding, hide_gain_);
+            copy_split(conceal_scratch_, first, second);
+        }
+    } else {
+        zero_split(payload_size_, first, second);
     }
-    const std::size_t samples = pcm.size() / sample_bytes;
+}
 
-    switch (format_.encoding) {
-    case AudioEncoding::PcmS16LE: {
-        for (std::size_t i = 0; i < samples; ++i) {
-            std::int16_t v;
-            std::memcpy(&v, pcm.data() + i * 2, sizeof(v));
-            v = static_cast<std::int16_t>(static_cast<float>(v) * gain);
-            std::memcpy(pcm.data() + i * 2, &v, sizeof(v));
-        }
-        break;
-    }
-    case AudioEncoding::PcmS32LE: {
-        for (std::size_t i = 0; i < samples; ++i) {
-            std::int32_t v;
-            std::memcpy(&v, pcm.data() + i * 4, sizeof(v));
-            v = static_cast<std::int32_t>(static_cast<float>(v) * gain);
-            std::memcpy(pcm.data() + i * 4, &v, sizeof(v));
+template <typename Clock>
+bool BasicJitterBuffer<Clock>::pop_stretched(std::span<std::byte> first, std::span<std::byte> second)
+{
+    // 本次输出必需的帧：不足一包时取下一个 sequence（其播放时刻已到，缺包照常隐藏）。
+    bool all_real = true;
+    const auto append_next = [&] {
+        const bool real = take_next_packet(stretcher_->prepare_append(), { });
+        stretcher_->commit_append();
+        all_real = all_real && real;
+    };
+    while (stretcher_->buffered_frames() < stretcher_->packet_frames()) {
+        append_next();
+    }
+
+    if (stretcher_->pending_frames() != 0) {
+        // 伸缩需要前瞻：只提前取已到达的包，未到的包不提前判丢，搜索范围随之缩小。
+        while (stretcher_->buffered_frames() < stretcher_->wanted_frames()) {
+            const auto& slot = slots_[next_pop_seq_ & slot_mask_];
+            if (!slot.valid || slot.sequence != next_pop_seq_) {
+                break;
+            }
+            append_next();
         }
-        break;
-    }
-    case AudioEncoding::PcmF32LE: {
-        for (std::size_t i = 0; i < samples; ++i) {
-            float v;
-            std::memcpy(&v, pcm.data() + i * 4, sizeof(v));
-            v *= gain;
-            std::memcpy(pcm.data() + i * 4, &v, sizeof(v));
+        (void)stretcher_->try_adjust();
+        // 删除后可能不足一包
+        while (stretcher_->buffered_frames() < stretcher_->packet_frames()) {
+            append_next();
         }
-        break;
-    }
-    default:
-        // S24LE/U8 打包格式解包成本高且极少使用：回退静音。
-        std::memset(pcm.data(), 0, pcm.size());
-        break;
     }
+
+    stretcher_->emit(first, second);
+    return all_real;
 }
 
-void JitterBuffer::reset()
+template <typename Clock>
+void BasicJitterBuffer<Clock>::reset()
 {
-    std::lock_guard<std::mutex> lock(slots_mutex_);
-    reset_playout_state_locked();
+    reset_playout_state();
+    publish_state();
 }
 
-void JitterBuffer::reset_playout_state_locked()
+template <typename Clock>
+void BasicJitterBuffer<Clock>::reset_playout_state()
 {
-    // 只清除 slot metadata，不清 storage_（旧数据不会被读取因为 valid=false）
+    // 只清除 slot metadata，不清 storage_（旧数据不会被读取因为 valid=false）。
+    // 缓冲索引的归属（slot / 备用 / 历史）保持不变：备用缓冲可能正被挂起的接收使用。
     for (auto& slot : slots_) {
         slot.valid = false;
     }
 
     initialized_ = false;
     next_pop_seq_ = 0;
-    highest_pushed_seq_ = 0;
+    fill_packets_ = 0;
     next_deadline_ = { };
     first_packet_time_ = { };
     consecutive_late_ = 0;
@@ -458,61 +887,66 @@ void JitterBuffer::reset_playout_state_locked()
     // 但保留已学习的 target——网络状况跨断流持续。
     adapt_clean_streak_ = 0;
     hide_gain_ = 0.0f; // PLC 失效（时间线已重置，上一包历史无意义），直到下一个真实包
+    if (concealment_) {
+        concealment_->reset();
+    }
+    if (stretcher_) {
+        stretcher_->reset();
+    }
 
     // 不清除统计计数器（packets_received_ / packets_lost_ / duplicates_ / late_packets_ / malformed_packets_）
     // 统计在 session 生命周期内累积，reset 只重置播放状态
 }
 
-std::uint64_t JitterBuffer::packets_received() const noexcept { return packets_received_.load(std::memory_order_relaxed); }
+template <typename Clock>
+void BasicJitterBuffer<Clock>::set_playout_rate(double rate) noexcept
+{
+    const double max_dev = config::DRIFT_COMP_MAX_PPM * 1e-6;
+    playout_rate_ = std::clamp(rate, 1.0 - max_dev, 1.0 + max_dev);
+    playout_step_q32_ = static_cast<std::uint64_t>(
+        std::llround(static_cast<double>(packet_duration_.count()) * 4294967296.0 / playout_rate_));
+}
 
-std::uint64_t JitterBuffer::packets_lost() const noexcept { return packets_lost_.load(std::memory_order_relaxed); }
+template <typename Clock>
+double BasicJitterBuffer<Clock>::playout_rate() const noexcept { return playout_rate_; }
 
-std::uint64_t JitterBuffer::duplicates() const noexcept { return duplicates_.load(std::memory_order_relaxed); }
+template <typename Clock>
+double BasicJitterBuffer<Clock>::mean_arrival_delay_ms() const noexcept { return published_.load().arrival_delay_ms; }
 
-std::uint64_t JitterBuffer::late_packets() const noexcept { return late_packets_.load(std::memory_order_relaxed); }
+template <typename Clock>
+std::uint32_t BasicJitterBuffer<Clock>::timeline_epoch() const noexcept { return published_.load().timeline_epoch; }
 
-std::uint64_t JitterBuffer::malformed_packets() const noexcept { return malformed_packets_.load(std::memory_order_relaxed); }
+template <typename Clock>
+std::uint64_t BasicJitterBuffer<Clock>::packets_received() const noexcept { return packets_received_.load(std::memory_order_relaxed); }
 
-std::uint64_t JitterBuffer::rebases() const noexcept { return rebases_.load(std::memory_order_relaxed); }
+template <typename Clock>
+std::uint64_t BasicJitterBuffer<Clock>::packets_lost() const noexcept { return packets_lost_.load(std::memory_order_relaxed); }
 
-std::size_t JitterBuffer::target_latency_packets() const noexcept
-{
-    std::lock_guard<std::mutex> lock(slots_mutex_);
-    return target_latency_packets_;
-}
+template <typename Clock>
+std::uint64_t BasicJitterBuffer<Clock>::duplicates() const noexcept { return duplicates_.load(std::memory_order_relaxed); }
 
-std::size_t JitterBuffer::buffer_fill_packets() const noexcept
-{
-    std::lock_guard<std::mutex> lock(slots_mutex_);
+template <typename Clock>
+std::uint64_t BasicJitterBuffer<Clock>::late_packets() const noexcept { return late_packets_.load(std::memory_order_relaxed); }
 
-    if (!initialized_) {
-        return 0;
-    }
+template <typename Clock>
+std::uint64_t BasicJitterBuffer<Clock>::malformed_packets() const noexcept { return malformed_packets_.load(std::memory_order_relaxed); }
 
-    // 计算已 push 但尚未 pop 的有效包数
-    std::size_t count = 0;
-    auto diff = seq_diff(highest_pushed_seq_, next_pop_seq_);
-    if (diff < 0) {
-        return 0;
-    }
+template <typename Clock>
+std::uint64_t BasicJitterBuffer<Clock>::rebases() const noexcept { return rebases_.load(std::memory_order_relaxed); }
 
-    // 遍历 [next_pop_seq_, highest_pushed_seq_] 范围内的 slot
-    for (int32_t i = 0; i <= diff && static_cast<std::size_t>(i) < capacity_; ++i) {
-        auto seq = next_pop_seq_ + static_cast<std::uint32_t>(i);
-        auto idx = seq & slot_mask_;
-        if (slots_[idx].valid && slots_[idx].sequence == seq) {
-            ++count;
-        }
-    }
-    return count;
-}
+template <typename Clock>
+std::size_t BasicJitterBuffer<Clock>::target_latency_packets() const noexcept { return published_.load().target_packets; }
 
-std::size_t JitterBuffer::capacity_packets() const noexcept { return capacity_; }
+template <typename Clock>
+std::size_t BasicJitterBuffer<Clock>::buffer_fill_packets() const noexcept { return published_.load().fill_packets; }
 
-std::uint32_t JitterBuffer::next_sequence() const noexcept
-{
-    std::lock_guard<std::mutex> lock(slots_mutex_);
-    return next_pop_seq_;
-}
+template <typename Clock>
+std::size_t BasicJitterBuffer<Clock>::capacity_packets() const noexcept { return capacity_; }
+
+template <typename Clock>
+std::uint32_t BasicJitterBuffer<Clock>::next_sequence() const noexcept { return published_.load().next_pop_seq; }
+
+template class BasicJitterBuffer<std::chrono::steady_clock>;
+template class BasicJitterBuffer<SimClock>;
 
 } // namespace aqua::jitter
@@ -1,13 +1,17 @@
 #ifndef AQUA_JITTER_BUFFER_H
 #define AQUA_JITTER_BUFFER_H
 
+#include "core/jitter_buffer/concealment.h"
+#include "core/jitter_buffer/delay_histogram.h"
+#include "core/jitter_buffer/seqlock.h"
+#include "core/jitter_buffer/sim_clock.h"
+#include "core/jitter_buffer/time_stretcher.h"
 #include "core/public/audio_format.h"
 #include "core/public/config.h"
 
 #include <atomic>
 #include <chrono>
 #include <cstdint>
-#include <mutex>
 #include <optional>
 #include <span>
 #include <vector>
@@ -18,25 +22,45 @@ namespace aqua::jitter {
 //
 // 核心设计：
 // - push 时不判定丢包，只归类（expected / future / duplicate / late）
-// - 只有超过 playout deadline 才判定 lost 并静音填充
-// - 预分配连续 PCM storage，热路径零 heap allocation
+// - 时间线按样本位置组织：播放块 = frames_per_packet 帧，块号 = sample_position / 每块帧数
+//   （固定包长时即 sequence）。push_at 接受任意整帧长度的包，可跨块、可只覆盖块的一部分；
+//   每个 slot 记录已到达帧的位图，缺失帧在 pop 时按丢包隐藏补齐
+// - 只有超过 playout deadline 才判定 lost 并以 PLC 填充
+// - 预分配连续 PCM 缓冲池，热路径零 heap allocation
+// - 零拷贝：slot / 接收备用缓冲 / PLC 历史均为池内缓冲索引，入槽与刷新 PLC 历史
+//   只交换索引；UDP 可直接收进 receive_buffer()，pop 可直接写进 RingBuffer 预留区
 // - 不依赖 timer，只暴露 next_playout_deadline() 供外部调度器使用
 // - rebase 保持节奏：小缺口沿原 cadence 推进 deadline（PLC 填补），
 //   只有大于 target 的断裂才重新缓冲，避免每次 rebase 停供打穿下游 RB
 // - 自适应 target（可选）：构造 floor 为下限兼初始值，late 压力下抬升、
 //   持续干净后缓慢回落，区间 [floor, ceiling]。调节通过 next_deadline_ ±1 拍
-//   实现蓄水/排水；与 drift rebase（时间线级）共用检测窗口但机制正交。
+//   实现蓄水/排水，或（time_stretch）交给 TimeStretcher 以略慢/略快的播放速率
+//   逐步完成；与 drift rebase（时间线级）共用检测窗口但机制正交。
+//
+// 时钟为模板参数（BasicJitterBuffer<Clock>，Clock 满足 std::chrono Clock 要求）：
+// 运行时用 JitterBuffer = BasicJitterBuffer<steady_clock>；离线仿真（aqua_jbsim）用
+// BasicJitterBuffer<SimClock>，时间由仿真器推进，远快于实时。成员定义在 .cpp，
+// 仅对这两种时钟显式实例化。
 //
 // Threading contract:
-//   push() 和 pop_next() 必须在同一个 executor / 线程中调用。
-//   当前设计为 io_context 单线程，push 来自 UDP 回调，pop_next 来自 steady_timer 回调。
-//   slots_ 访问由 slots_mutex_ 保护，允许诊断 getter（buffer_fill_packets）从其他线程安全读取。
+//   push() / pop_next() / reset() 必须在同一个 executor / 线程中调用。
+//   Timer 播放模式为 io_context 单线程，push 来自 UDP 回调，pop_next 来自 steady_timer 回调；
+//   Pull 模式两者都在播放回调线程（client::PullPlayout 经 IngressQueue 取包后 push_at）。
+//   热路径不加锁：占用数增量维护（O(1)），每次 push/pop/reset 末尾经 seqlock 发布
+//   一份状态快照；诊断 getter（buffer_fill_packets / target_latency_packets /
+//   next_sequence）只读快照，可从任意线程调用且永不阻塞热路径。
 //   统计计数器（packets_received_ 等）为 atomic，可从任意线程读取。
 
 // 自适应 target 参数（默认值取 config.h）。快升慢降 + 迟滞带：
 //   窗口内 late >= raise_late_count        → target +1 包（deadline 后移 1 拍蓄水）
 //   连续 lower_clean_windows 个干净窗口    → target -1 包（deadline 前移 1 拍排水）
 //   0 < late < raise_late_count            → 保持，且打断连续干净计数
+// estimator：LateCount = 上述 AIMD；Histogram = 到达延迟直方图的 histogram_quantile 分位
+// （遗忘因子 histogram_forget_factor，见 DelayHistogram），逐包评估、需要时一次抬升到位，
+// 窗口结束时一次回落到位（仍限于 [floor, ceiling]）；raise/lower 阈值不再使用。
+// time_stretch：deadline 不再跳变，改为向 TimeStretcher 记一包帧数的待伸缩量，
+// pop 以至多 PLAYOUT_STRETCH_MAX_RATE_PERCENT 的速率偏差删/插基音周期逐步排水/蓄水
+// （无整拍跳变的可闻断续；库默认关闭保证行为确定）。
 // max_packets（可选）：自适应 target 上限（包数）。nullopt = capacity/2（默认）。
 // 调用方给大 ceiling 时需同步放大 capacity（构造校验 max_packets <= capacity/2）；
 // 上游推导规则见 config.h（用户面仅 jitter-buffer 单参数：
@@ -46,11 +70,27 @@ struct AdaptiveTargetConfig {
     std::uint32_t raise_late_count = aqua::config::JITTER_DETECT_RAISE_LATE_COUNT;
     std::uint32_t lower_clean_windows = aqua::config::JITTER_DETECT_LOWER_CLEAN_WINDOWS;
     std::optional<std::size_t> max_packets; // nullopt = capacity/2
+    bool time_stretch = false;
+    config::JitterEstimator estimator = config::JitterEstimator::LateCount;
+    float histogram_quantile = aqua::config::JITTER_HISTOGRAM_QUANTILE; // (0, 1]
+    float histogram_forget_factor = aqua::config::JITTER_HISTOGRAM_FORGET_FACTOR; // (0, 1)
+};
+
+// 用户面单参数（jitter-buffer 毫秒）推导的 JB 尺寸，规则见 config.h：
+// capacity = bit_ceil(max(MIN_CAPACITY, ceil(ms→packets)))，floor = capacity/4，ceiling = capacity/2。
+// 客户端运行时与 aqua_jbsim 共用，保证仿真与线上同一运行点。
+struct JitterBufferSizing {
+    std::size_t capacity_packets;
+    std::size_t floor_packets;
+    std::size_t ceiling_packets;
 };
+[[nodiscard]] JitterBufferSizing derive_jitter_sizing(std::uint32_t jitter_buffer_ms,
+    std::uint32_t sample_rate, std::uint32_t frames_per_packet) noexcept;
 
-class JitterBuffer {
+template <typename Clock>
+class BasicJitterBuffer {
 public:
-    using clock = std::chrono::steady_clock;
+    using clock = Clock;
     using time_point = clock::time_point;
 
     // 构造时预分配所有内存。
@@ -63,42 +103,88 @@ public:
     // detect_window_packets: 检测窗口大小（包数），drift rebase 与 AIMD 共用，默认 config.h 值
     // drift_rebase_late_count: 窗口内 late 包数 >= 此值时触发时间线 rebase，默认 config.h 值
     // adaptive:          启用自适应 target（nullopt = 固定 target，库默认关闭保证行为确定）
-    JitterBuffer(const AudioFormat& format,
+    // receive_headroom_bytes: 零拷贝接收时 payload 前预留的报文头字节数（见 receive_buffer()）
+    // plc_mode:          丢包隐藏算法（默认 Repeat；Waveform 见 ConcealmentEngine）
+    // max_payload_bytes: push_at 接受的单包上限（0 = 一块，即固定包长）；
+    //                    同时是 receive_buffer() 的 payload 区大小
+    BasicJitterBuffer(const AudioFormat& format,
         std::uint32_t frames_per_packet,
         std::size_t floor_packets,
         std::size_t capacity_packets,
         std::uint32_t detect_window_packets = aqua::config::JITTER_DETECT_WINDOW_PACKETS,
         std::uint32_t drift_rebase_late_count = aqua::config::JITTER_DRIFT_REBASE_LATE_COUNT,
-        std::optional<AdaptiveTargetConfig> adaptive = std::nullopt);
+        std::optional<AdaptiveTargetConfig> adaptive = std::nullopt,
+        std::size_t receive_headroom_bytes = 0,
+        config::PlcMode plc_mode = config::PlcMode::Repeat,
+        std::size_t max_payload_bytes = 0);
 
-    JitterBuffer(const JitterBuffer&) = delete;
-    JitterBuffer& operator=(const JitterBuffer&) = delete;
+    BasicJitterBuffer(const BasicJitterBuffer&) = delete;
+    BasicJitterBuffer& operator=(const BasicJitterBuffer&) = delete;
 
     // UDP I/O 线程调用：推入收到的音频包。
     // 自动归类：expected / future / duplicate / late。
     // push 时不判定丢包。payload 大小不匹配的畸形包计数后丢弃（malformed_packets）。
+    // payload 恰好位于 receive_buffer() 的 payload 区时，入槽只交换缓冲索引（零拷贝）；
+    // 其他来源照常拷贝。
     void push(std::uint32_t sequence,
         std::span<const std::byte> payload);
 
+    // 按样本位置推入：payload 为从 sample_position 起的连续整帧 PCM，长度可逐包变化
+    // （1 帧 ~ max_payload_bytes）。包可跨多个播放块，也可只覆盖块的一部分；分类按
+    // 其覆盖的块进行（末块已过播放时刻 = late，全部帧已在窗口内到达 = duplicate）。
+    // 非整帧、空包或超过 max_payload_bytes 的包计为 malformed。
+    // sample_position 按 uint32 回绕展开（相邻包间距须 < 2^31 帧）。
+    void push_at(std::uint32_t sample_position,
+        std::span<const std::byte> payload);
+
+    // 指定到达时刻的版本：包在别处排队后才入 JB 时（拉模式播放，见 client::PullPlayout），
+    // 以真实到达时刻参与起播 deadline、到达延迟与自适应 target，不受排队时长影响。
+    // arrival 不得晚于当前时刻。
+    void push_at(std::uint32_t sample_position,
+        std::span<const std::byte> payload, time_point arrival);
+
+    // 零拷贝接收缓冲：headroom + max_payload_bytes 字节，位于池内当前备用缓冲。
+    // 供 UdpTransport 直接收包：报文头落在 headroom，payload 紧随其后。
+    // 包被入槽后备用缓冲换成槽位让出的旧缓冲，因此每次投递接收前须重新获取。
+    // 返回的缓冲在下一次 push 之前保持不变（pop_next / reset 不触碰备用缓冲）。
+    [[nodiscard]] std::span<std::byte> receive_buffer() noexcept;
+
     // 外部调度器查询下一次播放 deadline。
     // 返回 nullopt 表示尚未收到第一个包。
     // 线程契约：必须在调用 push()/pop_next() 的同一线程调用（当前 io_context 单线程模型）。
-    // 本方法无锁读取时间线状态，跨线程调用是 data race；诊断用途请用带锁的
+    // 本方法直接读取时间线状态，跨线程调用是 data race；诊断用途请用读快照的
     // buffer_fill_packets()/next_sequence()。
     [[nodiscard]] std::optional<time_point> next_playout_deadline() const noexcept;
 
     // deadline 到达后调用。输出 payload_size 字节：真实 PCM 或丢包隐藏。
-    // 丢包时输出"上一包 PCM 的衰减重复"（Packet Loss Concealment），
-    // 连续丢包每包增益减半（0.5, 0.25, ...）收敛为静音；无上一包历史时直接静音。
-    // 返回 true 表示输出了真实 PCM，false 表示输出了隐藏/静音（丢包）。
+    // 丢包时输出隐藏 PCM（Packet Loss Concealment），按构造时的 plc_mode：
+    // - Repeat：上一包 PCM 的衰减重复，连续丢包每包增益减半（0.5, 0.25, ...）收敛为静音；
+    //   增益经 audio::dsp::apply_gain 施加，覆盖全部 AudioEncoding（含 S24LE/U8）。
+    // - Waveform：ConcealmentEngine 基音匹配延续，缺口与恢复处交叉淡化，长缺口线性衰减。
+    // 无上一包历史时直接静音。
+    // 块内只有部分帧到达时，先按上述方式隐藏整块，再以已到达的帧覆盖（不计丢包）。
+    // 返回 true 表示输出了完整的真实 PCM，false 表示输出含隐藏/静音。
     // 长时间断流（deadline 落后超过整个 target 缓冲量）时重置时间线并输出静音。
+    // 时间伸缩进行中时输出取自 TimeStretcher 的 FIFO：一次 pop 可能取 0~多个 sequence，
+    // 返回值表示本次取出的包是否全部为真实 PCM。
     // output 的大小必须 >= payload_size。
     [[nodiscard]] bool pop_next(std::span<std::byte> output);
 
+    // 两段输出版本：payload 依次写满 first 再写 second（对应 RingBuffer 跨尾部的
+    // 预留区域，见 SpscRingBuffer::prepare_write），省去中转缓冲。
+    // first.size() + second.size() 必须 >= payload_size。
+    [[nodiscard]] bool pop_next(std::span<std::byte> first, std::span<std::byte> second);
+
     // 重置播放状态（如严重乱序或 session 重置时）。
-    // 只清除 slot 和 timeline 状态，不清除统计计数器。
+    // 只清除 slot 和 timeline 状态，不清除统计计数器。须与 push/pop_next 同线程调用。
     void reset();
 
+    // 出队节拍速率（时钟漂移补偿）：deadline 每拍推进 packet_duration / rate。
+    // rate > 1 出队变快（发送端时钟偏快时跟上到达速率），1.0 = 名义节拍（默认）。
+    // 钳到 1 ± DRIFT_COMP_MAX_PPM；推进量以 Q32 定点累加，长期无舍入漂移。须与 push/pop_next 同线程调用。
+    void set_playout_rate(double rate) noexcept;
+    [[nodiscard]] double playout_rate() const noexcept;
+
     // ---- Diagnostics ----
 
     [[nodiscard]] std::uint64_t packets_received() const noexcept;
@@ -107,53 +193,133 @@ public:
     [[nodiscard]] std::uint64_t late_packets() const noexcept;
     [[nodiscard]] std::uint64_t malformed_packets() const noexcept;
     [[nodiscard]] std::uint64_t rebases() const noexcept; // 时间线重建次数（drift/跳跃/连续late 触发）
-    [[nodiscard]] std::size_t target_latency_packets() const noexcept; // 当前 target（自适应时可变，加锁读）
-    [[nodiscard]] std::size_t buffer_fill_packets() const noexcept;
+    // 以下三项读 seqlock 快照（最近一次 push/pop/reset 结束时的状态），任意线程可调用。
+    [[nodiscard]] std::size_t target_latency_packets() const noexcept; // 当前 target（自适应时可变）
+    [[nodiscard]] std::size_t buffer_fill_packets() const noexcept; // 窗口内已到未播包数
     [[nodiscard]] std::size_t capacity_packets() const noexcept;
     [[nodiscard]] std::uint32_t next_sequence() const noexcept;
+    // 到达延迟均值（ms，读快照）：有效到达包相对名义到达时刻（播放时刻 - target）的延迟 EWMA，
+    // 时间线（重）建时归零。发送端与出队节拍的速率差使其线性漂移，供漂移补偿回路使用；
+    // target 调整不改变它。
+    [[nodiscard]] double mean_arrival_delay_ms() const noexcept;
+    // 时间线建立次数（首包、rebase、断流 reset 后重建均 +1，读快照）：变化即到达延迟基准已重置。
+    [[nodiscard]] std::uint32_t timeline_epoch() const noexcept;
 
 private:
     struct Slot {
-        std::uint32_t sequence = 0;
+        std::uint32_t sequence = 0; // 块号
         bool valid = false;
+        std::uint32_t buffer = 0; // 池内缓冲索引
+        std::uint32_t filled = 0; // 已到达帧数；== frames_per_packet_ 时整块齐备（位图不再查看）
     };
 
+    // 一个待入槽的包：从块 block 的第 offset 帧起共 frames 帧。
+    struct Fragment {
+        std::uint32_t block;
+        std::uint32_t offset;
+        std::uint32_t frames;
+        std::span<const std::byte> pcm;
+    };
+
+    // 跨线程发布的状态快照（seqlock 载荷，须 trivially copyable）
+    struct PublishedState {
+        std::uint32_t next_pop_seq = 0;
+        std::uint32_t fill_packets = 0;
+        std::uint32_t target_packets = 0;
+        std::uint32_t timeline_epoch = 0;
+        float arrival_delay_ms = 0.0f;
+    };
+
+    // 池内缓冲 b 的 payload 区（跳过 headroom）
+    std::span<std::byte> pool_payload(std::uint32_t buffer)
+    {
+        return { storage_.data() + buffer * buffer_stride_ + headroom_, payload_size_ };
+    }
     std::span<std::byte> slot_payload(std::size_t index)
     {
-        return { storage_.data() + index * payload_size_, payload_size_ };
+        return pool_payload(slots_[index].buffer);
     }
-    std::span<const std::byte> slot_payload(std::size_t index) const
+
+    // 将 payload（恰好一整块）存入 slot idx：来自备用缓冲时交换索引，否则拷贝。
+    void store_slot(std::size_t idx, std::uint32_t sequence, std::span<const std::byte> payload) noexcept;
+
+    // 入槽：整块对齐的包走 store_slot，其余按块拆开拷贝并更新到达位图。
+    // 只写 [next_pop_seq_, next_pop_seq_ + capacity) 内的块；新占用的块计入占用数。
+    void store(const Fragment& frag) noexcept;
+    void store_frames(std::uint32_t block, std::uint32_t offset, std::span<const std::byte> pcm) noexcept;
+
+    // 包的全部帧是否都已在 slot 中（重复包判定）。
+    [[nodiscard]] bool covered(const Fragment& frag) const noexcept;
+    [[nodiscard]] std::uint32_t last_block(const Fragment& frag) const noexcept
     {
-        return { storage_.data() + index * payload_size_, payload_size_ };
+        return frag.block + (frag.offset + frag.frames - 1) / frames_per_packet_;
     }
 
+    // slot idx 的到达位图（coverage_words_ 个 64 位字）
+    std::uint64_t* coverage(std::size_t index) noexcept { return coverage_.data() + index * coverage_words_; }
+    const std::uint64_t* coverage(std::size_t index) const noexcept { return coverage_.data() + index * coverage_words_; }
+
     // 有符号差值比较，正确处理 sequence 回绕
     static int32_t seq_diff(std::uint32_t a, std::uint32_t b) noexcept
     {
         return static_cast<int32_t>(a - b);
     }
 
-    // 以指定 sequence 为基准初始化播放时间线（首个包或 reset 后）
-    void init_timeline(std::uint32_t sequence,
-        std::span<const std::byte> payload);
+    // 以包的首块为基准初始化播放时间线（首个包或 reset 后）
+    void init_timeline(const Fragment& frag);
+
+    // push / pop_next 的实现体；公开入口在其返回后统一 publish_state()，
+    // 避免每个提前返回分支各自发布。
+    void push_impl(const Fragment& frag);
+    [[nodiscard]] bool pop_next_impl(std::span<std::byte> first, std::span<std::byte> second);
+
+    // 丢包隐藏一整块写入 first / second（Repeat 衰减重复 / Waveform / 静音）。
+    void conceal_block(std::span<std::byte> first, std::span<std::byte> second);
+
+    // 取出 next_pop_seq_（真实包或丢包隐藏）写入 first / second 并推进窗口，不动 deadline。
+    // 返回 true 表示真实 PCM。
+    [[nodiscard]] bool take_next_packet(std::span<std::byte> first, std::span<std::byte> second);
+    // 时间伸缩激活时的 pop：按需从 JB 取包追加到 TimeStretcher FIFO，尝试一次伸缩，输出一包。
+    [[nodiscard]] bool pop_stretched(std::span<std::byte> first, std::span<std::byte> second);
+
+    // reset 的实现体（pop_next 内部断流检测复用）
+    void reset_playout_state();
+
+    // 全量重算占用数：扫描 [next_pop_seq_, next_pop_seq_ + capacity) 的有效 slot。
+    // 仅在时间线重建（init_timeline，低频）时调用；稳态由 push/pop 增量维护。
+    void recount_fill() noexcept;
 
-    // reset 的无锁体（pop_next 内部断流检测复用，调用方必须已持有 slots_mutex_）
-    void reset_playout_state_locked();
+    // 将当前时间线状态发布到 seqlock 快照（push/pop/reset 末尾调用）。
+    void publish_state() noexcept;
 
     // 检测窗口评估：在 push 完成当前包分类并计入窗口后调用。
     // 窗口满时用同一份计数依次评估：drift rebase（late >= drift_rebase_late_count_
     // → init_timeline 重建时间线）与 AIMD（raise/lower/hold），然后重置窗口。
     // 返回 true 表示 drift rebase 已接管本包（init_timeline 已存储），调用方跳过常规入槽。
-    // 调用方必须已持有 slots_mutex_ 且时间线已初始化。
-    [[nodiscard]] bool evaluate_detect_window_locked(std::uint32_t sequence,
-        std::span<const std::byte> payload);
+    // 调用方必须保证时间线已初始化。
+    [[nodiscard]] bool evaluate_detect_window(const Fragment& frag);
+
+    // 自适应 target 改变 delta 包：deadline 整拍移动（回落时钳到 now），
+    // 或启用时间伸缩时记入 TimeStretcher 的待伸缩量。
+    void shift_target(std::int64_t delta);
 
-    // 丢包隐藏：按编码逐样本乘增益（S16/S32/F32）。
-    // S24LE/U8 解包成本高且极少使用，输出静音（全零）。
-    void apply_gain(std::span<std::byte> pcm, float gain) const noexcept;
+    // 与 next_pop_seq_ 相差 diff 的包的实际播放时刻（含伸缩 FIFO 与待伸缩量的偏移）。
+    [[nodiscard]] time_point playout_time(std::int32_t diff) const noexcept;
+
+    // 与 next_pop_seq_ 相差 diff 的块相对名义到达时刻（播放时刻 - target 缓冲量）的到达延迟。
+    [[nodiscard]] std::chrono::nanoseconds arrival_delay(std::int32_t diff) const noexcept;
+    // 有效到达包（含 late）：更新到达延迟 EWMA；Histogram 估计器时记入直方图。
+    void track_arrival(std::int32_t diff);
+    // Histogram 估计器：记录本包到达延迟，分位高于当前 target 时立即抬升。
+    void observe_arrival(std::chrono::nanoseconds delay);
+    // 直方图分位对应的 target（钳到 [floor, ceiling]）。
+    [[nodiscard]] std::size_t histogram_target() const noexcept;
 
     AudioFormat format_;
-    std::size_t payload_size_; // 每个 packet 的 PCM 字节数
+    std::uint32_t frames_per_packet_; // 每个播放块的帧数
+    std::size_t frame_bytes_;
+    std::size_t payload_size_; // 每个播放块的 PCM 字节数
+    std::size_t max_payload_bytes_; // push_at 单包上限（>= payload_size_）
     std::chrono::nanoseconds packet_duration_; // 每包时长（纳秒精度，由 frames_per_packet 和 sample_rate 推导）
 
     std::size_t target_latency_packets_; // 当前 target（自适应启用时在 [floor, ceiling] 游走）
@@ -165,22 +331,53 @@ private:
     std::size_t capacity_;
     std::size_t slot_mask_;
 
+    // 缓冲池：capacity 个 slot 缓冲 + 1 个接收备用 + 1 个 PLC 历史，每个
+    // headroom_ + max_payload_bytes_ 字节（slot 只用前 payload_size_）。slot 与备用/历史之间只交换索引。
+    std::size_t headroom_;
+    std::size_t buffer_stride_;
     std::vector<Slot> slots_;
+    std::size_t coverage_words_; // 每 slot 位图字数 = ceil(frames_per_packet / 64)
+    std::vector<std::uint64_t> coverage_; // 部分到达块的帧位图（filled < frames_per_packet_ 时有效）
     std::vector<std::byte> storage_;
-    mutable std::mutex slots_mutex_; // 保护 slots_ / next_pop_seq_ / highest_pushed_seq_ 跨线程读取
-
-    // 丢包隐藏（PLC）：上一包真实 PCM 的副本 + 当前隐藏增益。
-    // pop 真实包时刷新副本并置增益 1.0；每次隐藏输出后增益减半，收敛为静音。
-    // 0.0 表示无可用历史（reset 后），隐藏路径输出纯静音。
-    std::vector<std::byte> last_pcm_;
+    std::uint32_t spare_buffer_; // 接收备用缓冲（receive_buffer() 指向它）
+    std::uint32_t history_buffer_; // 上一包真实 PCM（PLC 源）
+    std::vector<std::byte> conceal_scratch_; // 两段输出跨界时的 PLC 中转（仅丢包路径）
+
+    // 占用数：seq ∈ [next_pop_seq_, next_pop_seq_ + capacity) 的有效 slot 数。
+    // 入槽 +1、真实 pop -1、窗口右滑时检查新进入的 seq；时间线重建时 recount_fill() 校准。
+    std::size_t fill_packets_ = 0;
+    Seqlock<PublishedState> published_;
+
+    // 丢包隐藏（PLC）：history_buffer_ 为上一包真实 PCM + 当前隐藏增益。
+    // pop 真实包时该 slot 缓冲与历史缓冲交换索引并置增益 1.0；每次隐藏输出后增益减半，
+    // 收敛为静音。0.0 表示无可用历史（reset 后），隐藏路径输出纯静音。
     float hide_gain_ = 0.0f;
+    // PlcMode::Waveform 时存在，接管隐藏输出（hide_gain_ 不再使用）
+    std::optional<ConcealmentEngine> concealment_;
+
+    // AdaptiveTargetConfig::time_stretch 时存在：AIMD 调整经它平滑完成
+    std::optional<TimeStretcher> stretcher_;
+
+    // JitterEstimator::Histogram 时存在：到达延迟分布（桶宽 1 包，桶数 ceiling + 1）
+    std::optional<DelayHistogram> histogram_;
+    std::size_t adapt_ceiling_; // 自适应上限（max_packets 或 capacity/2）
 
     // 播放时间线
+    // 当前 push / pop 的事件时刻：push 为包到达时刻，pop 为 clock::now()。时间线只经它读时钟。
+    time_point event_time_ { };
     bool initialized_ = false; // 是否收到第一个包
     std::uint32_t next_pop_seq_ = 0; // 下一个期望 pop 的 sequence
-    std::uint32_t highest_pushed_seq_ = 0; // 已 push 的最高 sequence
     time_point first_packet_time_ { }; // 第一个包到达时间
     time_point next_deadline_ { }; // 下一个 pop 的 deadline
+    // 出队节拍（set_playout_rate）：每拍推进 playout_step_q32_ / 2^32 纳秒，低 32 位余量累加到下一拍
+    double playout_rate_ = 1.0;
+    std::uint64_t playout_step_q32_;
+    std::uint64_t playout_residual_q32_ = 0;
+    // 到达延迟 EWMA（纳秒）与时间线建立次数，经快照发布
+    double arrival_delay_avg_ns_ = 0.0;
+    std::uint32_t timeline_epoch_ = 0;
+    // push_at 的 uint32 样本位置展开为 64 位（初值偏置为块长倍数，块号低 32 位与 position / 块长一致）
+    std::uint64_t position_ = 0;
 
     // 连续 late 包计数：用于检测音频源暂停后恢复导致的时间线失步。
     // 当 pop 空转推进 next_pop_seq_ 超前于实际到达的包时，新包全部判为 late（diff<0），
@@ -189,7 +386,7 @@ private:
     std::uint32_t consecutive_late_ = 0;
 
     // 检测窗口：统计有效到达包（排除重复/畸形）中的 late 数，窗口满时
-    // 由 evaluate_detect_window_locked 评估（drift rebase 与 AIMD 共用同一份计数）。
+    // 由 evaluate_detect_window 评估（drift rebase 与 AIMD 共用同一份计数）。
     // 与 consecutive_late_ 互补：consecutive_late_ 检测全部 late（暂停/恢复），
     // 窗口比例检测交替 late（时钟漂移 / 网络压力）。
     std::uint32_t detect_window_packets_;
@@ -202,10 +399,15 @@ private:
     std::atomic<std::uint64_t> packets_lost_ { 0 };
     std::atomic<std::uint64_t> duplicates_ { 0 };
     std::atomic<std::uint64_t> late_packets_ { 0 };
-    std::atomic<std::uint64_t> malformed_packets_ { 0 }; // payload 大小不匹配的畸形包
+    std::atomic<std::uint64_t> malformed_packets_ { 0 }; // payload 大小非法（非整帧/越界）的畸形包
     std::atomic<std::uint64_t> rebases_ { 0 }; // 已初始化后的时间线重建次数（不含首包）
 };
 
+extern template class BasicJitterBuffer<std::chrono::steady_clock>;
+extern template class BasicJitterBuffer<SimClock>;
+
+using JitterBuffer = BasicJitterBuffer<std::chrono::steady_clock>;
+
 } // namespace aqua::jitter
 
 #endif // AQUA_JITTER_BUFFER_H
@@ -0,0 +1,81 @@
+#ifndef AQUA_SEQLOCK_H
+#define AQUA_SEQLOCK_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace aqua::jitter {
+
+// 单写者 seqlock：写者无锁、无等待地发布一份小型 POD 快照，读者重试直到读到一致副本。
+//
+// 用途：热路径线程（io_context）发布状态，诊断线程低频轮询。写者从不被读者阻塞，
+// 读者只在与写入重叠的极短窗口内重试。
+//
+// 实现：序号奇数 = 写入中。载荷按 64 位字存入 relaxed atomic，避免非原子读写的
+// data race（标准意义下的 UB），配合 release/acquire fence 保证序号与载荷的可见顺序。
+//
+// Threading contract:
+//   store() 只能由单一线程调用；load() 可在任意线程并发调用。
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock payload must be trivially copyable");
+
+public:
+    Seqlock() noexcept
+    {
+        store(T { });
+    }
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    void store(const T& value) noexcept
+    {
+        std::array<std::uint64_t, WORDS> raw { };
+        std::memcpy(raw.data(), &value, sizeof(T));
+
+        const auto seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(raw[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    [[nodiscard]] T load() const noexcept
+    {
+        std::array<std::uint64_t, WORDS> raw { };
+        for (;;) {
+            const auto before = seq_.load(std::memory_order_acquire);
+            if ((before & 1) != 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::size_t i = 0; i < WORDS; ++i) {
+                raw[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+        T value { };
+        std::memcpy(static_cast<void*>(&value), raw.data(), sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<std::uint64_t> seq_ { 0 };
+    std::array<std::atomic<std::uint64_t>, WORDS> words_ { };
+};
+
+} // namespace aqua::jitter
+
+#endif // AQUA_SEQLOCK_H
@@ -0,0 +1,33 @@
+#ifndef AQUA_SIM_CLOCK_H
+#define AQUA_SIM_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace aqua::jitter {
+
+// 虚拟时钟：满足 std::chrono Clock 要求（静态 now()），时间只由调用方显式推进。
+// 供 BasicJitterBuffer<SimClock> 离线仿真（aqua_jbsim / 测试）使用：到达与 pop 事件按
+// 虚拟时间顺序驱动，无需真实等待，检测窗口/回落等长时程行为可在毫秒内跑完。
+//
+// 当前时刻为 thread_local：每个线程一条独立时间线，并行仿真互不干扰；
+// 同一线程内的所有 BasicJitterBuffer<SimClock> 共享该时间线。
+struct SimClock {
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<SimClock>;
+    static constexpr bool is_steady = true;
+
+    [[nodiscard]] static time_point now() noexcept { return now_; }
+    // 设定当前时刻（调用方保证单调不减）。
+    static void set(time_point t) noexcept { now_ = t; }
+    static void advance(duration d) noexcept { now_ += d; }
+
+private:
+    static inline thread_local time_point now_ { };
+};
+
+} // namespace aqua::jitter
+
+#endif // AQUA_SIM_CLOCK_H
@@ -0,0 +1,229 @@
+#include "core/jitter_buffer/time_stretcher.h"
+#include "core/audio/dsp/sample_convert.h"
+#include "core/public/config.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace aqua::jitter {
+
+namespace {
+    // 粗搜的目标分析采样率（与 ConcealmentEngine 一致）
+    constexpr std::uint32_t COARSE_ANALYSIS_RATE = 12000;
+} // namespace
+
+TimeStretcher::TimeStretcher(const AudioFormat& format, std::uint32_t frames_per_packet)
+    : format_(format)
+    , channels_(format.channels)
+    , frame_bytes_(format.frame_bytes())
+    , packet_frames_(frames_per_packet)
+{
+    const std::uint32_t rate = format.sample_rate;
+    min_lag_ = std::max<std::uint32_t>(1, rate / config::PLC_PITCH_MAX_HZ);
+    max_lag_ = std::max(min_lag_, rate / config::PLC_PITCH_MIN_HZ);
+    decimation_ = std::max<std::uint32_t>(1, rate / COARSE_ANALYSIS_RATE);
+
+    // FIFO 上界：追加前 < wanted_frames()（≤ 2·max_lag + 一包），追加至多再一包，
+    // 插入至多 max_lag；另留一包余量，compact 后总能放下下一包。
+    capacity_frames_ = 3 * static_cast<std::size_t>(max_lag_) + 3 * packet_frames_;
+    fifo_.resize(capacity_frames_ * frame_bytes_);
+    work_.resize(2 * static_cast<std::size_t>(max_lag_) * channels_);
+    mono_.resize(2 * static_cast<std::size_t>(max_lag_));
+}
+
+std::size_t TimeStretcher::wanted_frames() const noexcept
+{
+    if (pending_ == 0) {
+        return packet_frames_;
+    }
+    const auto want = static_cast<std::uint64_t>(pending_ > 0 ? pending_ : -pending_);
+    return 2 * static_cast<std::size_t>(std::min<std::uint64_t>(max_lag_, want)) + packet_frames_;
+}
+
+std::span<std::byte> TimeStretcher::prepare_append() noexcept
+{
+    if (tail_ + packet_frames_ > capacity_frames_) {
+        compact();
+    }
+    assert(tail_ + packet_frames_ <= capacity_frames_);
+    return { frame_ptr(tail_), packet_frames_ * frame_bytes_ };
+}
+
+void TimeStretcher::commit_append() noexcept
+{
+    tail_ += packet_frames_;
+}
+
+std::int64_t TimeStretcher::try_adjust() noexcept
+{
+    if (pending_ == 0 || cooldown_frames_ > 0) {
+        return 0;
+    }
+    const bool remove = pending_ > 0;
+    const auto want = static_cast<std::uint64_t>(remove ? pending_ : -pending_);
+
+    // 候选长度：L == want（一次做完），或 L ∈ [min_lag, want - min_lag]（剩余量不短于
+    // 最短周期）；均受 FIFO 现有帧数（需 2L）与最长周期约束。
+    const auto hi_lag = static_cast<std::uint32_t>(std::min<std::size_t>(max_lag_, buffered_frames() / 2));
+    const std::uint32_t single = want <= hi_lag ? static_cast<std::uint32_t>(want) : 0;
+    const std::uint32_t lo = min_lag_;
+    std::uint32_t hi = 0;
+    if (want >= 2 * static_cast<std::uint64_t>(min_lag_)) {
+        hi = static_cast<std::uint32_t>(std::min<std::uint64_t>(hi_lag, want - min_lag_));
+    }
+    if (single == 0 && hi < lo) {
+        return 0;
+    }
+
+    // 只解码参与搜索的区段
+    const std::size_t frames = 2 * static_cast<std::size_t>(std::max(single, hi));
+    const std::size_t samples = frames * channels_;
+    audio::dsp::decode_samples(std::span<const std::byte>(frame_ptr(head_), frames * frame_bytes_),
+        format_.encoding, std::span<float>(work_).first(samples));
+    const float inv_channels = 1.0f / static_cast<float>(channels_);
+    for (std::size_t f = 0; f < frames; ++f) {
+        float sum = 0.0f;
+        for (std::size_t c = 0; c < channels_; ++c) {
+            sum += work_[f * channels_ + c];
+        }
+        mono_[f] = sum * inv_channels;
+    }
+
+    const Match match = find_match(lo, hi, single);
+    if (match.score < config::PLAYOUT_STRETCH_MIN_CORRELATION
+        && ++rejects_ < config::PLAYOUT_STRETCH_MAX_REJECTS) {
+        return 0;
+    }
+    rejects_ = 0;
+
+    // 淡化段原地写入 work_[0, L)：每个输出样本只读同下标 i 与 i+L，原地安全。
+    const std::size_t lag = match.lag;
+    for (std::size_t f = 0; f < lag; ++f) {
+        const float w = static_cast<float>(f + 1) / static_cast<float>(lag + 1);
+        for (std::size_t c = 0; c < channels_; ++c) {
+            const float a = work_[f * channels_ + c];
+            const float b = work_[(lag + f) * channels_ + c];
+            work_[f * channels_ + c] = remove ? a * (1.0f - w) + b * w : b * (1.0f - w) + a * w;
+        }
+    }
+    const auto blended = std::span<const float>(work_).first(lag * channels_);
+
+    if (remove) {
+        audio::dsp::encode_samples(blended, format_.encoding,
+            std::span<std::byte>(frame_ptr(head_), lag * frame_bytes_));
+        std::memmove(frame_ptr(head_ + lag), frame_ptr(head_ + 2 * lag),
+            (tail_ - head_ - 2 * lag) * frame_bytes_);
+        tail_ -= lag;
+    } else {
+        if (tail_ + lag > capacity_frames_) {
+            compact();
+        }
+        std::memmove(frame_ptr(head_ + 2 * lag), frame_ptr(head_ + lag),
+            (tail_ - head_ - lag) * frame_bytes_);
+        tail_ += lag;
+        audio::dsp::encode_samples(blended, format_.encoding,
+            std::span<std::byte>(frame_ptr(head_ + lag), lag * frame_bytes_));
+    }
+
+    cooldown_frames_ = lag * 100 / config::PLAYOUT_STRETCH_MAX_RATE_PERCENT;
+    const auto done = remove ? static_cast<std::int64_t>(lag) : -static_cast<std::int64_t>(lag);
+    pending_ -= done;
+    return done;
+}
+
+void TimeStretcher::emit(std::span<std::byte> first, std::span<std::byte> second) noexcept
+{
+    assert(buffered_frames() >= packet_frames_);
+    const std::size_t bytes = packet_frames_ * frame_bytes_;
+    const std::byte* src = frame_ptr(head_);
+    const std::size_t part = std::min(bytes, first.size());
+    std::memcpy(first.data(), src, part);
+    if (part < bytes) {
+        std::memcpy(second.data(), src + part, bytes - part);
+    }
+
+    head_ += packet_frames_;
+    if (head_ == tail_) {
+        head_ = 0;
+        tail_ = 0;
+    }
+    cooldown_frames_ -= std::min(cooldown_frames_, packet_frames_);
+}
+
+void TimeStretcher::reset() noexcept
+{
+    head_ = 0;
+    tail_ = 0;
+    pending_ = 0;
+    cooldown_frames_ = 0;
+    rejects_ = 0;
+}
+
+TimeStretcher::Match TimeStretcher::find_match(std::uint32_t lo, std::uint32_t hi, std::uint32_t single) const noexcept
+{
+    // 相邻两段 [0,L) 与 [L,2L) 的归一化互相关；两段均近静音视为完全相似
+    // （静音处删插最不可闻），仅一段静音记 0。
+    const auto score = [&](std::uint32_t lag, std::uint32_t stride) noexcept {
+        const float* a = mono_.data();
+        const float* b = a + lag;
+        float xy = 0.0f;
+        float xx = 0.0f;
+        float yy = 0.0f;
+        for (std::size_t i = 0; i < lag; i += stride) {
+            xy += a[i] * b[i];
+            xx += a[i] * a[i];
+            yy += b[i] * b[i];
+        }
+        constexpr float ENERGY_EPSILON = 1e-9f;
+        if (xx < ENERGY_EPSILON && yy < ENERGY_EPSILON) {
+            return 1.0f;
+        }
+        if (xx < ENERGY_EPSILON || yy < ENERGY_EPSILON) {
+            return 0.0f;
+        }
+        return xy / std::sqrt(xx * yy);
+    };
+
+    // 一次做完且足够相似时直接采用（不必分步）
+    Match best;
+    if (single != 0) {
+        best = { single, score(single, 1) };
+    }
+    if (hi < lo || best.score >= config::PLAYOUT_STRETCH_MIN_CORRELATION) {
+        return best;
+    }
+
+    // 粗搜：lag 与求和同按 decimation_ 步进；精搜：全速率 ±decimation_
+    std::uint32_t coarse = lo;
+    float coarse_score = -1.0f;
+    for (std::uint32_t lag = lo; lag <= hi; lag += decimation_) {
+        const float s = score(lag, decimation_);
+        if (s > coarse_score) {
+            coarse_score = s;
+            coarse = lag;
+        }
+    }
+    const std::uint32_t fine_lo = coarse > lo + decimation_ ? coarse - decimation_ : lo;
+    const std::uint32_t fine_hi = std::min(hi, coarse + decimation_);
+    for (std::uint32_t lag = fine_lo; lag <= fine_hi; ++lag) {
+        const float s = score(lag, 1);
+        if (s > best.score) {
+            best = { lag, s };
+        }
+    }
+    return best;
+}
+
+void TimeStretcher::compact() noexcept
+{
+    if (head_ == 0) {
+        return;
+    }
+    std::memmove(fifo_.data(), frame_ptr(head_), (tail_ - head_) * frame_bytes_);
+    tail_ -= head_;
+    head_ = 0;
+}
+
+} // namespace aqua::jitter
@@ -0,0 +1,104 @@
+#ifndef AQUA_TIME_STRETCHER_H
+#define AQUA_TIME_STRETCHER_H
+
+#include "core/public/audio_format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace aqua::jitter {
+
+// 播放时间伸缩（JitterBuffer 自适应 target 的平滑调整，NetEq accelerate /
+// preemptive expand 思路）。
+//
+// - JitterBuffer 每次 pop 仍输出一包（deadline 节奏不变）；伸缩激活时 pop 经本类的
+//   PCM FIFO 输出：FIFO 不足一包时从 JB 取下一个 sequence 追加，FIFO 删帧后会多取包
+//   （排水），插帧后会有 pop 不取包（蓄水）。
+// - 待伸缩量（adjust）：正 = 需删除的帧数，负 = 需插入的帧数。每次 try_adjust 在 FIFO
+//   开头找相邻两段长度 L 的最相似周期（L ∈ [1/PLC_PITCH_MAX_HZ, 1/PLC_PITCH_MIN_HZ]，
+//   先按 ~12kHz 抽取粗搜、再全速率精搜），按线性权重交叉淡化：
+//     删除：x[0,L) → x[L,2L) 淡化为 L 帧，后接 x[2L..]
+//     插入：x[0,L) 后插入 x[L,2L) → x[0,L) 的淡化段，再接 x[L..]
+//   两种拼接的首尾都与相邻原样本连续。L 的取法保证剩余待伸缩量为 0 或不短于最短周期，
+//   因此累计恰好删/插整数包，伸缩结束时 FIFO 回到整包、JB 恢复直通。
+// - 速率上限：删/插 L 帧后须再输出 L×100/PLAYOUT_STRETCH_MAX_RATE_PERCENT 帧才做下一次。
+// - 只解码/编码参与搜索与淡化的区段，FIFO 其余部分按原始字节搬运（S24/U8 等不损精度）。
+//
+// 构造时预分配全部内存；热路径无分配、无锁。
+// Threading contract: 与所属 JitterBuffer 的 push/pop_next 同线程调用。
+class TimeStretcher {
+public:
+    TimeStretcher(const AudioFormat& format, std::uint32_t frames_per_packet);
+
+    TimeStretcher(const TimeStretcher&) = delete;
+    TimeStretcher& operator=(const TimeStretcher&) = delete;
+
+    // 累加待伸缩量（帧）：正 = 加速排水，负 = 减速蓄水。
+    void adjust(std::int64_t frames) noexcept { pending_ += frames; }
+    [[nodiscard]] std::int64_t pending_frames() const noexcept { return pending_; }
+
+    // 仍有待伸缩量或 FIFO 非空：JitterBuffer 须经 FIFO 输出（否则直通）。
+    [[nodiscard]] bool active() const noexcept { return pending_ != 0 || tail_ != head_; }
+
+    [[nodiscard]] std::size_t buffered_frames() const noexcept { return tail_ - head_; }
+    [[nodiscard]] std::size_t packet_frames() const noexcept { return packet_frames_; }
+
+    // 下一次 try_adjust 希望 FIFO 至少持有的帧数（两个最长可选周期 + 本次输出一包）。
+    // 调用方只应提前取出已到达的包补足，不足时 try_adjust 按现有帧数缩小搜索范围。
+    [[nodiscard]] std::size_t wanted_frames() const noexcept;
+
+    // FIFO 尾部一包大小的写入区；写满后 commit_append()。
+    [[nodiscard]] std::span<std::byte> prepare_append() noexcept;
+    void commit_append() noexcept;
+
+    // 尝试一次删除/插入（受速率上限与相似度门限约束）。
+    // 返回实际伸缩帧数：正 = 删除，负 = 插入，0 = 本次未执行。
+    std::int64_t try_adjust() noexcept;
+
+    // 从 FIFO 头部输出一包到 first / second 两段（调用方保证 buffered_frames() >= 一包）。
+    void emit(std::span<std::byte> first, std::span<std::byte> second) noexcept;
+
+    // 清空 FIFO 与待伸缩量（时间线重置时调用）。
+    void reset() noexcept;
+
+private:
+    // 在 mono_ 上为长度集合 {single} ∪ [lo, hi] 搜索最相似的相邻两周期，返回 (L, 相关度)。
+    struct Match {
+        std::uint32_t lag = 0;
+        float score = -1.0f;
+    };
+    [[nodiscard]] Match find_match(std::uint32_t lo, std::uint32_t hi, std::uint32_t single) const noexcept;
+
+    std::byte* frame_ptr(std::size_t frame) noexcept { return fifo_.data() + frame * frame_bytes_; }
+    // 把 [head_, tail_) 移到缓冲起点，腾出尾部空间。
+    void compact() noexcept;
+
+    AudioFormat format_;
+    std::size_t channels_;
+    std::size_t frame_bytes_;
+    std::size_t packet_frames_;
+    std::size_t capacity_frames_;
+
+    std::uint32_t min_lag_;
+    std::uint32_t max_lag_;
+    std::uint32_t decimation_;
+
+    // PCM FIFO（原始字节，帧下标 [head_, tail_)）
+    std::vector<std::byte> fifo_;
+    std::size_t head_ = 0;
+    std::size_t tail_ = 0;
+
+    // 分析/淡化缓冲（float，按 2×max_lag 帧预分配）
+    std::vector<float> work_;
+    std::vector<float> mono_;
+
+    std::int64_t pending_ = 0; // 待伸缩帧数（正删负插）
+    std::size_t cooldown_frames_ = 0; // 速率上限：距下一次允许伸缩还需输出的帧数
+    std::uint32_t rejects_ = 0; // 连续未找到合格位置的次数
+};
+
+} // namespace aqua::jitter
+
+#endif // AQUA_TIME_STRETCHER_H
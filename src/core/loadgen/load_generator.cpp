@@ -0,0 +1,422 @@
+#include "core/loadgen/load_generator.h"
+
+#include "core/grpc/grpc_client.h"
+#include "core/loadgen/receive_stats.h"
+#include "core/logger/logger.h"
+#include "core/net/packet/packet.h"
+#include "core/public/config.h"
+#include "core/rt/process_limits.h"
+
+#include <asio.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aqua::loadgen {
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    // 测量窗口内 stop_when 轮询间隔。
+    constexpr auto POLL_INTERVAL = std::chrono::milliseconds(100);
+    // 握手等待上限：与 ClientRuntime 的 HELLO 重试总时长一致，外加一个重试间隔余量。
+    constexpr auto HANDSHAKE_WAIT = config::HELLO_HANDSHAKE_RETRY_INTERVAL * (config::HELLO_HANDSHAKE_MAX_ATTEMPTS + 1);
+
+    std::int64_t now_ns() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count();
+    }
+
+    // UDP 分片：单线程 io_context + 分片内会话共享的接收缓冲。
+    // 会话 socket 用 async_wait(wait_read) + 非阻塞 receive_from 排空，读取在分片线程内
+    // 串行发生，因此一个缓冲即可服务全部会话（UdpTransport 每 socket 64KB 缓冲，
+    // 数千会话时内存开销不可接受）。
+    struct Shard {
+        asio::io_context ioc;
+        asio::executor_work_guard<asio::io_context::executor_type> work { asio::make_work_guard(ioc) };
+        std::thread thread;
+        std::array<std::byte, config::UDP_RECV_BUFFER_BYTES> recv_buf { };
+    };
+
+    // 单个模拟会话。socket / timer / 握手状态只在所属分片线程访问；
+    // acked / failed / stats 供报告线程读取。
+    struct SimSession {
+        SimSession(Shard& s, std::uint32_t id, asio::ip::udp::endpoint server_ep,
+            std::uint32_t sample_rate, DeliveryReference& ref, double connect_latency_ms)
+            : shard(s)
+            , session_id(id)
+            , server(std::move(server_ep))
+            , socket(s.ioc)
+            , hello_timer(s.ioc)
+            , stats(sample_rate)
+            , reference(ref)
+            , connect_ms(connect_latency_ms)
+        {
+            hello_len = net::encode_hello(session_id, hello_buf);
+        }
+
+        Shard& shard;
+        std::uint32_t session_id;
+        asio::ip::udp::endpoint server;
+        asio::ip::udp::socket socket;
+        asio::steady_timer hello_timer;
+        ReceiveStats stats;
+        DeliveryReference& reference;
+        double connect_ms;
+
+        std::array<std::byte, sizeof(net::HelloPacket)> hello_buf { };
+        std::size_t hello_len = 0;
+        int hello_attempts = 0;
+
+        std::atomic<bool> acked { false };
+        std::atomic<bool> failed { false };
+
+        // 报告线程私有：本步测量窗口起点的累计值
+        ReceiveStats::Snapshot window_start { };
+
+        // ---- 以下在分片线程执行 ----
+
+        void open()
+        {
+            asio::error_code ec;
+            socket.open(server.protocol(), ec);
+            if (!ec) {
+                socket.bind(asio::ip::udp::endpoint(server.protocol(), 0), ec);
+            }
+            if (!ec) {
+                socket.non_blocking(true, ec);
+            }
+            if (ec) {
+                log_warn_fmt("loadgen: session 0x{:08X} UDP socket failed: {}", session_id, ec.message());
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+            arm_receive();
+            send_hello();
+        }
+
+        void close()
+        {
+            asio::error_code ec;
+            hello_timer.cancel();
+            socket.close(ec);
+        }
+
+        void send_hello()
+        {
+            // 握手期每 HELLO_HANDSHAKE_RETRY_INTERVAL 重试，超过次数判失败；之后按保活间隔发送。
+            if (!acked.load(std::memory_order_relaxed) && ++hello_attempts > config::HELLO_HANDSHAKE_MAX_ATTEMPTS) {
+                failed.store(true, std::memory_order_relaxed);
+                close();
+                return;
+            }
+            asio::error_code ec;
+            socket.send_to(asio::buffer(hello_buf.data(), hello_len), server, 0, ec);
+
+            hello_timer.expires_after(acked.load(std::memory_order_relaxed)
+                    ? std::chrono::duration_cast<clock::duration>(config::HELLO_KEEPALIVE_INTERVAL)
+                    : std::chrono::duration_cast<clock::duration>(config::HELLO_HANDSHAKE_RETRY_INTERVAL));
+            hello_timer.async_wait([this](const asio::error_code& wait_ec) {
+                if (!wait_ec) {
+                    send_hello();
+                }
+            });
+        }
+
+        void arm_receive()
+        {
+            socket.async_wait(asio::ip::udp::socket::wait_read, [this](const asio::error_code& ec) {
+                if (ec) {
+                    return; // socket 已关闭
+                }
+                drain();
+                arm_receive();
+            });
+        }
+
+        void drain()
+        {
+            asio::ip::udp::endpoint sender;
+            for (;;) {
+                asio::error_code ec;
+                const std::size_t n = socket.receive_from(asio::buffer(shard.recv_buf), sender, 0, ec);
+                if (ec) {
+                    return; // would_block：已排空
+                }
+                handle(std::span<const std::byte> { shard.recv_buf.data(), n });
+            }
+        }
+
+        void handle(std::span<const std::byte> data)
+        {
+            const auto type = net::peek_type(data);
+            if (!type) {
+                return;
+            }
+            if (*type == net::PacketType::HelloAck) {
+                const auto ack = net::decode_hello(data);
+                if (ack && ack->session_id == session_id) {
+                    acked.store(true, std::memory_order_relaxed);
+                }
+            } else if (*type == net::PacketType::Audio) {
+                const auto decoded = net::decode_audio(data);
+                if (decoded) {
+                    const std::int64_t arrival = now_ns();
+                    stats.record(decoded->header.sequence, decoded->header.sample_position,
+                        decoded->payload.size(), arrival,
+                        reference.offset_ns(decoded->header.sample_position, arrival));
+                }
+            }
+        }
+    };
+} // namespace
+
+struct LoadGenerator::Impl {
+    mutable std::mutex error_mutex;
+    std::string last_error;
+
+    void set_last_error(std::string message)
+    {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        last_error = std::move(message);
+    }
+};
+
+LoadGenerator::LoadGenerator()
+    : impl_(std::make_unique<Impl>())
+{
+}
+
+LoadGenerator::~LoadGenerator() = default;
+
+std::string LoadGenerator::last_error() const
+{
+    std::lock_guard<std::mutex> lock(impl_->error_mutex);
+    return impl_->last_error;
+}
+
+bool LoadGenerator::run(const LoadGenConfig& cfg, std::function<void(const StepReport&)> on_step,
+    std::function<bool()> stop_when)
+{
+    const auto should_stop = [&] { return stop_when && stop_when(); };
+
+    asio::ip::address server_address;
+    try {
+        server_address = asio::ip::make_address(cfg.server_ip);
+    } catch (const std::exception& e) {
+        impl_->set_last_error("invalid server IP address '" + cfg.server_ip + "': " + e.what());
+        return false;
+    }
+
+    // 每会话一个 UDP socket：提前提示 fd 上限，避免爬坡中途 socket 打开失败。
+    if (const auto fd_limit = rt::open_file_soft_limit(); fd_limit && cfg.sessions + 64 > *fd_limit) {
+        log_warn_fmt("loadgen: {} sessions need more file descriptors than the soft limit {} (ulimit -n)",
+            cfg.sessions, *fd_limit);
+    }
+
+    grpc::GrpcClient grpc_client;
+    if (!grpc_client.connect_to_server(cfg.server_ip, cfg.server_rpc_port)) {
+        impl_->set_last_error("failed to connect to server gRPC " + cfg.server_ip + ":"
+            + std::to_string(cfg.server_rpc_port));
+        return false;
+    }
+
+    // ---- UDP 分片线程 ----
+    const std::uint32_t shard_count = std::max(1u,
+        cfg.io_threads > 0 ? cfg.io_threads : std::thread::hardware_concurrency());
+    std::vector<std::unique_ptr<Shard>> shards;
+    for (std::uint32_t i = 0; i < shard_count; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+        shards.back()->thread = std::thread([s = shards.back().get()] { s->ioc.run(); });
+    }
+
+    std::vector<std::unique_ptr<SimSession>> sessions;
+    std::mutex sessions_mutex;
+    std::unique_ptr<DeliveryReference> reference; // 首个 Connect 拿到采样率后创建
+    std::uint32_t sample_rate = 0;
+    std::uint32_t frames_per_packet = config::AUDIO_FRAMES_PER_PACKET;
+    bool ok = true;
+
+    const std::uint32_t ramp_step = std::max(1u, cfg.ramp_step);
+    const std::uint32_t concurrency = std::max(1u, cfg.connect_concurrency);
+    std::uint32_t step = 0;
+    std::uint32_t attempted = 0; // 已发起 Connect 的会话数（含失败），决定爬坡终点
+
+    while (!should_stop() && attempted < cfg.sessions) {
+        ++step;
+        const std::size_t first_new = sessions.size();
+        const std::uint32_t first_index = attempted;
+        const std::uint32_t to_add = std::min(ramp_step, cfg.sessions - attempted);
+        attempted += to_add;
+
+        // ---- 并发 Connect ----
+        std::atomic<std::uint32_t> next { 0 };
+        std::atomic<std::uint32_t> connect_failures { 0 };
+        std::vector<std::thread> workers;
+        for (std::uint32_t w = 0; w < std::min(concurrency, to_add); ++w) {
+            workers.emplace_back([&] {
+                for (std::uint32_t i = next++; i < to_add && !should_stop(); i = next++) {
+                    const std::uint32_t index = first_index + i;
+                    grpc::ConnectResult result;
+                    const auto t0 = clock::now();
+                    const bool connected = grpc_client.connect(
+                        cfg.client_name + "-" + std::to_string(index), result);
+                    const double latency_ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+                    if (!connected || !result.audio_format.valid()) {
+                        ++connect_failures;
+                        continue;
+                    }
+
+                    std::lock_guard<std::mutex> lock(sessions_mutex);
+                    if (!reference) {
+                        sample_rate = result.audio_format.sample_rate;
+                        reference = std::make_unique<DeliveryReference>(sample_rate);
+                    }
+                    Shard& shard = *shards[index % shards.size()];
+                    sessions.push_back(std::make_unique<SimSession>(shard, result.session_id,
+                        asio::ip::udp::endpoint(server_address, result.udp_port),
+                        sample_rate, *reference, latency_ms));
+                    asio::post(shard.ioc, [s = sessions.back().get()] { s->open(); });
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        if (sessions.empty()) {
+            impl_->set_last_error("Connect RPC failed for every session (server rejected or unreachable)");
+            ok = false;
+            break;
+        }
+
+        // ---- 等待本步新会话握手完成（成功或判失败）----
+        const auto handshake_deadline = clock::now() + HANDSHAKE_WAIT;
+        while (!should_stop() && clock::now() < handshake_deadline) {
+            const bool settled = std::all_of(sessions.begin() + static_cast<std::ptrdiff_t>(first_new), sessions.end(),
+                [](const auto& s) {
+                    return s->acked.load(std::memory_order_relaxed) || s->failed.load(std::memory_order_relaxed);
+                });
+            if (settled) {
+                break;
+            }
+            std::this_thread::sleep_for(POLL_INTERVAL);
+        }
+
+        // ---- 测量窗口 ----
+        for (auto& s : sessions) {
+            s->window_start = s->stats.snapshot();
+            (void)s->stats.take_window_offset_ms();
+        }
+        const auto window_begin = clock::now();
+        while (!should_stop() && clock::now() - window_begin < cfg.step_duration) {
+            std::this_thread::sleep_for(POLL_INTERVAL);
+        }
+        const double window_s = std::chrono::duration<double>(clock::now() - window_begin).count();
+
+        // ---- 汇总报告 ----
+        StepReport report;
+        report.step = step;
+        report.window_s = window_s;
+        report.sessions_failed = connect_failures.load();
+
+        std::uint64_t packets = 0;
+        std::uint64_t bytes = 0;
+        std::vector<double> offsets;
+        std::vector<double> connect_ms;
+        double loss_sum = 0.0;
+        double jitter_sum = 0.0;
+        for (std::size_t i = 0; i < sessions.size(); ++i) {
+            auto& s = *sessions[i];
+            const bool alive = s.acked.load(std::memory_order_relaxed) && !s.failed.load(std::memory_order_relaxed);
+            if (i >= first_new) {
+                connect_ms.push_back(s.connect_ms);
+                if (!alive) {
+                    ++report.sessions_failed;
+                }
+            }
+            if (!alive) {
+                continue;
+            }
+            ++report.sessions_active;
+
+            const auto now = s.stats.snapshot();
+            const auto received = now.received - s.window_start.received;
+            const auto lost = now.lost - std::min(now.lost, s.window_start.lost);
+            packets += received;
+            bytes += now.bytes - s.window_start.bytes;
+            const double loss_pct = received + lost > 0
+                ? static_cast<double>(lost) * 100.0 / static_cast<double>(received + lost)
+                : 0.0;
+            loss_sum += loss_pct;
+            report.loss_max_pct = std::max(report.loss_max_pct, loss_pct);
+            jitter_sum += now.jitter_ms;
+            report.jitter_max_ms = std::max(report.jitter_max_ms, now.jitter_ms);
+            if (const auto offset = s.stats.take_window_offset_ms()) {
+                offsets.push_back(*offset);
+            }
+        }
+
+        if (report.sessions_active > 0 && window_s > 0.0) {
+            report.fanout_packets_per_s = static_cast<double>(packets) / window_s;
+            report.fanout_mbps = static_cast<double>(bytes) * 8.0 / window_s / 1e6;
+            report.loss_mean_pct = loss_sum / report.sessions_active;
+            report.jitter_mean_ms = jitter_sum / report.sessions_active;
+            const double nominal_pps = static_cast<double>(sample_rate) / frames_per_packet;
+            const double expected = nominal_pps * window_s * report.sessions_active;
+            report.delivery_ratio = expected > 0.0 ? static_cast<double>(packets) / expected : 0.0;
+        }
+        if (!offsets.empty()) {
+            const double min_offset = *std::min_element(offsets.begin(), offsets.end());
+            for (auto& v : offsets) {
+                v -= min_offset;
+            }
+            report.skew_p50_ms = percentile(offsets, 0.50);
+            report.skew_p99_ms = percentile(offsets, 0.99);
+            report.skew_max_ms = percentile(offsets, 1.0);
+        }
+        report.connect_p50_ms = percentile(connect_ms, 0.50);
+        report.connect_p90_ms = percentile(connect_ms, 0.90);
+        report.connect_p99_ms = percentile(connect_ms, 0.99);
+        report.connect_max_ms = percentile(connect_ms, 1.0);
+
+        if (on_step) {
+            on_step(report);
+        }
+    }
+
+    // ---- 断开：并发 Disconnect，再关闭 socket、停止分片线程 ----
+    {
+        std::atomic<std::size_t> next { 0 };
+        std::vector<std::thread> workers;
+        for (std::uint32_t w = 0; w < std::min<std::size_t>(concurrency, sessions.size()); ++w) {
+            workers.emplace_back([&] {
+                for (std::size_t i = next++; i < sessions.size(); i = next++) {
+                    grpc_client.disconnect(sessions[i]->session_id);
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+    for (auto& s : sessions) {
+        asio::post(s->shard.ioc, [p = s.get()] { p->close(); });
+    }
+    for (auto& shard : shards) {
+        shard->work.reset();
+    }
+    for (auto& shard : shards) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+    }
+    sessions.clear();
+    return ok;
+}
+
+} // namespace aqua::loadgen
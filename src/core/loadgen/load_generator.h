@@ -0,0 +1,91 @@
+#ifndef AQUA_LOAD_GENERATOR_H
+#define AQUA_LOAD_GENERATOR_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace aqua::loadgen {
+
+// 压测配置。前端（aqua_loadgen CLI）填充后传入 LoadGenerator::run()。
+struct LoadGenConfig {
+    std::string server_ip = "127.0.0.1";
+    std::uint16_t server_rpc_port = 50051;
+    // 目标会话数与爬坡：每步新增 ramp_step 个会话，新增完成后测量 step_duration。
+    std::uint32_t sessions = 100;
+    std::uint32_t ramp_step = 10;
+    std::chrono::seconds step_duration { 5 };
+    // UDP 收发分片线程数（每线程一个 io_context，会话按序号轮询分配）。0 = 硬件并发数。
+    std::uint32_t io_threads = 0;
+    // 并发 Connect RPC 数（爬坡时的建连并发度）。
+    std::uint32_t connect_concurrency = 16;
+    // gRPC Connect 上报的名称前缀（服务器日志中为 "<prefix>-<序号>"）。
+    std::string client_name = "aqua_loadgen";
+};
+
+// 每步报告。窗口指标只统计本步测量期内的增量；失败会话不计入。
+struct StepReport {
+    std::uint32_t step = 0; // 从 1 开始
+    std::uint32_t sessions_active = 0; // 握手成功、仍在接收的会话数
+    std::uint32_t sessions_failed = 0; // 本步 Connect / HELLO 握手失败数
+    double window_s = 0.0;
+
+    // server 扇出吞吐（所有会话合计）
+    double fanout_packets_per_s = 0.0;
+    double fanout_mbps = 0.0; // payload 比特率
+    // 投递率：实收包数 / (会话数 × 标称包速率 × 窗口)。< 1 表示 server 跟不上或网络丢包。
+    double delivery_ratio = 0.0;
+
+    // 单客户端丢包率（%）：会话均值 / 最大值
+    double loss_mean_pct = 0.0;
+    double loss_max_pct = 0.0;
+    // interarrival jitter（ms）：会话均值 / 最大值
+    double jitter_mean_ms = 0.0;
+    double jitter_max_ms = 0.0;
+    // 跨会话投递偏差（ms）：各会话窗口平均投递偏移的 p50 / p99 / max 减最小值。
+    // 反映 server 逐会话扇出循环的先后差，随会话数线性增长说明扇出成为瓶颈。
+    double skew_p50_ms = 0.0;
+    double skew_p99_ms = 0.0;
+    double skew_max_ms = 0.0;
+
+    // 本步新增会话的 Connect RPC 时延分位（ms）
+    double connect_p50_ms = 0.0;
+    double connect_p90_ms = 0.0;
+    double connect_p99_ms = 0.0;
+    double connect_max_ms = 0.0;
+};
+
+// 负载生成器：单进程内模拟 N 个轻量会话（gRPC Connect + HELLO 握手/保活 + 逐会话
+// 接收计数，无 JitterBuffer / 播放），按步爬坡并报告 server 扇出能力，用于找出
+// 单个 ServerRuntime 跟不上的会话数。
+//
+// 线程模型：
+//   - 调用方线程：run() 阻塞执行爬坡、测量与报告（on_step 在此线程回调）。
+//   - Connect 工作线程：每步按 connect_concurrency 并发发起 Connect RPC。
+//   - UDP 分片线程：io_threads 个单线程 io_context，各自负责一组会话的收包、
+//     握手重试与保活；同一会话的全部操作在同一线程，无需加锁。
+class LoadGenerator {
+public:
+    LoadGenerator();
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    // 阻塞运行：爬坡至 cfg.sessions 或 stop_when 返回 true 后，断开全部会话返回。
+    // 服务器不可达（gRPC 通道建立失败 / 首个会话 Connect 失败）返回 false，last_error() 有原因。
+    bool run(const LoadGenConfig& cfg, std::function<void(const StepReport&)> on_step,
+        std::function<bool()> stop_when = { });
+
+    std::string last_error() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace aqua::loadgen
+
+#endif // AQUA_LOAD_GENERATOR_H
@@ -0,0 +1,123 @@
+#include "core/loadgen/receive_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace aqua::loadgen {
+
+ReceiveStats::ReceiveStats(std::uint32_t sample_rate)
+    : sample_rate_(sample_rate)
+{
+}
+
+void ReceiveStats::record(std::uint32_t sequence, std::uint32_t sample_position, std::size_t payload_bytes,
+    std::int64_t arrival_ns, std::int64_t offset_ns) noexcept
+{
+    received_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(payload_bytes, std::memory_order_relaxed);
+    window_offset_sum_us_.fetch_add(offset_ns / 1000, std::memory_order_relaxed);
+    window_offset_count_.fetch_add(1, std::memory_order_relaxed);
+
+    // RFC 3550 interarrival jitter：transit = 到达时刻 - 媒体时间戳，J += (|D| - J) / 16。
+    const std::int64_t media_ns = sample_rate_ > 0
+        ? static_cast<std::int64_t>(static_cast<double>(sample_position) * 1e9 / sample_rate_)
+        : 0;
+    const std::int64_t transit_ns = arrival_ns - media_ns;
+
+    if (first_) {
+        first_ = false;
+        expected_seq_ = sequence + 1;
+        seen_ = 1;
+        prev_transit_ns_ = transit_ns;
+        return;
+    }
+
+    // 序号差按 int32 解释，天然处理 uint32 回绕。
+    const auto gap = static_cast<std::int32_t>(sequence - expected_seq_);
+    if (gap >= 0) {
+        lost_.fetch_add(static_cast<std::uint64_t>(gap), std::memory_order_relaxed);
+        expected_seq_ = sequence + 1;
+        // 窗口前移 gap + 1 位：跳过的序号留 0（记为缺失），新序号置位。
+        const auto shift = static_cast<std::uint64_t>(gap) + 1;
+        seen_ = shift >= kSeenWindow ? 1 : (seen_ << shift) | 1;
+    } else {
+        // bit k 对应序号 expected_seq_ - 1 - k。
+        const auto age = static_cast<std::uint64_t>(-static_cast<std::int64_t>(gap)) - 1;
+        if (age >= kSeenWindow) {
+            // 超出窗口无法判重：只计乱序，不补回丢包（宁可高估丢包）。
+            reordered_.fetch_add(1, std::memory_order_relaxed);
+        } else if (seen_ & (std::uint64_t { 1 } << age)) {
+            duplicated_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            // 迟到包：此前按跳变计入丢包，补回一个。
+            seen_ |= std::uint64_t { 1 } << age;
+            reordered_.fetch_add(1, std::memory_order_relaxed);
+            lost_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    const double d_ms = static_cast<double>(std::llabs(transit_ns - prev_transit_ns_)) / 1e6;
+    prev_transit_ns_ = transit_ns;
+    const double j = jitter_ms_.load(std::memory_order_relaxed);
+    jitter_ms_.store(j + (d_ms - j) / 16.0, std::memory_order_relaxed);
+}
+
+ReceiveStats::Snapshot ReceiveStats::snapshot() const noexcept
+{
+    Snapshot s;
+    s.received = received_.load(std::memory_order_relaxed);
+    s.lost = lost_.load(std::memory_order_relaxed);
+    s.reordered = reordered_.load(std::memory_order_relaxed);
+    s.duplicated = duplicated_.load(std::memory_order_relaxed);
+    s.bytes = bytes_.load(std::memory_order_relaxed);
+    s.jitter_ms = jitter_ms_.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::optional<double> ReceiveStats::take_window_offset_ms() noexcept
+{
+    const auto count = window_offset_count_.exchange(0, std::memory_order_relaxed);
+    const auto sum_us = window_offset_sum_us_.exchange(0, std::memory_order_relaxed);
+    if (count == 0) {
+        return std::nullopt;
+    }
+    return static_cast<double>(sum_us) / static_cast<double>(count) / 1000.0;
+}
+
+DeliveryReference::DeliveryReference(std::uint32_t sample_rate)
+    : sample_rate_(sample_rate)
+{
+}
+
+std::int64_t DeliveryReference::offset_ns(std::uint32_t sample_position, std::int64_t arrival_ns) noexcept
+{
+    if (!ready_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(init_mutex_);
+        if (!ready_.load(std::memory_order_relaxed)) {
+            t0_ns_ = arrival_ns;
+            pos0_ = sample_position;
+            ready_.store(true, std::memory_order_release);
+        }
+    }
+    if (sample_rate_ == 0) {
+        return 0;
+    }
+    const auto frames = static_cast<std::int32_t>(sample_position - pos0_);
+    const auto reference_ns = t0_ns_ + static_cast<std::int64_t>(static_cast<double>(frames) * 1e9 / sample_rate_);
+    return arrival_ns - reference_ns;
+}
+
+double percentile(std::vector<double> values, double q)
+{
+    if (values.empty()) {
+        return 0.0;
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    // 最近秩：rank = ceil(q·n)，q = 0 取最小值。
+    const auto rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(values.size())));
+    const std::size_t index = rank == 0 ? 0 : rank - 1;
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+
+} // namespace aqua::loadgen
@@ -0,0 +1,81 @@
+#ifndef AQUA_RECEIVE_STATS_H
+#define AQUA_RECEIVE_STATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace aqua::loadgen {
+
+// 单个模拟会话的接收统计（无 JitterBuffer / 播放，只做计数）。
+//
+// 线程模型：record() 只由该会话所在的 io 线程调用（单写者）；snapshot() /
+// take_window_offset_ms() 由报告线程调用。计数器用 relaxed atomic，容忍读到旧值。
+class ReceiveStats {
+public:
+    explicit ReceiveStats(std::uint32_t sample_rate);
+
+    // 记录一个音频包。offset_ns 为相对 DeliveryReference 的投递偏移（跨会话可比）。
+    void record(std::uint32_t sequence, std::uint32_t sample_position, std::size_t payload_bytes,
+        std::int64_t arrival_ns, std::int64_t offset_ns) noexcept;
+
+    struct Snapshot {
+        std::uint64_t received = 0;
+        std::uint64_t lost = 0; // 序号跳变推断的丢包（迟到补回的会扣减）
+        std::uint64_t reordered = 0; // 迟到的缺失序号（及超出判重窗口的回退序号）
+        std::uint64_t duplicated = 0; // 判重窗口内已收过的序号
+        std::uint64_t bytes = 0; // payload 字节数
+        double jitter_ms = 0.0; // RFC 3550 interarrival jitter（EWMA）
+    };
+    Snapshot snapshot() const noexcept;
+
+    // 取出本窗口的平均投递偏移（ms）并清零窗口。窗口内无包返回 std::nullopt。
+    std::optional<double> take_window_offset_ms() noexcept;
+
+private:
+    std::uint32_t sample_rate_;
+
+    // 仅写线程访问
+    bool first_ = true;
+    std::uint32_t expected_seq_ = 0;
+    // 判重窗口：bit k 表示序号 expected_seq_ - 1 - k 已收到。
+    static constexpr std::uint64_t kSeenWindow = 64;
+    std::uint64_t seen_ = 0;
+    std::int64_t prev_transit_ns_ = 0;
+
+    std::atomic<std::uint64_t> received_ { 0 };
+    std::atomic<std::uint64_t> lost_ { 0 };
+    std::atomic<std::uint64_t> reordered_ { 0 };
+    std::atomic<std::uint64_t> duplicated_ { 0 };
+    std::atomic<std::uint64_t> bytes_ { 0 };
+    std::atomic<double> jitter_ms_ { 0.0 };
+    std::atomic<std::int64_t> window_offset_sum_us_ { 0 };
+    std::atomic<std::uint64_t> window_offset_count_ { 0 };
+};
+
+// 跨会话共享的投递时间基准：首个到达的包（任意会话）确立 (t0, pos0)，之后
+// 每个 sample_position 的"参考时刻" = t0 + (pos - pos0) / sample_rate。
+// 同一个包在不同会话的偏移之差 = server 扇出 + 网络路径的时间差（delivery skew）。
+class DeliveryReference {
+public:
+    explicit DeliveryReference(std::uint32_t sample_rate);
+
+    // 返回 arrival_ns 相对该 sample_position 参考时刻的偏移（ns）。线程安全。
+    std::int64_t offset_ns(std::uint32_t sample_position, std::int64_t arrival_ns) noexcept;
+
+private:
+    std::uint32_t sample_rate_;
+    std::atomic<bool> ready_ { false };
+    std::mutex init_mutex_; // 仅首包确立基准时使用
+    std::int64_t t0_ns_ = 0;
+    std::uint32_t pos0_ = 0;
+};
+
+// 最近秩分位数（q ∈ [0, 1]）。values 为空时返回 0。
+double percentile(std::vector<double> values, double q);
+
+} // namespace aqua::loadgen
+
+#endif // AQUA_RECEIVE_STATS_H
@@ -1,5 +1,7 @@
 #include "core/logger/logger.h"
 
+#include <spdlog/sinks/stdout_color_sinks.h>
+
 #include <cstring>
 
 namespace aqua {
@@ -64,6 +66,11 @@ void set_log_level(LogLevel level)
     spdlog::set_level(to_spdlog(level));
 }
 
+void redirect_log_to_stderr()
+{
+    spdlog::set_default_logger(spdlog::stderr_color_mt("aqua_stderr"));
+}
+
 void log_trace(std::string_view message) { spdlog::default_logger_raw()->log(spdlog::level::trace, message); }
 void log_debug(std::string_view message) { spdlog::default_logger_raw()->log(spdlog::level::debug, message); }
 void log_info(std::string_view message) { spdlog::default_logger_raw()->log(spdlog::level::info, message); }
@@ -25,6 +25,10 @@ std::optional<LogLevel> log_level_from_string(std::string_view name);
 
 void set_log_level(LogLevel level);
 
+// 把默认 logger 改为输出到 stderr（stdout 被 PCM 数据占用时，如 --playback-sink stdout）。
+// 须在 set_log_level 之前、任何日志线程启动之前调用。
+void redirect_log_to_stderr();
+
 void log_trace(std::string_view message);
 void log_debug(std::string_view message);
 void log_info(std::string_view message);
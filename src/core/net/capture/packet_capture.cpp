@@ -0,0 +1,314 @@
+#include "core/net/capture/packet_capture.h"
+
+#include "core/logger/logger.h"
+#include "core/public/config.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace aqua::net {
+
+namespace {
+
+    constexpr char CAPTURE_MAGIC[4] = { 'A', 'Q', 'C', 'P' };
+
+    // 落盘线程每次从缓冲取出的最大字节数。
+    constexpr std::size_t FLUSH_CHUNK_BYTES = 64 * 1024;
+
+    // 把 src 顺序拷入两段可写区域，返回下一个写偏移。
+    std::size_t copy_into(const audio::SpscRingBuffer::WriteRegion& region, std::size_t offset,
+        std::span<const std::byte> src) noexcept
+    {
+        const std::size_t first_room = offset < region.first.size() ? region.first.size() - offset : 0;
+        const std::size_t head = std::min(first_room, src.size());
+        if (head > 0) {
+            std::memcpy(region.first.data() + offset, src.data(), head);
+        }
+        if (head < src.size()) {
+            const std::size_t second_offset = offset + head - region.first.size();
+            std::memcpy(region.second.data() + second_offset, src.data() + head, src.size() - head);
+        }
+        return offset + src.size();
+    }
+
+} // namespace
+
+// ---- CaptureWriter ----
+
+CaptureWriter::CaptureWriter(std::string path, std::size_t ring_bytes)
+    : path_(std::move(path))
+    , ring_(ring_bytes)
+    , flush_buf_(FLUSH_CHUNK_BYTES)
+{
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    stop();
+}
+
+bool CaptureWriter::start(const CaptureInfo& info)
+{
+    if (running_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    out_ = std::fopen(path_.c_str(), "wb");
+    if (out_ == nullptr) {
+        log_error_fmt("Packet capture: cannot open '{}' for writing", path_);
+        return false;
+    }
+
+    CaptureFileHeader header { };
+    std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+    header.version = CAPTURE_FORMAT_VERSION;
+    header.encoding = static_cast<std::uint8_t>(info.format.encoding);
+    header.channels = info.format.channels;
+    header.sample_rate = info.format.sample_rate;
+    header.session_id = info.session_id;
+    if (std::fwrite(&header, 1, sizeof(header), out_) != sizeof(header)) {
+        log_error_fmt("Packet capture: failed to write header to '{}'", path_);
+        std::fclose(out_);
+        out_ = nullptr;
+        return false;
+    }
+
+    write_failed_ = false;
+    bytes_written_ = sizeof(header);
+    recorded_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    ring_.clear();
+    origin_ = std::chrono::steady_clock::now();
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this] { flush_loop(); });
+    log_info_fmt("Packet capture: recording received datagrams to '{}'", path_);
+    return true;
+}
+
+void CaptureWriter::stop()
+{
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    // 生产者已停止投递（调用方先停 io 线程），排空剩余记录。
+    drain();
+    std::fclose(out_);
+    out_ = nullptr;
+    log_info_fmt("Packet capture: {} datagrams ({} bytes) written to '{}', {} dropped",
+        recorded_.load(std::memory_order_relaxed), bytes_written_, path_,
+        dropped_.load(std::memory_order_relaxed));
+}
+
+void CaptureWriter::record(std::span<const std::byte> datagram,
+    std::chrono::steady_clock::time_point arrival) noexcept
+{
+    if (!running_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    CaptureRecordHeader header { };
+    header.arrival_ns = std::max<std::int64_t>(0,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(arrival - origin_).count());
+    header.size = static_cast<std::uint32_t>(datagram.size());
+
+    const std::size_t need = sizeof(header) + datagram.size();
+    const auto region = ring_.prepare_write(need);
+    if (region.size() < need) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const auto offset = copy_into(region, 0,
+        std::span<const std::byte> { reinterpret_cast<const std::byte*>(&header), sizeof(header) });
+    copy_into(region, offset, datagram);
+    ring_.commit_write(need);
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t CaptureWriter::recorded() const noexcept
+{
+    return recorded_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t CaptureWriter::dropped() const noexcept
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void CaptureWriter::flush_loop()
+{
+    while (running_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(config::CAPTURE_FLUSH_INTERVAL);
+        drain();
+    }
+}
+
+void CaptureWriter::drain() noexcept
+{
+    for (;;) {
+        const std::size_t got = ring_.read(flush_buf_);
+        if (got == 0) {
+            break;
+        }
+        if (write_failed_) {
+            continue; // 只排空，保证 record() 不因缓冲满而丢弃
+        }
+        if (std::fwrite(flush_buf_.data(), 1, got, out_) != got) {
+            log_error_fmt("Packet capture: write to '{}' failed, capture stops here", path_);
+            write_failed_ = true;
+            continue;
+        }
+        bytes_written_ += got;
+    }
+}
+
+// ---- CaptureReader ----
+
+CaptureReader::~CaptureReader()
+{
+    if (in_ != nullptr) {
+        std::fclose(in_);
+    }
+}
+
+bool CaptureReader::open(const std::string& path)
+{
+    if (in_ != nullptr) {
+        std::fclose(in_);
+    }
+    path_ = path;
+    in_ = std::fopen(path.c_str(), "rb");
+    if (in_ == nullptr) {
+        log_error_fmt("Packet capture: cannot open '{}' for reading", path);
+        return false;
+    }
+
+    CaptureFileHeader header { };
+    if (std::fread(&header, 1, sizeof(header), in_) != sizeof(header)
+        || std::memcmp(header.magic, CAPTURE_MAGIC, sizeof(header.magic)) != 0) {
+        log_error_fmt("Packet capture: '{}' is not an aqua capture file", path);
+        return false;
+    }
+    if (header.version != CAPTURE_FORMAT_VERSION) {
+        log_error_fmt("Packet capture: '{}' has unsupported version {} (expected {})",
+            path, header.version, CAPTURE_FORMAT_VERSION);
+        return false;
+    }
+    info_.format = { static_cast<AudioEncoding>(header.encoding), header.channels, header.sample_rate };
+    info_.session_id = header.session_id;
+    if (!info_.format.valid() || info_.format.bytes_per_sample() == 0) {
+        log_error_fmt("Packet capture: '{}' has an invalid audio format", path);
+        return false;
+    }
+    return true;
+}
+
+std::optional<CaptureReader::Record> CaptureReader::next(std::span<std::byte> out)
+{
+    if (in_ == nullptr) {
+        return std::nullopt;
+    }
+    CaptureRecordHeader header { };
+    if (std::fread(&header, 1, sizeof(header), in_) != sizeof(header)) {
+        return std::nullopt;
+    }
+    const std::size_t kept = std::min<std::size_t>(header.size, out.size());
+    if (std::fread(out.data(), 1, kept, in_) != kept) {
+        return std::nullopt;
+    }
+    if (kept < header.size
+        && std::fseek(in_, static_cast<long>(header.size - kept), SEEK_CUR) != 0) {
+        return std::nullopt;
+    }
+    return Record { header.arrival_ns, kept };
+}
+
+// ---- CaptureReplaySource ----
+
+CaptureReplaySource::CaptureReplaySource(asio::io_context& ioc)
+    : ioc_(ioc)
+    , timer_(ioc)
+    , buf_(config::UDP_RECV_BUFFER_BYTES)
+{
+}
+
+bool CaptureReplaySource::open(const std::string& path)
+{
+    return reader_.open(path);
+}
+
+void CaptureReplaySource::set_receive_buffer_provider(UdpTransport::ReceiveBufferProvider provider)
+{
+    buffer_provider_ = std::move(provider);
+}
+
+void CaptureReplaySource::start(UdpTransport::ReceiveHandler handler)
+{
+    handler_ = std::move(handler);
+    asio::post(ioc_, [this] {
+        origin_ = std::chrono::steady_clock::now();
+        deliver_due();
+    });
+}
+
+void CaptureReplaySource::stop()
+{
+    stopped_.store(true, std::memory_order_relaxed);
+    asio::post(ioc_, [this] { timer_.cancel(); });
+}
+
+bool CaptureReplaySource::finished() const noexcept
+{
+    return finished_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t CaptureReplaySource::replayed() const noexcept
+{
+    return replayed_.load(std::memory_order_relaxed);
+}
+
+void CaptureReplaySource::deliver_due()
+{
+    const asio::ip::udp::endpoint sender { };
+    while (!stopped_.load(std::memory_order_relaxed)) {
+        if (!pending_) {
+            pending_ = reader_.next(buf_);
+            if (!pending_) {
+                finished_.store(true, std::memory_order_relaxed);
+                log_info_fmt("Packet replay: finished, {} datagrams delivered",
+                    replayed_.load(std::memory_order_relaxed));
+                return;
+            }
+            if (!first_arrival_ns_) {
+                first_arrival_ns_ = pending_->arrival_ns;
+            }
+        }
+
+        const auto due = origin_ + std::chrono::nanoseconds(pending_->arrival_ns - *first_arrival_ns_);
+        if (due > std::chrono::steady_clock::now()) {
+            timer_.expires_at(due);
+            timer_.async_wait([this](const asio::error_code& ec) {
+                if (!ec) {
+                    deliver_due();
+                }
+            });
+            return;
+        }
+
+        std::span<std::byte> target = buffer_provider_ ? buffer_provider_() : std::span<std::byte> { };
+        std::size_t size = pending_->size;
+        if (target.empty()) {
+            target = buf_;
+        } else {
+            size = std::min(size, target.size());
+            std::memcpy(target.data(), buf_.data(), size);
+        }
+        pending_.reset();
+        replayed_.fetch_add(1, std::memory_order_relaxed);
+        if (handler_) {
+            handler_(sender, std::span<const std::byte> { target.data(), size });
+        }
+    }
+}
+
+} // namespace aqua::net
@@ -0,0 +1,175 @@
+#ifndef AQUA_PACKET_CAPTURE_H
+#define AQUA_PACKET_CAPTURE_H
+
+#include "core/audio/ringbuffer/spsc_ringbuffer.h"
+#include "core/net/transport/udp_transport.h"
+#include "core/public/audio_format.h"
+
+#include <asio.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace aqua::net {
+
+// 客户端数据面抓包 / 回放。
+//
+// 文件格式（小端，与 packet.h 同一假定）：
+//   CaptureFileHeader                 一次，记录会话格式与 session_id（回放时代替 gRPC Connect 结果）
+//   { CaptureRecordHeader, datagram } 每个收到的 UDP datagram 一条，原样保存（含报文头）
+// arrival_ns 相对抓包开始时刻，单调不减。
+#pragma pack(push, 1)
+struct CaptureFileHeader {
+    char magic[4]; // "AQCP"
+    std::uint16_t version;
+    std::uint8_t encoding; // AudioEncoding
+    std::uint8_t reserved;
+    std::uint32_t channels;
+    std::uint32_t sample_rate;
+    std::uint32_t session_id;
+};
+static_assert(sizeof(CaptureFileHeader) == 20);
+
+struct CaptureRecordHeader {
+    std::int64_t arrival_ns;
+    std::uint32_t size; // datagram 字节数
+};
+static_assert(sizeof(CaptureRecordHeader) == 12);
+#pragma pack(pop)
+
+inline constexpr std::uint16_t CAPTURE_FORMAT_VERSION = 1;
+
+// 抓包文件头携带的会话信息。
+struct CaptureInfo {
+    AudioFormat format;
+    std::uint32_t session_id = 0;
+};
+
+// 抓包写入端。
+//
+// 线程模型：
+//   - start()/stop() 在调用方线程；文件在 start() 内同步打开并写头，失败即返回 false。
+//   - record()：io_context 线程（唯一生产者），整条记录经 prepare_write/commit_write 一次发布，
+//     无锁、无分配、不做文件 I/O；缓冲不足时整条丢弃并计数。
+//   - 落盘线程：每 CAPTURE_FLUSH_INTERVAL 排空缓冲写文件（唯一消费者）；stop() 时排空剩余数据。
+//     写失败（磁盘满等）后停止写文件但继续排空，不影响收包。
+class CaptureWriter {
+public:
+    CaptureWriter(std::string path, std::size_t ring_bytes);
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    bool start(const CaptureInfo& info);
+    void stop();
+
+    // 记录一个 datagram。arrival 早于 start() 时按 0 记。
+    void record(std::span<const std::byte> datagram, std::chrono::steady_clock::time_point arrival) noexcept;
+
+    [[nodiscard]] std::uint64_t recorded() const noexcept;
+    [[nodiscard]] std::uint64_t dropped() const noexcept;
+
+private:
+    void flush_loop();
+    void drain() noexcept;
+
+    std::string path_;
+    audio::SpscRingBuffer ring_;
+    std::vector<std::byte> flush_buf_; // 落盘线程独占
+    std::FILE* out_ = nullptr;
+    bool write_failed_ = false; // 落盘线程独占（stop() 在 join 后访问）
+
+    std::chrono::steady_clock::time_point origin_ { };
+    std::thread thread_;
+    std::atomic<bool> running_ { false };
+    std::atomic<std::uint64_t> recorded_ { 0 };
+    std::atomic<std::uint64_t> dropped_ { 0 };
+    std::uint64_t bytes_written_ = 0;
+};
+
+// 抓包读取端（顺序读）。
+class CaptureReader {
+public:
+    CaptureReader() = default;
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    // 打开并校验文件头（magic / 版本 / 格式合法）。失败返回 false 并记日志。
+    bool open(const std::string& path);
+
+    [[nodiscard]] const CaptureInfo& info() const noexcept { return info_; }
+
+    struct Record {
+        std::int64_t arrival_ns;
+        std::size_t size; // 写入 out 的字节数
+    };
+
+    // 读取下一条记录到 out。超过 out 的 datagram 截断（与 UDP 接收缓冲行为一致）。
+    // 文件结束或记录不完整时返回 std::nullopt。
+    std::optional<Record> next(std::span<std::byte> out);
+
+private:
+    std::FILE* in_ = nullptr;
+    std::string path_;
+    CaptureInfo info_ { };
+};
+
+// 回放源：按抓包时的相对到达时序，把记录逐条交给与 UdpTransport 相同签名的接收回调，
+// 替代网络成为客户端接收路径的输入。
+//
+// 线程模型：投递与读文件都在 io_context 线程（steady_timer 驱动）；回调契约同
+// UdpTransport::start_receive。首条记录在 start() 时刻投递，其余保持与首条的时间差。
+// 调度落后（io 线程繁忙）时立即补投，不丢记录。
+class CaptureReplaySource {
+public:
+    explicit CaptureReplaySource(asio::io_context& ioc);
+
+    CaptureReplaySource(const CaptureReplaySource&) = delete;
+    CaptureReplaySource& operator=(const CaptureReplaySource&) = delete;
+
+    bool open(const std::string& path);
+
+    [[nodiscard]] const CaptureInfo& info() const noexcept { return reader_.info(); }
+
+    // 同 UdpTransport::set_receive_buffer_provider：投递前把记录拷入提供方缓冲（超长截断）。
+    void set_receive_buffer_provider(UdpTransport::ReceiveBufferProvider provider);
+
+    void start(UdpTransport::ReceiveHandler handler);
+    void stop();
+
+    // 全部记录已投递（或文件提前结束）。任意线程可读。
+    [[nodiscard]] bool finished() const noexcept;
+    [[nodiscard]] std::uint64_t replayed() const noexcept;
+
+private:
+    void deliver_due();
+
+    asio::io_context& ioc_;
+    asio::steady_timer timer_;
+    CaptureReader reader_;
+    UdpTransport::ReceiveHandler handler_;
+    UdpTransport::ReceiveBufferProvider buffer_provider_;
+
+    std::vector<std::byte> buf_; // 预读的下一条记录
+    std::optional<CaptureReader::Record> pending_;
+    std::optional<std::int64_t> first_arrival_ns_;
+    std::chrono::steady_clock::time_point origin_ { };
+
+    std::atomic<bool> stopped_ { false };
+    std::atomic<bool> finished_ { false };
+    std::atomic<std::uint64_t> replayed_ { 0 };
+};
+
+} // namespace aqua::net
+
+#endif // AQUA_PACKET_CAPTURE_H
@@ -21,6 +21,11 @@ namespace {
         std::memcpy(p, &v, sizeof(v));
     }
 
+    void write_u64_le(std::byte* p, std::uint64_t v) noexcept
+    {
+        std::memcpy(p, &v, sizeof(v));
+    }
+
     void write_u16_le(std::byte* p, std::uint16_t v) noexcept
     {
         std::memcpy(p, &v, sizeof(v));
@@ -33,6 +38,13 @@ namespace {
         return v;
     }
 
+    std::uint64_t read_u64_le(const std::byte* p) noexcept
+    {
+        std::uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
     std::uint16_t read_u16_le(const std::byte* p) noexcept
     {
         std::uint16_t v;
@@ -50,6 +62,17 @@ std::size_t encode_hello(std::uint32_t session_id, std::span<std::byte> out) noe
     return sizeof(HelloPacket);
 }
 
+std::size_t encode_hello_resume(std::uint32_t session_id, std::uint64_t resume_token,
+    std::span<std::byte> out) noexcept
+{
+    if (out.size() < sizeof(HelloResumePacket))
+        return 0;
+    out[0] = std::byte { static_cast<uint8_t>(PacketType::Hello) };
+    write_u32_le(out.data() + 1, session_id);
+    write_u64_le(out.data() + 5, resume_token);
+    return sizeof(HelloResumePacket);
+}
+
 std::size_t encode_hello_ack(std::uint32_t session_id, std::span<std::byte> out) noexcept
 {
     if (out.size() < sizeof(HelloPacket))
@@ -59,6 +82,17 @@ std::size_t encode_hello_ack(std::uint32_t session_id, std::span<std::byte> out)
     return sizeof(HelloPacket);
 }
 
+std::size_t encode_hello_ack_rejoin(std::uint32_t session_id, std::uint64_t resume_token,
+    std::span<std::byte> out) noexcept
+{
+    if (out.size() < sizeof(HelloResumePacket))
+        return 0;
+    out[0] = std::byte { static_cast<uint8_t>(PacketType::HelloAck) };
+    write_u32_le(out.data() + 1, session_id);
+    write_u64_le(out.data() + 5, resume_token);
+    return sizeof(HelloResumePacket);
+}
+
 std::size_t encode_audio(std::uint32_t session_id,
     std::uint32_t sequence,
     std::uint32_t sample_position,
@@ -111,6 +145,24 @@ std::optional<HelloPacket> decode_hello(std::span<const std::byte> in) noexcept
     return pkt;
 }
 
+std::optional<std::uint64_t> decode_hello_resume_token(std::span<const std::byte> in) noexcept
+{
+    if (in.size() < sizeof(HelloResumePacket))
+        return std::nullopt;
+    if (static_cast<PacketType>(static_cast<uint8_t>(in[0])) != PacketType::Hello)
+        return std::nullopt;
+    return read_u64_le(in.data() + 5);
+}
+
+std::optional<std::uint64_t> decode_hello_ack_rejoin_token(std::span<const std::byte> in) noexcept
+{
+    if (in.size() < sizeof(HelloResumePacket))
+        return std::nullopt;
+    if (static_cast<PacketType>(static_cast<uint8_t>(in[0])) != PacketType::HelloAck)
+        return std::nullopt;
+    return read_u64_le(in.data() + 5);
+}
+
 std::optional<DecodedAudio> decode_audio(std::span<const std::byte> in) noexcept
 {
     if (in.size() < sizeof(AudioPacketHeader))
@@ -23,6 +23,19 @@ struct HelloPacket {
 static_assert(sizeof(HelloPacket) == 5);
 #pragma pack(pop)
 
+// 扩展 HELLO（会话恢复）：HelloPacket 后追加 Connect 下发的 resume_token。
+// 服务端校验令牌后可仅凭 UDP 重新挂接（会话仍在：刷新 endpoint；刚超时移除：以原 session_id 恢复；
+// 其余：新建 session），无需重走 gRPC Connect。不认识扩展字段的旧服务端按普通 HELLO 处理（decode_hello 忽略尾部字节）。
+// 同一布局（type = HelloAck）即扩展 HELLO_ACK：服务端经 UDP 新建的 session_id + 其令牌，与请求等长（无放大）。
+#pragma pack(push, 1)
+struct HelloResumePacket {
+    PacketType type; // 1 byte（Hello）
+    std::uint32_t session_id; // 4 bytes LE
+    std::uint64_t resume_token; // 8 bytes LE
+};
+static_assert(sizeof(HelloResumePacket) == 13);
+#pragma pack(pop)
+
 // AUDIO 包头，后面紧跟 PCM payload
 // 注意：sample_position 为 uint32_t，48kHz/144帧/包下约 24.8 小时回绕。
 // 接收方（DiagnosticsManager）应视为模运算值，回绕后诊断指标会跳变但不影响音频播放。
@@ -43,15 +56,28 @@ static_assert(sizeof(AudioPacketHeader) == 15);
 // 当前为单源广播模型，客户端忽略 Audio 包的 session_id；此常量供 server 侧语义使用。
 inline constexpr std::uint32_t kBroadcastSessionId = 0;
 
+// HELLO_ACK 的 session_id = 0 表示扩展 HELLO 的恢复被拒绝（令牌无效，例如服务端已重启；或无法新建 session），
+// 客户端应立即改走 gRPC Connect。session_id 恒非零，无歧义。
+inline constexpr std::uint32_t kResumeRejectedSessionId = 0;
+
 // ---- 编码 ----
 
 // 将 HelloPacket 编码到 out 缓冲。返回写入的字节数。
 // out 必须至少 sizeof(HelloPacket) 字节。
 std::size_t encode_hello(std::uint32_t session_id, std::span<std::byte> out) noexcept;
 
+// 将扩展 HELLO（HelloResumePacket）编码到 out 缓冲。返回写入的字节数，空间不足返回 0。
+std::size_t encode_hello_resume(std::uint32_t session_id, std::uint64_t resume_token,
+    std::span<std::byte> out) noexcept;
+
 // 将 HelloAckPacket 编码到 out 缓冲。
 std::size_t encode_hello_ack(std::uint32_t session_id, std::span<std::byte> out) noexcept;
 
+// 将扩展 HELLO_ACK（HelloResumePacket 布局，type = HelloAck）编码到 out 缓冲：经 UDP 新建的 session 及其令牌。
+// 返回写入的字节数，空间不足返回 0。
+std::size_t encode_hello_ack_rejoin(std::uint32_t session_id, std::uint64_t resume_token,
+    std::span<std::byte> out) noexcept;
+
 // 将 AudioPacketHeader + payload 编码到 out。
 // 返回写入的总字节数（header + payload），若 out 空间不足返回 0。
 std::size_t encode_audio(std::uint32_t session_id,
@@ -68,6 +94,12 @@ std::optional<PacketType> peek_type(std::span<const std::byte> in) noexcept;
 // 解码 HELLO 包。校验类型和长度。
 std::optional<HelloPacket> decode_hello(std::span<const std::byte> in) noexcept;
 
+// 取扩展 HELLO 携带的 resume_token。普通 HELLO（长度不足）/ 非 Hello 类型返回 nullopt。
+std::optional<std::uint64_t> decode_hello_resume_token(std::span<const std::byte> in) noexcept;
+
+// 取扩展 HELLO_ACK 携带的新令牌（有值即表示服务端新建了 session）。普通 HELLO_ACK / 非 HelloAck 类型返回 nullopt。
+std::optional<std::uint64_t> decode_hello_ack_rejoin_token(std::span<const std::byte> in) noexcept;
+
 // 解码 AUDIO 包头。返回 header 和 payload 的 span（指向 in 内部）。
 // 不拷贝 payload，零开销。
 struct DecodedAudio {
@@ -51,6 +51,11 @@ void UdpTransport::start_receive(ReceiveHandler handler)
     do_receive();
 }
 
+void UdpTransport::set_receive_buffer_provider(ReceiveBufferProvider provider)
+{
+    buffer_provider_ = std::move(provider);
+}
+
 void UdpTransport::send(const asio::ip::udp::endpoint& target,
     std::span<const std::byte> data)
 {
@@ -112,9 +117,13 @@ asio::ip::udp::endpoint UdpTransport::socket_local_endpoint() const
 
 void UdpTransport::do_receive()
 {
+    std::span<std::byte> target = buffer_provider_ ? buffer_provider_() : std::span<std::byte> { };
+    if (target.empty()) {
+        target = recv_buf_;
+    }
     socket_.async_receive_from(
-        asio::buffer(recv_buf_), recv_endpoint_,
-        [this](const asio::error_code& ec, std::size_t bytes) {
+        asio::buffer(target.data(), target.size()), recv_endpoint_,
+        [this, target](const asio::error_code& ec, std::size_t bytes) {
             if (ec) {
                 // operation_aborted: socket 被 stop() 关闭，正常退出，不再投递接收。
                 if (ec == asio::error::operation_aborted) {
@@ -141,7 +150,7 @@ void UdpTransport::do_receive()
                 recv_endpoint_.port());
             if (handler_) {
                 handler_(recv_endpoint_,
-                    std::span<const std::byte> { recv_buf_.data(), bytes });
+                    std::span<const std::byte> { target.data(), bytes });
             }
             // stopped_ 检查：stop() 可能在 handler 执行期间被调用，
             // 此时不应再投递新的 async_receive_from。
@@ -2,12 +2,12 @@
 #define AQUA_UDP_TRANSPORT_H
 
 #include "core/public/config.h"
+#include "core/rt/function_ref.h"
 
 #include <asio.hpp>
 
 #include <atomic>
 #include <cstdint>
-#include <functional>
 #include <memory>
 #include <span>
 
@@ -16,12 +16,19 @@ namespace aqua::net {
 // UDP 数据面传输层封装。
 // 基于 asio::io_context 异步收发，回调在 io_context 线程触发。
 // 不持有 SessionManager 引用；收到包后通过回调上交，由上层做路由。
+// handler / 缓冲提供方是非拥有引用（rt::FunctionRef）：被引用对象须存活至 stop() 之后
+// io_context 不再运行本 transport 的接收回调（通常即 io 线程 join）。
 class UdpTransport {
 public:
-    using ReceiveHandler = std::function<void(
+    using ReceiveHandler = rt::FunctionRef<void(
         const asio::ip::udp::endpoint& sender,
         std::span<const std::byte> data)>;
 
+    // 零拷贝接收：每次投递接收前在 io_context 线程调用，返回本次接收的目标缓冲
+    // （由上层持有，须存活至对应 handler 返回）。返回空 span 时使用内部 recv_buf_。
+    // 超过目标缓冲的 datagram 会被截断，提供方须按最大预期包长分配。
+    using ReceiveBufferProvider = rt::FunctionRef<std::span<std::byte>()>;
+
     explicit UdpTransport(asio::io_context& ioc);
     ~UdpTransport();
 
@@ -35,6 +42,9 @@ public:
     // 启动异步接收循环。handler 在 io_context 线程触发，禁止阻塞。
     void start_receive(ReceiveHandler handler);
 
+    // 设置接收缓冲提供方（须在 start_receive 之前调用）。
+    void set_receive_buffer_provider(ReceiveBufferProvider provider);
+
     // 异步发送数据到目标 endpoint。
     void send(const asio::ip::udp::endpoint& target,
         std::span<const std::byte> data);
@@ -54,6 +64,7 @@ private:
     asio::io_context& ioc_;
     asio::ip::udp::socket socket_;
     ReceiveHandler handler_;
+    ReceiveBufferProvider buffer_provider_;
 
     // 关闭标志：stop() 设置后阻止 send 投递新发送、do_receive 重新投递接收。
     // 用 atomic 让任意线程都能安全读取。
@@ -1,7 +1,10 @@
 #ifndef AQUA_CONFIG_H
 #define AQUA_CONFIG_H
 
+#include <array>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 namespace aqua::config {
 
@@ -15,20 +18,30 @@ inline constexpr std::chrono::seconds SESSION_TIMEOUT { 5 };
 // Server 扫描并清理过期 session 的周期。
 inline constexpr std::chrono::seconds SESSION_CLEANUP_INTERVAL { 3 };
 
+// 超时移除的 session 可凭 resume_token（扩展 HELLO）原样恢复的时限：覆盖 Wi-Fi 漫游 / 网络切换等
+// 短暂离线。主动 Disconnect 的 session 不可恢复；服务端重启后密钥改变，令牌全部失效。
+inline constexpr std::chrono::seconds SESSION_RESUME_WINDOW { 60 };
+
 // Client 发送 UDP HELLO 保活的间隔。
 // 单路保活：UDP HELLO 同时刷新 NAT 映射与 server session last_seen。
 // 必须 < SESSION_TIMEOUT / 2，确保超时前至少有 2 次保活机会（5s timeout, 1s interval → 5 次机会）。
 inline constexpr std::chrono::seconds HELLO_KEEPALIVE_INTERVAL { 1 };
 
-// Client 握手阶段重发 HELLO 的间隔（上次 HELLO 无 ACK 后隔这么久再发）。
+// Client 握手阶段重发 HELLO 的间隔上限（上次 HELLO 无 ACK 后隔这么久再发）。
 inline constexpr std::chrono::milliseconds HELLO_HANDSHAKE_RETRY_INTERVAL { 800 };
 
-// Client 握手阶段最多发送 HELLO 的次数（含首次，即最大尝试次数）。
+// Client 握手阶段最多发送 HELLO 的次数（含首次，即最大尝试次数），loadgen 按固定间隔使用。
 // HELLO_HANDSHAKE_RETRY_INTERVAL × HELLO_HANDSHAKE_MAX_ATTEMPTS = 800ms × 6 = ~5s。
 inline constexpr int HELLO_HANDSHAKE_MAX_ATTEMPTS { 6 };
 
+// ClientRuntime 握手改为 ACK 事件驱动 + 快速首重试：首个 HELLO 丢失时 20ms 后即重发，
+// 之后倍增（20/40/80/...）封顶 HELLO_HANDSHAKE_RETRY_INTERVAL；ACK 到达立即唤醒，不等重试间隔。
+// 总时限沿用固定间隔方案的 ~5s（HELLO_HANDSHAKE_TIMEOUT）。
+inline constexpr std::chrono::milliseconds HELLO_HANDSHAKE_INITIAL_RETRY { 20 };
+inline constexpr std::chrono::milliseconds HELLO_HANDSHAKE_TIMEOUT = HELLO_HANDSHAKE_RETRY_INTERVAL * HELLO_HANDSHAKE_MAX_ATTEMPTS;
+
 // Client 无音频数据接收超时：超过此时间未收到任何 Audio 包则认为 server 已断开，
-// 触发重连（--auto-reconnect）或优雅退出。应 > 几个 HELLO 间隔以容忍网络抖动；
+// 优雅退出（--auto-reconnect 时改由 CLIENT_RECONNECT_GAP 触发原位重连）。应 > 几个 HELLO 间隔以容忍网络抖动；
 // 与 SESSION_TIMEOUT 对齐（server 侧 session 5s 超时，client 侧 5s 无数据退出）。
 inline constexpr std::chrono::seconds CLIENT_AUDIO_RECV_TIMEOUT { 5 };
 
@@ -49,9 +62,33 @@ inline constexpr std::chrono::seconds RECONNECT_MAX_DELAY { 30 };
 // 会话稳定运行超过此时长后，重连退避重置回基础值（避免长时间稳定后断线仍要等 30s）。
 inline constexpr std::chrono::seconds RECONNECT_BACKOFF_RESET_AFTER { 30 };
 
+// ---- 原位重连（--auto-reconnect 时会话内重建服务端会话，播放管线不重建）----
+// 断流达到此时长即在后台重新 gRPC Connect + HELLO：播放后端、RB / JB（含已学习的 target）、
+// 诊断计数器保留，间隙内输出 PLC / 静音。远短于 CLIENT_AUDIO_RECV_TIMEOUT（整会话重建的判据）。
+inline constexpr std::chrono::milliseconds CLIENT_RECONNECT_GAP { 1000 };
+// 单次重连的 gRPC 通道就绪等待：短超时 + 每次新建通道，服务端恢复后下一次尝试即可连上，
+// 不受 gRPC 通道内部重连退避（~1s 起）拖累。
+inline constexpr std::chrono::milliseconds CLIENT_RECONNECT_CONNECT_TIMEOUT { 500 };
+// 重连失败后的重试间隔：从 INITIAL 起倍增，封顶 MAX（首次尝试立即进行）。
+inline constexpr std::chrono::milliseconds CLIENT_RECONNECT_RETRY_INITIAL { 100 };
+inline constexpr std::chrono::milliseconds CLIENT_RECONNECT_RETRY_MAX { 1000 };
+// 原位重连先尝试 UDP 快速恢复（扩展 HELLO 携带 resume_token，不经 gRPC）：首次立即发送，
+// 无 ACK 时按此间隔重发，共 CLIENT_RESUME_ATTEMPTS 次；被拒绝（ACK session_id = 0）或用尽后改走 gRPC Connect。
+inline constexpr std::chrono::milliseconds CLIENT_RESUME_RETRY_INTERVAL { 100 };
+inline constexpr int CLIENT_RESUME_ATTEMPTS { 5 };
+
 // UDP 接收缓冲大小（字节），覆盖最大 UDP datagram。
 inline constexpr std::size_t UDP_RECV_BUFFER_BYTES = 65536;
 
+// ---- 数据面抓包 / 回放（--capture-file / --replay-file）----
+// 抓包无锁缓冲（字节）：io 线程按 datagram 整条写入，落盘线程每 CAPTURE_FLUSH_INTERVAL 排空一次。
+// 48kHz/F32/2ch 约 400KB/s，4MiB ≈ 10s 磁盘停顿余量；写满时整条丢弃并计数，不阻塞收包。
+inline constexpr std::size_t CAPTURE_RINGBUFFER_BYTES = 4 * 1024 * 1024;
+inline constexpr std::chrono::milliseconds CAPTURE_FLUSH_INTERVAL { 50 };
+
+// 回放文件读完后再运行这么久让 JB / RB 排空，随后会话正常结束（不触发音频超时重连）。
+inline constexpr std::chrono::seconds REPLAY_DRAIN_TIME { 1 };
+
 // 每个音频包的帧数。这是传输/打包参数，不属于 AudioFormat。
 // 采用帧数（而非毫秒）作为基本单位：JB 时间线推进量 packet_duration =
 // frames_per_packet × 10^6 / sample_rate 精确等于音频内容真实时长，任何采样率
@@ -61,6 +98,11 @@ inline constexpr std::size_t UDP_RECV_BUFFER_BYTES = 65536;
 // 44.1kHz: 144 帧 ≈ 3.27ms；96kHz: 144 帧 = 1.5ms（包率翻倍，但无漂移）。
 inline constexpr std::uint32_t AUDIO_FRAMES_PER_PACKET = 144;
 
+// 客户端 JitterBuffer 接受的单包 PCM 上限（字节）。JB 按 sample_position 定位，
+// 包长可以逐包变化（拆包、合包、协商后的新打包长度），只要不超过此值且为整帧；
+// 同时决定零拷贝接收缓冲的 payload 区大小。8192B ≈ 48kHz/F32/2ch 下 1024 帧（~21ms）。
+inline constexpr std::size_t AUDIO_MAX_PAYLOAD_BYTES = 8192;
+
 // RingBuffer 最小容量（字节）。仅作防御下限（配合下方 RINGBUFFER_ALIGNMENT_BYTES 对齐）。
 // 实际最小容量由 RINGBUFFER_ALIGNMENT_BYTES 决定：任何 < 1024 的请求最终都会对齐到 1024。
 inline constexpr std::size_t RINGBUFFER_MIN_BYTES = 64;
@@ -131,6 +173,183 @@ inline constexpr std::uint32_t JITTER_DETECT_RAISE_LATE_COUNT = 5;
 // 恰好放大脆弱期余量；8 个窗口（~13s）要求突发真正平息后才降。
 inline constexpr std::uint32_t JITTER_DETECT_LOWER_CLEAN_WINDOWS = 8;
 
+// ---- 自适应 target 估计器 ----
+// LateCount：上述 AIMD——窗口内 late 计数驱动，每次 ±1 包（库与客户端默认）。
+// Histogram：按包记录"到达时刻相对名义到达时刻（播放时刻 - target）的延迟"，落入以包时长
+//   为宽度的桶，维护带遗忘因子的直方图（NetEq 思路）；target 取延迟分布的
+//   JITTER_HISTOGRAM_QUANTILE 分位。分布变宽时逐包立即抬升到位，窗口结束时按分位一次回落，
+//   不依赖 late 已经发生；干净链路上直接收敛到能覆盖实际抖动的最小值。
+enum class JitterEstimator : std::uint8_t {
+    LateCount = 0,
+    Histogram = 1,
+};
+
+// 目标分位：target 使这么大比例的包按时到达。
+inline constexpr float JITTER_HISTOGRAM_QUANTILE = 0.995f;
+
+// 遗忘因子：每个包先把全部桶乘以此值，再给本包桶加 (1 - 此值)。
+// 0.9993 ≈ NetEq 的 32745/32768，时间常数 ~1400 包（3ms 包约 4s）。
+inline constexpr float JITTER_HISTOGRAM_FORGET_FACTOR = 0.9993f;
+
+// ---- 时间伸缩（AdaptiveTargetConfig::time_stretch）----
+// 启用后 AIMD 不再把 deadline 整拍前移/后移，而是记一包帧数的"待伸缩量"，由
+// TimeStretcher 在相邻两个基音周期相似处删除/插入一个周期（重叠相加交叉淡化），
+// 以略快/略慢的播放速率逐步排水/蓄水，调整本身不可闻。
+// 周期搜索范围复用 PLC_PITCH_MIN_HZ / PLC_PITCH_MAX_HZ。
+
+// 播放速率偏离 1 的上限（百分比）：删/插 L 帧后至少再输出 L×100/此值 帧才做下一次。
+// 5% 下排水/蓄水 1 包约需 20 包时长。
+inline constexpr std::uint32_t PLAYOUT_STRETCH_MAX_RATE_PERCENT = 5;
+
+// 相邻两周期归一化互相关 >= 此值才在该处删除/插入（静音段总是合格）。
+inline constexpr float PLAYOUT_STRETCH_MIN_CORRELATION = 0.6f;
+
+// 连续这么多次 pop 都找不到合格位置（持续非周期信号）时取最佳位置强制执行，
+// 保证调整在有限时间内完成。
+inline constexpr std::uint32_t PLAYOUT_STRETCH_MAX_REJECTS = 16;
+
+// ---- 丢包隐藏（PLC）----
+// Repeat：上一包逐包减半重复（库默认，行为确定，开销最小）。
+// Waveform：ConcealmentEngine——在最近 ~20ms 历史中按归一化互相关找基音周期，
+//   以该周期循环延续（环接缝处交叉淡化），真实包恢复时交叉淡出；长缺口平滑衰减。
+//   消除 Repeat 在包边界的硬切"咔哒"与包长周期的蜂鸣，使有损链路可用更小的 JB target。
+enum class PlcMode : std::uint8_t {
+    Repeat = 0,
+    Waveform = 1,
+};
+
+// 基音搜索范围（Hz）：66~400Hz 覆盖人声与多数乐器基频；下限决定历史窗口长度。
+inline constexpr std::uint32_t PLC_PITCH_MIN_HZ = 66;
+inline constexpr std::uint32_t PLC_PITCH_MAX_HZ = 400;
+
+// 互相关匹配模板长度（毫秒）：历史末尾这么长的一段与候选周期前的片段比较。
+inline constexpr std::uint32_t PLC_MATCH_WINDOW_MS = 5;
+
+// 归一化互相关低于此值视为非周期信号（噪声/清音），改用最长周期循环，降低蜂鸣感。
+inline constexpr float PLC_MIN_CORRELATION = 0.3f;
+
+// 缺口开始后保持满幅的时长，其后线性衰减，到 PLC_FADE_MS 时归零（此后输出静音）。
+// 取 G.711 Appendix I 的量级：10ms 内基本不可闻，60ms 以上延续反而有害。
+inline constexpr std::uint32_t PLC_HOLD_MS = 10;
+inline constexpr std::uint32_t PLC_FADE_MS = 60;
+
+// ---- 时钟漂移补偿（RuntimeConfig::drift_compensation）----
+// 两端时钟速率差原先只能靠 drift rebase（JB 时间线重建）与 RB 重臂纠正，二者都有可闻断续。
+// 客户端 DriftCompensator 以 DiagnosticsManager 的速率估计为前馈、缓冲占用为反馈，跑两个 PI 回路：
+//   JB 回路：JB 平均到达延迟保持在设定点 → JitterBuffer::set_playout_rate（出队节拍跟随发送端时钟）
+//   RB 回路：RB 占用保持在半水位 → pop 与 RB 之间分数倍率重采样（VariableResampler）的输出/输入比
+// 回路输出钳位（ppm）：覆盖 ±1000ppm 的晶振偏差并留余量。
+inline constexpr double DRIFT_COMP_MAX_PPM = 2000.0;
+
+// PI 增益（误差单位 ms，输出单位 ppm）。缓冲占用对速率差的响应为 de/dt = Δppm / 1000 (ms/s)，
+// 闭环 ωn = sqrt(Ki / 1000) = 0.05 rad/s、ζ = Kp / 2000 / ωn ≈ 0.7：约 1 分钟收敛，
+// 比到达抖动 / 设备周期的占用噪声慢两个数量级，重采样比率平稳不可闻。前馈承担大部分修正。
+inline constexpr double DRIFT_COMP_KP_PPM_PER_MS = 70.0;
+inline constexpr double DRIFT_COMP_KI_PPM_PER_MS_S = 2.5;
+
+// 时间线（重）建后等待这么久，到达延迟 EWMA 稳定后再取 JB 回路设定点。
+inline constexpr std::chrono::seconds DRIFT_COMP_WARMUP { 3 };
+
+// RB 占用平滑时间常数：消除批量 pop 与设备周期读取造成的 ±10ms 级锯齿。
+inline constexpr std::chrono::seconds DRIFT_COMP_RB_SMOOTHING { 2 };
+
+// JitterBuffer 到达延迟 EWMA 系数（每个有效到达包）：1/256 ≈ 0.77s @3ms 包。
+inline constexpr float JITTER_ARRIVAL_DELAY_EWMA_ALPHA = 1.0f / 256.0f;
+
+// ---- 播放调度（RuntimeConfig::playout_mode）----
+// Timer：io 线程 steady_timer 按 deadline 出队 → SpscRingBuffer → 设备回调读取。RB 须预蓄水到
+//   capacity/2（默认 ~21ms）并靠饥饿重臂 / 低水位看门狗维持运行点，出队受定时器粒度影响
+//   （最小 1ms 间隔，Windows ~15.6ms）。
+// Pull：设备回调经 client::PullPlayout 直接从 JB 出队，包由 io 线程经无锁 IngressQueue 交给
+//   播放线程。无 RB 级与预蓄水，出队时刻即设备取数时刻，端到端延迟少去 RB 运行点的几十毫秒。
+// Thread：专用调度线程（client::PlayoutScheduler）按绝对 deadline 高精度睡眠后批量出队 → RB，
+//   包同样经 IngressQueue 交给该线程；出队时刻不受 io 线程收包负载影响，可选实时优先级。
+enum class PlayoutMode : std::uint8_t {
+    Timer = 0,
+    Pull = 1,
+    Thread = 2,
+};
+
+// 拉模式入口队列深度（包数）：需覆盖最长的设备回调周期内的到达量（256 包 @3ms ≈ 770ms）。
+inline constexpr std::size_t PULL_INGRESS_QUEUE_PACKETS = 256;
+
+// 拉模式出队提前量（包数）：deadline 不晚于"设备播放位置 + 提前量"即出队，吸收回调时刻抖动。
+inline constexpr std::uint32_t PULL_PLAYOUT_LEAD_PACKETS = 1;
+
+// 拉模式设备缓冲预算（PlaybackBackend::set_latency_hint）：无 RB 半水位可参照，
+// 取一个小的固定值——起播缓冲已由 JB target 提供，设备侧只需吸收回调调度抖动。
+inline constexpr std::chrono::milliseconds PULL_PLAYOUT_DEVICE_BUFFER { 10 };
+
+// 调度线程批量窗口：每次唤醒出队 deadline 不晚于"唤醒时刻 + 窗口"的全部块，
+// 包长较短（~3ms）时合并相邻 deadline，减少唤醒次数。
+inline constexpr std::chrono::microseconds PLAYOUT_SCHEDULER_BATCH_WINDOW { 2000 };
+
+// 调度线程空闲轮询间隔（尚无时间线时等待首包入队）。
+inline constexpr std::chrono::milliseconds PLAYOUT_SCHEDULER_IDLE_INTERVAL { 2 };
+
+// 调度线程单次睡眠上限：更远的唤醒请求分段睡眠，也是 stop 的最长响应时间。
+inline constexpr std::chrono::milliseconds PLAYOUT_SCHEDULER_MAX_SLEEP { 50 };
+
+// 调度线程实时优先级（RuntimeConfig::playout_realtime）：Linux SCHED_FIFO 优先级；
+// Windows 取 THREAD_PRIORITY_TIME_CRITICAL，不使用此值。
+inline constexpr int PLAYOUT_SCHEDULER_RT_PRIORITY = 70;
+
+// ---- 多服务器混音（ClientConfig::mix_sources）----
+
+// 主服务器之外最多同时订阅的服务器数（每路一个 JB + 入口队列，全部预分配）。
+inline constexpr std::size_t MIX_MAX_SOURCES = 8;
+
+// 每路混音增益上限（线性）。求和不做自动归一化，多路满幅叠加由调用方用增益控制余量。
+inline constexpr float MIX_MAX_GAIN = 4.0f;
+
+// 附加源的 gRPC 通道就绪等待：后台进行，不阻塞起播（附加源 Connect 完成后才接入混音）。
+inline constexpr std::chrono::milliseconds MIX_SOURCE_CONNECT_TIMEOUT { 1000 };
+
+// 附加源断流判据：已接入的源超过此时长未到音频即后台重新 Connect（失败按 HELLO_KEEPALIVE_INTERVAL 重试）。
+// 留出两三个保活周期：服务端会话短暂超时由保活的扩展 HELLO 经 UDP 恢复，无需 gRPC。
+inline constexpr std::chrono::milliseconds MIX_SOURCE_RECONNECT_GAP { 3000 };
+
+// ---- 线程调度策略（RuntimeConfig::thread_policies）----
+
+// 运行时线程角色，RuntimeConfig::thread_policies 的下标。
+//   服务端：Grpc（gRPC 控制面）、Io（UDP io_context）、Sender（打包发送）、Capture（采集后端回调）
+//   客户端：Session（会话 / 监控主循环）、Io（UDP io_context）、Playback（播放后端回调）、
+//           Scheduler（PlayoutMode::Thread 调度线程）
+enum class ThreadRole : std::uint8_t {
+    Grpc = 0,
+    Io = 1,
+    Sender = 2,
+    Capture = 3,
+    Session = 4,
+    Playback = 5,
+    Scheduler = 6,
+};
+inline constexpr std::size_t THREAD_ROLE_COUNT = 7;
+
+// 调度策略：Default 不改动线程的调度类（继承进程设置）。
+// Fifo / RoundRobin 对应 Linux SCHED_FIFO / SCHED_RR（priority 1~99）；
+// Windows 无实时调度类，priority >= THREAD_POLICY_WIN_TIME_CRITICAL_MIN 取
+// THREAD_PRIORITY_TIME_CRITICAL，否则取 THREAD_PRIORITY_HIGHEST。
+enum class SchedPolicy : std::uint8_t {
+    Default = 0,
+    Fifo = 1,
+    RoundRobin = 2,
+};
+
+inline constexpr int THREAD_POLICY_MIN_PRIORITY = 1;
+inline constexpr int THREAD_POLICY_MAX_PRIORITY = 99;
+inline constexpr int THREAD_POLICY_WIN_TIME_CRITICAL_MIN = 50;
+
+struct ThreadPolicy {
+    SchedPolicy policy = SchedPolicy::Default;
+    int priority = 0; // Fifo / RoundRobin 时有效
+    std::uint64_t cpu_mask = 0; // bit i = CPU i（覆盖前 64 个 CPU）；0 = 不设亲和性
+};
+
+// 锁定内存（RuntimeConfig::lock_memory）后，每个运行时线程启动时预先触碰的栈深度：
+// 之后栈增长不再缺页（mlockall 只锁已映射的页，栈按需增长的页仍会在实时路径上缺页）。
+inline constexpr std::size_t THREAD_PREFAULT_STACK_BYTES = 256 * 1024;
+
 // ---- 运行时可配置参数 ----
 // 前端（CLI / UI）填充此结构体后传入 core 组件构造函数。
 // core 不依赖全局状态，所有可调参数通过此结构体注入。
@@ -144,6 +363,40 @@ struct RuntimeConfig {
     // 越小响应越灵敏、越大判定越稳。0 = JITTER_DETECT_WINDOW_PACKETS。
     std::uint32_t jitter_detect_window_packets = JITTER_DETECT_WINDOW_PACKETS;
 
+    // 丢包隐藏算法（见 PlcMode）。
+    PlcMode plc_mode = PlcMode::Repeat;
+
+    // 自适应 target 估计器（见 JitterEstimator）。
+    JitterEstimator jitter_estimator = JitterEstimator::LateCount;
+
+    // 自适应 target 调整经时间伸缩逐步完成（见 PLAYOUT_STRETCH_*）；false = deadline 整拍跳变。
+    bool time_stretch = true;
+
+    // 时钟漂移补偿（见 DRIFT_COMP_*）；false = 仅靠 drift rebase / RB 重臂纠正。
+    // 默认关：开启后出队路径经 VariableResampler（16 抽头 sinc，群时延 8 帧），
+    // 不再走 JB → RingBuffer 预留区的零拷贝直通；长时间运行、两端时钟偏差明显时再开。
+    bool drift_compensation = false;
+
+    // 播放设备格式与服务端不同时，格式转换降低分辨率的一侧加 TPDF 抖动（dsp::FormatConverter）。
+    bool dither = true;
+
+    // 播放调度（见 PlayoutMode）。
+    PlayoutMode playout_mode = PlayoutMode::Timer;
+
+    // Thread 调度线程请求实时优先级（见 PLAYOUT_SCHEDULER_RT_PRIORITY）；权限不足时告警并以普通优先级运行。
+    bool playout_realtime = false;
+
+    // 各线程角色的调度策略 / 优先级 / CPU 亲和性（下标为 ThreadRole）。默认全部不改动。
+    // 设置失败（权限不足、CPU 不存在等）只告警并计入诊断，线程以原设置继续运行。
+    // playout_realtime 为 Scheduler 角色的快捷方式（该角色仍为 Default 时取 SCHED_FIFO
+    // PLAYOUT_SCHEDULER_RT_PRIORITY）。
+    std::array<ThreadPolicy, THREAD_ROLE_COUNT> thread_policies { };
+
+    // 启动时 mlockall(MCL_CURRENT | MCL_FUTURE) 锁定进程内存（之后分配的缓冲在映射时即驻留），
+    // 并让每个运行时线程预触碰 THREAD_PREFAULT_STACK_BYTES 栈。进程级设置，运行时停止后不解除。
+    // 失败（RLIMIT_MEMLOCK 不足 / 平台不支持）只告警并计入诊断。
+    bool lock_memory = false;
+
     // 播放 RingBuffer 大小（字节）
     std::size_t playback_ringbuffer_size = DEFAULT_PLAYBACK_RINGBUFFER_BYTES;
 
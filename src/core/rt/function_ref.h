@@ -0,0 +1,73 @@
+#ifndef AQUA_FUNCTION_REF_H
+#define AQUA_FUNCTION_REF_H
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace aqua::rt {
+
+template <typename Signature>
+class FunctionRef;
+
+// 实时路径的非拥有回调引用：上下文指针 + 函数指针，两个字长，可平凡拷贝。
+//
+// 取代设备回调 / 收包回调上的 std::function：赋值不分配；调用是一次直接函数指针调用，
+// 被引用对象的 operator() 在 thunk 里内联；捕获状态留在调用方的栈帧 / 对象里，不经堆上闭包。
+//
+// 代价是不拥有被引用对象：它必须比引用活得久——持有方（后端 / 传输层 / 调度线程）停止回调
+// 之前不得销毁。因此只接受左值可调用对象，传临时 lambda 编译期报错（否则语句结束即悬空）。
+//
+// 构造方式：
+// - FunctionRef(f)：引用具名 lambda / 函数对象；
+// - FunctionRef::bind<&T::method>(obj)：绑定成员函数，obj 即上下文；
+// - FunctionRef(fn, ctx)：C 风格回调 R (*)(void*, Args...) + 上下文指针（平台回调表 / C API）。
+//
+// 默认构造为空（operator bool 为 false），空引用调用是未定义行为，持有方按需判空。
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+public:
+    using Thunk = R (*)(void*, Args...);
+
+    constexpr FunctionRef() noexcept = default;
+
+    constexpr FunctionRef(Thunk fn, void* ctx) noexcept
+        : ctx_(ctx)
+        , fn_(fn)
+    {
+    }
+
+    template <typename F>
+        requires(std::is_object_v<F> && !std::is_same_v<std::remove_cv_t<F>, FunctionRef>
+            && std::is_invocable_r_v<R, F&, Args...>)
+    constexpr FunctionRef(F& f) noexcept
+        : ctx_(const_cast<void*>(static_cast<const void*>(std::addressof(f))))
+        , fn_([](void* ctx, Args... args) -> R {
+            return std::invoke(*static_cast<F*>(ctx), std::forward<Args>(args)...);
+        })
+    {
+    }
+
+    template <auto Method, typename T>
+    [[nodiscard]] static constexpr FunctionRef bind(T& obj) noexcept
+    {
+        return FunctionRef(
+            [](void* ctx, Args... args) -> R {
+                return std::invoke(Method, *static_cast<T*>(ctx), std::forward<Args>(args)...);
+            },
+            const_cast<void*>(static_cast<const void*>(std::addressof(obj))));
+    }
+
+    R operator()(Args... args) const { return fn_(ctx_, std::forward<Args>(args)...); }
+
+    explicit constexpr operator bool() const noexcept { return fn_ != nullptr; }
+
+private:
+    void* ctx_ = nullptr;
+    Thunk fn_ = nullptr;
+};
+
+} // namespace aqua::rt
+
+#endif // AQUA_FUNCTION_REF_H
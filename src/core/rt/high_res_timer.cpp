@@ -0,0 +1,70 @@
+#include "core/rt/high_res_timer.h"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace aqua::rt {
+
+#if defined(_WIN32)
+
+HighResTimer::HighResTimer()
+    : handle_(CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS))
+{
+}
+
+HighResTimer::~HighResTimer()
+{
+    if (handle_) {
+        CloseHandle(handle_);
+    }
+}
+
+void HighResTimer::sleep_until(clock::time_point t)
+{
+    const auto remaining = t - clock::now();
+    if (remaining <= clock::duration::zero()) {
+        return;
+    }
+    if (!handle_) {
+        std::this_thread::sleep_until(t);
+        return;
+    }
+    // 负值 = 相对时间，单位 100ns
+    LARGE_INTEGER due;
+    due.QuadPart = -std::max<LONGLONG>(1, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count() / 100);
+    if (SetWaitableTimer(handle_, &due, 0, nullptr, nullptr, FALSE)) {
+        WaitForSingleObject(handle_, INFINITE);
+    } else {
+        std::this_thread::sleep_until(t);
+    }
+}
+
+#else
+
+HighResTimer::HighResTimer() = default;
+HighResTimer::~HighResTimer() = default;
+
+void HighResTimer::sleep_until(clock::time_point t)
+{
+#if defined(__linux__)
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    timespec ts { };
+    ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    // 绝对时刻：被信号打断后原样重试即可
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) { }
+#else
+    std::this_thread::sleep_until(t);
+#endif
+}
+
+#endif
+
+} // namespace aqua::rt
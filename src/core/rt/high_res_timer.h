@@ -0,0 +1,36 @@
+#ifndef AQUA_HIGH_RES_TIMER_H
+#define AQUA_HIGH_RES_TIMER_H
+
+#include <chrono>
+
+namespace aqua::rt {
+
+// 高精度绝对时刻睡眠（PlayoutScheduler 按 deadline 唤醒用）。
+//
+// - Linux：clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)（libstdc++ 的 steady_clock 即
+//   CLOCK_MONOTONIC，无需换算），被信号打断后按同一绝对时刻重试。
+// - Windows：高分辨率 waitable timer（Windows 10 1803+）；创建失败时退回 sleep_until
+//   （粒度受 timeBeginPeriod 限制）。
+// - 其他平台：std::this_thread::sleep_until。
+// 绝对时刻不会因调用方耗时累积误差；目标时刻已过时立即返回。
+//
+// Threading contract: 单线程使用（每个调度线程一个实例）。
+class HighResTimer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    HighResTimer();
+    ~HighResTimer();
+
+    HighResTimer(const HighResTimer&) = delete;
+    HighResTimer& operator=(const HighResTimer&) = delete;
+
+    void sleep_until(clock::time_point t);
+
+private:
+    void* handle_ = nullptr; // Windows waitable timer（HANDLE）；其他平台不使用
+};
+
+} // namespace aqua::rt
+
+#endif // AQUA_HIGH_RES_TIMER_H
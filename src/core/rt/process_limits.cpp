@@ -0,0 +1,20 @@
+#include "core/rt/process_limits.h"
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace aqua::rt {
+
+std::optional<std::uint64_t> open_file_soft_limit() noexcept
+{
+#if !defined(_WIN32)
+    rlimit limit { };
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        return static_cast<std::uint64_t>(limit.rlim_cur);
+    }
+#endif
+    return std::nullopt;
+}
+
+} // namespace aqua::rt
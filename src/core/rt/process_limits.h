@@ -0,0 +1,15 @@
+#ifndef AQUA_PROCESS_LIMITS_H
+#define AQUA_PROCESS_LIMITS_H
+
+#include <cstdint>
+#include <optional>
+
+namespace aqua::rt {
+
+// 进程打开文件数（含 socket）的软上限（POSIX getrlimit(RLIMIT_NOFILE)）。
+// 无上限（RLIM_INFINITY）/ 查询失败 / 平台无此概念（Windows）时返回 nullopt。
+[[nodiscard]] std::optional<std::uint64_t> open_file_soft_limit() noexcept;
+
+} // namespace aqua::rt
+
+#endif // AQUA_PROCESS_LIMITS_H
@@ -0,0 +1,216 @@
+#include "core/rt/thread_policy.h"
+
+#include "core/logger/logger.h"
+
+#include <cstddef>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace aqua::rt {
+
+namespace {
+
+    std::atomic<bool> g_memory_locked { false };
+
+    const char* policy_name(config::SchedPolicy policy) noexcept
+    {
+        switch (policy) {
+        case config::SchedPolicy::Fifo:
+            return "SCHED_FIFO";
+        case config::SchedPolicy::RoundRobin:
+            return "SCHED_RR";
+        case config::SchedPolicy::Default:
+            break;
+        }
+        return "default";
+    }
+
+    void record(ThreadPolicyReport* report, bool ok) noexcept
+    {
+        if (!report) {
+            return;
+        }
+        if (ok) {
+            report->record_applied();
+        } else {
+            report->record_failure();
+        }
+    }
+
+    bool apply_sched(std::thread::native_handle_type handle, config::ThreadRole role, const config::ThreadPolicy& policy)
+    {
+#if defined(_WIN32)
+        const int win_priority = policy.priority >= config::THREAD_POLICY_WIN_TIME_CRITICAL_MIN
+            ? THREAD_PRIORITY_TIME_CRITICAL
+            : THREAD_PRIORITY_HIGHEST;
+        if (!SetThreadPriority(handle, win_priority)) {
+            log_warn_fmt("Thread policy [{}]: SetThreadPriority({}) failed (error {}), keeping default priority",
+                thread_role_name(role), win_priority, GetLastError());
+            return false;
+        }
+        log_info_fmt("Thread policy [{}]: priority {}", thread_role_name(role),
+            win_priority == THREAD_PRIORITY_TIME_CRITICAL ? "TIME_CRITICAL" : "HIGHEST");
+        return true;
+#elif defined(__linux__)
+        const int native_policy = policy.policy == config::SchedPolicy::Fifo ? SCHED_FIFO : SCHED_RR;
+        sched_param param { };
+        param.sched_priority = policy.priority;
+        if (const int err = ::pthread_setschedparam(handle, native_policy, &param); err != 0) {
+            log_warn_fmt("Thread policy [{}]: {} priority {} failed ({}), keeping default scheduling "
+                         "(needs CAP_SYS_NICE or an rtprio limit)",
+                thread_role_name(role), policy_name(policy.policy), policy.priority, std::strerror(err));
+            return false;
+        }
+        log_info_fmt("Thread policy [{}]: {} priority {}", thread_role_name(role), policy_name(policy.policy),
+            policy.priority);
+        return true;
+#else
+        (void)handle;
+        log_warn_fmt("Thread policy [{}]: {} not supported on this platform", thread_role_name(role),
+            policy_name(policy.policy));
+        return false;
+#endif
+    }
+
+    bool apply_affinity(std::thread::native_handle_type handle, config::ThreadRole role, std::uint64_t mask)
+    {
+#if defined(_WIN32)
+        if (SetThreadAffinityMask(handle, static_cast<DWORD_PTR>(mask)) == 0) {
+            log_warn_fmt("Thread policy [{}]: SetThreadAffinityMask(0x{:X}) failed (error {})",
+                thread_role_name(role), mask, GetLastError());
+            return false;
+        }
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64; ++cpu) {
+            if ((mask >> cpu) & 1u) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        if (const int err = ::pthread_setaffinity_np(handle, sizeof(set), &set); err != 0) {
+            log_warn_fmt("Thread policy [{}]: CPU affinity 0x{:X} failed ({})", thread_role_name(role), mask,
+                std::strerror(err));
+            return false;
+        }
+#else
+        (void)handle;
+        log_warn_fmt("Thread policy [{}]: CPU affinity not supported on this platform", thread_role_name(role));
+        return false;
+#endif
+        log_info_fmt("Thread policy [{}]: CPU affinity 0x{:X}", thread_role_name(role), mask);
+        return true;
+    }
+
+} // namespace
+
+const char* thread_role_name(config::ThreadRole role) noexcept
+{
+    switch (role) {
+    case config::ThreadRole::Grpc:
+        return "grpc";
+    case config::ThreadRole::Io:
+        return "io";
+    case config::ThreadRole::Sender:
+        return "sender";
+    case config::ThreadRole::Capture:
+        return "capture";
+    case config::ThreadRole::Session:
+        return "session";
+    case config::ThreadRole::Playback:
+        return "playback";
+    case config::ThreadRole::Scheduler:
+        return "scheduler";
+    }
+    return "unknown";
+}
+
+bool apply_thread_policy(std::thread::native_handle_type handle, config::ThreadRole role,
+    const config::ThreadPolicy& policy, ThreadPolicyReport* report)
+{
+    bool ok = true;
+    if (policy.policy != config::SchedPolicy::Default) {
+        const bool sched_ok = apply_sched(handle, role, policy);
+        record(report, sched_ok);
+        ok = ok && sched_ok;
+    }
+    if (policy.cpu_mask != 0) {
+        const bool affinity_ok = apply_affinity(handle, role, policy.cpu_mask);
+        record(report, affinity_ok);
+        ok = ok && affinity_ok;
+    }
+    return ok;
+}
+
+bool apply_current_thread_policy(config::ThreadRole role, const config::ThreadPolicy& policy,
+    ThreadPolicyReport* report)
+{
+    if (process_memory_locked()) {
+        prefault_stack();
+    }
+#if defined(_WIN32)
+    return apply_thread_policy(GetCurrentThread(), role, policy, report);
+#elif defined(__linux__)
+    return apply_thread_policy(::pthread_self(), role, policy, report);
+#else
+    return apply_thread_policy({ }, role, policy, report);
+#endif
+}
+
+bool lock_process_memory(ThreadPolicyReport* report)
+{
+    if (process_memory_locked()) {
+        if (report) {
+            report->record_memory_locked();
+        }
+        return true;
+    }
+#if defined(__linux__)
+    if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        log_warn_fmt("mlockall failed ({}), memory stays pageable (raise RLIMIT_MEMLOCK or grant CAP_IPC_LOCK)",
+            std::strerror(errno));
+        if (report) {
+            report->record_failure();
+        }
+        return false;
+    }
+    g_memory_locked.store(true, std::memory_order_relaxed);
+    prefault_stack();
+    log_info("Process memory locked (mlockall MCL_CURRENT | MCL_FUTURE)");
+    if (report) {
+        report->record_memory_locked();
+    }
+    return true;
+#else
+    log_warn("Memory locking not supported on this platform, memory stays pageable");
+    if (report) {
+        report->record_failure();
+    }
+    return false;
+#endif
+}
+
+bool process_memory_locked() noexcept
+{
+    return g_memory_locked.load(std::memory_order_relaxed);
+}
+
+void prefault_stack() noexcept
+{
+    // 按页写一次即可让栈页驻留；volatile 防止整个数组被优化掉。
+    constexpr std::size_t PAGE_BYTES = 4096;
+    volatile unsigned char stack[config::THREAD_PREFAULT_STACK_BYTES];
+    for (std::size_t i = 0; i < sizeof(stack); i += PAGE_BYTES) {
+        stack[i] = 0;
+    }
+}
+
+} // namespace aqua::rt
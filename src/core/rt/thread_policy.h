@@ -0,0 +1,76 @@
+#ifndef AQUA_THREAD_POLICY_H
+#define AQUA_THREAD_POLICY_H
+
+#include "core/public/config.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace aqua::rt {
+
+// 运行时线程的调度策略 / CPU 亲和性 / 内存锁定（RuntimeConfig::thread_policies、lock_memory）。
+//
+// 全部设置都是"尽力而为"：失败（权限不足、CPU 不存在、平台不支持）只记一条告警并计入
+// ThreadPolicyReport，线程以原有设置继续运行，不影响运行时启动。
+//
+// - 调度：Linux pthread_setschedparam(SCHED_FIFO / SCHED_RR)，需要 CAP_SYS_NICE 或 rtprio
+//   资源限制；Windows SetThreadPriority（见 config::SchedPolicy）。
+// - 亲和性：Linux pthread_setaffinity_np，Windows SetThreadAffinityMask。
+// - 内存：Linux mlockall(MCL_CURRENT | MCL_FUTURE)；其他平台不支持（计为失败）。
+//
+// 后端回调线程（采集 / 播放）由平台后端创建，运行时拿不到句柄：在首次回调里对当前线程
+// 调用 apply_current_thread_policy（一次性系统调用，之后回调零开销）。
+
+// 角色名（日志 / CLI 解析用）："grpc" / "io" / "sender" / "capture" / "session" / "playback" / "scheduler"。
+[[nodiscard]] const char* thread_role_name(config::ThreadRole role) noexcept;
+
+// 每个运行时一个：累计策略应用结果，供诊断快照 / 状态查询读取。
+// Threading contract: record_* 任意线程（各运行时线程启动时），status 任意线程。
+class ThreadPolicyReport {
+public:
+    struct Status {
+        std::uint32_t applied = 0; // 成功生效的策略设置次数（调度 / 亲和性各计一次）
+        std::uint32_t failures = 0; // 失败次数（含内存锁定）
+        bool memory_locked = false;
+    };
+
+    void record_applied() noexcept { applied_.fetch_add(1, std::memory_order_relaxed); }
+    void record_failure() noexcept { failures_.fetch_add(1, std::memory_order_relaxed); }
+    void record_memory_locked() noexcept { memory_locked_.store(true, std::memory_order_relaxed); }
+
+    [[nodiscard]] Status status() const noexcept
+    {
+        return { applied_.load(std::memory_order_relaxed), failures_.load(std::memory_order_relaxed),
+            memory_locked_.load(std::memory_order_relaxed) };
+    }
+
+private:
+    std::atomic<std::uint32_t> applied_ { 0 };
+    std::atomic<std::uint32_t> failures_ { 0 };
+    std::atomic<bool> memory_locked_ { false };
+};
+
+// 对指定线程应用策略（可在控制线程对刚创建的 std::thread 调用）。
+// 返回 true 表示请求的设置全部生效（Default 且无亲和性时恒为 true，不计入 report）。
+bool apply_thread_policy(std::thread::native_handle_type handle, config::ThreadRole role,
+    const config::ThreadPolicy& policy, ThreadPolicyReport* report = nullptr);
+
+// 对调用线程应用策略；若进程内存已锁定（lock_process_memory 成功），先预触碰
+// THREAD_PREFAULT_STACK_BYTES 栈。运行时线程在入口处调用。
+bool apply_current_thread_policy(config::ThreadRole role, const config::ThreadPolicy& policy,
+    ThreadPolicyReport* report = nullptr);
+
+// mlockall(MCL_CURRENT | MCL_FUTURE) 并预触碰调用线程的栈。进程级、幂等：已锁定时直接返回 true。
+// 应在分配热路径缓冲（RingBuffer / JitterBuffer / 入口队列）之前调用，之后的分配在映射时即驻留。
+bool lock_process_memory(ThreadPolicyReport* report = nullptr);
+
+// 进程内存是否已由 lock_process_memory 锁定。
+[[nodiscard]] bool process_memory_locked() noexcept;
+
+// 预先触碰调用线程 THREAD_PREFAULT_STACK_BYTES 深度的栈页。
+void prefault_stack() noexcept;
+
+} // namespace aqua::rt
+
+#endif // AQUA_THREAD_POLICY_H
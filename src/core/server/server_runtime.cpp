@@ -6,7 +6,9 @@
 #include "core/logger/logger.h"
 #include "core/net/packet/packet.h"
 #include "core/net/transport/udp_transport.h"
+#include "core/rt/thread_policy.h"
 #include "core/session/session_manager.h"
+#include "core/session/session_resumer.h"
 
 #include <asio.hpp>
 
@@ -15,6 +17,7 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <semaphore>
 #include <span>
 #include <thread>
@@ -58,6 +61,7 @@ struct ServerRuntime::Impl {
 
     // ---- 控制面 ----
     SessionManager sessions;
+    SessionResumer resumer; // 会话恢复令牌（gRPC 签发、UDP HELLO 校验）
 
     // ---- gRPC ----
     std::unique_ptr<grpc::GrpcServer> grpc_server;
@@ -73,6 +77,17 @@ struct ServerRuntime::Impl {
     std::thread ioc_thread;
     std::thread sender_thread;
 
+    // 线程策略应用结果（各线程入口写入，thread_policy_status() 读取）。
+    rt::ThreadPolicyReport thread_policy_report;
+    // 采集线程由后端创建：首次回调时对当前线程应用一次 Capture 策略。
+    std::atomic<bool> capture_policy_pending { true };
+
+    void apply_thread_policy(config::ThreadRole role)
+    {
+        rt::apply_current_thread_policy(role, cfg.runtime.thread_policies[static_cast<std::size_t>(role)],
+            &thread_policy_report);
+    }
+
     void set_last_error(std::string message)
     {
         std::lock_guard<std::mutex> lock(error_mutex_);
@@ -88,6 +103,20 @@ struct ServerRuntime::Impl {
         }
     }
 
+    // ---- 采集回调（后端实时线程）：只写 RingBuffer 并唤醒 packetizer ----
+    void handle_capture(std::span<const std::byte> pcm)
+    {
+        if (capture_policy_pending.load(std::memory_order_relaxed)
+            && capture_policy_pending.exchange(false, std::memory_order_relaxed)) {
+            apply_thread_policy(config::ThreadRole::Capture);
+        }
+        const auto written = ringbuffer->write(pcm);
+        if (written < pcm.size()) {
+            capture_dropped_bytes.fetch_add(pcm.size() - written, std::memory_order_relaxed);
+        }
+        capture_sem.release(); // 立即唤醒 packetizer 线程
+    }
+
     // ---- UDP 接收路由（io_context 线程）----
     void handle_udp_receive(const asio::ip::udp::endpoint& sender,
         std::span<const std::byte> data)
@@ -104,12 +133,33 @@ struct ServerRuntime::Impl {
             if (!hello) {
                 return;
             }
-            // HELLO 兼任两种角色：
+            // HELLO 兼任四种角色：
             //   1. 首次握手（Created -> Connected）
             //   2. UDP keepalive（已 Connected，刷新 NAT 映射 + last_seen）
+            //   3. 扩展 HELLO（带 resume_token）：session 已超时删除时凭令牌以原 id 恢复，免 gRPC 重连
+            //   4. 扩展 HELLO 令牌有效但 session 不可恢复（主动删除 / 超窗 / 已恢复过）：经 UDP 新建 session
+            // session 仍在时一律走 establish_udp（扩展 HELLO 的保活也不校验令牌），只有未知 session 才校验。
             const bool was_connected = sessions.is_connected(hello->session_id);
-            if (sessions.establish_udp(hello->session_id, sender)) {
-                if (!was_connected) {
+            const auto token = net::decode_hello_resume_token(data);
+            bool accepted = sessions.establish_udp(hello->session_id, sender);
+            bool restored = false;
+            std::optional<SessionManager::session_id_t> rejoined;
+            if (!accepted && token && resumer.verify(hello->session_id, *token)) {
+                if (resumer.take_expired(hello->session_id)) {
+                    restored = sessions.restore_session(hello->session_id, sender);
+                    accepted = restored;
+                }
+                if (!accepted) {
+                    rejoined = rejoin_over_udp(hello->session_id, sender);
+                }
+            }
+
+            if (accepted) {
+                if (restored) {
+                    log_info_fmt("Session 0x{:08X} resumed via token: {}:{}",
+                        hello->session_id,
+                        sender.address().to_string(), sender.port());
+                } else if (!was_connected) {
                     log_info_fmt("Session 0x{:08X} UDP established: {}:{}",
                         hello->session_id,
                         sender.address().to_string(), sender.port());
@@ -123,6 +173,21 @@ struct ServerRuntime::Impl {
                 net::encode_hello_ack(hello->session_id, ack_buf);
                 transport->send(sender,
                     std::span<const std::byte> { ack_buf.data(), ack_buf.size() });
+            } else if (rejoined) {
+                // 新 session 的 id + 令牌经扩展 HELLO_ACK 下发（与请求等长，无放大）。
+                std::array<std::byte, sizeof(net::HelloResumePacket)> ack_buf { };
+                net::encode_hello_ack_rejoin(*rejoined, resumer.mint(*rejoined), ack_buf);
+                transport->send(sender,
+                    std::span<const std::byte> { ack_buf.data(), ack_buf.size() });
+            } else if (token) {
+                // 令牌无效（服务端已重启 / 伪造）：回 session_id = 0 的 HELLO_ACK（不长于请求，无放大），客户端立即改走 gRPC。
+                log_debug_fmt("HELLO resume for session 0x{:08X} rejected (from {}:{})",
+                    hello->session_id,
+                    sender.address().to_string(), sender.port());
+                std::array<std::byte, sizeof(net::HelloPacket)> ack_buf { };
+                net::encode_hello_ack(net::kResumeRejectedSessionId, ack_buf);
+                transport->send(sender,
+                    std::span<const std::byte> { ack_buf.data(), ack_buf.size() });
             } else {
                 log_warn_fmt("HELLO from unknown session 0x{:08X} (from {}:{})",
                     hello->session_id,
@@ -137,6 +202,25 @@ struct ServerRuntime::Impl {
         }
     }
 
+    // 令牌有效、原 session 不可恢复：经 UDP 新建 session 并直接置为 Connected（等价于一次 gRPC Connect + HELLO）。
+    // 同一旧 session 的重试（扩展 HELLO_ACK 丢失）复用已建的新 session。
+    std::optional<SessionManager::session_id_t> rejoin_over_udp(SessionManager::session_id_t old_id,
+        const asio::ip::udp::endpoint& sender)
+    {
+        if (const auto previous = resumer.rejoined(old_id); previous && sessions.establish_udp(*previous, sender)) {
+            return previous;
+        }
+        const auto id = sessions.create_session([this](auto candidate) { return resumer.is_reserved(candidate); });
+        if (!id || !sessions.establish_udp(*id, sender)) {
+            log_error_fmt("HELLO rejoin for session 0x{:08X}: failed to create session", old_id);
+            return std::nullopt;
+        }
+        resumer.record_rejoin(old_id, *id);
+        log_info_fmt("Session 0x{:08X} created over UDP for stale session 0x{:08X}: {}:{}",
+            *id, old_id, sender.address().to_string(), sender.port());
+        return id;
+    }
+
     // ---- session 超时清理定时器（挂 io_context，替代独立线程）----
     void schedule_cleanup()
     {
@@ -147,8 +231,10 @@ struct ServerRuntime::Impl {
             }
             const auto expired = sessions.collect_expired_sessions(config::SESSION_TIMEOUT);
             for (const auto id : expired) {
-                log_info_fmt("Session 0x{:08X} expired, removing", id);
+                log_info_fmt("Session 0x{:08X} expired, removing (resumable for {}s)", id,
+                    config::SESSION_RESUME_WINDOW.count());
                 sessions.remove_session(id);
+                resumer.record_expired(id);
             }
             schedule_cleanup();
         });
@@ -307,10 +393,15 @@ bool ServerRuntime::start(const ServerConfig& cfg, ServerCallbacks cb)
     log_info_fmt("Starting Aqua server on {} gRPC={}, UDP={}",
         cfg.bind_ip, cfg.rpc_port, cfg.udp_port);
 
-    // ---- WASAPI Loopback Capture（先启动，获取 AudioFormat 给 gRPC）----
+    // ---- 音频采集（WASAPI Loopback 或无设备来源，先启动，获取 AudioFormat 给 gRPC）----
     // 启动顺序：WASAPI -> gRPC(控制面) -> UDP(数据面) -> 其余线程。
     // 失败路径：任何步骤失败时，之前已启动的资源按逆序清理。
-    p.capture = audio::create_capture_backend();
+    // 先锁定内存：之后分配的采集 RB、后端缓冲与发送缓冲在映射时即驻留。
+    if (cfg.runtime.lock_memory) {
+        rt::lock_process_memory(&p.thread_policy_report);
+    }
+
+    p.capture = audio::create_capture_backend(cfg.capture);
     if (!p.capture) {
         p.set_last_error("no audio capture backend available");
         return false;
@@ -318,15 +409,8 @@ bool ServerRuntime::start(const ServerConfig& cfg, ServerCallbacks cb)
 
     p.ringbuffer = std::make_unique<audio::SpscRingBuffer>(cfg.runtime.capture_ringbuffer_size);
 
-    if (!p.capture->start([&p](std::span<const std::byte> pcm) {
-            const auto written = p.ringbuffer->write(pcm);
-            if (written < pcm.size()) {
-                p.capture_dropped_bytes.fetch_add(pcm.size() - written,
-                    std::memory_order_relaxed);
-            }
-            p.capture_sem.release(); // 立即唤醒 packetizer 线程
-        },
-            p.capture_format)) {
+    // 回调以 Impl 为上下文直接绑定成员函数（非拥有引用，Impl 与运行时同寿命）。
+    if (!p.capture->start(audio::CaptureBackend::CaptureCallback::bind<&Impl::handle_capture>(p), p.capture_format)) {
         p.set_last_error("failed to start audio capture");
         return false;
     }
@@ -345,11 +429,12 @@ bool ServerRuntime::start(const ServerConfig& cfg, ServerCallbacks cb)
 
     // ---- gRPC Server（控制面先就绪，client 可先 Connect 拿到 session_id）----
     p.grpc_server = std::make_unique<grpc::GrpcServer>(
-        p.sessions, p.capture_format,
+        p.sessions, p.resumer, p.capture_format,
         cfg.bind_ip, cfg.rpc_port,
         cfg.bind_ip, cfg.udp_port);
 
     p.grpc_thread = std::thread([&p] {
+        p.apply_thread_policy(config::ThreadRole::Grpc);
         p.grpc_server->run();
     });
 
@@ -387,18 +472,17 @@ bool ServerRuntime::start(const ServerConfig& cfg, ServerCallbacks cb)
     }
     log_info_fmt("UDP bound to {}:{}", cfg.bind_ip, cfg.udp_port);
 
-    p.transport->start_receive([&p](const asio::ip::udp::endpoint& sender,
-                                   std::span<const std::byte> data) {
-        p.handle_udp_receive(sender, data);
-    });
+    p.transport->start_receive(net::UdpTransport::ReceiveHandler::bind<&Impl::handle_udp_receive>(p));
 
     p.ioc_thread = std::thread([&p] {
+        p.apply_thread_policy(config::ThreadRole::Io);
         p.ioc.run();
     });
 
     p.schedule_cleanup();
 
     p.sender_thread = std::thread([&p] {
+        p.apply_thread_policy(config::ThreadRole::Sender);
         p.sender_loop();
     });
 
@@ -458,4 +542,9 @@ std::string ServerRuntime::last_error() const
     return impl_->last_error_;
 }
 
+rt::ThreadPolicyReport::Status ServerRuntime::thread_policy_status() const noexcept
+{
+    return impl_->thread_policy_report.status();
+}
+
 } // namespace aqua::server
@@ -1,8 +1,10 @@
 #ifndef AQUA_SERVER_RUNTIME_H
 #define AQUA_SERVER_RUNTIME_H
 
+#include "core/audio/backend/audio_backend_factory.h"
 #include "core/public/audio_format.h"
 #include "core/public/config.h"
+#include "core/rt/thread_policy.h"
 
 #include <atomic>
 #include <cstdint>
@@ -19,6 +21,8 @@ struct ServerConfig {
     std::uint16_t rpc_port = 50051;
     std::uint16_t udp_port = 50000;
     config::RuntimeConfig runtime; // 采集 RingBuffer 大小等可调参数
+    // 采集来源：默认平台设备；无声卡主机 / 性能测试可选文件、管道或信号发生器。
+    audio::CaptureSourceConfig capture;
 };
 
 // 服务器事件回调。所有回调在服务器内部线程触发，不得阻塞；重活投递到调用方线程。
@@ -41,6 +45,7 @@ struct ServerCallbacks {
 //   - packetizer 线程：RingBuffer → 编码 → 广播
 //   - 采集线程：平台音频后端回调
 //   - 调用方线程：start() / run() / shutdown()
+// 前四类线程在入口（采集线程在首次回调）按 RuntimeConfig::thread_policies 应用调度策略与亲和性。
 class ServerRuntime {
 public:
     ServerRuntime();
@@ -68,6 +73,10 @@ public:
     // 最近一次错误信息（start() 失败或 on_error 触发时）。按值返回，线程安全。
     std::string last_error() const;
 
+    // 线程策略 / 内存锁定的累计应用结果（RuntimeConfig::thread_policies / lock_memory）。
+    // 失败不会使 start() 失败，只在此处与日志中暴露。线程安全。
+    rt::ThreadPolicyReport::Status thread_policy_status() const noexcept;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
@@ -26,13 +26,14 @@ SessionManager::~SessionManager()
     }
 }
 
-std::optional<SessionManager::session_id_t> SessionManager::create_session()
+std::optional<SessionManager::session_id_t> SessionManager::create_session(
+    const std::function<bool(session_id_t)>& reserved)
 {
     std::unique_lock lock(mutex_);
 
     session_id_t id = generate_session_id();
     const session_id_t start = id;
-    while (sessions_.contains(id)) {
+    while (sessions_.contains(id) || (reserved && reserved(id))) {
         id = generate_session_id();
         if (id == start) {
             log_error("create_session: session id space exhausted");
@@ -61,6 +62,22 @@ bool SessionManager::remove_session(session_id_t id)
     return erased;
 }
 
+bool SessionManager::restore_session(session_id_t id, const asio::ip::udp::endpoint& endpoint)
+{
+    std::unique_lock lock(mutex_);
+    SessionInfo info;
+    info.session_id = id;
+    info.endpoint = endpoint;
+    info.created_at = std::chrono::steady_clock::now();
+    info.last_seen = info.created_at;
+    info.state = SessionState::Connected;
+    if (!sessions_.emplace(id, std::move(info)).second) {
+        return false;
+    }
+    log_debug_fmt("restore_session: 0x{:08X} (total={})", id, sessions_.size());
+    return true;
+}
+
 std::optional<SessionManager::SessionInfo> SessionManager::get_session(session_id_t id) const
 {
     std::shared_lock lock(mutex_);
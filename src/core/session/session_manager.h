@@ -45,11 +45,17 @@ public:
     SessionManager& operator=(const SessionManager&) = delete;
 
     // 创建新的session, 返回 session_id
-    std::optional<session_id_t> create_session();
+    // reserved 非空时跳过其返回 true 的 id（服务端用于避开仍可恢复的旧 session id，见 SessionResumer）。
+    // 谓词在持有排他锁时调用，不得回调 SessionManager。
+    std::optional<session_id_t> create_session(const std::function<bool(session_id_t)>& reserved = { });
 
     // 删除session
     bool remove_session(session_id_t id);
 
+    // 以指定 id 重建已删除的 session 并直接置为 Connected（UDP 会话恢复，调用方负责校验）。
+    // id 已存在时返回 false。
+    bool restore_session(session_id_t id, const asio::ip::udp::endpoint& endpoint);
+
     // 查询session
     std::optional<SessionInfo> get_session(session_id_t id) const;
 
@@ -0,0 +1,84 @@
+#include "core/session/session_resumer.h"
+
+#include "core/logger/logger.h"
+#include "core/public/config.h"
+
+#include <array>
+#include <cstring>
+#include <random>
+
+namespace aqua {
+
+SessionResumer::SessionResumer()
+{
+    std::random_device rd;
+    for (auto& word : key_) {
+        word = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    }
+}
+
+std::uint64_t SessionResumer::mint(session_id_t id) const noexcept
+{
+    std::array<std::byte, sizeof(id)> msg;
+    std::memcpy(msg.data(), &id, sizeof(id));
+    return siphash24(key_, msg);
+}
+
+bool SessionResumer::verify(session_id_t id, std::uint64_t token) const noexcept
+{
+    return token == mint(id);
+}
+
+void SessionResumer::record_expired(session_id_t id)
+{
+    std::lock_guard lock(mutex_);
+    const auto now = std::chrono::steady_clock::now();
+    std::erase_if(expired_, [&](const auto& entry) { return now - entry.second > config::SESSION_RESUME_WINDOW; });
+    expired_.insert_or_assign(id, now);
+    log_debug_fmt("record_expired: 0x{:08X} (resumable={})", id, expired_.size());
+}
+
+bool SessionResumer::take_expired(session_id_t id)
+{
+    std::lock_guard lock(mutex_);
+    const auto it = expired_.find(id);
+    if (it == expired_.end()) {
+        return false; // 主动 Disconnect / 已恢复过 / 早已清理
+    }
+    const bool in_window = std::chrono::steady_clock::now() - it->second <= config::SESSION_RESUME_WINDOW;
+    expired_.erase(it);
+    return in_window;
+}
+
+bool SessionResumer::is_reserved(session_id_t id) const
+{
+    std::lock_guard lock(mutex_);
+    return expired_.contains(id);
+}
+
+std::size_t SessionResumer::expired_count() const
+{
+    std::lock_guard lock(mutex_);
+    return expired_.size();
+}
+
+void SessionResumer::record_rejoin(session_id_t old_id, session_id_t new_id)
+{
+    std::lock_guard lock(mutex_);
+    const auto now = std::chrono::steady_clock::now();
+    std::erase_if(rejoined_, [&](const auto& entry) { return now - entry.second.at > config::SESSION_RESUME_WINDOW; });
+    rejoined_.insert_or_assign(old_id, Rejoin { new_id, now });
+}
+
+std::optional<SessionResumer::session_id_t> SessionResumer::rejoined(session_id_t old_id) const
+{
+    std::lock_guard lock(mutex_);
+    const auto it = rejoined_.find(old_id);
+    if (it == rejoined_.end()
+        || std::chrono::steady_clock::now() - it->second.at > config::SESSION_RESUME_WINDOW) {
+        return std::nullopt;
+    }
+    return it->second.new_id;
+}
+
+} // namespace aqua
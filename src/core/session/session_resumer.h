@@ -0,0 +1,62 @@
+#ifndef AQUA_SESSION_RESUMER_H
+#define AQUA_SESSION_RESUMER_H
+
+#include "core/session/siphash.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace aqua {
+
+// 会话恢复令牌（UDP 快速恢复，见 protocol.md §3）：签发 / 校验 + 可恢复表。
+// 与 SessionManager 分离（后者只存 session 状态），由 ServerRuntime 持有：
+// gRPC Connect 签发令牌，io 线程只在 HELLO 指向未知 session 时校验，保活 HELLO 不经此类。
+class SessionResumer {
+public:
+    using session_id_t = std::uint32_t;
+
+    SessionResumer();
+
+    SessionResumer(const SessionResumer&) = delete;
+    SessionResumer& operator=(const SessionResumer&) = delete;
+
+    // 令牌 = SipHash-2-4(进程随机密钥, session_id)。无状态：校验只需重算，不随 session 存储；
+    // 新建实例（服务端重启）后旧令牌全部失效。
+    std::uint64_t mint(session_id_t id) const noexcept;
+    bool verify(session_id_t id, std::uint64_t token) const noexcept;
+
+    // 超时移除的 session 记入可恢复表（SESSION_RESUME_WINDOW 内有效），顺带清理超出时限的条目。
+    // 主动 Disconnect 的 session 不记入，不可恢复。
+    void record_expired(session_id_t id);
+
+    // 取出可恢复条目：在表内且未超时限返回 true。一次性：无论结果如何条目都被移除。
+    bool take_expired(session_id_t id);
+
+    // id 仍在可恢复表内：新建 session 应避开（SessionManager::create_session 的 reserved 谓词）。
+    bool is_reserved(session_id_t id) const;
+
+    // 可恢复条目数（含已超时限、尚未清理的）。
+    std::size_t expired_count() const;
+
+    // 令牌有效但不可恢复时服务端经 UDP 新建 session：记录 旧 id → 新 id（SESSION_RESUME_WINDOW 内有效）。
+    // 同一令牌的重试（扩展 HELLO_ACK 丢失）据此返回同一个新 session，不重复创建。
+    void record_rejoin(session_id_t old_id, session_id_t new_id);
+    std::optional<session_id_t> rejoined(session_id_t old_id) const;
+
+private:
+    SipHashKey key_;
+    mutable std::mutex mutex_;
+    std::unordered_map<session_id_t, std::chrono::steady_clock::time_point> expired_; // id → 超时移除时刻
+    struct Rejoin {
+        session_id_t new_id;
+        std::chrono::steady_clock::time_point at;
+    };
+    std::unordered_map<session_id_t, Rejoin> rejoined_; // 旧 id → UDP 新建的 session
+};
+
+} // namespace aqua
+
+#endif // AQUA_SESSION_RESUMER_H
@@ -0,0 +1,75 @@
+#include "core/session/siphash.h"
+
+#include <bit>
+#include <cstring>
+
+namespace aqua {
+
+static_assert(std::endian::native == std::endian::little,
+    "siphash24 reads message words as little-endian");
+
+namespace {
+
+    struct SipState {
+        std::uint64_t v0, v1, v2, v3;
+
+        void round() noexcept
+        {
+            v0 += v1;
+            v1 = std::rotl(v1, 13);
+            v1 ^= v0;
+            v0 = std::rotl(v0, 32);
+            v2 += v3;
+            v3 = std::rotl(v3, 16);
+            v3 ^= v2;
+            v0 += v3;
+            v3 = std::rotl(v3, 21);
+            v3 ^= v0;
+            v2 += v1;
+            v1 = std::rotl(v1, 17);
+            v1 ^= v2;
+            v2 = std::rotl(v2, 32);
+        }
+
+        void compress(std::uint64_t m) noexcept
+        {
+            v3 ^= m;
+            round();
+            round();
+            v0 ^= m;
+        }
+    };
+
+} // namespace
+
+std::uint64_t siphash24(const SipHashKey& key, std::span<const std::byte> data) noexcept
+{
+    SipState s {
+        key[0] ^ 0x736f6d6570736575ULL,
+        key[1] ^ 0x646f72616e646f6dULL,
+        key[0] ^ 0x6c7967656e657261ULL,
+        key[1] ^ 0x7465646279746573ULL,
+    };
+
+    const std::size_t full = data.size() & ~std::size_t { 7 };
+    for (std::size_t i = 0; i < full; i += 8) {
+        std::uint64_t m;
+        std::memcpy(&m, data.data() + i, sizeof(m));
+        s.compress(m);
+    }
+
+    // 末块：剩余 0..7 字节 + 最高字节放总长度（mod 256）
+    std::uint64_t last = static_cast<std::uint64_t>(data.size()) << 56;
+    for (std::size_t i = full; i < data.size(); ++i) {
+        last |= static_cast<std::uint64_t>(std::to_integer<std::uint8_t>(data[i])) << (8 * (i - full));
+    }
+    s.compress(last);
+
+    s.v2 ^= 0xff;
+    for (int i = 0; i < 4; ++i) {
+        s.round();
+    }
+    return s.v0 ^ s.v1 ^ s.v2 ^ s.v3;
+}
+
+} // namespace aqua
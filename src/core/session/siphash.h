@@ -0,0 +1,21 @@
+#ifndef AQUA_SIPHASH_H
+#define AQUA_SIPHASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace aqua {
+
+// SipHash-2-4（Aumasson & Bernstein）：128-bit 密钥的 64-bit 短消息 MAC。
+// 用于会话恢复令牌（SessionResumer::mint）：服务端持有随机密钥，
+// 令牌 = MAC(session_id)，无需存储即可在 UDP 路径上校验。
+// 密钥按参考实现的字节序取两个小端 uint64（k0 = 字节 0..7，k1 = 字节 8..15）。
+using SipHashKey = std::array<std::uint64_t, 2>;
+
+[[nodiscard]] std::uint64_t siphash24(const SipHashKey& key, std::span<const std::byte> data) noexcept;
+
+} // namespace aqua
+
+#endif // AQUA_SIPHASH_H
@@ -169,3 +169,226 @@ TEST(CliParserClientTest, LogLevelRejectsInvalid)
     EXPECT_FALSE(parsed.success);
     EXPECT_NE(parsed.error_message.find("Invalid --log-level"), std::string::npos);
 }
+
+TEST(CliParserClientTest, PlaybackSinkDefaultsToDevice)
+{
+    auto parsed = aqua::parse_client_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.playback.sink, aqua::audio::PlaybackSink::Device);
+    EXPECT_EQ(parsed.playback.period, std::chrono::milliseconds(10));
+    EXPECT_DOUBLE_EQ(parsed.playback.drift_ppm, 0.0);
+}
+
+TEST(CliParserClientTest, PlaybackSinkOptions)
+{
+    auto parsed = aqua::parse_client_command_line({ "--playback-sink", "file", "--playback-file", "heard.wav",
+        "--playback-period", "5", "--playback-drift-ppm", "-150.5" });
+    ASSERT_TRUE(parsed.success) << parsed.error_message;
+    EXPECT_EQ(parsed.playback.sink, aqua::audio::PlaybackSink::File);
+    EXPECT_EQ(parsed.playback.path, "heard.wav");
+    EXPECT_EQ(parsed.playback.period, std::chrono::milliseconds(5));
+    EXPECT_DOUBLE_EQ(parsed.playback.drift_ppm, -150.5);
+
+    parsed = aqua::parse_client_command_line({ "--playback-sink", "null" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.playback.sink, aqua::audio::PlaybackSink::Null);
+}
+
+TEST(CliParserClientTest, PlaybackSinkRejectsInvalid)
+{
+    auto parsed = aqua::parse_client_command_line({ "--playback-sink", "file" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("--playback-file"), std::string::npos);
+
+    EXPECT_FALSE(aqua::parse_client_command_line({ "--playback-sink", "speaker" }).success);
+    EXPECT_FALSE(aqua::parse_client_command_line({ "--playback-period", "0" }).success);
+    EXPECT_FALSE(aqua::parse_client_command_line({ "--playback-drift-ppm", "1000.5" }).success);
+}
+
+TEST(CliParserClientTest, PlaybackFormatOptions)
+{
+    auto parsed = aqua::parse_client_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.playback.encoding, aqua::AudioEncoding::Invalid);
+    EXPECT_EQ(parsed.playback.channels, 0u);
+    EXPECT_EQ(parsed.playback.sample_rate, 0u);
+    EXPECT_TRUE(parsed.dither);
+
+    parsed = aqua::parse_client_command_line({ "--playback-sink", "null", "--playback-encoding", "S16",
+        "--playback-channels", "1", "--playback-rate", "44100", "--no-dither" });
+    ASSERT_TRUE(parsed.success) << parsed.error_message;
+    EXPECT_EQ(parsed.playback.encoding, aqua::AudioEncoding::PcmS16LE);
+    EXPECT_EQ(parsed.playback.channels, 1u);
+    EXPECT_EQ(parsed.playback.sample_rate, 44100u);
+    EXPECT_FALSE(parsed.dither);
+
+    EXPECT_FALSE(aqua::parse_client_command_line({ "--playback-encoding", "s12" }).success);
+    EXPECT_FALSE(aqua::parse_client_command_line({ "--playback-channels", "9" }).success);
+    EXPECT_FALSE(aqua::parse_client_command_line({ "--playback-channels", "-1" }).success);
+    EXPECT_FALSE(aqua::parse_client_command_line({ "--playback-rate", "4000" }).success);
+}
+
+TEST(CliParserClientTest, PlcOption)
+{
+    auto parsed = aqua::parse_client_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.plc_mode, aqua::config::PlcMode::Repeat);
+
+    parsed = aqua::parse_client_command_line({ "--plc", "waveform" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.plc_mode, aqua::config::PlcMode::Waveform);
+
+    parsed = aqua::parse_client_command_line({ "--plc", "silence" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("Invalid --plc"), std::string::npos);
+}
+
+TEST(CliParserClientTest, PlayoutOption)
+{
+    auto parsed = aqua::parse_client_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.playout_mode, aqua::config::PlayoutMode::Timer);
+
+    parsed = aqua::parse_client_command_line({ "--playout", "pull" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.playout_mode, aqua::config::PlayoutMode::Pull);
+
+    parsed = aqua::parse_client_command_line({ "--playout", "push" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("Invalid --playout"), std::string::npos);
+
+    parsed = aqua::parse_client_command_line({ "--playout", "thread", "--playout-realtime" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.playout_mode, aqua::config::PlayoutMode::Thread);
+    EXPECT_TRUE(parsed.playout_realtime);
+
+    // 实时优先级只作用于调度线程
+    parsed = aqua::parse_client_command_line({ "--playout-realtime" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("--playout-realtime"), std::string::npos);
+}
+
+TEST(CliParserClientTest, ThreadPolicyOptions)
+{
+    using aqua::config::SchedPolicy;
+    using aqua::config::ThreadRole;
+
+    auto parsed = aqua::parse_client_command_line({ "--thread-policy", "playback=fifo:85@1", "--thread-policy",
+        "io=rr:40", "--lock-memory" });
+    ASSERT_TRUE(parsed.success) << parsed.error_message;
+    EXPECT_TRUE(parsed.lock_memory);
+    const auto& playback = parsed.thread_policies[static_cast<std::size_t>(ThreadRole::Playback)];
+    EXPECT_EQ(playback.policy, SchedPolicy::Fifo);
+    EXPECT_EQ(playback.priority, 85);
+    EXPECT_EQ(playback.cpu_mask, 0b10u);
+    EXPECT_EQ(parsed.thread_policies[static_cast<std::size_t>(ThreadRole::Io)].policy, SchedPolicy::RoundRobin);
+
+    // 服务端角色不可用于客户端
+    parsed = aqua::parse_client_command_line({ "--thread-policy", "sender=fifo:80" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("unknown role"), std::string::npos);
+
+    // 调度线程角色只在 --playout thread 下存在
+    parsed = aqua::parse_client_command_line({ "--thread-policy", "scheduler=fifo:70" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("--playout thread"), std::string::npos);
+
+    parsed = aqua::parse_client_command_line({ "--playout", "thread", "--thread-policy", "scheduler=fifo:75@3" });
+    ASSERT_TRUE(parsed.success) << parsed.error_message;
+    EXPECT_EQ(parsed.thread_policies[static_cast<std::size_t>(ThreadRole::Scheduler)].priority, 75);
+}
+
+TEST(CliParserClientTest, TimeStretchOption)
+{
+    auto parsed = aqua::parse_client_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_TRUE(parsed.time_stretch);
+
+    parsed = aqua::parse_client_command_line({ "--no-time-stretch" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_FALSE(parsed.time_stretch);
+}
+
+TEST(CliParserClientTest, DriftCompensationOption)
+{
+    auto parsed = aqua::parse_client_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_FALSE(parsed.drift_compensation);
+
+    parsed = aqua::parse_client_command_line({ "--drift-compensation" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_TRUE(parsed.drift_compensation);
+}
+
+TEST(CliParserClientTest, JitterEstimatorOption)
+{
+    auto parsed = aqua::parse_client_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.jitter_estimator, aqua::config::JitterEstimator::LateCount);
+
+    parsed = aqua::parse_client_command_line({ "--jitter-estimator", "histogram" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.jitter_estimator, aqua::config::JitterEstimator::Histogram);
+
+    parsed = aqua::parse_client_command_line({ "--jitter-estimator", "median" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("Invalid --jitter-estimator"), std::string::npos);
+}
+
+TEST(CliParserClientTest, CaptureAndReplayOptions)
+{
+    auto parsed = aqua::parse_client_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_TRUE(parsed.capture_file.empty());
+    EXPECT_TRUE(parsed.replay_file.empty());
+
+    parsed = aqua::parse_client_command_line({ "--capture-file", "field.aqcap" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.capture_file, "field.aqcap");
+
+    parsed = aqua::parse_client_command_line({ "--replay-file", "field.aqcap", "--capture-file", "again.aqcap" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.replay_file, "field.aqcap");
+    EXPECT_EQ(parsed.capture_file, "again.aqcap");
+
+    parsed = aqua::parse_client_command_line({ "--replay-file", "field.aqcap", "--auto-reconnect" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("--replay-file"), std::string::npos);
+}
+
+TEST(CliParserClientTest, MixServerAndGainOptions)
+{
+    auto parsed = aqua::parse_client_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_TRUE(parsed.mix_servers.empty());
+    EXPECT_FLOAT_EQ(parsed.gain, 1.0f);
+
+    parsed = aqua::parse_client_command_line(
+        { "--gain", "0.5", "--mix-server", "10.0.0.2", "--mix-server", "10.0.0.3:50061@0.25" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_FLOAT_EQ(parsed.gain, 0.5f);
+    ASSERT_EQ(parsed.mix_servers.size(), 2u);
+    EXPECT_EQ(parsed.mix_servers[0].ip, "10.0.0.2");
+    EXPECT_EQ(parsed.mix_servers[0].rpc_port, 50051);
+    EXPECT_FLOAT_EQ(parsed.mix_servers[0].gain, 1.0f);
+    EXPECT_EQ(parsed.mix_servers[1].ip, "10.0.0.3");
+    EXPECT_EQ(parsed.mix_servers[1].rpc_port, 50061);
+    EXPECT_FLOAT_EQ(parsed.mix_servers[1].gain, 0.25f);
+
+    parsed = aqua::parse_client_command_line({ "--mix-server", "::1@2" });
+    ASSERT_TRUE(parsed.success);
+    ASSERT_EQ(parsed.mix_servers.size(), 1u);
+    EXPECT_EQ(parsed.mix_servers[0].ip, "::1");
+    EXPECT_EQ(parsed.mix_servers[0].rpc_port, 50051);
+
+    parsed = aqua::parse_client_command_line({ "--gain", "5" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("--gain"), std::string::npos);
+
+    parsed = aqua::parse_client_command_line({ "--mix-server", "10.0.0.2@-1" });
+    EXPECT_FALSE(parsed.success);
+
+    parsed = aqua::parse_client_command_line({ "--mix-server", "10.0.0.2", "--replay-file", "field.aqcap" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("--mix-server"), std::string::npos);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "app/cli/cli_parser_jbsim.h"
+
+TEST(CliParserJbsimTest, Defaults)
+{
+    auto parsed = aqua::parse_jbsim_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.profile, "wifi");
+    EXPECT_TRUE(parsed.trace_file.empty());
+    EXPECT_EQ(parsed.duration_s, 600u);
+    EXPECT_EQ(parsed.sample_rate, 48000u);
+    EXPECT_EQ(parsed.frames_per_packet, aqua::config::AUDIO_FRAMES_PER_PACKET);
+    EXPECT_EQ(parsed.jitter_buffer_ms, std::vector<uint32_t> { aqua::config::DEFAULT_JITTER_BUFFER_MS });
+    EXPECT_EQ(parsed.jitter_estimator, aqua::config::JitterEstimator::LateCount);
+    EXPECT_EQ(parsed.plc_mode, aqua::config::PlcMode::Repeat);
+    EXPECT_TRUE(parsed.time_stretch);
+    EXPECT_EQ(parsed.log_level, aqua::LogLevel::Warn);
+    EXPECT_DOUBLE_EQ(parsed.network.base_delay_ms, aqua::jbsim::network_profile_preset("wifi")->base_delay_ms);
+}
+
+TEST(CliParserJbsimTest, ProfileOverridesAndSweep)
+{
+    auto parsed = aqua::parse_jbsim_command_line({ "--profile", "cellular", "--ge-p", "0.05", "--psm-interval",
+        "51.2", "--seed", "9", "--jitter-buffer", "20,40,80", "--jitter-estimator", "histogram", "--plc",
+        "waveform", "--no-time-stretch", "--duration", "3600" });
+    ASSERT_TRUE(parsed.success) << parsed.error_message;
+    EXPECT_EQ(parsed.profile, "cellular");
+    EXPECT_DOUBLE_EQ(parsed.network.ge_good_to_bad, 0.05);
+    EXPECT_DOUBLE_EQ(parsed.network.psm_interval_ms, 51.2);
+    EXPECT_DOUBLE_EQ(parsed.network.base_delay_ms, 30.0); // 未覆盖项保留剖面值
+    EXPECT_EQ(parsed.network.seed, 9u);
+    EXPECT_EQ(parsed.jitter_buffer_ms, (std::vector<uint32_t> { 20, 40, 80 }));
+    EXPECT_EQ(parsed.jitter_estimator, aqua::config::JitterEstimator::Histogram);
+    EXPECT_EQ(parsed.plc_mode, aqua::config::PlcMode::Waveform);
+    EXPECT_FALSE(parsed.time_stretch);
+    EXPECT_EQ(parsed.duration_s, 3600u);
+}
+
+TEST(CliParserJbsimTest, RejectsInvalidValues)
+{
+    EXPECT_FALSE(aqua::parse_jbsim_command_line({ "--profile", "dialup" }).success);
+    EXPECT_FALSE(aqua::parse_jbsim_command_line({ "--ge-p", "1.5" }).success);
+    EXPECT_FALSE(aqua::parse_jbsim_command_line({ "--pareto-shape", "0" }).success);
+    EXPECT_FALSE(aqua::parse_jbsim_command_line({ "--jitter-buffer", "20,,40" }).success);
+    EXPECT_FALSE(aqua::parse_jbsim_command_line({ "--jitter-buffer", "0" }).success);
+    EXPECT_FALSE(aqua::parse_jbsim_command_line({ "--duration", "0" }).success);
+    EXPECT_FALSE(aqua::parse_jbsim_command_line({ "--seed", "-1" }).success);
+    EXPECT_FALSE(aqua::parse_jbsim_command_line({ "--plc", "zero" }).success);
+    EXPECT_FALSE(aqua::parse_jbsim_command_line({ "--jitter-estimator", "mean" }).success);
+}
+
+TEST(CliParserJbsimTest, HelpAndVersion)
+{
+    auto help = aqua::parse_jbsim_command_line({ "--help" });
+    ASSERT_TRUE(help.success);
+    EXPECT_TRUE(help.show_help);
+    EXPECT_NE(help.help_message.find("--profile"), std::string::npos);
+
+    auto version = aqua::parse_jbsim_command_line({ "--version" });
+    ASSERT_TRUE(version.success);
+    EXPECT_TRUE(version.show_version);
+}
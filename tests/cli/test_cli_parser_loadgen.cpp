@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "app/cli/cli_parser_loadgen.h"
+
+TEST(CliParserLoadgenTest, Defaults)
+{
+    auto parsed = aqua::parse_loadgen_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.server_ip, "127.0.0.1");
+    EXPECT_EQ(parsed.server_rpc_port, 50051);
+    EXPECT_EQ(parsed.sessions, 100u);
+    EXPECT_EQ(parsed.ramp_step, 10u);
+    EXPECT_EQ(parsed.step_seconds, 5u);
+    EXPECT_EQ(parsed.io_threads, 0u);
+    EXPECT_EQ(parsed.connect_concurrency, 16u);
+    EXPECT_EQ(parsed.log_level, aqua::LogLevel::Warn);
+}
+
+TEST(CliParserLoadgenTest, CustomOptions)
+{
+    auto parsed = aqua::parse_loadgen_command_line({ "--server-ip", "10.0.0.2", "--sessions", "2000",
+        "--ramp-step", "250", "--step-seconds", "10", "--io-threads", "4", "--connect-concurrency", "64",
+        "--client-name", "bench" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.server_ip, "10.0.0.2");
+    EXPECT_EQ(parsed.sessions, 2000u);
+    EXPECT_EQ(parsed.ramp_step, 250u);
+    EXPECT_EQ(parsed.step_seconds, 10u);
+    EXPECT_EQ(parsed.io_threads, 4u);
+    EXPECT_EQ(parsed.connect_concurrency, 64u);
+    EXPECT_EQ(parsed.client_name, "bench");
+}
+
+TEST(CliParserLoadgenTest, RejectsOutOfRangeValues)
+{
+    EXPECT_FALSE(aqua::parse_loadgen_command_line({ "--sessions", "0" }).success);
+    EXPECT_FALSE(aqua::parse_loadgen_command_line({ "--sessions", "-5" }).success);
+    EXPECT_FALSE(aqua::parse_loadgen_command_line({ "--ramp-step", "0" }).success);
+    EXPECT_FALSE(aqua::parse_loadgen_command_line({ "--step-seconds", "0" }).success);
+    EXPECT_FALSE(aqua::parse_loadgen_command_line({ "--connect-concurrency", "0" }).success);
+    EXPECT_FALSE(aqua::parse_loadgen_command_line({ "--client-name", "" }).success);
+    EXPECT_FALSE(aqua::parse_loadgen_command_line({ "--server-rpc-port", "70000" }).success);
+}
+
+TEST(CliParserLoadgenTest, HelpAndVersion)
+{
+    auto help = aqua::parse_loadgen_command_line({ "--help" });
+    ASSERT_TRUE(help.success);
+    EXPECT_TRUE(help.show_help);
+    EXPECT_NE(help.help_message.find("--sessions"), std::string::npos);
+
+    auto version = aqua::parse_loadgen_command_line({ "--version" });
+    ASSERT_TRUE(version.success);
+    EXPECT_TRUE(version.show_version);
+}
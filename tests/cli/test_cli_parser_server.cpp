@@ -115,3 +115,82 @@ TEST(CliParserServerTest, LogLevelRejectsInvalid)
     EXPECT_FALSE(parsed.success);
     EXPECT_NE(parsed.error_message.find("Invalid --log-level"), std::string::npos);
 }
+
+TEST(CliParserServerTest, CaptureSourceDefaultsToDevice)
+{
+    auto parsed = aqua::parse_server_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.capture.source, aqua::audio::CaptureSource::Device);
+}
+
+TEST(CliParserServerTest, HeadlessSignalSource)
+{
+    auto parsed = aqua::parse_server_command_line({ "--capture-source", "sine", "--capture-encoding", "s16",
+        "--capture-rate", "44100", "--capture-channels", "1", "--capture-period", "5",
+        "--signal-frequency", "1000", "--signal-amplitude", "0.25" });
+    ASSERT_TRUE(parsed.success) << parsed.error_message;
+    EXPECT_EQ(parsed.capture.source, aqua::audio::CaptureSource::Sine);
+    EXPECT_EQ(parsed.capture.format.encoding, aqua::AudioEncoding::PcmS16LE);
+    EXPECT_EQ(parsed.capture.format.sample_rate, 44100u);
+    EXPECT_EQ(parsed.capture.format.channels, 1u);
+    EXPECT_EQ(parsed.capture.period, std::chrono::milliseconds(5));
+    EXPECT_DOUBLE_EQ(parsed.capture.frequency_hz, 1000.0);
+    EXPECT_DOUBLE_EQ(parsed.capture.amplitude, 0.25);
+}
+
+TEST(CliParserServerTest, FileSourceRequiresPath)
+{
+    auto parsed = aqua::parse_server_command_line({ "--capture-source", "file" });
+    EXPECT_FALSE(parsed.success);
+    EXPECT_NE(parsed.error_message.find("--capture-path"), std::string::npos);
+
+    parsed = aqua::parse_server_command_line({ "--capture-source", "file", "--capture-path", "loop.wav" });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_EQ(parsed.capture.path, "loop.wav");
+}
+
+TEST(CliParserServerTest, InvalidCaptureOptions)
+{
+    EXPECT_FALSE(aqua::parse_server_command_line({ "--capture-source", "mic" }).success);
+    EXPECT_FALSE(aqua::parse_server_command_line({ "--capture-encoding", "f64" }).success);
+    EXPECT_FALSE(aqua::parse_server_command_line({ "--capture-rate", "1000" }).success);
+    EXPECT_FALSE(aqua::parse_server_command_line({ "--capture-channels", "0" }).success);
+    EXPECT_FALSE(aqua::parse_server_command_line({ "--capture-period", "0" }).success);
+    EXPECT_FALSE(aqua::parse_server_command_line({ "--signal-amplitude", "1.5" }).success);
+    EXPECT_FALSE(aqua::parse_server_command_line({ "--signal-frequency", "30000" }).success);
+}
+
+TEST(CliParserServerTest, ThreadPolicyOptions)
+{
+    using aqua::config::SchedPolicy;
+    using aqua::config::ThreadRole;
+    const auto at = [](const auto& parsed, ThreadRole role) {
+        return parsed.thread_policies[static_cast<std::size_t>(role)];
+    };
+
+    auto parsed = aqua::parse_server_command_line({ });
+    ASSERT_TRUE(parsed.success);
+    EXPECT_FALSE(parsed.lock_memory);
+    EXPECT_EQ(at(parsed, ThreadRole::Sender).policy, SchedPolicy::Default);
+
+    parsed = aqua::parse_server_command_line({ "--thread-policy", "sender=fifo:80@2", "--thread-policy",
+        "capture=rr:60", "--thread-policy", "io=default@0,4-5", "--lock-memory" });
+    ASSERT_TRUE(parsed.success) << parsed.error_message;
+    EXPECT_TRUE(parsed.lock_memory);
+    EXPECT_EQ(at(parsed, ThreadRole::Sender).policy, SchedPolicy::Fifo);
+    EXPECT_EQ(at(parsed, ThreadRole::Sender).priority, 80);
+    EXPECT_EQ(at(parsed, ThreadRole::Sender).cpu_mask, 0b100u);
+    EXPECT_EQ(at(parsed, ThreadRole::Capture).policy, SchedPolicy::RoundRobin);
+    EXPECT_EQ(at(parsed, ThreadRole::Capture).cpu_mask, 0u);
+    EXPECT_EQ(at(parsed, ThreadRole::Io).policy, SchedPolicy::Default);
+    EXPECT_EQ(at(parsed, ThreadRole::Io).cpu_mask, 0b110001u);
+
+    // 客户端角色 / 缺优先级 / 越界 / CPU 列表非法
+    for (const char* bad : { "playback=fifo:80", "sender=fifo", "sender=fifo:0", "sender=fifo:100",
+             "sender=default:5", "sender=idle", "sender", "sender=fifo:80@64", "sender=fifo:80@3-1",
+             "sender=fifo:80@" }) {
+        parsed = aqua::parse_server_command_line({ "--thread-policy", bad });
+        EXPECT_FALSE(parsed.success) << bad;
+        EXPECT_NE(parsed.error_message.find("--thread-policy"), std::string::npos) << bad;
+    }
+}
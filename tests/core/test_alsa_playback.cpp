@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "core/audio/backend/alsa/alsa_playback.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// 仅在 alsa-lib 可用时编译（tests/CMakeLists.txt 按 AQUA_HAVE_ALSA 追加）。
+// 使用 alsa-lib 内置的 "null" PCM 插件：无需声卡，接受任意格式并支持 mmap。
+
+using aqua::AudioEncoding;
+using aqua::AudioFormat;
+using aqua::audio::AlsaPlayback;
+
+namespace {
+
+const AudioFormat kF32Stereo { AudioEncoding::PcmF32LE, 2, 48000 };
+
+} // namespace
+
+TEST(AlsaPlaybackTest, NullDevicePullsFillCallbackThroughMmap)
+{
+    AlsaPlayback playback("null");
+    playback.set_latency_hint(std::chrono::milliseconds(20));
+
+    std::atomic<std::size_t> requested_bytes { 0 };
+    std::atomic<bool> misaligned { false };
+    const auto fill = [&](std::span<std::byte> out) -> std::size_t {
+        if (out.size() % kF32Stereo.frame_bytes() != 0) {
+            misaligned.store(true, std::memory_order_relaxed);
+        }
+        requested_bytes.fetch_add(out.size(), std::memory_order_relaxed);
+        return out.size() / 2; // 半填充：剩余部分由后端补静音
+    };
+    ASSERT_TRUE(playback.start(kF32Stereo, fill));
+
+    for (int i = 0; i < 100 && requested_bytes.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GT(requested_bytes.load(), 0u);
+    EXPECT_FALSE(misaligned.load());
+    EXPECT_TRUE(playback.is_running());
+
+    playback.stop();
+    EXPECT_FALSE(playback.is_running());
+    EXPECT_EQ(playback.device_delay_frames(), 0u);
+}
+
+TEST(AlsaPlaybackTest, UnknownDeviceFailsToStart)
+{
+    AlsaPlayback playback("aqua_no_such_pcm_device");
+    const auto fill = [](std::span<std::byte>) -> std::size_t { return 0; };
+    EXPECT_FALSE(playback.start(kF32Stereo, fill));
+    EXPECT_FALSE(playback.is_running());
+}
+
+TEST(AlsaPlaybackTest, RestartAfterStop)
+{
+    AlsaPlayback playback("null");
+    auto fill = [](std::span<std::byte>) -> std::size_t { return 0; };
+    ASSERT_TRUE(playback.start(kF32Stereo, fill));
+    EXPECT_FALSE(playback.start(kF32Stereo, fill)); // 已启动
+    playback.stop();
+    EXPECT_TRUE(playback.start(kF32Stereo, fill));
+    playback.stop();
+}
+
+TEST(AlsaPlaybackTest, NegotiateKeepsFormatTheDeviceAccepts)
+{
+    // null 插件接受任意格式：协商结果与请求一致
+    AlsaPlayback playback("null");
+    const AudioFormat s24_mono { AudioEncoding::PcmS24LE, 1, 44100 };
+    EXPECT_EQ(playback.negotiate_format(kF32Stereo), kF32Stereo);
+    EXPECT_EQ(playback.negotiate_format(s24_mono), s24_mono);
+
+    // 设备打不开：原样返回，错误留给 start()
+    AlsaPlayback missing("aqua_no_such_pcm_device");
+    EXPECT_EQ(missing.negotiate_format(kF32Stereo), kF32Stereo);
+}
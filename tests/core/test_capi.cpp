@@ -87,6 +87,9 @@ TEST(CapiTest, ClientConfigInitDefaults)
     EXPECT_EQ(cfg.playback_ringbuffer_size, 0u);
     EXPECT_EQ(cfg.auto_reconnect, 0);
     EXPECT_STREQ(cfg.client_name, "aqua_client");
+    EXPECT_EQ(cfg.plc_mode, AQUA_PLC_REPEAT);
+    EXPECT_EQ(cfg.disable_time_stretch, 0);
+    EXPECT_EQ(cfg.drift_compensation, 0);
 }
 
 TEST(CapiTest, ServerConfigInitDefaults)
@@ -0,0 +1,241 @@
+#include "core/audio/dsp/sample_convert.h"
+#include "core/jitter_buffer/concealment.h"
+#include "core/jitter_buffer/jitter_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+using aqua::jitter::ConcealmentEngine;
+
+// 48kHz 立体声 F32，10ms 包；200Hz 正弦周期恰为 240 帧。
+constexpr std::uint32_t RATE = 48000;
+constexpr std::uint32_t CHANNELS = 2;
+constexpr std::uint32_t FRAMES = 480;
+constexpr double TONE_HZ = 200.0;
+
+aqua::AudioFormat f32_format()
+{
+    return { aqua::AudioEncoding::PcmF32LE, CHANNELS, RATE };
+}
+
+// 第 packet 个包的正弦 PCM（跨包相位连续）
+std::vector<std::byte> sine_packet(std::uint32_t packet, float amplitude = 0.5f)
+{
+    std::vector<float> samples(FRAMES * CHANNELS);
+    for (std::uint32_t f = 0; f < FRAMES; ++f) {
+        const double t = static_cast<double>(packet * FRAMES + f) / RATE;
+        const auto v = static_cast<float>(amplitude * std::sin(2.0 * std::numbers::pi * TONE_HZ * t));
+        for (std::uint32_t c = 0; c < CHANNELS; ++c) {
+            samples[f * CHANNELS + c] = v;
+        }
+    }
+    std::vector<std::byte> pcm(samples.size() * sizeof(float));
+    std::memcpy(pcm.data(), samples.data(), pcm.size());
+    return pcm;
+}
+
+std::vector<float> as_floats(const std::vector<std::byte>& pcm)
+{
+    std::vector<float> out(pcm.size() / sizeof(float));
+    std::memcpy(out.data(), pcm.data(), pcm.size());
+    return out;
+}
+
+float max_abs_diff(const std::vector<float>& a, const std::vector<float>& b, std::size_t count)
+{
+    float diff = 0.0f;
+    for (std::size_t i = 0; i < count; ++i) {
+        diff = std::max(diff, std::abs(a[i] - b[i]));
+    }
+    return diff;
+}
+
+float peak(const std::vector<float>& v)
+{
+    float p = 0.0f;
+    for (const float x : v) {
+        p = std::max(p, std::abs(x));
+    }
+    return p;
+}
+
+} // namespace
+
+TEST(ConcealmentTest, PeriodicSignalContinuesInPhase)
+{
+    ConcealmentEngine engine(f32_format(), FRAMES);
+    for (std::uint32_t p = 0; p < 4; ++p) {
+        auto pcm = sine_packet(p);
+        engine.on_real(pcm);
+    }
+
+    std::vector<std::byte> out(FRAMES * CHANNELS * sizeof(float));
+    engine.conceal(out);
+    EXPECT_EQ(engine.period_frames(), 240u);
+
+    // 保持区（前 10ms = 本包）内应与真实延续几乎一致，而不是重复上一包或静音
+    const auto expected = as_floats(sine_packet(4));
+    EXPECT_LT(max_abs_diff(as_floats(out), expected, expected.size()), 1e-3f);
+}
+
+TEST(ConcealmentTest, LongGapDecaysToSilence)
+{
+    ConcealmentEngine engine(f32_format(), FRAMES);
+    for (std::uint32_t p = 0; p < 4; ++p) {
+        auto pcm = sine_packet(p);
+        engine.on_real(pcm);
+    }
+
+    std::vector<std::byte> out(FRAMES * CHANNELS * sizeof(float));
+    float previous = 1.0f;
+    for (int i = 0; i < 8; ++i) {
+        engine.conceal(out);
+        const float level = peak(as_floats(out));
+        EXPECT_LE(level, previous + 1e-4f) << "packet " << i;
+        previous = level;
+    }
+    // 60ms 后全静音
+    EXPECT_EQ(previous, 0.0f);
+}
+
+TEST(ConcealmentTest, RecoveryCrossfadesIntoRealData)
+{
+    ConcealmentEngine engine(f32_format(), FRAMES);
+    for (std::uint32_t p = 0; p < 4; ++p) {
+        auto pcm = sine_packet(p);
+        engine.on_real(pcm);
+    }
+    std::vector<std::byte> out(FRAMES * CHANNELS * sizeof(float));
+    engine.conceal(out);
+    const float last_concealed = as_floats(out)[(FRAMES - 1) * CHANNELS];
+
+    // 恢复包为常量 0.9：开头应从隐藏信号起步，淡化区之后与真实数据一致
+    std::vector<float> dc(FRAMES * CHANNELS, 0.9f);
+    std::vector<std::byte> real(dc.size() * sizeof(float));
+    std::memcpy(real.data(), dc.data(), real.size());
+    engine.on_real(real);
+
+    const auto mixed = as_floats(real);
+    EXPECT_LT(std::abs(mixed[0] - last_concealed), 0.1f);
+    EXPECT_NE(mixed[0], 0.9f);
+    const std::size_t xfade = RATE / aqua::config::PLC_PITCH_MAX_HZ;
+    for (std::size_t f = xfade; f < FRAMES; ++f) {
+        EXPECT_EQ(mixed[f * CHANNELS], 0.9f);
+    }
+}
+
+TEST(ConcealmentTest, RealPathIsBitExactWithoutGap)
+{
+    aqua::AudioFormat fmt { aqua::AudioEncoding::PcmS24LE, CHANNELS, RATE };
+    ConcealmentEngine engine(fmt, FRAMES);
+    std::vector<std::byte> pcm(FRAMES * fmt.frame_bytes());
+    for (std::size_t i = 0; i < pcm.size(); ++i) {
+        pcm[i] = static_cast<std::byte>(i * 37 + 11);
+    }
+    const auto original = pcm;
+    engine.on_real(pcm);
+    EXPECT_EQ(pcm, original);
+}
+
+TEST(ConcealmentTest, NoHistoryOutputsEncodedSilence)
+{
+    aqua::AudioFormat fmt { aqua::AudioEncoding::PcmU8, CHANNELS, RATE };
+    ConcealmentEngine engine(fmt, FRAMES);
+    std::vector<std::byte> out(FRAMES * fmt.frame_bytes(), std::byte { 7 });
+    engine.conceal(out);
+    EXPECT_EQ(engine.period_frames(), 0u);
+    for (const auto b : out) {
+        ASSERT_EQ(b, std::byte { 128 }); // U8 零点
+    }
+}
+
+TEST(ConcealmentTest, ResetDropsHistory)
+{
+    ConcealmentEngine engine(f32_format(), FRAMES);
+    auto pcm = sine_packet(0);
+    engine.on_real(pcm);
+    engine.reset();
+
+    std::vector<std::byte> out(FRAMES * CHANNELS * sizeof(float));
+    engine.conceal(out);
+    EXPECT_EQ(peak(as_floats(out)), 0.0f);
+}
+
+TEST(ConcealmentTest, JitterBufferWaveformModeConcealsLoss)
+{
+    aqua::jitter::JitterBuffer jb(f32_format(), FRAMES, 3, 8,
+        aqua::config::JITTER_DETECT_WINDOW_PACKETS, aqua::config::JITTER_DRIFT_REBASE_LATE_COUNT,
+        std::nullopt, 0, aqua::config::PlcMode::Waveform);
+
+    for (std::uint32_t p = 0; p < 6; ++p) {
+        if (p != 4) {
+            jb.push(100 + p, sine_packet(p));
+        }
+    }
+
+    std::vector<std::byte> out(FRAMES * CHANNELS * sizeof(float));
+    for (std::uint32_t p = 0; p < 4; ++p) {
+        ASSERT_TRUE(jb.pop_next(out));
+    }
+    EXPECT_FALSE(jb.pop_next(out)); // 104 丢失：波形延续
+    EXPECT_EQ(jb.packets_lost(), 1u);
+    const auto expected = as_floats(sine_packet(4));
+    EXPECT_LT(max_abs_diff(as_floats(out), expected, expected.size()), 1e-3f);
+
+    // 105 恢复：隐藏信号与真实信号同相（仅因开始衰减略小），淡化后贴合原波形
+    EXPECT_TRUE(jb.pop_next(out));
+    const auto resumed = as_floats(sine_packet(5));
+    EXPECT_LT(max_abs_diff(as_floats(out), resumed, resumed.size()), 1e-2f);
+}
+
+TEST(SampleConvertTest, IntegerRoundTripIsExact)
+{
+    for (const auto enc : { aqua::AudioEncoding::PcmS16LE, aqua::AudioEncoding::PcmS24LE,
+             aqua::AudioEncoding::PcmS32LE, aqua::AudioEncoding::PcmU8 }) {
+        const std::size_t bytes = aqua::AudioFormat { enc, 1, 1 }.bytes_per_sample();
+        std::vector<std::byte> pcm(64 * bytes);
+        for (std::size_t i = 0; i < pcm.size(); ++i) {
+            pcm[i] = static_cast<std::byte>(i * 53 + 7);
+        }
+        std::vector<float> samples(64);
+        ASSERT_EQ(aqua::audio::dsp::decode_samples(pcm, enc, samples), 64u);
+        std::vector<std::byte> back(pcm.size());
+        ASSERT_EQ(aqua::audio::dsp::encode_samples(samples, enc, back), 64u);
+        if (enc == aqua::AudioEncoding::PcmS32LE) {
+            // float 24 位尾数：S32 低位有 ≤ 2^7 的量化误差
+            for (std::size_t i = 0; i < 64; ++i) {
+                std::int32_t a;
+                std::int32_t b;
+                std::memcpy(&a, pcm.data() + i * 4, 4);
+                std::memcpy(&b, back.data() + i * 4, 4);
+                EXPECT_NEAR(static_cast<double>(a), static_cast<double>(b), 256.0);
+            }
+        } else {
+            EXPECT_EQ(pcm, back) << static_cast<int>(enc);
+        }
+    }
+}
+
+TEST(SampleConvertTest, EncodeSaturates)
+{
+    const std::vector<float> samples = { 2.0f, -2.0f, 1.0f, NAN };
+    std::vector<std::int16_t> s16(4);
+    aqua::audio::dsp::encode_samples(samples, aqua::AudioEncoding::PcmS16LE, std::as_writable_bytes(std::span(s16)));
+    EXPECT_EQ(s16[0], 32767);
+    EXPECT_EQ(s16[1], -32768);
+    EXPECT_EQ(s16[2], 32767);
+    EXPECT_EQ(s16[3], 0);
+
+    std::vector<std::int32_t> s32(2);
+    aqua::audio::dsp::encode_samples(std::span(samples).first(2), aqua::AudioEncoding::PcmS32LE,
+        std::as_writable_bytes(std::span(s32)));
+    EXPECT_EQ(s32[0], INT32_MAX);
+    EXPECT_EQ(s32[1], INT32_MIN);
+}
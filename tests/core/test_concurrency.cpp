@@ -47,7 +47,7 @@ std::vector<std::byte> make_payload(std::uint32_t sequence)
 } // namespace
 
 // ==== 1. JitterBuffer: push/pop 主线程 + 诊断 getter 跨线程读 ====
-// 头文件契约：slots_mutex_ 保护 slots_，允许诊断 getter 跨线程读
+// 头文件契约：热路径无锁，诊断 getter 读 seqlock 快照，允许跨线程读
 
 TEST(ConcurrencyTest, JitterBufferDiagnosticsGetterConcurrentWithPush)
 {
@@ -147,6 +147,56 @@ TEST(ConcurrencyTest, JitterBufferResetConcurrentWithGetters)
     EXPECT_EQ(resets.load(), 4);
 }
 
+// ==== 2b. JitterBuffer: seqlock 快照一致性 ====
+// 写线程稳态保持恒定水位（每 push 一包 pop 一包），读线程应始终看到同一次发布的
+// 完整快照：占用数不越界、next_sequence 单调不减。
+
+TEST(ConcurrencyTest, JitterBufferSnapshotConsistentWithHotPath)
+{
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 4, 16);
+
+    std::atomic<bool> stop { false };
+    std::atomic<bool> reader_started { false };
+    std::atomic<int> violations { 0 };
+    std::atomic<int> reads { 0 };
+
+    std::thread reader([&] {
+        reader_started.store(true, std::memory_order_relaxed);
+        std::uint32_t last_seq = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            const auto fill = jb.buffer_fill_packets();
+            const auto seq = jb.next_sequence();
+            if (fill > jb.capacity_packets() || static_cast<std::int32_t>(seq - last_seq) < 0) {
+                violations.fetch_add(1, std::memory_order_relaxed);
+            }
+            last_seq = seq;
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    while (!reader_started.load(std::memory_order_relaxed)) {
+        std::this_thread::yield();
+    }
+
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        jb.push(i, make_payload(i));
+    }
+    constexpr std::uint32_t N = 20000;
+    for (std::uint32_t i = 4; i < N; ++i) {
+        jb.push(i, make_payload(i));
+        (void)jb.pop_next(out);
+        if (i % 64 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    stop.store(true, std::memory_order_relaxed);
+    reader.join();
+
+    EXPECT_EQ(violations.load(), 0);
+    EXPECT_GT(reads.load(), 0);
+    EXPECT_EQ(jb.buffer_fill_packets(), 4u);
+}
+
 // ==== 3. DiagnosticsManager: io_context 线程 record_* + 主线程 collect_and_log/snapshot ====
 // 头文件契约：事件回调在 io_context 线程，周期采样在主线程
 
@@ -155,11 +205,13 @@ TEST(ConcurrencyTest, DiagnosticsManagerCrossThreadAccess)
     std::size_t rb_fill = 0;
     std::atomic<std::uint64_t> played { 0 };
 
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
+    const auto played_fn = [&played]() { return played.load(std::memory_order_relaxed); };
     aqua::diag::DiagnosticsManager dm(
         48000, 8, PAYLOAD_SIZE,
-        [&rb_fill]() { return rb_fill; },
+        rb_fill_fn,
         PAYLOAD_SIZE * 16,
-        [&played]() { return played.load(std::memory_order_relaxed); });
+        played_fn);
 
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 4, 16);
 
@@ -231,9 +283,10 @@ TEST(ConcurrencyTest, UdpTransportConcurrentSendersSafe)
     auto sender_ep = sender.socket_local_endpoint();
 
     std::atomic<int> received { 0 };
-    receiver.start_receive([&](const auto& /*sender*/, auto /*data*/) {
+    const auto on_receive = [&](const auto& /*sender*/, auto /*data*/) {
         received.fetch_add(1, std::memory_order_relaxed);
-    });
+    };
+    receiver.start_receive(on_receive);
 
     std::thread ioc_thread([&] { ioc.run(); });
 
@@ -482,8 +535,9 @@ TEST(ConcurrencyTest, SpscRingBufferAvailableBoundsUnderConcurrency)
 TEST(ConcurrencyTest, DiagnosticsManagerConcurrentCounterIncrement)
 {
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
     aqua::diag::DiagnosticsManager dm(
-        48000, 8, PAYLOAD_SIZE, [&rb_fill]() { return rb_fill; }, PAYLOAD_SIZE * 16);
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 16);
 
     constexpr int NUM_THREADS = 8;
     constexpr int PER_THREAD = 1000;
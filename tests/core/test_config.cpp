@@ -71,6 +71,12 @@ TEST(ConfigTest, KeepaliveIntervalWithinSessionTimeout)
     EXPECT_LT(aqua::config::HELLO_KEEPALIVE_INTERVAL, aqua::config::SESSION_TIMEOUT / 2);
 }
 
+TEST(ConfigTest, MixReconnectGapCoversKeepalives)
+{
+    // 混音源断流判定需跨过至少 2 次保活，避免单次丢包即重连
+    EXPECT_GE(aqua::config::MIX_SOURCE_RECONNECT_GAP, aqua::config::HELLO_KEEPALIVE_INTERVAL * 2);
+}
+
 // ---- 音频包参数 ----
 
 TEST(ConfigTest, FramesPerPacketProducesNoFragmentation)
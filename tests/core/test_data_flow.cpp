@@ -297,10 +297,11 @@ TEST(DataFlowTest, UdpLoopbackSinglePacket)
     std::atomic<bool> received { false };
     std::vector<std::byte> recv_data;
 
-    client.start_receive([&](const auto& /*sender*/, std::span<const std::byte> data) {
+    const auto on_client_receive = [&](const auto& /*sender*/, std::span<const std::byte> data) {
         recv_data.assign(data.begin(), data.end());
         received = true;
-    });
+    };
+    client.start_receive(on_client_receive);
 
     std::thread ioc_thread([&] { ioc.run(); });
 
@@ -345,13 +346,14 @@ TEST(DataFlowTest, UdpLoopbackMultiplePacketsIntoRingBuffer)
     SpscRingBuffer playback_rb(64 * 1024);
     std::atomic<int> packets_received { 0 };
 
-    client.start_receive([&](const auto&, std::span<const std::byte> data) {
+    const auto on_client_receive = [&](const auto&, std::span<const std::byte> data) {
         auto decoded = aqua::net::decode_audio(data);
         if (decoded) {
             playback_rb.write(decoded->payload);
             packets_received.fetch_add(1, std::memory_order_relaxed);
         }
-    });
+    };
+    client.start_receive(on_client_receive);
 
     std::thread ioc_thread([&] { ioc.run(); });
 
@@ -400,7 +402,7 @@ TEST(DataFlowTest, UdpLoopbackHelloHandshake)
     std::atomic<bool> ack_received { false };
 
     // server: 收到 HELLO -> establish + 回 ACK
-    server.start_receive([&](const auto& sender, std::span<const std::byte> data) {
+    const auto on_server_receive = [&](const auto& sender, std::span<const std::byte> data) {
         auto type = aqua::net::peek_type(data);
         if (type && *type == PacketType::Hello) {
             auto hello = aqua::net::decode_hello(data);
@@ -411,10 +413,11 @@ TEST(DataFlowTest, UdpLoopbackHelloHandshake)
                 server.send(sender, std::span<const std::byte> { ack.data(), ack.size() });
             }
         }
-    });
+    };
+    server.start_receive(on_server_receive);
 
     // client: 收到 ACK
-    client.start_receive([&](const auto&, std::span<const std::byte> data) {
+    const auto on_client_receive = [&](const auto&, std::span<const std::byte> data) {
         auto type = aqua::net::peek_type(data);
         if (type && *type == PacketType::HelloAck) {
             auto ack = aqua::net::decode_hello(data);
@@ -422,7 +425,8 @@ TEST(DataFlowTest, UdpLoopbackHelloHandshake)
                 ack_received = true;
             }
         }
-    });
+    };
+    client.start_receive(on_client_receive);
 
     std::thread ioc_thread([&] { ioc.run(); });
 
@@ -460,13 +464,14 @@ TEST(DataFlowTest, UdpLoopbackLargePayload)
     std::atomic<bool> received { false };
     std::size_t recv_payload_size = 0;
 
-    client.start_receive([&](const auto&, std::span<const std::byte> data) {
+    const auto on_client_receive = [&](const auto&, std::span<const std::byte> data) {
         auto decoded = aqua::net::decode_audio(data);
         if (decoded) {
             recv_payload_size = decoded->payload.size();
             received = true;
         }
-    });
+    };
+    client.start_receive(on_client_receive);
 
     std::thread ioc_thread([&] { ioc.run(); });
 
@@ -511,7 +516,7 @@ TEST(DataFlowTest, FullHandshakeAndBroadcastFlow)
     std::atomic<int> audio_recv { 0 };
 
     // server: 处理 HELLO + (后续) 不处理 Audio (单向)
-    server_transport.start_receive([&](const auto& sender, std::span<const std::byte> data) {
+    const auto on_server_receive = [&](const auto& sender, std::span<const std::byte> data) {
         auto type = aqua::net::peek_type(data);
         if (type && *type == PacketType::Hello) {
             auto hello = aqua::net::decode_hello(data);
@@ -521,10 +526,11 @@ TEST(DataFlowTest, FullHandshakeAndBroadcastFlow)
                 server_transport.send(sender, std::span<const std::byte> { ack.data(), ack.size() });
             }
         }
-    });
+    };
+    server_transport.start_receive(on_server_receive);
 
     // client: 处理 ACK + Audio
-    client_transport.start_receive([&](const auto&, std::span<const std::byte> data) {
+    const auto on_client_receive = [&](const auto&, std::span<const std::byte> data) {
         auto type = aqua::net::peek_type(data);
         if (!type)
             return;
@@ -535,7 +541,8 @@ TEST(DataFlowTest, FullHandshakeAndBroadcastFlow)
         } else if (*type == PacketType::Audio) {
             audio_recv.fetch_add(1, std::memory_order_relaxed);
         }
-    });
+    };
+    client_transport.start_receive(on_client_receive);
 
     std::thread ioc_thread([&] { ioc.run(); });
 
@@ -0,0 +1,127 @@
+#include "core/jitter_buffer/delay_histogram.h"
+#include "core/jitter_buffer/jitter_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using aqua::jitter::DelayHistogram;
+
+// 48kHz 立体声 F32，10ms 包
+constexpr std::uint32_t FRAMES = 480;
+constexpr std::size_t PAYLOAD = FRAMES * 2 * sizeof(float);
+
+aqua::AudioFormat f32_format()
+{
+    return { aqua::AudioEncoding::PcmF32LE, 2, 48000 };
+}
+
+// 每个样本权重 0.2、分位 0.9：单个延迟包即可移动分位，便于确定性测试
+aqua::jitter::AdaptiveTargetConfig histogram_config()
+{
+    aqua::jitter::AdaptiveTargetConfig cfg { };
+    cfg.estimator = aqua::config::JitterEstimator::Histogram;
+    cfg.histogram_quantile = 0.9f;
+    cfg.histogram_forget_factor = 0.8f;
+    return cfg;
+}
+
+} // namespace
+
+TEST(DelayHistogramTest, StartsWithAllMassAtZero)
+{
+    DelayHistogram hist(8, 0.9f);
+    EXPECT_EQ(hist.quantile(0.995f), 0u);
+    EXPECT_FLOAT_EQ(hist.buckets()[0], 1.0f);
+}
+
+TEST(DelayHistogramTest, ForgettingKeepsUnitMassAndShiftsQuantile)
+{
+    DelayHistogram hist(8, 0.5f);
+    hist.add(3);
+    // 0.5 在桶 0，0.5 在桶 3
+    EXPECT_FLOAT_EQ(hist.buckets()[0], 0.5f);
+    EXPECT_FLOAT_EQ(hist.buckets()[3], 0.5f);
+    EXPECT_EQ(hist.quantile(0.5f), 0u);
+    EXPECT_EQ(hist.quantile(0.9f), 3u);
+
+    // 旧样本按 f^n 淡出：连续 bucket 1 后分位迁移到 1
+    for (int i = 0; i < 10; ++i) {
+        hist.add(1);
+    }
+    EXPECT_EQ(hist.quantile(0.99f), 1u);
+    const auto b = hist.buckets();
+    EXPECT_NEAR(std::accumulate(b.begin(), b.end(), 0.0f), 1.0f, 1e-5f);
+}
+
+TEST(DelayHistogramTest, OverflowLandsInLastBucket)
+{
+    DelayHistogram hist(4, 0.5f);
+    hist.add(100);
+    EXPECT_FLOAT_EQ(hist.buckets()[3], 0.5f);
+    EXPECT_EQ(hist.quantile(1.0f), 3u);
+}
+
+TEST(DelayHistogramTest, ResetRestoresPrior)
+{
+    DelayHistogram hist(4, 0.5f);
+    hist.add(2);
+    hist.reset();
+    EXPECT_EQ(hist.quantile(1.0f), 0u);
+}
+
+TEST(DelayHistogramTest, JitterBufferRaisesToQuantileInOneStep)
+{
+    // floor 2、ceiling 8。seq 1 的名义到达时刻 = t0 + 10ms，≥45ms 才到 → 延迟 ≥35ms，需 ≥4 包：
+    // 单个样本即把 90% 分位推到 ≥4，一次抬升到位（AIMD 需窗口内 late 累计后逐包 +1）。
+    aqua::jitter::JitterBuffer jb(f32_format(), FRAMES, /*floor=*/2, /*capacity=*/16, 8, 8, histogram_config());
+    const std::vector<std::byte> payload(PAYLOAD);
+
+    jb.push(0, payload);
+    const auto before = jb.next_playout_deadline();
+    std::this_thread::sleep_for(std::chrono::milliseconds(45));
+    jb.push(1, payload);
+
+    EXPECT_GE(jb.target_latency_packets(), 4u);
+    EXPECT_LE(jb.target_latency_packets(), 8u);
+    EXPECT_EQ(jb.late_packets(), 0u);
+    // 未启用时间伸缩：deadline 随 target 整体后移
+    ASSERT_TRUE(before.has_value());
+    EXPECT_EQ(*jb.next_playout_deadline() - *before,
+        std::chrono::milliseconds(10) * static_cast<std::int64_t>(jb.target_latency_packets() - 2));
+}
+
+TEST(DelayHistogramTest, JitterBufferLowersAtWindowEnd)
+{
+    aqua::jitter::JitterBuffer jb(f32_format(), FRAMES, /*floor=*/2, /*capacity=*/16, 8, 8, histogram_config());
+    const std::vector<std::byte> payload(PAYLOAD);
+
+    jb.push(0, payload);
+    std::this_thread::sleep_for(std::chrono::milliseconds(45));
+    jb.push(1, payload);
+    ASSERT_GE(jb.target_latency_packets(), 4u);
+
+    // 之后的包都早于名义到达时刻（桶 0）：窗口（8 个到达）结束时分位回到 0，钳到 floor。
+    for (std::uint32_t s = 9; s < 15; ++s) {
+        jb.push(s, payload);
+    }
+    EXPECT_GE(jb.target_latency_packets(), 4u); // 回落只在窗口结束时评估
+    jb.push(15, payload);
+    EXPECT_EQ(jb.target_latency_packets(), 2u);
+}
+
+TEST(DelayHistogramTest, InvalidParametersThrow)
+{
+    auto cfg = histogram_config();
+    cfg.histogram_quantile = 0.0f;
+    EXPECT_THROW(aqua::jitter::JitterBuffer(f32_format(), FRAMES, 2, 16, 8, 8, cfg), std::invalid_argument);
+    cfg = histogram_config();
+    cfg.histogram_forget_factor = 1.0f;
+    EXPECT_THROW(aqua::jitter::JitterBuffer(f32_format(), FRAMES, 2, 16, 8, 8, cfg), std::invalid_argument);
+}
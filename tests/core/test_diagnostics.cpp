@@ -31,8 +31,9 @@ std::vector<std::byte> make_payload(std::uint32_t sequence)
 TEST(DiagnosticsTest, RttMeasurement)
 {
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
     aqua::diag::DiagnosticsManager dm(
-        48000, 8, PAYLOAD_SIZE, [&rb_fill]() { return rb_fill; }, PAYLOAD_SIZE * 8);
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
 
     dm.record_hello_sent();
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -50,8 +51,9 @@ TEST(DiagnosticsTest, RttMeasurement)
 TEST(DiagnosticsTest, InterarrivalJitter)
 {
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
     aqua::diag::DiagnosticsManager dm(
-        48000, 8, PAYLOAD_SIZE, [&rb_fill]() { return rb_fill; }, PAYLOAD_SIZE * 8);
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
 
     // 模拟均匀到达的包（无 jitter）
     for (int i = 0; i < 20; ++i) {
@@ -65,11 +67,43 @@ TEST(DiagnosticsTest, InterarrivalJitter)
     EXPECT_LT(snap.interarrival_jitter_ms, 2.0);
 }
 
+TEST(DiagnosticsTest, RestartStreamKeepsCountersAndRebasesArrival)
+{
+    std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
+    aqua::diag::DiagnosticsManager dm(
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
+
+    dm.record_underrun();
+    for (int i = 0; i < 10; ++i) {
+        dm.record_packet_arrival(static_cast<std::uint32_t>(i),
+            1'000'000 + static_cast<std::uint32_t>(i) * 480);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // 原位重连：新会话的 sample_position 从 0 重新开始。
+    // 不重启时回跳 ~20s 会被当成一次巨大的到达偏差，把 jitter EWMA 抬到 1s 以上。
+    dm.restart_stream();
+    dm.record_underrun();
+    for (int i = 0; i < 10; ++i) {
+        dm.record_packet_arrival(static_cast<std::uint32_t>(i),
+            static_cast<std::uint32_t>(i) * 480);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
+    dm.collect_and_log(jb);
+    auto snap = dm.snapshot();
+    EXPECT_EQ(snap.underruns, 2); // 计数器跨重连累计
+    EXPECT_LT(snap.interarrival_jitter_ms, 2.0);
+}
+
 TEST(DiagnosticsTest, RingBufferOccupancyTracking)
 {
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
     aqua::diag::DiagnosticsManager dm(
-        48000, 8, PAYLOAD_SIZE, [&rb_fill]() { return rb_fill; }, PAYLOAD_SIZE * 8);
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
 
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
 
@@ -91,8 +125,9 @@ TEST(DiagnosticsTest, RingBufferOccupancyTracking)
 TEST(DiagnosticsTest, UnderrunCounter)
 {
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
     aqua::diag::DiagnosticsManager dm(
-        48000, 8, PAYLOAD_SIZE, [&rb_fill]() { return rb_fill; }, PAYLOAD_SIZE * 8);
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
 
     dm.record_underrun();
     dm.record_underrun();
@@ -108,8 +143,9 @@ TEST(DiagnosticsTest, UnderrunCounter)
 TEST(DiagnosticsTest, PacketLossAndLateInSnapshot)
 {
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
     aqua::diag::DiagnosticsManager dm(
-        48000, 8, PAYLOAD_SIZE, [&rb_fill]() { return rb_fill; }, PAYLOAD_SIZE * 8);
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
 
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
     std::vector<std::byte> out(PAYLOAD_SIZE);
@@ -139,8 +175,9 @@ TEST(DiagnosticsTest, PacketLossAndLateInSnapshot)
 TEST(DiagnosticsTest, EmptySnapshot)
 {
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
     aqua::diag::DiagnosticsManager dm(
-        48000, 8, PAYLOAD_SIZE, [&rb_fill]() { return rb_fill; }, PAYLOAD_SIZE * 8);
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
 
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
     dm.collect_and_log(jb);
@@ -156,11 +193,13 @@ TEST(DiagnosticsTest, EndToEndLatencyIsBufferedAudio)
 {
     std::uint64_t played = 0;
     std::size_t rb_fill = PAYLOAD_SIZE * 5; // 5 包 = 50ms
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
+    const auto played_fn = [&played]() { return played; };
     aqua::diag::DiagnosticsManager dm(
         48000, 8, PAYLOAD_SIZE,
-        [&rb_fill]() { return rb_fill; },
+        rb_fill_fn,
         PAYLOAD_SIZE * 8,
-        [&played]() { return played; });
+        played_fn);
 
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
     // JB 缓冲 3 包 = 30ms
@@ -173,17 +212,124 @@ TEST(DiagnosticsTest, EndToEndLatencyIsBufferedAudio)
     auto snap = dm.snapshot();
     // e2e = 当前缓冲量 = JB(30ms) + RB(50ms) = 80ms，无需时间同步
     EXPECT_NEAR(snap.end_to_end_ms, 80.0, 1.0);
+    EXPECT_EQ(snap.device_delay_ms, 0.0); // 后端未上报设备延迟
+}
+
+TEST(DiagnosticsTest, EndToEndLatencyIncludesDeviceDelay)
+{
+    std::size_t rb_fill = PAYLOAD_SIZE * 5; // 5 包 = 50ms
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
+    aqua::diag::DiagnosticsManager dm(
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
+
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
+    jb.push(0, make_payload(0));
+    jb.push(1, make_payload(1));
+    jb.push(2, make_payload(2));
+
+    // 设备缓冲 960 帧 @ 48kHz = 20ms（ALSA snd_pcm_delay）
+    dm.record_device_delay(960);
+    dm.collect_and_log(jb);
+
+    auto snap = dm.snapshot();
+    EXPECT_NEAR(snap.device_delay_ms, 20.0, 0.01);
+    // e2e = JB(30ms) + RB(50ms) + 设备(20ms) = 100ms
+    EXPECT_NEAR(snap.end_to_end_ms, 100.0, 1.0);
+}
+
+TEST(DiagnosticsTest, WakeupLatenessPercentilesPerRefresh)
+{
+    const auto rb_fill_fn = [] { return std::size_t { 0 }; };
+    aqua::diag::DiagnosticsManager dm(48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
+
+    for (int i = 0; i < 99; ++i) {
+        dm.record_wakeup_lateness(std::chrono::microseconds(40));
+    }
+    dm.record_wakeup_lateness(std::chrono::milliseconds(4));
+    dm.collect_and_log(jb);
+
+    auto snap = dm.snapshot();
+    EXPECT_EQ(snap.sched_wakeups, 100u);
+    EXPECT_DOUBLE_EQ(snap.sched_wakeup_p50_us, 50.0); // 25us 分桶上界
+    EXPECT_DOUBLE_EQ(snap.sched_wakeup_p99_us, 50.0);
+    EXPECT_DOUBLE_EQ(snap.sched_wakeup_max_us, 4000.0);
+
+    // 下一诊断周期无唤醒：分位归零
+    dm.collect_and_log(jb);
+    snap = dm.snapshot();
+    EXPECT_EQ(snap.sched_wakeups, 0u);
+    EXPECT_EQ(snap.sched_wakeup_max_us, 0.0);
+}
+
+TEST(DiagnosticsTest, ThreadPolicyStatusInSnapshot)
+{
+    const auto rb_fill_fn = [] { return std::size_t { 0 }; };
+    aqua::diag::DiagnosticsManager dm(48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
+
+    dm.collect_and_log(jb);
+    auto snap = dm.snapshot();
+    EXPECT_EQ(snap.thread_policy_applied, 0u);
+    EXPECT_EQ(snap.thread_policy_failures, 0u);
+    EXPECT_FALSE(snap.memory_locked);
+
+    // 失败只进快照（非致命）：累计值原样反映
+    dm.record_thread_policy(3, 2, true);
+    dm.collect_and_log(jb);
+    snap = dm.snapshot();
+    EXPECT_EQ(snap.thread_policy_applied, 3u);
+    EXPECT_EQ(snap.thread_policy_failures, 2u);
+    EXPECT_TRUE(snap.memory_locked);
+}
+
+TEST(DiagnosticsTest, StartupTraceMarksEachStageOnce)
+{
+    using aqua::diag::StartupStage;
+    aqua::diag::StartupTrace trace;
+    EXPECT_FALSE(trace.reached(StartupStage::Connected));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    trace.mark(StartupStage::Connected);
+    const auto first = trace.times()[static_cast<std::size_t>(StartupStage::Connected)];
+    EXPECT_GE(first, 2.0);
+
+    // 重复打点（原位重连）不改写首次时刻
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    trace.mark(StartupStage::Connected);
+    EXPECT_DOUBLE_EQ(trace.times()[static_cast<std::size_t>(StartupStage::Connected)], first);
+
+    // 未到达的阶段为 0；begin() 重新起算
+    EXPECT_EQ(trace.times()[static_cast<std::size_t>(StartupStage::FirstAudible)], 0.0);
+    trace.begin();
+    EXPECT_FALSE(trace.reached(StartupStage::Connected));
+}
+
+TEST(DiagnosticsTest, StartupTimesInSnapshot)
+{
+    const auto rb_fill_fn = [] { return std::size_t { 0 }; };
+    aqua::diag::DiagnosticsManager dm(48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 8);
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
+
+    aqua::diag::StartupTimes times { };
+    times[static_cast<std::size_t>(aqua::diag::StartupStage::HelloAcked)] = 12.5;
+    times[static_cast<std::size_t>(aqua::diag::StartupStage::FirstAudible)] = 48.0;
+    dm.record_startup(times);
+    dm.collect_and_log(jb);
+    EXPECT_EQ(dm.snapshot().startup_ms, times);
 }
 
 TEST(DiagnosticsTest, DriftZeroWhenRatesMatch)
 {
     std::uint64_t played = 0;
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
+    const auto played_fn = [&played]() { return played; };
     aqua::diag::DiagnosticsManager dm(
         48000, 8, PAYLOAD_SIZE,
-        [&rb_fill]() { return rb_fill; },
+        rb_fill_fn,
         PAYLOAD_SIZE * 8,
-        [&played]() { return played; });
+        played_fn);
 
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
 
@@ -204,11 +350,13 @@ TEST(DiagnosticsTest, DriftPositiveWhenServerFaster)
 {
     std::uint64_t played = 0;
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
+    const auto played_fn = [&played]() { return played; };
     aqua::diag::DiagnosticsManager dm(
         48000, 8, PAYLOAD_SIZE,
-        [&rb_fill]() { return rb_fill; },
+        rb_fill_fn,
         PAYLOAD_SIZE * 8,
-        [&played]() { return played; });
+        played_fn);
 
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 3, 8);
 
@@ -0,0 +1,128 @@
+#include "core/client/drift_compensator.h"
+#include "core/public/config.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <optional>
+
+namespace {
+
+using aqua::client::DriftCompensator;
+
+constexpr std::chrono::milliseconds STEP { 50 };
+constexpr double RB_SETPOINT_MS = 20.0;
+
+// 缓冲占用对速率差的响应（ms 对 ppm 的一阶积分）：
+//   JB 到达延迟：出队快于发送 → 包相对节拍越来越晚，d' = (jb − sender) / 1000
+//   RB 占用：流入 (1+jb)(1+rs) − 流出 (1+device)，r' ≈ (jb + rs − device) / 1000
+struct Plant {
+    double sender_ppm;
+    double device_ppm;
+    double jb_delay_ms = 0.0;
+    double rb_fill_ms = RB_SETPOINT_MS;
+    std::uint32_t epoch = 1;
+    double worst_jb_error_ms = 0.0; // 取得设定点后的最大偏离
+    double worst_rb_error_ms = 0.0;
+
+    void run(DriftCompensator& comp, std::chrono::seconds duration, std::optional<double> feedforward)
+    {
+        const double dt = std::chrono::duration<double>(STEP).count();
+        for (auto t = std::chrono::milliseconds(0); t < duration; t += STEP) {
+            DriftCompensator::Measurement m;
+            m.jb_arrival_delay_ms = jb_delay_ms;
+            m.jb_timeline_epoch = epoch;
+            m.rb_fill_ms = rb_fill_ms;
+            m.playback_running = true;
+            m.sender_ppm = feedforward;
+            comp.update(m, STEP);
+            jb_delay_ms += (comp.jb_ppm() - sender_ppm) / 1000.0 * dt;
+            rb_fill_ms += (comp.jb_ppm() + comp.resample_ppm() - device_ppm) / 1000.0 * dt;
+            worst_rb_error_ms = std::max(worst_rb_error_ms, std::abs(rb_fill_ms - RB_SETPOINT_MS));
+            if (comp.jb_setpoint_ms()) {
+                worst_jb_error_ms = std::max(worst_jb_error_ms, std::abs(jb_delay_ms - *comp.jb_setpoint_ms()));
+            }
+        }
+    }
+};
+
+} // namespace
+
+TEST(DriftCompensatorTest, FeedforwardLocksOntoSenderAndDeviceClocks)
+{
+    DriftCompensator comp(RB_SETPOINT_MS);
+    Plant plant { 800.0, -500.0 };
+    plant.run(comp, std::chrono::seconds(600), 800.0);
+
+    ASSERT_TRUE(comp.jb_setpoint_ms().has_value());
+    EXPECT_NEAR(plant.jb_delay_ms, *comp.jb_setpoint_ms(), 0.1);
+    EXPECT_NEAR(plant.rb_fill_ms, RB_SETPOINT_MS, 0.1);
+    EXPECT_NEAR(comp.jb_ppm(), 800.0, 1.0);
+    EXPECT_NEAR(comp.resample_ppm(), -1300.0, 1.0);
+    EXPECT_NEAR(comp.output().jb_rate, 1.0008, 1e-6);
+    EXPECT_NEAR(comp.output().resample_ratio, 1.0 - 1300e-6, 1e-6);
+}
+
+TEST(DriftCompensatorTest, IntegratorAloneConvergesWithBoundedExcursion)
+{
+    DriftCompensator comp(RB_SETPOINT_MS);
+    Plant plant { -500.0, 500.0 }; // 合计 1000ppm
+
+    // 无前馈：占用偏离由积分项拉回，全程偏离有界（小于低水位看门狗的 25% 水位余量）
+    plant.run(comp, std::chrono::seconds(600), std::nullopt);
+    EXPECT_LT(plant.worst_rb_error_ms, 5.0);
+    EXPECT_LT(plant.worst_jb_error_ms, 5.0);
+    EXPECT_NEAR(comp.jb_ppm(), -500.0, 1.0);
+    EXPECT_NEAR(comp.resample_ppm(), 1000.0, 1.0);
+    EXPECT_NEAR(plant.rb_fill_ms, RB_SETPOINT_MS, 0.1);
+}
+
+TEST(DriftCompensatorTest, TimelineRebaseKeepsLearnedRate)
+{
+    DriftCompensator comp(RB_SETPOINT_MS);
+    Plant plant { 600.0, 0.0 };
+    plant.run(comp, std::chrono::seconds(600), std::nullopt);
+    ASSERT_NEAR(comp.jb_ppm(), 600.0, 1.0);
+
+    // 时间线重建：到达延迟基准归零，预热期间保持已学到的速率，随后重新取设定点
+    plant.epoch = 2;
+    plant.jb_delay_ms = 0.0;
+    plant.run(comp, std::chrono::seconds(1), std::nullopt);
+    EXPECT_FALSE(comp.jb_setpoint_ms().has_value());
+    EXPECT_NEAR(comp.jb_ppm(), 600.0, 1.0);
+
+    plant.run(comp, aqua::config::DRIFT_COMP_WARMUP, std::nullopt);
+    ASSERT_TRUE(comp.jb_setpoint_ms().has_value());
+    EXPECT_NEAR(*comp.jb_setpoint_ms(), 0.0, 0.1);
+}
+
+TEST(DriftCompensatorTest, RingLoopFrozenUntilPlaybackRuns)
+{
+    DriftCompensator comp(RB_SETPOINT_MS);
+    DriftCompensator::Measurement m;
+    m.jb_timeline_epoch = 1;
+    m.rb_fill_ms = 0.0; // pre-roll 蓄水中，远低于设定点
+    m.playback_running = false;
+    m.sender_ppm = 300.0;
+    for (int i = 0; i < 100; ++i) {
+        comp.update(m, STEP);
+    }
+    // 只有前馈：JB 跟随发送端，重采样抵消之（不因蓄水期的低占用而加速产出）
+    EXPECT_NEAR(comp.jb_ppm(), 300.0, 1e-9);
+    EXPECT_NEAR(comp.resample_ppm(), -300.0, 1e-9);
+}
+
+TEST(DriftCompensatorTest, OutputsAreClamped)
+{
+    DriftCompensator comp(RB_SETPOINT_MS);
+    DriftCompensator::Measurement m;
+    m.jb_timeline_epoch = 1;
+    m.rb_fill_ms = 1000.0;
+    m.playback_running = true;
+    m.sender_ppm = 50000.0;
+    comp.update(m, STEP);
+    EXPECT_DOUBLE_EQ(comp.jb_ppm(), aqua::config::DRIFT_COMP_MAX_PPM);
+    EXPECT_DOUBLE_EQ(comp.resample_ppm(), -aqua::config::DRIFT_COMP_MAX_PPM);
+}
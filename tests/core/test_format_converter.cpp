@@ -0,0 +1,269 @@
+#include "core/audio/dsp/cpu_features.h"
+#include "core/audio/dsp/format_converter.h"
+#include "core/audio/dsp/sample_convert.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using aqua::AudioEncoding;
+using aqua::AudioFormat;
+using aqua::audio::dsp::FormatConverter;
+using aqua::audio::dsp::FormatConverterOptions;
+using aqua::audio::dsp::SimdLevel;
+namespace dsp = aqua::audio::dsp;
+
+constexpr SimdLevel SIMD_LEVELS[] = { SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Neon };
+constexpr std::uint32_t RATE = 48000;
+
+// 覆盖舍入（半整数）、饱和、NaN / Inf 与 S32 正满幅边界的 float 样本；长度非向量宽度整数倍以覆盖尾部。
+std::vector<float> edge_samples()
+{
+    std::vector<float> v {
+        0.0f, -0.0f, 1.0f, -1.0f, 0.99999994f, 1.5f, -1.5f, 2.5f, -3.0e9f,
+        0.5f / 32768.0f, 1.5f / 32768.0f, -0.5f / 32768.0f, 32767.5f / 32768.0f,
+        std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(), 2147483520.0f / 2147483648.0f,
+    };
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(-1.2f, 1.2f);
+    while (v.size() < 1027) {
+        v.push_back(dist(rng));
+    }
+    return v;
+}
+
+FormatConverterOptions without_dither()
+{
+    FormatConverterOptions options;
+    options.dither = false;
+    return options;
+}
+
+std::vector<std::byte> random_pcm(std::size_t bytes)
+{
+    std::vector<std::byte> pcm(bytes);
+    std::mt19937 rng(5);
+    for (auto& b : pcm) {
+        b = std::byte { static_cast<std::uint8_t>(rng()) };
+    }
+    return pcm;
+}
+
+std::vector<std::byte> encode_f32(const std::vector<float>& samples)
+{
+    std::vector<std::byte> pcm(samples.size() * sizeof(float));
+    std::memcpy(pcm.data(), samples.data(), pcm.size());
+    return pcm;
+}
+
+std::vector<float> decode_f32(std::span<const std::byte> pcm)
+{
+    std::vector<float> samples(pcm.size() / sizeof(float));
+    std::memcpy(samples.data(), pcm.data(), pcm.size());
+    return samples;
+}
+
+} // namespace
+
+TEST(SampleConvertTest, SimdEncodeMatchesScalarBitExactly)
+{
+    const auto in = edge_samples();
+    for (const auto enc : { AudioEncoding::PcmS16LE, AudioEncoding::PcmS24LE, AudioEncoding::PcmS32LE,
+             AudioEncoding::PcmU8 }) {
+        const std::size_t bytes = in.size() * AudioFormat { enc, 1, 1 }.bytes_per_sample();
+        std::vector<std::byte> ref(bytes);
+        ASSERT_EQ(dsp::encode_samples(in, enc, ref, SimdLevel::Scalar), in.size());
+        for (const auto level : SIMD_LEVELS) {
+            if (!dsp::simd_level_supported(level)) {
+                continue;
+            }
+            std::vector<std::byte> out(bytes);
+            dsp::encode_samples(in, enc, out, level);
+            EXPECT_EQ(out, ref) << dsp::simd_level_name(level) << " encoding=" << static_cast<int>(enc);
+        }
+    }
+
+    // 饱和与 NaN 的具体取值
+    std::vector<std::byte> s32(4 * 3);
+    const float special[] = { 1.0f, -2.0f, std::numeric_limits<float>::quiet_NaN() };
+    dsp::encode_samples(special, AudioEncoding::PcmS32LE, s32);
+    std::int32_t v[3];
+    std::memcpy(v, s32.data(), sizeof(v));
+    EXPECT_EQ(v[0], std::numeric_limits<std::int32_t>::max());
+    EXPECT_EQ(v[1], std::numeric_limits<std::int32_t>::min());
+    EXPECT_EQ(v[2], 0);
+}
+
+TEST(SampleConvertTest, SimdDecodeMatchesScalarBitExactly)
+{
+    for (const auto enc : { AudioEncoding::PcmS16LE, AudioEncoding::PcmS32LE, AudioEncoding::PcmU8 }) {
+        const auto pcm = random_pcm(1027 * AudioFormat { enc, 1, 1 }.bytes_per_sample() + 1);
+        std::vector<float> ref(1027);
+        ASSERT_EQ(dsp::decode_samples(pcm, enc, ref, SimdLevel::Scalar), ref.size());
+        for (const auto level : SIMD_LEVELS) {
+            if (!dsp::simd_level_supported(level)) {
+                continue;
+            }
+            std::vector<float> out(ref.size());
+            dsp::decode_samples(pcm, enc, out, level);
+            EXPECT_EQ(std::memcmp(out.data(), ref.data(), ref.size() * sizeof(float)), 0)
+                << dsp::simd_level_name(level) << " encoding=" << static_cast<int>(enc);
+        }
+    }
+}
+
+TEST(FormatConverterTest, IntegerWideningRoundTripsLosslessly)
+{
+    const AudioFormat s16 { AudioEncoding::PcmS16LE, 2, RATE };
+    const AudioFormat s24 { AudioEncoding::PcmS24LE, 2, RATE };
+    const auto pcm = random_pcm(480 * s16.frame_bytes());
+
+    FormatConverter up(s16, s24, 480);
+    // 降位默认抖动；这里的 24 位数据低 8 位全零，关闭抖动后应精确还原
+    FormatConverter down(s24, s16, 480, without_dither());
+    EXPECT_FALSE(up.dithering());
+
+    std::vector<std::byte> wide(480 * s24.frame_bytes());
+    std::vector<std::byte> back(pcm.size());
+    ASSERT_EQ(up.process(pcm, wide, { }), 480u);
+    ASSERT_EQ(down.process(wide, back, { }), 480u);
+    EXPECT_EQ(back, pcm);
+}
+
+TEST(FormatConverterTest, DitherOnlyWhenResolutionIsLost)
+{
+    const AudioFormat f32 { AudioEncoding::PcmF32LE, 2, RATE };
+    const AudioFormat s16 { AudioEncoding::PcmS16LE, 2, RATE };
+    const AudioFormat s16_mono { AudioEncoding::PcmS16LE, 1, RATE };
+
+    EXPECT_TRUE(FormatConverter(f32, s16, 64).dithering());
+    EXPECT_FALSE(FormatConverter(f32, s16, 64, without_dither()).dithering());
+    EXPECT_TRUE(FormatConverter(s16, s16_mono, 64).dithering()); // 混音产生小数
+    EXPECT_FALSE(FormatConverter(s16, f32, 64).dithering());
+
+    // 静音输入：抖动输出在 ±1 LSB 内且均值接近 0
+    FormatConverter conv(f32, s16, 4800);
+    const auto silence = encode_f32(std::vector<float>(4800 * 2, 0.0f));
+    std::vector<std::byte> out(4800 * s16.frame_bytes());
+    ASSERT_EQ(conv.process(silence, out, { }), 4800u);
+    std::vector<std::int16_t> q(4800 * 2);
+    std::memcpy(q.data(), out.data(), out.size());
+    double sum = 0.0;
+    bool nonzero = false;
+    for (const auto s : q) {
+        EXPECT_LE(std::abs(s), 1);
+        sum += s;
+        nonzero |= s != 0;
+    }
+    EXPECT_TRUE(nonzero);
+    EXPECT_LT(std::abs(sum / static_cast<double>(q.size())), 0.05);
+}
+
+TEST(FormatConverterTest, DefaultMatricesFoldAndSpreadChannels)
+{
+    const AudioFormat stereo { AudioEncoding::PcmF32LE, 2, RATE };
+    const AudioFormat mono { AudioEncoding::PcmF32LE, 1, RATE };
+    const AudioFormat surround { AudioEncoding::PcmF32LE, 6, RATE };
+
+    // 立体声 → 单声道：L/R 平均
+    FormatConverter down(stereo, mono, 2);
+    std::vector<std::byte> out(2 * sizeof(float));
+    ASSERT_EQ(down.process(encode_f32({ 0.5f, 0.25f, -1.0f, 1.0f }), out, { }), 2u);
+    EXPECT_EQ(decode_f32(out), (std::vector<float> { 0.375f, 0.0f }));
+
+    // 单声道 → 5.1：只送 FL / FR
+    FormatConverter up(mono, surround, 1);
+    std::vector<std::byte> wide(6 * sizeof(float));
+    ASSERT_EQ(up.process(encode_f32({ 0.5f }), wide, { }), 1u);
+    EXPECT_EQ(decode_f32(wide), (std::vector<float> { 0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f }));
+
+    // 5.1 → 立体声：全声道同相满幅不削波，LFE 丢弃
+    const auto m = dsp::default_channel_matrix(6, 2);
+    ASSERT_EQ(m.size(), 12u);
+    for (int row = 0; row < 2; ++row) {
+        float sum = 0.0f;
+        for (int i = 0; i < 6; ++i) {
+            sum += std::abs(m[row * 6 + i]);
+        }
+        EXPECT_NEAR(sum, 1.0f, 1e-6f);
+        EXPECT_EQ(m[row * 6 + 3], 0.0f);
+    }
+    EXPECT_GT(m[0], m[2]); // FL 权重高于 FC
+    EXPECT_EQ(m[1], 0.0f); // FR 不进 L
+}
+
+TEST(FormatConverterTest, CustomMatrixAndSplitOutput)
+{
+    const AudioFormat in { AudioEncoding::PcmS16LE, 2, RATE };
+    const AudioFormat out { AudioEncoding::PcmS32LE, 2, RATE };
+    // 交换左右声道：单位阵的置换，不引入小数
+    FormatConverterOptions swap { .dither = true, .matrix = { 0.0f, 1.0f, 1.0f, 0.0f } };
+    FormatConverter a(in, out, 100, swap);
+    FormatConverter b(in, out, 100, swap);
+    EXPECT_FALSE(a.dithering());
+
+    const auto pcm = random_pcm(100 * in.frame_bytes());
+    std::vector<std::byte> whole(100 * out.frame_bytes());
+    std::vector<std::byte> split(whole.size());
+    ASSERT_EQ(a.process(pcm, whole, { }), 100u);
+    const std::size_t cut = 13 * out.frame_bytes() + 5; // 回绕点不在帧边界
+    ASSERT_EQ(b.process(pcm, std::span<std::byte> { split }.first(cut), std::span<std::byte> { split }.subspan(cut)), 100u);
+    EXPECT_EQ(whole, split);
+
+    std::int16_t r;
+    std::int32_t swapped_l;
+    std::memcpy(&r, pcm.data() + 2, 2);
+    std::memcpy(&swapped_l, whole.data(), 4);
+    EXPECT_EQ(swapped_l, static_cast<std::int32_t>(r) * 65536);
+
+    // 输出区不足：按整帧截断
+    std::vector<std::byte> small(10 * out.frame_bytes() + 3);
+    EXPECT_EQ(a.process(pcm, small, { }), 10u);
+}
+
+TEST(FormatConverterTest, ConvertsSampleRateOnFewerChannels)
+{
+    const AudioFormat in { AudioEncoding::PcmS16LE, 2, 44100 };
+    const AudioFormat out { AudioEncoding::PcmF32LE, 1, RATE };
+    FormatConverter conv(in, out, 441);
+    EXPECT_TRUE(conv.resampling());
+    EXPECT_FALSE(conv.dithering()); // F32 输出不抖动
+    EXPECT_EQ(conv.max_output_frames(), 482u); // 441 × 160 / 147 + 2
+    EXPECT_GT(conv.delay_frames(), 0.0);
+    EXPECT_FALSE(FormatConverter(in, { AudioEncoding::PcmS16LE, 2, 44100 }, 441).resampling());
+    EXPECT_TRUE(FormatConverter(in, { AudioEncoding::PcmS16LE, 2, RATE }, 441).dithering()); // 重采样产生小数
+
+    // 直流输入：稳态输出保持直流电平（L/R 各 0.5 折叠为单声道）
+    std::vector<std::int16_t> dc(441 * 2, 8192);
+    std::vector<std::byte> pcm(dc.size() * 2);
+    std::memcpy(pcm.data(), dc.data(), pcm.size());
+    std::vector<std::byte> buf(conv.max_output_frames() * out.frame_bytes());
+    std::size_t total = 0;
+    std::vector<float> last;
+    for (int block = 0; block < 10; ++block) {
+        const auto frames = conv.process(pcm, buf, { });
+        total += frames;
+        last = decode_f32(std::span<const std::byte> { buf }.first(frames * out.frame_bytes()));
+    }
+    EXPECT_NEAR(static_cast<double>(total), 4800.0 - conv.delay_frames(), 1.5);
+    for (const auto v : last) {
+        EXPECT_NEAR(v, 0.25f, 1e-4f);
+    }
+}
+
+TEST(FormatConverterTest, RejectsUnsupportedConfigurations)
+{
+    const AudioFormat s16 { AudioEncoding::PcmS16LE, 2, RATE };
+    EXPECT_THROW(FormatConverter(s16, { AudioEncoding::PcmS16LE, 2, 48001 }, 64), std::invalid_argument);
+    EXPECT_THROW(FormatConverter(s16, { }, 64), std::invalid_argument);
+    EXPECT_THROW(FormatConverter(s16, s16, 0), std::invalid_argument);
+    EXPECT_THROW(FormatConverter(s16, s16, 64, FormatConverterOptions { .matrix = { 1.0f } }), std::invalid_argument);
+}
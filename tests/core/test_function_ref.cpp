@@ -0,0 +1,74 @@
+#include "core/rt/function_ref.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace {
+
+using aqua::rt::FunctionRef;
+
+struct Counter {
+    int total = 0;
+
+    int add(int v)
+    {
+        total += v;
+        return total;
+    }
+};
+
+int add_to_context(void* ctx, int v)
+{
+    return static_cast<Counter*>(ctx)->add(v);
+}
+
+} // namespace
+
+// 平凡拷贝、两个字长；临时可调用对象不可绑定（否则语句结束即悬空）
+static_assert(std::is_trivially_copyable_v<FunctionRef<void(int)>>);
+static_assert(sizeof(FunctionRef<void(int)>) == 2 * sizeof(void*));
+static_assert(!std::is_constructible_v<FunctionRef<void(int)>, decltype([](int) { })>);
+
+TEST(FunctionRefTest, DefaultIsEmpty)
+{
+    FunctionRef<void()> ref;
+    EXPECT_FALSE(ref);
+}
+
+TEST(FunctionRefTest, ReferencesNamedLambdaWithoutCopying)
+{
+    int calls = 0;
+    auto increment = [&calls](int by) { calls += by; };
+    const FunctionRef<void(int)> ref = increment;
+    ASSERT_TRUE(ref);
+    ref(2);
+    ref(3);
+    EXPECT_EQ(calls, 5);
+
+    // 拷贝引用的是同一个对象
+    const auto copy = ref;
+    copy(1);
+    EXPECT_EQ(calls, 6);
+}
+
+TEST(FunctionRefTest, GenericLambdaAndReturnConversion)
+{
+    const auto size_of = [](auto data) { return data.size(); };
+    std::byte buf[12] { };
+    const FunctionRef<std::size_t(std::span<std::byte>)> ref = size_of;
+    EXPECT_EQ(ref(buf), 12u);
+}
+
+TEST(FunctionRefTest, BindsMemberFunctionAndCStyleContext)
+{
+    Counter counter;
+    const auto member = FunctionRef<int(int)>::bind<&Counter::add>(counter);
+    EXPECT_EQ(member(4), 4);
+
+    const FunctionRef<int(int)> c_style(&add_to_context, &counter);
+    EXPECT_EQ(c_style(6), 10);
+    EXPECT_EQ(counter.total, 10);
+}
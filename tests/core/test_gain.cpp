@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include "core/audio/dsp/cpu_features.h"
+#include "core/audio/dsp/gain.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using aqua::AudioEncoding;
+using aqua::AudioFormat;
+using aqua::audio::dsp::SimdLevel;
+namespace dsp = aqua::audio::dsp;
+
+namespace {
+
+constexpr AudioEncoding ALL_ENCODINGS[] = {
+    AudioEncoding::PcmF32LE,
+    AudioEncoding::PcmS16LE,
+    AudioEncoding::PcmS24LE,
+    AudioEncoding::PcmS32LE,
+    AudioEncoding::PcmU8,
+};
+
+constexpr SimdLevel ALL_LEVELS[] = { SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Neon };
+
+std::size_t sample_bytes(AudioEncoding enc)
+{
+    return AudioFormat { enc, 1, 1 }.bytes_per_sample();
+}
+
+// 随机 PCM：F32 取 [-1.5, 1.5]（覆盖超出满幅的值），整数编码取满字节随机。
+std::vector<std::byte> random_pcm(AudioEncoding enc, std::size_t samples, std::mt19937& rng)
+{
+    std::vector<std::byte> pcm(samples * sample_bytes(enc));
+    if (enc == AudioEncoding::PcmF32LE) {
+        std::uniform_real_distribution<float> dist(-1.5f, 1.5f);
+        for (std::size_t i = 0; i < samples; ++i) {
+            const float v = dist(rng);
+            std::memcpy(pcm.data() + i * 4, &v, sizeof(v));
+        }
+    } else {
+        std::uniform_int_distribution<int> dist(0, 255);
+        for (auto& b : pcm) {
+            b = std::byte { static_cast<std::uint8_t>(dist(rng)) };
+        }
+    }
+    return pcm;
+}
+
+std::int32_t read_s24(const std::vector<std::byte>& pcm, std::size_t i)
+{
+    const auto b0 = static_cast<std::uint32_t>(pcm[i * 3]);
+    const auto b1 = static_cast<std::uint32_t>(pcm[i * 3 + 1]);
+    const auto b2 = static_cast<std::uint32_t>(pcm[i * 3 + 2]);
+    return static_cast<std::int32_t>((b0 << 8) | (b1 << 16) | (b2 << 24)) >> 8;
+}
+
+} // namespace
+
+TEST(GainTest, SimdLevelNames)
+{
+    EXPECT_STREQ(dsp::simd_level_name(SimdLevel::Scalar), "scalar");
+    EXPECT_STREQ(dsp::simd_level_name(SimdLevel::Sse2), "sse2");
+    EXPECT_STREQ(dsp::simd_level_name(SimdLevel::Avx2), "avx2");
+    EXPECT_STREQ(dsp::simd_level_name(SimdLevel::Neon), "neon");
+    EXPECT_TRUE(dsp::simd_level_supported(SimdLevel::Scalar));
+    EXPECT_TRUE(dsp::simd_level_supported(dsp::detect_simd_level()));
+}
+
+TEST(GainTest, EverySimdLevelMatchesScalarBitExact)
+{
+    // 奇数长度覆盖各宽度的尾部；字节偏移 1 覆盖非对齐起点。
+    std::mt19937 rng(1234);
+    const std::size_t lengths[] = { 1, 7, 15, 17, 33, 255, 257, 1031 };
+    const std::pair<float, float> ramps[] = { { 1.0f, 1.0f }, { 0.5f, 0.5f }, { 1.0f, 0.0f }, { 0.0f, 1.0f },
+        { 0.25f, 1.75f }, { 2.5f, 2.5f } };
+
+    for (const auto level : ALL_LEVELS) {
+        if (!dsp::simd_level_supported(level)) {
+            continue;
+        }
+        for (const auto enc : ALL_ENCODINGS) {
+            for (const auto len : lengths) {
+                for (const auto& [start, end] : ramps) {
+                    for (const std::size_t offset : { std::size_t { 0 }, std::size_t { 1 } }) {
+                        const auto src = random_pcm(enc, len, rng);
+                        std::vector<std::byte> ref(src.size() + offset);
+                        std::vector<std::byte> vec(src.size() + offset);
+                        std::memcpy(ref.data() + offset, src.data(), src.size());
+                        std::memcpy(vec.data() + offset, src.data(), src.size());
+
+                        dsp::apply_gain_ramp(std::span(ref).subspan(offset), enc, start, end, SimdLevel::Scalar);
+                        dsp::apply_gain_ramp(std::span(vec).subspan(offset), enc, start, end, level);
+                        ASSERT_EQ(ref, vec) << dsp::simd_level_name(level) << " enc=" << static_cast<int>(enc)
+                                            << " len=" << len << " ramp=" << start << "->" << end
+                                            << " offset=" << offset;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(GainTest, DefaultDispatchMatchesScalar)
+{
+    std::mt19937 rng(42);
+    for (const auto enc : ALL_ENCODINGS) {
+        auto ref = random_pcm(enc, 480, rng);
+        auto vec = ref;
+        dsp::apply_gain_ramp(ref, enc, 0.8f, 0.2f, SimdLevel::Scalar);
+        dsp::apply_gain_ramp(vec, enc, 0.8f, 0.2f);
+        EXPECT_EQ(ref, vec) << static_cast<int>(enc);
+    }
+}
+
+TEST(GainTest, S24SignExtendsAndRepacks)
+{
+    // -2 (0xFFFFFE) × 0.5 = -1 (0xFFFFFF)；0x7FFFFE × 0.5 = 0x3FFFFF
+    std::vector<std::byte> pcm = {
+        std::byte { 0xFE }, std::byte { 0xFF }, std::byte { 0xFF },
+        std::byte { 0xFE }, std::byte { 0xFF }, std::byte { 0x7F },
+    };
+    dsp::apply_gain(pcm, AudioEncoding::PcmS24LE, 0.5f);
+    EXPECT_EQ(read_s24(pcm, 0), -1);
+    EXPECT_EQ(read_s24(pcm, 1), 0x3FFFFF);
+}
+
+TEST(GainTest, U8CentredOn128)
+{
+    std::vector<std::byte> pcm = { std::byte { 128 }, std::byte { 255 }, std::byte { 0 }, std::byte { 192 } };
+    dsp::apply_gain(pcm, AudioEncoding::PcmU8, 0.5f);
+    EXPECT_EQ(static_cast<int>(pcm[0]), 128); // 零点不动
+    EXPECT_EQ(static_cast<int>(pcm[1]), 128 + 63); // 127 × 0.5 → 63
+    EXPECT_EQ(static_cast<int>(pcm[2]), 128 - 64); // -128 × 0.5
+    EXPECT_EQ(static_cast<int>(pcm[3]), 128 + 32);
+
+    dsp::apply_gain(pcm, AudioEncoding::PcmU8, 0.0f);
+    for (const auto b : pcm) {
+        EXPECT_EQ(static_cast<int>(b), 128);
+    }
+}
+
+TEST(GainTest, IntegerEncodingsSaturate)
+{
+    std::vector<std::int16_t> s16 = { 20000, -20000, 100 };
+    dsp::apply_gain(std::as_writable_bytes(std::span(s16)), AudioEncoding::PcmS16LE, 2.0f);
+    EXPECT_EQ(s16[0], 32767);
+    EXPECT_EQ(s16[1], -32768);
+    EXPECT_EQ(s16[2], 200);
+
+    std::vector<std::int32_t> s32 = { 2000000000, -2000000000 };
+    dsp::apply_gain(std::as_writable_bytes(std::span(s32)), AudioEncoding::PcmS32LE, 4.0f);
+    EXPECT_GT(s32[0], 2147483000);
+    EXPECT_EQ(s32[1], INT32_MIN);
+}
+
+TEST(GainTest, RampEndpointsAreLinear)
+{
+    // 4 个样本从 1 渐变到 0：增益 1, 0.75, 0.5, 0.25（end 落在下一块首样本）
+    std::vector<float> f32(4, 1.0f);
+    dsp::apply_gain_ramp(std::as_writable_bytes(std::span(f32)), AudioEncoding::PcmF32LE, 1.0f, 0.0f);
+    EXPECT_FLOAT_EQ(f32[0], 1.0f);
+    EXPECT_FLOAT_EQ(f32[1], 0.75f);
+    EXPECT_FLOAT_EQ(f32[2], 0.5f);
+    EXPECT_FLOAT_EQ(f32[3], 0.25f);
+
+    std::vector<std::int16_t> s16(8, 10000);
+    dsp::apply_gain_ramp(std::as_writable_bytes(std::span(s16)), AudioEncoding::PcmS16LE, 0.0f, 1.0f);
+    EXPECT_EQ(s16[0], 0);
+    EXPECT_EQ(s16[4], 5000);
+    EXPECT_EQ(s16[7], 8750);
+}
+
+TEST(GainTest, TrailingPartialSampleUntouched)
+{
+    std::vector<std::byte> pcm(7, std::byte { 0x10 }); // S16：3 个整样本 + 1 个残字节
+    dsp::apply_gain(pcm, AudioEncoding::PcmS16LE, 0.0f);
+    for (std::size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(pcm[i], std::byte { 0 });
+    }
+    EXPECT_EQ(pcm[6], std::byte { 0x10 });
+}
+
+TEST(GainTest, MixAccumulateMatchesScalarBitExact)
+{
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> dist(-1.5f, 1.5f);
+    for (const auto level : ALL_LEVELS) {
+        if (!dsp::simd_level_supported(level)) {
+            continue;
+        }
+        for (const std::size_t len : { 1, 7, 15, 17, 257, 1031 }) {
+            std::vector<float> acc(len);
+            std::vector<float> src(len);
+            for (auto& v : acc) {
+                v = dist(rng);
+            }
+            for (auto& v : src) {
+                v = dist(rng);
+            }
+            auto ref = acc;
+            auto vec = acc;
+            dsp::mix_accumulate(ref, src, 0.3f, SimdLevel::Scalar);
+            dsp::mix_accumulate(vec, src, 0.3f, level);
+            ASSERT_EQ(ref, vec) << dsp::simd_level_name(level) << " len=" << len;
+        }
+    }
+}
+
+TEST(GainTest, MixAccumulateSumsWithGain)
+{
+    std::vector<float> acc { 0.5f, -0.25f, 1.0f };
+    const std::vector<float> src { 0.5f, 0.5f, 1.0f, 9.0f }; // 多出的样本不参与
+    dsp::mix_accumulate(acc, src, 0.5f);
+    EXPECT_FLOAT_EQ(acc[0], 0.75f);
+    EXPECT_FLOAT_EQ(acc[1], 0.0f);
+    EXPECT_FLOAT_EQ(acc[2], 1.5f); // F32 累加不钳位
+}
@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+
+#include "core/audio/backend/audio_backend_factory.h"
+#include "core/audio/backend/headless/wav_file.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using aqua::AudioEncoding;
+using aqua::AudioFormat;
+using aqua::audio::CaptureSource;
+using aqua::audio::CaptureSourceConfig;
+
+namespace {
+
+const AudioFormat kS16Stereo { AudioEncoding::PcmS16LE, 2, 48000 };
+
+std::filesystem::path temp_path(const char* name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+void write_file(const std::filesystem::path& path, const std::vector<std::byte>& bytes)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+// 启动采集，收集 duration 内的全部回调数据。
+struct Collected {
+    std::vector<std::byte> bytes;
+    std::size_t callbacks = 0;
+    std::size_t callback_bytes = 0; // 首次回调长度（每周期固定）
+};
+
+Collected run_capture(const CaptureSourceConfig& cfg, std::chrono::milliseconds duration, AudioFormat& format)
+{
+    Collected c;
+    std::mutex mutex;
+    // 回调是非拥有引用：先于后端声明，后端析构（stop）时仍然有效
+    const auto on_pcm = [&](std::span<const std::byte> pcm) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (c.callbacks == 0) {
+            c.callback_bytes = pcm.size();
+        }
+        ++c.callbacks;
+        c.bytes.insert(c.bytes.end(), pcm.begin(), pcm.end());
+    };
+    auto backend = aqua::audio::create_capture_backend(cfg);
+    EXPECT_NE(backend, nullptr);
+    if (!backend) {
+        return c;
+    }
+    EXPECT_TRUE(backend->start(on_pcm, format));
+    EXPECT_TRUE(backend->is_running());
+    std::this_thread::sleep_for(duration);
+    backend->stop();
+    EXPECT_FALSE(backend->is_running());
+    return c;
+}
+
+} // namespace
+
+// ---- WAV 读写 ----
+
+TEST(WavFileTest, HeaderRoundTrip)
+{
+    const AudioFormat fmt { AudioEncoding::PcmF32LE, 2, 44100 };
+    std::vector<std::byte> file(aqua::audio::WAV_HEADER_BYTES + 8 * 10);
+    ASSERT_TRUE(aqua::audio::write_wav_header(fmt, 80,
+        std::span<std::byte, aqua::audio::WAV_HEADER_BYTES> { file.data(), aqua::audio::WAV_HEADER_BYTES }));
+
+    auto info = aqua::audio::parse_wav(file);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->format, fmt);
+    EXPECT_EQ(info->data_offset, aqua::audio::WAV_HEADER_BYTES);
+    EXPECT_EQ(info->data_bytes, 80u);
+}
+
+TEST(WavFileTest, StreamingHeaderUsesActualLength)
+{
+    // 流式写出的 WAV 常把 data size 留为 0：按文件实际长度解析，并按帧对齐截断
+    std::vector<std::byte> file(aqua::audio::WAV_HEADER_BYTES + 4 * 5 + 3);
+    ASSERT_TRUE(aqua::audio::write_wav_header(kS16Stereo, 0,
+        std::span<std::byte, aqua::audio::WAV_HEADER_BYTES> { file.data(), aqua::audio::WAV_HEADER_BYTES }));
+
+    auto info = aqua::audio::parse_wav(file);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->data_bytes, 20u);
+}
+
+TEST(WavFileTest, RejectsNonWav)
+{
+    std::vector<std::byte> garbage(64, std::byte { 0x11 });
+    EXPECT_FALSE(aqua::audio::parse_wav(garbage).has_value());
+    EXPECT_FALSE(aqua::audio::parse_wav({ }).has_value());
+}
+
+// ---- 工厂校验 ----
+
+TEST(HeadlessCaptureTest, FactoryRejectsInvalidConfig)
+{
+    CaptureSourceConfig cfg;
+    cfg.source = CaptureSource::Sine;
+    cfg.format = { };
+    EXPECT_EQ(aqua::audio::create_capture_backend(cfg), nullptr);
+
+    cfg.format = kS16Stereo;
+    cfg.period = std::chrono::microseconds(0);
+    EXPECT_EQ(aqua::audio::create_capture_backend(cfg), nullptr);
+
+    cfg.period = std::chrono::milliseconds(10);
+    cfg.frequency_hz = 0.0;
+    EXPECT_EQ(aqua::audio::create_capture_backend(cfg), nullptr);
+
+    // 超过 Nyquist：与 CLI 一致拒绝；恰为 sample_rate/2 仍允许
+    cfg.frequency_hz = kS16Stereo.sample_rate / 2.0 + 1.0;
+    EXPECT_EQ(aqua::audio::create_capture_backend(cfg), nullptr);
+    cfg.frequency_hz = kS16Stereo.sample_rate / 2.0;
+    EXPECT_NE(aqua::audio::create_capture_backend(cfg), nullptr);
+    cfg.frequency_hz = 440.0;
+    cfg.amplitude = 1.5;
+    EXPECT_EQ(aqua::audio::create_capture_backend(cfg), nullptr);
+    cfg.amplitude = 0.5;
+
+    cfg.source = CaptureSource::File; // 无路径
+    EXPECT_EQ(aqua::audio::create_capture_backend(cfg), nullptr);
+}
+
+TEST(HeadlessCaptureTest, MissingFileFailsToStart)
+{
+    CaptureSourceConfig cfg;
+    cfg.source = CaptureSource::File;
+    cfg.path = temp_path("aqua_test_missing_capture.wav").string();
+    const auto on_pcm = [](std::span<const std::byte>) { };
+    auto backend = aqua::audio::create_capture_backend(cfg);
+    ASSERT_NE(backend, nullptr);
+    AudioFormat fmt { };
+    EXPECT_FALSE(backend->start(on_pcm, fmt));
+    EXPECT_FALSE(backend->is_running());
+}
+
+// ---- 信号发生器：格式、周期与实时节拍 ----
+
+TEST(HeadlessCaptureTest, SinePacedAtRealTime)
+{
+    CaptureSourceConfig cfg;
+    cfg.source = CaptureSource::Sine;
+    cfg.format = kS16Stereo;
+    cfg.period = std::chrono::milliseconds(5);
+    cfg.amplitude = 0.5;
+
+    AudioFormat fmt { };
+    const auto c = run_capture(cfg, std::chrono::milliseconds(300), fmt);
+    EXPECT_EQ(fmt, kS16Stereo);
+    EXPECT_EQ(c.callback_bytes, 240u * 4); // 5ms @48kHz = 240 帧 × 4B
+
+    // 实时节拍：300ms 内约 60 个周期（首周期立即交付，容忍调度抖动）
+    EXPECT_GE(c.callbacks, 45u);
+    EXPECT_LE(c.callbacks, 75u);
+
+    // 幅度不超过 0.5 满量程
+    for (std::size_t i = 0; i + 1 < c.bytes.size(); i += 2) {
+        std::int16_t s;
+        std::memcpy(&s, c.bytes.data() + i, sizeof(s));
+        ASSERT_LE(std::abs(s), 16384);
+    }
+}
+
+TEST(HeadlessCaptureTest, ImpulseTrainSpacing)
+{
+    CaptureSourceConfig cfg;
+    cfg.source = CaptureSource::Impulse;
+    cfg.format = { AudioEncoding::PcmF32LE, 1, 48000 };
+    cfg.period = std::chrono::milliseconds(10);
+    cfg.frequency_hz = 1000.0; // 每 48 帧一个脉冲
+    cfg.amplitude = 1.0;
+
+    AudioFormat fmt { };
+    const auto c = run_capture(cfg, std::chrono::milliseconds(50), fmt);
+    ASSERT_GE(c.bytes.size(), 480u * 4);
+
+    std::vector<std::size_t> pulses;
+    for (std::size_t i = 0; i < 480; ++i) {
+        float v;
+        std::memcpy(&v, c.bytes.data() + i * 4, sizeof(v));
+        if (v != 0.0f) {
+            EXPECT_FLOAT_EQ(v, 1.0f);
+            pulses.push_back(i);
+        }
+    }
+    ASSERT_EQ(pulses.size(), 10u);
+    for (std::size_t i = 0; i < pulses.size(); ++i) {
+        EXPECT_EQ(pulses[i], i * 48);
+    }
+}
+
+// ---- 文件来源：WAV 头覆盖格式、循环播放 ----
+
+TEST(HeadlessCaptureTest, WavFileLoops)
+{
+    const AudioFormat wav_fmt { AudioEncoding::PcmS16LE, 1, 8000 };
+    constexpr std::size_t frames = 5;
+    std::vector<std::byte> file(aqua::audio::WAV_HEADER_BYTES + frames * 2);
+    ASSERT_TRUE(aqua::audio::write_wav_header(wav_fmt, frames * 2,
+        std::span<std::byte, aqua::audio::WAV_HEADER_BYTES> { file.data(), aqua::audio::WAV_HEADER_BYTES }));
+    for (std::size_t i = 0; i < frames; ++i) {
+        const auto v = static_cast<std::int16_t>(i + 1);
+        std::memcpy(file.data() + aqua::audio::WAV_HEADER_BYTES + i * 2, &v, sizeof(v));
+    }
+    const auto path = temp_path("aqua_test_capture_loop.wav");
+    write_file(path, file);
+
+    CaptureSourceConfig cfg;
+    cfg.source = CaptureSource::File;
+    cfg.path = path.string();
+    cfg.format = kS16Stereo; // 被 WAV 头覆盖
+    cfg.period = std::chrono::milliseconds(2); // 16 帧/周期 > 文件长度，必然跨尾循环
+
+    AudioFormat fmt { };
+    const auto c = run_capture(cfg, std::chrono::milliseconds(30), fmt);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(fmt, wav_fmt);
+    ASSERT_GE(c.bytes.size(), 32u);
+    for (std::size_t i = 0; i < c.bytes.size() / 2; ++i) {
+        std::int16_t s;
+        std::memcpy(&s, c.bytes.data() + i * 2, sizeof(s));
+        ASSERT_EQ(s, static_cast<std::int16_t>(i % frames + 1)) << "sample " << i;
+    }
+}
+
+// ---- 管道来源：不足补静音，按帧对齐 ----
+
+#if !defined(_WIN32)
+TEST(HeadlessCaptureTest, FifoPadsSilenceAndKeepsFrameAlignment)
+{
+    const auto path = temp_path("aqua_test_capture.fifo");
+    std::filesystem::remove(path);
+    ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0);
+
+    CaptureSourceConfig cfg;
+    cfg.source = CaptureSource::Pipe;
+    cfg.path = path.string();
+    cfg.format = kS16Stereo;
+    cfg.period = std::chrono::milliseconds(5);
+
+    std::vector<std::byte> received;
+    std::mutex mutex;
+    const auto on_pcm = [&](std::span<const std::byte> pcm) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.insert(received.end(), pcm.begin(), pcm.end());
+    };
+    auto backend = aqua::audio::create_capture_backend(cfg);
+    ASSERT_NE(backend, nullptr);
+    AudioFormat fmt { };
+    ASSERT_TRUE(backend->start(on_pcm, fmt));
+
+    // 写入 10 帧 + 半帧：半帧留在 carry，不得错位声道
+    const int wfd = ::open(path.c_str(), O_WRONLY);
+    ASSERT_GE(wfd, 0);
+    std::vector<std::byte> frames(10 * 4 + 2, std::byte { 0x7F });
+    ASSERT_EQ(::write(wfd, frames.data(), frames.size()), static_cast<ssize_t>(frames.size()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ::close(wfd);
+    backend->stop();
+    std::filesystem::remove(path);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received.size() % 960, 0u); // 每周期恰好 240 帧
+    std::size_t non_silent = 0;
+    for (auto b : received) {
+        non_silent += b != std::byte { 0 } ? 1 : 0;
+    }
+    EXPECT_EQ(non_silent, 40u); // 仅 10 个整帧被交付
+}
+#endif
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include "core/audio/backend/audio_backend_factory.h"
+#include "core/audio/backend/headless/headless_playback.h"
+#include "core/audio/backend/headless/wav_file.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+using aqua::AudioEncoding;
+using aqua::AudioFormat;
+using aqua::audio::HeadlessPlayback;
+using aqua::audio::PlaybackSink;
+using aqua::audio::PlaybackSinkConfig;
+
+namespace {
+
+const AudioFormat kS16Stereo { AudioEncoding::PcmS16LE, 2, 48000 };
+
+std::vector<std::byte> read_file(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> raw((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::vector<std::byte> bytes(raw.size());
+    std::memcpy(bytes.data(), raw.data(), raw.size());
+    return bytes;
+}
+
+} // namespace
+
+TEST(HeadlessPlaybackTest, FactoryValidatesConfig)
+{
+    PlaybackSinkConfig cfg;
+    cfg.sink = PlaybackSink::Null;
+    EXPECT_NE(aqua::audio::create_playback_backend(cfg), nullptr);
+
+    cfg.period = std::chrono::microseconds(0);
+    EXPECT_EQ(aqua::audio::create_playback_backend(cfg), nullptr);
+
+    cfg.period = std::chrono::milliseconds(10);
+    cfg.drift_ppm = aqua::audio::MAX_PLAYBACK_DRIFT_PPM + 1.0;
+    EXPECT_EQ(aqua::audio::create_playback_backend(cfg), nullptr);
+
+    cfg.drift_ppm = 0.0;
+    cfg.sink = PlaybackSink::File;
+    EXPECT_EQ(aqua::audio::create_playback_backend(cfg), nullptr); // 无路径
+}
+
+TEST(HeadlessPlaybackTest, NegotiateAppliesFormatOverrides)
+{
+    PlaybackSinkConfig cfg;
+    cfg.sink = PlaybackSink::Null;
+    auto follow = aqua::audio::create_playback_backend(cfg);
+    ASSERT_NE(follow, nullptr);
+    EXPECT_EQ(follow->negotiate_format(kS16Stereo), kS16Stereo);
+
+    cfg.encoding = AudioEncoding::PcmF32LE;
+    cfg.channels = 6;
+    auto surround = aqua::audio::create_playback_backend(cfg);
+    ASSERT_NE(surround, nullptr);
+    // 采样率未覆盖时跟随请求
+    EXPECT_EQ(surround->negotiate_format(kS16Stereo), (AudioFormat { AudioEncoding::PcmF32LE, 6, 48000 }));
+
+    cfg.sample_rate = 44100;
+    auto resampled = aqua::audio::create_playback_backend(cfg);
+    ASSERT_NE(resampled, nullptr);
+    EXPECT_EQ(resampled->negotiate_format(kS16Stereo), (AudioFormat { AudioEncoding::PcmF32LE, 6, 44100 }));
+}
+
+TEST(HeadlessPlaybackTest, ConsumptionTimeScalesWithDrift)
+{
+    using std::chrono::nanoseconds;
+    EXPECT_EQ(HeadlessPlayback::consumption_time(48000, 48000, 0.0), nanoseconds(1'000'000'000));
+    // +100ppm：同样 1 秒的帧数提前 ~100us 消费完。
+    const auto fast = HeadlessPlayback::consumption_time(48000, 48000, 100.0);
+    EXPECT_NEAR(static_cast<double>(fast.count()), 1e9 / 1.0001, 2.0);
+    const auto slow = HeadlessPlayback::consumption_time(48000, 48000, -100.0);
+    EXPECT_NEAR(static_cast<double>(slow.count()), 1e9 / 0.9999, 2.0);
+    EXPECT_EQ(HeadlessPlayback::consumption_time(480, 0, 0.0), nanoseconds(0));
+}
+
+TEST(HeadlessPlaybackTest, NullSinkConsumesAtRealTimePace)
+{
+    PlaybackSinkConfig cfg;
+    cfg.sink = PlaybackSink::Null;
+    cfg.period = std::chrono::milliseconds(10);
+    auto playback = aqua::audio::create_playback_backend(cfg);
+    ASSERT_NE(playback, nullptr);
+
+    std::atomic<std::size_t> consumed { 0 };
+    std::atomic<std::size_t> callback_bytes { 0 };
+    const auto fill = [&](std::span<std::byte> out) -> std::size_t {
+        callback_bytes.store(out.size(), std::memory_order_relaxed);
+        consumed.fetch_add(out.size(), std::memory_order_relaxed);
+        return out.size();
+    };
+    ASSERT_TRUE(playback->start(kS16Stereo, fill));
+    const auto begin = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    playback->stop();
+    const double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    EXPECT_FALSE(playback->is_running());
+
+    // 每周期恰好 10ms = 480 帧
+    EXPECT_EQ(callback_bytes.load(), 480u * kS16Stereo.frame_bytes());
+    // 实时节拍：消费帧数 ≈ 经过时长 × 采样率（首周期立即拉取，放宽容差应对 CI 调度）
+    const double frames = static_cast<double>(consumed.load()) / kS16Stereo.frame_bytes();
+    EXPECT_GT(frames, elapsed_s * 48000 * 0.7);
+    EXPECT_LT(frames, elapsed_s * 48000 * 1.3 + 480);
+}
+
+TEST(HeadlessPlaybackTest, FileSinkRecordsWhatWasPlayedIncludingSilence)
+{
+    const auto path = std::filesystem::temp_directory_path() / "aqua_headless_playback.wav";
+    PlaybackSinkConfig cfg;
+    cfg.sink = PlaybackSink::File;
+    cfg.path = path.string();
+    cfg.period = std::chrono::milliseconds(5);
+    auto playback = aqua::audio::create_playback_backend(cfg);
+    ASSERT_NE(playback, nullptr);
+
+    // 每周期只填前半（0x11），后半由后端补静音
+    const auto fill = [](std::span<std::byte> out) -> std::size_t {
+        const std::size_t half = out.size() / 2;
+        std::memset(out.data(), 0x11, half);
+        return half;
+    };
+    ASSERT_TRUE(playback->start(kS16Stereo, fill));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    playback->stop();
+
+    const auto file = read_file(path);
+    const auto wav = aqua::audio::parse_wav(file);
+    ASSERT_TRUE(wav.has_value());
+    EXPECT_EQ(wav->format, kS16Stereo);
+    // 头部已回填实际长度，且按整周期（240 帧）写出
+    const std::size_t period_bytes = 240u * kS16Stereo.frame_bytes();
+    ASSERT_GE(wav->data_bytes, period_bytes);
+    EXPECT_EQ(wav->data_bytes % period_bytes, 0u);
+    EXPECT_EQ(wav->data_offset + wav->data_bytes, file.size());
+
+    const std::byte* pcm = file.data() + wav->data_offset;
+    EXPECT_EQ(pcm[0], std::byte { 0x11 });
+    EXPECT_EQ(pcm[period_bytes / 2 - 1], std::byte { 0x11 });
+    EXPECT_EQ(pcm[period_bytes / 2], std::byte { 0 });
+    EXPECT_EQ(pcm[period_bytes - 1], std::byte { 0 });
+
+    std::filesystem::remove(path);
+}
+
+TEST(HeadlessPlaybackTest, FileSinkFailsOnUnwritablePath)
+{
+    PlaybackSinkConfig cfg;
+    cfg.sink = PlaybackSink::File;
+    cfg.path = (std::filesystem::temp_directory_path() / "aqua_no_such_dir" / "out.wav").string();
+    auto playback = aqua::audio::create_playback_backend(cfg);
+    ASSERT_NE(playback, nullptr);
+    const auto fill = [](std::span<std::byte>) -> std::size_t { return 0; };
+    EXPECT_FALSE(playback->start(kS16Stereo, fill));
+    EXPECT_FALSE(playback->is_running());
+}
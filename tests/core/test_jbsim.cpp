@@ -0,0 +1,156 @@
+#include "core/jbsim/arrival_trace.h"
+#include "core/jbsim/jb_simulator.h"
+#include "core/jitter_buffer/jitter_buffer.h"
+#include "core/jitter_buffer/sim_clock.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace {
+
+using aqua::jbsim::Arrival;
+using aqua::jbsim::NetworkProfile;
+using aqua::jitter::SimClock;
+
+// 48kHz、144 帧/包 = 3ms
+constexpr std::uint32_t FRAMES = 144;
+constexpr std::chrono::nanoseconds PACKET { 3'000'000 };
+
+aqua::AudioFormat f32_format()
+{
+    return { aqua::AudioEncoding::PcmF32LE, 2, 48000 };
+}
+
+} // namespace
+
+TEST(JbsimTest, SimClockDrivesJitterBufferDeadlines)
+{
+    aqua::jitter::BasicJitterBuffer<SimClock> jb(f32_format(), FRAMES, /*floor=*/4, /*capacity=*/16);
+    const std::vector<std::byte> payload(FRAMES * 8);
+    std::vector<std::byte> out(payload.size());
+
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    jb.push(0, payload);
+    ASSERT_TRUE(jb.next_playout_deadline().has_value());
+    EXPECT_EQ(*jb.next_playout_deadline(), t0 + 4 * PACKET);
+
+    SimClock::set(*jb.next_playout_deadline());
+    EXPECT_TRUE(jb.pop_next(out));
+    EXPECT_EQ(*jb.next_playout_deadline(), t0 + 5 * PACKET);
+
+    // 虚拟时间跳过 1s：断流检测按虚拟时钟判定，重置时间线
+    SimClock::advance(std::chrono::seconds(1));
+    EXPECT_FALSE(jb.pop_next(out));
+    EXPECT_FALSE(jb.next_playout_deadline().has_value());
+}
+
+TEST(JbsimTest, GeneratedTraceIsDeterministicAndSorted)
+{
+    auto profile = *aqua::jbsim::network_profile_preset("cellular");
+    profile.seed = 7;
+    const auto a = aqua::jbsim::generate_trace(profile, 5000, PACKET);
+    const auto b = aqua::jbsim::generate_trace(profile, 5000, PACKET);
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].sequence, b[i].sequence);
+        EXPECT_EQ(a[i].arrival_ns, b[i].arrival_ns);
+    }
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end(), [](const Arrival& x, const Arrival& y) {
+        return x.arrival_ns < y.arrival_ns;
+    }));
+    // 基础时延是下界
+    for (const auto& arr : a) {
+        EXPECT_GE(arr.arrival_ns - arr.send_ns, 30'000'000);
+    }
+}
+
+TEST(JbsimTest, GilbertElliottLossMatchesStationaryRate)
+{
+    NetworkProfile profile;
+    profile.ge_good_to_bad = 0.01;
+    profile.ge_bad_to_good = 0.25;
+    profile.ge_loss_bad = 1.0;
+    constexpr std::uint32_t PACKETS = 200000;
+    const auto trace = aqua::jbsim::generate_trace(profile, PACKETS, PACKET);
+
+    // 稳态 Bad 占比 p / (p + r) ≈ 3.85%
+    const double loss = 1.0 - static_cast<double>(trace.size()) / PACKETS;
+    EXPECT_NEAR(loss, 0.01 / 0.26, 0.005);
+}
+
+TEST(JbsimTest, PowerSaveBurstsAlignToWakeInterval)
+{
+    NetworkProfile profile;
+    profile.psm_interval_ms = 20.0;
+    const auto trace = aqua::jbsim::generate_trace(profile, 1000, PACKET);
+    ASSERT_EQ(trace.size(), 1000u);
+    for (const auto& a : trace) {
+        EXPECT_EQ(a.arrival_ns % 20'000'000, 0);
+    }
+}
+
+TEST(JbsimTest, DriftScalesSendInterval)
+{
+    NetworkProfile profile;
+    profile.drift_ppm = 1000.0;
+    const auto trace = aqua::jbsim::generate_trace(profile, 1001, PACKET);
+    EXPECT_EQ(trace.back().send_ns, 1000 * PACKET.count() * 999 / 1000);
+}
+
+TEST(JbsimTest, ParseTraceUnwrapsSequenceAndNormalizesTransit)
+{
+    const auto trace = aqua::jbsim::parse_trace("# recorded\n"
+                                                "1000 4294967295\n"
+                                                "\n"
+                                                "5000 0\r\n"
+                                                "6000\t1\n",
+        PACKET);
+    ASSERT_TRUE(trace.has_value());
+    ASSERT_EQ(trace->size(), 3u);
+    // 回绕后按 0、1、2 包推算发送时刻：传输时延 1ms、2ms、0ms，最小值已为 0，不平移
+    EXPECT_EQ((*trace)[2].sequence, 1u);
+    EXPECT_EQ((*trace)[2].arrival_ns - (*trace)[2].send_ns, 0);
+    EXPECT_EQ((*trace)[1].arrival_ns - (*trace)[1].send_ns, 2'000'000);
+    EXPECT_EQ((*trace)[0].arrival_ns - (*trace)[0].send_ns, 1'000'000);
+
+    EXPECT_FALSE(aqua::jbsim::parse_trace("1000\n", PACKET).has_value());
+    EXPECT_FALSE(aqua::jbsim::parse_trace("1000 x\n", PACKET).has_value());
+    EXPECT_FALSE(aqua::jbsim::parse_trace("# empty\n", PACKET).has_value());
+}
+
+TEST(JbsimTest, CleanTraceHasFixedLatencyAndRunsFasterThanRealTime)
+{
+    NetworkProfile profile; // 1ms 固定时延，无抖动无丢包
+    const auto trace = aqua::jbsim::generate_trace(profile, 200000, PACKET); // 600s
+
+    aqua::jbsim::SimConfig cfg;
+    cfg.jitter_buffer_ms = 30; // capacity 16，floor 4 包 = 12ms
+    const auto report = aqua::jbsim::simulate(cfg, trace);
+
+    EXPECT_EQ(report.packets_arrived, 200000u);
+    EXPECT_EQ(report.blocks_played, 200000u);
+    EXPECT_EQ(report.blocks_concealed, 0u);
+    EXPECT_NEAR(report.latency_ms.p50, 13.0, 1e-6);
+    EXPECT_NEAR(report.latency_ms.max, 13.0, 1e-6);
+    EXPECT_NEAR(report.target_ms.max, 12.0, 1e-6);
+    EXPECT_NEAR(report.simulated_s, 600.0, 0.1);
+    EXPECT_LT(report.wall_s * 100.0, report.simulated_s);
+}
+
+TEST(JbsimTest, LossyTraceReportsConcealmentRuns)
+{
+    auto profile = *aqua::jbsim::network_profile_preset("lossy");
+    const auto trace = aqua::jbsim::generate_trace(profile, 20000, PACKET);
+
+    aqua::jbsim::SimConfig cfg;
+    const auto report = aqua::jbsim::simulate(cfg, trace);
+    EXPECT_GT(report.blocks_concealed, 0u);
+    EXPECT_GT(report.concealed_pct, 0.0);
+    EXPECT_GE(report.conceal_run_blocks.max, 1.0);
+    EXPECT_GE(report.conceal_run_blocks.max, report.conceal_run_blocks.p50);
+    EXPECT_GT(report.latency_ms.p50, 0.0);
+}
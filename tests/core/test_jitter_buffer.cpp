@@ -1,4 +1,5 @@
 #include "core/jitter_buffer/jitter_buffer.h"
+#include "core/jitter_buffer/sim_clock.h"
 #include "core/public/audio_format.h"
 
 #include <gtest/gtest.h>
@@ -7,6 +8,7 @@
 #include <array>
 #include <chrono>
 #include <cstring>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
@@ -195,6 +197,24 @@ TEST(JitterBufferTest, SinglePacketLossConcealedWithDecayedRepeat)
     EXPECT_EQ(jb.packets_lost(), 1);
 }
 
+TEST(JitterBufferTest, PackedS24LossConcealedNotSilenced)
+{
+    // 打包 24 位同样走衰减重复（此前回退静音）
+    aqua::AudioFormat fmt = make_test_format();
+    fmt.encoding = aqua::AudioEncoding::PcmS24LE;
+    constexpr std::size_t S24_PAYLOAD = FRAMES_PER_PACKET * 2 * 3;
+    aqua::jitter::JitterBuffer jb(fmt, FRAMES_PER_PACKET, TARGET, CAPACITY);
+    std::vector<std::byte> out(S24_PAYLOAD);
+
+    jb.push(100, make_payload(0x40, S24_PAYLOAD)); // 每样本 0x404040
+    jb.push(102, make_payload(102, S24_PAYLOAD));
+
+    EXPECT_TRUE(jb.pop_next(out));
+    EXPECT_FALSE(jb.pop_next(out));
+    // 0x404040 × 0.5 = 0x202020
+    EXPECT_TRUE(is_payload_of(out, 0x20));
+}
+
 TEST(JitterBufferTest, ConsecutivePacketLossDecaysToSilence)
 {
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
@@ -490,6 +510,234 @@ TEST(JitterBufferTest, BufferFillPackets)
     EXPECT_EQ(jb.buffer_fill_packets(), 3);
 }
 
+TEST(JitterBufferTest, BufferFillTracksReorderPopAndRebase)
+{
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+
+    // 乱序到达，101 缺失；重复包不改变占用
+    jb.push(100, make_payload(100));
+    jb.push(103, make_payload(103));
+    jb.push(102, make_payload(102));
+    jb.push(102, make_payload(102));
+    EXPECT_EQ(jb.buffer_fill_packets(), 3);
+
+    EXPECT_TRUE(jb.pop_next(out)); // 100
+    EXPECT_EQ(jb.buffer_fill_packets(), 2);
+    EXPECT_FALSE(jb.pop_next(out)); // 101: PLC，占用不变
+    EXPECT_EQ(jb.buffer_fill_packets(), 2);
+    EXPECT_TRUE(jb.pop_next(out)); // 102
+    EXPECT_EQ(jb.buffer_fill_packets(), 1);
+    EXPECT_EQ(jb.next_sequence(), 103u);
+
+    // 迟到的 101 不入槽
+    jb.push(101, make_payload(101));
+    EXPECT_EQ(jb.buffer_fill_packets(), 1);
+
+    // 大跳跃软 rebase：103 留在 slot 但落在新窗口 [120, 128) 之外，不计入
+    jb.push(120, make_payload(120));
+    EXPECT_EQ(jb.next_sequence(), 120u);
+    EXPECT_EQ(jb.buffer_fill_packets(), 1);
+    jb.push(121, make_payload(121));
+    EXPECT_EQ(jb.buffer_fill_packets(), 2);
+}
+
+// ---- 零拷贝接收 / 两段输出 ----
+
+TEST(JitterBufferTest, ReceiveBufferPushIsZeroCopy)
+{
+    constexpr std::size_t HEADROOM = 15;
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, TARGET, CAPACITY,
+        aqua::config::JITTER_DETECT_WINDOW_PACKETS, aqua::config::JITTER_DRIFT_REBASE_LATE_COUNT,
+        std::nullopt, HEADROOM);
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+
+    // 模拟 UdpTransport：报文收进 receive_buffer()，payload 位于 headroom 之后
+    const auto receive = [&](std::uint32_t seq) {
+        auto buf = jb.receive_buffer();
+        EXPECT_EQ(buf.size(), HEADROOM + PAYLOAD_SIZE);
+        const auto payload = make_payload(seq);
+        std::memcpy(buf.data() + HEADROOM, payload.data(), PAYLOAD_SIZE);
+        jb.push(seq, std::span<const std::byte> { buf.data() + HEADROOM, PAYLOAD_SIZE });
+        return buf.data();
+    };
+
+    const auto* first_rx = receive(10);
+    // 入槽后备用缓冲已换成另一块：下一次接收不会覆盖已缓冲的包
+    EXPECT_NE(jb.receive_buffer().data(), first_rx);
+    receive(11);
+    receive(12);
+    EXPECT_EQ(jb.buffer_fill_packets(), 3u);
+
+    for (std::uint32_t seq = 10; seq <= 12; ++seq) {
+        EXPECT_TRUE(jb.pop_next(out));
+        EXPECT_TRUE(is_payload_of(out, seq));
+    }
+    // PLC 历史来自最后一个真实包（索引交换，不依赖拷贝）
+    EXPECT_FALSE(jb.pop_next(out));
+    EXPECT_TRUE(is_plc_of(out, 12, 0.5f));
+}
+
+TEST(JitterBufferTest, DuplicateInReceiveBufferKeepsSpare)
+{
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+    jb.push(5, make_payload(5));
+
+    // 重复包不入槽：备用缓冲不变，已缓冲的 5 不被覆盖
+    auto spare = jb.receive_buffer();
+    const auto dup = make_payload(99);
+    std::memcpy(spare.data(), dup.data(), PAYLOAD_SIZE);
+    jb.push(5, std::span<const std::byte> { spare.data(), PAYLOAD_SIZE });
+    EXPECT_EQ(jb.receive_buffer().data(), spare.data());
+    EXPECT_EQ(jb.duplicates(), 1u);
+
+    EXPECT_TRUE(jb.pop_next(out));
+    EXPECT_TRUE(is_payload_of(out, 5));
+}
+
+TEST(JitterBufferTest, PopIntoSplitRegion)
+{
+    aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    jb.push(0, make_payload(0));
+
+    // 1001 字节处拆开（不在样本边界），模拟 RingBuffer 跨尾部的预留区
+    std::vector<std::byte> a(1001), b(PAYLOAD_SIZE - 1001);
+    EXPECT_TRUE(jb.pop_next(a, b));
+    EXPECT_TRUE(is_payload_of(a, 0));
+    EXPECT_TRUE(is_payload_of(b, 0));
+
+    // 丢包隐藏跨段输出：拼接后与单段输出一致
+    EXPECT_FALSE(jb.pop_next(a, b));
+    std::vector<std::byte> joined(a);
+    joined.insert(joined.end(), b.begin(), b.end());
+    EXPECT_TRUE(is_plc_of(joined, 0, 0.5f));
+
+    // 总长不足：拒绝且不推进
+    const auto seq = jb.next_sequence();
+    std::vector<std::byte> small1(PAYLOAD_SIZE / 4), small2(PAYLOAD_SIZE / 4);
+    EXPECT_FALSE(jb.pop_next(small1, small2));
+    EXPECT_EQ(jb.next_sequence(), seq);
+}
+
+// ---- 按样本位置推入（变长包）----
+
+// 每帧 8 字节（2ch F32）
+constexpr std::size_t FRAME_BYTES = PAYLOAD_SIZE / FRAMES_PER_PACKET;
+
+aqua::jitter::JitterBuffer make_variable_jb(std::size_t max_payload_bytes, std::size_t headroom = 0)
+{
+    return aqua::jitter::JitterBuffer(make_test_format(), FRAMES_PER_PACKET, TARGET, CAPACITY,
+        aqua::config::JITTER_DETECT_WINDOW_PACKETS, aqua::config::JITTER_DRIFT_REBASE_LATE_COUNT,
+        std::nullopt, headroom, aqua::config::PlcMode::Repeat, max_payload_bytes);
+}
+
+TEST(JitterBufferTest, PushAtAssemblesVariableSizedPackets)
+{
+    auto jb = make_variable_jb(2 * PAYLOAD_SIZE);
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+
+    // 半块 + 1.5 块 + 1 块：跨块的包拆进两个 slot
+    jb.push_at(0, make_payload(1, 240 * FRAME_BYTES));
+    jb.push_at(240, make_payload(2, 720 * FRAME_BYTES));
+    jb.push_at(960, make_payload(3, 480 * FRAME_BYTES));
+    EXPECT_EQ(jb.buffer_fill_packets(), 3u);
+
+    EXPECT_TRUE(jb.pop_next(out));
+    EXPECT_TRUE(is_payload_of(std::span(out).first(PAYLOAD_SIZE / 2), 1));
+    EXPECT_TRUE(is_payload_of(std::span(out).subspan(PAYLOAD_SIZE / 2), 2));
+    EXPECT_TRUE(jb.pop_next(out));
+    EXPECT_TRUE(is_payload_of(out, 2));
+    EXPECT_TRUE(jb.pop_next(out));
+    EXPECT_TRUE(is_payload_of(out, 3));
+
+    EXPECT_EQ(jb.packets_received(), 3u);
+    EXPECT_EQ(jb.packets_lost(), 0u);
+    EXPECT_EQ(jb.malformed_packets(), 0u);
+}
+
+TEST(JitterBufferTest, PushAtPartialBlockConcealsMissingFrames)
+{
+    auto jb = make_variable_jb(PAYLOAD_SIZE);
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+
+    jb.push_at(0, make_payload(1));
+    jb.push_at(720, make_payload(2, 240 * FRAME_BYTES)); // 块 1 只到后半
+    EXPECT_TRUE(jb.pop_next(out));
+
+    // 前半为上一块的 PLC（增益 0.5），后半为真实帧；部分块不计丢包
+    EXPECT_FALSE(jb.pop_next(out));
+    std::vector<std::byte> plc(PAYLOAD_SIZE);
+    (void)jb.pop_next(plc); // 整块缺失：PLC 增益 0.25，计丢包
+    EXPECT_TRUE(is_plc_of(plc, 1, 0.25f));
+    EXPECT_TRUE(is_payload_of(std::span(out).subspan(PAYLOAD_SIZE / 2), 2));
+    // is_plc_of 按整块比较：把前半复制成一整块
+    std::vector<std::byte> head(out.begin(), out.begin() + PAYLOAD_SIZE / 2);
+    head.insert(head.end(), out.begin(), out.begin() + PAYLOAD_SIZE / 2);
+    EXPECT_TRUE(is_plc_of(head, 1, 0.5f));
+    EXPECT_EQ(jb.packets_lost(), 1u);
+}
+
+TEST(JitterBufferTest, PushAtClassifiesDuplicateAndLateByCoverage)
+{
+    auto jb = make_variable_jb(PAYLOAD_SIZE);
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+
+    jb.push_at(0, make_payload(1, 240 * FRAME_BYTES));
+    jb.push_at(0, make_payload(1, 240 * FRAME_BYTES)); // 帧全部已到：重复
+    EXPECT_EQ(jb.duplicates(), 1u);
+    jb.push_at(0, make_payload(1)); // 覆盖了新帧：不是重复
+    EXPECT_EQ(jb.duplicates(), 1u);
+    EXPECT_EQ(jb.buffer_fill_packets(), 1u);
+
+    EXPECT_TRUE(jb.pop_next(out));
+    EXPECT_TRUE(is_payload_of(out, 1));
+
+    // 整包已过播放时刻：late；跨过 next_pop 的包只存未播部分
+    jb.push_at(240, make_payload(2, 240 * FRAME_BYTES));
+    EXPECT_EQ(jb.late_packets(), 1u);
+    jb.push_at(240, make_payload(3, 480 * FRAME_BYTES));
+    EXPECT_EQ(jb.late_packets(), 1u);
+    EXPECT_FALSE(jb.pop_next(out)); // 块 1 只有前半
+    EXPECT_TRUE(is_payload_of(std::span(out).first(PAYLOAD_SIZE / 2), 3));
+}
+
+TEST(JitterBufferTest, PushAtUnwrapsSamplePosition)
+{
+    auto jb = make_variable_jb(PAYLOAD_SIZE);
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+
+    // 4294966560 = 480 的倍数；第三包的 uint32 位置回绕到 224，块号仍连续
+    std::uint32_t pos = 4294966560u;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        jb.push_at(pos, make_payload(10 + i));
+        pos += FRAMES_PER_PACKET;
+    }
+    EXPECT_EQ(jb.buffer_fill_packets(), 4u);
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(jb.pop_next(out)) << i;
+        EXPECT_TRUE(is_payload_of(out, 10 + i)) << i;
+    }
+    EXPECT_EQ(jb.packets_lost(), 0u);
+    EXPECT_EQ(jb.rebases(), 0u);
+}
+
+TEST(JitterBufferTest, PushAtRejectsInvalidSizes)
+{
+    constexpr std::size_t HEADROOM = 15;
+    auto jb = make_variable_jb(2 * PAYLOAD_SIZE, HEADROOM);
+    EXPECT_EQ(jb.receive_buffer().size(), HEADROOM + 2 * PAYLOAD_SIZE);
+
+    jb.push_at(0, { });
+    jb.push_at(0, make_payload(1, FRAME_BYTES + 1)); // 非整帧
+    jb.push_at(0, make_payload(1, 2 * PAYLOAD_SIZE + FRAME_BYTES)); // 超过上限
+    EXPECT_EQ(jb.malformed_packets(), 3u);
+    EXPECT_EQ(jb.packets_received(), 0u);
+
+    // 上限不足一块：构造即拒绝
+    EXPECT_THROW(make_variable_jb(PAYLOAD_SIZE - FRAME_BYTES), std::invalid_argument);
+}
+
 // ---- reset 测试 ----
 
 TEST(JitterBufferTest, ResetClearsPlayoutStateButNotStatistics)
@@ -1102,3 +1350,63 @@ TEST(JitterBufferTest, AdaptiveTargetLowersAfterCleanWindows)
     EXPECT_EQ(*before - *after, std::chrono::milliseconds(10));
     EXPECT_EQ(jb.rebases(), 0u);
 }
+
+// ---- 出队节拍速率 / 到达延迟（时钟漂移补偿）----
+
+TEST(JitterBufferTest, PlayoutRateScalesDeadlineCadence)
+{
+    using aqua::jitter::SimClock;
+    aqua::jitter::BasicJitterBuffer<SimClock> jb(make_test_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+
+    SimClock::advance(std::chrono::seconds(1));
+    jb.push(0, make_payload(0));
+    jb.set_playout_rate(1.001);
+    EXPECT_DOUBLE_EQ(jb.playout_rate(), 1.001);
+    const auto first = *jb.next_playout_deadline();
+
+    // 1000 拍：每拍 10ms / 1.001，Q32 累加无舍入漂移
+    for (std::uint32_t s = 1; s <= 1000; ++s) {
+        jb.push(s, make_payload(s));
+        SimClock::set(*jb.next_playout_deadline());
+        (void)jb.pop_next(out);
+    }
+    const auto elapsed = *jb.next_playout_deadline() - first;
+    EXPECT_NEAR(static_cast<double>(std::chrono::nanoseconds(elapsed).count()), 10e9 / 1.001, 1.0);
+
+    // 钳到 1 ± DRIFT_COMP_MAX_PPM
+    jb.set_playout_rate(2.0);
+    EXPECT_DOUBLE_EQ(jb.playout_rate(), 1.0 + aqua::config::DRIFT_COMP_MAX_PPM * 1e-6);
+}
+
+TEST(JitterBufferTest, ArrivalDelayFollowsSenderClockOffset)
+{
+    using aqua::jitter::SimClock;
+    aqua::jitter::BasicJitterBuffer<SimClock> jb(make_test_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    std::vector<std::byte> out(PAYLOAD_SIZE);
+
+    // 发送端慢 1000ppm：包间隔 10.01ms，出队按名义 10ms → 每包到达延迟增加 10us
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    constexpr std::uint32_t PACKETS = 1000;
+    for (std::uint32_t s = 0; s < PACKETS; ++s) {
+        const auto arrival = t0 + std::chrono::microseconds(10'010) * s;
+        while (jb.next_playout_deadline() && *jb.next_playout_deadline() <= arrival) {
+            SimClock::set(*jb.next_playout_deadline());
+            (void)jb.pop_next(out);
+        }
+        SimClock::set(arrival);
+        jb.push(s, make_payload(s));
+    }
+    EXPECT_EQ(jb.timeline_epoch(), 1u);
+    EXPECT_EQ(jb.rebases(), 0u);
+    // EWMA（1/256）滞后约 255 包：10ms × (999 − 255) / 1000 ≈ 7.4ms
+    EXPECT_NEAR(jb.mean_arrival_delay_ms(), 7.4, 0.3);
+
+    // 断流后时间线重建：epoch 递增，延迟基准归零
+    SimClock::advance(std::chrono::seconds(2));
+    (void)jb.pop_next(out);
+    jb.push(PACKETS + 500, make_payload(PACKETS + 500));
+    EXPECT_EQ(jb.timeline_epoch(), 2u);
+    EXPECT_NEAR(jb.mean_arrival_delay_ms(), 0.0, 1e-6);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "core/loadgen/load_generator.h"
+#include "core/loadgen/receive_stats.h"
+
+using aqua::loadgen::DeliveryReference;
+using aqua::loadgen::ReceiveStats;
+
+namespace {
+
+constexpr std::uint32_t kRate = 48000;
+constexpr std::uint32_t kFrames = 144; // 3ms @ 48kHz
+constexpr std::int64_t kPeriodNs = 3'000'000;
+
+} // namespace
+
+TEST(LoadgenStatsTest, SequenceGapCountsAsLoss)
+{
+    ReceiveStats stats(kRate);
+    for (std::uint32_t seq : { 10u, 11u, 14u, 15u }) {
+        stats.record(seq, seq * kFrames, 576, seq * kPeriodNs, 0);
+    }
+    const auto s = stats.snapshot();
+    EXPECT_EQ(s.received, 4u);
+    EXPECT_EQ(s.lost, 2u); // 12、13
+    EXPECT_EQ(s.reordered, 0u);
+    EXPECT_EQ(s.bytes, 4u * 576);
+}
+
+TEST(LoadgenStatsTest, LateArrivalIsReorderNotLoss)
+{
+    ReceiveStats stats(kRate);
+    stats.record(1, 1 * kFrames, 576, 1 * kPeriodNs, 0);
+    stats.record(3, 3 * kFrames, 576, 3 * kPeriodNs, 0);
+    stats.record(2, 2 * kFrames, 576, 3 * kPeriodNs + 100, 0);
+    const auto s = stats.snapshot();
+    EXPECT_EQ(s.lost, 0u);
+    EXPECT_EQ(s.reordered, 1u);
+    EXPECT_EQ(s.duplicated, 0u);
+}
+
+TEST(LoadgenStatsTest, DuplicateAfterGapDoesNotHideLoss)
+{
+    ReceiveStats stats(kRate);
+    for (std::uint32_t seq : { 1u, 2u, 5u, 5u, 2u }) {
+        stats.record(seq, seq * kFrames, 576, seq * kPeriodNs, 0);
+    }
+    auto s = stats.snapshot();
+    EXPECT_EQ(s.lost, 2u); // 3、4 仍缺
+    EXPECT_EQ(s.reordered, 0u);
+    EXPECT_EQ(s.duplicated, 2u);
+
+    // 缺失序号迟到补回一个；再重复一次不得二次扣减
+    stats.record(3, 3 * kFrames, 576, 6 * kPeriodNs, 0);
+    stats.record(3, 3 * kFrames, 576, 6 * kPeriodNs, 0);
+    s = stats.snapshot();
+    EXPECT_EQ(s.lost, 1u);
+    EXPECT_EQ(s.reordered, 1u);
+    EXPECT_EQ(s.duplicated, 3u);
+}
+
+TEST(LoadgenStatsTest, LateArrivalBeyondWindowKeepsLoss)
+{
+    ReceiveStats stats(kRate);
+    stats.record(0, 0, 576, 0, 0);
+    stats.record(200, 200 * kFrames, 576, 200 * kPeriodNs, 0); // 1..199 缺失
+    stats.record(1, 1 * kFrames, 576, 201 * kPeriodNs, 0); // 超出窗口，无法判重
+    const auto s = stats.snapshot();
+    EXPECT_EQ(s.lost, 199u);
+    EXPECT_EQ(s.reordered, 1u);
+    EXPECT_EQ(s.duplicated, 0u);
+}
+
+TEST(LoadgenStatsTest, SequenceWrapIsNotLoss)
+{
+    ReceiveStats stats(kRate);
+    stats.record(0xFFFFFFFEu, 0, 576, 0, 0);
+    stats.record(0xFFFFFFFFu, kFrames, 576, kPeriodNs, 0);
+    stats.record(0u, 2 * kFrames, 576, 2 * kPeriodNs, 0);
+    EXPECT_EQ(stats.snapshot().lost, 0u);
+}
+
+TEST(LoadgenStatsTest, JitterZeroOnPerfectPacingAndGrowsWithVariance)
+{
+    ReceiveStats steady(kRate);
+    for (std::uint32_t i = 0; i < 100; ++i) {
+        steady.record(i, i * kFrames, 576, i * kPeriodNs, 0);
+    }
+    EXPECT_NEAR(steady.snapshot().jitter_ms, 0.0, 1e-3);
+
+    // 到达时刻交替 ±1ms：|D| 恒为 2ms，EWMA 收敛到 2ms
+    ReceiveStats noisy(kRate);
+    for (std::uint32_t i = 0; i < 500; ++i) {
+        const std::int64_t wobble = (i % 2 == 0) ? 1'000'000 : -1'000'000;
+        noisy.record(i, i * kFrames, 576, i * kPeriodNs + wobble, 0);
+    }
+    EXPECT_NEAR(noisy.snapshot().jitter_ms, 2.0, 0.05);
+}
+
+TEST(LoadgenStatsTest, WindowOffsetAveragesAndResets)
+{
+    ReceiveStats stats(kRate);
+    EXPECT_FALSE(stats.take_window_offset_ms().has_value());
+    stats.record(0, 0, 576, 0, 1'000'000);
+    stats.record(1, kFrames, 576, kPeriodNs, 3'000'000);
+    const auto offset = stats.take_window_offset_ms();
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_NEAR(*offset, 2.0, 1e-6);
+    EXPECT_FALSE(stats.take_window_offset_ms().has_value());
+}
+
+TEST(LoadgenStatsTest, DeliveryReferenceMeasuresCrossSessionSkew)
+{
+    DeliveryReference ref(kRate);
+    // 首包确立基准：偏移 0
+    EXPECT_EQ(ref.offset_ns(1000, 5'000'000), 0);
+    // 同一 sample_position 晚 2ms 到达另一会话：偏移 2ms
+    EXPECT_EQ(ref.offset_ns(1000, 7'000'000), 2'000'000);
+    // 后续包按标称速率推进：准点到达偏移为 0
+    EXPECT_EQ(ref.offset_ns(1000 + kFrames, 5'000'000 + kPeriodNs), 0);
+}
+
+TEST(LoadgenStatsTest, PercentileNearestRank)
+{
+    std::vector<double> v { 5, 1, 4, 2, 3, 6, 7, 8, 9, 10 };
+    EXPECT_DOUBLE_EQ(aqua::loadgen::percentile(v, 0.0), 1.0);
+    EXPECT_DOUBLE_EQ(aqua::loadgen::percentile(v, 0.5), 5.0);
+    EXPECT_DOUBLE_EQ(aqua::loadgen::percentile(v, 0.9), 9.0);
+    EXPECT_DOUBLE_EQ(aqua::loadgen::percentile(v, 1.0), 10.0);
+    EXPECT_DOUBLE_EQ(aqua::loadgen::percentile({ }, 0.5), 0.0);
+}
+
+TEST(LoadgenStatsTest, RunRejectsInvalidServerAddress)
+{
+    aqua::loadgen::LoadGenerator generator;
+    aqua::loadgen::LoadGenConfig cfg;
+    cfg.server_ip = "not-an-ip";
+    bool reported = false;
+    EXPECT_FALSE(generator.run(cfg, [&](const aqua::loadgen::StepReport&) { reported = true; }));
+    EXPECT_FALSE(reported);
+    EXPECT_NE(generator.last_error().find("not-an-ip"), std::string::npos);
+}
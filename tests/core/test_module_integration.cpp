@@ -72,7 +72,7 @@ TEST(ModuleIntegrationTest, HelloHandshakeRouting)
     auto session_id = *session_id_opt;
 
     // server: 接收 HELLO -> establish -> 回 ACK
-    server_transport.start_receive([&](const auto& sender, auto data) {
+    const auto on_server_receive = [&](const auto& sender, auto data) {
         auto type = aqua::net::peek_type(data);
         ASSERT_TRUE(type.has_value());
         ASSERT_EQ(*type, aqua::net::PacketType::Hello);
@@ -89,12 +89,13 @@ TEST(ModuleIntegrationTest, HelloHandshakeRouting)
         std::array<std::byte, sizeof(aqua::net::HelloPacket)> ack_buf { };
         aqua::net::encode_hello_ack(session_id, ack_buf);
         server_transport.send(sender, ack_buf);
-    });
+    };
+    server_transport.start_receive(on_server_receive);
 
     // client: 接收 HELLO_ACK
     std::atomic<bool> ack_received { false };
     std::atomic<std::uint32_t> ack_session_id { 0 };
-    client_transport.start_receive([&](const auto& /*sender*/, auto data) {
+    const auto on_client_receive = [&](const auto& /*sender*/, auto data) {
         auto type = aqua::net::peek_type(data);
         if (type && *type == aqua::net::PacketType::HelloAck) {
             auto ack = aqua::net::decode_hello(data);
@@ -103,7 +104,8 @@ TEST(ModuleIntegrationTest, HelloHandshakeRouting)
                 ack_received.store(true, std::memory_order_relaxed);
             }
         }
-    });
+    };
+    client_transport.start_receive(on_client_receive);
 
     std::thread ioc_thread([&] { ioc.run(); });
 
@@ -152,16 +154,23 @@ TEST(ModuleIntegrationTest, BroadcastToMultipleClientsConsistency)
     std::vector<std::atomic<int>> recv_counts(NUM_CLIENTS);
     std::vector<std::vector<std::byte>> recv_data(NUM_CLIENTS);
 
+    // 接收回调是非拥有引用：每个 client 的 handler 存在预留好的 vector 里（不重新分配），存活至 io 线程 join
+    const auto make_handler = [&](int idx) {
+        return [&, idx](const auto& /*sender*/, auto data) {
+            recv_counts[idx].fetch_add(1, std::memory_order_relaxed);
+            recv_data[idx].assign(data.begin(), data.end());
+        };
+    };
+    std::vector<decltype(make_handler(0))> handlers;
+    handlers.reserve(NUM_CLIENTS);
+
     for (int i = 0; i < NUM_CLIENTS; ++i) {
         clients.push_back(std::make_unique<aqua::net::UdpTransport>(ioc));
         ASSERT_TRUE(clients.back()->bind("127.0.0.1", 0));
         client_eps.push_back(clients.back()->socket_local_endpoint());
 
-        int idx = i;
-        clients.back()->start_receive([&, idx](const auto& /*sender*/, auto data) {
-            recv_counts[idx].fetch_add(1, std::memory_order_relaxed);
-            recv_data[idx].assign(data.begin(), data.end());
-        });
+        handlers.push_back(make_handler(i));
+        clients.back()->start_receive(handlers.back());
     }
 
     aqua::SessionManager sessions;
@@ -218,8 +227,9 @@ TEST(ModuleIntegrationTest, BroadcastToMultipleClientsConsistency)
 TEST(ModuleIntegrationTest, DiagnosticsReadsJitterBufferState)
 {
     std::size_t rb_fill = 0;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
     aqua::diag::DiagnosticsManager dm(
-        48000, 8, PAYLOAD_SIZE, [&rb_fill]() { return rb_fill; }, PAYLOAD_SIZE * 16);
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, PAYLOAD_SIZE * 16);
 
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 4, 16);
 
@@ -347,13 +357,14 @@ TEST(ModuleIntegrationTest, RealUdpToJitterBuffer)
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 4, 16);
 
     std::atomic<int> pushed { 0 };
-    receiver.start_receive([&](const auto& /*sender*/, auto data) {
+    const auto on_receive = [&](const auto& /*sender*/, auto data) {
         auto decoded = aqua::net::decode_audio(data);
         if (decoded) {
             jb.push(decoded->header.sequence, decoded->payload);
             pushed.fetch_add(1, std::memory_order_relaxed);
         }
-    });
+    };
+    receiver.start_receive(on_receive);
 
     std::thread ioc_thread([&] { ioc.run(); });
 
@@ -584,8 +595,9 @@ TEST(ModuleIntegrationTest, DiagnosticsCapacityFieldsPopulated)
 {
     std::size_t rb_fill = 0;
     constexpr std::size_t RB_CAP = 8192;
+    const auto rb_fill_fn = [&rb_fill]() { return rb_fill; };
     aqua::diag::DiagnosticsManager dm(
-        48000, 8, PAYLOAD_SIZE, [&rb_fill]() { return rb_fill; }, RB_CAP);
+        48000, 8, PAYLOAD_SIZE, rb_fill_fn, RB_CAP);
 
     aqua::jitter::JitterBuffer jb(make_test_format(), FRAMES_PER_PACKET, 4, 16);
 
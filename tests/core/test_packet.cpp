@@ -184,6 +184,68 @@ TEST(PacketTest, HelloWireFormat)
     EXPECT_EQ(buf[4], std::byte { 0xFF });
 }
 
+TEST(PacketTest, EncodeDecodeHelloResume)
+{
+    std::array<std::byte, 32> buf { };
+    auto written = aqua::net::encode_hello_resume(0x12345678u, 0x0102030405060708ULL, buf);
+    ASSERT_EQ(written, sizeof(aqua::net::HelloResumePacket));
+    EXPECT_EQ(buf[0], std::byte { 0x01 }); // 仍是 Hello
+    EXPECT_EQ(buf[5], std::byte { 0x08 }); // token LE
+    EXPECT_EQ(buf[12], std::byte { 0x01 });
+
+    const std::span<const std::byte> wire { buf.data(), written };
+    auto token = aqua::net::decode_hello_resume_token(wire);
+    ASSERT_TRUE(token.has_value());
+    EXPECT_EQ(*token, 0x0102030405060708ULL);
+
+    // 不认识扩展字段的一方仍按普通 HELLO 解析
+    auto hello = aqua::net::decode_hello(wire);
+    ASSERT_TRUE(hello.has_value());
+    EXPECT_EQ(hello->session_id, 0x12345678u);
+
+    std::array<std::byte, 12> small { };
+    EXPECT_EQ(aqua::net::encode_hello_resume(1, 2, small), 0u);
+}
+
+TEST(PacketTest, PlainHelloHasNoResumeToken)
+{
+    std::array<std::byte, 32> buf { };
+    auto written = aqua::net::encode_hello(0x12345678u, buf);
+    EXPECT_FALSE(aqua::net::decode_hello_resume_token({ buf.data(), written }).has_value());
+
+    // HELLO_ACK 不携带令牌（即使长度足够）
+    written = aqua::net::encode_hello_resume(1, 2, buf);
+    buf[0] = std::byte { static_cast<uint8_t>(PacketType::HelloAck) };
+    EXPECT_FALSE(aqua::net::decode_hello_resume_token({ buf.data(), written }).has_value());
+}
+
+TEST(PacketTest, EncodeDecodeHelloAckRejoin)
+{
+    std::array<std::byte, 32> buf { };
+    auto written = aqua::net::encode_hello_ack_rejoin(0x12345679u, 0x0102030405060708ULL, buf);
+    ASSERT_EQ(written, sizeof(aqua::net::HelloResumePacket)); // 与扩展 HELLO 等长
+    EXPECT_EQ(buf[0], std::byte { static_cast<uint8_t>(PacketType::HelloAck) });
+
+    const std::span<const std::byte> wire { buf.data(), written };
+    auto token = aqua::net::decode_hello_ack_rejoin_token(wire);
+    ASSERT_TRUE(token.has_value());
+    EXPECT_EQ(*token, 0x0102030405060708ULL);
+    // 扩展 HELLO 的令牌解码不认 HELLO_ACK
+    EXPECT_FALSE(aqua::net::decode_hello_resume_token(wire).has_value());
+
+    // 旧客户端按普通 HELLO_ACK 解析出新 session_id
+    auto ack = aqua::net::decode_hello(wire);
+    ASSERT_TRUE(ack.has_value());
+    EXPECT_EQ(ack->session_id, 0x12345679u);
+
+    // 普通 HELLO_ACK 不携带令牌
+    written = aqua::net::encode_hello_ack(0x12345679u, buf);
+    EXPECT_FALSE(aqua::net::decode_hello_ack_rejoin_token({ buf.data(), written }).has_value());
+
+    std::array<std::byte, 12> small { };
+    EXPECT_EQ(aqua::net::encode_hello_ack_rejoin(1, 2, small), 0u);
+}
+
 TEST(PacketTest, DecodeHelloRejectsAudioType)
 {
     // 用 Audio type 字节解析 hello，应失败
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include "core/net/capture/packet_capture.h"
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using aqua::AudioEncoding;
+using aqua::AudioFormat;
+using aqua::net::CaptureInfo;
+using aqua::net::CaptureReader;
+using aqua::net::CaptureReplaySource;
+using aqua::net::CaptureWriter;
+
+namespace {
+
+const CaptureInfo kInfo { { AudioEncoding::PcmS16LE, 2, 48000 }, 0x1234ABCD };
+
+std::filesystem::path temp_path(const char* name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+std::vector<std::byte> datagram(std::size_t size, std::uint8_t tag)
+{
+    std::vector<std::byte> d(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        d[i] = static_cast<std::byte>(tag + i);
+    }
+    return d;
+}
+
+} // namespace
+
+TEST(PacketCaptureTest, WriteThenReadRoundTrip)
+{
+    const auto path = temp_path("aqua_test_capture_roundtrip.aqcap");
+    {
+        CaptureWriter writer(path.string(), 64 * 1024);
+        ASSERT_TRUE(writer.start(kInfo));
+        const auto t0 = std::chrono::steady_clock::now();
+        writer.record(datagram(15, 1), t0 + std::chrono::milliseconds(1));
+        writer.record(datagram(1167, 2), t0 + std::chrono::milliseconds(4));
+        writer.record(datagram(5, 3), t0 + std::chrono::milliseconds(4));
+        EXPECT_EQ(writer.recorded(), 3u);
+        writer.stop();
+    }
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(path.string()));
+    EXPECT_EQ(reader.info().format, kInfo.format);
+    EXPECT_EQ(reader.info().session_id, kInfo.session_id);
+
+    std::vector<std::byte> buf(2048);
+    const auto a = reader.next(buf);
+    ASSERT_TRUE(a.has_value());
+    EXPECT_EQ(a->size, 15u);
+    EXPECT_EQ(std::vector<std::byte>(buf.begin(), buf.begin() + 15), datagram(15, 1));
+
+    const auto b = reader.next(buf);
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(b->size, 1167u);
+    EXPECT_EQ(std::vector<std::byte>(buf.begin(), buf.begin() + 1167), datagram(1167, 2));
+    EXPECT_EQ(b->arrival_ns - a->arrival_ns, 3'000'000);
+
+    // 超出读缓冲的记录截断，后续记录不受影响
+    std::vector<std::byte> small(4);
+    const auto c = reader.next(small);
+    ASSERT_TRUE(c.has_value());
+    EXPECT_EQ(c->size, 4u);
+    EXPECT_EQ(c->arrival_ns, b->arrival_ns);
+    EXPECT_FALSE(reader.next(buf).has_value());
+
+    std::filesystem::remove(path);
+}
+
+TEST(PacketCaptureTest, FullRingDropsWholeRecords)
+{
+    const auto path = temp_path("aqua_test_capture_drop.aqcap");
+    {
+        // 1KiB 缓冲、刷盘线程 50ms 才醒：第一条占满后其余整条丢弃
+        CaptureWriter writer(path.string(), 1024);
+        ASSERT_TRUE(writer.start(kInfo));
+        const auto now = std::chrono::steady_clock::now();
+        writer.record(datagram(900, 1), now);
+        writer.record(datagram(900, 2), now);
+        writer.record(datagram(900, 3), now);
+        EXPECT_EQ(writer.recorded(), 1u);
+        EXPECT_EQ(writer.dropped(), 2u);
+        writer.stop();
+    }
+
+    CaptureReader reader;
+    ASSERT_TRUE(reader.open(path.string()));
+    std::vector<std::byte> buf(2048);
+    const auto a = reader.next(buf);
+    ASSERT_TRUE(a.has_value());
+    EXPECT_EQ(std::vector<std::byte>(buf.begin(), buf.begin() + 900), datagram(900, 1));
+    EXPECT_FALSE(reader.next(buf).has_value());
+
+    std::filesystem::remove(path);
+}
+
+TEST(PacketCaptureTest, ReaderRejectsForeignFiles)
+{
+    const auto path = temp_path("aqua_test_capture_bad.aqcap");
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "RIFF\x24\x00\x00\x00WAVEfmt ";
+    }
+    CaptureReader reader;
+    EXPECT_FALSE(reader.open(path.string()));
+    EXPECT_FALSE(reader.open(temp_path("aqua_test_capture_missing.aqcap").string()));
+    std::filesystem::remove(path);
+}
+
+TEST(PacketCaptureTest, ReplayPreservesRelativeTiming)
+{
+    const auto path = temp_path("aqua_test_capture_replay.aqcap");
+    {
+        CaptureWriter writer(path.string(), 64 * 1024);
+        ASSERT_TRUE(writer.start(kInfo));
+        const auto t0 = std::chrono::steady_clock::now() + std::chrono::seconds(2); // 绝对偏移不影响回放
+        writer.record(datagram(16, 1), t0);
+        writer.record(datagram(16, 2), t0 + std::chrono::milliseconds(30));
+        writer.record(datagram(16, 3), t0 + std::chrono::milliseconds(30));
+        writer.record(datagram(16, 4), t0 + std::chrono::milliseconds(80));
+        writer.stop();
+    }
+
+    asio::io_context ioc;
+    CaptureReplaySource source(ioc);
+    ASSERT_TRUE(source.open(path.string()));
+    EXPECT_EQ(source.info().session_id, kInfo.session_id);
+
+    // 提供方缓冲只有 8 字节：记录被拷入并截断，与 UdpTransport 行为一致
+    std::array<std::byte, 8> provided { };
+    const auto provide = [&] { return std::span<std::byte>(provided); };
+    source.set_receive_buffer_provider(provide);
+
+    std::vector<std::chrono::steady_clock::time_point> times;
+    std::vector<std::vector<std::byte>> payloads;
+    const auto on_datagram = [&](const asio::ip::udp::endpoint&, std::span<const std::byte> data) {
+        EXPECT_EQ(data.data(), provided.data());
+        times.push_back(std::chrono::steady_clock::now());
+        payloads.emplace_back(data.begin(), data.end());
+    };
+    source.start(on_datagram);
+    ioc.run(); // 全部投递后无待处理任务，自然返回
+
+    EXPECT_TRUE(source.finished());
+    EXPECT_EQ(source.replayed(), 4u);
+    ASSERT_EQ(times.size(), 4u);
+    const auto last = datagram(16, 4);
+    EXPECT_EQ(payloads[3], std::vector<std::byte>(last.begin(), last.begin() + 8));
+    EXPECT_GE(times[1] - times[0], std::chrono::milliseconds(30));
+    EXPECT_LT(times[2] - times[1], std::chrono::milliseconds(10));
+    EXPECT_GE(times[3] - times[0], std::chrono::milliseconds(80));
+    EXPECT_LT(times[3] - times[0], std::chrono::milliseconds(300));
+
+    std::filesystem::remove(path);
+}
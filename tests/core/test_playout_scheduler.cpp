@@ -0,0 +1,114 @@
+#include "core/client/playout_scheduler.h"
+#include "core/diagnostics/lateness_histogram.h"
+#include "core/public/config.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// ---- LatenessHistogram ----
+
+TEST(LatenessHistogramTest, PercentilesPerInterval)
+{
+    aqua::diag::LatenessHistogram h;
+    EXPECT_EQ(h.take_interval().wakeups, 0u);
+
+    // 990 次 ~10us、9 次 ~1ms、1 次 30ms（溢出桶）
+    for (int i = 0; i < 990; ++i) {
+        h.record(10us);
+    }
+    for (int i = 0; i < 9; ++i) {
+        h.record(1010us);
+    }
+    h.record(30ms);
+
+    const auto p = h.take_interval();
+    EXPECT_EQ(p.wakeups, 1000u);
+    EXPECT_DOUBLE_EQ(p.p50_us, 25.0); // 桶上界
+    EXPECT_DOUBLE_EQ(p.p99_us, 25.0);
+    EXPECT_DOUBLE_EQ(p.p999_us, 1025.0);
+    EXPECT_DOUBLE_EQ(p.max_us, 30000.0);
+
+    // 下一区间只含新样本；提前唤醒按 0 计
+    h.record(-5us);
+    h.record(200us);
+    const auto q = h.take_interval();
+    EXPECT_EQ(q.wakeups, 2u);
+    EXPECT_DOUBLE_EQ(q.p50_us, 25.0);
+    EXPECT_DOUBLE_EQ(q.max_us, 200.0);
+    EXPECT_LE(q.p99_us, q.max_us);
+}
+
+// ---- PlayoutScheduler ----
+
+TEST(PlayoutSchedulerTest, WakesAtAbsoluteDeadlines)
+{
+    using clock = aqua::client::PlayoutScheduler::clock;
+    constexpr auto PERIOD = 3ms;
+    constexpr int TICKS = 40;
+
+    std::vector<clock::time_point> wakeups;
+    std::vector<std::chrono::nanoseconds> lateness;
+    std::atomic<int> ticks { 0 };
+    clock::time_point origin { };
+
+    const auto tick = [&](clock::time_point now) -> std::optional<clock::time_point> {
+        if (origin == clock::time_point { }) {
+            origin = now;
+        }
+        wakeups.push_back(now);
+        ++ticks;
+        return origin + PERIOD * static_cast<int>(wakeups.size());
+    };
+    const auto on_lateness = [&](std::chrono::nanoseconds late) { lateness.push_back(late); };
+    aqua::client::PlayoutScheduler scheduler(tick, on_lateness);
+
+    scheduler.start();
+    EXPECT_TRUE(scheduler.is_running());
+    while (ticks.load() < TICKS) {
+        std::this_thread::sleep_for(1ms);
+    }
+    scheduler.stop();
+    EXPECT_FALSE(scheduler.is_running());
+
+    // 每次唤醒都不早于请求时刻；绝对 deadline 使 tick 间隔不累积漂移
+    ASSERT_GE(wakeups.size(), static_cast<std::size_t>(TICKS));
+    for (std::size_t i = 1; i < wakeups.size(); ++i) {
+        EXPECT_GE(wakeups[i], origin + PERIOD * static_cast<int>(i));
+    }
+    const auto span = wakeups[TICKS - 1] - origin;
+    EXPECT_GE(span, PERIOD * (TICKS - 1));
+    EXPECT_LT(span, PERIOD * (TICKS - 1) + 50ms);
+
+    // 按 deadline 的唤醒全部上报迟到（首次 tick 没有请求时刻）
+    ASSERT_GE(lateness.size(), static_cast<std::size_t>(TICKS - 1));
+    for (const auto late : lateness) {
+        EXPECT_GE(late.count(), 0);
+    }
+}
+
+TEST(PlayoutSchedulerTest, IdlePollsWithoutLatenessAndStopsPromptly)
+{
+    std::atomic<int> ticks { 0 };
+    std::atomic<int> lateness_reports { 0 };
+    const auto tick = [&](aqua::client::PlayoutScheduler::clock::time_point) {
+        ++ticks;
+        return std::optional<aqua::client::PlayoutScheduler::clock::time_point> { };
+    };
+    const auto on_lateness = [&](std::chrono::nanoseconds) { ++lateness_reports; };
+    aqua::client::PlayoutScheduler scheduler(tick, on_lateness);
+
+    scheduler.start();
+    std::this_thread::sleep_for(aqua::config::PLAYOUT_SCHEDULER_IDLE_INTERVAL * 10);
+    const auto stop_begin = std::chrono::steady_clock::now();
+    scheduler.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - stop_begin, 100ms);
+
+    EXPECT_GE(ticks.load(), 3);
+    EXPECT_EQ(lateness_reports.load(), 0);
+}
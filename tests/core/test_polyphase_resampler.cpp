@@ -0,0 +1,162 @@
+#include "core/audio/dsp/cpu_features.h"
+#include "core/audio/dsp/polyphase_resampler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using aqua::audio::dsp::PolyphaseResampler;
+using aqua::audio::dsp::SimdLevel;
+namespace dsp = aqua::audio::dsp;
+
+constexpr std::size_t CHUNK = 480;
+
+// 交织立体声正弦：左声道 freq、右声道反相。
+std::vector<float> stereo_sine(double freq, std::uint32_t rate, std::size_t frames)
+{
+    std::vector<float> v(frames * 2);
+    for (std::size_t i = 0; i < frames; ++i) {
+        const auto s = static_cast<float>(0.5 * std::sin(2.0 * std::numbers::pi * freq * i / rate));
+        v[i * 2] = s;
+        v[i * 2 + 1] = -s;
+    }
+    return v;
+}
+
+// 以 chunks 给出的块大小（循环使用）逐块喂入，收集全部输出。
+std::vector<float> run(PolyphaseResampler& rs, const std::vector<float>& in, std::uint32_t channels,
+    const std::vector<std::size_t>& chunks)
+{
+    std::vector<float> out;
+    std::vector<float> buf(rs.max_output_frames() * channels);
+    std::size_t pos = 0;
+    for (std::size_t k = 0; pos < in.size() / channels; ++k) {
+        const std::size_t n = std::min(chunks[k % chunks.size()], in.size() / channels - pos);
+        const auto got = rs.process(std::span<const float> { in }.subspan(pos * channels, n * channels), buf);
+        out.insert(out.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(got * channels));
+        pos += n;
+    }
+    return out;
+}
+
+double rms(std::span<const float> v)
+{
+    double sum = 0.0;
+    for (const auto x : v) {
+        sum += static_cast<double>(x) * x;
+    }
+    return std::sqrt(sum / static_cast<double>(v.size()));
+}
+
+} // namespace
+
+TEST(PolyphaseResamplerTest, ReducesRatioAndSizesFilter)
+{
+    PolyphaseResampler up(2, 44100, 48000, CHUNK);
+    EXPECT_EQ(up.interpolation(), 160u);
+    EXPECT_EQ(up.decimation(), 147u);
+    EXPECT_EQ(up.taps(), PolyphaseResampler::BASE_TAPS);
+    EXPECT_DOUBLE_EQ(up.delay_frames(), 16.0 * 160.0 / 147.0);
+
+    // 降采样：截止随输出 Nyquist 收窄，抽头加长
+    PolyphaseResampler down(2, 96000, 48000, CHUNK);
+    EXPECT_EQ(down.interpolation(), 1u);
+    EXPECT_EQ(down.decimation(), 2u);
+    EXPECT_EQ(down.taps(), 64u);
+    EXPECT_EQ(down.max_output_frames(), CHUNK / 2 + 2);
+}
+
+TEST(PolyphaseResamplerTest, SineSurvivesRateConversion)
+{
+    struct Case {
+        std::uint32_t in_rate;
+        std::uint32_t out_rate;
+    };
+    for (const auto c : { Case { 44100, 48000 }, Case { 48000, 44100 }, Case { 48000, 96000 }, Case { 96000, 48000 } }) {
+        PolyphaseResampler rs(2, c.in_rate, c.out_rate, CHUNK);
+        const auto in = stereo_sine(1000.0, c.in_rate, c.in_rate / 2);
+        const auto out = run(rs, in, 2, { CHUNK });
+
+        // 输出点 n 对应输入时刻 n / out_rate（无相移）；跳过开头静音邻域的过渡段
+        double max_err = 0.0;
+        for (std::size_t n = 200; n < out.size() / 2; ++n) {
+            const double expected = 0.5 * std::sin(2.0 * std::numbers::pi * 1000.0 * n / c.out_rate);
+            max_err = std::max(max_err, std::abs(out[n * 2] - expected));
+            max_err = std::max(max_err, std::abs(out[n * 2 + 1] + expected));
+        }
+        EXPECT_LT(max_err, 1e-3) << c.in_rate << " -> " << c.out_rate;
+
+        // 输出帧数 = 输入帧数 × L / M 减去固定延迟
+        const double ideal = static_cast<double>(in.size() / 2) * c.out_rate / c.in_rate;
+        EXPECT_NEAR(static_cast<double>(out.size() / 2), ideal - rs.delay_frames(), 1.5)
+            << c.in_rate << " -> " << c.out_rate;
+    }
+}
+
+TEST(PolyphaseResamplerTest, DownsamplingRejectsAliases)
+{
+    // 96kHz 下 30kHz 正弦高于 48kHz 输出的 Nyquist，应被抗混叠滤除
+    PolyphaseResampler rs(2, 96000, 48000, CHUNK);
+    const auto out = run(rs, stereo_sine(30000.0, 96000, 48000), 2, { CHUNK });
+    EXPECT_LT(rms(std::span<const float> { out }.subspan(400)), 1e-3);
+}
+
+TEST(PolyphaseResamplerTest, OutputIndependentOfChunking)
+{
+    const auto in = stereo_sine(440.0, 44100, 10000);
+    PolyphaseResampler a(2, 44100, 48000, CHUNK);
+    PolyphaseResampler b(2, 44100, 48000, CHUNK);
+    const auto whole = run(a, in, 2, { CHUNK });
+    const auto pieces = run(b, in, 2, { 1, 7, 480, 33, 0, 129 });
+    EXPECT_EQ(whole, pieces);
+
+    // reset 后从静音邻域重新开始，与新实例一致
+    a.reset();
+    PolyphaseResampler fresh(2, 44100, 48000, CHUNK);
+    EXPECT_EQ(run(a, in, 2, { CHUNK }), run(fresh, in, 2, { CHUNK }));
+}
+
+TEST(PolyphaseResamplerTest, SimdLevelsMatchScalar)
+{
+    std::vector<float> in(3001 * 2);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (auto& x : in) {
+        x = dist(rng);
+    }
+    PolyphaseResampler scalar(2, 44100, 48000, CHUNK, SimdLevel::Scalar);
+    const auto ref = run(scalar, in, 2, { CHUNK });
+    for (const auto level : { SimdLevel::Sse2, SimdLevel::Avx2, SimdLevel::Neon }) {
+        if (!dsp::simd_level_supported(level)) {
+            continue;
+        }
+        PolyphaseResampler rs(2, 44100, 48000, CHUNK, level);
+        const auto out = run(rs, in, 2, { CHUNK });
+        ASSERT_EQ(out.size(), ref.size());
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            ASSERT_NEAR(out[i], ref[i], 1e-6f) << dsp::simd_level_name(level) << " sample " << i;
+        }
+    }
+}
+
+TEST(PolyphaseResamplerTest, TruncatesToOutputRoomAndRejectsBadRatios)
+{
+    PolyphaseResampler rs(1, 48000, 96000, CHUNK);
+    std::vector<float> in(CHUNK, 0.25f);
+    std::vector<float> small(10);
+    EXPECT_EQ(rs.process(in, small), 10u);
+
+    EXPECT_TRUE(PolyphaseResampler::supports(44100, 192000));
+    EXPECT_FALSE(PolyphaseResampler::supports(44100, 48001));
+    EXPECT_FALSE(PolyphaseResampler::supports(0, 48000));
+    EXPECT_THROW(PolyphaseResampler(2, 44100, 48001, CHUNK), std::invalid_argument);
+    EXPECT_THROW(PolyphaseResampler(0, 44100, 48000, CHUNK), std::invalid_argument);
+    EXPECT_THROW(PolyphaseResampler(2, 44100, 48000, 0), std::invalid_argument);
+}
@@ -0,0 +1,310 @@
+#include "core/audio/dsp/format_converter.h"
+#include "core/client/pull_playout.h"
+#include "core/jitter_buffer/ingress_queue.h"
+#include "core/jitter_buffer/jitter_buffer.h"
+#include "core/jitter_buffer/sim_clock.h"
+#include "core/public/audio_format.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using aqua::jitter::IngressQueue;
+using aqua::jitter::SimClock;
+using PullPlayout = aqua::client::BasicPullPlayout<SimClock>;
+using JitterBuffer = aqua::jitter::BasicJitterBuffer<SimClock>;
+
+// 48kHz, 2ch, F32LE；10ms 一包
+aqua::AudioFormat make_server_format()
+{
+    aqua::AudioFormat fmt;
+    fmt.encoding = aqua::AudioEncoding::PcmF32LE;
+    fmt.channels = 2;
+    fmt.sample_rate = 48000;
+    return fmt;
+}
+
+constexpr std::uint32_t FRAMES_PER_PACKET = 480;
+constexpr std::size_t PAYLOAD_SIZE = FRAMES_PER_PACKET * 2 * 4;
+constexpr std::chrono::milliseconds PACKET_DURATION { 10 };
+constexpr std::size_t TARGET = 3;
+constexpr std::size_t CAPACITY = 16;
+
+// 第 index 个包：所有样本 = (index + 1) / 1000（非零，便于与静音区分）
+std::vector<std::byte> make_packet(std::uint32_t index)
+{
+    std::vector<float> samples(FRAMES_PER_PACKET * 2, static_cast<float>(index + 1) / 1000.0f);
+    std::vector<std::byte> payload(PAYLOAD_SIZE);
+    std::memcpy(payload.data(), samples.data(), PAYLOAD_SIZE);
+    return payload;
+}
+
+std::chrono::nanoseconds since_epoch(SimClock::time_point t)
+{
+    return t.time_since_epoch();
+}
+
+// 发送端：每 10ms 一包，按到达时刻排入入口队列（模拟 io 线程）。
+struct Sender {
+    IngressQueue& ingress;
+    SimClock::time_point t0;
+    std::uint32_t next = 0;
+
+    void deliver_until(SimClock::time_point t)
+    {
+        while (t0 + PACKET_DURATION * next <= t) {
+            const auto payload = make_packet(next);
+            ASSERT_TRUE(ingress.push(since_epoch(t0 + PACKET_DURATION * next), next * FRAMES_PER_PACKET, payload));
+            ++next;
+        }
+    }
+};
+
+} // namespace
+
+// ---- IngressQueue ----
+
+TEST(IngressQueueTest, DropsWhenFullAndDrainsInOrder)
+{
+    IngressQueue q(4, 8, 16);
+    EXPECT_EQ(q.capacity(), 4u);
+    const std::vector<std::byte> payload(16, std::byte { 0x5A });
+
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(q.push(std::chrono::nanoseconds(i), i * 100, payload));
+    }
+    EXPECT_EQ(q.size(), 4u);
+    // 队满：接收缓冲改指向溢出区，push 丢弃并计数，已排队的包不受影响
+    EXPECT_EQ(q.receive_buffer().size(), 24u);
+    EXPECT_FALSE(q.push(std::chrono::nanoseconds(4), 400, payload));
+    EXPECT_EQ(q.dropped(), 1u);
+
+    std::vector<std::uint32_t> positions;
+    EXPECT_EQ(q.drain([&](const IngressQueue::Entry& e) {
+        EXPECT_EQ(e.arrival.count(), static_cast<std::int64_t>(positions.size()));
+        EXPECT_EQ(e.payload.size(), 16u);
+        EXPECT_EQ(e.payload[0], std::byte { 0x5A });
+        positions.push_back(e.sample_position);
+    }),
+        4u);
+    EXPECT_EQ(positions, (std::vector<std::uint32_t> { 0, 100, 200, 300 }));
+    EXPECT_EQ(q.size(), 0u);
+
+    // 释放后可继续排队（槽回绕）
+    EXPECT_TRUE(q.push(std::chrono::nanoseconds(5), 500, payload));
+    EXPECT_EQ(q.size(), 1u);
+}
+
+TEST(IngressQueueTest, ReceiveBufferPayloadIsZeroCopy)
+{
+    IngressQueue q(2, 8, 16);
+    const auto buf = q.receive_buffer();
+    ASSERT_EQ(buf.size(), 24u);
+    std::memset(buf.data(), 0x11, buf.size());
+    const auto payload = buf.subspan(8, 12);
+
+    ASSERT_TRUE(q.push(std::chrono::nanoseconds(1), 7, payload));
+    // 下一个接收缓冲是另一个槽
+    EXPECT_NE(q.receive_buffer().data(), buf.data());
+    q.drain([&](const IngressQueue::Entry& e) {
+        EXPECT_EQ(e.payload.data(), payload.data());
+        EXPECT_EQ(e.payload.size(), 12u);
+        EXPECT_EQ(e.sample_position, 7u);
+    });
+}
+
+TEST(IngressQueueTest, RejectsEmptyAndOversizedPayloads)
+{
+    EXPECT_THROW(IngressQueue(0, 8, 16), std::invalid_argument);
+    EXPECT_THROW(IngressQueue(4, 8, 0), std::invalid_argument);
+
+    IngressQueue q(4, 0, 16);
+    const std::vector<std::byte> big(17);
+    EXPECT_FALSE(q.push(std::chrono::nanoseconds(0), 0, big));
+    EXPECT_FALSE(q.push(std::chrono::nanoseconds(0), 0, { }));
+    EXPECT_EQ(q.dropped(), 2u);
+    EXPECT_EQ(q.size(), 0u);
+}
+
+// ---- PullPlayout ----
+
+TEST(PullPlayoutTest, SilentUntilFirstDeadlineWithoutUnderrun)
+{
+    JitterBuffer jb(make_server_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    IngressQueue ingress(64, 0, PAYLOAD_SIZE);
+    PullPlayout playout(jb, ingress, make_server_format(), make_server_format(), FRAMES_PER_PACKET, nullptr, nullptr, 1);
+    std::vector<std::byte> out(256 * 8);
+
+    // 尚无包：静音，不计欠载
+    SimClock::advance(std::chrono::seconds(1));
+    auto r = playout.fill(out);
+    EXPECT_EQ(r.bytes, 0u);
+    EXPECT_FALSE(r.underrun);
+    EXPECT_FALSE(playout.started());
+
+    // 首包到达，但首块 deadline（起播缓冲 = JB target）未到
+    Sender sender { ingress, SimClock::now() };
+    sender.deliver_until(SimClock::now());
+    r = playout.fill(out);
+    EXPECT_EQ(r.bytes, 0u);
+    EXPECT_FALSE(r.underrun);
+    EXPECT_FALSE(playout.started());
+    EXPECT_EQ(ingress.size(), 0u); // 已在播放线程入 JB
+    EXPECT_EQ(jb.packets_received(), 1u);
+}
+
+TEST(PullPlayoutTest, StreamIsContinuousAcrossUnalignedCallbacks)
+{
+    JitterBuffer jb(make_server_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    IngressQueue ingress(64, 0, PAYLOAD_SIZE);
+    PullPlayout playout(jb, ingress, make_server_format(), make_server_format(), FRAMES_PER_PACKET, nullptr, nullptr, 1);
+
+    // 设备回调 300 帧（6.25ms），与 480 帧的包不对齐
+    constexpr std::size_t CALLBACK_FRAMES = 300;
+    const auto callback_period = std::chrono::nanoseconds(CALLBACK_FRAMES * 1'000'000'000 / 48000);
+    std::vector<std::byte> out(CALLBACK_FRAMES * 8);
+    std::vector<float> played;
+
+    SimClock::advance(std::chrono::seconds(1));
+    Sender sender { ingress, SimClock::now() };
+    std::uint32_t misses = 0;
+    std::uint32_t underruns = 0;
+    for (int i = 0; i < 320; ++i) { // 2s
+        sender.deliver_until(SimClock::now());
+        const auto r = playout.fill(out);
+        misses += r.deadline_misses;
+        underruns += r.underrun ? 1 : 0;
+        if (playout.started()) {
+            EXPECT_EQ(r.bytes, out.size());
+        }
+        const auto* samples = reinterpret_cast<const float*>(out.data());
+        played.insert(played.end(), samples, samples + r.bytes / 4);
+        SimClock::advance(callback_period);
+    }
+    EXPECT_TRUE(playout.started());
+    EXPECT_EQ(misses, 0u);
+    EXPECT_EQ(underruns, 0u);
+
+    // 样本按包序连续：第 k 个 960 样本段全为 (k + 1) / 1000
+    ASSERT_GT(played.size(), 100u * FRAMES_PER_PACKET * 2);
+    for (std::size_t s = 0; s < played.size(); ++s) {
+        const auto packet = static_cast<float>(s / (FRAMES_PER_PACKET * 2));
+        ASSERT_FLOAT_EQ(played[s], (packet + 1.0f) / 1000.0f) << "sample " << s;
+    }
+    // 起播前静音约为 JB target（3 包）
+    EXPECT_NEAR(static_cast<double>(played.size()) / 2 / 48000, 2.0 - 0.03, 0.02);
+    // 每块恰在 deadline 附近开始播放
+    EXPECT_NEAR(playout.backlog_ms(), 0.0, 10.0);
+}
+
+TEST(PullPlayoutTest, LateCallbackCountsDeadlineMisses)
+{
+    JitterBuffer jb(make_server_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    IngressQueue ingress(64, 0, PAYLOAD_SIZE);
+    PullPlayout playout(jb, ingress, make_server_format(), make_server_format(), FRAMES_PER_PACKET, nullptr, nullptr, 0);
+    std::vector<std::byte> out(FRAMES_PER_PACKET * 8);
+
+    SimClock::advance(std::chrono::seconds(1));
+    Sender sender { ingress, SimClock::now() };
+    for (int i = 0; i < 50; ++i) {
+        sender.deliver_until(SimClock::now());
+        EXPECT_EQ(playout.fill(out).deadline_misses, 0u);
+        SimClock::advance(PACKET_DURATION);
+    }
+    ASSERT_TRUE(playout.started());
+
+    // 回调晚到 15ms（设备卡顿）：首块落后 deadline 超过一包计 miss；
+    // 未超过 JB 的断流判定阈值（JITTER_MIN_RESET_LATENESS_MS），时间线保留
+    SimClock::advance(std::chrono::milliseconds(15));
+    sender.deliver_until(SimClock::now());
+    const auto r = playout.fill(out);
+    EXPECT_GE(r.deadline_misses, 1u);
+    EXPECT_FALSE(r.underrun);
+    EXPECT_GT(playout.backlog_ms(), 10.0);
+    EXPECT_EQ(jb.timeline_epoch(), 1u);
+}
+
+TEST(PullPlayoutTest, RequestResetRestartsTimelineForNewStream)
+{
+    JitterBuffer jb(make_server_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    IngressQueue ingress(64, 0, PAYLOAD_SIZE);
+    PullPlayout playout(jb, ingress, make_server_format(), make_server_format(), FRAMES_PER_PACKET, nullptr, nullptr, 1);
+    std::vector<std::byte> out(FRAMES_PER_PACKET * 8);
+
+    SimClock::advance(std::chrono::seconds(1));
+    Sender sender { ingress, SimClock::now() };
+    for (int i = 0; i < 50; ++i) {
+        sender.deliver_until(SimClock::now());
+        (void)playout.fill(out);
+        SimClock::advance(PACKET_DURATION);
+    }
+    ASSERT_TRUE(playout.started());
+    EXPECT_EQ(jb.timeline_epoch(), 1u);
+
+    // 原位重连：旧流停止，新会话的流从 sample_position 0 重新开始（相对旧时间线回跳）
+    playout.request_reset();
+    auto r = playout.fill(out);
+    EXPECT_EQ(r.bytes, 0u);
+    EXPECT_FALSE(r.underrun);
+    EXPECT_FALSE(playout.started());
+
+    Sender restarted { ingress, SimClock::now() };
+    int silent_callbacks = 0;
+    for (; silent_callbacks < 10; ++silent_callbacks) {
+        restarted.deliver_until(SimClock::now());
+        r = playout.fill(out);
+        if (r.bytes > 0) {
+            break;
+        }
+        SimClock::advance(PACKET_DURATION);
+    }
+    // 新流按 JB target 起播，不等待旧时间线的回跳判定
+    EXPECT_LE(silent_callbacks, static_cast<int>(TARGET));
+    ASSERT_GT(r.bytes, 0u);
+    float first = 0.0f;
+    std::memcpy(&first, out.data(), sizeof(first));
+    EXPECT_FLOAT_EQ(first, 1.0f / 1000.0f);
+    EXPECT_EQ(jb.timeline_epoch(), 2u);
+}
+
+TEST(PullPlayoutTest, ConverterOutputIsStagedAcrossCallbacks)
+{
+    aqua::AudioFormat device = make_server_format();
+    device.encoding = aqua::AudioEncoding::PcmS16LE;
+    JitterBuffer jb(make_server_format(), FRAMES_PER_PACKET, TARGET, CAPACITY);
+    IngressQueue ingress(64, 0, PAYLOAD_SIZE);
+    aqua::audio::dsp::FormatConverterOptions options;
+    options.dither = false;
+    aqua::audio::dsp::FormatConverter converter(make_server_format(), device, FRAMES_PER_PACKET, options);
+    PullPlayout playout(jb, ingress, make_server_format(), device, FRAMES_PER_PACKET, nullptr, &converter, 1);
+    EXPECT_EQ(playout.staging_capacity(), PAYLOAD_SIZE);
+
+    constexpr std::size_t CALLBACK_FRAMES = 200;
+    const auto callback_period = std::chrono::nanoseconds(CALLBACK_FRAMES * 1'000'000'000 / 48000);
+    std::vector<std::byte> out(CALLBACK_FRAMES * 4);
+    std::vector<std::int16_t> played;
+
+    SimClock::advance(std::chrono::seconds(1));
+    Sender sender { ingress, SimClock::now() };
+    std::uint32_t underruns = 0;
+    for (int i = 0; i < 240; ++i) { // 1s
+        sender.deliver_until(SimClock::now());
+        const auto r = playout.fill(out);
+        underruns += r.underrun ? 1 : 0;
+        const auto* samples = reinterpret_cast<const std::int16_t*>(out.data());
+        played.insert(played.end(), samples, samples + r.bytes / 2);
+        EXPECT_LT(playout.staged_bytes(), playout.staging_capacity());
+        SimClock::advance(callback_period);
+    }
+    EXPECT_EQ(underruns, 0u);
+    ASSERT_GT(played.size(), 50u * FRAMES_PER_PACKET * 2);
+    for (std::size_t s = 0; s < played.size(); ++s) {
+        const auto packet = static_cast<double>(s / (FRAMES_PER_PACKET * 2));
+        ASSERT_NEAR(played[s], (packet + 1.0) / 1000.0 * 32767.0, 1.0) << "sample " << s;
+    }
+}
@@ -0,0 +1,136 @@
+#include "core/audio/dsp/resampler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+using aqua::audio::dsp::VariableResampler;
+
+// 48kHz 立体声 F32，10ms 块；1kHz 正弦（远在通带内）。
+constexpr std::uint32_t RATE = 48000;
+constexpr std::uint32_t CHANNELS = 2;
+constexpr std::uint32_t FRAMES = 480;
+constexpr std::size_t FRAME_BYTES = CHANNELS * sizeof(float);
+constexpr double TONE_HZ = 1000.0;
+
+aqua::AudioFormat f32_format()
+{
+    return { aqua::AudioEncoding::PcmF32LE, CHANNELS, RATE };
+}
+
+double tone(double frame)
+{
+    return 0.5 * std::sin(2.0 * std::numbers::pi * TONE_HZ * frame / RATE);
+}
+
+std::vector<std::byte> sine_block(std::uint32_t block)
+{
+    std::vector<float> samples(FRAMES * CHANNELS);
+    for (std::uint32_t f = 0; f < FRAMES; ++f) {
+        for (std::uint32_t c = 0; c < CHANNELS; ++c) {
+            samples[f * CHANNELS + c] = static_cast<float>(tone(static_cast<double>(block) * FRAMES + f));
+        }
+    }
+    std::vector<std::byte> bytes(samples.size() * sizeof(float));
+    std::memcpy(bytes.data(), samples.data(), bytes.size());
+    return bytes;
+}
+
+// 以固定比率重采样 blocks 块正弦，返回全部输出（交织 float）。
+std::vector<float> run(VariableResampler& rs, double ratio, std::uint32_t blocks)
+{
+    std::vector<float> all;
+    std::vector<std::byte> out(rs.max_output_frames() * FRAME_BYTES);
+    for (std::uint32_t b = 0; b < blocks; ++b) {
+        const auto in = sine_block(b);
+        const auto frames = rs.process(in, ratio, out, { });
+        const auto old = all.size();
+        all.resize(old + frames * CHANNELS);
+        std::memcpy(all.data() + old, out.data(), frames * FRAME_BYTES);
+    }
+    return all;
+}
+
+} // namespace
+
+TEST(ResamplerTest, UnityRatioTracksInputWithLookahead)
+{
+    VariableResampler rs(f32_format(), FRAMES);
+    const auto out = run(rs, 1.0, 20);
+
+    // 首个输出点对齐首个输入帧；末尾 TAPS/2 帧等待下一块右侧邻域。
+    ASSERT_EQ(out.size() / CHANNELS, 20 * FRAMES - VariableResampler::TAPS / 2);
+    double max_err = 0.0;
+    for (std::size_t k = VariableResampler::TAPS; k < out.size() / CHANNELS; ++k) {
+        for (std::uint32_t c = 0; c < CHANNELS; ++c) {
+            max_err = std::max(max_err, std::abs(out[k * CHANNELS + c] - tone(static_cast<double>(k))));
+        }
+    }
+    EXPECT_LT(max_err, 1e-3);
+}
+
+TEST(ResamplerTest, FractionalRatioStretchesTimelineAccurately)
+{
+    constexpr double RATIO = 1.0 + 1000e-6;
+    VariableResampler rs(f32_format(), FRAMES);
+    const auto out = run(rs, RATIO, 200); // 2s 输入
+    const auto frames = out.size() / CHANNELS;
+
+    // 输出帧数 ≈ 输入 × 比率（96000 → 96096），差值只来自尾部前瞻
+    EXPECT_NEAR(static_cast<double>(frames), 200.0 * FRAMES * RATIO - VariableResampler::TAPS / 2, 2.0);
+
+    // 输出帧 k 对应输入时刻 k / ratio：与理想正弦逐点比较
+    double max_err = 0.0;
+    for (std::size_t k = VariableResampler::TAPS; k < frames; ++k) {
+        const double expected = tone(static_cast<double>(k) / RATIO);
+        max_err = std::max(max_err, std::abs(out[k * CHANNELS] - expected));
+    }
+    EXPECT_LT(max_err, 1e-3);
+}
+
+TEST(ResamplerTest, SplitOutputMatchesContiguousOutput)
+{
+    VariableResampler a(f32_format(), FRAMES);
+    VariableResampler b(f32_format(), FRAMES);
+    std::vector<std::byte> whole(a.max_output_frames() * FRAME_BYTES);
+    std::vector<std::byte> split(whole.size());
+    for (std::uint32_t blk = 0; blk < 5; ++blk) {
+        const auto in = sine_block(blk);
+        const auto n = a.process(in, 0.9995, whole, { });
+        // 回绕点不在帧边界
+        const std::size_t cut = 7 * FRAME_BYTES + 3;
+        const auto m = b.process(in, 0.9995, std::span<std::byte> { split }.first(cut),
+            std::span<std::byte> { split }.subspan(cut));
+        ASSERT_EQ(n, m);
+        EXPECT_EQ(std::memcmp(whole.data(), split.data(), n * FRAME_BYTES), 0);
+    }
+}
+
+TEST(ResamplerTest, RatioIsClampedToSupportedRange)
+{
+    VariableResampler rs(f32_format(), FRAMES);
+    std::vector<std::byte> out(rs.max_output_frames() * FRAME_BYTES);
+    std::size_t total = 0;
+    for (std::uint32_t b = 0; b < 100; ++b) {
+        const auto frames = rs.process(sine_block(b), 2.0, out, { });
+        EXPECT_LE(frames, rs.max_output_frames());
+        total += frames;
+    }
+    EXPECT_NEAR(static_cast<double>(total),
+        100.0 * FRAMES * (1.0 + VariableResampler::MAX_RATIO_DEVIATION) - VariableResampler::TAPS / 2, 2.0);
+}
+
+TEST(ResamplerTest, ResetRestartsFromSilentHistory)
+{
+    VariableResampler rs(f32_format(), FRAMES);
+    (void)run(rs, 1.003, 3);
+    rs.reset();
+    std::vector<std::byte> out(rs.max_output_frames() * FRAME_BYTES);
+    EXPECT_EQ(rs.process(sine_block(0), 1.0, out, { }), FRAMES - VariableResampler::TAPS / 2);
+}
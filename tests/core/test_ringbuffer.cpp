@@ -93,6 +93,43 @@ TEST(SpscRingBufferTest, PartialReadThenContinue)
     EXPECT_EQ(out2, std::vector<std::byte>(data.begin() + 50, data.end()));
 }
 
+TEST(SpscRingBufferTest, PrepareCommitWriteWrapsAndPublishesOnCommit)
+{
+    SpscRingBuffer rb(1024);
+    std::vector<std::byte> sink(1000);
+    // 把读写指针推到尾部附近：下一次预留必须跨尾部拆成两段
+    std::vector<std::byte> filler(1000, std::byte { 0 });
+    ASSERT_EQ(rb.write(filler), 1000u);
+    ASSERT_EQ(rb.read(sink), 1000u);
+
+    auto region = rb.prepare_write(100);
+    ASSERT_EQ(region.size(), 100u);
+    EXPECT_EQ(region.first.size(), 24u);
+    EXPECT_EQ(region.second.size(), 76u);
+    for (std::size_t i = 0; i < region.first.size(); ++i)
+        region.first[i] = static_cast<std::byte>(i);
+    for (std::size_t i = 0; i < region.second.size(); ++i)
+        region.second[i] = static_cast<std::byte>(region.first.size() + i);
+
+    // commit 前对消费者不可见
+    EXPECT_EQ(rb.available_read(), 0u);
+    rb.commit_write(100);
+    ASSERT_EQ(rb.available_read(), 100u);
+
+    std::vector<std::byte> out(100);
+    ASSERT_EQ(rb.read(out), 100u);
+    for (std::size_t i = 0; i < out.size(); ++i)
+        EXPECT_EQ(out[i], static_cast<std::byte>(i));
+}
+
+TEST(SpscRingBufferTest, PrepareWriteClampedToFreeSpace)
+{
+    SpscRingBuffer rb(1024);
+    std::vector<std::byte> data(1000, std::byte { 1 });
+    ASSERT_EQ(rb.write(data), 1000u);
+    EXPECT_EQ(rb.prepare_write(100).size(), 24u);
+}
+
 TEST(SpscRingBufferTest, Clear)
 {
     SpscRingBuffer rb(1024);
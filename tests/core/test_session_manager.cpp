@@ -299,3 +299,44 @@ TEST(SessionManagerTest, EstablishUdpIPv6Endpoint)
     EXPECT_EQ(manager.get_endpoint(*id).value(), ep6);
     EXPECT_TRUE(manager.is_connected(*id));
 }
+
+// ---- reserved 谓词 / restore_session（UDP 会话恢复，令牌见 test_session_resumer.cpp）----
+
+TEST(SessionManagerTest, CreateSessionSkipsReservedIds)
+{
+    aqua::SessionManager manager;
+    auto first = manager.create_session();
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(manager.remove_session(*first));
+
+    // 同一实例下一个 id 的低 16 位是 counter + 1：保留它后应跳过
+    const auto reserved_id = (*first & 0xFFFF0000u) | ((*first + 1) & 0xFFFFu);
+    std::vector<aqua::SessionManager::session_id_t> probed;
+    auto next = manager.create_session([&](auto id) {
+        probed.push_back(id);
+        return id == reserved_id;
+    });
+    ASSERT_TRUE(next.has_value());
+    EXPECT_NE(*next, reserved_id);
+    ASSERT_EQ(probed.size(), 2u);
+    EXPECT_EQ(probed.front(), reserved_id);
+}
+
+TEST(SessionManagerTest, RestoreSessionRecreatesConnected)
+{
+    aqua::SessionManager manager;
+    auto id = manager.create_session();
+    ASSERT_TRUE(id.has_value());
+    ASSERT_TRUE(manager.remove_session(*id));
+
+    asio::ip::udp::endpoint ep(asio::ip::make_address("127.0.0.1"), 30000);
+    ASSERT_TRUE(manager.restore_session(*id, ep));
+    EXPECT_TRUE(manager.is_connected(*id));
+    EXPECT_EQ(manager.get_endpoint(*id).value(), ep);
+
+    // 已存在：不覆盖
+    asio::ip::udp::endpoint other(asio::ip::make_address("127.0.0.2"), 30001);
+    EXPECT_FALSE(manager.restore_session(*id, other));
+    EXPECT_EQ(manager.get_endpoint(*id).value(), ep);
+    EXPECT_EQ(manager.session_count(), 1u);
+}
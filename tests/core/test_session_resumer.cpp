@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "core/session/session_resumer.h"
+#include "core/session/siphash.h"
+
+#include <array>
+
+// ---- SipHash-2-4 / 恢复令牌 ----
+
+TEST(SessionResumerTest, SipHashMatchesReferenceVector)
+{
+    // SipHash-2-4 论文附录 A：key = 00..0f，message = 00..0e（15 字节）
+    const aqua::SipHashKey key { 0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL };
+    std::array<std::byte, 15> msg { };
+    for (std::size_t i = 0; i < msg.size(); ++i) {
+        msg[i] = static_cast<std::byte>(i);
+    }
+    EXPECT_EQ(aqua::siphash24(key, msg), 0xa129ca6149be45e5ULL);
+    EXPECT_EQ(aqua::siphash24(key, { }), 0x726fdb47dd0e0e31ULL);
+}
+
+TEST(SessionResumerTest, TokenIsPerSessionAndPerInstance)
+{
+    aqua::SessionResumer resumer;
+    EXPECT_EQ(resumer.mint(0x00010001), resumer.mint(0x00010001));
+    EXPECT_NE(resumer.mint(0x00010001), resumer.mint(0x00010002));
+    EXPECT_TRUE(resumer.verify(0x00010001, resumer.mint(0x00010001)));
+    EXPECT_FALSE(resumer.verify(0x00010001, resumer.mint(0x00010001) ^ 1));
+    // 令牌属于另一个 session
+    EXPECT_FALSE(resumer.verify(0x00010001, resumer.mint(0x00010002)));
+
+    // 另一个实例（服务端重启）密钥不同，令牌不通用
+    aqua::SessionResumer restarted;
+    EXPECT_NE(restarted.mint(0x00010001), resumer.mint(0x00010001));
+    EXPECT_FALSE(restarted.verify(0x00010001, resumer.mint(0x00010001)));
+}
+
+// ---- 可恢复表 ----
+
+TEST(SessionResumerTest, ExpiredEntryIsTakenOnce)
+{
+    aqua::SessionResumer resumer;
+    resumer.record_expired(0x00010001);
+    EXPECT_TRUE(resumer.is_reserved(0x00010001));
+    EXPECT_EQ(resumer.expired_count(), 1u);
+
+    EXPECT_TRUE(resumer.take_expired(0x00010001));
+    // 恢复后即普通 session：条目已移除，不再保留该 id
+    EXPECT_FALSE(resumer.take_expired(0x00010001));
+    EXPECT_FALSE(resumer.is_reserved(0x00010001));
+    EXPECT_EQ(resumer.expired_count(), 0u);
+}
+
+TEST(SessionResumerTest, UnrecordedSessionIsNotResumable)
+{
+    // 主动 Disconnect 的 session 不记入可恢复表
+    aqua::SessionResumer resumer;
+    EXPECT_FALSE(resumer.is_reserved(0x00010001));
+    EXPECT_FALSE(resumer.take_expired(0x00010001));
+}
+
+TEST(SessionResumerTest, RecordExpiredIsIdempotent)
+{
+    aqua::SessionResumer resumer;
+    resumer.record_expired(0x00010001);
+    resumer.record_expired(0x00010001);
+    resumer.record_expired(0x00010002);
+    EXPECT_EQ(resumer.expired_count(), 2u);
+    EXPECT_TRUE(resumer.take_expired(0x00010002));
+    EXPECT_TRUE(resumer.is_reserved(0x00010001));
+}
+
+// ---- UDP 新建 session ----
+
+TEST(SessionResumerTest, RejoinIsRememberedPerOldSession)
+{
+    aqua::SessionResumer resumer;
+    EXPECT_FALSE(resumer.rejoined(0x00010001).has_value());
+
+    resumer.record_rejoin(0x00010001, 0x00010005);
+    ASSERT_TRUE(resumer.rejoined(0x00010001).has_value());
+    EXPECT_EQ(*resumer.rejoined(0x00010001), 0x00010005u);
+    EXPECT_FALSE(resumer.rejoined(0x00010005).has_value());
+
+    // 前一个新 session 已失效、同一旧令牌再次新建：覆盖为最新的映射
+    resumer.record_rejoin(0x00010001, 0x00010006);
+    EXPECT_EQ(*resumer.rejoined(0x00010001), 0x00010006u);
+}
@@ -0,0 +1,333 @@
+#include "core/client/pull_playout.h"
+#include "core/client/stream_mixer.h"
+#include "core/jitter_buffer/ingress_queue.h"
+#include "core/jitter_buffer/jitter_buffer.h"
+#include "core/jitter_buffer/sim_clock.h"
+#include "core/public/audio_format.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using aqua::AudioEncoding;
+using aqua::AudioFormat;
+using aqua::jitter::SimClock;
+using StreamMixer = aqua::client::BasicStreamMixer<SimClock>;
+
+constexpr std::uint32_t FRAMES_PER_PACKET = 480;
+constexpr std::chrono::milliseconds PACKET_DURATION { 10 };
+constexpr std::size_t FLOOR = 2;
+constexpr std::size_t CAPACITY = 8;
+
+AudioFormat make_format(AudioEncoding encoding, std::uint32_t channels = 2, std::uint32_t rate = 48000)
+{
+    return AudioFormat { encoding, channels, rate };
+}
+
+StreamMixer::StreamConfig make_stream(const AudioFormat& format, float gain)
+{
+    StreamMixer::StreamConfig cfg;
+    cfg.format = format;
+    cfg.gain = gain;
+    cfg.floor_packets = FLOOR;
+    cfg.capacity_packets = CAPACITY;
+    return cfg;
+}
+
+std::vector<std::byte> f32_block(float value, std::uint32_t channels = 2)
+{
+    std::vector<float> samples(FRAMES_PER_PACKET * channels, value);
+    std::vector<std::byte> block(samples.size() * 4);
+    std::memcpy(block.data(), samples.data(), block.size());
+    return block;
+}
+
+std::vector<std::byte> s16_block(std::int16_t value, std::uint32_t channels = 2)
+{
+    std::vector<std::int16_t> samples(FRAMES_PER_PACKET * channels, value);
+    std::vector<std::byte> block(samples.size() * 2);
+    std::memcpy(block.data(), samples.data(), block.size());
+    return block;
+}
+
+float f32_at(const std::vector<std::byte>& block, std::size_t i)
+{
+    float v;
+    std::memcpy(&v, block.data() + i * 4, sizeof(v));
+    return v;
+}
+
+std::int16_t s16_at(const std::vector<std::byte>& block, std::size_t i)
+{
+    std::int16_t v;
+    std::memcpy(&v, block.data() + i * 2, sizeof(v));
+    return v;
+}
+
+} // namespace
+
+TEST(StreamMixerTest, PrimaryGainWithoutStreams)
+{
+    StreamMixer unity(make_format(AudioEncoding::PcmS16LE), FRAMES_PER_PACKET, 1.0f);
+    auto block = s16_block(1000);
+    EXPECT_EQ(unity.mix(block, SimClock::now()), 0u);
+    EXPECT_EQ(block, s16_block(1000)); // 增益 1 且无附加流：不触碰主流块
+
+    StreamMixer half(make_format(AudioEncoding::PcmS16LE), FRAMES_PER_PACKET, 0.5f);
+    EXPECT_EQ(half.mix(block, SimClock::now()), 0u);
+    EXPECT_EQ(s16_at(block, 0), 500);
+    EXPECT_EQ(s16_at(block, block.size() / 2 - 1), 500);
+}
+
+TEST(StreamMixerTest, RejectsMismatchedSampleRate)
+{
+    StreamMixer mixer(make_format(AudioEncoding::PcmF32LE), FRAMES_PER_PACKET, 1.0f);
+    EXPECT_THROW((void)mixer.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE, 2, 44100), 1.0f)),
+        std::invalid_argument);
+    EXPECT_THROW((void)mixer.add_stream(make_stream(AudioFormat { }, 1.0f)), std::invalid_argument);
+    EXPECT_EQ(mixer.stream_count(), 0u);
+}
+
+TEST(StreamMixerTest, StreamSlotsAreBounded)
+{
+    StreamMixer mixer(make_format(AudioEncoding::PcmF32LE), FRAMES_PER_PACKET, 1.0f, 2);
+    EXPECT_EQ(mixer.max_streams(), 2u);
+    EXPECT_EQ(mixer.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE), 1.0f)), 0u);
+    EXPECT_EQ(mixer.add_stream(make_stream(make_format(AudioEncoding::PcmS16LE), 1.0f)), 1u);
+    EXPECT_THROW(mixer.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE), 1.0f)), std::length_error);
+    EXPECT_EQ(mixer.stream_count(), 2u);
+}
+
+TEST(StreamMixerTest, StreamAddedWhileMixingJoinsLaterBlocks)
+{
+    // 附加源起播后才接入：接入前主流块原样，接入后的块正常混入
+    StreamMixer mixer(make_format(AudioEncoding::PcmF32LE), FRAMES_PER_PACKET, 1.0f);
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    auto block = f32_block(0.5f);
+    EXPECT_EQ(mixer.mix(block, t0), 0u);
+    EXPECT_EQ(block, f32_block(0.5f));
+
+    const auto stream = mixer.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE), 1.0f));
+    for (std::uint32_t k = 0; k < 4; ++k) {
+        ASSERT_TRUE(mixer.push(stream, (t0 + PACKET_DURATION * k).time_since_epoch(), k * FRAMES_PER_PACKET,
+            f32_block(0.25f)));
+    }
+    const auto deadline = t0 + PACKET_DURATION * FLOOR;
+    SimClock::set(deadline);
+    block = f32_block(0.5f);
+    ASSERT_EQ(mixer.mix(block, deadline), 1u);
+    EXPECT_FLOAT_EQ(f32_at(block, 0), 0.75f);
+}
+
+TEST(StreamMixerTest, SumsDueStreamsWithPerStreamGain)
+{
+    // 主流 F32；附加流一路 S16（经格式转换）、一路 F32（直通），deadline 与主流块对齐
+    StreamMixer mixer(make_format(AudioEncoding::PcmF32LE), FRAMES_PER_PACKET, 0.5f);
+    const auto s16_stream = mixer.add_stream(make_stream(make_format(AudioEncoding::PcmS16LE), 0.25f));
+    const auto f32_stream = mixer.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE), 2.0f));
+
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    const auto extra_s16 = s16_block(16384); // 0.5 满幅
+    const auto extra_f32 = f32_block(0.125f);
+
+    std::size_t mixed_blocks = 0;
+    for (std::uint32_t k = 0; k < 20; ++k) {
+        const auto arrival = t0 + PACKET_DURATION * k;
+        ASSERT_TRUE(mixer.push(s16_stream, arrival.time_since_epoch(), k * FRAMES_PER_PACKET, extra_s16));
+        ASSERT_TRUE(mixer.push(f32_stream, arrival.time_since_epoch(), k * FRAMES_PER_PACKET, extra_f32));
+
+        // 主流块的播放时刻：首包到达 + 起播缓冲（FLOOR 包）之后逐包推进
+        if (k < FLOOR) {
+            continue;
+        }
+        const auto deadline = t0 + PACKET_DURATION * k;
+        SimClock::set(deadline);
+        auto block = f32_block(0.5f);
+        const auto mixed = mixer.mix(block, deadline);
+        if (mixed == 2) {
+            ++mixed_blocks;
+            // 0.5 · 0.5 + 0.5 · 0.25 + 0.125 · 2
+            EXPECT_FLOAT_EQ(f32_at(block, 0), 0.625f);
+            EXPECT_FLOAT_EQ(f32_at(block, FRAMES_PER_PACKET * 2 - 1), 0.625f);
+        }
+    }
+    EXPECT_GE(mixed_blocks, 15u);
+    EXPECT_EQ(mixer.stats(s16_stream).mixed_blocks, mixed_blocks);
+    EXPECT_EQ(mixer.stats(f32_stream).packets_received, 20u);
+    EXPECT_EQ(mixer.stats(f32_stream).packets_lost, 0u);
+}
+
+TEST(StreamMixerTest, IntegerMixSaturates)
+{
+    StreamMixer mixer(make_format(AudioEncoding::PcmS16LE), FRAMES_PER_PACKET, 1.0f);
+    const auto stream = mixer.add_stream(make_stream(make_format(AudioEncoding::PcmS16LE), 1.0f));
+
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    for (std::uint32_t k = 0; k < 4; ++k) {
+        ASSERT_TRUE(mixer.push(stream, (t0 + PACKET_DURATION * k).time_since_epoch(), k * FRAMES_PER_PACKET,
+            s16_block(30000)));
+    }
+    const auto deadline = t0 + PACKET_DURATION * FLOOR;
+    SimClock::set(deadline);
+    auto block = s16_block(30000);
+    ASSERT_EQ(mixer.mix(block, deadline), 1u);
+    EXPECT_EQ(s16_at(block, 0), 32767);
+}
+
+TEST(StreamMixerTest, StreamNotYetDueIsLeftOut)
+{
+    StreamMixer mixer(make_format(AudioEncoding::PcmF32LE), FRAMES_PER_PACKET, 1.0f);
+    const auto stream = mixer.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE), 1.0f));
+
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    ASSERT_TRUE(mixer.push(stream, t0.time_since_epoch(), 0, f32_block(0.25f)));
+
+    // 主流块早于附加流首块 deadline 一包以上：该路本块不参与，主流块原样
+    auto block = f32_block(0.5f);
+    EXPECT_EQ(mixer.mix(block, t0), 0u);
+    EXPECT_EQ(block, f32_block(0.5f));
+    EXPECT_EQ(mixer.stats(stream).packets_received, 1u);
+}
+
+TEST(StreamMixerTest, LaggingStreamCatchesUpToPrimary)
+{
+    StreamMixer mixer(make_format(AudioEncoding::PcmF32LE), FRAMES_PER_PACKET, 1.0f);
+    const auto stream = mixer.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE), 1.0f));
+
+    // 附加流先起播：主流首块的播放时刻比附加流首块晚 2 包，附加流丢弃 2 块对齐后混入
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    for (std::uint32_t k = 0; k < 6; ++k) {
+        ASSERT_TRUE(mixer.push(stream, (t0 + PACKET_DURATION * k).time_since_epoch(), k * FRAMES_PER_PACKET,
+            f32_block(static_cast<float>(k + 1) / 100.0f)));
+    }
+    const auto deadline = t0 + PACKET_DURATION * (FLOOR + 2);
+    SimClock::set(deadline);
+    auto block = f32_block(0.0f);
+    ASSERT_EQ(mixer.mix(block, deadline), 1u);
+    EXPECT_EQ(mixer.stats(stream).skipped_blocks, 2u);
+    EXPECT_FLOAT_EQ(f32_at(block, 0), 0.03f); // 第 3 个包（k = 2）
+}
+
+TEST(StreamMixerTest, MixOverSilenceLedByEarliestStream)
+{
+    // 无附加流时间线：无领拍 deadline，块写为编码后的静音（U8 零点 0x80），主流增益不参与
+    StreamMixer idle(make_format(AudioEncoding::PcmU8), FRAMES_PER_PACKET, 0.5f);
+    (void)idle.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE), 1.0f));
+    EXPECT_FALSE(idle.next_deadline().has_value());
+    std::vector<std::byte> u8_block(FRAMES_PER_PACKET * 2, std::byte { 0x12 });
+    EXPECT_EQ(idle.mix_over_silence(u8_block, SimClock::now()), 0u);
+    EXPECT_EQ(u8_block, std::vector<std::byte>(FRAMES_PER_PACKET * 2, std::byte { 0x80 }));
+
+    StreamMixer mixer(make_format(AudioEncoding::PcmF32LE), FRAMES_PER_PACKET, 0.5f);
+    const auto early = mixer.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE), 0.5f));
+    const auto late = mixer.add_stream(make_stream(make_format(AudioEncoding::PcmF32LE), 1.0f));
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    for (std::uint32_t k = 0; k < 4; ++k) {
+        ASSERT_TRUE(mixer.push(early, (t0 + PACKET_DURATION * k).time_since_epoch(), k * FRAMES_PER_PACKET,
+            f32_block(0.5f)));
+        // 晚一包起播：首块 deadline 比领拍流晚一包，首个领拍块不参与
+        ASSERT_TRUE(mixer.push(late, (t0 + PACKET_DURATION * (k + 1)).time_since_epoch(), k * FRAMES_PER_PACKET,
+            f32_block(0.25f)));
+    }
+    mixer.drain();
+    const auto lead = mixer.next_deadline();
+    ASSERT_TRUE(lead.has_value());
+
+    SimClock::set(*lead);
+    auto block = f32_block(0.9f);
+    ASSERT_EQ(mixer.mix_over_silence(block, *lead), 1u);
+    EXPECT_FLOAT_EQ(f32_at(block, 0), 0.25f); // 0.5 · 0.5，以静音为底
+    EXPECT_EQ(mixer.stats(late).mixed_blocks, 0u);
+
+    // 下一块：两路 deadline 同在半包内，一起混入
+    const auto next = mixer.next_deadline();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(*next, *lead + PACKET_DURATION);
+    SimClock::set(*next);
+    ASSERT_EQ(mixer.mix_over_silence(block, *next), 2u);
+    EXPECT_FLOAT_EQ(f32_at(block, 0), 0.5f);
+}
+
+TEST(StreamMixerTest, PullPlayoutMixesExtraStream)
+{
+    using JitterBuffer = aqua::jitter::BasicJitterBuffer<SimClock>;
+    using PullPlayout = aqua::client::BasicPullPlayout<SimClock>;
+    const auto format = make_format(AudioEncoding::PcmF32LE);
+    const std::size_t payload = FRAMES_PER_PACKET * format.frame_bytes();
+
+    JitterBuffer jb(format, FRAMES_PER_PACKET, FLOOR, CAPACITY);
+    aqua::jitter::IngressQueue ingress(64, 0, payload);
+    StreamMixer mixer(format, FRAMES_PER_PACKET, 1.0f);
+    const auto stream = mixer.add_stream(make_stream(format, 0.5f));
+    PullPlayout playout(jb, ingress, format, format, FRAMES_PER_PACKET, nullptr, nullptr, 0, &mixer);
+    std::vector<std::byte> out(payload);
+
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    std::size_t mixed_callbacks = 0;
+    for (std::uint32_t k = 0; k < 30; ++k) {
+        SimClock::set(t0 + PACKET_DURATION * k);
+        ASSERT_TRUE(ingress.push(SimClock::now().time_since_epoch(), k * FRAMES_PER_PACKET, f32_block(0.25f)));
+        ASSERT_TRUE(mixer.push(stream, SimClock::now().time_since_epoch(), k * FRAMES_PER_PACKET, f32_block(0.5f)));
+        const auto r = playout.fill(out);
+        if (r.bytes == out.size() && f32_at(out, 0) == 0.5f) {
+            ++mixed_callbacks; // 0.25 + 0.5 · 0.5
+        }
+    }
+    EXPECT_GE(mixed_callbacks, 20u);
+}
+
+TEST(StreamMixerTest, PullPlayoutKeepsExtraStreamWhenPrimaryStops)
+{
+    // 主流停发且时间线被丢弃（服务器闪断 / 原位重连）：附加流按自己的 deadline 领拍，以静音为底继续出声
+    using JitterBuffer = aqua::jitter::BasicJitterBuffer<SimClock>;
+    using PullPlayout = aqua::client::BasicPullPlayout<SimClock>;
+    const auto format = make_format(AudioEncoding::PcmF32LE);
+    const std::size_t payload = FRAMES_PER_PACKET * format.frame_bytes();
+
+    JitterBuffer jb(format, FRAMES_PER_PACKET, FLOOR, CAPACITY);
+    aqua::jitter::IngressQueue ingress(64, 0, payload);
+    StreamMixer mixer(format, FRAMES_PER_PACKET, 1.0f);
+    const auto stream = mixer.add_stream(make_stream(format, 0.5f));
+    PullPlayout playout(jb, ingress, format, format, FRAMES_PER_PACKET, nullptr, nullptr, 0, &mixer);
+    std::vector<std::byte> out(payload);
+
+    SimClock::advance(std::chrono::seconds(1));
+    const auto t0 = SimClock::now();
+    constexpr std::uint32_t kPrimaryPackets = 15;
+    std::size_t extra_only = 0;
+    std::size_t underruns = 0;
+    for (std::uint32_t k = 0; k < 60; ++k) {
+        SimClock::set(t0 + PACKET_DURATION * k);
+        if (k < kPrimaryPackets) {
+            ASSERT_TRUE(ingress.push(SimClock::now().time_since_epoch(), k * FRAMES_PER_PACKET, f32_block(0.25f)));
+        } else if (k == kPrimaryPackets) {
+            playout.request_reset();
+        }
+        ASSERT_TRUE(mixer.push(stream, SimClock::now().time_since_epoch(), k * FRAMES_PER_PACKET, f32_block(0.5f)));
+        const auto r = playout.fill(out);
+        if (k > kPrimaryPackets) {
+            EXPECT_FALSE(playout.started());
+            underruns += r.underrun ? 1 : 0;
+            if (r.bytes == out.size() && f32_at(out, 0) == 0.25f) {
+                ++extra_only; // 0.5 · 0.5，无主流
+            }
+        }
+    }
+    EXPECT_GE(extra_only, 40u);
+    EXPECT_EQ(underruns, 0u);
+    EXPECT_EQ(jb.next_playout_deadline(), std::nullopt);
+    EXPECT_GE(mixer.stats(stream).mixed_blocks, 50u);
+}
@@ -0,0 +1,142 @@
+#include "core/client/playout_scheduler.h"
+#include "core/public/config.h"
+#include "core/rt/thread_policy.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// 在独立线程执行 fn，避免改动 gtest 主线程的调度 / 亲和性。
+template <typename Fn>
+void run_on_thread(Fn&& fn)
+{
+    std::thread t(std::forward<Fn>(fn));
+    t.join();
+}
+
+} // namespace
+
+TEST(ThreadPolicyTest, RoleNames)
+{
+    EXPECT_STREQ(aqua::rt::thread_role_name(aqua::config::ThreadRole::Grpc), "grpc");
+    EXPECT_STREQ(aqua::rt::thread_role_name(aqua::config::ThreadRole::Capture), "capture");
+    EXPECT_STREQ(aqua::rt::thread_role_name(aqua::config::ThreadRole::Playback), "playback");
+    EXPECT_STREQ(aqua::rt::thread_role_name(aqua::config::ThreadRole::Scheduler), "scheduler");
+}
+
+TEST(ThreadPolicyTest, DefaultPolicyIsNoop)
+{
+    aqua::rt::ThreadPolicyReport report;
+    bool ok = false;
+    run_on_thread([&] {
+        ok = aqua::rt::apply_current_thread_policy(aqua::config::ThreadRole::Io, { }, &report);
+    });
+    EXPECT_TRUE(ok);
+    const auto status = report.status();
+    EXPECT_EQ(status.applied, 0u);
+    EXPECT_EQ(status.failures, 0u);
+}
+
+#if defined(__linux__)
+TEST(ThreadPolicyTest, AffinityToAllowedCpuApplies)
+{
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    int cpu = 0;
+    while (cpu < 64 && !CPU_ISSET(cpu, &allowed)) {
+        ++cpu;
+    }
+    if (cpu == 64) {
+        GTEST_SKIP() << "no allowed CPU below 64";
+    }
+
+    aqua::config::ThreadPolicy policy;
+    policy.cpu_mask = std::uint64_t { 1 } << cpu;
+    aqua::rt::ThreadPolicyReport report;
+    bool ok = false;
+    int ran_on = -1;
+    run_on_thread([&] {
+        ok = aqua::rt::apply_current_thread_policy(aqua::config::ThreadRole::Sender, policy, &report);
+        cpu_set_t now;
+        if (sched_getaffinity(0, sizeof(now), &now) == 0 && CPU_COUNT(&now) == 1 && CPU_ISSET(cpu, &now)) {
+            ran_on = cpu;
+        }
+    });
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(ran_on, cpu);
+    EXPECT_EQ(report.status().applied, 1u);
+    EXPECT_EQ(report.status().failures, 0u);
+}
+
+TEST(ThreadPolicyTest, UnavailableCpuIsReportedNotFatal)
+{
+    cpu_set_t allowed;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+    if (CPU_ISSET(63, &allowed)) {
+        GTEST_SKIP() << "CPU 63 is available on this host";
+    }
+
+    aqua::config::ThreadPolicy policy;
+    policy.cpu_mask = std::uint64_t { 1 } << 63;
+    aqua::rt::ThreadPolicyReport report;
+    bool ok = true;
+    run_on_thread([&] {
+        ok = aqua::rt::apply_current_thread_policy(aqua::config::ThreadRole::Capture, policy, &report);
+    });
+    EXPECT_FALSE(ok);
+    EXPECT_EQ(report.status().applied, 0u);
+    EXPECT_EQ(report.status().failures, 1u);
+}
+#endif
+
+TEST(ThreadPolicyTest, RealtimePolicyCountsExactlyOneOutcome)
+{
+    // 有无 CAP_SYS_NICE 结果不同，但必须恰好计一次成功或失败，且不抛出
+    aqua::config::ThreadPolicy policy;
+    policy.policy = aqua::config::SchedPolicy::Fifo;
+    policy.priority = 10;
+    aqua::rt::ThreadPolicyReport report;
+    bool ok = false;
+    run_on_thread([&] {
+        ok = aqua::rt::apply_current_thread_policy(aqua::config::ThreadRole::Playback, policy, &report);
+    });
+    const auto status = report.status();
+    EXPECT_EQ(status.applied + status.failures, 1u);
+    EXPECT_EQ(ok, status.applied == 1u);
+}
+
+TEST(ThreadPolicyTest, SchedulerKeepsRunningWhenPolicyFails)
+{
+    // 无论策略是否生效，调度线程都照常 tick
+    aqua::config::ThreadPolicy policy;
+    policy.policy = aqua::config::SchedPolicy::RoundRobin;
+    policy.priority = 5;
+    aqua::rt::ThreadPolicyReport report;
+    std::atomic<int> ticks { 0 };
+    const auto tick = [&](aqua::client::PlayoutScheduler::clock::time_point) {
+        ++ticks;
+        return std::optional<aqua::client::PlayoutScheduler::clock::time_point> { };
+    };
+    aqua::client::PlayoutScheduler scheduler(tick);
+    scheduler.start(policy, &report);
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (ticks.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    scheduler.stop();
+
+    EXPECT_GE(ticks.load(), 3);
+    const auto status = report.status();
+    EXPECT_EQ(status.applied + status.failures, 1u);
+}
@@ -0,0 +1,216 @@
+#include "core/jitter_buffer/jitter_buffer.h"
+#include "core/jitter_buffer/time_stretcher.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+using aqua::jitter::TimeStretcher;
+
+// 48kHz 立体声 F32，10ms 包；200Hz 正弦周期恰为 240 帧。
+constexpr std::uint32_t RATE = 48000;
+constexpr std::uint32_t CHANNELS = 2;
+constexpr std::uint32_t FRAMES = 480;
+constexpr std::size_t PAYLOAD = FRAMES * CHANNELS * sizeof(float);
+constexpr double TONE_HZ = 200.0;
+
+aqua::AudioFormat f32_format()
+{
+    return { aqua::AudioEncoding::PcmF32LE, CHANNELS, RATE };
+}
+
+float tone(std::uint64_t frame)
+{
+    return static_cast<float>(0.5 * std::sin(2.0 * std::numbers::pi * TONE_HZ * static_cast<double>(frame) / RATE));
+}
+
+std::vector<std::byte> sine_packet(std::uint32_t packet)
+{
+    std::vector<float> samples(FRAMES * CHANNELS);
+    for (std::uint32_t f = 0; f < FRAMES; ++f) {
+        for (std::uint32_t c = 0; c < CHANNELS; ++c) {
+            samples[f * CHANNELS + c] = tone(static_cast<std::uint64_t>(packet) * FRAMES + f);
+        }
+    }
+    std::vector<std::byte> pcm(PAYLOAD);
+    std::memcpy(pcm.data(), samples.data(), pcm.size());
+    return pcm;
+}
+
+void append(TimeStretcher& stretcher, const std::vector<std::byte>& pcm)
+{
+    auto dst = stretcher.prepare_append();
+    std::memcpy(dst.data(), pcm.data(), dst.size());
+    stretcher.commit_append();
+}
+
+// 输出是否为从 start_frame 起的连续正弦（左声道）
+float max_tone_error(const std::vector<std::byte>& pcm, std::uint64_t start_frame)
+{
+    std::vector<float> samples(pcm.size() / sizeof(float));
+    std::memcpy(samples.data(), pcm.data(), pcm.size());
+    float err = 0.0f;
+    for (std::size_t f = 0; f < samples.size() / CHANNELS; ++f) {
+        err = std::max(err, std::abs(samples[f * CHANNELS] - tone(start_frame + f)));
+    }
+    return err;
+}
+
+} // namespace
+
+TEST(TimeStretcherTest, IdlePassesBytesThroughExactly)
+{
+    aqua::AudioFormat fmt { aqua::AudioEncoding::PcmS24LE, CHANNELS, RATE };
+    TimeStretcher stretcher(fmt, FRAMES);
+    EXPECT_FALSE(stretcher.active());
+
+    std::vector<std::byte> pcm(FRAMES * fmt.frame_bytes());
+    for (std::size_t i = 0; i < pcm.size(); ++i) {
+        pcm[i] = static_cast<std::byte>(i * 37 + 11);
+    }
+    append(stretcher, pcm);
+    EXPECT_TRUE(stretcher.active());
+    EXPECT_EQ(stretcher.try_adjust(), 0); // 无待伸缩量
+
+    std::vector<std::byte> out(pcm.size());
+    stretcher.emit(out, { });
+    EXPECT_EQ(out, pcm);
+    EXPECT_FALSE(stretcher.active());
+}
+
+TEST(TimeStretcherTest, RemovesWholePeriodsSeamlessly)
+{
+    TimeStretcher stretcher(f32_format(), FRAMES);
+    for (std::uint32_t p = 0; p < 3; ++p) {
+        append(stretcher, sine_packet(p));
+    }
+
+    // 删除一包（480 帧 = 两个周期）：可一次完成，删除后波形仍是连续正弦
+    stretcher.adjust(FRAMES);
+    EXPECT_EQ(stretcher.try_adjust(), static_cast<std::int64_t>(FRAMES));
+    EXPECT_EQ(stretcher.pending_frames(), 0);
+    EXPECT_EQ(stretcher.buffered_frames(), 2u * FRAMES);
+
+    std::vector<std::byte> out(PAYLOAD);
+    stretcher.emit(out, { });
+    EXPECT_LT(max_tone_error(out, 0), 1e-5f);
+    stretcher.emit(out, { });
+    EXPECT_LT(max_tone_error(out, FRAMES), 1e-5f);
+    EXPECT_FALSE(stretcher.active()); // 整包删完，FIFO 回到空
+}
+
+TEST(TimeStretcherTest, InsertsPeriodAndKeepsPhase)
+{
+    TimeStretcher stretcher(f32_format(), FRAMES);
+    append(stretcher, sine_packet(0));
+    append(stretcher, sine_packet(1));
+
+    stretcher.adjust(-static_cast<std::int64_t>(FRAMES));
+    const auto inserted = stretcher.try_adjust();
+    ASSERT_LT(inserted, 0);
+    EXPECT_EQ(-inserted % 240, 0); // 插入整周期
+    EXPECT_EQ(stretcher.buffered_frames(), 2u * FRAMES + static_cast<std::size_t>(-inserted));
+
+    std::vector<std::byte> out(PAYLOAD);
+    stretcher.emit(out, { });
+    EXPECT_LT(max_tone_error(out, 0), 1e-5f);
+}
+
+TEST(TimeStretcherTest, RateLimitedBetweenAdjustments)
+{
+    TimeStretcher stretcher(f32_format(), FRAMES);
+    for (std::uint32_t p = 0; p < 4; ++p) {
+        append(stretcher, sine_packet(p));
+    }
+
+    // 待删 4 个周期：首次最多删到剩余 >= 最短周期，之后须等冷却
+    stretcher.adjust(960);
+    const auto first = stretcher.try_adjust();
+    ASSERT_GT(first, 0);
+    ASSERT_NE(stretcher.pending_frames(), 0);
+    EXPECT_EQ(stretcher.try_adjust(), 0);
+
+    // 冷却 = L × 100 / PLAYOUT_STRETCH_MAX_RATE_PERCENT 帧输出
+    const auto cooldown = static_cast<std::size_t>(first) * 100 / aqua::config::PLAYOUT_STRETCH_MAX_RATE_PERCENT;
+    std::vector<std::byte> out(PAYLOAD);
+    std::size_t emitted = 0;
+    std::uint32_t next = 4;
+    while (emitted < cooldown) {
+        EXPECT_EQ(stretcher.try_adjust(), 0);
+        while (stretcher.buffered_frames() < stretcher.wanted_frames()) {
+            append(stretcher, sine_packet(next++));
+        }
+        stretcher.emit(out, { });
+        emitted += FRAMES;
+    }
+    while (stretcher.buffered_frames() < stretcher.wanted_frames()) {
+        append(stretcher, sine_packet(next++));
+    }
+    EXPECT_GT(stretcher.try_adjust(), 0);
+}
+
+TEST(TimeStretcherTest, ResetClearsFifoAndPending)
+{
+    TimeStretcher stretcher(f32_format(), FRAMES);
+    append(stretcher, sine_packet(0));
+    stretcher.adjust(100);
+    stretcher.reset();
+    EXPECT_FALSE(stretcher.active());
+    EXPECT_EQ(stretcher.buffered_frames(), 0u);
+}
+
+TEST(TimeStretcherTest, JitterBufferAdjustsTargetWithoutDeadlineJump)
+{
+    // 窗口 8 包、1 个干净窗口即回落；floor 2
+    aqua::jitter::AdaptiveTargetConfig cfg { };
+    cfg.raise_late_count = 2;
+    cfg.lower_clean_windows = 1;
+    cfg.time_stretch = true;
+    aqua::jitter::JitterBuffer jb(f32_format(), FRAMES, /*floor=*/2, /*capacity=*/16, 8, 8, cfg);
+    std::vector<std::byte> out(PAYLOAD);
+
+    // 抬升：pop 越过 0..5 后推 2 个 late + 6 个 expected → target 3，deadline 不后移
+    jb.push(0, sine_packet(0));
+    for (int i = 0; i < 6; ++i) {
+        (void)jb.pop_next(out);
+    }
+    jb.push(3, sine_packet(3));
+    jb.push(4, sine_packet(4));
+    const auto before_raise = jb.next_playout_deadline();
+    for (std::uint32_t s = 6; s <= 11; ++s) {
+        jb.push(s, sine_packet(s));
+    }
+    ASSERT_EQ(jb.target_latency_packets(), 3u);
+    EXPECT_EQ(jb.next_playout_deadline(), before_raise);
+
+    // 蓄水：插入一包帧数，6 个包播放 7 拍，全部真实且波形连续（每包起点相位均为 0）
+    const auto lost_before = jb.packets_lost();
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_TRUE(jb.pop_next(out)) << "pop " << i;
+        EXPECT_LT(max_tone_error(out, 0), 1e-5f) << "pop " << i;
+    }
+    EXPECT_EQ(jb.next_sequence(), 12u);
+
+    // 回落：干净窗口 → target 2，deadline 不前移
+    for (std::uint32_t s = 12; s <= 18; ++s) {
+        jb.push(s, sine_packet(s));
+    }
+    const auto before_lower = jb.next_playout_deadline();
+    jb.push(19, sine_packet(19));
+    EXPECT_EQ(jb.target_latency_packets(), 2u);
+    EXPECT_EQ(jb.next_playout_deadline(), before_lower);
+
+    // 排水：删除一包帧数，8 个包 7 拍播完
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_TRUE(jb.pop_next(out)) << "pop " << i;
+        EXPECT_LT(max_tone_error(out, 0), 1e-5f) << "pop " << i;
+    }
+    EXPECT_EQ(jb.next_sequence(), 20u);
+    EXPECT_EQ(jb.packets_lost(), lost_before);
+}
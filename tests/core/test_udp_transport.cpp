@@ -2,6 +2,7 @@
 
 #include "core/net/transport/udp_transport.h"
 
+#include <array>
 #include <atomic>
 #include <thread>
 
@@ -38,10 +39,11 @@ TEST(UdpTransportTest, SendReceiveLoopback)
     std::atomic<bool> received { false };
     std::vector<std::byte> recv_data;
 
-    receiver.start_receive([&](const auto& /*sender*/, std::span<const std::byte> data) {
+    const auto on_receive = [&](const auto& /*sender*/, std::span<const std::byte> data) {
         recv_data.assign(data.begin(), data.end());
         received = true;
-    });
+    };
+    receiver.start_receive(on_receive);
 
     // 发送端
     UdpTransport sender(ioc);
@@ -66,6 +68,48 @@ TEST(UdpTransportTest, SendReceiveLoopback)
     t.join();
 }
 
+TEST(UdpTransportTest, ReceivesIntoProvidedBuffer)
+{
+    asio::io_context ioc;
+    UdpTransport receiver(ioc);
+    ASSERT_TRUE(receiver.bind("127.0.0.1", 0));
+    auto local_ep = receiver.socket_local_endpoint();
+
+    // 提供方每次轮换两个缓冲，验证每次接收前都重新获取目标
+    std::array<std::array<std::byte, 16>, 2> buffers { };
+    int provided = 0;
+    const auto provide = [&] {
+        return std::span<std::byte> { buffers[provided++ % 2] };
+    };
+    receiver.set_receive_buffer_provider(provide);
+
+    std::atomic<int> count { 0 };
+    std::vector<const std::byte*> targets;
+    const auto on_receive = [&](const auto&, std::span<const std::byte> data) {
+        targets.push_back(data.data());
+        count++;
+    };
+    receiver.start_receive(on_receive);
+
+    UdpTransport sender(ioc);
+    ASSERT_TRUE(sender.bind("127.0.0.1", 0));
+    std::vector<std::byte> msg(4, std::byte { 7 });
+    sender.send(local_ep, msg);
+    sender.send(local_ep, msg);
+
+    std::thread t([&] { ioc.run(); });
+    for (int i = 0; i < 100 && count < 2; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ioc.stop();
+    t.join();
+
+    ASSERT_EQ(count.load(), 2);
+    EXPECT_EQ(targets[0], buffers[0].data());
+    EXPECT_EQ(targets[1], buffers[1].data());
+    EXPECT_EQ(buffers[0][0], std::byte { 7 });
+    EXPECT_EQ(buffers[1][3], std::byte { 7 });
+}
+
 TEST(UdpTransportTest, MultiplePackets)
 {
     asio::io_context ioc;
@@ -74,9 +118,10 @@ TEST(UdpTransportTest, MultiplePackets)
     auto local_ep = receiver.socket_local_endpoint();
 
     std::atomic<int> count { 0 };
-    receiver.start_receive([&](const auto&, auto) {
+    const auto on_receive = [&](const auto&, auto) {
         count++;
-    });
+    };
+    receiver.start_receive(on_receive);
 
     UdpTransport sender(ioc);
     ASSERT_TRUE(sender.bind("127.0.0.1", 0));
@@ -107,9 +152,10 @@ TEST(UdpTransportTest, RecoversFromConnectionRefusedError)
     auto receiver_ep = receiver.socket_local_endpoint();
 
     std::atomic<int> received_count { 0 };
-    receiver.start_receive([&](const auto&, auto) {
+    const auto on_receive = [&](const auto&, auto) {
         received_count.fetch_add(1, std::memory_order_relaxed);
-    });
+    };
+    receiver.start_receive(on_receive);
 
     UdpTransport sender(ioc);
     ASSERT_TRUE(sender.bind("127.0.0.1", 0));